@@ -99,6 +99,19 @@
 **   RRPStatusNameServer(char*);
 **   RRPTransferDomain(char*, char*);
 **   RRPFreeResponse(RRPRESPONSE*);
+**   RRPCloneResponse(RRPRESPONSE*);
+**   RRPGetExpirationDate(RRPRESPONSE*);
+**   RRPGetResponseDate(RRPRESPONSE*, char*);
+**   RRPRestoreDomain(char*);
+**   RRPSyncDomain(char*, char*);
+**   RRPCreateRequest(RRPCOMMAND, RRPENTITY, const char*, size_t);
+**   RRPAppendRequestAttribute(RRPREQUEST*, const char*, size_t,
+**       const char*, size_t);
+**   RRPExecuteRequest(RRPREQUEST*);
+**   RRPFreeRequest(RRPREQUEST*);
+**   RRPParseResponse(char*);
+**   RRPParseRequest(const char*, size_t);
+**   RRPFormatResponse(RRPRESPONSE*, size_t*);
 **
 ** ========================================================================
 **
@@ -132,16 +145,55 @@
 ** RRPRESPONSE* RRPAddDomain(char*, RRPVECTOR*, int);
 ** RRPRESPONSE* RRPRenewDomain(char *, int, int);
 **
+** ========================================================================
+**
+** Version: 2.1 for RRP version 2.1.0
+**
+** Date: Oct. 19th, 2026
+** Changes:
+**
+** Request strings are built in an RRPREQUEST structure, a buffer that
+** grows geometrically and knows its own length, instead of being
+** reallocated and re-scanned with strlen() for every line that is
+** appended. The request is sent with RRPSendRequestData() so that its
+** length is not computed again. RRPCreateRequest(),
+** RRPAppendRequestAttribute() and RRPExecuteRequest() expose this to
+** callers that already know the lengths of their strings; the C++ API
+** (rrpAPI.hpp) is built on them.
+**
+** RRPStartSession() no longer prints the request, which contains the
+** registrar's password, to standard output.
+**
+** RRPCloneResponse() copies a response cheaply, e.g. to hand the same
+** response to several threads (see rrpClient.h).
+**
+** RRPExecuteRequest(), and so every command of this API, waits for the
+** process governor (see rrpGovernor.h) when one is set.
+**
+** RRPGetResponseDate() reads any date attribute of a response, e.g. to
+** tell whether a domain changed after a command was sent (see
+** RRPResolveOutcome() in rrpRetry.h).
+**
+** RRPParseRequest() and RRPFormatResponse() turn strings into requests
+** and responses into strings, the reverse of what the rest of the API
+** does, for a session broker that relays them (see rrpBroker.c).
+**
 */
 
 #ifndef _RRP_API_H_
 #define _RRP_API_H_
 
+#include <stddef.h>
+#include <time.h>
 #include "rrpProperties.h"
 #include "rrpVector.h"
 #include "rrpInternalError.h"
 #include "rrpConnection.h"
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 #ifndef _RRP_BOOLEAN_
 #define _RRP_BOOLEAN_
 
@@ -164,6 +216,48 @@
 	#define MAX_SIZE 1024
 #endif
 
+#ifndef _RRP_REQUEST_
+#define _RRP_REQUEST_
+
+	/*
+	** RRP commands (see RRPCreateRequest())
+	*/
+	typedef enum {
+		RRP_ADD_COMMAND,
+		RRP_CHECK_COMMAND,
+		RRP_DEL_COMMAND,
+		RRP_DESCRIBE_COMMAND,
+		RRP_MOD_COMMAND,
+		RRP_QUIT_COMMAND,
+		RRP_RENEW_COMMAND,
+		RRP_RESTORE_COMMAND,
+		RRP_SESSION_COMMAND,
+		RRP_STATUS_COMMAND,
+		RRP_SYNC_COMMAND,
+		RRP_TRANSFER_COMMAND
+	} RRPCOMMAND;
+
+	/*
+	** Entities an RRP command applies to
+	*/
+	typedef enum {
+		RRP_NO_ENTITY,
+		RRP_DOMAIN_ENTITY,
+		RRP_NAMESERVER_ENTITY
+	} RRPENTITY;
+
+	typedef struct {
+		RRPCOMMAND command;        /* RRP command */
+		RRPENTITY entity;          /* entity the command applies to */
+		char* text;                /* request string, ends with ".\r\n" */
+		size_t length;             /* length of request string */
+		size_t capacity;           /* size of allocated buffer */
+		size_t nameOffset;         /* offset of entity name in text */
+		size_t nameLength;         /* length of entity name */
+	} RRPREQUEST;
+
+#endif
+
 /*
 **
 ** Function: RRPStartSession
@@ -486,6 +580,28 @@ RRPRESPONSE* RRPModifyNameServer(char*, char*, RRPVECTOR*, RRPPROPERTIES*,
 */
 RRPRESPONSE* RRPRenewDomain(char*, int, int);
 
+/*
+**
+** Function: RRPRestoreDomain
+**
+** Description: Restore a domain name
+**
+** Input: char* - a fully qualified domain name to restore
+**
+** Output: none
+**
+** Return: RRPRESPONSE* - a pointer to an RRPRESPONSE structure containing
+**                        the components of the RRP response returned from
+**                        the server. NULL is return is an internal error
+**                        occurs.
+**
+** Note: THE MEMORY ALLOCATED FOR THE RRPRESPONSE STRUCTURE MUST BE
+**       RELEASED BY CALLING THE RRPFreeResponse() FUNCTION (SEE FUNCTION
+**       DESCRIPTION BELOW)
+**
+*/
+RRPRESPONSE* RRPRestoreDomain(char*);
+
 /*
 **
 ** Function: RRPStatusDomain
@@ -532,6 +648,29 @@ RRPRESPONSE* RRPStatusDomain(char*);
 */
 RRPRESPONSE* RRPStatusNameServer(char*);
 
+/*
+**
+** Function: RRPSyncDomain
+**
+** Description: Sync domain registration expiration date
+**
+** Input: char* - a fully qualified domain name to register
+**        char* - the new registration expiration date (mm-dd) 
+**
+** Output: none
+**
+** Return: RRPRESPONSE* - a pointer to an RRPRESPONSE structure containing
+**                        the components of the RRP response returned from
+**                        the server. NULL is return is an internal error
+**                        occurs.
+**
+** Note: THE MEMORY ALLOCATED FOR THE RRPRESPONSE STRUCTURE MUST BE
+**       RELEASED BY CALLING THE RRPFreeResponse() FUNCTION (SEE FUNCTION
+**       DESCRIPTION BELOW)
+**
+*/
+RRPRESPONSE* RRPSyncDomain(char*, char*);
+
 /*
 **
 ** Function: RRPTransferDomain
@@ -588,4 +727,233 @@ RRPRESPONSE* RRPTransferDomain(char*, char*);
 */
 int RRPFreeResponse(RRPRESPONSE*);
 
+/*
+**
+** Function: RRPCloneResponse
+**
+** Description: Makes a copy of an RRPRESPONSE structure. The attributes
+**              of the copy share their storage with those of the
+**              original (see RRPCloneProperties()), so the copy is
+**              cheap, and the original and the copy can be used and
+**              freed independently, even by different threads
+**
+** Input: RRPRESPONSE* - pointer to an RRPRESPONSE structure to copy
+**
+** Output: none
+**
+** Return: RRPRESPONSE* - a pointer to an allocated RRPRESPONSE
+**                        structure. NULL is returned if an internal
+**                        error occurs.
+**
+** Note: THE MEMORY ALLOCATED FOR THE RRPRESPONSE STRUCTURE MUST BE
+**       RELEASED BY CALLING THE RRPFreeResponse() FUNCTION
+**
+*/
+RRPRESPONSE* RRPCloneResponse(RRPRESPONSE*);
+
+/*
+**
+** Function: RRPGetExpirationDate
+**
+** Description: Returns the registration expiration date of a domain
+**              from the 'registration expiration date' attribute of a
+**              Status response (see RRPStatusDomain()). The date is
+**              interpreted as GMT
+**
+** Input: RRPRESPONSE* - pointer to an RRPRESPONSE structure
+**
+** Output: none
+**
+** Return: time_t - the expiration date. Returns (time_t) -1 if the
+**                  response has no expiration date or if an internal
+**                  error occurs
+**
+*/
+time_t RRPGetExpirationDate(RRPRESPONSE*);
+
+/*
+**
+** Function: RRPGetResponseDate
+**
+** Description: Returns a date attribute of a response, such as the
+**              'updated date' or 'created date' of a Status response.
+**              The date is interpreted as GMT
+**
+** Input: RRPRESPONSE* - pointer to an RRPRESPONSE structure
+**        char* - the name of the attribute
+**
+** Output: none
+**
+** Return: time_t - the date. Returns (time_t) -1 if the response has no
+**                  such attribute or if an internal error occurs
+**
+*/
+time_t RRPGetResponseDate(RRPRESPONSE*, char*);
+
+/*
+**
+** Function: RRPCreateRequest
+**
+** Description: Creates an RRP request string for a command. The request
+**              can then be extended with RRPAppendRequestAttribute() and
+**              sent with RRPExecuteRequest(). This is the entry point for
+**              callers that already know the length of their strings
+**              (e.g. the C++ API in rrpAPI.hpp): the strings are copied
+**              once into the request and are not scanned for their length
+**
+** Input: RRPCOMMAND - the RRP command
+**        RRPENTITY - the entity the command applies to. RRP_NO_ENTITY
+**                    for the Describe, Quit and Session commands
+**        const char* - the name of the domain or name server. Ignored
+**                      if the entity is RRP_NO_ENTITY. Need not be
+**                      NUL terminated
+**        size_t - the length of the name
+**
+** Output: none
+**
+** Return: RRPREQUEST* - a pointer to an allocated RRPREQUEST structure.
+**                       NULL is returned if an internal error occurs
+**
+** Note: THE MEMORY ALLOCATED FOR THE RRPREQUEST STRUCTURE MUST BE
+**       RELEASED BY CALLING THE RRPFreeRequest() FUNCTION
+**
+*/
+RRPREQUEST* RRPCreateRequest(RRPCOMMAND, RRPENTITY, const char*, size_t);
+
+/*
+**
+** Function: RRPAppendRequestAttribute
+**
+** Description: Appends a "key:value" line to an RRP request string
+**
+** Input: RRPREQUEST* - a pointer to an RRPREQUEST structure
+**        const char* - the attribute key (e.g. "NameServer"). Need not
+**                      be NUL terminated
+**        size_t - the length of the key
+**        const char* - the attribute value. Need not be NUL terminated
+**        size_t - the length of the value
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+int RRPAppendRequestAttribute(RRPREQUEST*, const char*, size_t,
+	const char*, size_t);
+
+/*
+**
+** Function: RRPExecuteRequest
+**
+** Description: Sends an RRP request string to the RRP server, then reads
+**              and parses the response. The request is not released and
+**              can be executed again. With a process governor (see
+**              rrpGovernor.h), the request waits until the governor
+**              allows it
+**
+** Input: RRPREQUEST* - a pointer to an RRPREQUEST structure
+**
+** Output: none
+**
+** Return: RRPRESPONSE* - a pointer to an RRPRESPONSE structure containing
+**                        the components of the RRP response returned from
+**                        the server. NULL is return is an internal error
+**                        occurs.
+**
+** Note: THE MEMORY ALLOCATED FOR THE RRPRESPONSE STRUCTURE MUST BE
+**       RELEASED BY CALLING THE RRPFreeResponse() FUNCTION
+**
+*/
+RRPRESPONSE* RRPExecuteRequest(RRPREQUEST*);
+
+/*
+**
+** Function: RRPFreeRequest
+**
+** Description: Frees all memory allocated for an RRPREQUEST structure
+**
+** Input: RRPREQUEST* - pointer to an RRPREQUEST structure to free
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+int RRPFreeRequest(RRPREQUEST*);
+
+/*
+**
+** Function: RRPParseResponse
+**
+** Description: Breaks up an RRP response string (as returned by
+**              RRPReadResponse() or RRPNextConnectionResponse()) into
+**              its components
+**
+** Input: char* - the RRP response string
+**
+** Output: none
+**
+** Return: RRPRESPONSE* - a pointer to an RRPRESPONSE structure containing
+**                        the components of the RRP response. NULL is
+**                        returned if an internal error occurs.
+**
+** Note: THE MEMORY ALLOCATED FOR THE RRPRESPONSE STRUCTURE MUST BE
+**       RELEASED BY CALLING THE RRPFreeResponse() FUNCTION
+**
+*/
+RRPRESPONSE* RRPParseResponse(char*);
+
+/*
+**
+** Function: RRPParseRequest
+**
+** Description: Builds an RRPREQUEST structure from an RRP request string
+**              received from elsewhere, e.g. by a session broker (see
+**              rrpBroker.c). The command, the entity and the entity
+**              name are found in the string, which is copied as is
+**
+** Input: const char* - the RRP request string, ending with ".\r\n".
+**                      Need not be NUL terminated
+**        size_t - the length of the string
+**
+** Output: none
+**
+** Return: RRPREQUEST* - a pointer to an allocated RRPREQUEST structure.
+**                       NULL is returned if the string is not an RRP
+**                       request (RRP_BAD_PARAM_ERROR) or if an internal
+**                       error occurs
+**
+** Note: THE MEMORY ALLOCATED FOR THE RRPREQUEST STRUCTURE MUST BE
+**       RELEASED BY CALLING THE RRPFreeRequest() FUNCTION
+**
+*/
+RRPREQUEST* RRPParseRequest(const char*, size_t);
+
+/*
+**
+** Function: RRPFormatResponse
+**
+** Description: Writes an RRPRESPONSE structure back as an RRP response
+**              string, the reverse of RRPParseResponse(). The attributes
+**              are written in the order their keys were first seen,
+**              each value of a key on a line of its own
+**
+** Input: RRPRESPONSE* - pointer to an RRPRESPONSE structure
+**
+** Output: size_t* - the length of the string. May be NULL
+**
+** Return: char* - the response string, ending with ".\r\n". NULL is
+**                 returned if an internal error occurs.
+**
+** Note: THE STRING MUST BE RELEASED BY CALLING free()
+**
+*/
+char* RRPFormatResponse(RRPRESPONSE*, size_t*);
+
+#ifdef __cplusplus
+}
+#endif
+
 #endif /* _RRP_API_H_ */
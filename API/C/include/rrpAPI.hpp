@@ -0,0 +1,942 @@
+/* ===========================================================================
+ * Copyright (C) 2000 VeriSign, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * VeriSign Global Registry Service
+ * 21345 Ridgetop Circle
+ * Dulles, VA 20166
+ * ===========================================================================
+ * The RRP, APIs and Software are provided "as-is" and without any warranty
+ * of any kind.  NSI EXPRESSLY DISCLAIMS ALL WARRANTIES AND/OR CONDITIONS,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * AND CONDITIONS OF MERCHANTABILITY OR SATISFACTORY QUALITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE AND NONINFRINGEMENT OF THIRD PARTY RIGHTS.  NSI DOES
+ * NOT WARRANT THAT THE FUNCTIONS CONTAINED IN THE RRP, APIs OR SOFTWARE
+ * WILL MEET REGISTRAR'S REQUIREMENTS, OR THAT THE OPERATION OF THE RRP,
+ * APIs OR SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE,OR THAT DEFECTS IN
+ * THE RRP, APIs OR SOFTWARE WILL BE CORRECTED.  FURTHERMORE, NSI DOES NOT
+ * WARRANT NOR MAKE ANY REPRESENTATIONS REGARDING THE USE OR THE RESULTS OF
+ * THE RRP, APIs, SOFTWARE OR RELATED DOCUMENTATION IN TERMS OF THEIR
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR OTHERWISE.  SHOULD THE RRP, APIs
+ * OR SOFTWARE PROVE DEFECTIVE, REGISTRAR ASSUMES THE ENTIRE COST OF ALL
+ * NECESSARY SERVICING, REPAIR OR CORRECTION.
+ * ======================================================================== */
+
+/*
+**
+** Module Name: rrpAPI.hpp
+**
+** Version: 2.1 for RRP version 2.1.0
+**
+** Date: Oct. 19th, 2026
+**
+** Description: rrpAPI.hpp is a header-only C++17 interface to the RRP
+**              API. It wraps the structures of the C API in classes that
+**              release them when they go out of scope:
+**
+**                rrp::Vector     - owns an RRPVECTOR. Copies share the
+**                                  elements (see RRPCloneVector())
+**                rrp::Values     - view of the strings of an RRPVECTOR
+**                rrp::Attributes - view of the key/value pairs of an
+**                                  RRPPROPERTIES structure
+**                rrp::Properties - owns an RRPPROPERTIES structure.
+**                                  Copies share the properties (see
+**                                  RRPCloneProperties())
+**                rrp::Request    - owns an RRPREQUEST (move only)
+**                rrp::Response   - owns an RRPRESPONSE (move only)
+**                rrp::Session    - an authenticated RRP session (move
+**                                  only). Ends the session and closes
+**                                  the connection when destroyed
+**
+**              Strings are passed as std::string_view and handed to the
+**              C API together with their length (see RRPCreateRequest()),
+**              so they are copied once, into the request string, and are
+**              never scanned for their length. Responses are viewed in
+**              place rather than copied.
+**
+**              Internal errors of the C API are thrown as rrp::Error,
+**              which carries the internal error code. A failed login is
+**              thrown as rrp::CommandError. Other RRP error responses
+**              are returned as usual and can be examined with
+**              Response::code().
+**
+** Note:        The C API has a single connection, so only one
+**              rrp::Session may exist at a time. A moved-from object may
+**              only be assigned to or destroyed.
+**
+** Changes:
+**
+*/
+
+#ifndef _RRP_API_HPP_
+#define _RRP_API_HPP_
+
+#include <cstddef>
+#include <cstring>
+#include <ctime>
+#include <initializer_list>
+#include <iterator>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include "rrpAPI.h"
+
+namespace rrp {
+
+/*
+** An internal error of the C API (see rrpInternalError.h)
+*/
+class Error : public std::runtime_error {
+public:
+	explicit Error (RRPINTERNAL_ERROR_CODE code)
+		: std::runtime_error(description(code)), _code(code) {}
+
+	RRPINTERNAL_ERROR_CODE code () const noexcept { return _code; }
+
+	/*
+	** Throws the internal error code that is currently set
+	*/
+	[[noreturn]] static void raise () {
+		throw Error(RRPGetInternalErrorCode());
+	}
+
+private:
+	static std::string description (RRPINTERNAL_ERROR_CODE code) {
+		char* text = (code == RRPGetInternalErrorCode()) ?
+			RRPGetInternalErrorDescription() : nullptr;
+
+		return text != nullptr ? text : "RRP internal error";
+	}
+
+	RRPINTERNAL_ERROR_CODE _code;
+};
+
+/*
+** An RRP error response to a command that can not be ignored (a failed
+** login)
+*/
+class CommandError : public std::runtime_error {
+public:
+	CommandError (int code, std::string_view description)
+		: std::runtime_error(std::to_string(code) + " " +
+			std::string(description)), _code(code) {}
+
+	int code () const noexcept { return _code; }
+
+private:
+	int _code;
+};
+
+/*
+** A view of the strings of an RRPVECTOR. The vector is walked directly,
+** so the view does not move the vector's current element pointer
+*/
+class Values {
+public:
+	class iterator {
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = std::string_view;
+		using difference_type = std::ptrdiff_t;
+		using pointer = const std::string_view*;
+		using reference = std::string_view;
+
+		iterator () noexcept = default;
+		explicit iterator (RRPELEMENT_NODE* node) noexcept : _node(node) {}
+
+		std::string_view operator* () const { return _node->value; }
+
+		iterator& operator++ () noexcept {
+			_node = _node->next;
+			return *this;
+		}
+
+		iterator operator++ (int) noexcept {
+			iterator old = *this;
+			_node = _node->next;
+			return old;
+		}
+
+		bool operator== (const iterator& other) const noexcept {
+			return _node == other._node;
+		}
+
+		bool operator!= (const iterator& other) const noexcept {
+			return _node != other._node;
+		}
+
+	private:
+		RRPELEMENT_NODE* _node = nullptr;
+	};
+
+	Values () noexcept = default;
+	explicit Values (RRPVECTOR* vector) noexcept : _vector(vector) {}
+
+	iterator begin () const noexcept {
+		return iterator(_vector != nullptr ? _vector->head : nullptr);
+	}
+
+	iterator end () const noexcept { return iterator(); }
+
+	std::size_t size () const noexcept {
+		return _vector != nullptr ? _vector->count : 0;
+	}
+
+	bool empty () const noexcept { return size() == 0; }
+
+	std::string_view front () const { return *begin(); }
+
+private:
+	RRPVECTOR* _vector = nullptr;
+};
+
+/*
+** An RRPVECTOR. Copying a Vector does not copy its strings: the copies
+** share them until one of them is modified (see RRPCloneVector())
+*/
+class Vector {
+public:
+	using iterator = Values::iterator;
+
+	Vector () : _vector(RRPCreateVector()) {
+		if (_vector == nullptr) {
+			Error::raise();
+		}
+	}
+
+	Vector (std::initializer_list<std::string_view> values)
+		: _vector(pack(values.begin(), values.end())) {}
+
+	/*
+	** Builds a vector from any range of strings in a single allocation
+	** (see RRPCreateVectorFromBuffer()). Empty strings are skipped and
+	** the strings must not contain newlines
+	*/
+	template <class Range,
+		class = decltype(std::string_view(*std::begin(std::declval<const Range&>())))>
+	explicit Vector (const Range& values)
+		: _vector(pack(std::begin(values), std::end(values))) {}
+
+	/*
+	** Takes ownership of an RRPVECTOR
+	*/
+	explicit Vector (RRPVECTOR* vector) noexcept : _vector(vector) {}
+
+	Vector (const Vector& other) : _vector(RRPCloneVector(other._vector)) {
+		if (_vector == nullptr) {
+			Error::raise();
+		}
+	}
+
+	Vector (Vector&& other) noexcept
+		: _vector(std::exchange(other._vector, nullptr)) {}
+
+	Vector& operator= (Vector other) noexcept {
+		std::swap(_vector, other._vector);
+		return *this;
+	}
+
+	~Vector () {
+		if (_vector != nullptr) {
+			RRPFreeVector(_vector);
+		}
+	}
+
+	void push_back (std::string_view value) {
+		if (RRPAddVectorElementN(_vector, value.data(), value.size()) < 0) {
+			Error::raise();
+		}
+	}
+
+	void clear () {
+		if (RRPRemoveAllVectorElements(_vector) < 0) {
+			Error::raise();
+		}
+	}
+
+	Values values () const noexcept { return Values(_vector); }
+	iterator begin () const noexcept { return values().begin(); }
+	iterator end () const noexcept { return values().end(); }
+	std::size_t size () const noexcept { return values().size(); }
+	bool empty () const noexcept { return size() == 0; }
+
+	RRPVECTOR* get () const noexcept { return _vector; }
+
+	RRPVECTOR* release () noexcept {
+		return std::exchange(_vector, nullptr);
+	}
+
+private:
+	template <class Iterator>
+	static RRPVECTOR* pack (Iterator first, Iterator last) {
+		std::string buffer;
+		std::size_t size = 0;
+		RRPVECTOR* vector = nullptr;
+
+		for (Iterator i = first; i != last; ++i) {
+			size += std::string_view(*i).size() + 1;
+		}
+
+		buffer.reserve(size);
+
+		for (Iterator i = first; i != last; ++i) {
+			buffer.append(std::string_view(*i));
+			buffer.push_back('\0');
+		}
+
+		vector = RRPCreateVectorFromBuffer(buffer.data(), buffer.size(),
+			RRPFALSE);
+
+		if (vector == nullptr) {
+			Error::raise();
+		}
+
+		return vector;
+	}
+
+	RRPVECTOR* _vector;
+};
+
+/*
+** A view of the key/value pairs of an RRPPROPERTIES structure. A key with
+** several values appears once for each value
+*/
+class Attributes {
+public:
+	using value_type = std::pair<std::string_view, std::string_view>;
+
+	class iterator {
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = Attributes::value_type;
+		using difference_type = std::ptrdiff_t;
+		using pointer = const value_type*;
+		using reference = value_type;
+
+		iterator () noexcept = default;
+
+		explicit iterator (RRPPROPERTY_NODE* property) noexcept
+			: _property(property) {
+			skipEmpty();
+		}
+
+		value_type operator* () const {
+			return value_type(_property->key, _element->value);
+		}
+
+		iterator& operator++ () noexcept {
+			_element = _element->next;
+			if (_element == nullptr) {
+				_property = _property->next;
+				skipEmpty();
+			}
+			return *this;
+		}
+
+		iterator operator++ (int) noexcept {
+			iterator old = *this;
+			++*this;
+			return old;
+		}
+
+		bool operator== (const iterator& other) const noexcept {
+			return _property == other._property &&
+				_element == other._element;
+		}
+
+		bool operator!= (const iterator& other) const noexcept {
+			return !(*this == other);
+		}
+
+	private:
+		void skipEmpty () noexcept {
+			for (; _property != nullptr; _property = _property->next) {
+				if (_property->values != nullptr &&
+					(_element = _property->values->head) != nullptr) {
+					return;
+				}
+			}
+			_element = nullptr;
+		}
+
+		RRPPROPERTY_NODE* _property = nullptr;
+		RRPELEMENT_NODE* _element = nullptr;
+	};
+
+	Attributes () noexcept = default;
+
+	explicit Attributes (RRPPROPERTIES* properties) noexcept
+		: _properties(properties) {}
+
+	iterator begin () const noexcept {
+		return iterator(_properties != nullptr ? _properties->head : nullptr);
+	}
+
+	iterator end () const noexcept { return iterator(); }
+
+	bool empty () const noexcept { return begin() == end(); }
+
+	/*
+	** Returns the values of a key. The view is empty if there is no such
+	** key
+	*/
+	Values values (std::string_view key) const noexcept {
+		RRPPROPERTY_NODE* node = nullptr;
+
+		if (_properties == nullptr) {
+			return Values();
+		}
+
+		for (node = _properties->head; node != nullptr; node = node->next) {
+			if (key == node->key) {
+				return Values(node->values);
+			}
+		}
+
+		return Values();
+	}
+
+	/*
+	** Returns the first value of a key
+	*/
+	std::optional<std::string_view> find (std::string_view key) const {
+		Values found = values(key);
+
+		if (found.empty()) {
+			return std::nullopt;
+		}
+
+		return found.front();
+	}
+
+private:
+	RRPPROPERTIES* _properties = nullptr;
+};
+
+/*
+** An RRPPROPERTIES structure, such as the old and new values given to
+** Session::modify_domain(). Copying a Properties does not copy its
+** strings: the copies share them until one of them is modified (see
+** RRPCloneProperties()). The structure is only created by the first
+** put(), so an empty Properties costs nothing
+*/
+class Properties {
+public:
+	using iterator = Attributes::iterator;
+
+	Properties () noexcept = default;
+
+	Properties (std::initializer_list<Attributes::value_type> pairs) {
+		for (const auto& pair : pairs) {
+			put(pair.first, pair.second);
+		}
+	}
+
+	/*
+	** Takes ownership of an RRPPROPERTIES structure
+	*/
+	explicit Properties (RRPPROPERTIES* properties) noexcept
+		: _properties(properties) {}
+
+	Properties (const Properties& other)
+		: _properties(other._properties != nullptr ?
+			RRPCloneProperties(other._properties) : nullptr) {
+		if (other._properties != nullptr && _properties == nullptr) {
+			Error::raise();
+		}
+	}
+
+	Properties (Properties&& other) noexcept
+		: _properties(std::exchange(other._properties, nullptr)) {}
+
+	Properties& operator= (Properties other) noexcept {
+		std::swap(_properties, other._properties);
+		return *this;
+	}
+
+	~Properties () {
+		if (_properties != nullptr) {
+			RRPFreeProperties(_properties);
+		}
+	}
+
+	/*
+	** Adds a value to a key (see RRPPutProperty())
+	*/
+	void put (std::string_view key, std::string_view value) {
+		if (_properties == nullptr &&
+			(_properties = RRPCreateProperties()) == nullptr) {
+			Error::raise();
+		}
+
+		if (RRPPutPropertyN(_properties, key.data(), key.size(),
+			value.data(), value.size()) < 0) {
+			Error::raise();
+		}
+	}
+
+	Attributes attributes () const noexcept {
+		return Attributes(_properties);
+	}
+
+	iterator begin () const noexcept { return attributes().begin(); }
+	iterator end () const noexcept { return attributes().end(); }
+	bool empty () const noexcept { return attributes().empty(); }
+
+	/*
+	** The structure, or NULL if nothing was put in it
+	*/
+	RRPPROPERTIES* get () const noexcept { return _properties; }
+
+	RRPPROPERTIES* release () noexcept {
+		return std::exchange(_properties, nullptr);
+	}
+
+private:
+	RRPPROPERTIES* _properties = nullptr;
+};
+
+/*
+** An RRP request string (see RRPCreateRequest())
+*/
+class Request {
+public:
+	Request (RRPCOMMAND command, RRPENTITY entity = RRP_NO_ENTITY,
+		std::string_view name = std::string_view())
+		: _request(RRPCreateRequest(command, entity, name.data(),
+			name.size())) {
+		if (_request == nullptr) {
+			Error::raise();
+		}
+	}
+
+	Request (const Request&) = delete;
+	Request& operator= (const Request&) = delete;
+
+	Request (Request&& other) noexcept
+		: _request(std::exchange(other._request, nullptr)) {}
+
+	Request& operator= (Request&& other) noexcept {
+		std::swap(_request, other._request);
+		return *this;
+	}
+
+	~Request () {
+		if (_request != nullptr) {
+			RRPFreeRequest(_request);
+		}
+	}
+
+	/*
+	** Appends a "key:value" line
+	*/
+	Request& add (std::string_view key, std::string_view value) {
+		if (RRPAppendRequestAttribute(_request, key.data(), key.size(),
+			value.data(), value.size()) < 0) {
+			Error::raise();
+		}
+		return *this;
+	}
+
+	Request& add (std::string_view key, int value) {
+		return add(key, std::string_view(std::to_string(value)));
+	}
+
+	/*
+	** Appends a "key:value" line for each value
+	*/
+	template <class Range>
+	Request& add_each (std::string_view key, const Range& values) {
+		for (const auto& value : values) {
+			add(key, std::string_view(value));
+		}
+		return *this;
+	}
+
+	/*
+	** Appends a "key:oldValue=newValue" line (see RRPModifyDomain())
+	*/
+	Request& replace (std::string_view key, std::string_view oldValue,
+		std::string_view newValue) {
+		std::string value;
+
+		value.reserve(oldValue.size() + 1 + newValue.size());
+		value.append(oldValue).append(1, '=').append(newValue);
+
+		return add(key, value);
+	}
+
+	/*
+	** Appends a "key:oldValue=" line (see RRPModifyDomain())
+	*/
+	Request& remove (std::string_view key, std::string_view oldValue) {
+		return replace(key, oldValue, std::string_view());
+	}
+
+	/*
+	** Appends the values added, replaced and deleted for a key, in the
+	** order RRPModifyDomain() and RRPModifyNameServer() use
+	*/
+	template <class Range>
+	Request& change (std::string_view key, const Range& added,
+		const Properties& modified, const Range& deleted) {
+		add_each(key, added);
+
+		for (const auto& [oldValue, newValue] : modified) {
+			replace(key, oldValue, newValue);
+		}
+
+		for (const auto& oldValue : deleted) {
+			remove(key, std::string_view(oldValue));
+		}
+		return *this;
+	}
+
+	RRPCOMMAND command () const noexcept { return _request->command; }
+	RRPENTITY entity () const noexcept { return _request->entity; }
+
+	std::string_view name () const noexcept {
+		return std::string_view(_request->text + _request->nameOffset,
+			_request->nameLength);
+	}
+
+	std::string_view text () const noexcept {
+		return std::string_view(_request->text, _request->length);
+	}
+
+	RRPREQUEST* get () const noexcept { return _request; }
+
+	RRPREQUEST* release () noexcept {
+		return std::exchange(_request, nullptr);
+	}
+
+private:
+	RRPREQUEST* _request;
+};
+
+/*
+** An RRP response
+*/
+class Response {
+public:
+	/*
+	** Takes ownership of an RRPRESPONSE. Throws the current internal
+	** error if 'response' is NULL
+	*/
+	explicit Response (RRPRESPONSE* response) : _response(response) {
+		if (_response == nullptr) {
+			Error::raise();
+		}
+	}
+
+	Response (const Response&) = delete;
+	Response& operator= (const Response&) = delete;
+
+	Response (Response&& other) noexcept
+		: _response(std::exchange(other._response, nullptr)) {}
+
+	Response& operator= (Response&& other) noexcept {
+		std::swap(_response, other._response);
+		return *this;
+	}
+
+	~Response () {
+		if (_response != nullptr) {
+			RRPFreeResponse(_response);
+		}
+	}
+
+	int code () const noexcept { return _response->code; }
+
+	/*
+	** True for the 2xx (success) response codes
+	*/
+	bool success () const noexcept { return code() / 100 == 2; }
+
+	std::string_view description () const noexcept {
+		return _response->description != nullptr ?
+			std::string_view(_response->description) : std::string_view();
+	}
+
+	Attributes attributes () const noexcept {
+		return Attributes(_response->attributes);
+	}
+
+	std::optional<std::string_view> attribute (std::string_view key) const {
+		return attributes().find(key);
+	}
+
+	/*
+	** Returns the registration expiration date of a Status response,
+	** or (time_t) -1 (see RRPGetExpirationDate())
+	*/
+	std::time_t expiration () const noexcept {
+		return RRPGetExpirationDate(_response);
+	}
+
+	RRPRESPONSE* get () const noexcept { return _response; }
+
+	RRPRESPONSE* release () noexcept {
+		return std::exchange(_response, nullptr);
+	}
+
+private:
+	RRPRESPONSE* _response;
+};
+
+/*
+** An authenticated RRP session on the connection of the C API
+** (see RRPCreateConnection() and RRPStartSession())
+*/
+class Session {
+public:
+	/*
+	** Connects to an RRP server and logs in. Throws rrp::Error if the
+	** connection can not be made and rrp::CommandError if the server
+	** rejects the login
+	*/
+	Session (std::string_view host, unsigned short port,
+		std::string_view id, std::string_view password,
+		unsigned timeout = 0) {
+		std::string hostName(host);
+
+		RRPSetTimeout(timeout);
+
+		if (RRPCreateConnection(hostName.data(), port) < 0) {
+			Error::raise();
+		}
+
+		_open = true;
+
+		try {
+			Request login(RRP_SESSION_COMMAND);
+			login.add("-Id", id).add("-Password", password);
+
+			Response response = execute(login);
+
+			if (!response.success()) {
+				throw CommandError(response.code(), response.description());
+			}
+		}
+		catch (...) {
+			close();
+			throw;
+		}
+	}
+
+	Session (const Session&) = delete;
+	Session& operator= (const Session&) = delete;
+
+	Session (Session&& other) noexcept
+		: _open(std::exchange(other._open, false)) {}
+
+	Session& operator= (Session&& other) noexcept {
+		std::swap(_open, other._open);
+		return *this;
+	}
+
+	~Session () {
+		close();
+	}
+
+	/*
+	** Ends the session and closes the connection. Errors are ignored
+	*/
+	void close () noexcept {
+		RRPRESPONSE* response = nullptr;
+
+		if (!_open) {
+			return;
+		}
+
+		_open = false;
+
+		if ((response = RRPEndSession()) != nullptr) {
+			RRPFreeResponse(response);
+		}
+
+		RRPCloseConnection();
+	}
+
+	bool is_open () const noexcept { return _open; }
+
+	Response execute (const Request& request) {
+		return Response(RRPExecuteRequest(request.get()));
+	}
+
+	Response check_domain (std::string_view domainName) {
+		return run(RRP_CHECK_COMMAND, RRP_DOMAIN_ENTITY, domainName);
+	}
+
+	Response check_nameserver (std::string_view nameServer) {
+		return run(RRP_CHECK_COMMAND, RRP_NAMESERVER_ENTITY, nameServer);
+	}
+
+	Response status_domain (std::string_view domainName) {
+		return run(RRP_STATUS_COMMAND, RRP_DOMAIN_ENTITY, domainName);
+	}
+
+	Response status_nameserver (std::string_view nameServer) {
+		return run(RRP_STATUS_COMMAND, RRP_NAMESERVER_ENTITY, nameServer);
+	}
+
+	Response delete_domain (std::string_view domainName) {
+		return run(RRP_DEL_COMMAND, RRP_DOMAIN_ENTITY, domainName);
+	}
+
+	Response delete_nameserver (std::string_view nameServer) {
+		return run(RRP_DEL_COMMAND, RRP_NAMESERVER_ENTITY, nameServer);
+	}
+
+	Response restore_domain (std::string_view domainName) {
+		return run(RRP_RESTORE_COMMAND, RRP_DOMAIN_ENTITY, domainName);
+	}
+
+	Response describe (std::string_view target = std::string_view()) {
+		Request request(RRP_DESCRIBE_COMMAND);
+
+		if (!target.empty()) {
+			request.add("-Target", target);
+		}
+
+		return execute(request);
+	}
+
+	/*
+	** 'nameServers' may be any range of strings, or a braced list
+	*/
+	template <class Range = std::initializer_list<std::string_view>>
+	Response add_domain (std::string_view domainName,
+		const Range& nameServers = {}, int registrationPeriod = 0) {
+		Request request(RRP_ADD_COMMAND, RRP_DOMAIN_ENTITY, domainName);
+
+		request.add_each("NameServer", nameServers);
+
+		if (registrationPeriod > 0) {
+			request.add("-Period", registrationPeriod);
+		}
+
+		return execute(request);
+	}
+
+	template <class Range = std::initializer_list<std::string_view>>
+	Response add_nameserver (std::string_view nameServer,
+		const Range& ipAddresses = {}) {
+		Request request(RRP_ADD_COMMAND, RRP_NAMESERVER_ENTITY, nameServer);
+
+		request.add_each("IPAddress", ipAddresses);
+
+		return execute(request);
+	}
+
+	Response renew_domain (std::string_view domainName,
+		int renewRegistrationPeriod = 0, int currentExpirationYear = 0) {
+		Request request(RRP_RENEW_COMMAND, RRP_DOMAIN_ENTITY, domainName);
+
+		if (renewRegistrationPeriod > 0) {
+			request.add("-Period", renewRegistrationPeriod);
+		}
+
+		if (currentExpirationYear > 0) {
+			request.add("-CurrentExpirationYear", currentExpirationYear);
+		}
+
+		return execute(request);
+	}
+
+	/*
+	** Requests the transfer of a domain if 'approve' is empty, otherwise
+	** approves ("yes") or denies ("no") a transfer
+	*/
+	Response transfer_domain (std::string_view domainName,
+		std::string_view approve = std::string_view()) {
+		Request request(RRP_TRANSFER_COMMAND, RRP_DOMAIN_ENTITY, domainName);
+
+		if (!approve.empty()) {
+			request.add("-Approve", approve);
+		}
+
+		return execute(request);
+	}
+
+	/*
+	** Updates the name servers and statuses of a domain (see
+	** RRPModifyDomain()). The keys of the Properties are the values to
+	** replace, and their values the replacements
+	*/
+	template <class Range = std::initializer_list<std::string_view>>
+	Response modify_domain (std::string_view domainName,
+		const Range& addedNameServers = {},
+		const Properties& modifiedNameServers = Properties(),
+		const Range& deletedNameServers = {},
+		const Range& addedStatuses = {},
+		const Properties& modifiedStatuses = Properties(),
+		const Range& deletedStatuses = {}) {
+		Request request(RRP_MOD_COMMAND, RRP_DOMAIN_ENTITY, domainName);
+
+		request.change("NameServer", addedNameServers, modifiedNameServers,
+			deletedNameServers);
+		request.change("Status", addedStatuses, modifiedStatuses,
+			deletedStatuses);
+
+		return execute(request);
+	}
+
+	/*
+	** Renames a name server if 'newNameServer' is not empty, and updates
+	** its IP addresses (see RRPModifyNameServer())
+	*/
+	template <class Range = std::initializer_list<std::string_view>>
+	Response modify_nameserver (std::string_view nameServer,
+		std::string_view newNameServer = std::string_view(),
+		const Range& addedIPAddresses = {},
+		const Properties& modifiedIPAddresses = Properties(),
+		const Range& deletedIPAddresses = {}) {
+		Request request(RRP_MOD_COMMAND, RRP_NAMESERVER_ENTITY, nameServer);
+
+		if (!newNameServer.empty()) {
+			request.add("NewNameServer", newNameServer);
+		}
+
+		request.change("IPAddress", addedIPAddresses, modifiedIPAddresses,
+			deletedIPAddresses);
+
+		return execute(request);
+	}
+
+	Response sync_domain (std::string_view domainName,
+		std::string_view syncDate) {
+		Request request(RRP_SYNC_COMMAND, RRP_DOMAIN_ENTITY, domainName);
+
+		request.add("date", syncDate);
+
+		return execute(request);
+	}
+
+private:
+	Response run (RRPCOMMAND command, RRPENTITY entity,
+		std::string_view name) {
+		return execute(Request(command, entity, name));
+	}
+
+	bool _open = false;
+};
+
+} /* namespace rrp */
+
+#endif /* _RRP_API_HPP_ */
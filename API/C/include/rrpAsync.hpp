@@ -0,0 +1,619 @@
+/* ===========================================================================
+ * Copyright (C) 2000 VeriSign, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * VeriSign Global Registry Service
+ * 21345 Ridgetop Circle
+ * Dulles, VA 20166
+ * ===========================================================================
+ * The RRP, APIs and Software are provided "as-is" and without any warranty
+ * of any kind.  NSI EXPRESSLY DISCLAIMS ALL WARRANTIES AND/OR CONDITIONS,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * AND CONDITIONS OF MERCHANTABILITY OR SATISFACTORY QUALITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE AND NONINFRINGEMENT OF THIRD PARTY RIGHTS.  NSI DOES
+ * NOT WARRANT THAT THE FUNCTIONS CONTAINED IN THE RRP, APIs OR SOFTWARE
+ * WILL MEET REGISTRAR'S REQUIREMENTS, OR THAT THE OPERATION OF THE RRP,
+ * APIs OR SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE,OR THAT DEFECTS IN
+ * THE RRP, APIs OR SOFTWARE WILL BE CORRECTED.  FURTHERMORE, NSI DOES NOT
+ * WARRANT NOR MAKE ANY REPRESENTATIONS REGARDING THE USE OR THE RESULTS OF
+ * THE RRP, APIs, SOFTWARE OR RELATED DOCUMENTATION IN TERMS OF THEIR
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR OTHERWISE.  SHOULD THE RRP, APIs
+ * OR SOFTWARE PROVE DEFECTIVE, REGISTRAR ASSUMES THE ENTIRE COST OF ALL
+ * NECESSARY SERVICING, REPAIR OR CORRECTION.
+ * ======================================================================== */
+
+/*
+**
+** Module Name: rrpAsync.hpp
+**
+** Version: 2.1 for RRP version 2.1.0
+**
+** Date: Oct. 19th, 2026
+**
+** Description: rrpAsync.hpp is a header-only C++20 coroutine interface
+**              to the RRP session pools of rrpSession.h. It lets many RRP
+**              commands be written as straight-line code and run
+**              concurrently on one thread:
+**
+**                rrp::Task<T> - a coroutine returning T. A task starts
+**                               when it is awaited, or when it is run by
+**                               rrp::Pool::run()
+**                rrp::Pool    - an RRPSESSIONPOOL (move only). Its
+**                               commands return awaitables yielding an
+**                               rrp::Response (see rrpAPI.hpp)
+**                rrp::when_all - awaits a number of tasks at once
+**
+**              Example:
+**
+**                rrp::Task<bool> available (rrp::Pool& pool,
+**                    std::string_view name) {
+**                    rrp::Response response =
+**                        co_await pool.check_domain(name);
+**                    co_return response.code() == 210;
+**                }
+**
+**                rrp::Pool pool("localhost", 648, "id", "password", 4);
+**                std::vector<rrp::Task<bool>> tasks;
+**                for (auto& name : names) {
+**                    tasks.push_back(available(pool, name));
+**                }
+**                std::vector<bool> result =
+**                    pool.run(rrp::when_all(std::move(tasks)));
+**
+**              A coroutine awaiting a command is suspended until the
+**              response arrives, and is resumed from the completion
+**              function of the request, i.e. from within
+**              rrp::Pool::poll(). No thread ever blocks on a response,
+**              and the requests of all the suspended coroutines are
+**              pipelined on the sessions of the pool.
+**
+**              A command throws rrp::Error if its request fails (the
+**              session's connection failed, etc.). RRP error responses
+**              are returned as usual.
+**
+** Note:        A pool, the tasks that use it and the internal error code
+**              of the C API belong to one thread: use one pool per
+**              thread. Tasks awaiting a command must not be destroyed
+**              before the pool has completed it, and a pool must not be
+**              destroyed by one of its own tasks.
+**
+** Changes:
+**
+*/
+
+#ifndef _RRP_ASYNC_HPP_
+#define _RRP_ASYNC_HPP_
+
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <initializer_list>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "rrpAPI.hpp"
+#include "rrpSession.h"
+
+namespace rrp {
+
+template <class T = void>
+class Task;
+
+namespace detail {
+
+/*
+** The part of the promise of a task that does not depend on its result.
+** 'continuation' is resumed when the task completes. A task started by
+** when_all() shares a counter with the other tasks and resumes the
+** continuation only when it is the last one to complete
+*/
+class TaskPromiseBase {
+public:
+	struct FinalAwaiter {
+		bool await_ready () const noexcept { return false; }
+
+		template <class Promise>
+		std::coroutine_handle<> await_suspend (
+			std::coroutine_handle<Promise> handle) noexcept {
+			TaskPromiseBase& promise = handle.promise();
+
+			if (promise.remaining != nullptr && --*promise.remaining != 0) {
+				return std::noop_coroutine();
+			}
+
+			return promise.continuation;
+		}
+
+		void await_resume () const noexcept {}
+	};
+
+	std::suspend_always initial_suspend () const noexcept { return {}; }
+	FinalAwaiter final_suspend () const noexcept { return {}; }
+
+	void unhandled_exception () noexcept {
+		exception = std::current_exception();
+	}
+
+	std::coroutine_handle<> continuation = std::noop_coroutine();
+	std::size_t* remaining = nullptr;
+	std::exception_ptr exception;
+};
+
+template <class T>
+class TaskPromise : public TaskPromiseBase {
+public:
+	Task<T> get_return_object () noexcept;
+
+	template <class Value>
+	void return_value (Value&& value) {
+		result.emplace(std::forward<Value>(value));
+	}
+
+	T take () {
+		if (exception) {
+			std::rethrow_exception(exception);
+		}
+		return std::move(*result);
+	}
+
+	std::optional<T> result;
+};
+
+template <>
+class TaskPromise<void> : public TaskPromiseBase {
+public:
+	Task<void> get_return_object () noexcept;
+
+	void return_void () const noexcept {}
+
+	void take () {
+		if (exception) {
+			std::rethrow_exception(exception);
+		}
+	}
+};
+
+} /* namespace detail */
+
+/*
+** A lazily started coroutine returning T (move only)
+*/
+template <class T>
+class Task {
+public:
+	using promise_type = detail::TaskPromise<T>;
+	using handle_type = std::coroutine_handle<promise_type>;
+
+	explicit Task (handle_type handle) noexcept : _handle(handle) {}
+
+	Task (const Task&) = delete;
+	Task& operator= (const Task&) = delete;
+
+	Task (Task&& other) noexcept
+		: _handle(std::exchange(other._handle, nullptr)) {}
+
+	Task& operator= (Task&& other) noexcept {
+		std::swap(_handle, other._handle);
+		return *this;
+	}
+
+	~Task () {
+		if (_handle) {
+			_handle.destroy();
+		}
+	}
+
+	bool done () const noexcept { return _handle.done(); }
+
+	/*
+	** Starts the task and suspends the awaiting coroutine until the task
+	** completes. The task's result is returned, or its exception thrown
+	*/
+	auto operator co_await () && noexcept {
+		struct Awaiter {
+			bool await_ready () const noexcept { return false; }
+
+			std::coroutine_handle<> await_suspend (
+				std::coroutine_handle<> awaiting) noexcept {
+				handle.promise().continuation = awaiting;
+				return handle;
+			}
+
+			T await_resume () { return handle.promise().take(); }
+
+			handle_type handle;
+		};
+
+		return Awaiter { _handle };
+	}
+
+	handle_type handle () const noexcept { return _handle; }
+
+private:
+	handle_type _handle;
+};
+
+template <class T>
+Task<T> detail::TaskPromise<T>::get_return_object () noexcept {
+	return Task<T>(std::coroutine_handle<TaskPromise>::from_promise(*this));
+}
+
+inline Task<void> detail::TaskPromise<void>::get_return_object () noexcept {
+	return Task<void>(std::coroutine_handle<TaskPromise>::from_promise(*this));
+}
+
+/*
+** Awaits a number of tasks which run concurrently. The results are
+** returned in the order of the tasks. If tasks fail, the exception of the
+** first of them is thrown once all of them have completed
+*/
+template <class T>
+class WhenAll {
+public:
+	explicit WhenAll (std::vector<Task<T>> tasks) noexcept
+		: _tasks(std::move(tasks)) {}
+
+	bool await_ready () const noexcept { return _tasks.empty(); }
+
+	/*
+	** Starts each task in turn. A task runs until it awaits a command, so
+	** all of the tasks' first commands are submitted before the awaiting
+	** coroutine suspends. The extra count keeps a task that completes
+	** during this loop from resuming the awaiting coroutine
+	*/
+	bool await_suspend (std::coroutine_handle<> awaiting) noexcept {
+		_remaining = _tasks.size() + 1;
+
+		for (Task<T>& task : _tasks) {
+			task.handle().promise().continuation = awaiting;
+			task.handle().promise().remaining = &_remaining;
+			task.handle().resume();
+		}
+
+		return --_remaining != 0;
+	}
+
+	auto await_resume () {
+		if constexpr (std::is_void_v<T>) {
+			for (Task<T>& task : _tasks) {
+				task.handle().promise().take();
+			}
+		}
+		else {
+			std::vector<T> results;
+
+			results.reserve(_tasks.size());
+
+			for (Task<T>& task : _tasks) {
+				results.push_back(task.handle().promise().take());
+			}
+
+			return results;
+		}
+	}
+
+private:
+	std::vector<Task<T>> _tasks;
+	std::size_t _remaining = 0;
+};
+
+template <class T>
+Task<std::conditional_t<std::is_void_v<T>, void, std::vector<T>>>
+when_all (std::vector<Task<T>> tasks) {
+	co_return co_await WhenAll<T>(std::move(tasks));
+}
+
+/*
+** A pool of authenticated RRP sessions (see RRPCreateSessionPool())
+*/
+class Pool {
+public:
+	/*
+	** Suspends the awaiting coroutine until the response to a request
+	** arrives. The request is submitted when the coroutine suspends
+	*/
+	class Command {
+	public:
+		Command (RRPSESSIONPOOL* pool, Request request) noexcept
+			: _pool(pool), _request(std::move(request)) {}
+
+		bool await_ready () const noexcept { return false; }
+
+		bool await_suspend (std::coroutine_handle<> awaiting) noexcept {
+			_awaiting = awaiting;
+
+			if (RRPSubmitPoolRequest(_pool, _request.get(), complete,
+				this) < 0) {
+				_error = RRPGetInternalErrorCode();
+				return false;
+			}
+
+			_request.release();
+
+			return true;
+		}
+
+		Response await_resume () {
+			if (_response == nullptr) {
+				RRPSetInternalErrorCode(_error);
+				Error::raise();
+			}
+
+			return Response(std::exchange(_response, nullptr));
+		}
+
+	private:
+		static void complete (RRPREQUEST*, RRPRESPONSE* response,
+			void* context) {
+			Command* command = static_cast<Command*>(context);
+
+			command->_response = response;
+			command->_error = RRPGetInternalErrorCode();
+			command->_awaiting.resume();
+		}
+
+		RRPSESSIONPOOL* _pool;
+		Request _request;
+		RRPRESPONSE* _response = nullptr;
+		RRPINTERNAL_ERROR_CODE _error = RRP_NO_ERROR;
+		std::coroutine_handle<> _awaiting;
+	};
+
+	/*
+	** Opens 'sessions' sessions to an RRP server. Throws rrp::Error if a
+	** session can not be opened (RRP_SESSION_REFUSED_ERROR if the server
+	** rejects the login)
+	*/
+	Pool (std::string_view host, unsigned short port,
+		std::string_view id, std::string_view password, int sessions = 1) {
+		std::string hostName(host);
+		std::string registrarID(id);
+		std::string registrarPassword(password);
+
+		_pool = RRPCreateSessionPool(hostName.data(), port,
+			registrarID.data(), registrarPassword.data(), sessions);
+
+		if (_pool == nullptr) {
+			Error::raise();
+		}
+	}
+
+	Pool (const Pool&) = delete;
+	Pool& operator= (const Pool&) = delete;
+
+	Pool (Pool&& other) noexcept
+		: _pool(std::exchange(other._pool, nullptr)) {}
+
+	Pool& operator= (Pool&& other) noexcept {
+		std::swap(_pool, other._pool);
+		return *this;
+	}
+
+	/*
+	** Closes the sessions. Coroutines still awaiting a command are
+	** resumed with rrp::Error (RRP_NOT_CONNECTED_ERROR)
+	*/
+	~Pool () {
+		if (_pool != nullptr) {
+			RRPFreeSessionPool(_pool);
+		}
+	}
+
+	/*
+	** Sets the number of requests each session sends before it waits
+	** for a response (see RRPSetSessionWindow())
+	*/
+	void set_window (int window) {
+		if (RRPSetSessionPoolWindow(_pool, window) < 0) {
+			Error::raise();
+		}
+	}
+
+	int pending () const noexcept { return RRPGetSessionPoolPending(_pool); }
+
+	/*
+	** Waits up to 'timeout' milliseconds (-1 for no limit) for responses
+	** and resumes the coroutines awaiting them (see RRPPollSessionPool()).
+	** Returns the number of commands completed
+	*/
+	int poll (int timeout = -1) {
+		int completed = RRPPollSessionPool(_pool, timeout);
+
+		if (completed < 0) {
+			Error::raise();
+		}
+
+		return completed;
+	}
+
+	/*
+	** Starts a task and polls the pool until the task completes, then
+	** returns its result or throws its exception
+	*/
+	template <class T>
+	T run (Task<T> task) {
+		task.handle().resume();
+
+		while (!task.done()) {
+			if (pending() == 0) {
+				throw std::logic_error("rrp::Pool::run: task awaits nothing");
+			}
+			poll();
+		}
+
+		return task.handle().promise().take();
+	}
+
+	Command execute (Request request) {
+		return Command(_pool, std::move(request));
+	}
+
+	Command check_domain (std::string_view domainName) {
+		return entity_command(RRP_CHECK_COMMAND, RRP_DOMAIN_ENTITY, domainName);
+	}
+
+	Command check_nameserver (std::string_view nameServer) {
+		return entity_command(RRP_CHECK_COMMAND, RRP_NAMESERVER_ENTITY, nameServer);
+	}
+
+	Command status_domain (std::string_view domainName) {
+		return entity_command(RRP_STATUS_COMMAND, RRP_DOMAIN_ENTITY, domainName);
+	}
+
+	Command status_nameserver (std::string_view nameServer) {
+		return entity_command(RRP_STATUS_COMMAND, RRP_NAMESERVER_ENTITY, nameServer);
+	}
+
+	Command delete_domain (std::string_view domainName) {
+		return entity_command(RRP_DEL_COMMAND, RRP_DOMAIN_ENTITY, domainName);
+	}
+
+	Command delete_nameserver (std::string_view nameServer) {
+		return entity_command(RRP_DEL_COMMAND, RRP_NAMESERVER_ENTITY, nameServer);
+	}
+
+	Command restore_domain (std::string_view domainName) {
+		return entity_command(RRP_RESTORE_COMMAND, RRP_DOMAIN_ENTITY, domainName);
+	}
+
+	/*
+	** 'nameServers' may be any range of strings, or a braced list
+	*/
+	template <class Range = std::initializer_list<std::string_view>>
+	Command add_domain (std::string_view domainName,
+		const Range& nameServers = {}, int registrationPeriod = 0) {
+		Request request(RRP_ADD_COMMAND, RRP_DOMAIN_ENTITY, domainName);
+
+		request.add_each("NameServer", nameServers);
+
+		if (registrationPeriod > 0) {
+			request.add("-Period", registrationPeriod);
+		}
+
+		return execute(std::move(request));
+	}
+
+	template <class Range = std::initializer_list<std::string_view>>
+	Command add_nameserver (std::string_view nameServer,
+		const Range& ipAddresses = {}) {
+		Request request(RRP_ADD_COMMAND, RRP_NAMESERVER_ENTITY, nameServer);
+
+		request.add_each("IPAddress", ipAddresses);
+
+		return execute(std::move(request));
+	}
+
+	Command renew_domain (std::string_view domainName,
+		int renewRegistrationPeriod = 0, int currentExpirationYear = 0) {
+		Request request(RRP_RENEW_COMMAND, RRP_DOMAIN_ENTITY, domainName);
+
+		if (renewRegistrationPeriod > 0) {
+			request.add("-Period", renewRegistrationPeriod);
+		}
+
+		if (currentExpirationYear > 0) {
+			request.add("-CurrentExpirationYear", currentExpirationYear);
+		}
+
+		return execute(std::move(request));
+	}
+
+	/*
+	** Requests the transfer of a domain if 'approve' is empty, otherwise
+	** approves ("yes") or denies ("no") a transfer
+	*/
+	Command transfer_domain (std::string_view domainName,
+		std::string_view approve = std::string_view()) {
+		Request request(RRP_TRANSFER_COMMAND, RRP_DOMAIN_ENTITY, domainName);
+
+		if (!approve.empty()) {
+			request.add("-Approve", approve);
+		}
+
+		return execute(std::move(request));
+	}
+
+	/*
+	** Updates the name servers and statuses of a domain (see
+	** rrp::Session::modify_domain())
+	*/
+	template <class Range = std::initializer_list<std::string_view>>
+	Command modify_domain (std::string_view domainName,
+		const Range& addedNameServers = {},
+		const Properties& modifiedNameServers = Properties(),
+		const Range& deletedNameServers = {},
+		const Range& addedStatuses = {},
+		const Properties& modifiedStatuses = Properties(),
+		const Range& deletedStatuses = {}) {
+		Request request(RRP_MOD_COMMAND, RRP_DOMAIN_ENTITY, domainName);
+
+		request.change("NameServer", addedNameServers, modifiedNameServers,
+			deletedNameServers);
+		request.change("Status", addedStatuses, modifiedStatuses,
+			deletedStatuses);
+
+		return execute(std::move(request));
+	}
+
+	/*
+	** Renames a name server if 'newNameServer' is not empty, and updates
+	** its IP addresses (see rrp::Session::modify_nameserver())
+	*/
+	template <class Range = std::initializer_list<std::string_view>>
+	Command modify_nameserver (std::string_view nameServer,
+		std::string_view newNameServer = std::string_view(),
+		const Range& addedIPAddresses = {},
+		const Properties& modifiedIPAddresses = Properties(),
+		const Range& deletedIPAddresses = {}) {
+		Request request(RRP_MOD_COMMAND, RRP_NAMESERVER_ENTITY, nameServer);
+
+		if (!newNameServer.empty()) {
+			request.add("NewNameServer", newNameServer);
+		}
+
+		request.change("IPAddress", addedIPAddresses, modifiedIPAddresses,
+			deletedIPAddresses);
+
+		return execute(std::move(request));
+	}
+
+	Command sync_domain (std::string_view domainName,
+		std::string_view syncDate) {
+		Request request(RRP_SYNC_COMMAND, RRP_DOMAIN_ENTITY, domainName);
+
+		request.add("date", syncDate);
+
+		return execute(std::move(request));
+	}
+
+	RRPSESSIONPOOL* get () const noexcept { return _pool; }
+
+private:
+	Command entity_command (RRPCOMMAND command, RRPENTITY entity,
+		std::string_view name) {
+		return execute(Request(command, entity, name));
+	}
+
+	RRPSESSIONPOOL* _pool;
+};
+
+} /* namespace rrp */
+
+#endif /* _RRP_ASYNC_HPP_ */
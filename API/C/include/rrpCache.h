@@ -0,0 +1,246 @@
+/* ===========================================================================
+ * Copyright (C) 2000 VeriSign, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * VeriSign Global Registry Service
+ * 21345 Ridgetop Circle
+ * Dulles, VA 20166
+ * ===========================================================================
+ * The RRP, APIs and Software are provided "as-is" and without any warranty
+ * of any kind.  NSI EXPRESSLY DISCLAIMS ALL WARRANTIES AND/OR CONDITIONS,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * AND CONDITIONS OF MERCHANTABILITY OR SATISFACTORY QUALITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE AND NONINFRINGEMENT OF THIRD PARTY RIGHTS.  NSI DOES
+ * NOT WARRANT THAT THE FUNCTIONS CONTAINED IN THE RRP, APIs OR SOFTWARE
+ * WILL MEET REGISTRAR'S REQUIREMENTS, OR THAT THE OPERATION OF THE RRP,
+ * APIs OR SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE,OR THAT DEFECTS IN
+ * THE RRP, APIs OR SOFTWARE WILL BE CORRECTED.  FURTHERMORE, NSI DOES NOT
+ * WARRANT NOR MAKE ANY REPRESENTATIONS REGARDING THE USE OR THE RESULTS OF
+ * THE RRP, APIs, SOFTWARE OR RELATED DOCUMENTATION IN TERMS OF THEIR
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR OTHERWISE.  SHOULD THE RRP, APIs
+ * OR SOFTWARE PROVE DEFECTIVE, REGISTRAR ASSUMES THE ENTIRE COST OF ALL
+ * NECESSARY SERVICING, REPAIR OR CORRECTION.
+ * ======================================================================== */
+
+/*
+**
+** Module Name: rrpCache.h
+**
+** Version: 2.1 for RRP version 2.1.0
+**
+** Date: Oct. 19th, 2026
+**
+** Description: rrpCache keeps the responses to Check and Status
+**              requests for a while, so that a name asked about again is
+**              answered from memory rather than by the registry.
+**
+**              Each result has its own time to live: "not found" (545)
+**              and "available" (210, 212) results can be kept for less
+**              (or more) time than the others (200, 211, 213). Other
+**              response codes are never kept. Only requests that carry
+**              no attribute besides the entity name are cached.
+**
+**              Add, Del, Mod, Renew, Restore, Sync and Transfer requests
+**              drop the entry of their name when they complete
+**              (RRPCacheResponse()), and RRPInvalidateCache() drops an
+**              entry on demand. A response received after its name was
+**              dropped is not kept, since it may predate the change.
+**
+**              The entries are spread over stripes, each with its own
+**              lock, so that threads looking up different names seldom
+**              wait for each other.
+**
+**              In the event of an internal error (bad parameter, memory
+**              allocation error, etc.) each function will return a
+**              value indicating that an error has occured (see function
+**              descriptions below). An internal error code that
+**              identifies the error will be set. The error code can
+**              be accessed and interpreted by the functions defined in
+**              rrpInternalError.h (see API documentation)
+**
+** Note:        The functions can be called from any thread.
+**
+** Entry Points:
+**
+**    RRPCreateCache(int, int, int, int, int);
+**    RRPGetCachedResponse(RRPCACHE*, RRPREQUEST*, unsigned long*);
+**    RRPCacheResponse(RRPCACHE*, RRPREQUEST*, RRPRESPONSE*,
+**        unsigned long);
+**    RRPInvalidateCache(RRPCACHE*, RRPENTITY, char*);
+**    RRPGetCacheStatistics(RRPCACHE*, RRPCACHESTATISTICS*);
+**    RRPFreeCache(RRPCACHE*);
+**
+** Changes:
+**
+*/
+
+#ifndef _RRP_CACHE_H_
+#define _RRP_CACHE_H_
+
+#include "rrpAPI.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+** The structure is private to rrpCache.c
+*/
+typedef struct _RRPCACHE  RRPCACHE;
+
+/*
+** Counts of the lookups and updates of a cache (see
+** RRPGetCacheStatistics())
+*/
+typedef struct {
+	unsigned long hits;          /* lookups answered from the cache */
+	unsigned long misses;        /* lookups not answered */
+	unsigned long stores;        /* responses kept */
+	unsigned long invalidations; /* entries dropped after a change */
+	unsigned long evictions;     /* entries dropped to make room */
+} RRPCACHESTATISTICS;
+
+/*
+**
+** Function: RRPCreateCache
+**
+** Description: Creates an empty response cache
+**
+** Input: int - number of stripes (locks). 0 selects a default
+**        int - maximum number of names kept. The oldest entries are
+**              dropped to make room
+**        int - time to live of found results, in seconds
+**        int - time to live of "not found" results, in seconds
+**        int - time to live of "available" results, in seconds
+**
+**        A time to live of 0 keeps no result of that kind.
+**
+** Output: none
+**
+** Return: RRPCACHE* - a pointer to an RRPCACHE structure. NULL is returned
+**                     if an internal error occurs.
+**
+** Note: THE CACHE MUST BE RELEASED BY CALLING RRPFreeCache()
+**
+*/
+RRPCACHE* RRPCreateCache(int, int, int, int, int);
+
+/*
+**
+** Function: RRPGetCachedResponse
+**
+** Description: Looks up the response to a Check or Status request
+**
+** Input: RRPCACHE* - a pointer to an RRPCACHE structure
+**        RRPREQUEST* - the request
+**
+** Output: unsigned long* - optional (may be NULL). Receives the version
+**                          of the request's entry, to be passed to
+**                          RRPCacheResponse() with the response from the
+**                          registry on a miss
+**
+** Return: RRPRESPONSE* - a copy of the cached response (see
+**                        RRPCloneResponse()). NULL is returned on a miss,
+**                        with the internal error code set to
+**                        RRP_NO_ERROR, or if an internal error occurs.
+**
+** Note: THE MEMORY ALLOCATED FOR THE RRPRESPONSE STRUCTURE MUST BE
+**       RELEASED BY CALLING THE RRPFreeResponse() FUNCTION
+**
+*/
+RRPRESPONSE* RRPGetCachedResponse(RRPCACHE*, RRPREQUEST*, unsigned long*);
+
+/*
+**
+** Function: RRPCacheResponse
+**
+** Description: Updates a cache with the outcome of a request. The
+**              response to a Check or Status request is kept (a copy of
+**              it), unless the name's entry was dropped since the version
+**              was read. A request that changes its entity drops the
+**              name's entry, even when it failed without a response,
+**              since the change may still have happened
+**
+** Input: RRPCACHE* - a pointer to an RRPCACHE structure
+**        RRPREQUEST* - the request
+**        RRPRESPONSE* - its response, or NULL if it failed
+**        unsigned long - the version returned by RRPGetCachedResponse()
+**                        before the request was sent
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful, whether or not the response
+**               was kept. -1 is returned if an internal error occurs.
+**
+*/
+int RRPCacheResponse(RRPCACHE*, RRPREQUEST*, RRPRESPONSE*, unsigned long);
+
+/*
+**
+** Function: RRPInvalidateCache
+**
+** Description: Drops the entry of a name (e.g. after it was changed by
+**              another program)
+**
+** Input: RRPCACHE* - a pointer to an RRPCACHE structure
+**        RRPENTITY - the entity
+**        char* - the domain name or name server host name
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+int RRPInvalidateCache(RRPCACHE*, RRPENTITY, char*);
+
+/*
+**
+** Function: RRPGetCacheStatistics
+**
+** Description: Returns the counts of the lookups and updates of a cache
+**
+** Input: RRPCACHE* - a pointer to an RRPCACHE structure
+**
+** Output: RRPCACHESTATISTICS* - the counts
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+int RRPGetCacheStatistics(RRPCACHE*, RRPCACHESTATISTICS*);
+
+/*
+**
+** Function: RRPFreeCache
+**
+** Description: Frees a cache and the responses it keeps
+**
+** Input: RRPCACHE* - a pointer to an RRPCACHE structure
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+int RRPFreeCache(RRPCACHE*);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _RRP_CACHE_H_ */
@@ -0,0 +1,325 @@
+/* ===========================================================================
+ * Copyright (C) 2000 VeriSign, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * VeriSign Global Registry Service
+ * 21345 Ridgetop Circle
+ * Dulles, VA 20166
+ * ===========================================================================
+ * The RRP, APIs and Software are provided "as-is" and without any warranty
+ * of any kind.  NSI EXPRESSLY DISCLAIMS ALL WARRANTIES AND/OR CONDITIONS,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * AND CONDITIONS OF MERCHANTABILITY OR SATISFACTORY QUALITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE AND NONINFRINGEMENT OF THIRD PARTY RIGHTS.  NSI DOES
+ * NOT WARRANT THAT THE FUNCTIONS CONTAINED IN THE RRP, APIs OR SOFTWARE
+ * WILL MEET REGISTRAR'S REQUIREMENTS, OR THAT THE OPERATION OF THE RRP,
+ * APIs OR SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE,OR THAT DEFECTS IN
+ * THE RRP, APIs OR SOFTWARE WILL BE CORRECTED.  FURTHERMORE, NSI DOES NOT
+ * WARRANT NOR MAKE ANY REPRESENTATIONS REGARDING THE USE OR THE RESULTS OF
+ * THE RRP, APIs, SOFTWARE OR RELATED DOCUMENTATION IN TERMS OF THEIR
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR OTHERWISE.  SHOULD THE RRP, APIs
+ * OR SOFTWARE PROVE DEFECTIVE, REGISTRAR ASSUMES THE ENTIRE COST OF ALL
+ * NECESSARY SERVICING, REPAIR OR CORRECTION.
+ * ======================================================================== */
+
+/*
+**
+** Module Name: rrpCalendar.h
+**
+** Version: 2.1 for RRP version 2.1.0
+**
+** Date: Oct. 19th, 2026
+**
+** Description: rrpCalendar indexes domain names by their registration
+**              expiration date, so that the domains due for renewal can
+**              be found without scanning the whole portfolio.
+**
+**              An RRPCALENDAR is a time wheel of day-sized buckets: a
+**              domain is kept in the bucket of its expiration day, which
+**              is found by taking the day number modulo the number of
+**              buckets (RRP_CALENDAR_DAYS, more than the longest
+**              registration period). The calendar remembers the first
+**              day whose domains have not all been taken, so finding the
+**              due domains visits the buckets of the days elapsed since
+**              and the domains they hold: its cost is proportional to
+**              the number of due domains, not to the size of the
+**              calendar. A table of the names allows a domain to be
+**              moved or removed in constant time.
+**
+**              The expiration dates are usually taken from Status
+**              responses (see RRPAddCalendarResponse()). The due domains
+**              are renewed with RRPRenewCalendarDomains(), which
+**              pipelines the Renew commands over a session pool (see
+**              rrpSession.h) and gives each the current expiration year,
+**              so that a domain is never renewed twice for the same
+**              year. A domain renewed is indexed again under the new
+**              expiration date returned by the server.
+**
+**              In the event of an internal error (bad parameter, memory
+**              allocation error, etc.) each function will return a
+**              value indicating that an error has occured (see function
+**              descriptions below). An internal error code that
+**              identifies the error will be set. The error code can
+**              be accessed and interpreted by the functions defined in
+**              rrpInternalError.h (see API documentation)
+**
+** Entry Points:
+**
+**    RRPCreateCalendar(time_t);
+**    RRPAddCalendarDomain(RRPCALENDAR*, char*, time_t);
+**    RRPAddCalendarResponse(RRPCALENDAR*, char*, RRPRESPONSE*);
+**    RRPRemoveCalendarDomain(RRPCALENDAR*, char*);
+**    RRPGetCalendarExpiration(RRPCALENDAR*, char*);
+**    RRPGetCalendarSize(RRPCALENDAR*);
+**    RRPRenewCalendarDomains(RRPCALENDAR*, time_t, int, RRPSESSIONPOOL*,
+**        int);
+**    RRPGetCalendarRenewals(RRPCALENDAR*, int*);
+**    RRPFreeCalendar(RRPCALENDAR*);
+**
+** Changes:
+**
+*/
+
+#ifndef _RRP_CALENDAR_H_
+#define _RRP_CALENDAR_H_
+
+#include <time.h>
+#include "rrpAPI.h"
+#include "rrpSession.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+** Number of day-sized buckets of the time wheel. Domains expiring this
+** many days or more after the first day not taken share buckets with
+** earlier days, which only costs time when those buckets are visited
+*/
+#ifndef RRP_CALENDAR_DAYS
+	#define RRP_CALENDAR_DAYS 4096
+#endif
+
+/*
+** The structure is private to rrpCalendar.c
+*/
+typedef struct _RRPCALENDAR  RRPCALENDAR;
+
+/*
+** One domain taken by RRPRenewCalendarDomains() (see
+** RRPGetCalendarRenewals())
+*/
+typedef struct {
+	char* name;                 /* domain name, which belongs to the
+	                               calendar */
+	time_t expiration;          /* expiration date before the renewal */
+	time_t renewedExpiration;   /* expiration date after the renewal,
+	                               (time_t) -1 unless renewed */
+	int code;                   /* RRP response code, -1 if the Renew
+	                               command failed */
+} RRPCALENDARRENEWAL;
+
+/*
+**
+** Function: RRPCreateCalendar
+**
+** Description: Creates an empty calendar
+**
+** Input: time_t - the first day whose domains can be taken. Domains
+**                 that expire before it are due on that day
+**
+** Output: none
+**
+** Return: RRPCALENDAR* - a pointer to an allocated RRPCALENDAR
+**                        structure. NULL is returned if an internal
+**                        error occurs.
+**
+** Note: THE MEMORY ALLOCATED FOR THE RRPCALENDAR STRUCTURE MUST BE
+**       RELEASED BY CALLING THE RRPFreeCalendar() FUNCTION
+**
+*/
+RRPCALENDAR* RRPCreateCalendar(time_t);
+
+/*
+**
+** Function: RRPAddCalendarDomain
+**
+** Description: Adds a domain to a calendar. A domain that is already in
+**              the calendar is moved to its new expiration date
+**
+** Input: RRPCALENDAR* - a pointer to an RRPCALENDAR structure
+**        char* - the domain name
+**        time_t - the registration expiration date
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+int RRPAddCalendarDomain(RRPCALENDAR*, char*, time_t);
+
+/*
+**
+** Function: RRPAddCalendarResponse
+**
+** Description: Adds a domain to a calendar under the registration
+**              expiration date of a Status or Renew response (see
+**              RRPGetExpirationDate())
+**
+** Input: RRPCALENDAR* - a pointer to an RRPCALENDAR structure
+**        char* - the domain name
+**        RRPRESPONSE* - the response
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if the
+**               response has no expiration date (RRP_BAD_PARAM_ERROR)
+**               or if an internal error occurs.
+**
+*/
+int RRPAddCalendarResponse(RRPCALENDAR*, char*, RRPRESPONSE*);
+
+/*
+**
+** Function: RRPRemoveCalendarDomain
+**
+** Description: Removes a domain from a calendar
+**
+** Input: RRPCALENDAR* - a pointer to an RRPCALENDAR structure
+**        char* - the domain name
+**
+** Output: none
+**
+** Return: int - 1 is returned if the domain was removed, 0 if it was
+**               not in the calendar. -1 is returned if an internal
+**               error occurs.
+**
+*/
+int RRPRemoveCalendarDomain(RRPCALENDAR*, char*);
+
+/*
+**
+** Function: RRPGetCalendarExpiration
+**
+** Description: Returns the expiration date of a domain of a calendar
+**
+** Input: RRPCALENDAR* - a pointer to an RRPCALENDAR structure
+**        char* - the domain name
+**
+** Output: none
+**
+** Return: time_t - the expiration date. (time_t) -1 is returned if the
+**                  domain is not in the calendar or if an internal
+**                  error occurs.
+**
+*/
+time_t RRPGetCalendarExpiration(RRPCALENDAR*, char*);
+
+/*
+**
+** Function: RRPGetCalendarSize
+**
+** Description: Returns the number of domains of a calendar
+**
+** Input: RRPCALENDAR* - a pointer to an RRPCALENDAR structure
+**
+** Output: none
+**
+** Return: int - the number of domains. -1 is returned if an internal
+**               error occurs.
+**
+*/
+int RRPGetCalendarSize(RRPCALENDAR*);
+
+/*
+**
+** Function: RRPRenewCalendarDomains
+**
+** Description: Takes the domains of a calendar that expire at or before
+**              a date, earliest day first, and renews them. The Renew
+**              commands are pipelined over the sessions of a pool and
+**              give the current expiration year of the domain. A domain
+**              renewed is added again under the expiration date of the
+**              response, if it has one; a domain whose Renew command failed (its
+**              session's connection failed, etc.) is added again under
+**              its old date, so that it is due again; a domain whose
+**              renewal was refused is removed from the calendar. The
+**              outcome of each domain taken can be read with
+**              RRPGetCalendarRenewals()
+**
+** Input: RRPCALENDAR* - a pointer to an RRPCALENDAR structure
+**        time_t - the date
+**        int - the renewal period in years, 0 for the server's default
+**        RRPSESSIONPOOL* - a pointer to an RRPSESSIONPOOL structure
+**        int - the most domains to take
+**
+** Output: none
+**
+** Return: int - the number of domains renewed. -1 is returned if an
+**               internal error occurs.
+**
+** Note: If -1 is returned, Renew commands may still be in flight. They
+**       complete at the next call with the same pool, or when the pool
+**       is freed, which must then be done before freeing the calendar
+**
+*/
+int RRPRenewCalendarDomains(RRPCALENDAR*, time_t, int, RRPSESSIONPOOL*,
+	int);
+
+/*
+**
+** Function: RRPGetCalendarRenewals
+**
+** Description: Returns the domains taken by the last call to
+**              RRPRenewCalendarDomains(), in the order they were taken
+**
+** Input: RRPCALENDAR* - a pointer to an RRPCALENDAR structure
+**
+** Output: int* - the number of domains
+**
+** Return: RRPCALENDARRENEWAL* - array of renewals, which belongs to the
+**                               RRPCALENDAR structure. NULL is returned
+**                               if an internal error occurs.
+**
+*/
+RRPCALENDARRENEWAL* RRPGetCalendarRenewals(RRPCALENDAR*, int*);
+
+/*
+**
+** Function: RRPFreeCalendar
+**
+** Description: Frees all of the memory allocated for an RRPCALENDAR
+**              structure
+**
+** Input: RRPCALENDAR* - a pointer to an RRPCALENDAR structure
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+** Note: If RRPRenewCalendarDomains() failed, the session pool it used
+**       must be freed first, since Renew commands may still be in flight
+**
+*/
+int RRPFreeCalendar(RRPCALENDAR*);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _RRP_CALENDAR_H_ */
@@ -0,0 +1,539 @@
+/* ===========================================================================
+ * Copyright (C) 2000 VeriSign, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * VeriSign Global Registry Service
+ * 21345 Ridgetop Circle
+ * Dulles, VA 20166
+ * ===========================================================================
+ * The RRP, APIs and Software are provided "as-is" and without any warranty
+ * of any kind.  NSI EXPRESSLY DISCLAIMS ALL WARRANTIES AND/OR CONDITIONS,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * AND CONDITIONS OF MERCHANTABILITY OR SATISFACTORY QUALITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE AND NONINFRINGEMENT OF THIRD PARTY RIGHTS.  NSI DOES
+ * NOT WARRANT THAT THE FUNCTIONS CONTAINED IN THE RRP, APIs OR SOFTWARE
+ * WILL MEET REGISTRAR'S REQUIREMENTS, OR THAT THE OPERATION OF THE RRP,
+ * APIs OR SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE,OR THAT DEFECTS IN
+ * THE RRP, APIs OR SOFTWARE WILL BE CORRECTED.  FURTHERMORE, NSI DOES NOT
+ * WARRANT NOR MAKE ANY REPRESENTATIONS REGARDING THE USE OR THE RESULTS OF
+ * THE RRP, APIs, SOFTWARE OR RELATED DOCUMENTATION IN TERMS OF THEIR
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR OTHERWISE.  SHOULD THE RRP, APIs
+ * OR SOFTWARE PROVE DEFECTIVE, REGISTRAR ASSUMES THE ENTIRE COST OF ALL
+ * NECESSARY SERVICING, REPAIR OR CORRECTION.
+ * ======================================================================== */
+
+/*
+**
+** Module Name: rrpClient.h
+**
+** Version: 2.1 for RRP version 2.1.0
+**
+** Date: Oct. 19th, 2026
+**
+** Description: rrpClient lets any number of threads share the sessions
+**              of an RRPSESSIONPOOL (see rrpSession.h). The pool is
+**              driven by a thread of the client; the other threads
+**              submit requests to it, either waiting for the response
+**              (RRPClientRequest()) or with a completion function that
+**              is called from the client's thread
+**              (RRPSubmitClientRequest()).
+**
+**              Check and Status requests are coalesced: while one is in
+**              flight, an identical request (same command, entity name
+**              and attributes) is not sent again but attached to the
+**              first one, and receives its own copy of the same response
+**              when it arrives (see RRPCloneResponse()). Popular names
+**              asked about by several threads at once then cost a single
+**              command. The copies share the response's attributes, so
+**              they are cheap however many requests are attached.
+**
+**              Requests belong to priority classes (RRPCLIENTCLASS). The
+**              client keeps them until a session has room in its window
+**              (see RRPSetSessionWindow()), then sends the oldest request
+**              of the highest class first, so interactive commands skip
+**              ahead of queued bulk work rather than waiting behind it
+**              in the sessions' queues. Each class can be limited in the
+**              number of requests it has in flight and can have sessions
+**              reserved for it (RRPSetClientClassLimits()); the latency
+**              of each class, from submission to completion, is reported
+**              by RRPGetClientClassStatistics().
+**
+**              A client can also be given a response cache (see
+**              rrpCache.h and RRPSetClientCache()): Check and Status
+**              requests are then looked up in the calling thread before
+**              being queued, and every response the client receives
+**              updates the cache.
+**
+**              With a retry policy (see rrpRetry.h and
+**              RRPSetClientRetryPolicy()), a request that fails in a way
+**              the policy allows to retry is kept by the client and sent
+**              again once its delay has passed.
+**
+**              In the event of an internal error (bad parameter, memory
+**              allocation error, etc.) each function will return a
+**              value indicating that an error has occured (see function
+**              descriptions below). An internal error code that
+**              identifies the error will be set. The error code can
+**              be accessed and interpreted by the functions defined in
+**              rrpInternalError.h (see API documentation)
+**
+** Note:        The functions can be called from any thread, except
+**              RRPClientRequest() and RRPFreeClient(), which must not be
+**              called from a completion function. The pool must not be
+**              used directly once it belongs to a client.
+**
+** Entry Points:
+**
+**    RRPCreateClient(RRPSESSIONPOOL*);
+**    RRPSubmitClientRequest(RRPCLIENT*, RRPREQUEST*, RRPCOMPLETION,
+**        void*);
+**    RRPSubmitClientClassRequest(RRPCLIENT*, RRPCLIENTCLASS, RRPREQUEST*,
+**        RRPCOMPLETION, void*);
+**    RRPClientRequest(RRPCLIENT*, RRPREQUEST*);
+**    RRPClientClassRequest(RRPCLIENT*, RRPCLIENTCLASS, RRPREQUEST*);
+**    RRPClientCheckDomain(RRPCLIENT*, char*);
+**    RRPClientCheckNameServer(RRPCLIENT*, char*);
+**    RRPClientStatusDomain(RRPCLIENT*, char*);
+**    RRPClientStatusNameServer(RRPCLIENT*, char*);
+**    RRPSetClientCoalescing(RRPCLIENT*, RRPBOOLEAN);
+**    RRPSetClientCache(RRPCLIENT*, RRPCACHE*);
+**    RRPSetClientRetryPolicy(RRPCLIENT*, RRPRETRYPOLICY*);
+**    RRPSetClientClassLimits(RRPCLIENT*, RRPCLIENTCLASS, int, int);
+**    RRPGetClientStatistics(RRPCLIENT*, RRPCLIENTSTATISTICS*);
+**    RRPGetClientClassStatistics(RRPCLIENT*, RRPCLIENTCLASS,
+**        RRPCLIENTCLASSSTATISTICS*);
+**    RRPFreeClient(RRPCLIENT*);
+**
+** Changes:
+**
+*/
+
+#ifndef _RRP_CLIENT_H_
+#define _RRP_CLIENT_H_
+
+#include "rrpAPI.h"
+#include "rrpSession.h"
+#include "rrpCache.h"
+#include "rrpRetry.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+** The structure is private to rrpClient.c
+*/
+typedef struct _RRPCLIENT  RRPCLIENT;
+
+/*
+** Counts of the requests of a client (see RRPGetClientStatistics())
+*/
+typedef struct {
+	unsigned long submitted;    /* requests accepted */
+	unsigned long sent;         /* requests given to the pool */
+	unsigned long coalesced;    /* requests attached to one in flight */
+	unsigned long failed;       /* requests completed without a response */
+	unsigned long retried;      /* requests sent again (see
+	                               RRPSetClientRetryPolicy()) */
+} RRPCLIENTSTATISTICS;
+
+/*
+** Priority classes of requests, from the highest to the lowest
+*/
+typedef enum {
+	RRP_INTERACTIVE_CLASS,
+	RRP_NORMAL_CLASS,
+	RRP_BULK_CLASS
+} RRPCLIENTCLASS;
+
+#define RRP_CLIENT_CLASSES 3
+
+/*
+** Counts and latencies of the requests of a class (see
+** RRPGetClientClassStatistics()). Latencies are in microseconds, from
+** submission to completion, over all the requests completed so far
+*/
+typedef struct {
+	unsigned long submitted;    /* requests accepted */
+	unsigned long completed;    /* requests completed */
+	int queued;                 /* requests waiting for a session */
+	int active;                 /* requests sent, not yet answered */
+	unsigned long median;       /* 50th percentile of the latencies */
+	unsigned long p90;          /* 90th percentile */
+	unsigned long p99;          /* 99th percentile */
+	unsigned long maximum;      /* highest latency */
+} RRPCLIENTCLASSSTATISTICS;
+
+/*
+**
+** Function: RRPCreateClient
+**
+** Description: Creates a client for a session pool and starts the
+**              client's thread
+**
+** Input: RRPSESSIONPOOL* - the pool (see RRPCreateSessionPool()). The
+**                          client takes ownership of the pool if
+**                          successful
+**
+** Output: none
+**
+** Return: RRPCLIENT* - a pointer to an RRPCLIENT structure. NULL is
+**                      returned if an internal error occurs.
+**
+** Note: THE CLIENT MUST BE RELEASED BY CALLING RRPFreeClient()
+**
+*/
+RRPCLIENT* RRPCreateClient(RRPSESSIONPOOL*);
+
+/*
+**
+** Function: RRPSubmitClientRequest
+**
+** Description: Submits a request of RRP_NORMAL_CLASS to a client (see
+**              RRPSubmitClientClassRequest())
+**
+** Input: RRPCLIENT* - a pointer to an RRPCLIENT structure
+**        RRPREQUEST* - the request. The client takes ownership of the
+**                      request if successful
+**        RRPCOMPLETION - function called with the response
+**        void* - context pointer passed to the completion function
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs or if the client is being freed
+**               (RRP_NOT_CONNECTED_ERROR). The request then still
+**               belongs to the caller
+**
+*/
+int RRPSubmitClientRequest(RRPCLIENT*, RRPREQUEST*, RRPCOMPLETION, void*);
+
+/*
+**
+** Function: RRPSubmitClientClassRequest
+**
+** Description: Submits a request of a priority class to a client. The
+**              completion function is called from the client's thread
+**              when the response arrives (see RRPCOMPLETION in
+**              rrpSession.h)
+**
+** Input: RRPCLIENT* - a pointer to an RRPCLIENT structure
+**        RRPCLIENTCLASS - the request's class
+**        RRPREQUEST* - the request. The client takes ownership of the
+**                      request if successful
+**        RRPCOMPLETION - function called with the response
+**        void* - context pointer passed to the completion function
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs or if the client is being freed
+**               (RRP_NOT_CONNECTED_ERROR). The request then still
+**               belongs to the caller
+**
+*/
+int RRPSubmitClientClassRequest(RRPCLIENT*, RRPCLIENTCLASS, RRPREQUEST*,
+	RRPCOMPLETION, void*);
+
+/*
+**
+** Function: RRPClientRequest
+**
+** Description: Submits a request of RRP_NORMAL_CLASS to a client and
+**              waits for its response (see RRPClientClassRequest())
+**
+** Input: RRPCLIENT* - a pointer to an RRPCLIENT structure
+**        RRPREQUEST* - the request, which is released in all cases
+**
+** Output: none
+**
+** Return: RRPRESPONSE* - a pointer to an RRPRESPONSE structure. NULL is
+**                        returned if an internal error occurs.
+**
+** Note: THE MEMORY ALLOCATED FOR THE RRPRESPONSE STRUCTURE MUST BE
+**       RELEASED BY CALLING THE RRPFreeResponse() FUNCTION
+**
+*/
+RRPRESPONSE* RRPClientRequest(RRPCLIENT*, RRPREQUEST*);
+
+/*
+**
+** Function: RRPClientClassRequest
+**
+** Description: Submits a request of a priority class to a client and
+**              waits for its response
+**
+** Input: RRPCLIENT* - a pointer to an RRPCLIENT structure
+**        RRPCLIENTCLASS - the request's class
+**        RRPREQUEST* - the request, which is released in all cases
+**
+** Output: none
+**
+** Return: RRPRESPONSE* - a pointer to an RRPRESPONSE structure containing
+**                        the components of the RRP response returned from
+**                        the server. NULL is returned if an internal
+**                        error occurs, or if the request failed (its
+**                        session's connection failed, etc.)
+**
+** Note: THE MEMORY ALLOCATED FOR THE RRPRESPONSE STRUCTURE MUST BE
+**       RELEASED BY CALLING THE RRPFreeResponse() FUNCTION
+**
+*/
+RRPRESPONSE* RRPClientClassRequest(RRPCLIENT*, RRPCLIENTCLASS, RRPREQUEST*);
+
+/*
+**
+** Function: RRPClientCheckDomain
+**
+** Description: Checks the availability of a domain name through a
+**              client, in RRP_INTERACTIVE_CLASS (see RRPCheckDomain() and
+**              RRPClientClassRequest())
+**
+** Input: RRPCLIENT* - a pointer to an RRPCLIENT structure
+**        char* - a fully qualified domain name
+**
+** Output: none
+**
+** Return: RRPRESPONSE* - a pointer to an RRPRESPONSE structure. NULL is
+**                        returned if an internal error occurs.
+**
+** Note: THE MEMORY ALLOCATED FOR THE RRPRESPONSE STRUCTURE MUST BE
+**       RELEASED BY CALLING THE RRPFreeResponse() FUNCTION
+**
+*/
+RRPRESPONSE* RRPClientCheckDomain(RRPCLIENT*, char*);
+
+/*
+**
+** Function: RRPClientCheckNameServer
+**
+** Description: Checks a name server through a client, in
+**              RRP_INTERACTIVE_CLASS (see RRPCheckNameServer() and
+**              RRPClientClassRequest())
+**
+** Input: RRPCLIENT* - a pointer to an RRPCLIENT structure
+**        char* - the name server's host name
+**
+** Output: none
+**
+** Return: RRPRESPONSE* - a pointer to an RRPRESPONSE structure. NULL is
+**                        returned if an internal error occurs.
+**
+** Note: THE MEMORY ALLOCATED FOR THE RRPRESPONSE STRUCTURE MUST BE
+**       RELEASED BY CALLING THE RRPFreeResponse() FUNCTION
+**
+*/
+RRPRESPONSE* RRPClientCheckNameServer(RRPCLIENT*, char*);
+
+/*
+**
+** Function: RRPClientStatusDomain
+**
+** Description: Gets the status of a domain through a client, in
+**              RRP_INTERACTIVE_CLASS (see RRPStatusDomain() and
+**              RRPClientClassRequest())
+**
+** Input: RRPCLIENT* - a pointer to an RRPCLIENT structure
+**        char* - a fully qualified domain name
+**
+** Output: none
+**
+** Return: RRPRESPONSE* - a pointer to an RRPRESPONSE structure. NULL is
+**                        returned if an internal error occurs.
+**
+** Note: THE MEMORY ALLOCATED FOR THE RRPRESPONSE STRUCTURE MUST BE
+**       RELEASED BY CALLING THE RRPFreeResponse() FUNCTION
+**
+*/
+RRPRESPONSE* RRPClientStatusDomain(RRPCLIENT*, char*);
+
+/*
+**
+** Function: RRPClientStatusNameServer
+**
+** Description: Gets the status of a name server through a client, in
+**              RRP_INTERACTIVE_CLASS (see RRPStatusNameServer() and
+**              RRPClientClassRequest())
+**
+** Input: RRPCLIENT* - a pointer to an RRPCLIENT structure
+**        char* - the name server's host name
+**
+** Output: none
+**
+** Return: RRPRESPONSE* - a pointer to an RRPRESPONSE structure. NULL is
+**                        returned if an internal error occurs.
+**
+** Note: THE MEMORY ALLOCATED FOR THE RRPRESPONSE STRUCTURE MUST BE
+**       RELEASED BY CALLING THE RRPFreeResponse() FUNCTION
+**
+*/
+RRPRESPONSE* RRPClientStatusNameServer(RRPCLIENT*, char*);
+
+/*
+**
+** Function: RRPSetClientCoalescing
+**
+** Description: Turns the coalescing of identical Check and Status
+**              requests on or off (on by default). Requests already in
+**              flight are not affected
+**
+** Input: RRPCLIENT* - a pointer to an RRPCLIENT structure
+**        RRPBOOLEAN - RRPTRUE to coalesce requests
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+int RRPSetClientCoalescing(RRPCLIENT*, RRPBOOLEAN);
+
+/*
+**
+** Function: RRPSetClientCache
+**
+** Description: Gives a response cache to a client. A Check or Status
+**              request found in the cache is completed with a copy of the
+**              cached response without being sent; the completion
+**              function of RRPSubmitClientRequest() is still called from
+**              the client's thread
+**
+** Input: RRPCLIENT* - a pointer to an RRPCLIENT structure
+**        RRPCACHE* - the cache (see RRPCreateCache()), or NULL. The cache
+**                    still belongs to the caller, may be shared by
+**                    several clients and must outlive the client
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+** Note: The cache must be set before any request is submitted
+**
+*/
+int RRPSetClientCache(RRPCLIENT*, RRPCACHE*);
+
+/*
+**
+** Function: RRPSetClientRetryPolicy
+**
+** Description: Gives a retry policy to a client (see rrpRetry.h). A
+**              request that fails as the policy allows is sent again
+**              after the policy's delay, possibly on another session;
+**              its completion function is only called with the last
+**              outcome. The requests attached to it wait for that
+**              outcome as well
+**
+** Input: RRPCLIENT* - a pointer to an RRPCLIENT structure
+**        RRPRETRYPOLICY* - the policy (see RRPCreateRetryPolicy()), or
+**                          NULL to never retry (the default). The
+**                          policy still belongs to the caller and must
+**                          outlive the client
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+** Note: The policy must be set before any request is submitted
+**
+*/
+int RRPSetClientRetryPolicy(RRPCLIENT*, RRPRETRYPOLICY*);
+
+/*
+**
+** Function: RRPSetClientClassLimits
+**
+** Description: Limits the requests of a priority class. Sessions are
+**              reserved from the first session of the pool on, in the
+**              order of the classes: a session reserved for a class is
+**              only used by that class and the classes above it
+**
+** Input: RRPCLIENT* - a pointer to an RRPCLIENT structure
+**        RRPCLIENTCLASS - the class
+**        int - the most requests of the class sent at once, or 0 for no
+**              limit (the default)
+**        int - number of sessions reserved for the class (0 by default).
+**              At least one session of the pool must be left unreserved
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+int RRPSetClientClassLimits(RRPCLIENT*, RRPCLIENTCLASS, int, int);
+
+/*
+**
+** Function: RRPGetClientStatistics
+**
+** Description: Returns the counts of the requests of a client
+**
+** Input: RRPCLIENT* - a pointer to an RRPCLIENT structure
+**
+** Output: RRPCLIENTSTATISTICS* - the counts
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+int RRPGetClientStatistics(RRPCLIENT*, RRPCLIENTSTATISTICS*);
+
+/*
+**
+** Function: RRPGetClientClassStatistics
+**
+** Description: Returns the counts and latencies of the requests of a
+**              priority class
+**
+** Input: RRPCLIENT* - a pointer to an RRPCLIENT structure
+**        RRPCLIENTCLASS - the class
+**
+** Output: RRPCLIENTCLASSSTATISTICS* - the counts and latencies. The
+**                                     percentiles are rounded up, by at
+**                                     most a quarter
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+int RRPGetClientClassStatistics(RRPCLIENT*, RRPCLIENTCLASS,
+	RRPCLIENTCLASSSTATISTICS*);
+
+/*
+**
+** Function: RRPFreeClient
+**
+** Description: Completes the requests submitted to a client, stops the
+**              client's thread, then frees the pool (see
+**              RRPFreeSessionPool()) and the client
+**
+** Input: RRPCLIENT* - a pointer to an RRPCLIENT structure
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+int RRPFreeClient(RRPCLIENT*);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _RRP_CLIENT_H_ */
@@ -61,8 +61,19 @@
 **  RRPSetTimeout (unsigned);
 ** 	RRPCreateConnection (char*, unsigned short int);
 ** 	RRPSendRequest(char*);
+** 	RRPSendRequestData(const char*, size_t);
 ** 	RRPReadResponse();
 ** 	RRPCloseConnection();
+** 	RRPOpenConnection(char*, unsigned short int);
+** 	RRPOpenLocalConnection(char*);
+** 	RRPGetConnectionGreeting(RRPCONNECTION*);
+** 	RRPGetConnectionDescriptor(RRPCONNECTION*);
+** 	RRPSetConnectionBlocking(RRPCONNECTION*, int);
+** 	RRPWriteConnection(RRPCONNECTION*, const char*, size_t);
+** 	RRPFillConnection(RRPCONNECTION*);
+** 	RRPNextConnectionResponse(RRPCONNECTION*, char**);
+** 	RRPReadConnectionResponse(RRPCONNECTION*);
+** 	RRPFreeConnection(RRPCONNECTION*);
 **
 **
 **  IMPORTANT: THIS IMPLEMENTATION OF THE RRP API IS NOT
@@ -77,11 +88,32 @@
 **
 ** Changes:
 **
+** Oct. 19th, 2026: RRPSendRequestData() sends a request string whose
+** length is already known. Both send functions now keep writing until
+** the whole request has been sent. A secure replacement of
+** rrpConnection.c must implement RRPSendRequestData() as well.
+**
+** Oct. 19th, 2026: Connection handles (RRPOpenConnection() and the
+** functions that take an RRPCONNECTION*) allow several connections at
+** once, non-blocking operation, and pipelined requests. They must also
+** be implemented by a secure replacement of rrpConnection.c.
+**
+** Oct. 19th, 2026: RRPOpenLocalConnection() connects to a Unix domain
+** socket, such as that of a session broker (see rrpBroker.c). A secure
+** replacement of rrpConnection.c must implement it as well, but need not
+** encrypt it: the socket never leaves the host.
+**
 */
 
 #ifndef _RRP_CONNECTION_H_
 #define _RRP_CONNECTION_H_
 
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 #ifndef RRPBUFSIZE
 	#define RRPBUFSIZE 256
 #endif
@@ -136,6 +168,26 @@ int RRPCreateConnection (char*, unsigned short int);
 */
 int RRPSendRequest (char*);
 
+/*
+**
+** Function: RRPSendRequestData
+**
+** Description: Sends an RRP request string of a known length to the RRP
+**              server
+**
+** Input: const char* - the RRP request string to send to the server. Need
+**                      not be NUL terminated
+**        size_t - the length of the request string
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+**
+*/
+int RRPSendRequestData (const char*, size_t);
+
 /*
 **
 ** Function: RRPReadResponse
@@ -173,4 +225,222 @@ char* RRPReadResponse (void);
 */
 int RRPCloseConnection (void);
 
+/*
+** Connection handles
+**
+** The functions below manage any number of connections, each identified
+** by an RRPCONNECTION handle, independently of the connection used by the
+** functions above. They are used by rrpSession to keep several sessions
+** open at once and to pipeline requests on them. A connection can be
+** switched to non-blocking mode so that it can be driven from an event
+** loop (see RRPGetConnectionDescriptor()). In blocking mode the timeout
+** set by RRPSetTimeout() applies to each operation; it is implemented
+** with poll() rather than SIGALRM, so handles can be used from several
+** threads (one thread per handle)
+*/
+typedef struct _RRPCONNECTION  RRPCONNECTION;
+
+/*
+**
+** Function: RRPOpenConnection
+**
+** Description: Establishes a new connection to a specified RRP server and
+**              reads the server's greeting (see
+**              RRPGetConnectionGreeting()). The connection is in
+**              blocking mode
+**
+** Input: char* - host name or IP address of RRP server
+**        unsigned short int - RRP server port
+**
+** Output: none
+**
+** Return: RRPCONNECTION* - a handle for the connection. NULL is returned
+**                          if an internal error or timeout occurs.
+**
+** Note: THE CONNECTION MUST BE CLOSED BY CALLING RRPFreeConnection()
+**
+*/
+RRPCONNECTION* RRPOpenConnection (char*, unsigned short int);
+
+/*
+**
+** Function: RRPOpenLocalConnection
+**
+** Description: Establishes a new connection to an RRP server, or to a
+**              session broker (see rrpBroker.c), listening on a Unix
+**              domain socket, and reads its greeting. The connection is
+**              in blocking mode and is then used like one opened by
+**              RRPOpenConnection()
+**
+** Input: char* - path of the socket
+**
+** Output: none
+**
+** Return: RRPCONNECTION* - a handle for the connection. NULL is returned
+**                          if an internal error or timeout occurs.
+**
+** Note: THE CONNECTION MUST BE CLOSED BY CALLING RRPFreeConnection()
+**
+*/
+RRPCONNECTION* RRPOpenLocalConnection (char*);
+
+/*
+**
+** Function: RRPGetConnectionGreeting
+**
+** Description: Returns the greeting the RRP server sent when the
+**              connection was established (the server's version and
+**              current date, ending with ".\r\n")
+**
+** Input: RRPCONNECTION* - a connection handle
+**
+** Output: none
+**
+** Return: char* - the greeting. NULL is returned if an internal error
+**                 occurs. The string belongs to the connection
+**
+*/
+char* RRPGetConnectionGreeting (RRPCONNECTION*);
+
+/*
+**
+** Function: RRPGetConnectionDescriptor
+**
+** Description: Returns the file descriptor of a connection, to wait for
+**              it to become readable or writable with poll() or select()
+**
+** Input: RRPCONNECTION* - a connection handle
+**
+** Output: none
+**
+** Return: int - the file descriptor. -1 is returned if an internal error
+**               occurs.
+**
+*/
+int RRPGetConnectionDescriptor (RRPCONNECTION*);
+
+/*
+**
+** Function: RRPSetConnectionBlocking
+**
+** Description: Switches a connection between blocking and non-blocking
+**              mode
+**
+** Input: RRPCONNECTION* - a connection handle
+**        int - 1 for blocking mode, 0 for non-blocking mode
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+int RRPSetConnectionBlocking (RRPCONNECTION*, int);
+
+/*
+**
+** Function: RRPWriteConnection
+**
+** Description: Writes request data to a connection. In blocking mode all
+**              of the data is written. In non-blocking mode only as much
+**              as the socket accepts without blocking is written
+**
+** Input: RRPCONNECTION* - a connection handle
+**        const char* - the data to write
+**        size_t - the number of characters to write
+**
+** Output: none
+**
+** Return: long - the number of characters written, which may be 0 in
+**                non-blocking mode. -1 is returned if an internal error
+**                or timeout occurs.
+**
+*/
+long RRPWriteConnection (RRPCONNECTION*, const char*, size_t);
+
+/*
+**
+** Function: RRPFillConnection
+**
+** Description: Reads the data that is available on a connection into the
+**              connection's input buffer, from which responses are then
+**              taken by RRPNextConnectionResponse(). In blocking mode,
+**              waits until some data is available
+**
+** Input: RRPCONNECTION* - a connection handle
+**
+** Output: none
+**
+** Return: long - the number of characters read, which may be 0 in
+**                non-blocking mode. -1 is returned if the server closed
+**                the connection or if an internal error or timeout occurs.
+**
+*/
+long RRPFillConnection (RRPCONNECTION*);
+
+/*
+**
+** Function: RRPNextConnectionResponse
+**
+** Description: Takes the next complete response string out of the input
+**              buffer of a connection. Does not read from the connection
+**              (see RRPFillConnection()). Each character is examined only
+**              once however many times this function is called while a
+**              response is incomplete
+**
+** Input: RRPCONNECTION* - a connection handle
+**
+** Output: char** - the response string, or NULL if the input buffer does
+**                  not hold a complete response
+**
+** Return: int - 1 is returned if a response was returned, 0 if no complete
+**               response is available. -1 is returned if an internal
+**               error occurs.
+**
+** Note: THE MEMORY USED FOR THE RRP RESPONSE STRING IS ALLOCATED DYNAMICALLY
+**       AND MUST BE RELEASED BY THE CALLER OF THE FUNCTION
+**
+*/
+int RRPNextConnectionResponse (RRPCONNECTION*, char**);
+
+/*
+**
+** Function: RRPReadConnectionResponse
+**
+** Description: Reads and returns the next response string from a
+**              connection in blocking mode
+**
+** Input: RRPCONNECTION* - a connection handle
+**
+** Output: none
+**
+** Return: char* - the RRP response string is returned if successful.
+**                 NULL is returned if an internal error or timeout occurs.
+**
+** Note: THE MEMORY USED FOR THE RRP RESPONSE STRING IS ALLOCATED DYNAMICALLY
+**       AND MUST BE RELEASED BY THE CALLER OF THE FUNCTION
+**
+*/
+char* RRPReadConnectionResponse (RRPCONNECTION*);
+
+/*
+**
+** Function: RRPFreeConnection
+**
+** Description: Closes a connection and frees its handle
+**
+** Input: RRPCONNECTION* - a connection handle
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+int RRPFreeConnection (RRPCONNECTION*);
+
+#ifdef __cplusplus
+}
+#endif
+
 #endif /* _RRP_CONNECTION_H_ */
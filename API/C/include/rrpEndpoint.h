@@ -0,0 +1,411 @@
+/* ===========================================================================
+ * Copyright (C) 2000 VeriSign, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * VeriSign Global Registry Service
+ * 21345 Ridgetop Circle
+ * Dulles, VA 20166
+ * ===========================================================================
+ * The RRP, APIs and Software are provided "as-is" and without any warranty
+ * of any kind.  NSI EXPRESSLY DISCLAIMS ALL WARRANTIES AND/OR CONDITIONS,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * AND CONDITIONS OF MERCHANTABILITY OR SATISFACTORY QUALITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE AND NONINFRINGEMENT OF THIRD PARTY RIGHTS.  NSI DOES
+ * NOT WARRANT THAT THE FUNCTIONS CONTAINED IN THE RRP, APIs OR SOFTWARE
+ * WILL MEET REGISTRAR'S REQUIREMENTS, OR THAT THE OPERATION OF THE RRP,
+ * APIs OR SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE,OR THAT DEFECTS IN
+ * THE RRP, APIs OR SOFTWARE WILL BE CORRECTED.  FURTHERMORE, NSI DOES NOT
+ * WARRANT NOR MAKE ANY REPRESENTATIONS REGARDING THE USE OR THE RESULTS OF
+ * THE RRP, APIs, SOFTWARE OR RELATED DOCUMENTATION IN TERMS OF THEIR
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR OTHERWISE.  SHOULD THE RRP, APIs
+ * OR SOFTWARE PROVE DEFECTIVE, REGISTRAR ASSUMES THE ENTIRE COST OF ALL
+ * NECESSARY SERVICING, REPAIR OR CORRECTION.
+ * ======================================================================== */
+
+/*
+**
+** Module Name: rrpEndpoint.h
+**
+** Version: 2.1 for RRP version 2.1.0
+**
+** Date: Oct. 19th, 2026
+**
+** Description: rrpEndpoint spreads a registrar's sessions over several
+**              RRP servers (front ends of the same registry) and moves
+**              them away from a server that is slow or failing.
+**
+**              A set of endpoints keeps, for each server, the smoothed
+**              time it takes to connect and log in and to answer a
+**              command, the smoothed share of attempts that failed, and
+**              the number of sessions connected to it. A new session
+**              goes to the endpoint with the best score, which is its
+**              latency weighted by its error rate and by the sessions
+**              already on it; an endpoint that has not been measured yet
+**              is tried first.
+**
+**              Each endpoint has a circuit breaker. It opens after a
+**              number of connections in a row could not be opened or
+**              were lost, or when most of the recent commands were
+**              refused; no session is sent to the endpoint while it is
+**              open. Once the cool-down has passed one session is let
+**              through as a trial, and the breaker closes again if it
+**              connects. When every breaker is open, the endpoint open
+**              the longest is tried anyway: the caller's retry policy
+**              then paces the attempts.
+**
+**              The sessions of rrpSession.h report to their set of
+**              endpoints themselves (see RRPOpenEndpointSession()), and
+**              a session whose endpoint's breaker opens moves to another
+**              endpoint as soon as it has no command awaiting a
+**              response, if it may reconnect.
+**
+**              In the event of an internal error (bad parameter, memory
+**              allocation error, etc.) each function will return a
+**              value indicating that an error has occured (see function
+**              descriptions below). An internal error code that
+**              identifies the error will be set. The error code can
+**              be accessed and interpreted by the functions defined in
+**              rrpInternalError.h (see API documentation)
+**
+** Note:        The functions can be called from any thread. Endpoints
+**              can be added but not removed, so an endpoint index stays
+**              valid for the life of its set.
+**
+** Entry Points:
+**
+**    RRPCreateEndpoints(void);
+**    RRPAddEndpoint(RRPENDPOINTS*, char*, unsigned short int);
+**    RRPParseEndpoints(char*, unsigned short int);
+**    RRPSetEndpointBreaker(RRPENDPOINTS*, int, int);
+**    RRPGetEndpointCount(RRPENDPOINTS*);
+**    RRPGetEndpointHost(RRPENDPOINTS*, int);
+**    RRPGetEndpointPort(RRPENDPOINTS*, int);
+**    RRPPickEndpoint(RRPENDPOINTS*);
+**    RRPReportEndpoint(RRPENDPOINTS*, int, RRPENDPOINTEVENT, long);
+**    RRPReleaseEndpoint(RRPENDPOINTS*, int);
+**    RRPIsEndpointHealthy(RRPENDPOINTS*, int);
+**    RRPGetEndpointStatistics(RRPENDPOINTS*, int, RRPENDPOINTSTATISTICS*);
+**    RRPFreeEndpoints(RRPENDPOINTS*);
+**
+** Changes:
+**
+*/
+
+#ifndef _RRP_ENDPOINT_H_
+#define _RRP_ENDPOINT_H_
+
+#include "rrpAPI.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+** The structure is private to rrpEndpoint.c
+*/
+typedef struct _RRPENDPOINTS  RRPENDPOINTS;
+
+/*
+** Default circuit breaker (see RRPSetEndpointBreaker())
+*/
+#define RRP_DEFAULT_BREAKER_FAILURES 3       /* connections in a row */
+#define RRP_DEFAULT_BREAKER_COOLDOWN 5000    /* milliseconds */
+
+/*
+** States of the circuit breaker of an endpoint
+*/
+typedef enum {
+	RRP_BREAKER_CLOSED,         /* sessions may be sent to the endpoint */
+	RRP_BREAKER_OPEN,           /* no session until the cool-down ends */
+	RRP_BREAKER_TRIAL           /* one session is trying the endpoint */
+} RRPBREAKERSTATE;
+
+/*
+** What happened on an endpoint (see RRPReportEndpoint())
+*/
+typedef enum {
+	RRP_ENDPOINT_CONNECTED,     /* a session logged in */
+	RRP_ENDPOINT_RESPONDED,     /* a command was answered */
+	RRP_ENDPOINT_REFUSED,       /* a command was refused (see
+	                               RRPClassifyOutcome() in rrpRetry.h) */
+	RRP_ENDPOINT_FAILED         /* a connection could not be opened, or
+	                               was lost */
+} RRPENDPOINTEVENT;
+
+/*
+** State and counts of an endpoint (see RRPGetEndpointStatistics())
+*/
+typedef struct {
+	RRPBREAKERSTATE state;
+	double latency;             /* smoothed, in microseconds. 0 until
+	                               measured */
+	double errorRate;           /* smoothed share of failed attempts,
+	                               from 0 to 1 */
+	int sessions;               /* sessions connected to the endpoint */
+	unsigned long connected;    /* events reported */
+	unsigned long responded;
+	unsigned long refused;
+	unsigned long failed;
+	unsigned long trips;        /* times the breaker opened */
+} RRPENDPOINTSTATISTICS;
+
+/*
+**
+** Function: RRPCreateEndpoints
+**
+** Description: Creates an empty set of endpoints, with the default
+**              circuit breaker
+**
+** Input: none
+**
+** Output: none
+**
+** Return: RRPENDPOINTS* - a pointer to an RRPENDPOINTS structure. NULL is
+**                         returned if an internal error occurs.
+**
+** Note: THE SET MUST BE RELEASED BY CALLING RRPFreeEndpoints()
+**
+*/
+RRPENDPOINTS* RRPCreateEndpoints(void);
+
+/*
+**
+** Function: RRPAddEndpoint
+**
+** Description: Adds an RRP server to a set of endpoints
+**
+** Input: RRPENDPOINTS* - a pointer to an RRPENDPOINTS structure
+**        char* - host name or IP address of RRP server
+**        unsigned short int - RRP server port
+**
+** Output: none
+**
+** Return: int - the index of the endpoint in the set. -1 is returned if
+**               an internal error occurs.
+**
+*/
+int RRPAddEndpoint(RRPENDPOINTS*, char*, unsigned short int);
+
+/*
+**
+** Function: RRPParseEndpoints
+**
+** Description: Creates a set of endpoints from a list of the form
+**              "host[:port][,host[:port]...]"
+**
+** Input: char* - the list
+**        unsigned short int - port of the hosts listed without one
+**
+** Output: none
+**
+** Return: RRPENDPOINTS* - a pointer to an RRPENDPOINTS structure. NULL is
+**                         returned if an internal error occurs or if
+**                         the list is empty or malformed
+**                         (RRP_BAD_PARAM_ERROR).
+**
+** Note: THE SET MUST BE RELEASED BY CALLING RRPFreeEndpoints()
+**
+*/
+RRPENDPOINTS* RRPParseEndpoints(char*, unsigned short int);
+
+/*
+**
+** Function: RRPSetEndpointBreaker
+**
+** Description: Sets when the circuit breakers of a set of endpoints open
+**              and for how long
+**
+** Input: RRPENDPOINTS* - a pointer to an RRPENDPOINTS structure
+**        int - connections in a row that could not be opened or were
+**              lost after which a breaker opens (1 or more)
+**        int - milliseconds a breaker stays open before a trial session
+**              is let through
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+int RRPSetEndpointBreaker(RRPENDPOINTS*, int, int);
+
+/*
+**
+** Function: RRPGetEndpointCount
+**
+** Description: Returns the number of endpoints in a set
+**
+** Input: RRPENDPOINTS* - a pointer to an RRPENDPOINTS structure
+**
+** Output: none
+**
+** Return: int - the number of endpoints. -1 is returned if an internal
+**               error occurs.
+**
+*/
+int RRPGetEndpointCount(RRPENDPOINTS*);
+
+/*
+**
+** Function: RRPGetEndpointHost
+**
+** Description: Returns the host of an endpoint
+**
+** Input: RRPENDPOINTS* - a pointer to an RRPENDPOINTS structure
+**        int - the index of the endpoint
+**
+** Output: none
+**
+** Return: char* - the host name or IP address. It belongs to the set.
+**                 NULL is returned if an internal error occurs.
+**
+*/
+char* RRPGetEndpointHost(RRPENDPOINTS*, int);
+
+/*
+**
+** Function: RRPGetEndpointPort
+**
+** Description: Returns the port of an endpoint
+**
+** Input: RRPENDPOINTS* - a pointer to an RRPENDPOINTS structure
+**        int - the index of the endpoint
+**
+** Output: none
+**
+** Return: int - the port. -1 is returned if an internal error occurs.
+**
+*/
+int RRPGetEndpointPort(RRPENDPOINTS*, int);
+
+/*
+**
+** Function: RRPPickEndpoint
+**
+** Description: Chooses the endpoint a new connection should go to, and
+**              counts a session on it until RRPReleaseEndpoint() is
+**              called. If the endpoint's breaker has finished its
+**              cool-down, the session is its trial
+**
+** Input: RRPENDPOINTS* - a pointer to an RRPENDPOINTS structure
+**
+** Output: none
+**
+** Return: int - the index of the endpoint. -1 is returned if an
+**               internal error occurs or if the set is empty
+**               (RRP_BAD_PARAM_ERROR).
+**
+*/
+int RRPPickEndpoint(RRPENDPOINTS*);
+
+/*
+**
+** Function: RRPReportEndpoint
+**
+** Description: Records what happened on an endpoint
+**
+** Input: RRPENDPOINTS* - a pointer to an RRPENDPOINTS structure
+**        int - the index of the endpoint
+**        RRPENDPOINTEVENT - what happened
+**        long - for RRP_ENDPOINT_CONNECTED, the microseconds taken to
+**               connect and log in; for RRP_ENDPOINT_RESPONDED, the
+**               microseconds from sending the command to reading its
+**               response. Ignored otherwise
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+int RRPReportEndpoint(RRPENDPOINTS*, int, RRPENDPOINTEVENT, long);
+
+/*
+**
+** Function: RRPReleaseEndpoint
+**
+** Description: Stops counting a session on an endpoint (see
+**              RRPPickEndpoint()), when its connection is closed or
+**              lost
+**
+** Input: RRPENDPOINTS* - a pointer to an RRPENDPOINTS structure
+**        int - the index of the endpoint
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+int RRPReleaseEndpoint(RRPENDPOINTS*, int);
+
+/*
+**
+** Function: RRPIsEndpointHealthy
+**
+** Description: Tells whether sessions should stay on an endpoint
+**
+** Input: RRPENDPOINTS* - a pointer to an RRPENDPOINTS structure
+**        int - the index of the endpoint
+**
+** Output: none
+**
+** Return: RRPBOOLEAN - RRPFALSE if the endpoint's breaker is open and
+**                      the breaker of another endpoint is closed,
+**                      RRPTRUE otherwise or if an internal error occurs
+**
+*/
+RRPBOOLEAN RRPIsEndpointHealthy(RRPENDPOINTS*, int);
+
+/*
+**
+** Function: RRPGetEndpointStatistics
+**
+** Description: Returns the state and counts of an endpoint
+**
+** Input: RRPENDPOINTS* - a pointer to an RRPENDPOINTS structure
+**        int - the index of the endpoint
+**
+** Output: RRPENDPOINTSTATISTICS* - the state and counts
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+int RRPGetEndpointStatistics(RRPENDPOINTS*, int, RRPENDPOINTSTATISTICS*);
+
+/*
+**
+** Function: RRPFreeEndpoints
+**
+** Description: Frees a set of endpoints. The sessions that use it must
+**              have been closed
+**
+** Input: RRPENDPOINTS* - a pointer to an RRPENDPOINTS structure
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+int RRPFreeEndpoints(RRPENDPOINTS*);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _RRP_ENDPOINT_H_ */
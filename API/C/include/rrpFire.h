@@ -0,0 +1,263 @@
+/* ===========================================================================
+ * Copyright (C) 2000 VeriSign, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * VeriSign Global Registry Service
+ * 21345 Ridgetop Circle
+ * Dulles, VA 20166
+ * ===========================================================================
+ * The RRP, APIs and Software are provided "as-is" and without any warranty
+ * of any kind.  NSI EXPRESSLY DISCLAIMS ALL WARRANTIES AND/OR CONDITIONS,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * AND CONDITIONS OF MERCHANTABILITY OR SATISFACTORY QUALITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE AND NONINFRINGEMENT OF THIRD PARTY RIGHTS.  NSI DOES
+ * NOT WARRANT THAT THE FUNCTIONS CONTAINED IN THE RRP, APIs OR SOFTWARE
+ * WILL MEET REGISTRAR'S REQUIREMENTS, OR THAT THE OPERATION OF THE RRP,
+ * APIs OR SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE,OR THAT DEFECTS IN
+ * THE RRP, APIs OR SOFTWARE WILL BE CORRECTED.  FURTHERMORE, NSI DOES NOT
+ * WARRANT NOR MAKE ANY REPRESENTATIONS REGARDING THE USE OR THE RESULTS OF
+ * THE RRP, APIs, SOFTWARE OR RELATED DOCUMENTATION IN TERMS OF THEIR
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR OTHERWISE.  SHOULD THE RRP, APIs
+ * OR SOFTWARE PROVE DEFECTIVE, REGISTRAR ASSUMES THE ENTIRE COST OF ALL
+ * NECESSARY SERVICING, REPAIR OR CORRECTION.
+ * ======================================================================== */
+
+/*
+**
+** Module Name: rrpFire.h
+**
+** Version: 2.1 for RRP version 2.1.0
+**
+** Date: Oct. 19th, 2026
+**
+** Description: rrpFire sends a burst of Add commands on a number of
+**              sessions at a given instant of the server's clock, to
+**              register domain names the moment they are deleted.
+**
+**              RRPCreateFire() logs in all of the sessions ahead of
+**              time, and estimates the offset of the server's clock from
+**              the date in the greeting of each connection. The domains
+**              are added with RRPAddFireDomain(), which formats their Add
+**              commands once into a single buffer. RRPFireAt() then
+**              starts one thread per session, each pinned to a processor
+**              where possible, which sleeps until the instant with
+**              clock_nanosleep(), writes the whole buffer at once and
+**              reads the responses. The local times at which each
+**              command was sent and its response received are recorded
+**              (see RRPGetFireAttempts()).
+**
+**              The greeting date has a resolution of one second. Each
+**              connection bounds the offset between the time of the
+**              connect and the arrival of the greeting, and the bounds of
+**              all of the connections are intersected, so more sessions
+**              opened at different fractions of a second narrow the
+**              estimate (see RRPGetFireClockOffset()).
+**
+**              In the event of an internal error (bad parameter, memory
+**              allocation error, etc.) each function will return a
+**              value indicating that an error has occured (see function
+**              descriptions below). An internal error code that
+**              identifies the error will be set. The error code can
+**              be accessed and interpreted by the functions defined in
+**              rrpInternalError.h (see API documentation)
+**
+** Entry Points:
+**
+**    RRPCreateFire(char*, unsigned short int, char*, char*, int);
+**    RRPAddFireDomain(RRPFIRE*, char*, RRPVECTOR*, int);
+**    RRPGetFireClockOffset(RRPFIRE*, double*, double*);
+**    RRPSetFireClockOffset(RRPFIRE*, double);
+**    RRPFireAt(RRPFIRE*, struct timespec*, long);
+**    RRPGetFireAttempts(RRPFIRE*, int*);
+**    RRPFreeFire(RRPFIRE*);
+**
+** Changes:
+**
+*/
+
+#ifndef _RRP_FIRE_H_
+#define _RRP_FIRE_H_
+
+#include <time.h>
+#include "rrpAPI.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+** The structure is private to rrpFire.c
+*/
+typedef struct _RRPFIRE  RRPFIRE;
+
+/*
+** One Add command sent by one session (see RRPGetFireAttempts()). The
+** times are local CLOCK_REALTIME times
+*/
+typedef struct {
+	int session;                /* index of the session */
+	int domain;                 /* index of the domain (order added) */
+	int code;                   /* RRP response code, -1 if it failed */
+	struct timespec woke;       /* session's thread woke up */
+	struct timespec sent;       /* write of the burst returned */
+	struct timespec received;   /* response was read */
+} RRPFIREATTEMPT;
+
+/*
+**
+** Function: RRPCreateFire
+**
+** Description: Opens and logs in a number of sessions to an RRP server,
+**              and estimates the offset of the server's clock
+**
+** Input: char* - host name or IP address of RRP server
+**        unsigned short int - RRP server port
+**        char* - registrar's id
+**        char* - registrar's password
+**        int - the number of sessions (1 or more)
+**
+** Output: none
+**
+** Return: RRPFIRE* - a pointer to an RRPFIRE structure. NULL is returned
+**                    if an internal error occurs or if a session can not
+**                    be opened.
+**
+** Note: THE STRUCTURE MUST BE RELEASED BY CALLING RRPFreeFire()
+**
+*/
+RRPFIRE* RRPCreateFire(char*, unsigned short int, char*, char*, int);
+
+/*
+**
+** Function: RRPAddFireDomain
+**
+** Description: Adds the Add command of a domain to the burst. Every
+**              session sends every domain's command, in the order added
+**
+** Input: RRPFIRE* - a pointer to an RRPFIRE structure
+**        char* - the domain name
+**        RRPVECTOR* - name servers, or NULL
+**        int - registration period in years, or 0 for the default
+**
+** Output: none
+**
+** Return: int - the index of the domain. -1 is returned if an internal
+**               error occurs.
+**
+*/
+int RRPAddFireDomain(RRPFIRE*, char*, RRPVECTOR*, int);
+
+/*
+**
+** Function: RRPGetFireClockOffset
+**
+** Description: Returns the estimated offset of the server's clock (the
+**              server's time less the local time)
+**
+** Input: RRPFIRE* - a pointer to an RRPFIRE structure
+**
+** Output: double* - the offset in seconds
+**         double* - the largest error of the estimate in seconds, or
+**                   NULL. It is negative if the greetings disagreed, in
+**                   which case the offset is only a rough estimate
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs, or if no greeting had a date.
+**
+*/
+int RRPGetFireClockOffset(RRPFIRE*, double*, double*);
+
+/*
+**
+** Function: RRPSetFireClockOffset
+**
+** Description: Replaces the estimated offset of the server's clock, e.g.
+**              with 0 when the local clock is known to be synchronized
+**
+** Input: RRPFIRE* - a pointer to an RRPFIRE structure
+**        double - the offset in seconds (server's time less local time)
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+int RRPSetFireClockOffset(RRPFIRE*, double);
+
+/*
+**
+** Function: RRPFireAt
+**
+** Description: Sends the burst on every session at an instant of the
+**              server's clock, and waits for all of the responses
+**
+** Input: RRPFIRE* - a pointer to an RRPFIRE structure
+**        struct timespec* - the instant, in the server's time
+**        long - nanoseconds between the bursts of successive sessions,
+**               to spread the sessions over the uncertainty of the
+**               offset. Session i fires at instant + i * stagger
+**
+** Output: none
+**
+** Return: int - the number of Add commands that got a response. -1 is
+**               returned if an internal error occurs.
+**
+** Note: The sessions are ended once they have fired
+**
+*/
+int RRPFireAt(RRPFIRE*, struct timespec*, long);
+
+/*
+**
+** Function: RRPGetFireAttempts
+**
+** Description: Returns the attempts of the last RRPFireAt(), session by
+**              session, in the order each session sent them
+**
+** Input: RRPFIRE* - a pointer to an RRPFIRE structure
+**
+** Output: int* - the number of attempts
+**
+** Return: RRPFIREATTEMPT* - array of attempts, which belongs to the
+**                           RRPFIRE structure. NULL is returned if an
+**                           internal error occurs.
+**
+*/
+RRPFIREATTEMPT* RRPGetFireAttempts(RRPFIRE*, int*);
+
+/*
+**
+** Function: RRPFreeFire
+**
+** Description: Closes the sessions and frees all of the memory allocated
+**              for an RRPFIRE structure
+**
+** Input: RRPFIRE* - a pointer to an RRPFIRE structure
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+int RRPFreeFire(RRPFIRE*);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _RRP_FIRE_H_ */
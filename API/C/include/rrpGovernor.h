@@ -0,0 +1,270 @@
+/* ===========================================================================
+ * Copyright (C) 2000 VeriSign, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * VeriSign Global Registry Service
+ * 21345 Ridgetop Circle
+ * Dulles, VA 20166
+ * ===========================================================================
+ * The RRP, APIs and Software are provided "as-is" and without any warranty
+ * of any kind.  NSI EXPRESSLY DISCLAIMS ALL WARRANTIES AND/OR CONDITIONS,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * AND CONDITIONS OF MERCHANTABILITY OR SATISFACTORY QUALITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE AND NONINFRINGEMENT OF THIRD PARTY RIGHTS.  NSI DOES
+ * NOT WARRANT THAT THE FUNCTIONS CONTAINED IN THE RRP, APIs OR SOFTWARE
+ * WILL MEET REGISTRAR'S REQUIREMENTS, OR THAT THE OPERATION OF THE RRP,
+ * APIs OR SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE,OR THAT DEFECTS IN
+ * THE RRP, APIs OR SOFTWARE WILL BE CORRECTED.  FURTHERMORE, NSI DOES NOT
+ * WARRANT NOR MAKE ANY REPRESENTATIONS REGARDING THE USE OR THE RESULTS OF
+ * THE RRP, APIs, SOFTWARE OR RELATED DOCUMENTATION IN TERMS OF THEIR
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR OTHERWISE.  SHOULD THE RRP, APIs
+ * OR SOFTWARE PROVE DEFECTIVE, REGISTRAR ASSUMES THE ENTIRE COST OF ALL
+ * NECESSARY SERVICING, REPAIR OR CORRECTION.
+ * ======================================================================== */
+
+/*
+**
+** Module Name: rrpGovernor.h
+**
+** Version: 2.1 for RRP version 2.1.0
+**
+** Date: Oct. 19th, 2026
+**
+** Description: rrpGovernor keeps a registrar's commands within the rate
+**              the registry allows. A governor holds a token bucket for
+**              all commands and, optionally, one for each class of
+**              commands (queries, transforms and session commands).
+**              A command may be sent when every bucket it draws from
+**              holds a token; each bucket is refilled at its rate, up
+**              to its burst, so quota left unused for a moment is not
+**              lost but cannot pile up either.
+**
+**              A governor is meant to be shared by all the sessions of
+**              a process (see RRPSetSessionGovernor() in rrpSession.h),
+**              and can be made the process governor, which the blocking
+**              command functions of rrpAPI.h wait for and which new
+**              sessions start with (RRPSetProcessGovernor()).
+**
+**              In the event of an internal error (bad parameter, memory
+**              allocation error, etc.) each function will return a
+**              value indicating that an error has occured (see function
+**              descriptions below). An internal error code that
+**              identifies the error will be set. The error code can
+**              be accessed and interpreted by the functions defined in
+**              rrpInternalError.h (see API documentation)
+**
+** Note:        The functions can be called from any thread.
+**
+** Entry Points:
+**
+**    RRPCreateGovernor(double, int);
+**    RRPSetGovernorClassRate(RRPGOVERNOR*, RRPCOMMANDCLASS, double, int);
+**    RRPAcquireGovernor(RRPGOVERNOR*, RRPCOMMAND);
+**    RRPWaitGovernor(RRPGOVERNOR*, RRPCOMMAND);
+**    RRPGetGovernorStatistics(RRPGOVERNOR*, RRPGOVERNORSTATISTICS*);
+**    RRPSetProcessGovernor(RRPGOVERNOR*);
+**    RRPGetProcessGovernor(void);
+**    RRPFreeGovernor(RRPGOVERNOR*);
+**
+** Changes:
+**
+*/
+
+#ifndef _RRP_GOVERNOR_H_
+#define _RRP_GOVERNOR_H_
+
+#include "rrpAPI.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+** The structure is private to rrpGovernor.c
+*/
+typedef struct _RRPGOVERNOR  RRPGOVERNOR;
+
+/*
+** Classes of commands, each with its own optional bucket
+*/
+typedef enum {
+	RRP_QUERY_COMMANDS,         /* Check, Status, Describe */
+	RRP_TRANSFORM_COMMANDS,     /* Add, Del, Mod, Renew, Restore, Sync,
+	                               Transfer */
+	RRP_SESSION_COMMANDS        /* Session, Quit */
+} RRPCOMMANDCLASS;
+
+#define RRP_COMMAND_CLASSES 3
+
+/*
+** Counts of a governor (see RRPGetGovernorStatistics())
+*/
+typedef struct {
+	unsigned long granted;      /* commands allowed */
+	unsigned long deferred;     /* requests told to wait */
+} RRPGOVERNORSTATISTICS;
+
+/*
+**
+** Function: RRPCreateGovernor
+**
+** Description: Creates a governor
+**
+** Input: double - the most commands per second, all classes together.
+**                 0 sets no overall limit
+**        int - the most commands that may be sent at once after a lull
+**              (1 or more)
+**
+** Output: none
+**
+** Return: RRPGOVERNOR* - a pointer to an RRPGOVERNOR structure. NULL is
+**                        returned if an internal error occurs.
+**
+** Note: THE GOVERNOR MUST BE RELEASED BY CALLING RRPFreeGovernor()
+**
+*/
+RRPGOVERNOR* RRPCreateGovernor(double, int);
+
+/*
+**
+** Function: RRPSetGovernorClassRate
+**
+** Description: Limits the rate of a class of commands, within the
+**              overall rate of the governor
+**
+** Input: RRPGOVERNOR* - a pointer to an RRPGOVERNOR structure
+**        RRPCOMMANDCLASS - the class
+**        double - the most commands of the class per second. 0 removes
+**                 the limit
+**        int - the most commands of the class that may be sent at once
+**              after a lull (1 or more)
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+int RRPSetGovernorClassRate(RRPGOVERNOR*, RRPCOMMANDCLASS, double, int);
+
+/*
+**
+** Function: RRPAcquireGovernor
+**
+** Description: Takes the tokens needed to send a command, if they are
+**              all available. Never blocks
+**
+** Input: RRPGOVERNOR* - a pointer to an RRPGOVERNOR structure
+**        RRPCOMMAND - the command
+**
+** Output: none
+**
+** Return: long - 0 if the command may be sent now, otherwise the number
+**                of microseconds after which it may be asked again. -1
+**                is returned if an internal error occurs.
+**
+*/
+long RRPAcquireGovernor(RRPGOVERNOR*, RRPCOMMAND);
+
+/*
+**
+** Function: RRPWaitGovernor
+**
+** Description: Waits until a command may be sent and takes its tokens
+**
+** Input: RRPGOVERNOR* - a pointer to an RRPGOVERNOR structure
+**        RRPCOMMAND - the command
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+int RRPWaitGovernor(RRPGOVERNOR*, RRPCOMMAND);
+
+/*
+**
+** Function: RRPGetGovernorStatistics
+**
+** Description: Returns the counts of a governor
+**
+** Input: RRPGOVERNOR* - a pointer to an RRPGOVERNOR structure
+**
+** Output: RRPGOVERNORSTATISTICS* - the counts
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+int RRPGetGovernorStatistics(RRPGOVERNOR*, RRPGOVERNORSTATISTICS*);
+
+/*
+**
+** Function: RRPSetProcessGovernor
+**
+** Description: Sets the governor of the process: the command functions
+**              of rrpAPI.h wait for it before sending their command, and
+**              sessions opened from now on use it (see
+**              RRPSetSessionGovernor())
+**
+** Input: RRPGOVERNOR* - the governor, or NULL for none (the default).
+**                       It still belongs to the caller and must outlive
+**                       its use
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful.
+**
+*/
+int RRPSetProcessGovernor(RRPGOVERNOR*);
+
+/*
+**
+** Function: RRPGetProcessGovernor
+**
+** Description: Returns the governor of the process
+**
+** Input: none
+**
+** Output: none
+**
+** Return: RRPGOVERNOR* - the governor, or NULL if there is none
+**
+*/
+RRPGOVERNOR* RRPGetProcessGovernor(void);
+
+/*
+**
+** Function: RRPFreeGovernor
+**
+** Description: Frees a governor
+**
+** Input: RRPGOVERNOR* - a pointer to an RRPGOVERNOR structure
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+int RRPFreeGovernor(RRPGOVERNOR*);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _RRP_GOVERNOR_H_ */
@@ -64,6 +64,10 @@
 #ifndef _RRP_INTERNAL_ERROR_H_
 #define _RRP_INTERNAL_ERROR_H_
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 /*
 ** Internal error code definitions
 */
@@ -79,7 +83,9 @@ typedef enum {
 	RRP_NOT_CONNECTED_ERROR, /* No socket connection exists */
 	RRP_RESPONSE_FORMAT_ERROR, /* Invalid RRP response format */
 	RRP_UNKNOWN_ERROR, /* Unknown internal error */
-	RRP_TIMEOUT_ERROR /* Socket operation timeout */
+	RRP_TIMEOUT_ERROR, /* Socket operation timeout */
+	RRP_LIMIT_EXCEEDED_ERROR, /* Internal limit exceeded */
+	RRP_SESSION_REFUSED_ERROR /* RRP server refused to start session */
 } RRPINTERNAL_ERROR_CODE;
 
 /*
@@ -150,4 +156,8 @@ char* RRPGetInternalErrorDescription();
 */
 void RRPPrintInternalErrorDescription ();
 
+#ifdef __cplusplus
+}
+#endif
+
 #endif /* _RRP_INTERNAL_ERROR_H_ */
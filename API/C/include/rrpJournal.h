@@ -0,0 +1,382 @@
+/* ===========================================================================
+ * Copyright (C) 2000 VeriSign, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * VeriSign Global Registry Service
+ * 21345 Ridgetop Circle
+ * Dulles, VA 20166
+ * ===========================================================================
+ * The RRP, APIs and Software are provided "as-is" and without any warranty
+ * of any kind.  NSI EXPRESSLY DISCLAIMS ALL WARRANTIES AND/OR CONDITIONS,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * AND CONDITIONS OF MERCHANTABILITY OR SATISFACTORY QUALITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE AND NONINFRINGEMENT OF THIRD PARTY RIGHTS.  NSI DOES
+ * NOT WARRANT THAT THE FUNCTIONS CONTAINED IN THE RRP, APIs OR SOFTWARE
+ * WILL MEET REGISTRAR'S REQUIREMENTS, OR THAT THE OPERATION OF THE RRP,
+ * APIs OR SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE,OR THAT DEFECTS IN
+ * THE RRP, APIs OR SOFTWARE WILL BE CORRECTED.  FURTHERMORE, NSI DOES NOT
+ * WARRANT NOR MAKE ANY REPRESENTATIONS REGARDING THE USE OR THE RESULTS OF
+ * THE RRP, APIs, SOFTWARE OR RELATED DOCUMENTATION IN TERMS OF THEIR
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR OTHERWISE.  SHOULD THE RRP, APIs
+ * OR SOFTWARE PROVE DEFECTIVE, REGISTRAR ASSUMES THE ENTIRE COST OF ALL
+ * NECESSARY SERVICING, REPAIR OR CORRECTION.
+ * ======================================================================== */
+
+/*
+**
+** Module Name: rrpJournal.h
+**
+** Version: 2.1 for RRP version 2.1.0
+**
+** Date: Oct. 19th, 2026
+**
+** Description: rrpJournal keeps a durable record of the commands that
+**              change the registry (by default Add, Del, Renew and
+**              Transfer) and of their outcome, for billing
+**              reconciliation and for recovery after a crash.
+**
+**              A journal is an append-only file. The intent of each
+**              command is recorded, and made durable, before the
+**              command is sent; its outcome is recorded when the
+**              response arrives or the command fails. Records are
+**              gathered in memory and written and synchronized together
+**              (group commit): the sessions of rrpSession.h commit
+**              their journal once before each write to the connection,
+**              so one fsync covers every command written at once, and
+**              a thread that commits while another is synchronizing
+**              waits for it and is often covered by it. Outcomes are
+**              made durable by the next commit; an outcome lost in a
+**              crash leaves its command unresolved, never resolved
+**              wrongly.
+**
+**              After a crash, a journal reader (see
+**              RRPOpenJournalReader()) lists the commands whose outcome
+**              is unknown: those with no outcome recorded, and those
+**              whose connection failed before the response arrived.
+**
+**              Each record is one line of tab-separated fields ending
+**              with a checksum, so that a record cut short or damaged
+**              by a crash is recognized and skipped:
+**
+**                I seq time command name request checksum
+**                O seq code outcome checksum
+**
+**              where 'request' is the text of the request with its
+**              line breaks, tabs and backslashes escaped, 'code' is the
+**              response code (-1 if there was no response) and
+**              'outcome' is the RRPOUTCOME of the command (see
+**              rrpRetry.h).
+**
+**              In the event of an internal error (bad parameter, memory
+**              allocation error, etc.) each function will return a
+**              value indicating that an error has occured (see function
+**              descriptions below). An internal error code that
+**              identifies the error will be set. The error code can
+**              be accessed and interpreted by the functions defined in
+**              rrpInternalError.h (see API documentation)
+**
+** Note:        The functions of a journal can be called from any
+**              thread, but its commands are not changed once it is in
+**              use. A journal reader belongs to one thread.
+**
+** Entry Points:
+**
+**    RRPOpenJournal(char*);
+**    RRPSetJournalCommand(RRPJOURNAL*, RRPCOMMAND, RRPBOOLEAN);
+**    RRPGetJournalCommand(RRPJOURNAL*, RRPCOMMAND);
+**    RRPRecordJournalIntent(RRPJOURNAL*, RRPREQUEST*);
+**    RRPRecordJournalOutcome(RRPJOURNAL*, unsigned long, RRPRESPONSE*);
+**    RRPCommitJournal(RRPJOURNAL*, unsigned long);
+**    RRPGetJournalStatistics(RRPJOURNAL*, RRPJOURNALSTATISTICS*);
+**    RRPCloseJournal(RRPJOURNAL*);
+**    RRPOpenJournalReader(char*);
+**    RRPReadJournalEntry(RRPJOURNALREADER*, RRPJOURNALENTRY*);
+**    RRPGetJournalDamage(RRPJOURNALREADER*);
+**    RRPCloseJournalReader(RRPJOURNALREADER*);
+**
+** Changes:
+**
+*/
+
+#ifndef _RRP_JOURNAL_H_
+#define _RRP_JOURNAL_H_
+
+#include "rrpAPI.h"
+#include "rrpInternalError.h"
+#include "rrpRetry.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+** The structures are private to rrpJournal.c
+*/
+typedef struct _RRPJOURNAL  RRPJOURNAL;
+typedef struct _RRPJOURNALREADER  RRPJOURNALREADER;
+
+/*
+** Counts of a journal (see RRPGetJournalStatistics())
+*/
+typedef struct {
+	unsigned long intents;      /* intents recorded */
+	unsigned long outcomes;     /* outcomes recorded */
+	unsigned long commits;      /* writes synchronized */
+} RRPJOURNALSTATISTICS;
+
+/*
+** A command whose outcome is unknown (see RRPReadJournalEntry())
+*/
+typedef struct {
+	unsigned long sequence;     /* number of the command in the journal */
+	long time;                  /* when its intent was recorded, in
+	                               seconds since the epoch */
+	RRPCOMMAND command;
+	char* name;                 /* name of the entity, "" if none */
+	char* request;              /* text of the request */
+	int code;                   /* response code, -1 if none */
+	RRPOUTCOME outcome;         /* RRP_OUTCOME_UNKNOWN */
+} RRPJOURNALENTRY;
+
+/*
+**
+** Function: RRPOpenJournal
+**
+** Description: Opens a journal for appending, creating the file if
+**              needed. Sequence numbers go on from the last one in the
+**              file
+**
+** Input: char* - name of the journal file
+**
+** Output: none
+**
+** Return: RRPJOURNAL* - a pointer to an RRPJOURNAL structure. NULL is
+**                       returned if an internal error occurs or if the
+**                       file can not be opened (RRP_IO_ERROR).
+**
+** Note: THE JOURNAL MUST BE CLOSED BY CALLING RRPCloseJournal()
+**
+*/
+RRPJOURNAL* RRPOpenJournal(char*);
+
+/*
+**
+** Function: RRPSetJournalCommand
+**
+** Description: Tells whether a command is recorded in a journal
+**
+** Input: RRPJOURNAL* - a pointer to an RRPJOURNAL structure
+**        RRPCOMMAND - the command
+**        RRPBOOLEAN - RRPTRUE to record the command
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+int RRPSetJournalCommand(RRPJOURNAL*, RRPCOMMAND, RRPBOOLEAN);
+
+/*
+**
+** Function: RRPGetJournalCommand
+**
+** Description: Tells whether a command is recorded in a journal
+**
+** Input: RRPJOURNAL* - a pointer to an RRPJOURNAL structure
+**        RRPCOMMAND - the command
+**
+** Output: none
+**
+** Return: RRPBOOLEAN - RRPTRUE if the command is recorded, RRPFALSE if
+**                      not or if an internal error occurs
+**
+*/
+RRPBOOLEAN RRPGetJournalCommand(RRPJOURNAL*, RRPCOMMAND);
+
+/*
+**
+** Function: RRPRecordJournalIntent
+**
+** Description: Records that a request is about to be sent. The record is
+**              durable once RRPCommitJournal() has returned for its
+**              sequence number
+**
+** Input: RRPJOURNAL* - a pointer to an RRPJOURNAL structure
+**        RRPREQUEST* - the request
+**
+** Output: none
+**
+** Return: unsigned long - the sequence number of the command, 1 or
+**                         more. 0 is returned if an internal error
+**                         occurs.
+**
+*/
+unsigned long RRPRecordJournalIntent(RRPJOURNAL*, RRPREQUEST*);
+
+/*
+**
+** Function: RRPRecordJournalOutcome
+**
+** Description: Records the outcome of a command. The record is made
+**              durable by the next commit
+**
+** Input: RRPJOURNAL* - a pointer to an RRPJOURNAL structure
+**        unsigned long - the sequence number of the command
+**        RRPRESPONSE* - the response, or NULL if there was none: the
+**                       command may then have been executed or not
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+int RRPRecordJournalOutcome(RRPJOURNAL*, unsigned long, RRPRESPONSE*);
+
+/*
+**
+** Function: RRPCommitJournal
+**
+** Description: Makes the records of a journal durable, up to a command.
+**              Records gathered by other threads meanwhile are written
+**              and synchronized along with them
+**
+** Input: RRPJOURNAL* - a pointer to an RRPJOURNAL structure
+**        unsigned long - the sequence number of the command, or 0 for
+**                        every record
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs, or if the file could not be
+**               written or synchronized (RRP_IO_ERROR); the journal can
+**               then no longer be used.
+**
+*/
+int RRPCommitJournal(RRPJOURNAL*, unsigned long);
+
+/*
+**
+** Function: RRPGetJournalStatistics
+**
+** Description: Returns the counts of a journal
+**
+** Input: RRPJOURNAL* - a pointer to an RRPJOURNAL structure
+**
+** Output: RRPJOURNALSTATISTICS* - the counts
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+int RRPGetJournalStatistics(RRPJOURNAL*, RRPJOURNALSTATISTICS*);
+
+/*
+**
+** Function: RRPCloseJournal
+**
+** Description: Commits every record of a journal, closes its file and
+**              frees it. The sessions that use it must have been closed
+**
+** Input: RRPJOURNAL* - a pointer to an RRPJOURNAL structure
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs, or if the last records could not
+**               be committed (RRP_IO_ERROR); the journal is freed
+**               anyway.
+**
+*/
+int RRPCloseJournal(RRPJOURNAL*);
+
+/*
+**
+** Function: RRPOpenJournalReader
+**
+** Description: Reads a journal and gathers the commands whose outcome
+**              is unknown, in the order they were recorded
+**
+** Input: char* - name of the journal file
+**
+** Output: none
+**
+** Return: RRPJOURNALREADER* - a pointer to an RRPJOURNALREADER
+**                             structure. NULL is returned if an internal
+**                             error occurs or if the file can not be
+**                             read (RRP_IO_ERROR).
+**
+** Note: THE READER MUST BE CLOSED BY CALLING RRPCloseJournalReader()
+**
+*/
+RRPJOURNALREADER* RRPOpenJournalReader(char*);
+
+/*
+**
+** Function: RRPReadJournalEntry
+**
+** Description: Returns the next command whose outcome is unknown
+**
+** Input: RRPJOURNALREADER* - a pointer to an RRPJOURNALREADER structure
+**
+** Output: RRPJOURNALENTRY* - the command. Its strings belong to the
+**                            reader and are valid until it is closed
+**
+** Return: int - 1 is returned if a command was returned, 0 once there
+**               are no more. -1 is returned if an internal error occurs.
+**
+*/
+int RRPReadJournalEntry(RRPJOURNALREADER*, RRPJOURNALENTRY*);
+
+/*
+**
+** Function: RRPGetJournalDamage
+**
+** Description: Returns the number of records of a journal that were
+**              skipped because they were cut short or damaged
+**
+** Input: RRPJOURNALREADER* - a pointer to an RRPJOURNALREADER structure
+**
+** Output: none
+**
+** Return: int - the number of records. -1 is returned if an internal
+**               error occurs.
+**
+*/
+int RRPGetJournalDamage(RRPJOURNALREADER*);
+
+/*
+**
+** Function: RRPCloseJournalReader
+**
+** Description: Frees a journal reader and the commands it returned
+**
+** Input: RRPJOURNALREADER* - a pointer to an RRPJOURNALREADER structure
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+int RRPCloseJournalReader(RRPJOURNALREADER*);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _RRP_JOURNAL_H_ */
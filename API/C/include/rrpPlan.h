@@ -0,0 +1,310 @@
+/* ===========================================================================
+ * Copyright (C) 2000 VeriSign, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * VeriSign Global Registry Service
+ * 21345 Ridgetop Circle
+ * Dulles, VA 20166
+ * ===========================================================================
+ * The RRP, APIs and Software are provided "as-is" and without any warranty
+ * of any kind.  NSI EXPRESSLY DISCLAIMS ALL WARRANTIES AND/OR CONDITIONS,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * AND CONDITIONS OF MERCHANTABILITY OR SATISFACTORY QUALITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE AND NONINFRINGEMENT OF THIRD PARTY RIGHTS.  NSI DOES
+ * NOT WARRANT THAT THE FUNCTIONS CONTAINED IN THE RRP, APIs OR SOFTWARE
+ * WILL MEET REGISTRAR'S REQUIREMENTS, OR THAT THE OPERATION OF THE RRP,
+ * APIs OR SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE,OR THAT DEFECTS IN
+ * THE RRP, APIs OR SOFTWARE WILL BE CORRECTED.  FURTHERMORE, NSI DOES NOT
+ * WARRANT NOR MAKE ANY REPRESENTATIONS REGARDING THE USE OR THE RESULTS OF
+ * THE RRP, APIs, SOFTWARE OR RELATED DOCUMENTATION IN TERMS OF THEIR
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR OTHERWISE.  SHOULD THE RRP, APIs
+ * OR SOFTWARE PROVE DEFECTIVE, REGISTRAR ASSUMES THE ENTIRE COST OF ALL
+ * NECESSARY SERVICING, REPAIR OR CORRECTION.
+ * ======================================================================== */
+
+/*
+**
+** Module Name: rrpPlan.h
+**
+** Version: 2.1 for RRP version 2.1.0
+**
+** Date: Oct. 19th, 2026
+**
+** Description: rrpPlan computes the smallest Mod command that brings a
+**              domain or name server from its current state, as given
+**              by a Status response, to a desired state. Only the
+**              values that differ are added, replaced or deleted, and a
+**              domain or name server that is already in the desired
+**              state needs no command at all.
+**
+**              The result is a plan holding the vectors and properties
+**              to pass to RRPModifyDomain() or RRPModifyNameServer(), or
+**              from which a request can be built for a session (see
+**              RRPCreateDomainPlanRequest()). A name server that is
+**              removed while another one is added is replaced on a
+**              single line ("NameServer:old=new"), and the same is done
+**              for IP addresses. Host names are compared without regard
+**              to case or a trailing dot, statuses without regard to
+**              case. Only the statuses a registrar can set (those whose
+**              name starts with "REGISTRAR-") are planned; the others
+**              are set by the registry and are left alone.
+**
+**              In the event of an internal error (bad parameter, memory
+**              allocation error, etc.) each function will return a
+**              value indicating that an error has occured (see function
+**              descriptions below). An internal error code that
+**              identifies the error will be set. The error code can
+**              be accessed and interpreted by the functions defined in
+**              rrpInternalError.h (see API documentation)
+**
+** Entry Points:
+**
+**    RRPPlanListChanges(RRPVECTOR*, RRPVECTOR*, int, RRPLISTCHANGES*);
+**    RRPPlanModifyDomain(RRPRESPONSE*, RRPVECTOR*, RRPVECTOR*,
+**        RRPDOMAINPLAN*);
+**    RRPPlanModifyNameServer(RRPRESPONSE*, RRPVECTOR*,
+**        RRPNAMESERVERPLAN*);
+**    RRPCreateDomainPlanRequest(char*, RRPDOMAINPLAN*);
+**    RRPCreateNameServerPlanRequest(char*, RRPNAMESERVERPLAN*);
+**    RRPFreeListChanges(RRPLISTCHANGES*);
+**    RRPFreeDomainPlan(RRPDOMAINPLAN*);
+**    RRPFreeNameServerPlan(RRPNAMESERVERPLAN*);
+**
+** Changes:
+**
+*/
+
+#ifndef _RRP_PLAN_H_
+#define _RRP_PLAN_H_
+
+#include "rrpAPI.h"
+#include "rrpVector.h"
+#include "rrpProperties.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+** Options of RRPPlanListChanges()
+*/
+#define RRP_PLAN_CASELESS 1    /* compare values without regard to case */
+#define RRP_PLAN_HOST_NAMES 2  /* ignore a trailing dot (and case) */
+#define RRP_PLAN_REPLACE 4     /* pair deleted and added values into
+                                  replacements */
+
+/*
+** Changes to a list of values. Each member is NULL if it is empty
+*/
+typedef struct {
+	RRPVECTOR* added;          /* values to add */
+	RRPPROPERTIES* modified;   /* old value (key) to replace by a new one
+	                              (value) */
+	RRPVECTOR* deleted;        /* values to delete */
+} RRPLISTCHANGES;
+
+/*
+** Arguments of RRPModifyDomain()
+*/
+typedef struct {
+	RRPLISTCHANGES nameServers;
+	RRPLISTCHANGES statuses;
+} RRPDOMAINPLAN;
+
+/*
+** Arguments of RRPModifyNameServer()
+*/
+typedef struct {
+	RRPLISTCHANGES ipAddresses;
+} RRPNAMESERVERPLAN;
+
+/*
+**
+** Function: RRPPlanListChanges
+**
+** Description: Computes the changes that turn a list of values into
+**              another. Duplicate values count once
+**
+** Input: RRPVECTOR* - the current values, NULL if none
+**        RRPVECTOR* - the desired values, NULL if none
+**        int - options: RRP_PLAN_CASELESS, RRP_PLAN_HOST_NAMES and
+**              RRP_PLAN_REPLACE, or'ed together
+**
+** Output: RRPLISTCHANGES* - the changes. Added values are taken from
+**                           the desired list and deleted values from
+**                           the current list
+**
+** Return: int - the number of values added, replaced and deleted, 0 if
+**               the lists hold the same values. -1 is returned if an
+**               internal error occurs.
+**
+** Note: THE MEMORY ALLOCATED FOR THE CHANGES MUST BE RELEASED BY
+**       CALLING THE RRPFreeListChanges() FUNCTION
+**
+*/
+int RRPPlanListChanges(RRPVECTOR*, RRPVECTOR*, int, RRPLISTCHANGES*);
+
+/*
+**
+** Function: RRPPlanModifyDomain
+**
+** Description: Computes the arguments of the smallest RRPModifyDomain()
+**              call that gives a domain the desired name servers and
+**              statuses
+**
+** Input: RRPRESPONSE* - the Status response of the domain (see
+**                       RRPStatusDomain())
+**        RRPVECTOR* - the desired name servers. NULL leaves the name
+**                     servers as they are
+**        RRPVECTOR* - the desired statuses. NULL leaves the statuses as
+**                     they are
+**
+** Output: RRPDOMAINPLAN* - the plan
+**
+** Return: int - the number of values added, replaced and deleted, 0 if
+**               the domain is already in the desired state. -1 is
+**               returned if an internal error occurs.
+**
+** Note: THE MEMORY ALLOCATED FOR THE PLAN MUST BE RELEASED BY CALLING
+**       THE RRPFreeDomainPlan() FUNCTION
+**
+*/
+int RRPPlanModifyDomain(RRPRESPONSE*, RRPVECTOR*, RRPVECTOR*,
+	RRPDOMAINPLAN*);
+
+/*
+**
+** Function: RRPPlanModifyNameServer
+**
+** Description: Computes the arguments of the smallest
+**              RRPModifyNameServer() call that gives a name server the
+**              desired IP addresses
+**
+** Input: RRPRESPONSE* - the Status response of the name server (see
+**                       RRPStatusNameServer())
+**        RRPVECTOR* - the desired IP addresses
+**
+** Output: RRPNAMESERVERPLAN* - the plan
+**
+** Return: int - the number of addresses added, replaced and deleted, 0
+**               if the name server is already in the desired state. -1
+**               is returned if an internal error occurs.
+**
+** Note: THE MEMORY ALLOCATED FOR THE PLAN MUST BE RELEASED BY CALLING
+**       THE RRPFreeNameServerPlan() FUNCTION
+**
+*/
+int RRPPlanModifyNameServer(RRPRESPONSE*, RRPVECTOR*, RRPNAMESERVERPLAN*);
+
+/*
+**
+** Function: RRPCreateDomainPlanRequest
+**
+** Description: Creates the Mod request of a domain plan, e.g. to submit
+**              it to a session (see rrpSession.h)
+**
+** Input: char* - the domain name
+**        RRPDOMAINPLAN* - the plan
+**
+** Output: none
+**
+** Return: RRPREQUEST* - a pointer to an allocated RRPREQUEST structure.
+**                       NULL is returned if an internal error occurs.
+**
+** Note: THE MEMORY ALLOCATED FOR THE RRPREQUEST STRUCTURE MUST BE
+**       RELEASED BY CALLING THE RRPFreeRequest() FUNCTION
+**
+*/
+RRPREQUEST* RRPCreateDomainPlanRequest(char*, RRPDOMAINPLAN*);
+
+/*
+**
+** Function: RRPCreateNameServerPlanRequest
+**
+** Description: Creates the Mod request of a name server plan, e.g. to
+**              submit it to a session (see rrpSession.h)
+**
+** Input: char* - the name server's host name
+**        RRPNAMESERVERPLAN* - the plan
+**
+** Output: none
+**
+** Return: RRPREQUEST* - a pointer to an allocated RRPREQUEST structure.
+**                       NULL is returned if an internal error occurs.
+**
+** Note: THE MEMORY ALLOCATED FOR THE RRPREQUEST STRUCTURE MUST BE
+**       RELEASED BY CALLING THE RRPFreeRequest() FUNCTION
+**
+*/
+RRPREQUEST* RRPCreateNameServerPlanRequest(char*, RRPNAMESERVERPLAN*);
+
+/*
+**
+** Function: RRPFreeListChanges
+**
+** Description: Frees the vectors and properties of a list of changes
+**              and sets them to NULL
+**
+** Input: RRPLISTCHANGES* - a pointer to an RRPLISTCHANGES structure
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+int RRPFreeListChanges(RRPLISTCHANGES*);
+
+/*
+**
+** Function: RRPFreeDomainPlan
+**
+** Description: Frees the vectors and properties of a domain plan and
+**              sets them to NULL
+**
+** Input: RRPDOMAINPLAN* - a pointer to an RRPDOMAINPLAN structure
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+int RRPFreeDomainPlan(RRPDOMAINPLAN*);
+
+/*
+**
+** Function: RRPFreeNameServerPlan
+**
+** Description: Frees the vectors and properties of a name server plan
+**              and sets them to NULL
+**
+** Input: RRPNAMESERVERPLAN* - a pointer to an RRPNAMESERVERPLAN
+**                             structure
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+int RRPFreeNameServerPlan(RRPNAMESERVERPLAN*);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _RRP_PLAN_H_ */
@@ -68,6 +68,8 @@
 ** 	RRPContainsProperty(RRPPROPERTIES*, char*);
 ** 	RRPRemoveProperty(RRPPROPERTIES*, char*);
 ** 	RRPPutProperty(RRPPROPERTIES*, char*, char*);
+**    RRPPutPropertyN(RRPPROPERTIES*, const char*, size_t, const char*,
+**       size_t);
 ** 	RRPPutPropertyPair(RRPPROPERTIES*, char*);
 ** 	RRPClearProperties(RRPPROPERTIES*);
 ** 	RRPFreeProperties(RRPPROPERTIES*);
@@ -78,15 +80,37 @@
 **
 ** Changes:
 **
+** RRPCloneProperties() no longer copies the properties being cloned.
+** The original and the clone share a single reference counted list of
+** properties until one of them is modified, at which point the
+** modified structure makes a private copy of the list. The values of
+** each property are RRPVECTOR clones, so even that copy only duplicates
+** the property keys and not the values themselves.
+**
+** Oct. 19th, 2026: RRPPutPropertyN() adds a value from a key and value
+** of known lengths, so that callers holding them (e.g. std::string_view
+** in rrpAPI.hpp) need not copy them or have them measured first.
+**
 */
 #ifndef _RRP_PROPERTIES_H_
 #define _RRP_PROPERTIES_H_
 
 #include "rrpVector.h"
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 typedef struct _RRPPROPERTIES  RRPPROPERTIES;
 typedef struct _RRPPROPERTY_NODE  RRPPROPERTY_NODE;
 
+/*
+** Reference counted list of properties shared by an RRPPROPERTIES
+** structure and its clones (see RRPCloneProperties()). The structure
+** is private to rrpProperties.c
+*/
+typedef struct _RRPPROPERTIES_STORAGE  RRPPROPERTIES_STORAGE;
+
 
 #ifndef _RRP_BOOLEAN_
 	#define _RRP_BOOLEAN_
@@ -104,6 +128,7 @@ struct _RRPPROPERTIES {
 	RRPPROPERTY_NODE* current;
 	RRPPROPERTY_NODE* head;
 	RRPPROPERTY_NODE* tail;
+	RRPPROPERTIES_STORAGE* storage; /* NULL if the list is not shared */
 };
 
 /*
@@ -131,7 +156,10 @@ RRPPROPERTIES*  RRPCreateProperties(void);
 ** Function: RRPCloneProperties
 **
 ** Description: Allocates memory for and returns an exact copy of
-**              an RRPPROPERTIES structure
+**              an RRPPROPERTIES structure. The properties are not
+**              copied: both structures share the same properties until
+**              one of them is modified, at which point the modified
+**              structure makes a private copy of its properties
 **
 ** Input: RRPPROPERTIES* - a pointer to an RRPPROPERTIES structure
 **
@@ -208,6 +236,30 @@ int RRPRemoveProperty(RRPPROPERTIES*, char*);
 */
 int RRPPutProperty(RRPPROPERTIES*, char*, char*);
 
+/*
+**
+** Function: RRPPutPropertyN
+**
+** Description: Same as RRPPutProperty() but the key and value are
+**              strings of given lengths that need not be NUL
+**              terminated
+**
+** Input: RRPPROPERTIES* - a pointer to an RRPPROPERTIES structure
+**        const char* - a key identifying property
+**        size_t - the number of characters in the key
+**        const char* - a property value
+**        size_t - the number of characters in the value
+**
+** Output: none
+**
+** Return: int - returns 0 if successful. Returns -1 if an internal
+**               error occurs
+**
+**
+*/
+int RRPPutPropertyN(RRPPROPERTIES*, const char*, size_t, const char*,
+	size_t);
+
 /*
 **
 ** Function: RRPPutPropertyPair
@@ -308,7 +360,11 @@ int RRPGetPropertiesSize(RRPPROPERTIES*);
 **
 ** Description: Returns an RRPVector structure containing the values
 **              for a particular property. The property is identified
-**              by a specified key.
+**              by a specified key. The RRPVector belongs to the
+**              properties and may be shared with their clones (see
+**              RRPCloneProperties()): it must not be modified or freed.
+**              Use RRPPutProperty() and RRPRemoveProperty() to change
+**              the values of a property.
 **
 ** Input: RRPPROPERTIES* - a pointer to an RRPPROPERTIES structure
 **        char* - a key which identifies a property
@@ -344,4 +400,8 @@ RRPVECTOR* RRPGetProperty(RRPPROPERTIES*, char*);
 */
 char* RRPGetNextPropertyKey(RRPPROPERTIES*);
 
+#ifdef __cplusplus
+}
+#endif
+
 #endif /* _RRP_PROPERTIES_H_ */
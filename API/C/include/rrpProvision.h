@@ -0,0 +1,320 @@
+/* ===========================================================================
+ * Copyright (C) 2000 VeriSign, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * VeriSign Global Registry Service
+ * 21345 Ridgetop Circle
+ * Dulles, VA 20166
+ * ===========================================================================
+ * The RRP, APIs and Software are provided "as-is" and without any warranty
+ * of any kind.  NSI EXPRESSLY DISCLAIMS ALL WARRANTIES AND/OR CONDITIONS,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * AND CONDITIONS OF MERCHANTABILITY OR SATISFACTORY QUALITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE AND NONINFRINGEMENT OF THIRD PARTY RIGHTS.  NSI DOES
+ * NOT WARRANT THAT THE FUNCTIONS CONTAINED IN THE RRP, APIs OR SOFTWARE
+ * WILL MEET REGISTRAR'S REQUIREMENTS, OR THAT THE OPERATION OF THE RRP,
+ * APIs OR SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE,OR THAT DEFECTS IN
+ * THE RRP, APIs OR SOFTWARE WILL BE CORRECTED.  FURTHERMORE, NSI DOES NOT
+ * WARRANT NOR MAKE ANY REPRESENTATIONS REGARDING THE USE OR THE RESULTS OF
+ * THE RRP, APIs, SOFTWARE OR RELATED DOCUMENTATION IN TERMS OF THEIR
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR OTHERWISE.  SHOULD THE RRP, APIs
+ * OR SOFTWARE PROVE DEFECTIVE, REGISTRAR ASSUMES THE ENTIRE COST OF ALL
+ * NECESSARY SERVICING, REPAIR OR CORRECTION.
+ * ======================================================================== */
+
+/*
+**
+** Module Name: rrpProvision.h
+**
+** Version: 2.1 for RRP version 2.1.0
+**
+** Date: Oct. 19th, 2026
+**
+** Description: rrpProvision runs a batch of Add, Mod and Del commands on
+**              domains and name servers in parallel, in an order that
+**              respects the dependencies between them.
+**
+**              The operations are added to an RRPPROVISION one by one.
+**              When the batch is run (see RRPRunProvision()), a
+**              dependency graph is built from the operations themselves:
+**
+**                - an Add or Mod of a domain that references a name
+**                  server comes after the Add of that name server
+**                - the Del of a name server comes after the Mod commands
+**                  that remove it from a domain, and after every Del of
+**                  a domain (which may reference it)
+**                - the operations on the same domain or name server run
+**                  in the order they were added
+**
+**              and further dependencies can be given explicitly (see
+**              RRPAddProvisionDependency()). Every operation whose
+**              dependencies are done is submitted at once to a session
+**              pool (see rrpSession.h), so independent branches of the
+**              graph run side by side on all of the sessions. An
+**              operation that is refused or fails is not retried, and
+**              the operations that depend on it, directly or not, are
+**              skipped.
+**
+**              In the event of an internal error (bad parameter, memory
+**              allocation error, etc.) each function will return a
+**              value indicating that an error has occured (see function
+**              descriptions below). An internal error code that
+**              identifies the error will be set. The error code can
+**              be accessed and interpreted by the functions defined in
+**              rrpInternalError.h (see API documentation)
+**
+** Entry Points:
+**
+**    RRPCreateProvision(void);
+**    RRPProvisionAddNameServer(RRPPROVISION*, char*, RRPVECTOR*);
+**    RRPProvisionAddDomain(RRPPROVISION*, char*, RRPVECTOR*, int);
+**    RRPProvisionModifyDomain(RRPPROVISION*, char*, RRPVECTOR*,
+**        RRPVECTOR*);
+**    RRPProvisionDeleteDomain(RRPPROVISION*, char*);
+**    RRPProvisionDeleteNameServer(RRPPROVISION*, char*);
+**    RRPAddProvisionDependency(RRPPROVISION*, int, int);
+**    RRPRunProvision(RRPPROVISION*, RRPSESSIONPOOL*);
+**    RRPGetProvisionState(RRPPROVISION*, int, int*);
+**    RRPFreeProvision(RRPPROVISION*);
+**
+** Changes:
+**
+*/
+
+#ifndef _RRP_PROVISION_H_
+#define _RRP_PROVISION_H_
+
+#include "rrpAPI.h"
+#include "rrpVector.h"
+#include "rrpSession.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+** The structure is private to rrpProvision.c
+*/
+typedef struct _RRPPROVISION  RRPPROVISION;
+
+/*
+** State of an operation (see RRPGetProvisionState())
+*/
+typedef enum {
+	RRP_PROVISION_PENDING,     /* not run yet */
+	RRP_PROVISION_DONE,        /* accepted by the server */
+	RRP_PROVISION_REFUSED,     /* refused by the server */
+	RRP_PROVISION_FAILED,      /* no response (session failed, etc.) */
+	RRP_PROVISION_SKIPPED      /* an operation it depends on was not
+	                              done */
+} RRPPROVISIONSTATE;
+
+/*
+**
+** Function: RRPCreateProvision
+**
+** Description: Creates an empty batch of operations
+**
+** Input: none
+**
+** Output: none
+**
+** Return: RRPPROVISION* - a pointer to an allocated RRPPROVISION
+**                         structure. NULL is returned if an internal
+**                         error occurs.
+**
+** Note: THE MEMORY ALLOCATED FOR THE RRPPROVISION STRUCTURE MUST BE
+**       RELEASED BY CALLING THE RRPFreeProvision() FUNCTION
+**
+*/
+RRPPROVISION* RRPCreateProvision(void);
+
+/*
+**
+** Function: RRPProvisionAddNameServer
+**
+** Description: Adds the Add command of a name server to a batch
+**
+** Input: RRPPROVISION* - a pointer to an RRPPROVISION structure
+**        char* - the name server's host name
+**        RRPVECTOR* - the IP addresses of the name server, NULL if none
+**
+** Output: none
+**
+** Return: int - the index of the operation. -1 is returned if an
+**               internal error occurs.
+**
+*/
+int RRPProvisionAddNameServer(RRPPROVISION*, char*, RRPVECTOR*);
+
+/*
+**
+** Function: RRPProvisionAddDomain
+**
+** Description: Adds the Add command of a domain to a batch
+**
+** Input: RRPPROVISION* - a pointer to an RRPPROVISION structure
+**        char* - the domain name
+**        RRPVECTOR* - the name servers of the domain, NULL if none
+**        int - the registration period in years, 0 for the server's
+**              default
+**
+** Output: none
+**
+** Return: int - the index of the operation. -1 is returned if an
+**               internal error occurs.
+**
+*/
+int RRPProvisionAddDomain(RRPPROVISION*, char*, RRPVECTOR*, int);
+
+/*
+**
+** Function: RRPProvisionModifyDomain
+**
+** Description: Adds the Mod command of a domain that adds and deletes
+**              name servers to a batch
+**
+** Input: RRPPROVISION* - a pointer to an RRPPROVISION structure
+**        char* - the domain name
+**        RRPVECTOR* - the name servers to add, NULL if none
+**        RRPVECTOR* - the name servers to delete, NULL if none
+**
+** Output: none
+**
+** Return: int - the index of the operation. -1 is returned if an
+**               internal error occurs.
+**
+*/
+int RRPProvisionModifyDomain(RRPPROVISION*, char*, RRPVECTOR*, RRPVECTOR*);
+
+/*
+**
+** Function: RRPProvisionDeleteDomain
+**
+** Description: Adds the Del command of a domain to a batch
+**
+** Input: RRPPROVISION* - a pointer to an RRPPROVISION structure
+**        char* - the domain name
+**
+** Output: none
+**
+** Return: int - the index of the operation. -1 is returned if an
+**               internal error occurs.
+**
+*/
+int RRPProvisionDeleteDomain(RRPPROVISION*, char*);
+
+/*
+**
+** Function: RRPProvisionDeleteNameServer
+**
+** Description: Adds the Del command of a name server to a batch
+**
+** Input: RRPPROVISION* - a pointer to an RRPPROVISION structure
+**        char* - the name server's host name
+**
+** Output: none
+**
+** Return: int - the index of the operation. -1 is returned if an
+**               internal error occurs.
+**
+*/
+int RRPProvisionDeleteNameServer(RRPPROVISION*, char*);
+
+/*
+**
+** Function: RRPAddProvisionDependency
+**
+** Description: Makes an operation of a batch wait until another one is
+**              done
+**
+** Input: RRPPROVISION* - a pointer to an RRPPROVISION structure
+**        int - the index of the operation to run first
+**        int - the index of the operation to run after it
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+int RRPAddProvisionDependency(RRPPROVISION*, int, int);
+
+/*
+**
+** Function: RRPRunProvision
+**
+** Description: Runs the operations of a batch over the sessions of a
+**              pool, each as soon as the operations it depends on are
+**              done, and returns once every operation is done, refused,
+**              failed or skipped. A batch can only be run once
+**
+** Input: RRPPROVISION* - a pointer to an RRPPROVISION structure
+**        RRPSESSIONPOOL* - a pointer to an RRPSESSIONPOOL structure
+**
+** Output: none
+**
+** Return: int - the number of operations done. -1 is returned if the
+**               dependencies form a cycle (RRP_BAD_PARAM_ERROR; nothing
+**               is run), if the batch was already run, or if an
+**               internal error occurs.
+**
+** Note: If -1 is returned after the batch started, commands may still
+**       be in flight: the pool must be freed before the batch
+**
+*/
+int RRPRunProvision(RRPPROVISION*, RRPSESSIONPOOL*);
+
+/*
+**
+** Function: RRPGetProvisionState
+**
+** Description: Returns the state of an operation of a batch
+**
+** Input: RRPPROVISION* - a pointer to an RRPPROVISION structure
+**        int - the index of the operation
+**
+** Output: int* - the RRP response code, -1 if the operation has no
+**                response. May be NULL
+**
+** Return: RRPPROVISIONSTATE - the state. RRP_PROVISION_PENDING is
+**                             returned if an internal error occurs.
+**
+*/
+RRPPROVISIONSTATE RRPGetProvisionState(RRPPROVISION*, int, int*);
+
+/*
+**
+** Function: RRPFreeProvision
+**
+** Description: Frees all of the memory allocated for an RRPPROVISION
+**              structure
+**
+** Input: RRPPROVISION* - a pointer to an RRPPROVISION structure
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+int RRPFreeProvision(RRPPROVISION*);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _RRP_PROVISION_H_ */
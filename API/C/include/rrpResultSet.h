@@ -0,0 +1,388 @@
+/* ===========================================================================
+ * Copyright (C) 2000 VeriSign, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * VeriSign Global Registry Service
+ * 21345 Ridgetop Circle
+ * Dulles, VA 20166
+ * ===========================================================================
+ * The RRP, APIs and Software are provided "as-is" and without any warranty
+ * of any kind.  NSI EXPRESSLY DISCLAIMS ALL WARRANTIES AND/OR CONDITIONS,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * AND CONDITIONS OF MERCHANTABILITY OR SATISFACTORY QUALITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE AND NONINFRINGEMENT OF THIRD PARTY RIGHTS.  NSI DOES
+ * NOT WARRANT THAT THE FUNCTIONS CONTAINED IN THE RRP, APIs OR SOFTWARE
+ * WILL MEET REGISTRAR'S REQUIREMENTS, OR THAT THE OPERATION OF THE RRP,
+ * APIs OR SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE,OR THAT DEFECTS IN
+ * THE RRP, APIs OR SOFTWARE WILL BE CORRECTED.  FURTHERMORE, NSI DOES NOT
+ * WARRANT NOR MAKE ANY REPRESENTATIONS REGARDING THE USE OR THE RESULTS OF
+ * THE RRP, APIs, SOFTWARE OR RELATED DOCUMENTATION IN TERMS OF THEIR
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR OTHERWISE.  SHOULD THE RRP, APIs
+ * OR SOFTWARE PROVE DEFECTIVE, REGISTRAR ASSUMES THE ENTIRE COST OF ALL
+ * NECESSARY SERVICING, REPAIR OR CORRECTION.
+ * ======================================================================== */
+
+/*
+**
+** Module Name: rrpResultSet.h
+**
+** Version: 2.1 for RRP version 2.1.0
+**
+** Date: Oct. 19th, 2026
+**
+** Description: rrpResultSet provides a compact container for the
+**              results of many Check or Status commands (e.g. a sweep
+**              of a large list of domain names). Rather than keeping one
+**              RRPRESPONSE structure per command, each result is stored
+**              as one row of a set of parallel arrays (columns):
+**
+**                - the RRP response code
+**                - a bit mask of the domain's statuses. Each distinct
+**                  status string is stored once, and is identified by
+**                  its bit number (see RRPGetResultSetStatusBit())
+**                - the registration expiration date
+**                - the offset of the domain or name server name in a
+**                  single heap of NUL terminated strings
+**
+**              Each column can be accessed by row index, and the whole
+**              result set can be written to a CSV or binary file with a
+**              single sequential write.
+**
+**              In the event of an internal error (bad parameter, memory
+**              allocation error, etc.) each function will return a
+**              value indicating that an error has occured (see function
+**              descriptions below). An internal error code that
+**              identifies the error will be set. The error code can
+**              be accessed and interpreted by the functions defined in
+**              rrpInternalError.h (see API documentation)
+**
+** Entry Points:
+**
+**    RRPCreateResultSet(int);
+**    RRPAddResultSetRow(RRPRESULTSET*, char*, RRPRESPONSE*);
+**    RRPGetResultSetSize(RRPRESULTSET*);
+**    RRPGetResultSetName(RRPRESULTSET*, int);
+**    RRPGetResultSetCode(RRPRESULTSET*, int);
+**    RRPGetResultSetStatuses(RRPRESULTSET*, int);
+**    RRPGetResultSetExpiration(RRPRESULTSET*, int);
+**    RRPGetResultSetStatusBit(RRPRESULTSET*, char*);
+**    RRPGetResultSetStatusName(RRPRESULTSET*, int);
+**    RRPWriteResultSetCSV(RRPRESULTSET*, char*);
+**    RRPWriteResultSetBinary(RRPRESULTSET*, char*);
+**    RRPClearResultSet(RRPRESULTSET*);
+**    RRPFreeResultSet(RRPRESULTSET*);
+**
+** Changes:
+**
+*/
+
+#ifndef _RRP_RESULT_SET_H_
+#define _RRP_RESULT_SET_H_
+
+#include <time.h>
+#include "rrpAPI.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+** Maximum number of distinct status strings in a result set (one bit
+** of the status mask of each row per status string)
+*/
+#define RRP_MAX_RESULT_STATUSES 32
+
+typedef struct _RRPRESULTSET  RRPRESULTSET;
+
+struct _RRPRESULTSET {
+	int count;               /* number of rows */
+	int capacity;            /* number of rows allocated */
+	int* codes;              /* RRP response code of each row, -1 if
+	                            the command failed with an internal
+	                            error */
+	unsigned int* statuses;  /* status bit mask of each row */
+	time_t* expirations;     /* expiration date of each row, (time_t) -1
+	                            if the response had none */
+	size_t* names;           /* offset of the name of each row in
+	                            nameHeap */
+	char* nameHeap;          /* NUL terminated names of all rows */
+	size_t nameHeapSize;     /* bytes used in nameHeap */
+	size_t nameHeapCapacity; /* bytes allocated for nameHeap */
+	int statusCount;         /* number of distinct statuses */
+	char* statusNames[RRP_MAX_RESULT_STATUSES]; /* status of each bit */
+};
+
+/*
+**
+** Function: RRPCreateResultSet
+**
+** Description: Allocates memory for and returns a pointer to an empty
+**              RRPRESULTSET structure
+**
+** Input: int - the number of rows to allocate memory for initially.
+**              The result set grows as needed, so this is only a hint
+**
+** Output: none
+**
+** Return: RRPRESULTSET* - a pointer to an allocated RRPRESULTSET
+**         structure. NULL is returned if an internal error occurs.
+**
+** Note:   THE POINTER RETURNED MUST BE PASSED TO RRPFreeResultSet() IN
+**         ORDER TO FREE THE MEMORY ALLOCATED UPON CREATION OF STRUCTURE.
+*/
+RRPRESULTSET* RRPCreateResultSet(int);
+
+/*
+**
+** Function: RRPAddResultSetRow
+**
+** Description: Appends the result of one command to a result set. The
+**              response code, statuses and expiration date are copied
+**              from the response; the response itself is not kept and
+**              may be freed as soon as this function returns
+**
+** Input: RRPRESULTSET* - a pointer to an RRPRESULTSET structure
+**        char* - the domain or name server name the command was for
+**        RRPRESPONSE* - the response to the command. NULL indicates
+**                       that the command failed with an internal error
+**
+** Output: none
+**
+** Return: int - the row index of the new row. Returns -1 if an internal
+**               error occurs (RRP_LIMIT_EXCEEDED_ERROR if the response
+**               would bring the number of distinct statuses above
+**               RRP_MAX_RESULT_STATUSES), in which case the rows and
+**               statuses of the result set are left unchanged
+**
+*/
+int RRPAddResultSetRow(RRPRESULTSET*, char*, RRPRESPONSE*);
+
+/*
+**
+** Function: RRPGetResultSetSize
+**
+** Description: Returns the number of rows in a result set
+**
+** Input: RRPRESULTSET* - a pointer to an RRPRESULTSET structure
+**
+** Output: none
+**
+** Return: int - the number of rows. Returns -1 if an internal error
+**               occurs
+**
+*/
+int RRPGetResultSetSize(RRPRESULTSET*);
+
+/*
+**
+** Function: RRPGetResultSetName
+**
+** Description: Returns the domain or name server name of a row
+**
+** Input: RRPRESULTSET* - a pointer to an RRPRESULTSET structure
+**        int - row index
+**
+** Output: none
+**
+** Return: char* - the name. The string belongs to the result set and
+**                 must not be freed. Returns NULL if an internal error
+**                 occurs
+**
+*/
+char* RRPGetResultSetName(RRPRESULTSET*, int);
+
+/*
+**
+** Function: RRPGetResultSetCode
+**
+** Description: Returns the RRP response code of a row
+**
+** Input: RRPRESULTSET* - a pointer to an RRPRESULTSET structure
+**        int - row index
+**
+** Output: none
+**
+** Return: int - the response code, or -1 if the command failed with
+**               an internal error. Also returns -1 if an internal error
+**               occurs
+**
+*/
+int RRPGetResultSetCode(RRPRESULTSET*, int);
+
+/*
+**
+** Function: RRPGetResultSetStatuses
+**
+** Description: Returns the status bit mask of a row. Bit n is set if
+**              the response contained the status returned by
+**              RRPGetResultSetStatusName() for n
+**
+** Input: RRPRESULTSET* - a pointer to an RRPRESULTSET structure
+**        int - row index
+**
+** Output: none
+**
+** Return: unsigned int - the status bit mask. Returns 0 if an internal
+**                        error occurs
+**
+*/
+unsigned int RRPGetResultSetStatuses(RRPRESULTSET*, int);
+
+/*
+**
+** Function: RRPGetResultSetExpiration
+**
+** Description: Returns the registration expiration date of a row
+**
+** Input: RRPRESULTSET* - a pointer to an RRPRESULTSET structure
+**        int - row index
+**
+** Output: none
+**
+** Return: time_t - the expiration date. Returns (time_t) -1 if the
+**                  response had no expiration date or if an internal
+**                  error occurs
+**
+*/
+time_t RRPGetResultSetExpiration(RRPRESULTSET*, int);
+
+/*
+**
+** Function: RRPGetResultSetStatusBit
+**
+** Description: Returns the bit number that identifies a status in the
+**              status bit masks of a result set
+**
+** Input: RRPRESULTSET* - a pointer to an RRPRESULTSET structure
+**        char* - a status (e.g. "ACTIVE")
+**
+** Output: none
+**
+** Return: int - the bit number. Returns -1 if no row has the status or
+**               if an internal error occurs
+**
+*/
+int RRPGetResultSetStatusBit(RRPRESULTSET*, char*);
+
+/*
+**
+** Function: RRPGetResultSetStatusName
+**
+** Description: Returns the status identified by a bit number in the
+**              status bit masks of a result set
+**
+** Input: RRPRESULTSET* - a pointer to an RRPRESULTSET structure
+**        int - bit number
+**
+** Output: none
+**
+** Return: char* - the status. The string belongs to the result set and
+**                 must not be freed. Returns NULL if the bit is not used
+**                 or if an internal error occurs
+**
+*/
+char* RRPGetResultSetStatusName(RRPRESULTSET*, int);
+
+/*
+**
+** Function: RRPWriteResultSetCSV
+**
+** Description: Writes a result set to a file as comma separated values,
+**              one line per row: name, response code, statuses
+**              (separated by spaces) and expiration date
+**              ("yyyy-mm-dd hh:mm:ss", GMT, empty if none). The whole
+**              file is formatted in memory and written at once
+**
+** Input: RRPRESULTSET* - a pointer to an RRPRESULTSET structure
+**        char* - the name of the file to create (or replace)
+**
+** Output: none
+**
+** Return: int - returns 0 if successful. Returns -1 if an internal
+**               error occurs
+**
+*/
+int RRPWriteResultSetCSV(RRPRESULTSET*, char*);
+
+/*
+**
+** Function: RRPWriteResultSetBinary
+**
+** Description: Writes a result set to a file in binary form with a
+**              single gathering write. The file contains, in order:
+**
+**                - the 8 characters "RRPRSET1"
+**                - the number of rows and the number of statuses (int)
+**                - the size of the status heap and of the name heap
+**                  (size_t)
+**                - the status heap: the NUL terminated statuses, in
+**                  bit number order
+**                - the codes, statuses, expirations and names columns
+**                  (int, unsigned int, time_t and size_t arrays)
+**                - the name heap
+**
+**              All numbers are in the native size and byte order of
+**              the host that wrote the file
+**
+** Input: RRPRESULTSET* - a pointer to an RRPRESULTSET structure
+**        char* - the name of the file to create (or replace)
+**
+** Output: none
+**
+** Return: int - returns 0 if successful. Returns -1 if an internal
+**               error occurs
+**
+*/
+int RRPWriteResultSetBinary(RRPRESULTSET*, char*);
+
+/*
+**
+** Function: RRPClearResultSet
+**
+** Description: Removes all of the rows (and statuses) of a result set.
+**              The memory allocated for the columns is kept for reuse
+**
+** Input: RRPRESULTSET* - a pointer to an RRPRESULTSET structure
+**
+** Output: none
+**
+** Return: int - returns 0 if successful. Returns -1 if an internal
+**               error occurs
+**
+*/
+int RRPClearResultSet(RRPRESULTSET*);
+
+/*
+**
+** Function: RRPFreeResultSet
+**
+** Description: Frees all memory allocated for a result set
+**
+** Input: RRPRESULTSET* - a pointer to an RRPRESULTSET structure
+**
+** Output: none
+**
+** Return: int - returns 0 if successful. Returns -1 if an internal
+**               error occurs
+**
+*/
+int RRPFreeResultSet(RRPRESULTSET*);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _RRP_RESULT_SET_H_ */
@@ -0,0 +1,472 @@
+/* ===========================================================================
+ * Copyright (C) 2000 VeriSign, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * VeriSign Global Registry Service
+ * 21345 Ridgetop Circle
+ * Dulles, VA 20166
+ * ===========================================================================
+ * The RRP, APIs and Software are provided "as-is" and without any warranty
+ * of any kind.  NSI EXPRESSLY DISCLAIMS ALL WARRANTIES AND/OR CONDITIONS,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * AND CONDITIONS OF MERCHANTABILITY OR SATISFACTORY QUALITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE AND NONINFRINGEMENT OF THIRD PARTY RIGHTS.  NSI DOES
+ * NOT WARRANT THAT THE FUNCTIONS CONTAINED IN THE RRP, APIs OR SOFTWARE
+ * WILL MEET REGISTRAR'S REQUIREMENTS, OR THAT THE OPERATION OF THE RRP,
+ * APIs OR SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE,OR THAT DEFECTS IN
+ * THE RRP, APIs OR SOFTWARE WILL BE CORRECTED.  FURTHERMORE, NSI DOES NOT
+ * WARRANT NOR MAKE ANY REPRESENTATIONS REGARDING THE USE OR THE RESULTS OF
+ * THE RRP, APIs, SOFTWARE OR RELATED DOCUMENTATION IN TERMS OF THEIR
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR OTHERWISE.  SHOULD THE RRP, APIs
+ * OR SOFTWARE PROVE DEFECTIVE, REGISTRAR ASSUMES THE ENTIRE COST OF ALL
+ * NECESSARY SERVICING, REPAIR OR CORRECTION.
+ * ======================================================================== */
+
+/*
+**
+** Module Name: rrpRetry.h
+**
+** Version: 2.1 for RRP version 2.1.0
+**
+** Date: Oct. 19th, 2026
+**
+** Description: rrpRetry decides whether a failed RRP command should be
+**              sent again, and when. The outcome of a command is
+**              classified from its response code or, when there is no
+**              response, from the internal error code:
+**
+**                - commands that succeeded (2xx codes) or failed for a
+**                  reason that sending them again will not change (most
+**                  5xx codes, bad parameters) are never retried;
+**                - commands the server refused without executing them
+**                  (421, and 420, 520 and 521, after which the server
+**                  closes the connection) are retried whatever they do;
+**                - commands whose outcome is unknown, because the
+**                  connection failed or timed out before the response
+**                  arrived, are retried only if they are idempotent
+**                  (Check, Describe and Status) unless the policy says
+**                  otherwise: a Renew or Add sent twice could be
+**                  executed twice.
+**
+**              The outcome of an Add or a Renew of a domain that is
+**              unknown can often be settled by asking the server about
+**              the domain (see RRPCreateProbeRequest() and
+**              RRPResolveOutcome()): a Status command tells whether the
+**              domain was created for the registrar, or renewed, since
+**              the command was sent. The command is then sent again
+**              only if it was not executed. The sessions of
+**              rrpSession.h do so after a lost connection, for the
+**              commands the policy probes (see RRPSetRetryProbe()).
+**
+**              The delay before each retry grows exponentially with a
+**              decorrelated jitter: it is drawn at random between the
+**              base delay and three times the previous delay, up to a
+**              ceiling. Clients that failed together thus come back at
+**              different times instead of all at once, which keeps
+**              them from overwhelming a registry that is recovering
+**              from an outage.
+**
+**              The same delays pace other attempts that are always worth
+**              repeating, such as opening a connection again (see
+**              RRPGetBackoffDelay() and RRPSetSessionReconnect() in
+**              rrpSession.h).
+**
+**              A policy is not changed once it is in use, and can then
+**              be shared by any number of threads. The progress of
+**              each command is kept in its own RRPRETRYSTATE.
+**
+**              In the event of an internal error (bad parameter, memory
+**              allocation error, etc.) each function will return a
+**              value indicating that an error has occured (see function
+**              descriptions below). An internal error code that
+**              identifies the error will be set. The error code can
+**              be accessed and interpreted by the functions defined in
+**              rrpInternalError.h (see API documentation)
+**
+** Entry Points:
+**
+**    RRPCreateRetryPolicy(int, int, int);
+**    RRPSetRetryCommand(RRPRETRYPOLICY*, RRPCOMMAND, RRPBOOLEAN);
+**    RRPGetRetryCommand(RRPRETRYPOLICY*, RRPCOMMAND);
+**    RRPSetRetryProbe(RRPRETRYPOLICY*, RRPCOMMAND, RRPBOOLEAN);
+**    RRPGetRetryProbe(RRPRETRYPOLICY*, RRPCOMMAND);
+**    RRPClassifyOutcome(RRPRESPONSE*, RRPINTERNAL_ERROR_CODE);
+**    RRPCreateProbeRequest(RRPREQUEST*);
+**    RRPResolveOutcome(RRPREQUEST*, RRPRESPONSE*, char*, time_t);
+**    RRPIsIdempotentCommand(RRPCOMMAND);
+**    RRPGetRetryDelay(RRPRETRYPOLICY*, RRPRETRYSTATE*, RRPREQUEST*,
+**        RRPRESPONSE*, RRPINTERNAL_ERROR_CODE);
+**    RRPGetBackoffDelay(RRPRETRYPOLICY*, RRPRETRYSTATE*);
+**    RRPExecuteRetryRequest(RRPRETRYPOLICY*, RRPREQUEST*);
+**    RRPFreeRetryPolicy(RRPRETRYPOLICY*);
+**
+** Changes:
+**
+*/
+
+#ifndef _RRP_RETRY_H_
+#define _RRP_RETRY_H_
+
+#include "rrpAPI.h"
+#include "rrpInternalError.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+** The structure is private to rrpRetry.c
+*/
+typedef struct _RRPRETRYPOLICY  RRPRETRYPOLICY;
+
+/*
+** Outcomes of a command (see RRPClassifyOutcome())
+*/
+typedef enum {
+	RRP_OUTCOME_SUCCEEDED,      /* 2xx response */
+	RRP_OUTCOME_FAILED,         /* failed for good */
+	RRP_OUTCOME_REFUSED,        /* not executed, may be sent again */
+	RRP_OUTCOME_DISCONNECTED,   /* not executed, and the server closes
+	                               the connection */
+	RRP_OUTCOME_UNKNOWN         /* no response: may have been executed */
+} RRPOUTCOME;
+
+/*
+** Progress of the retries of a command. All fields are 0 before the
+** command is first sent
+*/
+typedef struct {
+	int attempts;               /* times the command failed so far */
+	int delay;                  /* last delay, in milliseconds */
+	unsigned int seed;          /* state of the random number generator */
+} RRPRETRYSTATE;
+
+/*
+** Default number of attempts, base delay and longest delay in
+** milliseconds (see RRPCreateRetryPolicy())
+*/
+#ifndef RRP_DEFAULT_RETRY_ATTEMPTS
+	#define RRP_DEFAULT_RETRY_ATTEMPTS 5
+#endif
+
+#ifndef RRP_DEFAULT_RETRY_BASE
+	#define RRP_DEFAULT_RETRY_BASE 100
+#endif
+
+#ifndef RRP_DEFAULT_RETRY_CEILING
+	#define RRP_DEFAULT_RETRY_CEILING 30000
+#endif
+
+/*
+** Most seconds the registry's clock is taken to be behind ours when
+** the dates of a domain are compared with the time a command was sent
+** (see RRPResolveOutcome())
+*/
+#ifndef RRP_PROBE_CLOCK_SKEW
+	#define RRP_PROBE_CLOCK_SKEW 60
+#endif
+
+/*
+**
+** Function: RRPCreateRetryPolicy
+**
+** Description: Creates a retry policy. Only idempotent commands are
+**              retried after an unknown outcome (see
+**              RRPSetRetryCommand()), and the outcome of Add and Renew
+**              is probed (see RRPSetRetryProbe())
+**
+** Input: int - the most times a command is sent, the first one included
+**              (1 or more; 1 never retries)
+**        int - the shortest delay before a retry, in milliseconds (1 or
+**              more)
+**        int - the longest delay before a retry, in milliseconds (no
+**              less than the shortest)
+**
+** Output: none
+**
+** Return: RRPRETRYPOLICY* - a pointer to an RRPRETRYPOLICY structure.
+**                           NULL is returned if an internal error
+**                           occurs.
+**
+** Note: THE POLICY MUST BE RELEASED BY CALLING RRPFreeRetryPolicy()
+**
+*/
+RRPRETRYPOLICY* RRPCreateRetryPolicy(int, int, int);
+
+/*
+**
+** Function: RRPSetRetryCommand
+**
+** Description: Tells whether a command is retried after an unknown
+**              outcome, e.g. a Renew that gives the current expiration
+**              year, which the server refuses to execute twice
+**
+** Input: RRPRETRYPOLICY* - a pointer to an RRPRETRYPOLICY structure
+**        RRPCOMMAND - the command
+**        RRPBOOLEAN - RRPTRUE to retry the command
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+int RRPSetRetryCommand(RRPRETRYPOLICY*, RRPCOMMAND, RRPBOOLEAN);
+
+/*
+**
+** Function: RRPGetRetryCommand
+**
+** Description: Tells whether a command is retried after an unknown
+**              outcome (see RRPSetRetryCommand())
+**
+** Input: RRPRETRYPOLICY* - a pointer to an RRPRETRYPOLICY structure
+**        RRPCOMMAND - the command
+**
+** Output: none
+**
+** Return: RRPBOOLEAN - RRPTRUE if the command is retried. RRPFALSE is
+**                      also returned if an internal error occurs.
+**
+*/
+RRPBOOLEAN RRPGetRetryCommand(RRPRETRYPOLICY*, RRPCOMMAND);
+
+/*
+**
+** Function: RRPSetRetryProbe
+**
+** Description: Tells whether the unknown outcome of a command is probed
+**              with a Status command before the command is given up
+**              (see RRPResolveOutcome()). Only Add and Renew can be
+**              probed, and are by default
+**
+** Input: RRPRETRYPOLICY* - a pointer to an RRPRETRYPOLICY structure
+**        RRPCOMMAND - the command
+**        RRPBOOLEAN - RRPTRUE to probe the command
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs or if the command can not be
+**               probed.
+**
+*/
+int RRPSetRetryProbe(RRPRETRYPOLICY*, RRPCOMMAND, RRPBOOLEAN);
+
+/*
+**
+** Function: RRPGetRetryProbe
+**
+** Description: Tells whether the unknown outcome of a command is probed
+**              (see RRPSetRetryProbe())
+**
+** Input: RRPRETRYPOLICY* - a pointer to an RRPRETRYPOLICY structure
+**        RRPCOMMAND - the command
+**
+** Output: none
+**
+** Return: RRPBOOLEAN - RRPTRUE if the command is probed. RRPFALSE is
+**                      also returned if an internal error occurs.
+**
+*/
+RRPBOOLEAN RRPGetRetryProbe(RRPRETRYPOLICY*, RRPCOMMAND);
+
+/*
+**
+** Function: RRPClassifyOutcome
+**
+** Description: Classifies the outcome of a command
+**
+** Input: RRPRESPONSE* - the response of the command, or NULL if it
+**                       failed
+**        RRPINTERNAL_ERROR_CODE - the internal error code of a command
+**                                 without a response
+**
+** Output: none
+**
+** Return: RRPOUTCOME - the outcome
+**
+*/
+RRPOUTCOME RRPClassifyOutcome(RRPRESPONSE*, RRPINTERNAL_ERROR_CODE);
+
+/*
+**
+** Function: RRPCreateProbeRequest
+**
+** Description: Creates the Status request that probes the outcome of
+**              an Add or a Renew of a domain
+**
+** Input: RRPREQUEST* - the Add or Renew request
+**
+** Output: none
+**
+** Return: RRPREQUEST* - a pointer to an allocated RRPREQUEST structure.
+**                       NULL is returned if an internal error occurs or
+**                       if the request can not be probed.
+**
+** Note: THE MEMORY ALLOCATED FOR THE RRPREQUEST STRUCTURE MUST BE
+**       RELEASED BY CALLING THE RRPFreeRequest() FUNCTION
+**
+*/
+RRPREQUEST* RRPCreateProbeRequest(RRPREQUEST*);
+
+/*
+**
+** Function: RRPResolveOutcome
+**
+** Description: Tells from the response of a probe (see
+**              RRPCreateProbeRequest()) whether an Add or a Renew whose
+**              outcome was unknown was executed:
+**
+**                - an Add was executed if the domain exists, is
+**                  sponsored by the registrar and was created after the
+**                  command was sent. It was not if the domain does not
+**                  exist, belongs to another registrar or is older;
+**                - a Renew that gives the current expiration year was
+**                  executed if the domain now expires in a later year,
+**                  and was not otherwise;
+**                - a Renew that does not is never settled: the dates
+**                  of the domain cannot tell it from another change,
+**                  so its outcome stays unknown unless the domain does
+**                  not exist or belongs to another registrar.
+**
+**              The creation date of the domain is compared with the
+**              time the command was sent less RRP_PROBE_CLOCK_SKEW, so
+**              a domain the registrar created just before an Add is
+**              taken as created by it
+**
+** Input: RRPREQUEST* - the Add or Renew request
+**        RRPRESPONSE* - the response of the probe
+**        char* - the registrar's id
+**        time_t - when the request was sent
+**
+** Output: none
+**
+** Return: RRPOUTCOME - RRP_OUTCOME_SUCCEEDED if the command was
+**                      executed, RRP_OUTCOME_REFUSED if it was not and
+**                      may be sent again, RRP_OUTCOME_UNKNOWN if the
+**                      probe does not tell. RRP_OUTCOME_UNKNOWN is also
+**                      returned if an internal error occurs.
+**
+*/
+RRPOUTCOME RRPResolveOutcome(RRPREQUEST*, RRPRESPONSE*, char*, time_t);
+
+/*
+**
+** Function: RRPIsIdempotentCommand
+**
+** Description: Tells whether executing a command twice has the same
+**              effect as executing it once
+**
+** Input: RRPCOMMAND - the command
+**
+** Output: none
+**
+** Return: RRPBOOLEAN - RRPTRUE for Check, Describe and Status
+**
+*/
+RRPBOOLEAN RRPIsIdempotentCommand(RRPCOMMAND);
+
+/*
+**
+** Function: RRPGetRetryDelay
+**
+** Description: Counts a failed attempt of a command, and tells whether
+**              and when to send it again
+**
+** Input: RRPRETRYPOLICY* - a pointer to an RRPRETRYPOLICY structure
+**        RRPRETRYSTATE* - the progress of the command, zeroed before
+**                         it is first sent
+**        RRPREQUEST* - the request
+**        RRPRESPONSE* - its response, or NULL if it failed
+**        RRPINTERNAL_ERROR_CODE - the internal error code of a request
+**                                 without a response
+**
+** Output: RRPRETRYSTATE* - the progress, updated
+**
+** Return: int - the time to wait before sending the request again, in
+**               milliseconds, or 0 if it must not be sent again. -1 is
+**               returned if an internal error occurs.
+**
+*/
+int RRPGetRetryDelay(RRPRETRYPOLICY*, RRPRETRYSTATE*, RRPREQUEST*,
+	RRPRESPONSE*, RRPINTERNAL_ERROR_CODE);
+
+/*
+**
+** Function: RRPGetBackoffDelay
+**
+** Description: Counts a failed attempt of an operation that is always
+**              worth trying again, such as opening a connection, and
+**              tells when to try again
+**
+** Input: RRPRETRYPOLICY* - a pointer to an RRPRETRYPOLICY structure
+**        RRPRETRYSTATE* - the progress of the operation, zeroed before
+**                         its first attempt
+**
+** Output: RRPRETRYSTATE* - the progress, updated
+**
+** Return: int - the time to wait before the next attempt, in
+**               milliseconds, or 0 once the policy's attempts are used
+**               up. -1 is returned if an internal error occurs.
+**
+*/
+int RRPGetBackoffDelay(RRPRETRYPOLICY*, RRPRETRYSTATE*);
+
+/*
+**
+** Function: RRPExecuteRetryRequest
+**
+** Description: Executes a request (see RRPExecuteRequest()) and sends
+**              it again as the policy allows while the server refuses
+**              it. Failures that leave the connection unusable are not
+**              retried, since the connection is not opened again here
+**
+** Input: RRPRETRYPOLICY* - a pointer to an RRPRETRYPOLICY structure
+**        RRPREQUEST* - a pointer to an RRPREQUEST structure
+**
+** Output: none
+**
+** Return: RRPRESPONSE* - the last response. NULL is returned if an
+**                        internal error occurs.
+**
+** Note: THE MEMORY ALLOCATED FOR THE RRPRESPONSE STRUCTURE MUST BE
+**       RELEASED BY CALLING THE RRPFreeResponse() FUNCTION
+**
+*/
+RRPRESPONSE* RRPExecuteRetryRequest(RRPRETRYPOLICY*, RRPREQUEST*);
+
+/*
+**
+** Function: RRPFreeRetryPolicy
+**
+** Description: Frees a retry policy
+**
+** Input: RRPRETRYPOLICY* - a pointer to an RRPRETRYPOLICY structure
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+int RRPFreeRetryPolicy(RRPRETRYPOLICY*);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _RRP_RETRY_H_ */
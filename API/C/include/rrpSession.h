@@ -0,0 +1,925 @@
+/* ===========================================================================
+ * Copyright (C) 2000 VeriSign, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * VeriSign Global Registry Service
+ * 21345 Ridgetop Circle
+ * Dulles, VA 20166
+ * ===========================================================================
+ * The RRP, APIs and Software are provided "as-is" and without any warranty
+ * of any kind.  NSI EXPRESSLY DISCLAIMS ALL WARRANTIES AND/OR CONDITIONS,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * AND CONDITIONS OF MERCHANTABILITY OR SATISFACTORY QUALITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE AND NONINFRINGEMENT OF THIRD PARTY RIGHTS.  NSI DOES
+ * NOT WARRANT THAT THE FUNCTIONS CONTAINED IN THE RRP, APIs OR SOFTWARE
+ * WILL MEET REGISTRAR'S REQUIREMENTS, OR THAT THE OPERATION OF THE RRP,
+ * APIs OR SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE,OR THAT DEFECTS IN
+ * THE RRP, APIs OR SOFTWARE WILL BE CORRECTED.  FURTHERMORE, NSI DOES NOT
+ * WARRANT NOR MAKE ANY REPRESENTATIONS REGARDING THE USE OR THE RESULTS OF
+ * THE RRP, APIs, SOFTWARE OR RELATED DOCUMENTATION IN TERMS OF THEIR
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR OTHERWISE.  SHOULD THE RRP, APIs
+ * OR SOFTWARE PROVE DEFECTIVE, REGISTRAR ASSUMES THE ENTIRE COST OF ALL
+ * NECESSARY SERVICING, REPAIR OR CORRECTION.
+ * ======================================================================== */
+
+/*
+**
+** Module Name: rrpSession.h
+**
+** Version: 2.1 for RRP version 2.1.0
+**
+** Date: Oct. 19th, 2026
+**
+** Description: rrpSession provides RRP sessions that can be used side by
+**              side and that pipeline their requests: a request is sent
+**              without waiting for the responses to the requests sent
+**              before it, and the responses are matched to the requests
+**              in the order they were sent.
+**
+**              An RRPSESSION is a logged in connection (see
+**              RRPOpenConnection()) with a queue of requests. Each
+**              request (see RRPCreateRequest()) is submitted with a
+**              completion function which is called with the response
+**              when it arrives. The session never blocks once it is
+**              logged in: RRPFlushSession() writes what the connection
+**              accepts and RRPProcessSession() handles the responses
+**              that have arrived, so a session can be driven from any
+**              event loop (see RRPGetSessionDescriptor()).
+**
+**              An RRPSESSIONPOOL is a set of sessions of one registrar
+**              with a simple event loop (see RRPPollSessionPool()).
+**              Requests submitted to the pool are given to the session
+**              with the fewest outstanding requests.
+**
+**              A session can be given a governor (see rrpGovernor.h):
+**              it then only writes a request once the governor allows
+**              its command, and holds the rest back without blocking.
+**              An event loop waits for such a session with a timeout
+**              (see RRPGetSessionTimeout()) rather than for its
+**              descriptor.
+**
+**              A session can also be told to open its connection again
+**              when it fails (RRPSetSessionReconnect()). It then keeps
+**              its requests, sends again those that are safe to repeat,
+**              and logs in again with the credentials it was opened
+**              with, so a long job rides through dropped connections
+**              and sessions the server closed while they were idle.
+**              An Add or a Renew whose response was lost is settled by
+**              asking the server about its domain, and sent again only
+**              if it was not executed.
+**
+**              A session opened on a set of endpoints (see
+**              rrpEndpoint.h) connects to the healthiest of several
+**              servers each time it opens its connection, and reports
+**              how each of them performs (RRPOpenEndpointSession(),
+**              RRPCreateEndpointSessionPool()).
+**
+**              A session with a journal (see rrpJournal.h) records the
+**              commands that change the registry, and makes their
+**              intent durable before writing them: one commit covers
+**              all the requests of a write (RRPSetSessionJournal()).
+**
+**              A process that shares the registrar's few sessions
+**              with others goes through a session broker (see
+**              rrpBroker.c) instead of logging in itself: a session
+**              opened on the broker's local socket pipelines its
+**              requests to the broker, which relays them over its own
+**              sessions (RRPOpenBrokerSession(),
+**              RRPCreateBrokerSessionPool()).
+**
+**              In the event of an internal error (bad parameter, memory
+**              allocation error, etc.) each function will return a
+**              value indicating that an error has occured (see function
+**              descriptions below). An internal error code that
+**              identifies the error will be set. The error code can
+**              be accessed and interpreted by the functions defined in
+**              rrpInternalError.h (see API documentation)
+**
+** Note:        A completion function is called from RRPProcessSession()
+**              or RRPPollSessionPool(). It may submit new requests, but
+**              must not close the session or free the pool.
+**
+** Entry Points:
+**
+**    RRPOpenSession(char*, unsigned short int, char*, char*);
+**    RRPOpenEndpointSession(RRPENDPOINTS*, char*, char*);
+**    RRPOpenBrokerSession(char*);
+**    RRPLoginConnection(RRPCONNECTION*, char*, char*);
+**    RRPSubmitSessionRequest(RRPSESSION*, RRPREQUEST*, RRPCOMPLETION,
+**        void*);
+**    RRPFlushSession(RRPSESSION*);
+**    RRPProcessSession(RRPSESSION*);
+**    RRPGetSessionDescriptor(RRPSESSION*);
+**    RRPGetSessionEvents(RRPSESSION*);
+**    RRPGetSessionPending(RRPSESSION*);
+**    RRPSetSessionWindow(RRPSESSION*, int);
+**    RRPGetSessionWindow(RRPSESSION*);
+**    RRPSetSessionGovernor(RRPSESSION*, RRPGOVERNOR*);
+**    RRPGetSessionTimeout(RRPSESSION*);
+**    RRPSetSessionReconnect(RRPSESSION*, RRPRETRYPOLICY*);
+**    RRPSetSessionJournal(RRPSESSION*, RRPJOURNAL*);
+**    RRPIsSessionOpen(RRPSESSION*);
+**    RRPCloseSession(RRPSESSION*);
+**    RRPCreateSessionPool(char*, unsigned short int, char*, char*, int);
+**    RRPCreateEndpointSessionPool(RRPENDPOINTS*, char*, char*, int);
+**    RRPCreateBrokerSessionPool(char*, int);
+**    RRPSubmitPoolRequest(RRPSESSIONPOOL*, RRPREQUEST*, RRPCOMPLETION,
+**        void*);
+**    RRPPollSessionPool(RRPSESSIONPOOL*, int);
+**    RRPRunSessionPool(RRPSESSIONPOOL*);
+**    RRPGetSessionPoolPending(RRPSESSIONPOOL*);
+**    RRPGetSessionPoolSize(RRPSESSIONPOOL*);
+**    RRPGetPoolSession(RRPSESSIONPOOL*, int);
+**    RRPSetSessionPoolWindow(RRPSESSIONPOOL*, int);
+**    RRPSetSessionPoolGovernor(RRPSESSIONPOOL*, RRPGOVERNOR*);
+**    RRPSetSessionPoolReconnect(RRPSESSIONPOOL*, RRPRETRYPOLICY*);
+**    RRPSetSessionPoolJournal(RRPSESSIONPOOL*, RRPJOURNAL*);
+**    RRPFreeSessionPool(RRPSESSIONPOOL*);
+**    RRPCheckDomains(char**, int, RRPSESSIONPOOL*, RRPCHECKRESULT*);
+**
+** Changes:
+**
+** Oct. 19th, 2026: RRPGetSessionWindow() added, so that a scheduler can
+** keep its requests out of the sessions' queues (see rrpClient.c).
+**
+** Oct. 19th, 2026: Sessions can be paced by a governor (see
+** rrpGovernor.h), and start with the process governor. A session held
+** back by its governor does not ask for POLLOUT; RRPGetSessionTimeout()
+** tells event loops when to flush it again.
+**
+*/
+
+#ifndef _RRP_SESSION_H_
+#define _RRP_SESSION_H_
+
+#include "rrpAPI.h"
+#include "rrpConnection.h"
+#include "rrpGovernor.h"
+#include "rrpRetry.h"
+#include "rrpEndpoint.h"
+#include "rrpJournal.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+** Default number of requests a session sends before it waits for a
+** response (see RRPSetSessionWindow())
+*/
+#ifndef RRP_DEFAULT_SESSION_WINDOW
+	#define RRP_DEFAULT_SESSION_WINDOW 32
+#endif
+
+/*
+** The structures are private to rrpSession.c
+*/
+typedef struct _RRPSESSION  RRPSESSION;
+typedef struct _RRPSESSIONPOOL  RRPSESSIONPOOL;
+
+/*
+** Completion function of a request. It is called with the request, the
+** response and the context pointer given to RRPSubmitSessionRequest().
+** The response is NULL if the request failed, in which case the internal
+** error code is set. THE RESPONSE MUST BE RELEASED BY THE COMPLETION
+** FUNCTION (see RRPFreeResponse()). The request is released when the
+** completion function returns.
+*/
+typedef void (*RRPCOMPLETION)(RRPREQUEST*, RRPRESPONSE*, void*);
+
+/*
+** Response codes of the Check command
+*/
+#define RRP_DOMAIN_AVAILABLE_CODE 210
+#define RRP_DOMAIN_NOT_AVAILABLE_CODE 211
+
+/*
+** The result of the Check command for one name (see RRPCheckDomains())
+*/
+typedef struct {
+	int code;             /* RRP response code, -1 if the check failed */
+	RRPBOOLEAN available; /* RRPTRUE if the code is 210 */
+} RRPCHECKRESULT;
+
+/*
+**
+** Function: RRPOpenSession
+**
+** Description: Connects to an RRP server and starts an authenticated
+**              session. The session is then in non-blocking mode
+**
+** Input: char* - host name or IP address of RRP server
+**        unsigned short int - RRP server port
+**        char* - registrar's id
+**        char* - registrar's password
+**
+** Output: none
+**
+** Return: RRPSESSION* - a pointer to an RRPSESSION structure. NULL is
+**                       returned if an internal error occurs, or if the
+**                       server refuses the session
+**                       (RRP_SESSION_REFUSED_ERROR).
+**
+** Note: THE SESSION MUST BE CLOSED BY CALLING RRPCloseSession()
+**
+*/
+RRPSESSION* RRPOpenSession(char*, unsigned short int, char*, char*);
+
+/*
+**
+** Function: RRPOpenEndpointSession
+**
+** Description: Starts an authenticated session on the best of a set of
+**              RRP servers (see RRPPickEndpoint()), trying each of them
+**              in turn if need be. The session reports its connections
+**              and the latency of its commands to the set, and picks a
+**              server again whenever it opens its connection again. The
+**              session is then in non-blocking mode
+**
+** Input: RRPENDPOINTS* - the set of endpoints. It still belongs to the
+**                        caller and must outlive the session
+**        char* - registrar's id
+**        char* - registrar's password
+**
+** Output: none
+**
+** Return: RRPSESSION* - a pointer to an RRPSESSION structure. NULL is
+**                       returned if an internal error occurs, or if no
+**                       server could be connected to.
+**
+** Note: THE SESSION MUST BE CLOSED BY CALLING RRPCloseSession()
+**
+*/
+RRPSESSION* RRPOpenEndpointSession(RRPENDPOINTS*, char*, char*);
+
+/*
+**
+** Function: RRPOpenBrokerSession
+**
+** Description: Connects to a session broker (see rrpBroker.c) on its
+**              Unix domain socket. The broker is already logged in, so
+**              the session needs no credentials and costs no login; its
+**              requests are relayed over the broker's own sessions. The
+**              session is then in non-blocking mode and is used like
+**              any other
+**
+** Input: char* - path of the broker's socket
+**
+** Output: none
+**
+** Return: RRPSESSION* - a pointer to an RRPSESSION structure. NULL is
+**                       returned if an internal error occurs, or if no
+**                       broker listens on the socket.
+**
+** Note: THE SESSION MUST BE CLOSED BY CALLING RRPCloseSession()
+**
+*/
+RRPSESSION* RRPOpenBrokerSession(char*);
+
+/*
+**
+** Function: RRPLoginConnection
+**
+** Description: Starts an authenticated session on a connection in
+**              blocking mode (see RRPOpenConnection())
+**
+** Input: RRPCONNECTION* - a pointer to an RRPCONNECTION structure
+**        char* - registrar's id
+**        char* - registrar's password
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs, or if the server refuses the
+**               session (RRP_SESSION_REFUSED_ERROR).
+**
+*/
+int RRPLoginConnection(RRPCONNECTION*, char*, char*);
+
+/*
+**
+** Function: RRPSubmitSessionRequest
+**
+** Description: Adds a request to the queue of a session. The request is
+**              sent by RRPFlushSession() once fewer than the session's
+**              window of requests are awaiting a response
+**
+** Input: RRPSESSION* - a pointer to an RRPSESSION structure
+**        RRPREQUEST* - the request. The session takes ownership of the
+**                      request if successful
+**        RRPCOMPLETION - function called with the response
+**        void* - context pointer passed to the completion function
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs or if the session is closed
+**               (RRP_NOT_CONNECTED_ERROR). The request then still
+**               belongs to the caller
+**
+*/
+int RRPSubmitSessionRequest(RRPSESSION*, RRPREQUEST*, RRPCOMPLETION, void*);
+
+/*
+**
+** Function: RRPFlushSession
+**
+** Description: Writes as many queued requests to the connection as it
+**              accepts without blocking. A session whose connection was
+**              lost opens it again first, once that is due (see
+**              RRPSetSessionReconnect()). A session that may reconnect
+**              and whose endpoint's breaker opened writes no new request,
+**              and opens its connection again, on another endpoint, once
+**              the written ones are answered (see RRPOpenEndpointSession())
+**
+** Input: RRPSESSION* - a pointer to an RRPSESSION structure
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs. If the connection failed, the
+**               session is closed and each of its requests is completed
+**               with a NULL response, unless the connection is to be
+**               opened again (see RRPSetSessionReconnect())
+**
+*/
+int RRPFlushSession(RRPSESSION*);
+
+/*
+**
+** Function: RRPProcessSession
+**
+** Description: Reads the responses that have arrived on the connection
+**              without blocking, calls the completion function of the
+**              matching requests, then sends more queued requests (see
+**              RRPFlushSession())
+**
+** Input: RRPSESSION* - a pointer to an RRPSESSION structure
+**
+** Output: none
+**
+** Return: int - the number of requests completed. -1 is returned if an
+**               internal error occurs. If the connection failed, the
+**               session is closed and each of its requests is completed
+**               with a NULL response, unless the connection is to be
+**               opened again (see RRPSetSessionReconnect())
+**
+*/
+int RRPProcessSession(RRPSESSION*);
+
+/*
+**
+** Function: RRPGetSessionDescriptor
+**
+** Description: Returns the file descriptor of the connection of a session
+**
+** Input: RRPSESSION* - a pointer to an RRPSESSION structure
+**
+** Output: none
+**
+** Return: int - the file descriptor. -1 is returned if an internal error
+**               occurs or if the session is closed.
+**
+*/
+int RRPGetSessionDescriptor(RRPSESSION*);
+
+/*
+**
+** Function: RRPGetSessionEvents
+**
+** Description: Returns the poll() events a session is waiting for:
+**              POLLIN while requests are awaiting a response, and
+**              POLLOUT while requests remain to be written (unless its
+**              governor holds them back, see RRPGetSessionTimeout()) or
+**              once its lost connection is due to be opened again
+**
+** Input: RRPSESSION* - a pointer to an RRPSESSION structure
+**
+** Output: none
+**
+** Return: int - the events. 0 is returned if the session has nothing to
+**               do, is closed, or if an internal error occurs
+**
+*/
+int RRPGetSessionEvents(RRPSESSION*);
+
+/*
+**
+** Function: RRPGetSessionPending
+**
+** Description: Returns the number of requests of a session that have not
+**              been completed
+**
+** Input: RRPSESSION* - a pointer to an RRPSESSION structure
+**
+** Output: none
+**
+** Return: int - the number of requests. -1 is returned if an internal
+**               error occurs.
+**
+*/
+int RRPGetSessionPending(RRPSESSION*);
+
+/*
+**
+** Function: RRPSetSessionWindow
+**
+** Description: Sets the number of requests a session sends before it
+**              waits for a response (RRP_DEFAULT_SESSION_WINDOW by
+**              default). A window of 1 disables pipelining
+**
+** Input: RRPSESSION* - a pointer to an RRPSESSION structure
+**        int - the window (1 or more)
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+int RRPSetSessionWindow(RRPSESSION*, int);
+
+/*
+**
+** Function: RRPGetSessionWindow
+**
+** Description: Returns the number of requests a session sends before it
+**              waits for a response (see RRPSetSessionWindow())
+**
+** Input: RRPSESSION* - a pointer to an RRPSESSION structure
+**
+** Output: none
+**
+** Return: int - the window. -1 is returned if an internal error occurs.
+**
+*/
+int RRPGetSessionWindow(RRPSESSION*);
+
+/*
+**
+** Function: RRPSetSessionGovernor
+**
+** Description: Sets the governor that paces the requests of a session.
+**              A session starts with the process governor (see
+**              RRPSetProcessGovernor())
+**
+** Input: RRPSESSION* - a pointer to an RRPSESSION structure
+**        RRPGOVERNOR* - the governor, or NULL for none. It still belongs
+**                       to the caller and must outlive the session
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+int RRPSetSessionGovernor(RRPSESSION*, RRPGOVERNOR*);
+
+/*
+**
+** Function: RRPGetSessionTimeout
+**
+** Description: Returns how long a session must wait before it can send:
+**              while its governor holds its next request back, while a
+**              probe the server was too busy to answer waits to be
+**              asked again, or while its lost connection waits to be
+**              opened again (see RRPSetSessionReconnect()). The session
+**              should be flushed (see RRPFlushSession()) once that time
+**              has passed, whether or not it has a descriptor
+**
+** Input: RRPSESSION* - a pointer to an RRPSESSION structure
+**
+** Output: none
+**
+** Return: int - the time in milliseconds, 0 if the session may be
+**               flushed now. -1 is returned if the session is not
+**               waiting or if an internal error occurs.
+**
+*/
+int RRPGetSessionTimeout(RRPSESSION*);
+
+/*
+**
+** Function: RRPSetSessionReconnect
+**
+** Description: Lets a session open its connection again, and log in with
+**              the credentials it was opened with, when the connection
+**              fails or the server closes it. The requests that were
+**              written but not answered are sent again if the policy
+**              retries their command after an unknown outcome (see
+**              RRPSetRetryCommand()). Those whose outcome the policy
+**              probes (see RRPSetRetryProbe()) are replaced by a Status
+**              command once the connection is open again: a command
+**              that was not executed is then sent again, and one that
+**              was is completed with the response of the probe. A
+**              probe the server is too busy to answer is sent again
+**              after the policy's delays, within its attempts, ahead
+**              of the requests not written yet. The others, and those
+**              the probe does not settle, are completed with a NULL
+**              response. The requests not written yet are kept.
+**              The connection is opened again as soon as the session
+**              has requests, then after the delays of the policy until
+**              it succeeds or the policy's attempts are used up, and
+**              the session is then closed
+**
+** Input: RRPSESSION* - a pointer to an RRPSESSION structure
+**        RRPRETRYPOLICY* - the policy (see rrpRetry.h), or NULL to
+**                          close the session when its connection fails
+**                          (the default). It still belongs to the caller
+**                          and must outlive the session
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+int RRPSetSessionReconnect(RRPSESSION*, RRPRETRYPOLICY*);
+
+/*
+**
+** Function: RRPSetSessionJournal
+**
+** Description: Records in a journal the requests of a session whose
+**              command the journal records (see RRPSetJournalCommand()).
+**              The intent of such a request is recorded when it is
+**              copied to the output buffer and committed before the
+**              buffer is written; its outcome is recorded when it is
+**              completed, as unknown if it was completed without a
+**              response. If the journal fails, the session is closed
+**              rather than send a command that is not recorded. The
+**              journal is set before any request is submitted
+**
+** Input: RRPSESSION* - a pointer to an RRPSESSION structure
+**        RRPJOURNAL* - the journal, or NULL for none (the default). It
+**                      still belongs to the caller and must outlive the
+**                      session
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+int RRPSetSessionJournal(RRPSESSION*, RRPJOURNAL*);
+
+/*
+**
+** Function: RRPIsSessionOpen
+**
+** Description: Tells whether a session is still usable
+**
+** Input: RRPSESSION* - a pointer to an RRPSESSION structure
+**
+** Output: none
+**
+** Return: RRPBOOLEAN - RRPTRUE if the session is open or is to open
+**                      its lost connection again, RRPFALSE if it is
+**                      closed or if an internal error occurs
+**
+*/
+RRPBOOLEAN RRPIsSessionOpen(RRPSESSION*);
+
+/*
+**
+** Function: RRPCloseSession
+**
+** Description: Ends a session, closes its connection and frees all of
+**              the memory allocated for it. Requests that have not been
+**              completed are completed with a NULL response:
+**              RRP_IO_ERROR for those that were written and may have
+**              been executed, RRP_NOT_CONNECTED_ERROR for the others.
+**              If no request is awaiting a response, the Quit command
+**              is sent and its response read first
+**
+** Input: RRPSESSION* - a pointer to an RRPSESSION structure
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+int RRPCloseSession(RRPSESSION*);
+
+/*
+**
+** Function: RRPCreateSessionPool
+**
+** Description: Opens a number of sessions to an RRP server for one
+**              registrar (see RRPOpenSession())
+**
+** Input: char* - host name or IP address of RRP server
+**        unsigned short int - RRP server port
+**        char* - registrar's id
+**        char* - registrar's password
+**        int - the number of sessions (1 or more)
+**
+** Output: none
+**
+** Return: RRPSESSIONPOOL* - a pointer to an RRPSESSIONPOOL structure.
+**                           NULL is returned if any of the sessions can
+**                           not be opened
+**
+** Note: THE POOL MUST BE RELEASED BY CALLING RRPFreeSessionPool()
+**
+*/
+RRPSESSIONPOOL* RRPCreateSessionPool(char*, unsigned short int, char*,
+	char*, int);
+
+/*
+**
+** Function: RRPCreateEndpointSessionPool
+**
+** Description: Opens a number of sessions for one registrar, spread
+**              over a set of RRP servers (see RRPOpenEndpointSession())
+**
+** Input: RRPENDPOINTS* - the set of endpoints. It still belongs to the
+**                        caller and must outlive the pool
+**        char* - registrar's id
+**        char* - registrar's password
+**        int - the number of sessions (1 or more)
+**
+** Output: none
+**
+** Return: RRPSESSIONPOOL* - a pointer to an RRPSESSIONPOOL structure.
+**                           NULL is returned if any of the sessions can
+**                           not be opened
+**
+** Note: THE POOL MUST BE RELEASED BY CALLING RRPFreeSessionPool()
+**
+*/
+RRPSESSIONPOOL* RRPCreateEndpointSessionPool(RRPENDPOINTS*, char*, char*,
+	int);
+
+/*
+**
+** Function: RRPCreateBrokerSessionPool
+**
+** Description: Opens a number of sessions to a session broker (see
+**              RRPOpenBrokerSession()), e.g. for a process that drives
+**              its requests through an RRPCLIENT (see rrpClient.h)
+**
+** Input: char* - path of the broker's socket
+**        int - the number of sessions (1 or more)
+**
+** Output: none
+**
+** Return: RRPSESSIONPOOL* - a pointer to an RRPSESSIONPOOL structure.
+**                           NULL is returned if any of the sessions can
+**                           not be opened
+**
+** Note: THE POOL MUST BE RELEASED BY CALLING RRPFreeSessionPool()
+**
+*/
+RRPSESSIONPOOL* RRPCreateBrokerSessionPool(char*, int);
+
+/*
+**
+** Function: RRPSubmitPoolRequest
+**
+** Description: Submits a request to the open session of a pool with the
+**              fewest requests outstanding (see RRPSubmitSessionRequest())
+**
+** Input: RRPSESSIONPOOL* - a pointer to an RRPSESSIONPOOL structure
+**        RRPREQUEST* - the request. The pool takes ownership of the
+**                      request if successful
+**        RRPCOMPLETION - function called with the response
+**        void* - context pointer passed to the completion function
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs or if no session is open
+**               (RRP_NOT_CONNECTED_ERROR)
+**
+*/
+int RRPSubmitPoolRequest(RRPSESSIONPOOL*, RRPREQUEST*, RRPCOMPLETION,
+	void*);
+
+/*
+**
+** Function: RRPPollSessionPool
+**
+** Description: Waits until at least one session of a pool can make
+**              progress, then sends queued requests and completes the
+**              requests whose responses have arrived
+**
+** Input: RRPSESSIONPOOL* - a pointer to an RRPSESSIONPOOL structure
+**        int - the longest time to wait, in milliseconds. -1 waits
+**              until a session is ready, or until the governor of a
+**              session lets it send again
+**
+** Output: none
+**
+** Return: int - the number of requests completed, which is 0 if the time
+**               ran out or if no requests are pending. -1 is returned if
+**               an internal error occurs.
+**
+*/
+int RRPPollSessionPool(RRPSESSIONPOOL*, int);
+
+/*
+**
+** Function: RRPRunSessionPool
+**
+** Description: Polls a pool (see RRPPollSessionPool()) until all of its
+**              requests, including those submitted by completion
+**              functions, have been completed
+**
+** Input: RRPSESSIONPOOL* - a pointer to an RRPSESSIONPOOL structure
+**
+** Output: none
+**
+** Return: int - the number of requests completed. -1 is returned if an
+**               internal error occurs.
+**
+*/
+int RRPRunSessionPool(RRPSESSIONPOOL*);
+
+/*
+**
+** Function: RRPGetSessionPoolPending
+**
+** Description: Returns the number of requests of all of the sessions of a
+**              pool that have not been completed
+**
+** Input: RRPSESSIONPOOL* - a pointer to an RRPSESSIONPOOL structure
+**
+** Output: none
+**
+** Return: int - the number of requests. -1 is returned if an internal
+**               error occurs.
+**
+*/
+int RRPGetSessionPoolPending(RRPSESSIONPOOL*);
+
+/*
+**
+** Function: RRPGetSessionPoolSize
+**
+** Description: Returns the number of sessions of a pool
+**
+** Input: RRPSESSIONPOOL* - a pointer to an RRPSESSIONPOOL structure
+**
+** Output: none
+**
+** Return: int - the number of sessions. -1 is returned if an internal
+**               error occurs.
+**
+*/
+int RRPGetSessionPoolSize(RRPSESSIONPOOL*);
+
+/*
+**
+** Function: RRPGetPoolSession
+**
+** Description: Returns one of the sessions of a pool
+**
+** Input: RRPSESSIONPOOL* - a pointer to an RRPSESSIONPOOL structure
+**        int - the index of the session (0 to size - 1)
+**
+** Output: none
+**
+** Return: RRPSESSION* - the session, which belongs to the pool. NULL is
+**                       returned if an internal error occurs.
+**
+*/
+RRPSESSION* RRPGetPoolSession(RRPSESSIONPOOL*, int);
+
+/*
+**
+** Function: RRPSetSessionPoolWindow
+**
+** Description: Sets the window of each session of a pool (see
+**              RRPSetSessionWindow())
+**
+** Input: RRPSESSIONPOOL* - a pointer to an RRPSESSIONPOOL structure
+**        int - the window (1 or more)
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+int RRPSetSessionPoolWindow(RRPSESSIONPOOL*, int);
+
+/*
+**
+** Function: RRPSetSessionPoolGovernor
+**
+** Description: Sets the governor of each session of a pool (see
+**              RRPSetSessionGovernor())
+**
+** Input: RRPSESSIONPOOL* - a pointer to an RRPSESSIONPOOL structure
+**        RRPGOVERNOR* - the governor, or NULL for none
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+int RRPSetSessionPoolGovernor(RRPSESSIONPOOL*, RRPGOVERNOR*);
+
+/*
+**
+** Function: RRPSetSessionPoolReconnect
+**
+** Description: Sets the reconnection policy of each session of a pool
+**              (see RRPSetSessionReconnect())
+**
+** Input: RRPSESSIONPOOL* - a pointer to an RRPSESSIONPOOL structure
+**        RRPRETRYPOLICY* - the policy, or NULL for none
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+int RRPSetSessionPoolReconnect(RRPSESSIONPOOL*, RRPRETRYPOLICY*);
+
+/*
+**
+** Function: RRPSetSessionPoolJournal
+**
+** Description: Sets the journal of each session of a pool (see
+**              RRPSetSessionJournal())
+**
+** Input: RRPSESSIONPOOL* - a pointer to an RRPSESSIONPOOL structure
+**        RRPJOURNAL* - the journal, or NULL for none
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+int RRPSetSessionPoolJournal(RRPSESSIONPOOL*, RRPJOURNAL*);
+
+/*
+**
+** Function: RRPFreeSessionPool
+**
+** Description: Closes all of the sessions of a pool (see
+**              RRPCloseSession()) and frees the pool
+**
+** Input: RRPSESSIONPOOL* - a pointer to an RRPSESSIONPOOL structure
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+int RRPFreeSessionPool(RRPSESSIONPOOL*);
+
+/*
+**
+** Function: RRPCheckDomains
+**
+** Description: Checks the availability of a number of domain names. The
+**              Check commands are pipelined over the sessions of a pool,
+**              and only as many are created as the sessions' windows can
+**              hold, so any number of names can be checked in constant
+**              memory
+**
+** Input: char** - array of domain names
+**        int - the number of names
+**        RRPSESSIONPOOL* - a pointer to an RRPSESSIONPOOL structure
+**
+** Output: RRPCHECKRESULT* - array of 'count' results, in the order of the
+**                           names. The code of a name whose check failed
+**                           (its session's connection failed, etc.) is
+**                           set to -1
+**
+** Return: int - the number of names checked, i.e. 'count' less the
+**               failed checks. -1 is returned if an internal error
+**               occurs: the Check commands not written yet are then
+**               dropped, and the responses to those already written
+**               are discarded when they arrive. The other requests of
+**               the pool are not affected.
+**
+*/
+int RRPCheckDomains(char**, int, RRPSESSIONPOOL*, RRPCHECKRESULT*);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _RRP_SESSION_H_ */
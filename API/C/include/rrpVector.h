@@ -60,7 +60,10 @@
 **
 ** 	RRPCreateVector(void);
 **    RRPCloneVector(RRPVECTOR*);
+**    RRPCreateVectorFromArray(char**, int, RRPBOOLEAN);
+**    RRPCreateVectorFromBuffer(char*, size_t, RRPBOOLEAN);
 ** 	RRPAddVectorElement(RRPVECTOR*, char*);
+**    RRPAddVectorElementN(RRPVECTOR*, const char*, size_t);
 ** 	RRPRemoveAllVectorElements(RRPVECTOR*);
 ** 	RRPFreeVector(RRPVECTOR*);
 ** 	RRPGetVectorSize(RRPVECTOR*);
@@ -69,11 +72,40 @@
 **
 ** Changes:
 **
+** RRPCloneVector() no longer copies the elements of the vector being
+** cloned. The original and the clone share a single reference counted
+** list of nodes, and a vector makes its own private copy of the list
+** only when it is modified (copy-on-write). Cloning is therefore a
+** constant time operation, and a list that is cloned many times (e.g.
+** one set of name servers used for many RRPAddDomain() calls) is only
+** stored once.
+**
+** RRPCreateVectorFromArray() and RRPCreateVectorFromBuffer() build a
+** complete vector from an array of strings or from a packed buffer in
+** a single allocation, instead of one allocation per node and string
+** with RRPAddVectorElement(). The strings can optionally be borrowed
+** from the caller rather than copied.
+**
+** Oct. 19th, 2026: RRPAddVectorElementN() adds an element from a string
+** of known length, so that callers holding one (e.g. a std::string in
+** rrpAPI.hpp) need not copy it or have it measured first.
+**
 */
 
 #ifndef _RRP_VECTOR_H_
 #define _RRP_VECTOR_H_
 
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef _RRP_BOOLEAN_
+	#define _RRP_BOOLEAN_
+	typedef enum { RRPFALSE, RRPTRUE }  RRPBOOLEAN;
+#endif
+
 typedef struct _RRPELEMENT_NODE  RRPELEMENT_NODE;
 
 struct _RRPELEMENT_NODE {
@@ -83,11 +115,18 @@ struct _RRPELEMENT_NODE {
 
 typedef struct _RRPVECTOR  RRPVECTOR;
 
+/*
+** Reference counted list of nodes shared by a vector and its clones
+** (see RRPCloneVector()). The structure is private to rrpVector.c
+*/
+typedef struct _RRPVECTOR_STORAGE  RRPVECTOR_STORAGE;
+
 struct _RRPVECTOR {
 	int count;
 	RRPELEMENT_NODE* current;
 	RRPELEMENT_NODE* head;
 	RRPELEMENT_NODE* tail;
+	RRPVECTOR_STORAGE* storage; /* NULL if the nodes are not shared */
 };
 
 /*
@@ -115,7 +154,10 @@ RRPVECTOR*  RRPCreateVector(void);
 **
 ** Description: Allocates memory for and returns a pointer to a
 **              a new RRPVECTOR structure which is an indentical
-**              copy of another
+**              copy of another. The elements are not copied: both
+**              vectors share the same elements until one of them is
+**              modified, at which point the modified vector makes a
+**              private copy of its elements
 **
 ** Input: RRPVECTOR* - a pointer to an RRPVECTOR structure to clone
 **
@@ -129,6 +171,67 @@ RRPVECTOR*  RRPCreateVector(void);
 */
 RRPVECTOR* RRPCloneVector(RRPVECTOR*);
 
+/*
+**
+** Function: RRPCreateVectorFromArray
+**
+** Description: Allocates memory for and returns a pointer to a new
+**              RRPVECTOR structure containing each string of an
+**              array, in order. All of the nodes (and the copies of the
+**              strings, unless they are borrowed) are allocated in one
+**              block rather than one at a time
+**
+** Input: char** - an array of strings
+**        int - the number of strings in the array
+**        RRPBOOLEAN - RRPTRUE to borrow the strings rather than copy
+**                     them. Borrowed strings must not be changed or
+**                     freed until the vector and all of its clones have
+**                     been freed or modified (a vector that is modified
+**                     makes its own copy of the strings)
+**
+** Output: none
+**
+** Return: RRPVECTOR* - a pointer to a new allocated RRPVECTOR structure.
+**         NULL is returned if an internal error occurs.
+**
+** Note:   THE POINTER RETURNED MUST BE PASSED TO RRPFreeVector() IN ORDER
+**         TO FREE THE MEMORY ALLOCATED UPON CREATION OF STRUCTURE.
+*/
+RRPVECTOR* RRPCreateVectorFromArray(char**, int, RRPBOOLEAN);
+
+/*
+**
+** Function: RRPCreateVectorFromBuffer
+**
+** Description: Allocates memory for and returns a pointer to a new
+**              RRPVECTOR structure containing each string of a buffer
+**              in which the strings are separated by NUL characters
+**              or newlines (a carriage return before a newline is
+**              ignored, as are empty strings). All of the nodes (and
+**              the copy of the buffer, unless it is borrowed) are
+**              allocated in one block
+**
+** Input: char* - the buffer
+**        size_t - the number of characters in the buffer
+**        RRPBOOLEAN - RRPTRUE to borrow the buffer rather than copy it.
+**                     A borrowed buffer must be followed by a NUL
+**                     character (at buffer[length]); the separator
+**                     after each string is overwritten with a NUL
+**                     character. It must not be changed or freed until
+**                     the vector and all of its clones have been freed
+**                     or modified (a vector that is modified makes its
+**                     own copy of the strings)
+**
+** Output: none
+**
+** Return: RRPVECTOR* - a pointer to a new allocated RRPVECTOR structure.
+**         NULL is returned if an internal error occurs.
+**
+** Note:   THE POINTER RETURNED MUST BE PASSED TO RRPFreeVector() IN ORDER
+**         TO FREE THE MEMORY ALLOCATED UPON CREATION OF STRUCTURE.
+*/
+RRPVECTOR* RRPCreateVectorFromBuffer(char*, size_t, RRPBOOLEAN);
+
 /*
 **
 ** Function: RRPAddVectorElement
@@ -148,6 +251,27 @@ RRPVECTOR* RRPCloneVector(RRPVECTOR*);
 */
 int RRPAddVectorElement(RRPVECTOR*, char*);
 
+/*
+**
+** Function: RRPAddVectorElementN
+**
+** Description: Adds a new vector element to the end of an
+**              RRPVECTOR structure, from a string of a given length
+**              that need not be NUL terminated
+**
+** Input: RRPVECTOR* - a pointer to an RRPVECTOR structure
+**        const char* - the element string
+**        size_t - the number of characters in the string
+**
+** Output: none
+**
+** Return: int - returns 0 if successful. Returns -1 if an internal
+**               error occurs.
+**
+**
+*/
+int RRPAddVectorElementN(RRPVECTOR*, const char*, size_t);
+
 /*
 **
 ** Function: RRPRemoveAllVectorElements
@@ -237,4 +361,8 @@ char* RRPGetVectorElementAt(RRPVECTOR*, int);
 */
 int RRPDeleteVectorElementAt(RRPVECTOR*, int);
 
+#ifdef __cplusplus
+}
+#endif
+
 #endif /* _RRP_VECTOR_H_ */
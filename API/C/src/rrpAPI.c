@@ -90,6 +90,19 @@
 **   RRPStatusNameServer(char*);
 **   RRPTransferDomain(char*, char*);
 **   RRPFreeResponse(RRPRESPONSE*);
+**   RRPCloneResponse(RRPRESPONSE*);
+**   RRPGetExpirationDate(RRPRESPONSE*);
+**   RRPGetResponseDate(RRPRESPONSE*, char*);
+**   RRPRestoreDomain(char*);
+**   RRPSyncDomain(char*, char*);
+**   RRPCreateRequest(RRPCOMMAND, RRPENTITY, const char*, size_t);
+**   RRPAppendRequestAttribute(RRPREQUEST*, const char*, size_t,
+**       const char*, size_t);
+**   RRPExecuteRequest(RRPREQUEST*);
+**   RRPFreeRequest(RRPREQUEST*);
+**   RRPParseResponse(char*);
+**   RRPParseRequest(const char*, size_t);
+**   RRPFormatResponse(RRPRESPONSE*, size_t*);
 **
 ** ========================================================================
 **
@@ -153,26 +166,85 @@
 ** RRPRESPONSE* RRPSyncDomain(char*, char*);
 ** RRPRESPONSE* RRPRestoreDomain(char*);
 **
+** ========================================================================
+**
+** Version: 2.1 for RRP version 2.1.0
+**
+** Date: Oct. 19th, 2026
+** Changes:
+**
+** Request strings are built in an RRPREQUEST structure, a buffer that
+** grows geometrically and knows its own length, instead of being
+** reallocated and re-scanned with strlen() for every line that is
+** appended. The request is sent with RRPSendRequestData() so that its
+** length is not computed again. RRPCreateRequest(),
+** RRPAppendRequestAttribute() and RRPExecuteRequest() expose this to
+** callers that already know the lengths of their strings; the C++ API
+** (rrpAPI.hpp) is built on them.
+**
+** RRPStartSession() no longer prints the request, which contains the
+** registrar's password, to standard output.
+**
+** RRPCloneResponse() has been added. The copy shares the attributes
+** of the original response instead of parsing or copying them again.
+**
+** RRPExecuteRequest(), and so every command of this API, waits for the
+** process governor (see rrpGovernor.h) when one is set.
+**
+** RRPGetResponseDate() reads any date attribute of a response, e.g. to
+** tell whether a domain changed after a command was sent (see
+** RRPResolveOutcome() in rrpRetry.h).
+**
+** RRPParseRequest() and RRPFormatResponse() turn strings into requests
+** and responses into strings, the reverse of what the rest of the API
+** does, for a session broker that relays them (see rrpBroker.c).
+**
 */
 
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <stdarg.h>
+#include <strings.h>
+#include <time.h>
 #include "rrpAPI.h"
 #include "rrpInternalError.h"
 #include "rrpConnection.h"
+#include "rrpGovernor.h"
 #include "rrpProperties.h"
 #include "rrpVector.h"
 
 RRPRESPONSE* createResponse (void);
 RRPRESPONSE* parseResponse(char*);
-RRPRESPONSE* processRequest (char*);
-char* appendStringToRequest (char*, char*);
-char* appendIntToRequest (char*, char*, int);
-char* mySprintf(char*, char*, ...);
-char* appendPropertiesToRequest (char*, char*, RRPPROPERTIES*);
-char* appendVectorToRequest (char*, char*, RRPVECTOR*);
-char* appendDeletedVectorToRequest (char*, char*, RRPVECTOR*);
+time_t parseDate (char*);
+static RRPRESPONSE* processRequest (RRPREQUEST*);
+static RRPREQUEST* createEntityRequest (RRPCOMMAND, RRPENTITY, char*);
+static int reserveRequest (RRPREQUEST*, size_t);
+static int appendLineToRequest (RRPREQUEST*, const char*, size_t,
+	const char*, size_t, const char*, size_t);
+static int appendStringToRequest (RRPREQUEST*, const char*, const char*);
+static int appendIntToRequest (RRPREQUEST*, const char*, int);
+static int appendPropertiesToRequest (RRPREQUEST*, const char*,
+	RRPPROPERTIES*);
+static int appendVectorToRequest (RRPREQUEST*, const char*, RRPVECTOR*);
+static int appendDeletedVectorToRequest (RRPREQUEST*, const char*,
+	RRPVECTOR*);
+static const char* findRequestLine (const char*, size_t, const char*,
+	size_t*);
+
+/*
+** RRP command names and entity prefixes, in the order of the RRPCOMMAND
+** and RRPENTITY enumerations (see rrpAPI.h)
+*/
+static const char* rrpCommandNames[] = {
+	"Add", "Check", "Del", "Describe", "Mod", "Quit", "Renew", "Restore",
+	"Session", "Status", "Sync", "Transfer"
+};
+
+static const char* rrpEntityNames[] = {
+	NULL,
+	"EntityName:Domain\r\nDomainName:",
+	"EntityName:NameServer\r\nNameServer:"
+};
 
 /*
 **
@@ -203,8 +275,7 @@ RRPRESPONSE* RRPStartSession (
 	char* registrarPassword,
 	char* newRegistrarPassword
 ) {
-	char* request = NULL;
-	int status = 0;
+	RRPREQUEST* request = NULL;
 
 	/*
 	** Validate parameters
@@ -214,22 +285,20 @@ RRPRESPONSE* RRPStartSession (
 		return NULL;
 	}
 
-	if (newRegistrarPassword != NULL && strlen(newRegistrarPassword) > 0) {
-		request = mySprintf("Session\r\n-Id:%s\r\n-Password:%s\r\n"
-			"-NewPassword:%s\r\n.\r\n", 
-			request, registrarID, registrarPassword, 
-			newRegistrarPassword);
-	}
-	else {
-		request = mySprintf("Session\r\n-Id:%s\r\n-Password:%s\r\n.\r\n",
-			request, registrarID, registrarPassword);
-	}
+	request = RRPCreateRequest(RRP_SESSION_COMMAND, RRP_NO_ENTITY, NULL, 0);
 
 	if (request == NULL) {
 		return NULL;
 	}
 
-	printf("%s\r\n", request);
+	if (appendStringToRequest(request, "-Id", registrarID) < 0 ||
+		appendStringToRequest(request, "-Password", registrarPassword) < 0 ||
+		(newRegistrarPassword != NULL && *newRegistrarPassword != '\0' &&
+		appendStringToRequest(request, "-NewPassword",
+			newRegistrarPassword) < 0)) {
+		RRPFreeRequest(request);
+		return NULL;
+	}
 
 	return processRequest(request);
 
@@ -256,13 +325,8 @@ RRPRESPONSE* RRPStartSession (
 **
 */
 RRPRESPONSE* RRPEndSession () {
-   char* request = NULL;
-
-	if ( (request = mySprintf("Quit\r\n.\r\n", request)) == NULL) {
-		return NULL;
-	}
-
-	return processRequest(request);
+	return processRequest(RRPCreateRequest(RRP_QUIT_COMMAND, RRP_NO_ENTITY,
+		NULL, 0));
 
 } /* RRPEndSession */
 
@@ -298,7 +362,7 @@ RRPRESPONSE* RRPAddDomain (
 	RRPVECTOR* nameServers,
 	int registrationPeriod
 ) {
-   char* request = NULL;
+	RRPREQUEST* request = NULL;
 
 	/*
 	** Validate parameters
@@ -308,29 +372,18 @@ RRPRESPONSE* RRPAddDomain (
 		return NULL;
 	}
 
-	request = mySprintf("Add\r\nEntityName:Domain\r\nDomainName:%s\r\n",
-		request, domainName);
+	request = createEntityRequest(RRP_ADD_COMMAND, RRP_DOMAIN_ENTITY,
+		domainName);
 
 	if (request == NULL) {
 		return NULL;
 	}
 
-	if (nameServers != NULL) {
-		request = appendVectorToRequest(request, "NameServer", nameServers);
-		if (request == NULL) {
-			return NULL;
-		}
-	}
-
-	if ( registrationPeriod > 0) {
-		request = appendIntToRequest(request, "-Period:", registrationPeriod);
-	   if (request == NULL) {
-		 return NULL;
-      }
-	}
-
-	request = mySprintf(".\r\n", request);
-	if (request == NULL) {
+	if ((nameServers != NULL &&
+		appendVectorToRequest(request, "NameServer", nameServers) < 0) ||
+		(registrationPeriod > 0 &&
+		appendIntToRequest(request, "-Period", registrationPeriod) < 0)) {
+		RRPFreeRequest(request);
 		return NULL;
 	}
 
@@ -363,7 +416,7 @@ RRPRESPONSE* RRPAddNameServer (
 	char* nameServer,
 	RRPVECTOR* ipAddresses
 ) {
-	char* request = NULL;
+	RRPREQUEST* request = NULL;
 
 	/*
 	** Validate parameters
@@ -373,21 +426,16 @@ RRPRESPONSE* RRPAddNameServer (
 		return NULL;
 	}
 
-	request = mySprintf("Add\r\nEntityName:NameServer\r\nNameServer:%s\r\n",
-		request, nameServer);
+	request = createEntityRequest(RRP_ADD_COMMAND, RRP_NAMESERVER_ENTITY,
+		nameServer);
+
 	if (request == NULL) {
 		return NULL;
 	}
 
-	if (ipAddresses != NULL) {
-		request = appendVectorToRequest(request, "IPAddress", ipAddresses);
-		if (request == NULL) {
-			return NULL;
-		}
-	}
-
-	request = mySprintf(".\r\n", request);
-	if (request == NULL) {
+	if (ipAddresses != NULL &&
+		appendVectorToRequest(request, "IPAddress", ipAddresses) < 0) {
+		RRPFreeRequest(request);
 		return NULL;
 	}
 
@@ -418,8 +466,6 @@ RRPRESPONSE* RRPAddNameServer (
 RRPRESPONSE* RRPCheckDomain (
 	char* domainName
 ) {
-	char* request = NULL;
-
 	/*
 	** Validate parameters
 	*/
@@ -428,14 +474,8 @@ RRPRESPONSE* RRPCheckDomain (
 		return NULL;
 	}
 
-	request = mySprintf("Check\r\nEntityName:Domain\r\n"
-		"DomainName:%s\r\n.\r\n", request, domainName);
-
-	if (request == NULL) {
-		return NULL;
-	}
-
-	return processRequest(request);
+	return processRequest(createEntityRequest(RRP_CHECK_COMMAND, RRP_DOMAIN_ENTITY,
+		domainName));
 
 } /* RRPCheckDomain */
 
@@ -462,8 +502,6 @@ RRPRESPONSE* RRPCheckDomain (
 RRPRESPONSE* RRPCheckNameServer (
 	char* nameServer
 ) {
-	char* request = NULL;
-
 	/*
 	** Validate parameters
 	*/
@@ -472,14 +510,8 @@ RRPRESPONSE* RRPCheckNameServer (
 		return NULL;
 	}
 
-	request = mySprintf("Check\r\nEntityName:NameServer\r\n"
-		"NameServer:%s\r\n.\r\n", request, nameServer);
-
-	if (request == NULL) {
-		return NULL;
-	}
-
-	return processRequest(request);
+	return processRequest(createEntityRequest(RRP_CHECK_COMMAND, RRP_NAMESERVER_ENTITY,
+		nameServer));
 
 } /* RRPCheckNameServer */
 
@@ -507,8 +539,6 @@ RRPRESPONSE* RRPCheckNameServer (
 RRPRESPONSE* RRPDeleteDomain (
 	char* domainName
 ) {
-	char* request = NULL;
-
 	/*
 	** Validate parameters
 	*/
@@ -517,14 +547,8 @@ RRPRESPONSE* RRPDeleteDomain (
 		return NULL;
 	}
 
-	request = mySprintf("Del\r\nEntityName:Domain\r\nDomainName:%s\r\n.\r\n",
-		request, domainName);
-
-	if (request == NULL) {
-		return NULL;
-	}
-
-	return processRequest(request);
+	return processRequest(createEntityRequest(RRP_DEL_COMMAND, RRP_DOMAIN_ENTITY,
+		domainName));
 
 } /* RRPDeleteDomain */
 
@@ -551,8 +575,6 @@ RRPRESPONSE* RRPDeleteDomain (
 RRPRESPONSE* RRPDeleteNameServer (
 	char* nameServer
 ) {
-	char* request = NULL;
-
 	/*
 	** Validate parameters
 	*/
@@ -561,14 +583,8 @@ RRPRESPONSE* RRPDeleteNameServer (
 		return NULL;
 	}
 
-	request = mySprintf("Del\r\nEntityName:NameServer\r\n"
-		"NameServer:%s\r\n.\r\n", request, nameServer);
-
-	if (request == NULL) {
-		return NULL;
-	}
-
-	return processRequest(request);
+	return processRequest(createEntityRequest(RRP_DEL_COMMAND, RRP_NAMESERVER_ENTITY,
+		nameServer));
 
 } /* RRPDeleteNameServer */
 
@@ -597,20 +613,20 @@ RRPRESPONSE* RRPDeleteNameServer (
 RRPRESPONSE* RRPDescribe (
 	char* target
 ) {
-	char* request = NULL;
+	RRPREQUEST* request = NULL;
 
-	if (target == NULL) {
-		request = mySprintf("Describe\r\n.\r\n", request);
-	}
-	else {
-		request = mySprintf("Describe\r\n-Target:%s\r\n.\r\n", 
-			request, target);
-	}
+	request = RRPCreateRequest(RRP_DESCRIBE_COMMAND, RRP_NO_ENTITY, NULL, 0);
 
 	if (request == NULL) {
 		return NULL;
 	}
 
+	if (target != NULL &&
+		appendStringToRequest(request, "-Target", target) < 0) {
+		RRPFreeRequest(request);
+		return NULL;
+	}
+
 	return processRequest(request);
 
 } /* RRPDescribe */
@@ -666,7 +682,7 @@ RRPRESPONSE* RRPModifyDomain (
 	RRPPROPERTIES* modifiedStatuses,
 	RRPVECTOR* deletedStatuses
 ) {
-	char* request = NULL;
+	RRPREQUEST* request = NULL;
 
 	/*
 	** Validate parameters
@@ -676,65 +692,26 @@ RRPRESPONSE* RRPModifyDomain (
 		return NULL;
 	}
 
-
-	request = mySprintf("Mod\r\nEntityName:Domain\r\nDomainName:%s\r\n",
-		request, domainName);
+	request = createEntityRequest(RRP_MOD_COMMAND, RRP_DOMAIN_ENTITY,
+		domainName);
 
 	if (request == NULL) {
 		return NULL;
 	}
 
-
-	if (addedNameServers != NULL) {
-		request = appendVectorToRequest(request, "NameServer", 
-			addedNameServers);
-		if (request == NULL) {
-			return NULL;
-		}
-	}
-
-	if (modifiedNameServers != NULL) {
-		request = appendPropertiesToRequest(request, "NameServer",
-			modifiedNameServers);
-		if (request == NULL) {
-			return NULL;
-		}
-	}
-
-	if (deletedNameServers != NULL) {
-		request = appendDeletedVectorToRequest(request, "NameServer",
-			deletedNameServers);
-		if (request == NULL) {
-			return NULL;
-		}
-	}
-
-	if (addedStatuses != NULL) {
-		request = appendVectorToRequest(request, "Status", addedStatuses);
-		if (request == NULL) {
-			return NULL;
-		}
-	}
-
-
-	if (modifiedStatuses != NULL) {
-		request = appendPropertiesToRequest(request, "Status",
-			modifiedStatuses);
-		if (request == NULL) {
-			return NULL;
-		}
-	}
-
-	if (deletedStatuses != NULL) {
-		request = appendDeletedVectorToRequest(request, "Status",
-			deletedStatuses);
-		if (request == NULL) {
-			return NULL;
-		}
-	}
-
-	request = mySprintf(".\r\n", request);
-	if (request == NULL) {
+	if ((addedNameServers != NULL && appendVectorToRequest(request,
+			"NameServer", addedNameServers) < 0) ||
+		(modifiedNameServers != NULL && appendPropertiesToRequest(request,
+			"NameServer", modifiedNameServers) < 0) ||
+		(deletedNameServers != NULL && appendDeletedVectorToRequest(request,
+			"NameServer", deletedNameServers) < 0) ||
+		(addedStatuses != NULL && appendVectorToRequest(request,
+			"Status", addedStatuses) < 0) ||
+		(modifiedStatuses != NULL && appendPropertiesToRequest(request,
+			"Status", modifiedStatuses) < 0) ||
+		(deletedStatuses != NULL && appendDeletedVectorToRequest(request,
+			"Status", deletedStatuses) < 0)) {
+		RRPFreeRequest(request);
 		return NULL;
 	}
 
@@ -782,7 +759,7 @@ RRPRESPONSE* RRPModifyNameServer (
 	RRPPROPERTIES* modifiedIPAddresses,
 	RRPVECTOR* deletedIPAddresses
 ) {
-	char* request = NULL;
+	RRPREQUEST* request = NULL;
 
 	/*
 	** Validate parameters
@@ -792,46 +769,22 @@ RRPRESPONSE* RRPModifyNameServer (
 		return NULL;
 	}
 
-	request = mySprintf("Mod\r\nEntityName:NameServer\r\nNameServer:%s\r\n",
-		request, nameServer);
+	request = createEntityRequest(RRP_MOD_COMMAND, RRP_NAMESERVER_ENTITY,
+		nameServer);
 
 	if (request == NULL) {
 		return NULL;
 	}
 
-
-	if (newNameServer != NULL) {
-		request = mySprintf("NewNameServer:%s\r\n", request, newNameServer);
-		if (request == NULL) {
-			return NULL;
-		}
-	}
-
-	if (addedIPAddresses != NULL) {
-		request = appendVectorToRequest(request, "IPAddress", addedIPAddresses);
-		if (request == NULL) {
-			return NULL;
-		}
-	}
-
-	if (modifiedIPAddresses != NULL) {
-		request = appendPropertiesToRequest(request, "IPAddress",
-			modifiedIPAddresses);
-		if (request == NULL) {
-			return NULL;
-		}
-	}
-
-	if (deletedIPAddresses != NULL) {
-		request = appendDeletedVectorToRequest(request, "IPAddress",
-			deletedIPAddresses);
-		if (request == NULL) {
-			return NULL;
-		}
-	}
-
-	request = mySprintf(".\r\n", request);
-	if (request == NULL) {
+	if ((newNameServer != NULL && appendStringToRequest(request,
+			"NewNameServer", newNameServer) < 0) ||
+		(addedIPAddresses != NULL && appendVectorToRequest(request,
+			"IPAddress", addedIPAddresses) < 0) ||
+		(modifiedIPAddresses != NULL && appendPropertiesToRequest(request,
+			"IPAddress", modifiedIPAddresses) < 0) ||
+		(deletedIPAddresses != NULL && appendDeletedVectorToRequest(request,
+			"IPAddress", deletedIPAddresses) < 0)) {
+		RRPFreeRequest(request);
 		return NULL;
 	}
 
@@ -871,7 +824,7 @@ RRPRESPONSE* RRPRenewDomain (
 	int renewRegistrationPeriod,
 	int currentExpirationYear
 ) {
-	char* request = NULL;
+	RRPREQUEST* request = NULL;
 
 	/*
 	** Validate parameters
@@ -881,31 +834,18 @@ RRPRESPONSE* RRPRenewDomain (
 		return NULL;
 	}
 
-	request = mySprintf("Renew\r\nEntityName:Domain\r\nDomainName:%s\r\n",
-		request, domainName);
+	request = createEntityRequest(RRP_RENEW_COMMAND, RRP_DOMAIN_ENTITY,
+		domainName);
 
 	if (request == NULL) {
 		return NULL;
 	}
 
-	if (renewRegistrationPeriod > 0) {
-		request = appendIntToRequest(request, "-Period:", 
-			renewRegistrationPeriod);
-		if (request == NULL) {
-			return NULL;
-		}
-	}
-
-	if (currentExpirationYear > 0) {
-		request = appendIntToRequest(request, "-CurrentExpirationYear:", 
-			currentExpirationYear);
-		if (request == NULL) {
-			return NULL;
-		}
-	}
-
-	request = mySprintf(".\r\n", request);
-	if (request == NULL) {
+	if ((renewRegistrationPeriod > 0 && appendIntToRequest(request,
+			"-Period", renewRegistrationPeriod) < 0) ||
+		(currentExpirationYear > 0 && appendIntToRequest(request,
+			"-CurrentExpirationYear", currentExpirationYear) < 0)) {
+		RRPFreeRequest(request);
 		return NULL;
 	}
 
@@ -936,8 +876,6 @@ RRPRESPONSE* RRPRenewDomain (
 RRPRESPONSE* RRPRestoreDomain (
 	char* domainName
 ) {
-	char* request = NULL;
-
 	/*
 	** Validate parameters
 	*/
@@ -946,14 +884,8 @@ RRPRESPONSE* RRPRestoreDomain (
 		return NULL;
 	}
 
-	request = mySprintf("Restore\r\nEntityName:Domain\r\n"
-		"DomainName:%s\r\n.\r\n", request, domainName);
-
-	if (request == NULL) {
-		return NULL;
-	}
-
-	return processRequest(request);
+	return processRequest(createEntityRequest(RRP_RESTORE_COMMAND, RRP_DOMAIN_ENTITY,
+		domainName));
 
 } /* RRPRestoreDomain */
 
@@ -980,8 +912,6 @@ RRPRESPONSE* RRPRestoreDomain (
 RRPRESPONSE* RRPStatusDomain (
 	char* domainName
 ) {
-	char* request = NULL;
-
 	/*
 	** Validate parameters
 	*/
@@ -990,14 +920,8 @@ RRPRESPONSE* RRPStatusDomain (
 		return NULL;
 	}
 
-	request = mySprintf("Status\r\nEntityName:Domain\r\nDomainName:%s\r\n.\r\n",
-		request, domainName);
-
-	if (request == NULL) {
-		return NULL;
-	}
-
-	return processRequest(request);
+	return processRequest(createEntityRequest(RRP_STATUS_COMMAND, RRP_DOMAIN_ENTITY,
+		domainName));
 
 } /* RRPStatusDomain */
 
@@ -1024,8 +948,6 @@ RRPRESPONSE* RRPStatusDomain (
 RRPRESPONSE* RRPStatusNameServer (
 	char* nameServer
 ) {
-	char* request = NULL;
-
 	/*
 	** Validate parameters
 	*/
@@ -1034,16 +956,8 @@ RRPRESPONSE* RRPStatusNameServer (
 		return NULL;
 	}
 
-	request = mySprintf("Status\r\nEntityName:NameServer\r\nNameServer:%s",
-		request, nameServer);
-
-	request = mySprintf("\r\n.\r\n", request);
-
-	if (request == NULL) {
-		return NULL;
-	}
-
-	return processRequest(request);
+	return processRequest(createEntityRequest(RRP_STATUS_COMMAND, RRP_NAMESERVER_ENTITY,
+		nameServer));
 
 } /* RRPStatusNameServer */
 
@@ -1072,7 +986,7 @@ RRPRESPONSE* RRPSyncDomain (
 	char* domainName,
 	char* syncDate
 ) {
-   char* request = NULL;
+	RRPREQUEST* request = NULL;
 
 	/*
 	** Validate parameters
@@ -1082,15 +996,15 @@ RRPRESPONSE* RRPSyncDomain (
 		return NULL;
 	}
 
-	request = mySprintf("Sync\r\nEntityName:Domain\r\nDomainName:%s\r\ndate:%s\r\n",
-		request, domainName, syncDate);
+	request = createEntityRequest(RRP_SYNC_COMMAND, RRP_DOMAIN_ENTITY,
+		domainName);
 
 	if (request == NULL) {
 		return NULL;
 	}
 
-	request = mySprintf(".\r\n", request);
-	if (request == NULL) {
+	if (appendStringToRequest(request, "date", syncDate) < 0) {
+		RRPFreeRequest(request);
 		return NULL;
 	}
 
@@ -1139,7 +1053,7 @@ RRPRESPONSE* RRPTransferDomain (
 	char* domainName,
 	char* approve
 ) {
-	char* request = NULL;
+	RRPREQUEST* request = NULL;
 
 	/*
 	** Validate parameters
@@ -1149,21 +1063,16 @@ RRPRESPONSE* RRPTransferDomain (
 		return NULL;
 	}
 
-	request = mySprintf("Transfer\r\nEntityName:Domain\r\nDomainName:%s\r\n",
-		request, domainName);
+	request = createEntityRequest(RRP_TRANSFER_COMMAND, RRP_DOMAIN_ENTITY,
+		domainName);
 
 	if (request == NULL) {
 		return NULL;
 	}
 
-	if (approve != NULL) {
-		request = mySprintf("-Approve:%s\r\n.\r\n", request, approve);
-	}
-	else {
-		request = mySprintf(".\r\n", request);
-	}
-
-	if (request == NULL) {
+	if (approve != NULL &&
+		appendStringToRequest(request, "-Approve", approve) < 0) {
+		RRPFreeRequest(request);
 		return NULL;
 	}
 
@@ -1211,116 +1120,762 @@ int RRPFreeResponse (
 } /* RRPFreeResponse */
 
 /*
-** Parses an RRP response string and builds an RRPRESPONSE structure.
-** Returns a pointer to new RRPRESPONSE structure. Returns NULL and sets error
-** code if an error occurs.
 **
-** Note:        IMPORTANT: THE MEMORY THAT IS ALLOCATED FOR EACH RRPRESPONSE
-**              STRUCTURE THAT IS CONSTRUCTED BY EACH FUNCTION MUST BE
-**              RELEASED BY CALLING THE RRPFreeResponse() FUNCTION
-**              (SEE FUNCTION DESCRIPTION BELOW)
+** Function: RRPCloneResponse
+**
+** Description: Makes a copy of an RRPRESPONSE structure. The attributes
+**              of the copy share their storage with those of the
+**              original (see RRPCloneProperties()), so the copy is
+**              cheap, and the original and the copy can be used and
+**              freed independently, even by different threads
+**
+** Input: RRPRESPONSE* - pointer to an RRPRESPONSE structure to copy
+**
+** Output: none
+**
+** Return: RRPRESPONSE* - a pointer to an allocated RRPRESPONSE
+**                        structure. NULL is returned if an internal
+**                        error occurs.
+**
+** Note: THE MEMORY ALLOCATED FOR THE RRPRESPONSE STRUCTURE MUST BE
+**       RELEASED BY CALLING THE RRPFreeResponse() FUNCTION
+**
 */
-RRPRESPONSE* parseResponse (
-   char* string 
+RRPRESPONSE* RRPCloneResponse (
+	RRPRESPONSE* response
 ) {
-	RRPRESPONSE* response = NULL;
-	char* responseString = NULL;
-	char* crlfIndex = NULL;
-	char* spaceIndex = NULL;
-	char* line = NULL;
-	char c;
+	RRPRESPONSE* copy = NULL;
 
 	/*
 	** Validate parameter
 	*/
-	if (string == NULL) {
+	if (response == NULL) {
 		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
 		return NULL;
 	}
 
-	/*
-	** make a copy of 'string' parameter so we can manipulate it without
-	** altering the parameter
-	*/
-	responseString = strdup(string);
-
-	/*
-	** Start line pointer at beginning of string
-	*/
-	line = responseString;
-
-	/*
-	** Allocate memory for RRPRESONSE structure... check for
-	** memory allocation error
-	*/
-	response = createResponse();
-
-	if (NULL == response) {
+	copy = (RRPRESPONSE*) calloc(1, sizeof(RRPRESPONSE));
+	if (copy == NULL) {
 		RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
 		return NULL;
 	}
 
-	while ((crlfIndex = strstr(line, "\r\n")) != NULL) {
-		c = *crlfIndex;
-		*crlfIndex = '\0';
-
-		if (response->code == -1) {
-			spaceIndex = strstr(line, " ");
-			if (spaceIndex	== NULL) {
-				RRPSetInternalErrorCode(RRP_RESPONSE_FORMAT_ERROR);
-				break;
-			}
-
-			*spaceIndex = '\0';
-			response->code = atoi(line);
-			response->description = strdup(spaceIndex + 1);
-
-			if (response->description == NULL) {
-				RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
-				break;
-			}
-		}
-		else if (strchr(line, ':') != NULL) {
-			if (response->attributes == NULL) {
-				response->attributes = RRPCreateProperties();
-			}
-			RRPPutPropertyPair(response->attributes, line);
-		}
-		else if (strcmp(line, ".\r\n")) {
-   			free(responseString);
-	   		return response;
-		}
-		else {
-			RRPSetInternalErrorCode(RRP_RESPONSE_FORMAT_ERROR);
-			break;
-		}
+	copy->code = response->code;
 
-		line = crlfIndex + 2;
-		*crlfIndex = c;
+	if (response->description != NULL &&
+		(copy->description = strdup(response->description)) == NULL) {
+		free(copy);
+		RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
+		return NULL;
 	}
 
-	/*
-	** If we made it this far, then an error occured. Free up any allocated
-	** resources and return nULL
-	*/
-	if (response != NULL) {
-		free(response);
+	if (response->attributes != NULL &&
+		(copy->attributes = RRPCloneProperties(response->attributes)) ==
+		NULL) {
+		RRPFreeResponse(copy);
+		return NULL;
 	}
 
-	if (responseString != NULL) {
-		free(responseString);
-	}
-	
-	return NULL;
-}
+	return copy;
 
-RRPRESPONSE* createResponse () {
-	RRPRESPONSE* response = NULL;
-	response = (RRPRESPONSE*) calloc(1, sizeof(RRPRESPONSE));
+} /* RRPCloneResponse */
 
-	if (response == NULL) {
-		return NULL;
-	}
+/*
+**
+** Function: RRPGetExpirationDate
+**
+** Description: Returns the registration expiration date of a domain
+**              from the 'registration expiration date' attribute of a
+**              Status response (see RRPStatusDomain()). The date is
+**              interpreted as GMT
+**
+** Input: RRPRESPONSE* - pointer to an RRPRESPONSE structure
+**
+** Output: none
+**
+** Return: time_t - the expiration date. Returns (time_t) -1 if the
+**                  response has no expiration date or if an internal
+**                  error occurs
+**
+*/
+time_t RRPGetExpirationDate (
+	RRPRESPONSE* response
+) {
+	return RRPGetResponseDate(response, "registration expiration date");
+
+} /* RRPGetExpirationDate */
+
+/*
+**
+** Function: RRPGetResponseDate
+**
+** Description: Returns a date attribute of a response, such as the
+**              'updated date' or 'created date' of a Status response.
+**              The date is interpreted as GMT
+**
+** Input: RRPRESPONSE* - pointer to an RRPRESPONSE structure
+**        char* - the name of the attribute
+**
+** Output: none
+**
+** Return: time_t - the date. Returns (time_t) -1 if the response has no
+**                  such attribute or if an internal error occurs
+**
+*/
+time_t RRPGetResponseDate (
+	RRPRESPONSE* response,
+	char* attribute
+) {
+	RRPVECTOR* values = NULL;
+	char* value = NULL;
+
+	/*
+	** Validate parameters
+	*/
+	if (response == NULL || attribute == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return (time_t) -1;
+	}
+
+	if (response->attributes == NULL || (values = RRPGetProperty(
+		response->attributes, attribute)) == NULL) {
+		RRPSetInternalErrorCode(RRP_NO_SUCH_PROPERTY_ERROR);
+		return (time_t) -1;
+	}
+
+	if ((value = RRPGetVectorElementAt(values, 0)) == NULL) {
+		return (time_t) -1;
+	}
+
+	return parseDate(value);
+
+} /* RRPGetResponseDate */
+
+/*
+**
+** Function: RRPCreateRequest
+**
+** Description: Creates an RRP request string for a command. The request
+**              can then be extended with RRPAppendRequestAttribute() and
+**              sent with RRPExecuteRequest(). This is the entry point for
+**              callers that already know the length of their strings
+**              (e.g. the C++ API in rrpAPI.hpp): the strings are copied
+**              once into the request and are not scanned for their length
+**
+** Input: RRPCOMMAND - the RRP command
+**        RRPENTITY - the entity the command applies to. RRP_NO_ENTITY
+**                    for the Describe, Quit and Session commands
+**        const char* - the name of the domain or name server. Ignored
+**                      if the entity is RRP_NO_ENTITY. Need not be
+**                      NUL terminated
+**        size_t - the length of the name
+**
+** Output: none
+**
+** Return: RRPREQUEST* - a pointer to an allocated RRPREQUEST structure.
+**                       NULL is returned if an internal error occurs
+**
+** Note: THE MEMORY ALLOCATED FOR THE RRPREQUEST STRUCTURE MUST BE
+**       RELEASED BY CALLING THE RRPFreeRequest() FUNCTION
+**
+*/
+RRPREQUEST* RRPCreateRequest (
+	RRPCOMMAND command,
+	RRPENTITY entity,
+	const char* name,
+	size_t nameLength
+) {
+	RRPREQUEST* request = NULL;
+	const char* commandName = NULL;
+	const char* entityName = NULL;
+	size_t commandLength = 0;
+	size_t entityLength = 0;
+	size_t length = 0;
+	char* p = NULL;
+
+	/*
+	** Validate parameters
+	*/
+	if ((int) command < 0 || command > RRP_TRANSFER_COMMAND ||
+		(int) entity < 0 || entity > RRP_NAMESERVER_ENTITY ||
+		(entity != RRP_NO_ENTITY && name == NULL)) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return NULL;
+	}
+
+	commandName = rrpCommandNames[command];
+	commandLength = strlen(commandName);
+	length = commandLength + 2;
+
+	if (entity != RRP_NO_ENTITY) {
+		entityName = rrpEntityNames[entity];
+		entityLength = strlen(entityName);
+		length += entityLength + nameLength + 2;
+	}
+
+	request = (RRPREQUEST*) calloc(1, sizeof(RRPREQUEST));
+	if (request == NULL) {
+		RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
+		return NULL;
+	}
+
+	/*
+	** Leave room for a few attributes so that most commands are built
+	** without growing the buffer
+	*/
+	request->capacity = length + 3 + 1 + 128;
+	request->text = (char*) malloc(request->capacity);
+	if (request->text == NULL) {
+		free(request);
+		RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
+		return NULL;
+	}
+
+	request->command = command;
+	request->entity = entity;
+
+	p = request->text;
+	memcpy(p, commandName, commandLength);
+	p += commandLength;
+	*p++ = '\r';
+	*p++ = '\n';
+
+	if (entity != RRP_NO_ENTITY) {
+		memcpy(p, entityName, entityLength);
+		p += entityLength;
+		request->nameOffset = p - request->text;
+		request->nameLength = nameLength;
+		memcpy(p, name, nameLength);
+		p += nameLength;
+		*p++ = '\r';
+		*p++ = '\n';
+	}
+
+	memcpy(p, ".\r\n", 4);
+	request->length = length + 3;
+
+	return request;
+
+} /* RRPCreateRequest */
+
+/*
+**
+** Function: RRPAppendRequestAttribute
+**
+** Description: Appends a "key:value" line to an RRP request string
+**
+** Input: RRPREQUEST* - a pointer to an RRPREQUEST structure
+**        const char* - the attribute key (e.g. "NameServer"). Need not
+**                      be NUL terminated
+**        size_t - the length of the key
+**        const char* - the attribute value. Need not be NUL terminated
+**        size_t - the length of the value
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+int RRPAppendRequestAttribute (
+	RRPREQUEST* request,
+	const char* key,
+	size_t keyLength,
+	const char* value,
+	size_t valueLength
+) {
+	/*
+	** Validate parameters
+	*/
+	if (request == NULL || key == NULL || value == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	return appendLineToRequest(request, key, keyLength, value, valueLength,
+		NULL, 0);
+
+} /* RRPAppendRequestAttribute */
+
+/*
+**
+** Function: RRPExecuteRequest
+**
+** Description: Sends an RRP request string to the RRP server, then reads
+**              and parses the response. The request is not released and
+**              can be executed again. With a process governor (see
+**              rrpGovernor.h), the request waits until the governor
+**              allows it
+**
+** Input: RRPREQUEST* - a pointer to an RRPREQUEST structure
+**
+** Output: none
+**
+** Return: RRPRESPONSE* - a pointer to an RRPRESPONSE structure containing
+**                        the components of the RRP response returned from
+**                        the server. NULL is return is an internal error
+**                        occurs.
+**
+** Note: THE MEMORY ALLOCATED FOR THE RRPRESPONSE STRUCTURE MUST BE
+**       RELEASED BY CALLING THE RRPFreeResponse() FUNCTION
+**
+*/
+RRPRESPONSE* RRPExecuteRequest (
+	RRPREQUEST* request
+) {
+	RRPRESPONSE* response = NULL;
+	char* responseString = NULL;
+
+	/*
+	** Validate parameter
+	*/
+	if (request == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return NULL;
+	}
+
+	if (RRPGetProcessGovernor() != NULL &&
+		RRPWaitGovernor(RRPGetProcessGovernor(), request->command) < 0) {
+		return NULL;
+	}
+
+	if (RRPSendRequestData(request->text, request->length) < 0) {
+		return NULL;
+	}
+
+	responseString = RRPReadResponse();
+	if (responseString == NULL) {
+		return NULL;
+	}
+
+	response = parseResponse(responseString);
+
+	free(responseString);
+
+	return response;
+
+} /* RRPExecuteRequest */
+
+/*
+**
+** Function: RRPFreeRequest
+**
+** Description: Frees all memory allocated for an RRPREQUEST structure
+**
+** Input: RRPREQUEST* - pointer to an RRPREQUEST structure to free
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+int RRPFreeRequest (
+	RRPREQUEST* request
+) {
+	/*
+	** Validate parameter
+	*/
+	if (request == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	free(request->text);
+	free(request);
+
+	return 0;
+
+} /* RRPFreeRequest */
+
+/*
+**
+** Function: RRPParseResponse
+**
+** Description: Breaks up an RRP response string (as returned by
+**              RRPReadResponse() or RRPNextConnectionResponse()) into
+**              its components
+**
+** Input: char* - the RRP response string
+**
+** Output: none
+**
+** Return: RRPRESPONSE* - a pointer to an RRPRESPONSE structure containing
+**                        the components of the RRP response. NULL is
+**                        returned if an internal error occurs.
+**
+** Note: THE MEMORY ALLOCATED FOR THE RRPRESPONSE STRUCTURE MUST BE
+**       RELEASED BY CALLING THE RRPFreeResponse() FUNCTION
+**
+*/
+RRPRESPONSE* RRPParseResponse (
+	char* string
+) {
+	return parseResponse(string);
+
+} /* RRPParseResponse */
+
+/*
+**
+** Function: RRPParseRequest
+**
+** Description: Builds an RRPREQUEST structure from an RRP request string
+**              received from elsewhere, e.g. by a session broker (see
+**              rrpBroker.c). The command, the entity and the entity
+**              name are found in the string, which is copied as is
+**
+** Input: const char* - the RRP request string, ending with ".\r\n".
+**                      Need not be NUL terminated
+**        size_t - the length of the string
+**
+** Output: none
+**
+** Return: RRPREQUEST* - a pointer to an allocated RRPREQUEST structure.
+**                       NULL is returned if the string is not an RRP
+**                       request (RRP_BAD_PARAM_ERROR) or if an internal
+**                       error occurs
+**
+** Note: THE MEMORY ALLOCATED FOR THE RRPREQUEST STRUCTURE MUST BE
+**       RELEASED BY CALLING THE RRPFreeRequest() FUNCTION
+**
+*/
+RRPREQUEST* RRPParseRequest (
+	const char* string,
+	size_t length
+) {
+	RRPREQUEST* request = NULL;
+	const char* value = NULL;
+	size_t valueLength = 0;
+	size_t commandLength = 0;
+	int command = 0;
+
+	/*
+	** Validate parameters
+	*/
+	if (string == NULL || length < 5 ||
+		memcmp(string + length - 3, ".\r\n", 3) != 0 ||
+		findRequestLine(string, length, NULL, &commandLength) == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return NULL;
+	}
+
+	for (command = 0; command <= RRP_TRANSFER_COMMAND; command++) {
+		if (strlen(rrpCommandNames[command]) == commandLength &&
+			strncasecmp(string, rrpCommandNames[command],
+			commandLength) == 0) {
+			break;
+		}
+	}
+
+	if (command > RRP_TRANSFER_COMMAND) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return NULL;
+	}
+
+	request = (RRPREQUEST*) calloc(1, sizeof(RRPREQUEST));
+	if (request == NULL) {
+		RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
+		return NULL;
+	}
+
+	request->capacity = length + 1;
+	request->text = (char*) malloc(request->capacity);
+	if (request->text == NULL) {
+		free(request);
+		RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
+		return NULL;
+	}
+
+	memcpy(request->text, string, length);
+	request->text[length] = '\0';
+	request->length = length;
+	request->command = (RRPCOMMAND) command;
+	request->entity = RRP_NO_ENTITY;
+
+	/*
+	** The name is on the "DomainName:" or "NameServer:" line that
+	** follows the entity; a domain may have "NameServer:" lines too
+	*/
+	value = findRequestLine(request->text, length, "EntityName",
+		&valueLength);
+	if (value != NULL && valueLength == 6 &&
+		strncasecmp(value, "Domain", 6) == 0) {
+		request->entity = RRP_DOMAIN_ENTITY;
+		value = findRequestLine(request->text, length, "DomainName",
+			&valueLength);
+	}
+	else if (value != NULL && valueLength == 10 &&
+		strncasecmp(value, "NameServer", 10) == 0) {
+		request->entity = RRP_NAMESERVER_ENTITY;
+		value = findRequestLine(request->text, length, "NameServer",
+			&valueLength);
+	}
+	else {
+		value = NULL;
+	}
+
+	if (value != NULL) {
+		request->nameOffset = value - request->text;
+		request->nameLength = valueLength;
+	}
+
+	return request;
+
+} /* RRPParseRequest */
+
+/*
+**
+** Function: RRPFormatResponse
+**
+** Description: Writes an RRPRESPONSE structure back as an RRP response
+**              string, the reverse of RRPParseResponse(). The attributes
+**              are written in the order their keys were first seen,
+**              each value of a key on a line of its own
+**
+** Input: RRPRESPONSE* - pointer to an RRPRESPONSE structure
+**
+** Output: size_t* - the length of the string. May be NULL
+**
+** Return: char* - the response string, ending with ".\r\n". NULL is
+**                 returned if an internal error occurs.
+**
+** Note: THE STRING MUST BE RELEASED BY CALLING free()
+**
+*/
+char* RRPFormatResponse (
+	RRPRESPONSE* response,
+	size_t* length
+) {
+	RRPVECTOR* values = NULL;
+	char* string = NULL;
+	char* key = NULL;
+	char* value = NULL;
+	char* p = NULL;
+	size_t size = 0;
+	size_t keyLength = 0;
+	size_t valueLength = 0;
+	int pass = 0;
+	int count = 0;
+	int i = 0;
+
+	/*
+	** Validate parameter
+	*/
+	if (response == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return NULL;
+	}
+
+	/*
+	** Measure the string, then write it
+	*/
+	for (pass = 0; pass < 2; pass++) {
+		if (pass == 1) {
+			string = (char*) malloc(size + 1);
+			if (string == NULL) {
+				RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
+				return NULL;
+			}
+			p = string + sprintf(string, "%d %s\r\n", response->code,
+				response->description != NULL ?
+				response->description : "");
+		}
+		else {
+			size = 12 + 1 + 2 + 3 + (response->description != NULL ?
+				strlen(response->description) : 0);
+		}
+
+		if (response->attributes == NULL) {
+			continue;
+		}
+
+		RRPResetPropertyPointer(response->attributes);
+		while ((key = RRPGetNextPropertyKey(response->attributes)) != NULL) {
+			values = RRPGetProperty(response->attributes, key);
+			count = RRPGetVectorSize(values);
+			keyLength = strlen(key);
+
+			for (i = 0; i < count; i++) {
+				value = RRPGetVectorElementAt(values, i);
+				valueLength = strlen(value);
+
+				if (pass == 0) {
+					size += keyLength + 1 + valueLength + 2;
+					continue;
+				}
+
+				memcpy(p, key, keyLength);
+				p += keyLength;
+				*p++ = ':';
+				memcpy(p, value, valueLength);
+				p += valueLength;
+				*p++ = '\r';
+				*p++ = '\n';
+			}
+		}
+	}
+
+	memcpy(p, ".\r\n", 4);
+	p += 3;
+
+	if (length != NULL) {
+		*length = p - string;
+	}
+
+	return string;
+
+} /* RRPFormatResponse */
+
+/*
+** Parses an RRP response string and builds an RRPRESPONSE structure.
+** Returns a pointer to new RRPRESPONSE structure. Returns NULL and sets error
+** code if an error occurs.
+**
+** Note:        IMPORTANT: THE MEMORY THAT IS ALLOCATED FOR EACH RRPRESPONSE
+**              STRUCTURE THAT IS CONSTRUCTED BY EACH FUNCTION MUST BE
+**              RELEASED BY CALLING THE RRPFreeResponse() FUNCTION
+**              (SEE FUNCTION DESCRIPTION BELOW)
+*/
+RRPRESPONSE* parseResponse (
+   char* string 
+) {
+	RRPRESPONSE* response = NULL;
+	char* responseString = NULL;
+	char* crlfIndex = NULL;
+	char* spaceIndex = NULL;
+	char* line = NULL;
+	char c;
+
+	/*
+	** Validate parameter
+	*/
+	if (string == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return NULL;
+	}
+
+	/*
+	** make a copy of 'string' parameter so we can manipulate it without
+	** altering the parameter
+	*/
+	responseString = strdup(string);
+	if (responseString == NULL) {
+		RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
+		return NULL;
+	}
+
+	/*
+	** Start line pointer at beginning of string
+	*/
+	line = responseString;
+
+	/*
+	** Allocate memory for RRPRESONSE structure... check for
+	** memory allocation error
+	*/
+	response = createResponse();
+
+	if (NULL == response) {
+		free(responseString);
+		RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
+		return NULL;
+	}
+
+	while ((crlfIndex = strstr(line, "\r\n")) != NULL) {
+		c = *crlfIndex;
+		*crlfIndex = '\0';
+
+		if (response->code == -1) {
+			spaceIndex = strstr(line, " ");
+			if (spaceIndex	== NULL) {
+				RRPSetInternalErrorCode(RRP_RESPONSE_FORMAT_ERROR);
+				break;
+			}
+
+			*spaceIndex = '\0';
+			response->code = atoi(line);
+			response->description = strdup(spaceIndex + 1);
+
+			if (response->description == NULL) {
+				RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
+				break;
+			}
+		}
+		else if (strchr(line, ':') != NULL) {
+			if (response->attributes == NULL) {
+				response->attributes = RRPCreateProperties();
+			}
+			RRPPutPropertyPair(response->attributes, line);
+		}
+		else if (strcmp(line, ".\r\n")) {
+   			free(responseString);
+	   		return response;
+		}
+		else {
+			RRPSetInternalErrorCode(RRP_RESPONSE_FORMAT_ERROR);
+			break;
+		}
+
+		line = crlfIndex + 2;
+		*crlfIndex = c;
+	}
+
+	/*
+	** If we made it this far, then an error occured. Free up any allocated
+	** resources and return nULL
+	*/
+	if (response != NULL) {
+		RRPFreeResponse(response);
+	}
+
+	if (responseString != NULL) {
+		free(responseString);
+	}
+	
+	return NULL;
+}
+
+/*
+** Converts an RRP date ("yyyy-mm-dd hh:mm:ss.f", GMT) to a time_t.
+** Returns (time_t) -1 and sets error code if the date can not be parsed.
+*/
+time_t
+parseDate (
+	char* date
+) {
+	int year = 0, month = 0, day = 0;
+	int hour = 0, minute = 0, second = 0;
+	long days = 0;
+
+	if (sscanf(date, "%d-%d-%d %d:%d:%d", &year, &month, &day,
+		&hour, &minute, &second) < 3 || month < 1 || month > 12 ||
+		day < 1 || day > 31) {
+		RRPSetInternalErrorCode(RRP_RESPONSE_FORMAT_ERROR);
+		return (time_t) -1;
+	}
+
+	/*
+	** Count the days since 1970-01-01 in the proleptic Gregorian
+	** calendar. mktime() can not be used since it works in local time
+	*/
+	if (month <= 2) {
+		year--;
+		month += 12;
+	}
+	days = 365L * year + year / 4 - year / 100 + year / 400 +
+		(153 * (month - 3) + 2) / 5 + day - 719469L;
+
+	return (time_t) days * 86400 + hour * 3600 + minute * 60 + second;
+
+} /* parseDate */
+
+RRPRESPONSE* createResponse () {
+	RRPRESPONSE* response = NULL;
+	response = (RRPRESPONSE*) calloc(1, sizeof(RRPRESPONSE));
+
+	if (response == NULL) {
+		return NULL;
+	}
 
 	response->code = -1;
 	response->description = NULL;
@@ -1331,143 +1886,118 @@ RRPRESPONSE* createResponse () {
 } /* createResponse */
 
 
-char*
-appendIntToRequest (
-	char* orginalRequest,
-	char* key,
-	int   newInteger
+
+
+
+
+/*
+** Returns the request for a command that applies to a domain or a
+** name server. Returns NULL and sets error code if an error occurs.
+*/
+static RRPREQUEST*
+createEntityRequest (
+	RRPCOMMAND command,
+	RRPENTITY entity,
+	char* name
 ) {
-   char* newRequest = NULL;
-	char newString[MAX_SIZE];
-   int  originalRequestSize, newStringSize;
-	
-	sprintf( newString, "%s%d\r\n", key, newInteger );
-	newStringSize = strlen(newString);
-
-   if (orginalRequest == NULL) {
-      originalRequestSize = 0;
-      newRequest = (char*) calloc(1, newStringSize + originalRequestSize + 1);
-   }
-   else {
-      originalRequestSize = strlen(orginalRequest);
-      newRequest = (char*) realloc(orginalRequest, newStringSize + originalRequestSize + 1);
-   }
-
-   if (newRequest == NULL) {
-      RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
-      return NULL;
-   }
-   memcpy(newRequest + originalRequestSize, newString, newStringSize + 1);
-   return newRequest;
-}
+	return RRPCreateRequest(command, entity, name, strlen(name));
 
+} /* createEntityRequest */
 
 
 
 
 
-char*
-appendStringToRequest (
-	char* orginalRequest,
-	char* newString
+
+
+/*
+** Makes room for 'size' more characters in a request string. Returns 0
+** if successful. Returns -1 and sets error code if an error occurs.
+*/
+static int
+reserveRequest (
+	RRPREQUEST* request,
+	size_t size
 ) {
-	char* newRequest = NULL;
-	size_t originalRequestSize;
-	size_t newStringSize;
+	size_t capacity = 0;
+	char* text = NULL;
 
-	if (NULL == newString) {
-		return NULL;
-	}
-	else {
-		newStringSize = strlen(newString);
+	if (request->length + size + 1 <= request->capacity) {
+		return 0;
 	}
 
-	if (orginalRequest == NULL) {
-		originalRequestSize = 0;
-		newRequest = (char*) calloc(1, newStringSize + originalRequestSize + 1);
-	}
-	else {
-		originalRequestSize = strlen(orginalRequest);
-		newRequest = (char*) realloc(orginalRequest, newStringSize +
-			originalRequestSize + 1);
+	capacity = request->capacity * 2;
+	if (capacity < request->length + size + 1) {
+		capacity = request->length + size + 1;
 	}
 
-	if (newRequest == NULL) {
+	text = (char*) realloc(request->text, capacity);
+	if (text == NULL) {
 		RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
-		return NULL;
+		return -1;
 	}
-	memcpy(newRequest + originalRequestSize, newString, newStringSize + 1);
-	return newRequest;
 
-} /* appendStringToRequest */
+	request->text = text;
+	request->capacity = capacity;
+
+	return 0;
+
+} /* reserveRequest */
+
 
 
 
 
-char*
-mySprintf (
-	char* format,
-	char* originalString,
-	...
+
+
+/*
+** Appends a "key:value" line to a request string, or a "key:value=newValue"
+** line if 'newValue' is not NULL. The line is written over the ".\r\n"
+** that ends the request, which is then written again after it. Returns 0
+** if successful. Returns -1 and sets error code if an error occurs.
+*/
+static int
+appendLineToRequest (
+	RRPREQUEST* request,
+	const char* key,
+	size_t keyLength,
+	const char* value,
+	size_t valueLength,
+	const char* newValue,
+	size_t newValueLength
 ) {
-	va_list argumentList;
-	char* stringArgument;
-	RRPPROPERTIES* propertiesArgument;
-	char* newString = NULL;
-	char modifier[3];
-	char string[64];
-	int stringIndex = 0;
-
-	modifier[0] = '\0';
-	modifier[1] = '\0';
-	modifier[2] = '\0';
-	string[0] = '\0';
-
-
-	va_start(argumentList, originalString);
-
-	newString = originalString;
-
-	while (*format != '\0') {
-		modifier[0] = modifier[1];
-		modifier[1] = *format;
-
-		if (strcmp(modifier, "%s") == 0) {
-			stringArgument = va_arg(argumentList, char*);
-			if (string[0] != '\0') {
-				newString = appendStringToRequest(newString, string);
-				if (newString == NULL) {
-					return NULL;
-				}
-			}
-			stringIndex = 0;
-			string[0] = '\0';
+	size_t lineLength = 0;
+	char* p = NULL;
 
-			newString = appendStringToRequest(newString, stringArgument);
-			if (newString == NULL) {
-				return NULL;
-			}
-		}
-		else if (*format != '%') {
-			string[stringIndex++] = *format;
-			string[stringIndex] = '\0';
-		}
+	lineLength = keyLength + 1 + valueLength + 2;
+	if (newValue != NULL) {
+		lineLength += 1 + newValueLength;
+	}
 
-		format++;
+	if (reserveRequest(request, lineLength) < 0) {
+		return -1;
 	}
 
+	p = request->text + request->length - 3;
 
-	if (string[0] != '\0') {
-		newString = appendStringToRequest(newString, string);
-		if (newString == NULL) {
-			return NULL;
-		}
+	memcpy(p, key, keyLength);
+	p += keyLength;
+	*p++ = ':';
+	memcpy(p, value, valueLength);
+	p += valueLength;
+
+	if (newValue != NULL) {
+		*p++ = '=';
+		memcpy(p, newValue, newValueLength);
+		p += newValueLength;
 	}
 
-	va_end(argumentList); 
-	return newString;
+	memcpy(p, "\r\n.\r\n", 6);
+	request->length += lineLength;
+
+	return 0;
 
-} /* mySprintf */
+} /* appendLineToRequest */
 
 
 
@@ -1475,54 +2005,71 @@ mySprintf (
 
 
 
-char*
-appendPropertiesToRequest (
-	char* originalRequest,
-	char* rrpAttributeKey,
-	RRPPROPERTIES* properties
+static int
+appendStringToRequest (
+	RRPREQUEST* request,
+	const char* key,
+	const char* value
 ) {
-	RRPPROPERTIES* clone = NULL;
-	RRPVECTOR* vector = NULL;
-	char* newRequest = NULL;
-	int vectorSize = 0;
-	char* value = NULL;
-	char* key = NULL;
-	int i = 0;
+	return appendLineToRequest(request, key, strlen(key), value,
+		strlen(value), NULL, 0);
 
-	if ( (clone = RRPCloneProperties(properties)) == NULL) {
-		return NULL;
-	}
-	if (RRPResetPropertyPointer(clone) == -1) {
-		return NULL;
-	}
+} /* appendStringToRequest */
 
-	newRequest = originalRequest;
 
-	while ( (key = RRPGetNextPropertyKey(clone)) != NULL) {
-		vector = RRPGetProperty(clone, key);
-		if (vector == NULL) {
-			return NULL;
-		}
 
-		vectorSize = RRPGetVectorSize(vector);
 
-		for (i=0; i < vectorSize; i++) {
-			value = RRPGetVectorElementAt(vector, i);
-			if (value == NULL) {
-				return NULL;
-			}
-			newRequest = mySprintf("%s:%s=%s\r\n", newRequest, rrpAttributeKey,
-				key, value);
-			if (newRequest == NULL) {
-				RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
-				return NULL;
+
+
+
+static int
+appendIntToRequest (
+	RRPREQUEST* request,
+	const char* key,
+	int value
+) {
+	char string[16];
+
+	sprintf(string, "%d", value);
+
+	return appendLineToRequest(request, key, strlen(key), string,
+		strlen(string), NULL, 0);
+
+} /* appendIntToRequest */
+
+
+
+
+
+
+
+static int
+appendPropertiesToRequest (
+	RRPREQUEST* request,
+	const char* key,
+	RRPPROPERTIES* properties
+) {
+	RRPPROPERTY_NODE* node = NULL;
+	RRPELEMENT_NODE* element = NULL;
+	size_t keyLength = strlen(key);
+
+	/*
+	** Walk the list of properties directly rather than through
+	** RRPGetNextPropertyKey() so that the caller's current property
+	** pointer is left alone
+	*/
+	for (node = properties->head; node != NULL; node = node->next) {
+		for (element = node->values->head; element != NULL;
+			element = element->next) {
+			if (appendLineToRequest(request, key, keyLength, node->key,
+				strlen(node->key), element->value,
+				strlen(element->value)) < 0) {
+				return -1;
 			}
 		}
 	}
 
-	RRPFreeProperties(clone);
-
-	return newRequest;
+	return 0;
 
 } /* appendPropertiesToRequest */
 
@@ -1532,67 +2079,45 @@ appendPropertiesToRequest (
 
 
 
-char*
+static int
 appendVectorToRequest (
-	char* originalRequest,
-	char* key,
+	RRPREQUEST* request,
+	const char* key,
 	RRPVECTOR* vector
 ) {
-	int vectorSize = 0;
-	char* newRequest = NULL;
-	char* value = NULL;
-	int i = 0;
-
-	vectorSize = RRPGetVectorSize(vector);
+	RRPELEMENT_NODE* element = NULL;
+	size_t keyLength = strlen(key);
 
-	newRequest = originalRequest;
-
-	for (i=0; i < vectorSize; i++) {
-		value = RRPGetVectorElementAt(vector, i);
-		if (value == NULL) {
-			return NULL;
-		}
-		newRequest = mySprintf("%s:%s\r\n", newRequest, key, value);
-		if (newRequest == NULL) {
-			RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
-			return NULL;
+	for (element = vector->head; element != NULL; element = element->next) {
+		if (appendLineToRequest(request, key, keyLength, element->value,
+			strlen(element->value), NULL, 0) < 0) {
+			return -1;
 		}
 	}
 
-	return newRequest;
+	return 0;
 
 } /* appendVectorToRequest */
 
 
 
-char*
+static int
 appendDeletedVectorToRequest (
-	char* originalRequest,
-	char* key,
+	RRPREQUEST* request,
+	const char* key,
 	RRPVECTOR* vector
 ) {
-	int vectorSize = 0;
-	char* newRequest = NULL;
-	char* value = NULL;
-	int i = 0;
-
-	vectorSize = RRPGetVectorSize(vector);
+	RRPELEMENT_NODE* element = NULL;
+	size_t keyLength = strlen(key);
 
-	newRequest = originalRequest;
-
-	for (i=0; i < vectorSize; i++) {
-		value = RRPGetVectorElementAt(vector, i);
-		if (value == NULL) {
-			return NULL;
-		}
-		newRequest = mySprintf("%s:%s=\r\n", newRequest, key, value);
-		if (newRequest == NULL) {
-			RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
-			return NULL;
+	for (element = vector->head; element != NULL; element = element->next) {
+		if (appendLineToRequest(request, key, keyLength, element->value,
+			strlen(element->value), "", 0) < 0) {
+			return -1;
 		}
 	}
 
-	return newRequest;
+	return 0;
 
 } /* appendDeletedVectorToRequest */
 
@@ -1602,36 +2127,76 @@ appendDeletedVectorToRequest (
 
 
 
-RRPRESPONSE*
+/*
+** Executes a request built by one of the command functions above and
+** releases it. Returns NULL if 'request' is NULL (the error code has
+** already been set by the function that failed to build it).
+*/
+static RRPRESPONSE*
 processRequest (
-   char* request
+	RRPREQUEST* request
 ) {
-	char* responseString = NULL;
 	RRPRESPONSE* response = NULL;
 
 	if (request == NULL) {
-		RRPSetInternalErrorCode(RRP_UNKNOWN_ERROR);
 		return NULL;
 	}
 
-   if (RRPSendRequest(request) < 0) {
-		free(request);
-		return NULL;
-   }
+	response = RRPExecuteRequest(request);
 
-	responseString = RRPReadResponse();
+	RRPFreeRequest(request);
 
+	return response;
 
-	if (responseString == NULL) {
-		free(request);
-		return NULL;
-	}
+} /* processRequest */
 
-	response = parseResponse(responseString);
 
-	free(responseString);
-	free(request);
 
-	return response;
 
-} /* processRequest */
+
+
+
+/*
+** Finds the line of a request string whose key is 'key', ignoring case,
+** or its first line if 'key' is NULL. Returns the value on that line (the
+** whole line if 'key' is NULL) and stores its length in 'length'. Returns
+** NULL if there is no such line.
+*/
+static const char*
+findRequestLine (
+	const char* text,
+	size_t length,
+	const char* key,
+	size_t* valueLength
+) {
+	const char* line = text;
+	const char* end = text + length;
+	const char* crlf = NULL;
+	size_t keyLength = key != NULL ? strlen(key) : 0;
+
+	while (line < end) {
+		crlf = line;
+		while (crlf + 1 < end && (crlf[0] != '\r' || crlf[1] != '\n')) {
+			crlf++;
+		}
+		if (crlf + 1 >= end) {
+			return NULL;
+		}
+
+		if (key == NULL) {
+			*valueLength = crlf - line;
+			return line;
+		}
+
+		if ((size_t) (crlf - line) > keyLength && line[keyLength] == ':' &&
+			strncasecmp(line, key, keyLength) == 0) {
+			*valueLength = crlf - line - keyLength - 1;
+			return line + keyLength + 1;
+		}
+
+		line = crlf + 2;
+	}
+
+	return NULL;
+
+} /* findRequestLine */
@@ -0,0 +1,996 @@
+/* ===========================================================================
+ * Copyright (C) 2000 VeriSign, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * VeriSign Global Registry Service
+ * 21345 Ridgetop Circle
+ * Dulles, VA 20166
+ * ===========================================================================
+ * The RRP, APIs and Software are provided "as-is" and without any warranty
+ * of any kind.  NSI EXPRESSLY DISCLAIMS ALL WARRANTIES AND/OR CONDITIONS,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * AND CONDITIONS OF MERCHANTABILITY OR SATISFACTORY QUALITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE AND NONINFRINGEMENT OF THIRD PARTY RIGHTS.  NSI DOES
+ * NOT WARRANT THAT THE FUNCTIONS CONTAINED IN THE RRP, APIs OR SOFTWARE
+ * WILL MEET REGISTRAR'S REQUIREMENTS, OR THAT THE OPERATION OF THE RRP,
+ * APIs OR SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE,OR THAT DEFECTS IN
+ * THE RRP, APIs OR SOFTWARE WILL BE CORRECTED.  FURTHERMORE, NSI DOES NOT
+ * WARRANT NOR MAKE ANY REPRESENTATIONS REGARDING THE USE OR THE RESULTS OF
+ * THE RRP, APIs, SOFTWARE OR RELATED DOCUMENTATION IN TERMS OF THEIR
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR OTHERWISE.  SHOULD THE RRP, APIs
+ * OR SOFTWARE PROVE DEFECTIVE, REGISTRAR ASSUMES THE ENTIRE COST OF ALL
+ * NECESSARY SERVICING, REPAIR OR CORRECTION.
+ * ======================================================================== */
+
+/*
+**
+** Module Name: rrpBroker.c
+**
+** Version: 2.1 for RRP version 2.1.0
+**
+** Date: Oct. 19th, 2026
+**
+** Description: rrpBroker holds the few sessions a registrar may have
+**              open at once (MaxSessions in the server's rrps.cfg) and
+**              lets any number of local processes share them. It logs
+**              in once, then accepts clients on a Unix domain socket
+**              and relays their commands over its sessions (see
+**              rrpSession.h), pipelined, so a client neither pays for a
+**              login nor counts against the registry's limit.
+**
+**              Clients speak RRP to the broker: a session opened with
+**              RRPOpenBrokerSession() does so, and needs no credentials.
+**              The broker answers Session commands itself, without
+**              checking them, and closes the connection after a Quit;
+**              the permissions of the socket decide who may use the
+**              registrar's sessions. Each other command goes to the
+**              session with the fewest commands outstanding, and the
+**              responses are returned to each client in the order it
+**              sent its commands. A client has at most a given number
+**              of commands in flight; the broker stops reading from it
+**              until some of them are answered.
+**
+**              The sessions log in again when their connections drop
+**              (see RRPSetSessionReconnect()). A command that may have
+**              been executed but whose outcome could not be settled is
+**              not answered: the broker closes the connection of its
+**              client instead, after the responses to the commands
+**              sent before it, so the client learns that the outcome
+**              is unknown. A command that was never sent, or that the
+**              server refused with 420 before closing the session, is
+**              answered with 421 and may be sent again: the session,
+**              not the client's connection, is what the server closed.
+**
+**              SIGINT and SIGTERM stop the broker once the commands in
+**              flight are answered. The exit status is 0 unless the
+**              broker could not start, or lost all of its sessions.
+**
+** Usage:       rrpBroker -h host[,host...] [-p port] -u id [-w password]
+**                  -l socket [-s sessions] [-n window] [-c commands]
+**                  [-j journal] [-r rate] [-v]
+**
+**              The password is taken from the RRP_PASSWORD environment
+**              variable if -w is not given. The servers are given as
+**              for rrpRenew. With -j every command that changes the
+**              registry is recorded in a journal (see rrpJournal.h).
+**              With -v clients are logged on the standard error as
+**              they come and go.
+**
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <unistd.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <time.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include "rrpAPI.h"
+#include "rrpSession.h"
+#include "rrpGovernor.h"
+#include "rrpRetry.h"
+#include "rrpEndpoint.h"
+#include "rrpJournal.h"
+#include "rrpInternalError.h"
+#include "rrpTool.h"
+
+/*
+** Longest request accepted from a client, size of each read, and
+** connections waiting to be accepted
+*/
+#define BROKER_MAX_REQUEST 65536
+#define BROKER_READ_SIZE 4096
+#define BROKER_BACKLOG 64
+
+/*
+** Attempts to open a connection again before a session is given up: a
+** broker rides through long outages
+*/
+#define BROKER_RECONNECT_ATTEMPTS 1000
+
+/*
+** Responses of the broker itself
+*/
+#define BROKER_OK "200 Command completed successfully\r\n.\r\n"
+#define BROKER_BYE "220 Command completed successfully. " \
+	"Server closing connection\r\n.\r\n"
+#define BROKER_RETRY "421 Command failed due to server error. " \
+	"Client should try again\r\n.\r\n"
+#define BROKER_INVALID "500 Invalid command name\r\n.\r\n"
+
+typedef struct _BROKERCLIENT  BROKERCLIENT;
+typedef struct _BROKERSLOT  BROKERSLOT;
+
+/*
+** A command of a client, in the order it was received. Its response
+** waits there until the commands before it have been answered
+*/
+struct _BROKERSLOT {
+	BROKERCLIENT* client;
+	char* response;             /* NULL while the command is in flight */
+	size_t length;
+	int lost;                   /* its outcome is unknown */
+	int last;                   /* the connection closes after it */
+	BROKERSLOT* next;
+};
+
+/*
+** A local client. It is freed once its connection is closed and none of
+** its commands is in flight
+*/
+struct _BROKERCLIENT {
+	int socket;                 /* -1 once closed */
+	char* input;
+	size_t inputLength;
+	size_t inputCapacity;
+	char* output;
+	size_t outputStart;
+	size_t outputLength;
+	size_t outputCapacity;
+	BROKERSLOT* head;           /* oldest command not answered yet */
+	BROKERSLOT* tail;
+	int inFlight;               /* commands relayed to a session */
+	int ended;                  /* sent Quit: nothing more is read */
+	int closing;                /* closed once its output is written */
+	BROKERCLIENT* next;
+};
+
+static BROKERCLIENT* clients = NULL;
+static int clientCount = 0;
+static int clientLimit = 0;
+static int verbose = 0;
+static char greeting[128];
+static unsigned long accepted = 0;
+static unsigned long relayed = 0;
+static unsigned long unknown = 0;
+
+static void usage (char*);
+static int openListener (char*);
+static void acceptClients (int);
+static void readClient (BROKERCLIENT*);
+static void relayClient (BROKERCLIENT*, RRPSESSIONPOOL*);
+static size_t findRequestEnd (const char*, size_t);
+static BROKERSLOT* addSlot (BROKERCLIENT*);
+static void answerSlot (BROKERSLOT*, const char*);
+static void completeRelay (RRPREQUEST*, RRPRESPONSE*, void*);
+static void deliverClient (BROKERCLIENT*);
+static void writeClient (BROKERCLIENT*);
+static void closeClient (BROKERCLIENT*);
+static void reapClients (void);
+
+int
+main (
+	int argc,
+	char** argv
+) {
+	RRPSESSIONPOOL* pool = NULL;
+	RRPSESSION* session = NULL;
+	RRPGOVERNOR* governor = NULL;
+	RRPRETRYPOLICY* reconnect = NULL;
+	RRPENDPOINTS* endpoints = NULL;
+	RRPJOURNAL* journal = NULL;
+	BROKERCLIENT* client = NULL;
+	BROKERCLIENT** polled = NULL;
+	struct pollfd* descriptors = NULL;
+	char* host = NULL;
+	char* registrarID = NULL;
+	char* registrarPassword = getenv("RRP_PASSWORD");
+	char* socketName = NULL;
+	char* journalName = NULL;
+	unsigned short int port = 648;
+	int listener = -1;
+	int sessions = 3;
+	int window = RRP_DEFAULT_SESSION_WINDOW;
+	int capacity = 0;
+	int count = 0;
+	int timeout = 0;
+	int wait = 0;
+	int writing = 0;
+	int alive = 0;
+	int status = 0;
+	int option = 0;
+	int result = 0;
+	int i = 0;
+	double rate = 0;
+	time_t now = 0;
+
+	while ((option = getopt(argc, argv, "h:p:u:w:l:s:n:c:j:r:v")) != -1) {
+		switch (option) {
+			case 'h': host = optarg; break;
+			case 'p': port = (unsigned short int) atoi(optarg); break;
+			case 'u': registrarID = optarg; break;
+			case 'w': registrarPassword = optarg; break;
+			case 'l': socketName = optarg; break;
+			case 's': sessions = atoi(optarg); break;
+			case 'n': window = atoi(optarg); break;
+			case 'c': clientLimit = atoi(optarg); break;
+			case 'j': journalName = optarg; break;
+			case 'r': rate = atof(optarg); break;
+			case 'v': verbose = 1; break;
+			default: usage(argv[0]);
+		}
+	}
+
+	if (clientLimit == 0) {
+		clientLimit = window;
+	}
+
+	if (host == NULL || registrarID == NULL || registrarPassword == NULL ||
+		socketName == NULL || sessions < 1 || window < 1 ||
+		clientLimit < 1 || rate < 0 || optind != argc) {
+		usage(argv[0]);
+	}
+
+	/*
+	** Claim the socket before logging in, so that a second broker never
+	** adds its sessions to those of the first
+	*/
+	listener = openListener(socketName);
+	if (listener < 0) {
+		exit(1);
+	}
+
+	/*
+	** The sessions, and their logins, share the process governor
+	*/
+	if ((governor = RRPCreateToolGovernor(rate)) != NULL) {
+		RRPSetProcessGovernor(governor);
+	}
+
+	pool = RRPOpenToolPool(host, port, registrarID, registrarPassword,
+		sessions, window, BROKER_RECONNECT_ATTEMPTS, &endpoints,
+		&reconnect);
+
+	if (journalName != NULL) {
+		journal = RRPOpenJournal(journalName);
+		if (journal == NULL) {
+			RRPPrintInternalErrorDescription();
+			exit(1);
+		}
+		RRPSetSessionPoolJournal(pool, journal);
+	}
+
+	now = time(NULL);
+	strftime(greeting, sizeof(greeting),
+		"RRP Broker version 2.1.0\r\n%a %b %d %H:%M:%S GMT %Y\r\n.\r\n",
+		gmtime(&now));
+
+	RRPCatchToolSignals();
+	signal(SIGPIPE, SIG_IGN);
+
+	for (;;) {
+		/*
+		** Once interrupted, accept nothing more and read nothing more,
+		** but answer what is in flight
+		*/
+		if (RRPToolInterrupted && listener >= 0) {
+			close(listener);
+			unlink(socketName);
+			listener = -1;
+		}
+
+		for (client = clients, writing = 0; client != NULL;
+			client = client->next) {
+			if (client->socket >= 0 &&
+				client->outputStart < client->outputLength) {
+				writing++;
+			}
+		}
+
+		if (RRPToolInterrupted && writing == 0 &&
+			RRPGetSessionPoolPending(pool) == 0) {
+			break;
+		}
+
+		/*
+		** The sessions come first, then the listener, then the clients
+		*/
+		if (capacity < sessions + 1 + clientCount) {
+			capacity = (sessions + 1 + clientCount) * 2;
+			descriptors = (struct pollfd*) realloc(descriptors,
+				capacity * sizeof(struct pollfd));
+			polled = (BROKERCLIENT**) realloc(polled,
+				capacity * sizeof(BROKERCLIENT*));
+			if (descriptors == NULL || polled == NULL) {
+				fprintf(stderr, "Out of memory\n");
+				exit(1);
+			}
+		}
+
+		timeout = -1;
+		count = 0;
+		for (i = 0; i < sessions; i++) {
+			session = RRPGetPoolSession(pool, i);
+			descriptors[count].fd = -1;
+			descriptors[count].events = 0;
+			descriptors[count].revents = 0;
+
+			if (RRPIsSessionOpen(session)) {
+				if (RRPGetSessionEvents(session) & POLLOUT) {
+					RRPFlushSession(session);
+				}
+
+				/*
+				** Always read, to notice a server that closes an idle
+				** session
+				*/
+				if ((descriptors[count].fd =
+					RRPGetSessionDescriptor(session)) >= 0) {
+					descriptors[count].events =
+						RRPGetSessionEvents(session) | POLLIN;
+				}
+
+				if ((wait = RRPGetSessionTimeout(session)) >= 0 &&
+					(timeout < 0 || wait < timeout)) {
+					timeout = wait;
+				}
+			}
+			count++;
+		}
+
+		descriptors[count].fd = listener;
+		descriptors[count].events = POLLIN;
+		descriptors[count].revents = 0;
+		count++;
+
+		for (client = clients; client != NULL; client = client->next) {
+			if (client->socket < 0) {
+				continue;
+			}
+
+			descriptors[count].fd = client->socket;
+			descriptors[count].events = 0;
+			descriptors[count].revents = 0;
+			if (!RRPToolInterrupted && !client->ended && !client->closing &&
+				client->inFlight < clientLimit) {
+				descriptors[count].events |= POLLIN;
+			}
+			if (client->outputStart < client->outputLength) {
+				descriptors[count].events |= POLLOUT;
+			}
+			polled[count] = client;
+			count++;
+		}
+
+		result = poll(descriptors, count, timeout);
+		if (result < 0 && errno != EINTR) {
+			perror("poll");
+			status = 1;
+			break;
+		}
+
+		for (i = 0; i < count && result > 0; i++) {
+			if (descriptors[i].revents == 0) {
+				continue;
+			}
+
+			if (i < sessions) {
+				session = RRPGetPoolSession(pool, i);
+				if ((descriptors[i].revents & POLLOUT) &&
+					RRPFlushSession(session) < 0) {
+					continue;
+				}
+				if (descriptors[i].revents & (POLLIN | POLLERR | POLLHUP)) {
+					RRPProcessSession(session);
+				}
+			}
+			else if (i == sessions) {
+				acceptClients(listener);
+			}
+			else {
+				client = polled[i];
+				if (client->socket >= 0 &&
+					(descriptors[i].revents & POLLOUT)) {
+					writeClient(client);
+				}
+				if (client->socket >= 0 &&
+					(descriptors[i].revents & (POLLIN | POLLERR | POLLHUP))) {
+					readClient(client);
+				}
+			}
+		}
+
+		for (i = 0, alive = 0; i < sessions; i++) {
+			session = RRPGetPoolSession(pool, i);
+			if (RRPIsSessionOpen(session)) {
+				alive++;
+				if (RRPGetSessionTimeout(session) == 0) {
+					RRPFlushSession(session);
+				}
+			}
+		}
+
+		/*
+		** Relay what the clients have sent, including commands held
+		** back until earlier ones were answered
+		*/
+		for (client = clients; client != NULL; client = client->next) {
+			relayClient(client, pool);
+			if (client->socket >= 0 && client->closing &&
+				client->outputStart == client->outputLength) {
+				closeClient(client);
+			}
+		}
+		reapClients();
+
+		if (alive == 0) {
+			fprintf(stderr, "All sessions lost: ");
+			RRPPrintInternalErrorDescription();
+			status = 1;
+			RRPToolInterrupted = 1;
+		}
+	}
+
+	if (listener >= 0) {
+		close(listener);
+		unlink(socketName);
+	}
+
+	/*
+	** Closing the sessions completes whatever they still hold, so the
+	** clients go after them
+	*/
+	RRPFreeSessionPool(pool);
+	for (client = clients; client != NULL; client = client->next) {
+		closeClient(client);
+	}
+	reapClients();
+
+	RRPFreeRetryPolicy(reconnect);
+	RRPFreeEndpoints(endpoints);
+	if (journal != NULL) {
+		RRPCloseJournal(journal);
+	}
+	if (governor != NULL) {
+		RRPSetProcessGovernor(NULL);
+		RRPFreeGovernor(governor);
+	}
+	free(descriptors);
+	free(polled);
+
+	fprintf(stderr, "%lu clients, %lu commands relayed, %lu unknown\n",
+		accepted, relayed, unknown);
+
+	exit(status);
+
+} /* main() */
+
+
+/*
+** Prints the usage message and exits
+*/
+static void
+usage (
+	char* program
+) {
+	RRPPrintToolUsage(program,
+		"\t-l socket [-s sessions] [-n window] [-c commands] [-j journal]\n"
+		"\t[-r rate] [-v]\n",
+		"\t-l\tUnix domain socket the clients connect to\n"
+		"\t-c\tcommands of a client in flight (default the window)\n"
+		"\t-j\tjournal recording each command before it is sent\n"
+		"\t-v\tlog the clients as they come and go\n",
+		3);
+
+} /* usage() */
+
+
+/*
+** Creates the socket the clients connect to, readable and writable by
+** the owner and group only. A socket left behind by a broker that died
+** is replaced, but not one a broker still listens on. Returns the
+** descriptor, or -1 if it can not be created.
+*/
+static int
+openListener (
+	char* path
+) {
+	struct sockaddr_un address;
+	int listener = -1;
+
+	if (strlen(path) >= sizeof(address.sun_path)) {
+		fprintf(stderr, "%s: socket path too long\n", path);
+		return -1;
+	}
+
+	memset((char *) &address, 0, sizeof(address));
+	address.sun_family = AF_UNIX;
+	strcpy(address.sun_path, path);
+
+	listener = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (listener < 0) {
+		perror("socket");
+		return -1;
+	}
+
+	if (connect(listener, (struct sockaddr *) &address,
+		sizeof(address)) == 0) {
+		fprintf(stderr, "%s: a broker is already listening\n", path);
+		close(listener);
+		return -1;
+	}
+	close(listener);
+	unlink(path);
+
+	listener = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (listener < 0) {
+		perror("socket");
+		return -1;
+	}
+
+	if (bind(listener, (struct sockaddr *) &address,
+		sizeof(address)) < 0 ||
+		chmod(path, S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP) < 0 ||
+		listen(listener, BROKER_BACKLOG) < 0) {
+		perror(path);
+		close(listener);
+		return -1;
+	}
+
+	fcntl(listener, F_SETFL, fcntl(listener, F_GETFL) | O_NONBLOCK);
+
+	return listener;
+
+} /* openListener() */
+
+
+/*
+** Accepts the clients waiting on the socket and greets them
+*/
+static void
+acceptClients (
+	int listener
+) {
+	BROKERCLIENT* client = NULL;
+	int descriptor = -1;
+
+	while ((descriptor = accept(listener, NULL, NULL)) >= 0) {
+		fcntl(descriptor, F_SETFL, fcntl(descriptor, F_GETFL) | O_NONBLOCK);
+
+		client = (BROKERCLIENT*) calloc(1, sizeof(BROKERCLIENT));
+		if (client != NULL) {
+			client->outputCapacity = BROKER_READ_SIZE;
+			client->output = (char*) malloc(client->outputCapacity);
+		}
+		if (client == NULL || client->output == NULL) {
+			fprintf(stderr, "Out of memory\n");
+			free(client);
+			close(descriptor);
+			continue;
+		}
+
+		client->socket = descriptor;
+		client->outputLength = strlen(greeting);
+		memcpy(client->output, greeting, client->outputLength);
+		client->next = clients;
+		clients = client;
+		clientCount++;
+		accepted++;
+
+		if (verbose) {
+			fprintf(stderr, "client %d connected (%d clients)\n",
+				descriptor, clientCount);
+		}
+	}
+
+} /* acceptClients() */
+
+
+/*
+** Reads what a client has sent. The client is closed when it hangs up,
+** or when it sends a request too long to be one
+*/
+static void
+readClient (
+	BROKERCLIENT* client
+) {
+	char* input = NULL;
+	ssize_t count = 0;
+
+	if (client->inputCapacity - client->inputLength < BROKER_READ_SIZE) {
+		input = (char*) realloc(client->input,
+			client->inputCapacity + BROKER_READ_SIZE);
+		if (input == NULL) {
+			fprintf(stderr, "Out of memory\n");
+			closeClient(client);
+			return;
+		}
+		client->input = input;
+		client->inputCapacity += BROKER_READ_SIZE;
+	}
+
+	count = read(client->socket, client->input + client->inputLength,
+		client->inputCapacity - client->inputLength);
+	if (count < 0 && (errno == EAGAIN || errno == EINTR)) {
+		return;
+	}
+
+	if (count <= 0) {
+		closeClient(client);
+		return;
+	}
+
+	client->inputLength += count;
+
+	if (client->inputLength > BROKER_MAX_REQUEST &&
+		findRequestEnd(client->input, client->inputLength) == 0) {
+		fprintf(stderr, "client %d: request too long\n", client->socket);
+		closeClient(client);
+	}
+
+} /* readClient() */
+
+
+/*
+** Relays the complete requests a client has sent, as long as it has
+** fewer commands in flight than its limit. Session and Quit commands
+** and requests that are not RRP commands are answered at once, in
+** their turn
+*/
+static void
+relayClient (
+	BROKERCLIENT* client,
+	RRPSESSIONPOOL* pool
+) {
+	RRPREQUEST* request = NULL;
+	BROKERSLOT* slot = NULL;
+	size_t start = 0;
+	size_t length = 0;
+
+	while (client->socket >= 0 && !RRPToolInterrupted && !client->ended &&
+		!client->closing && client->inFlight < clientLimit &&
+		(length = findRequestEnd(client->input + start,
+		client->inputLength - start)) > 0) {
+		slot = addSlot(client);
+		if (slot == NULL) {
+			break;
+		}
+
+		request = RRPParseRequest(client->input + start, length);
+		start += length;
+
+		if (request == NULL) {
+			answerSlot(slot, BROKER_INVALID);
+		}
+		else if (request->command == RRP_SESSION_COMMAND) {
+			answerSlot(slot, BROKER_OK);
+			RRPFreeRequest(request);
+		}
+		else if (request->command == RRP_QUIT_COMMAND) {
+			answerSlot(slot, BROKER_BYE);
+			slot->last = 1;
+			client->ended = 1;
+			RRPFreeRequest(request);
+		}
+		else if (RRPSubmitPoolRequest(pool, request, completeRelay,
+			slot) < 0) {
+			answerSlot(slot, BROKER_RETRY);
+			RRPFreeRequest(request);
+		}
+		else {
+			client->inFlight++;
+			relayed++;
+		}
+	}
+
+	if (start > 0 && client->socket >= 0) {
+		memmove(client->input, client->input + start,
+			client->inputLength - start);
+		client->inputLength -= start;
+	}
+
+	deliverClient(client);
+
+} /* relayClient() */
+
+
+/*
+** Returns the length of the request at the start of 'text', which ends
+** with a "." line, or 0 if it is not complete
+*/
+static size_t
+findRequestEnd (
+	const char* text,
+	size_t length
+) {
+	size_t i = 0;
+
+	if (length >= 3 && memcmp(text, ".\r\n", 3) == 0) {
+		return 3;
+	}
+
+	for (i = 0; i + 5 <= length; i++) {
+		if (text[i] == '\r' && memcmp(text + i, "\r\n.\r\n", 5) == 0) {
+			return i + 5;
+		}
+	}
+
+	return 0;
+
+} /* findRequestEnd() */
+
+
+/*
+** Adds a command to the end of a client's queue. Returns NULL if memory
+** runs out; the client is then closed
+*/
+static BROKERSLOT*
+addSlot (
+	BROKERCLIENT* client
+) {
+	BROKERSLOT* slot = NULL;
+
+	slot = (BROKERSLOT*) calloc(1, sizeof(BROKERSLOT));
+	if (slot == NULL) {
+		fprintf(stderr, "Out of memory\n");
+		closeClient(client);
+		return NULL;
+	}
+
+	slot->client = client;
+	if (client->tail != NULL) {
+		client->tail->next = slot;
+	}
+	else {
+		client->head = slot;
+	}
+	client->tail = slot;
+
+	return slot;
+
+} /* addSlot() */
+
+
+/*
+** Answers a command with a response of the broker's own. The outcome of
+** the command is unknown if memory runs out
+*/
+static void
+answerSlot (
+	BROKERSLOT* slot,
+	const char* response
+) {
+	slot->length = strlen(response);
+	slot->response = (char*) malloc(slot->length);
+	if (slot->response == NULL) {
+		slot->lost = 1;
+		return;
+	}
+	memcpy(slot->response, response, slot->length);
+
+} /* answerSlot() */
+
+
+/*
+** Completion function of a relayed command: keeps the response until
+** the client's earlier commands are answered
+*/
+static void
+completeRelay (
+	RRPREQUEST* request,
+	RRPRESPONSE* response,
+	void* context
+) {
+	BROKERSLOT* slot = (BROKERSLOT*) context;
+	RRPOUTCOME outcome = RRP_OUTCOME_UNKNOWN;
+
+	(void) request;
+
+	if (response != NULL && response->code == 420) {
+		/*
+		** The server failed the command and closed the session, which
+		** is opened again here: the client just sends it again
+		*/
+		RRPFreeResponse(response);
+		answerSlot(slot, BROKER_RETRY);
+	}
+	else if (response != NULL) {
+		slot->response = RRPFormatResponse(response, &slot->length);
+		slot->lost = slot->response == NULL;
+		RRPFreeResponse(response);
+	}
+	else {
+		/*
+		** A command that was never sent can be sent again
+		*/
+		outcome = RRPClassifyOutcome(NULL, RRPGetInternalErrorCode());
+		if (outcome == RRP_OUTCOME_DISCONNECTED) {
+			answerSlot(slot, BROKER_RETRY);
+		}
+		else {
+			slot->lost = 1;
+		}
+	}
+
+	if (slot->lost) {
+		unknown++;
+	}
+
+	slot->client->inFlight--;
+	deliverClient(slot->client);
+
+} /* completeRelay() */
+
+
+/*
+** Moves the responses at the head of a client's queue to its output.
+** After a command whose outcome is unknown, or after a Quit, the client
+** is closed and nothing more is written to it
+*/
+static void
+deliverClient (
+	BROKERCLIENT* client
+) {
+	BROKERSLOT* slot = NULL;
+	char* output = NULL;
+	size_t capacity = 0;
+
+	while ((slot = client->head) != NULL &&
+		(slot->response != NULL || slot->lost)) {
+		if (client->socket >= 0 && !client->closing) {
+			if (!slot->lost && client->outputLength + slot->length >
+				client->outputCapacity) {
+				capacity = client->outputCapacity * 2;
+				if (capacity < client->outputLength + slot->length) {
+					capacity = client->outputLength + slot->length;
+				}
+				output = (char*) realloc(client->output, capacity);
+				if (output == NULL) {
+					slot->lost = 1;
+				}
+				else {
+					client->output = output;
+					client->outputCapacity = capacity;
+				}
+			}
+
+			if (slot->lost) {
+				client->closing = 1;
+			}
+			else {
+				memcpy(client->output + client->outputLength,
+					slot->response, slot->length);
+				client->outputLength += slot->length;
+				client->closing = slot->last;
+			}
+		}
+
+		client->head = slot->next;
+		if (client->head == NULL) {
+			client->tail = NULL;
+		}
+		free(slot->response);
+		free(slot);
+	}
+
+} /* deliverClient() */
+
+
+/*
+** Writes what a client's connection accepts of its output. The client
+** is closed if it has hung up
+*/
+static void
+writeClient (
+	BROKERCLIENT* client
+) {
+	ssize_t count = 0;
+
+	count = write(client->socket, client->output + client->outputStart,
+		client->outputLength - client->outputStart);
+	if (count < 0 && (errno == EAGAIN || errno == EINTR)) {
+		return;
+	}
+
+	if (count < 0) {
+		closeClient(client);
+		return;
+	}
+
+	client->outputStart += count;
+	if (client->outputStart == client->outputLength) {
+		client->outputStart = 0;
+		client->outputLength = 0;
+	}
+
+} /* writeClient() */
+
+
+/*
+** Closes the connection of a client. Its commands in flight are still
+** completed, and their responses dropped
+*/
+static void
+closeClient (
+	BROKERCLIENT* client
+) {
+	if (client->socket < 0) {
+		return;
+	}
+
+	if (verbose) {
+		fprintf(stderr, "client %d disconnected (%d in flight)\n",
+			client->socket, client->inFlight);
+	}
+
+	close(client->socket);
+	client->socket = -1;
+	free(client->input);
+	client->input = NULL;
+	client->inputLength = 0;
+	client->inputCapacity = 0;
+	client->outputStart = 0;
+	client->outputLength = 0;
+
+	deliverClient(client);
+
+} /* closeClient() */
+
+
+/*
+** Frees the clients that are closed and have no command in flight
+*/
+static void
+reapClients (void) {
+	BROKERCLIENT** link = &clients;
+	BROKERCLIENT* client = NULL;
+	BROKERSLOT* slot = NULL;
+
+	while ((client = *link) != NULL) {
+		if (client->socket >= 0 || client->inFlight > 0) {
+			link = &client->next;
+			continue;
+		}
+
+		while ((slot = client->head) != NULL) {
+			client->head = slot->next;
+			free(slot->response);
+			free(slot);
+		}
+
+		*link = client->next;
+		free(client->output);
+		free(client);
+		clientCount--;
+	}
+
+} /* reapClients() */
@@ -0,0 +1,902 @@
+/* ===========================================================================
+ * Copyright (C) 2000 VeriSign, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * VeriSign Global Registry Service
+ * 21345 Ridgetop Circle
+ * Dulles, VA 20166
+ * ===========================================================================
+ * The RRP, APIs and Software are provided "as-is" and without any warranty
+ * of any kind.  NSI EXPRESSLY DISCLAIMS ALL WARRANTIES AND/OR CONDITIONS,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * AND CONDITIONS OF MERCHANTABILITY OR SATISFACTORY QUALITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE AND NONINFRINGEMENT OF THIRD PARTY RIGHTS.  NSI DOES
+ * NOT WARRANT THAT THE FUNCTIONS CONTAINED IN THE RRP, APIs OR SOFTWARE
+ * WILL MEET REGISTRAR'S REQUIREMENTS, OR THAT THE OPERATION OF THE RRP,
+ * APIs OR SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE,OR THAT DEFECTS IN
+ * THE RRP, APIs OR SOFTWARE WILL BE CORRECTED.  FURTHERMORE, NSI DOES NOT
+ * WARRANT NOR MAKE ANY REPRESENTATIONS REGARDING THE USE OR THE RESULTS OF
+ * THE RRP, APIs, SOFTWARE OR RELATED DOCUMENTATION IN TERMS OF THEIR
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR OTHERWISE.  SHOULD THE RRP, APIs
+ * OR SOFTWARE PROVE DEFECTIVE, REGISTRAR ASSUMES THE ENTIRE COST OF ALL
+ * NECESSARY SERVICING, REPAIR OR CORRECTION.
+ * ======================================================================== */
+
+/*
+**
+** Module Name: rrpCache.c
+**
+** Version: 2.1 for RRP version 2.1.0
+**
+** Date: Oct. 19th, 2026
+**
+** Description: rrpCache keeps the responses to Check and Status
+**              requests per name (see rrpCache.h).
+**
+**              A name hashes to a stripe, which holds a mutex, a table of
+**              entries and the list of its entries from the oldest to the
+**              newest. An entry holds the Check response and the Status
+**              response of one name, each with the time it expires.
+**              Stripes also count the entries they dropped after a
+**              change: a response is only kept if that version did not
+**              move while its request was in flight.
+**
+** Entry Points:
+**
+**    RRPCreateCache(int, int, int, int, int);
+**    RRPGetCachedResponse(RRPCACHE*, RRPREQUEST*, unsigned long*);
+**    RRPCacheResponse(RRPCACHE*, RRPREQUEST*, RRPRESPONSE*,
+**        unsigned long);
+**    RRPInvalidateCache(RRPCACHE*, RRPENTITY, char*);
+**    RRPGetCacheStatistics(RRPCACHE*, RRPCACHESTATISTICS*);
+**    RRPFreeCache(RRPCACHE*);
+**
+** Changes:
+**
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <time.h>
+#include <pthread.h>
+#include "rrpCache.h"
+#include "rrpInternalError.h"
+
+/*
+** Number of stripes when none is given
+*/
+#ifndef RRP_CACHE_STRIPES
+	#define RRP_CACHE_STRIPES 64
+#endif
+
+/*
+** Kinds of results, each with its own time to live
+*/
+#define RRP_CACHE_FOUND      0
+#define RRP_CACHE_NOT_FOUND  1
+#define RRP_CACHE_AVAILABLE  2
+
+/*
+** Slots of an entry
+*/
+#define RRP_CACHE_CHECK      0
+#define RRP_CACHE_STATUS     1
+
+typedef struct _RRPCACHEENTRY  RRPCACHEENTRY;
+
+struct _RRPCACHEENTRY {
+	unsigned long hash;
+	RRPENTITY entity;
+	char* name;                 /* lower case */
+	size_t length;
+	RRPRESPONSE* responses[2];  /* Check and Status responses, or NULL */
+	time_t expires[2];
+	RRPCACHEENTRY* next;        /* next entry in the same bucket */
+	RRPCACHEENTRY* older;
+	RRPCACHEENTRY* newer;
+};
+
+typedef struct {
+	pthread_mutex_t mutex;
+	RRPCACHEENTRY** buckets;
+	int count;
+	RRPCACHEENTRY* oldest;
+	RRPCACHEENTRY* newest;
+	unsigned long version;      /* entries dropped after a change */
+	RRPCACHESTATISTICS statistics;
+} RRPCACHESTRIPE;
+
+struct _RRPCACHE {
+	RRPCACHESTRIPE* stripes;
+	int stripeCount;
+	int bucketCount;            /* buckets of each stripe */
+	int limit;                  /* entries of each stripe */
+	int ttl[3];                 /* by kind of result */
+};
+
+
+/*
+** Functions used internally by the cache
+*/
+static time_t getCacheTime (void);
+static unsigned long hashCacheName (RRPENTITY, const char*, size_t);
+static RRPCACHESTRIPE* getCacheStripe (RRPCACHE*, unsigned long);
+static RRPCACHEENTRY** findCacheEntry (RRPCACHE*, RRPCACHESTRIPE*,
+	unsigned long, RRPENTITY, const char*, size_t);
+static void removeCacheEntry (RRPCACHESTRIPE*, RRPCACHEENTRY**);
+static int getCacheSlot (RRPREQUEST*);
+static int getCacheKind (RRPRESPONSE*);
+static int invalidateCacheName (RRPCACHE*, RRPENTITY, const char*, size_t);
+
+
+
+
+/*
+**
+** Function: RRPCreateCache
+**
+** Description: Creates an empty response cache
+**
+** Input: int - number of stripes (locks). 0 selects a default
+**        int - maximum number of names kept. The oldest entries are
+**              dropped to make room
+**        int - time to live of found results, in seconds
+**        int - time to live of "not found" results, in seconds
+**        int - time to live of "available" results, in seconds
+**
+**        A time to live of 0 keeps no result of that kind.
+**
+** Output: none
+**
+** Return: RRPCACHE* - a pointer to an RRPCACHE structure. NULL is returned
+**                     if an internal error occurs.
+**
+** Note: THE CACHE MUST BE RELEASED BY CALLING RRPFreeCache()
+**
+*/
+
+RRPCACHE*
+RRPCreateCache (
+	int stripeCount,
+	int capacity,
+	int ttl,
+	int notFoundTtl,
+	int availableTtl
+) {
+	RRPCACHE* cache = NULL;
+	int i = 0;
+
+	/*
+	** Validate parameters
+	*/
+	if (stripeCount < 0 || capacity < 1 || ttl < 0 || notFoundTtl < 0 ||
+		availableTtl < 0) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return NULL;
+	}
+
+	if (stripeCount == 0) {
+		stripeCount = RRP_CACHE_STRIPES;
+	}
+	if (stripeCount > capacity) {
+		stripeCount = capacity;
+	}
+
+	cache = (RRPCACHE*) calloc(1, sizeof(RRPCACHE));
+	if (cache == NULL) {
+		RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
+		return NULL;
+	}
+
+	cache->stripeCount = stripeCount;
+	cache->limit = (capacity + stripeCount - 1) / stripeCount;
+	cache->bucketCount = cache->limit < 16 ? 16 : cache->limit;
+	cache->ttl[RRP_CACHE_FOUND] = ttl;
+	cache->ttl[RRP_CACHE_NOT_FOUND] = notFoundTtl;
+	cache->ttl[RRP_CACHE_AVAILABLE] = availableTtl;
+
+	cache->stripes = (RRPCACHESTRIPE*) calloc(stripeCount,
+		sizeof(RRPCACHESTRIPE));
+	if (cache->stripes == NULL) {
+		free(cache);
+		RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
+		return NULL;
+	}
+
+	for (i = 0; i < stripeCount; i++) {
+		cache->stripes[i].buckets = (RRPCACHEENTRY**) calloc(
+			cache->bucketCount, sizeof(RRPCACHEENTRY*));
+		if (cache->stripes[i].buckets == NULL) {
+			cache->stripeCount = i;
+			RRPFreeCache(cache);
+			RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
+			return NULL;
+		}
+		pthread_mutex_init(&cache->stripes[i].mutex, NULL);
+	}
+
+	return cache;
+
+} /* RRPCreateCache */
+
+
+
+
+
+
+/*
+**
+** Function: RRPGetCachedResponse
+**
+** Description: Looks up the response to a Check or Status request
+**
+** Input: RRPCACHE* - a pointer to an RRPCACHE structure
+**        RRPREQUEST* - the request
+**
+** Output: unsigned long* - optional (may be NULL). Receives the version
+**                          of the request's entry, to be passed to
+**                          RRPCacheResponse() with the response from the
+**                          registry on a miss
+**
+** Return: RRPRESPONSE* - a copy of the cached response (see
+**                        RRPCloneResponse()). NULL is returned on a miss,
+**                        with the internal error code set to
+**                        RRP_NO_ERROR, or if an internal error occurs.
+**
+** Note: THE MEMORY ALLOCATED FOR THE RRPRESPONSE STRUCTURE MUST BE
+**       RELEASED BY CALLING THE RRPFreeResponse() FUNCTION
+**
+*/
+
+RRPRESPONSE*
+RRPGetCachedResponse (
+	RRPCACHE* cache,
+	RRPREQUEST* request,
+	unsigned long* version
+) {
+	RRPCACHESTRIPE* stripe = NULL;
+	RRPCACHEENTRY** link = NULL;
+	RRPCACHEENTRY* entry = NULL;
+	RRPRESPONSE* response = NULL;
+	const char* name = NULL;
+	unsigned long hash = 0;
+	int slot = 0;
+
+	/*
+	** Validate parameters
+	*/
+	if (cache == NULL || request == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return NULL;
+	}
+
+	RRPSetInternalErrorCode(RRP_NO_ERROR);
+
+	if ((slot = getCacheSlot(request)) < 0) {
+		if (version != NULL) {
+			*version = 0;
+		}
+		return NULL;
+	}
+
+	name = request->text + request->nameOffset;
+	hash = hashCacheName(request->entity, name, request->nameLength);
+	stripe = getCacheStripe(cache, hash);
+
+	pthread_mutex_lock(&stripe->mutex);
+
+	if (version != NULL) {
+		*version = stripe->version;
+	}
+
+	link = findCacheEntry(cache, stripe, hash, request->entity, name,
+		request->nameLength);
+
+	if ((entry = *link) != NULL && entry->responses[slot] != NULL) {
+		if (entry->expires[slot] > getCacheTime()) {
+			response = RRPCloneResponse(entry->responses[slot]);
+		}
+		else {
+			RRPFreeResponse(entry->responses[slot]);
+			entry->responses[slot] = NULL;
+			if (entry->responses[1 - slot] == NULL) {
+				removeCacheEntry(stripe, link);
+			}
+		}
+	}
+
+	if (response != NULL) {
+		stripe->statistics.hits++;
+	}
+	else {
+		stripe->statistics.misses++;
+	}
+
+	pthread_mutex_unlock(&stripe->mutex);
+
+	return response;
+
+} /* RRPGetCachedResponse */
+
+
+
+
+
+
+/*
+**
+** Function: RRPCacheResponse
+**
+** Description: Updates a cache with the outcome of a request. The
+**              response to a Check or Status request is kept (a copy of
+**              it), unless the name's entry was dropped since the version
+**              was read. A request that changes its entity drops the
+**              name's entry, even when it failed without a response,
+**              since the change may still have happened
+**
+** Input: RRPCACHE* - a pointer to an RRPCACHE structure
+**        RRPREQUEST* - the request
+**        RRPRESPONSE* - its response, or NULL if it failed
+**        unsigned long - the version returned by RRPGetCachedResponse()
+**                        before the request was sent
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful, whether or not the response
+**               was kept. -1 is returned if an internal error occurs.
+**
+*/
+
+int
+RRPCacheResponse (
+	RRPCACHE* cache,
+	RRPREQUEST* request,
+	RRPRESPONSE* response,
+	unsigned long version
+) {
+	RRPCACHESTRIPE* stripe = NULL;
+	RRPCACHEENTRY** link = NULL;
+	RRPCACHEENTRY* entry = NULL;
+	RRPRESPONSE* copy = NULL;
+	const char* name = NULL;
+	unsigned long hash = 0;
+	int slot = 0;
+	int kind = 0;
+	size_t i = 0;
+
+	/*
+	** Validate parameters
+	*/
+	if (cache == NULL || request == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	if (request->entity == RRP_NO_ENTITY) {
+		return 0;
+	}
+
+	name = request->text + request->nameOffset;
+
+	switch (request->command) {
+		case RRP_ADD_COMMAND:
+		case RRP_DEL_COMMAND:
+		case RRP_MOD_COMMAND:
+		case RRP_RENEW_COMMAND:
+		case RRP_RESTORE_COMMAND:
+		case RRP_SYNC_COMMAND:
+		case RRP_TRANSFER_COMMAND:
+			return invalidateCacheName(cache, request->entity, name,
+				request->nameLength);
+
+		default:
+			break;
+	}
+
+	if (response == NULL || (slot = getCacheSlot(request)) < 0 ||
+		(kind = getCacheKind(response)) < 0 || cache->ttl[kind] == 0) {
+		return 0;
+	}
+
+	/*
+	** Copy outside the lock
+	*/
+	if ((copy = RRPCloneResponse(response)) == NULL) {
+		return -1;
+	}
+
+	hash = hashCacheName(request->entity, name, request->nameLength);
+	stripe = getCacheStripe(cache, hash);
+
+	pthread_mutex_lock(&stripe->mutex);
+
+	/*
+	** The name may have changed after the response was sent
+	*/
+	if (stripe->version != version) {
+		pthread_mutex_unlock(&stripe->mutex);
+		RRPFreeResponse(copy);
+		return 0;
+	}
+
+	link = findCacheEntry(cache, stripe, hash, request->entity, name,
+		request->nameLength);
+
+	if ((entry = *link) != NULL) {
+		/*
+		** Make it the newest entry
+		*/
+		if (entry != stripe->newest) {
+			if (entry->older != NULL) {
+				entry->older->newer = entry->newer;
+			}
+			else {
+				stripe->oldest = entry->newer;
+			}
+			entry->newer->older = entry->older;
+			entry->older = stripe->newest;
+			entry->newer = NULL;
+			stripe->newest->newer = entry;
+			stripe->newest = entry;
+		}
+	}
+	else {
+		entry = (RRPCACHEENTRY*) calloc(1, sizeof(RRPCACHEENTRY));
+		if (entry == NULL ||
+			(entry->name = (char*) malloc(request->nameLength + 1)) == NULL) {
+			pthread_mutex_unlock(&stripe->mutex);
+			free(entry);
+			RRPFreeResponse(copy);
+			RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
+			return -1;
+		}
+
+		for (i = 0; i < request->nameLength; i++) {
+			entry->name[i] = (char) tolower((unsigned char) name[i]);
+		}
+		entry->name[i] = '\0';
+		entry->length = request->nameLength;
+		entry->hash = hash;
+		entry->entity = request->entity;
+
+		entry->next = *link;
+		*link = entry;
+
+		entry->older = stripe->newest;
+		if (stripe->newest != NULL) {
+			stripe->newest->newer = entry;
+		}
+		else {
+			stripe->oldest = entry;
+		}
+		stripe->newest = entry;
+		stripe->count++;
+
+		/*
+		** Make room by dropping the oldest entry
+		*/
+		if (stripe->count > cache->limit) {
+			link = findCacheEntry(cache, stripe, stripe->oldest->hash,
+				stripe->oldest->entity, stripe->oldest->name,
+				stripe->oldest->length);
+			removeCacheEntry(stripe, link);
+			stripe->statistics.evictions++;
+		}
+	}
+
+	if (entry->responses[slot] != NULL) {
+		RRPFreeResponse(entry->responses[slot]);
+	}
+	entry->responses[slot] = copy;
+	entry->expires[slot] = getCacheTime() + cache->ttl[kind];
+	stripe->statistics.stores++;
+
+	pthread_mutex_unlock(&stripe->mutex);
+
+	return 0;
+
+} /* RRPCacheResponse */
+
+
+
+
+
+
+/*
+**
+** Function: RRPInvalidateCache
+**
+** Description: Drops the entry of a name (e.g. after it was changed by
+**              another program)
+**
+** Input: RRPCACHE* - a pointer to an RRPCACHE structure
+**        RRPENTITY - the entity
+**        char* - the domain name or name server host name
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+
+int
+RRPInvalidateCache (
+	RRPCACHE* cache,
+	RRPENTITY entity,
+	char* name
+) {
+	/*
+	** Validate parameters
+	*/
+	if (cache == NULL || name == NULL || (entity != RRP_DOMAIN_ENTITY &&
+		entity != RRP_NAMESERVER_ENTITY)) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	return invalidateCacheName(cache, entity, name, strlen(name));
+
+} /* RRPInvalidateCache */
+
+
+
+
+
+
+/*
+**
+** Function: RRPGetCacheStatistics
+**
+** Description: Returns the counts of the lookups and updates of a cache
+**
+** Input: RRPCACHE* - a pointer to an RRPCACHE structure
+**
+** Output: RRPCACHESTATISTICS* - the counts
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+
+int
+RRPGetCacheStatistics (
+	RRPCACHE* cache,
+	RRPCACHESTATISTICS* statistics
+) {
+	RRPCACHESTRIPE* stripe = NULL;
+	int i = 0;
+
+	/*
+	** Validate parameters
+	*/
+	if (cache == NULL || statistics == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	memset(statistics, 0, sizeof(RRPCACHESTATISTICS));
+
+	for (i = 0; i < cache->stripeCount; i++) {
+		stripe = &cache->stripes[i];
+
+		pthread_mutex_lock(&stripe->mutex);
+		statistics->hits += stripe->statistics.hits;
+		statistics->misses += stripe->statistics.misses;
+		statistics->stores += stripe->statistics.stores;
+		statistics->invalidations += stripe->statistics.invalidations;
+		statistics->evictions += stripe->statistics.evictions;
+		pthread_mutex_unlock(&stripe->mutex);
+	}
+
+	return 0;
+
+} /* RRPGetCacheStatistics */
+
+
+
+
+
+
+/*
+**
+** Function: RRPFreeCache
+**
+** Description: Frees a cache and the responses it keeps
+**
+** Input: RRPCACHE* - a pointer to an RRPCACHE structure
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+
+int
+RRPFreeCache (
+	RRPCACHE* cache
+) {
+	RRPCACHESTRIPE* stripe = NULL;
+	RRPCACHEENTRY* entry = NULL;
+	int i = 0;
+
+	/*
+	** Validate parameters
+	*/
+	if (cache == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	for (i = 0; i < cache->stripeCount; i++) {
+		stripe = &cache->stripes[i];
+
+		while ((entry = stripe->oldest) != NULL) {
+			stripe->oldest = entry->newer;
+			if (entry->responses[RRP_CACHE_CHECK] != NULL) {
+				RRPFreeResponse(entry->responses[RRP_CACHE_CHECK]);
+			}
+			if (entry->responses[RRP_CACHE_STATUS] != NULL) {
+				RRPFreeResponse(entry->responses[RRP_CACHE_STATUS]);
+			}
+			free(entry->name);
+			free(entry);
+		}
+
+		pthread_mutex_destroy(&stripe->mutex);
+		free(stripe->buckets);
+	}
+
+	free(cache->stripes);
+	free(cache);
+
+	return 0;
+
+} /* RRPFreeCache */
+
+
+
+
+
+
+/*
+** Returns the time of a clock that is not set back, in seconds
+*/
+static time_t
+getCacheTime (void) {
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return now.tv_sec;
+
+} /* getCacheTime() */
+
+
+
+/*
+** Returns the hash value of an entity name, ignoring case
+*/
+static unsigned long
+hashCacheName (
+	RRPENTITY entity,
+	const char* name,
+	size_t length
+) {
+	unsigned long hash = 5381 + (unsigned long) entity;
+	size_t i = 0;
+
+	for (i = 0; i < length; i++) {
+		hash = hash * 33 + (unsigned char) tolower((unsigned char) name[i]);
+	}
+
+	return hash;
+
+} /* hashCacheName() */
+
+
+
+/*
+** Returns the stripe of a hash value
+*/
+static RRPCACHESTRIPE*
+getCacheStripe (
+	RRPCACHE* cache,
+	unsigned long hash
+) {
+	return &cache->stripes[hash % cache->stripeCount];
+
+} /* getCacheStripe() */
+
+
+
+/*
+** Returns the link to the entry of a name in its stripe's table, or the
+** link at the end of its bucket if there is no such entry. The stripe
+** must be locked
+*/
+static RRPCACHEENTRY**
+findCacheEntry (
+	RRPCACHE* cache,
+	RRPCACHESTRIPE* stripe,
+	unsigned long hash,
+	RRPENTITY entity,
+	const char* name,
+	size_t length
+) {
+	RRPCACHEENTRY** link = NULL;
+	RRPCACHEENTRY* entry = NULL;
+	size_t i = 0;
+
+	link = &stripe->buckets[(hash / cache->stripeCount) %
+		cache->bucketCount];
+
+	for (; (entry = *link) != NULL; link = &entry->next) {
+		if (entry->hash != hash || entry->entity != entity ||
+			entry->length != length) {
+			continue;
+		}
+
+		for (i = 0; i < length; i++) {
+			if (entry->name[i] != tolower((unsigned char) name[i])) {
+				break;
+			}
+		}
+
+		if (i == length) {
+			break;
+		}
+	}
+
+	return link;
+
+} /* findCacheEntry() */
+
+
+
+/*
+** Unlinks and frees an entry. The stripe must be locked
+*/
+static void
+removeCacheEntry (
+	RRPCACHESTRIPE* stripe,
+	RRPCACHEENTRY** link
+) {
+	RRPCACHEENTRY* entry = *link;
+
+	*link = entry->next;
+
+	if (entry->older != NULL) {
+		entry->older->newer = entry->newer;
+	}
+	else {
+		stripe->oldest = entry->newer;
+	}
+
+	if (entry->newer != NULL) {
+		entry->newer->older = entry->older;
+	}
+	else {
+		stripe->newest = entry->older;
+	}
+
+	stripe->count--;
+
+	if (entry->responses[RRP_CACHE_CHECK] != NULL) {
+		RRPFreeResponse(entry->responses[RRP_CACHE_CHECK]);
+	}
+	if (entry->responses[RRP_CACHE_STATUS] != NULL) {
+		RRPFreeResponse(entry->responses[RRP_CACHE_STATUS]);
+	}
+	free(entry->name);
+	free(entry);
+
+} /* removeCacheEntry() */
+
+
+
+/*
+** Returns the slot of a request that can be cached, or -1. A request
+** carrying attributes besides the entity name is not cached
+*/
+static int
+getCacheSlot (
+	RRPREQUEST* request
+) {
+	if ((request->entity != RRP_DOMAIN_ENTITY &&
+		request->entity != RRP_NAMESERVER_ENTITY) ||
+		request->length != request->nameOffset + request->nameLength +
+			sizeof("\r\n.\r\n") - 1) {
+		return -1;
+	}
+
+	if (request->command == RRP_CHECK_COMMAND) {
+		return RRP_CACHE_CHECK;
+	}
+
+	if (request->command == RRP_STATUS_COMMAND) {
+		return RRP_CACHE_STATUS;
+	}
+
+	return -1;
+
+} /* getCacheSlot() */
+
+
+
+/*
+** Returns the kind of result of a response, or -1 if it is not kept
+*/
+static int
+getCacheKind (
+	RRPRESPONSE* response
+) {
+	switch (response->code) {
+		case 200:
+		case 211:
+		case 213:
+			return RRP_CACHE_FOUND;
+
+		case 545:
+			return RRP_CACHE_NOT_FOUND;
+
+		case 210:
+		case 212:
+			return RRP_CACHE_AVAILABLE;
+
+		default:
+			return -1;
+	}
+
+} /* getCacheKind() */
+
+
+
+/*
+** Drops the entry of a name and moves its stripe's version, so that the
+** responses in flight for the name are not kept
+*/
+static int
+invalidateCacheName (
+	RRPCACHE* cache,
+	RRPENTITY entity,
+	const char* name,
+	size_t length
+) {
+	RRPCACHESTRIPE* stripe = NULL;
+	RRPCACHEENTRY** link = NULL;
+	unsigned long hash = 0;
+
+	hash = hashCacheName(entity, name, length);
+	stripe = getCacheStripe(cache, hash);
+
+	pthread_mutex_lock(&stripe->mutex);
+
+	stripe->version++;
+
+	link = findCacheEntry(cache, stripe, hash, entity, name, length);
+	if (*link != NULL) {
+		removeCacheEntry(stripe, link);
+		stripe->statistics.invalidations++;
+	}
+
+	pthread_mutex_unlock(&stripe->mutex);
+
+	return 0;
+
+} /* invalidateCacheName() */
@@ -0,0 +1,1100 @@
+/* ===========================================================================
+ * Copyright (C) 2000 VeriSign, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * VeriSign Global Registry Service
+ * 21345 Ridgetop Circle
+ * Dulles, VA 20166
+ * ===========================================================================
+ * The RRP, APIs and Software are provided "as-is" and without any warranty
+ * of any kind.  NSI EXPRESSLY DISCLAIMS ALL WARRANTIES AND/OR CONDITIONS,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * AND CONDITIONS OF MERCHANTABILITY OR SATISFACTORY QUALITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE AND NONINFRINGEMENT OF THIRD PARTY RIGHTS.  NSI DOES
+ * NOT WARRANT THAT THE FUNCTIONS CONTAINED IN THE RRP, APIs OR SOFTWARE
+ * WILL MEET REGISTRAR'S REQUIREMENTS, OR THAT THE OPERATION OF THE RRP,
+ * APIs OR SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE,OR THAT DEFECTS IN
+ * THE RRP, APIs OR SOFTWARE WILL BE CORRECTED.  FURTHERMORE, NSI DOES NOT
+ * WARRANT NOR MAKE ANY REPRESENTATIONS REGARDING THE USE OR THE RESULTS OF
+ * THE RRP, APIs, SOFTWARE OR RELATED DOCUMENTATION IN TERMS OF THEIR
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR OTHERWISE.  SHOULD THE RRP, APIs
+ * OR SOFTWARE PROVE DEFECTIVE, REGISTRAR ASSUMES THE ENTIRE COST OF ALL
+ * NECESSARY SERVICING, REPAIR OR CORRECTION.
+ * ======================================================================== */
+
+/*
+**
+** Module Name: rrpCalendar.c
+**
+** Version: 2.1 for RRP version 2.1.0
+**
+** Date: Oct. 19th, 2026
+**
+** Description: rrpCalendar indexes domain names by their registration
+**              expiration date in a time wheel of day-sized buckets, and
+**              renews the domains that are due (see rrpCalendar.h).
+**
+** Entry Points:
+**
+**    RRPCreateCalendar(time_t);
+**    RRPAddCalendarDomain(RRPCALENDAR*, char*, time_t);
+**    RRPAddCalendarResponse(RRPCALENDAR*, char*, RRPRESPONSE*);
+**    RRPRemoveCalendarDomain(RRPCALENDAR*, char*);
+**    RRPGetCalendarExpiration(RRPCALENDAR*, char*);
+**    RRPGetCalendarSize(RRPCALENDAR*);
+**    RRPRenewCalendarDomains(RRPCALENDAR*, time_t, int, RRPSESSIONPOOL*,
+**        int);
+**    RRPGetCalendarRenewals(RRPCALENDAR*, int*);
+**    RRPFreeCalendar(RRPCALENDAR*);
+**
+** Changes:
+**
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "rrpCalendar.h"
+#include "rrpInternalError.h"
+
+/*
+** Seconds in a day
+*/
+#define RRP_CALENDAR_DAY 86400L
+
+/*
+** A domain of a calendar. It is linked in the bucket of its day and in
+** the table of names
+*/
+typedef struct _RRPCALENDARENTRY  RRPCALENDARENTRY;
+
+struct _RRPCALENDARENTRY {
+	char* name;
+	unsigned long hash;         /* hash value of 'name' */
+	time_t expiration;
+	RRPCALENDARENTRY* previous; /* previous entry of the bucket */
+	RRPCALENDARENTRY* next;     /* next entry of the bucket */
+	RRPCALENDARENTRY* nextName; /* next entry of the name table bucket */
+};
+
+/*
+** State of RRPRenewCalendarDomains(). Each Renew command in flight has a
+** slot, which is reused for the next domain when the command completes.
+** The state belongs to the calendar so that commands left in flight by
+** an error can still complete
+*/
+typedef struct {
+	RRPSESSIONPOOL* pool;
+	int period;
+	int next;                   /* next renewal to submit */
+	int completed;              /* renewals completed or failed */
+	int renewed;                /* renewals accepted */
+} RRPRENEWBATCH;
+
+typedef struct {
+	RRPCALENDAR* calendar;
+	int index;                  /* renewal in flight */
+} RRPRENEWSLOT;
+
+struct _RRPCALENDAR {
+	long firstDay;              /* first day whose domains have not all
+	                               been taken */
+	int count;                  /* number of domains */
+	RRPCALENDARENTRY* days[RRP_CALENDAR_DAYS];
+	RRPCALENDARENTRY** names;   /* table of names */
+	int nameTableSize;          /* buckets of the table, a power of 2 */
+	RRPCALENDARRENEWAL* renewals;
+	int renewalCount;
+	int renewalCapacity;
+	RRPRENEWBATCH batch;
+	RRPRENEWSLOT* slots;
+	int slotCount;
+};
+
+
+/*
+** Functions used internally to index the domains and renew them
+*/
+static unsigned long hashCalendarName (const char*);
+static RRPCALENDARENTRY* findCalendarEntry (RRPCALENDAR*, const char*,
+	unsigned long);
+static void linkCalendarEntry (RRPCALENDAR*, RRPCALENDARENTRY*);
+static void unlinkCalendarEntry (RRPCALENDAR*, RRPCALENDARENTRY*);
+static int growCalendarNames (RRPCALENDAR*);
+static int takeDueCalendarDomains (RRPCALENDAR*, time_t, int);
+static void submitRenewal (RRPRENEWSLOT*);
+static void completeRenewal (RRPREQUEST*, RRPRESPONSE*, void*);
+static int finishRenewals (RRPCALENDAR*, RRPSESSIONPOOL*);
+
+
+
+
+/*
+**
+** Function: RRPCreateCalendar
+**
+** Description: Creates an empty calendar
+**
+** Input: time_t - the first day whose domains can be taken. Domains
+**                 that expire before it are due on that day
+**
+** Output: none
+**
+** Return: RRPCALENDAR* - a pointer to an allocated RRPCALENDAR
+**                        structure. NULL is returned if an internal
+**                        error occurs.
+**
+** Note: THE MEMORY ALLOCATED FOR THE RRPCALENDAR STRUCTURE MUST BE
+**       RELEASED BY CALLING THE RRPFreeCalendar() FUNCTION
+**
+*/
+
+RRPCALENDAR*
+RRPCreateCalendar (
+	time_t start
+) {
+	RRPCALENDAR* calendar = NULL;
+
+	/*
+	** Validate parameters
+	*/
+	if (start < 0) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return NULL;
+	}
+
+	calendar = (RRPCALENDAR*) calloc(1, sizeof(RRPCALENDAR));
+	if (calendar == NULL) {
+		RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
+		return NULL;
+	}
+
+	calendar->firstDay = (long) (start / RRP_CALENDAR_DAY);
+
+	return calendar;
+
+} /* RRPCreateCalendar */
+
+
+
+
+
+
+/*
+**
+** Function: RRPAddCalendarDomain
+**
+** Description: Adds a domain to a calendar. A domain that is already in
+**              the calendar is moved to its new expiration date
+**
+** Input: RRPCALENDAR* - a pointer to an RRPCALENDAR structure
+**        char* - the domain name
+**        time_t - the registration expiration date
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+
+int
+RRPAddCalendarDomain (
+	RRPCALENDAR* calendar,
+	char* name,
+	time_t expiration
+) {
+	RRPCALENDARENTRY* entry = NULL;
+	unsigned long hash = 0;
+
+	/*
+	** Validate parameters
+	*/
+	if (calendar == NULL || name == NULL || expiration < 0) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	hash = hashCalendarName(name);
+	entry = findCalendarEntry(calendar, name, hash);
+
+	if (entry != NULL) {
+		unlinkCalendarEntry(calendar, entry);
+		entry->expiration = expiration;
+		linkCalendarEntry(calendar, entry);
+		return 0;
+	}
+
+	/*
+	** Keep at most one name per bucket of the table on average
+	*/
+	if (calendar->count >= calendar->nameTableSize &&
+		growCalendarNames(calendar) < 0) {
+		return -1;
+	}
+
+	entry = (RRPCALENDARENTRY*) malloc(sizeof(RRPCALENDARENTRY));
+	if (entry == NULL || (entry->name = strdup(name)) == NULL) {
+		free(entry);
+		RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
+		return -1;
+	}
+
+	entry->hash = hash;
+	entry->expiration = expiration;
+	entry->nextName = calendar->names[hash & (calendar->nameTableSize - 1)];
+	calendar->names[hash & (calendar->nameTableSize - 1)] = entry;
+	calendar->count++;
+
+	linkCalendarEntry(calendar, entry);
+
+	return 0;
+
+} /* RRPAddCalendarDomain */
+
+
+
+
+
+
+/*
+**
+** Function: RRPAddCalendarResponse
+**
+** Description: Adds a domain to a calendar under the registration
+**              expiration date of a Status or Renew response (see
+**              RRPGetExpirationDate())
+**
+** Input: RRPCALENDAR* - a pointer to an RRPCALENDAR structure
+**        char* - the domain name
+**        RRPRESPONSE* - the response
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if the
+**               response has no expiration date (RRP_BAD_PARAM_ERROR)
+**               or if an internal error occurs.
+**
+*/
+
+int
+RRPAddCalendarResponse (
+	RRPCALENDAR* calendar,
+	char* name,
+	RRPRESPONSE* response
+) {
+	time_t expiration = (time_t) -1;
+
+	/*
+	** Validate parameters
+	*/
+	if (calendar == NULL || name == NULL || response == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	expiration = RRPGetExpirationDate(response);
+	if (expiration == (time_t) -1) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	return RRPAddCalendarDomain(calendar, name, expiration);
+
+} /* RRPAddCalendarResponse */
+
+
+
+
+
+
+/*
+**
+** Function: RRPRemoveCalendarDomain
+**
+** Description: Removes a domain from a calendar
+**
+** Input: RRPCALENDAR* - a pointer to an RRPCALENDAR structure
+**        char* - the domain name
+**
+** Output: none
+**
+** Return: int - 1 is returned if the domain was removed, 0 if it was
+**               not in the calendar. -1 is returned if an internal
+**               error occurs.
+**
+*/
+
+int
+RRPRemoveCalendarDomain (
+	RRPCALENDAR* calendar,
+	char* name
+) {
+	RRPCALENDARENTRY** link = NULL;
+	RRPCALENDARENTRY* entry = NULL;
+	unsigned long hash = 0;
+
+	/*
+	** Validate parameters
+	*/
+	if (calendar == NULL || name == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	if (calendar->nameTableSize == 0) {
+		return 0;
+	}
+
+	hash = hashCalendarName(name);
+
+	for (link = &calendar->names[hash & (calendar->nameTableSize - 1)];
+		*link != NULL; link = &(*link)->nextName) {
+		entry = *link;
+
+		if (entry->hash == hash && strcmp(entry->name, name) == 0) {
+			*link = entry->nextName;
+			unlinkCalendarEntry(calendar, entry);
+			calendar->count--;
+			free(entry->name);
+			free(entry);
+			return 1;
+		}
+	}
+
+	return 0;
+
+} /* RRPRemoveCalendarDomain */
+
+
+
+
+
+
+/*
+**
+** Function: RRPGetCalendarExpiration
+**
+** Description: Returns the expiration date of a domain of a calendar
+**
+** Input: RRPCALENDAR* - a pointer to an RRPCALENDAR structure
+**        char* - the domain name
+**
+** Output: none
+**
+** Return: time_t - the expiration date. (time_t) -1 is returned if the
+**                  domain is not in the calendar or if an internal
+**                  error occurs.
+**
+*/
+
+time_t
+RRPGetCalendarExpiration (
+	RRPCALENDAR* calendar,
+	char* name
+) {
+	RRPCALENDARENTRY* entry = NULL;
+
+	/*
+	** Validate parameters
+	*/
+	if (calendar == NULL || name == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return (time_t) -1;
+	}
+
+	entry = findCalendarEntry(calendar, name, hashCalendarName(name));
+
+	return (entry != NULL) ? entry->expiration : (time_t) -1;
+
+} /* RRPGetCalendarExpiration */
+
+
+
+
+
+
+/*
+**
+** Function: RRPGetCalendarSize
+**
+** Description: Returns the number of domains of a calendar
+**
+** Input: RRPCALENDAR* - a pointer to an RRPCALENDAR structure
+**
+** Output: none
+**
+** Return: int - the number of domains. -1 is returned if an internal
+**               error occurs.
+**
+*/
+
+int
+RRPGetCalendarSize (
+	RRPCALENDAR* calendar
+) {
+	/*
+	** Validate parameters
+	*/
+	if (calendar == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	return calendar->count;
+
+} /* RRPGetCalendarSize */
+
+
+
+
+
+
+/*
+**
+** Function: RRPRenewCalendarDomains
+**
+** Description: Takes the domains of a calendar that expire at or before
+**              a date, earliest day first, and renews them. The Renew
+**              commands are pipelined over the sessions of a pool and
+**              give the current expiration year of the domain. A domain
+**              renewed is added again under the expiration date of the
+**              response, if it has one; a domain whose Renew command failed (its
+**              session's connection failed, etc.) is added again under
+**              its old date, so that it is due again; a domain whose
+**              renewal was refused is removed from the calendar. The
+**              outcome of each domain taken can be read with
+**              RRPGetCalendarRenewals()
+**
+** Input: RRPCALENDAR* - a pointer to an RRPCALENDAR structure
+**        time_t - the date
+**        int - the renewal period in years, 0 for the server's default
+**        RRPSESSIONPOOL* - a pointer to an RRPSESSIONPOOL structure
+**        int - the most domains to take
+**
+** Output: none
+**
+** Return: int - the number of domains renewed. -1 is returned if an
+**               internal error occurs.
+**
+** Note: If -1 is returned, Renew commands may still be in flight. They
+**       complete at the next call with the same pool, or when the pool
+**       is freed, which must then be done before freeing the calendar
+**
+*/
+
+int
+RRPRenewCalendarDomains (
+	RRPCALENDAR* calendar,
+	time_t until,
+	int period,
+	RRPSESSIONPOOL* pool,
+	int max
+) {
+	RRPRENEWSLOT* slots = NULL;
+	int slotCount = 0;
+	int size = 0;
+	int i = 0;
+
+	/*
+	** Validate parameters
+	*/
+	if (calendar == NULL || until < 0 || period < 0 || pool == NULL ||
+		max < 0) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	/*
+	** Commands left in flight by an earlier error complete first
+	*/
+	if (finishRenewals(calendar, pool) < 0) {
+		return -1;
+	}
+
+	for (i = 0; i < calendar->renewalCount; i++) {
+		free(calendar->renewals[i].name);
+	}
+	calendar->renewalCount = 0;
+
+	if (takeDueCalendarDomains(calendar, until, max) < 0) {
+		return -1;
+	}
+
+	/*
+	** One slot for each request the sessions send before waiting for a
+	** response: more would only wait in the sessions' queues
+	*/
+	size = RRPGetSessionPoolSize(pool);
+	for (i = 0; i < size; i++) {
+		if (RRPIsSessionOpen(RRPGetPoolSession(pool, i))) {
+			slotCount += RRP_DEFAULT_SESSION_WINDOW;
+		}
+	}
+
+	if (slotCount > calendar->renewalCount) {
+		slotCount = calendar->renewalCount;
+	}
+
+	if (slotCount > calendar->slotCount) {
+		slots = (RRPRENEWSLOT*) realloc(calendar->slots,
+			slotCount * sizeof(RRPRENEWSLOT));
+		if (slots == NULL) {
+			slotCount = calendar->slotCount;
+		}
+		else {
+			calendar->slots = slots;
+			calendar->slotCount = slotCount;
+		}
+	}
+
+	calendar->batch.pool = pool;
+	calendar->batch.period = period;
+	calendar->batch.next = 0;
+	calendar->batch.completed = 0;
+	calendar->batch.renewed = 0;
+
+	for (i = 0; i < slotCount; i++) {
+		calendar->slots[i].calendar = calendar;
+		submitRenewal(&calendar->slots[i]);
+	}
+
+	/*
+	** Without a slot (no session is open, or out of memory) every
+	** domain is failed and added again
+	*/
+	if (slotCount == 0) {
+		calendar->batch.next = calendar->renewalCount;
+		for (i = 0; i < calendar->renewalCount; i++) {
+			RRPAddCalendarDomain(calendar, calendar->renewals[i].name,
+				calendar->renewals[i].expiration);
+		}
+		calendar->batch.completed = calendar->renewalCount;
+	}
+
+	if (finishRenewals(calendar, pool) < 0) {
+		return -1;
+	}
+
+	return calendar->batch.renewed;
+
+} /* RRPRenewCalendarDomains */
+
+
+
+
+
+
+/*
+**
+** Function: RRPGetCalendarRenewals
+**
+** Description: Returns the domains taken by the last call to
+**              RRPRenewCalendarDomains(), in the order they were taken
+**
+** Input: RRPCALENDAR* - a pointer to an RRPCALENDAR structure
+**
+** Output: int* - the number of domains
+**
+** Return: RRPCALENDARRENEWAL* - array of renewals, which belongs to the
+**                               RRPCALENDAR structure. NULL is returned
+**                               if an internal error occurs.
+**
+*/
+
+RRPCALENDARRENEWAL*
+RRPGetCalendarRenewals (
+	RRPCALENDAR* calendar,
+	int* count
+) {
+	/*
+	** Validate parameters
+	*/
+	if (calendar == NULL || count == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return NULL;
+	}
+
+	*count = calendar->renewalCount;
+
+	return calendar->renewals;
+
+} /* RRPGetCalendarRenewals */
+
+
+
+
+
+
+/*
+**
+** Function: RRPFreeCalendar
+**
+** Description: Frees all of the memory allocated for an RRPCALENDAR
+**              structure
+**
+** Input: RRPCALENDAR* - a pointer to an RRPCALENDAR structure
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+** Note: If RRPRenewCalendarDomains() failed, the session pool it used
+**       must be freed first, since Renew commands may still be in flight
+**
+*/
+
+int
+RRPFreeCalendar (
+	RRPCALENDAR* calendar
+) {
+	RRPCALENDARENTRY* entry = NULL;
+	RRPCALENDARENTRY* next = NULL;
+	int i = 0;
+
+	/*
+	** Validate parameters
+	*/
+	if (calendar == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	for (i = 0; i < calendar->nameTableSize; i++) {
+		for (entry = calendar->names[i]; entry != NULL; entry = next) {
+			next = entry->nextName;
+			free(entry->name);
+			free(entry);
+		}
+	}
+
+	for (i = 0; i < calendar->renewalCount; i++) {
+		free(calendar->renewals[i].name);
+	}
+
+	free(calendar->names);
+	free(calendar->renewals);
+	free(calendar->slots);
+	free(calendar);
+
+	return 0;
+
+} /* RRPFreeCalendar */
+
+
+
+
+
+
+/*
+** Returns the hash value of a domain name
+*/
+static unsigned long
+hashCalendarName (
+	const char* name
+) {
+	unsigned long hash = 5381;
+
+	while (*name != '\0') {
+		hash = hash * 33 + (unsigned char) *name++;
+	}
+
+	return hash;
+
+} /* hashCalendarName */
+
+
+
+
+
+
+/*
+** Returns the entry of a domain name, or NULL if it is not in the
+** calendar
+*/
+static RRPCALENDARENTRY*
+findCalendarEntry (
+	RRPCALENDAR* calendar,
+	const char* name,
+	unsigned long hash
+) {
+	RRPCALENDARENTRY* entry = NULL;
+
+	if (calendar->nameTableSize == 0) {
+		return NULL;
+	}
+
+	for (entry = calendar->names[hash & (calendar->nameTableSize - 1)];
+		entry != NULL; entry = entry->nextName) {
+		if (entry->hash == hash && strcmp(entry->name, name) == 0) {
+			return entry;
+		}
+	}
+
+	return NULL;
+
+} /* findCalendarEntry */
+
+
+
+
+
+
+/*
+** Links an entry at the end of the bucket of its expiration day. A
+** domain that expires before the first day not taken is due on that day
+*/
+static void
+linkCalendarEntry (
+	RRPCALENDAR* calendar,
+	RRPCALENDARENTRY* entry
+) {
+	RRPCALENDARENTRY** bucket = NULL;
+	long day = (long) (entry->expiration / RRP_CALENDAR_DAY);
+
+	if (day < calendar->firstDay) {
+		day = calendar->firstDay;
+	}
+
+	bucket = &calendar->days[day % RRP_CALENDAR_DAYS];
+
+	/*
+	** The first entry's 'previous' points to the last one
+	*/
+	entry->next = NULL;
+
+	if (*bucket == NULL) {
+		entry->previous = entry;
+		*bucket = entry;
+	}
+	else {
+		entry->previous = (*bucket)->previous;
+		(*bucket)->previous->next = entry;
+		(*bucket)->previous = entry;
+	}
+
+} /* linkCalendarEntry */
+
+
+
+
+
+
+/*
+** Unlinks an entry from the bucket that holds it
+*/
+static void
+unlinkCalendarEntry (
+	RRPCALENDAR* calendar,
+	RRPCALENDARENTRY* entry
+) {
+	RRPCALENDARENTRY** bucket = NULL;
+	long day = (long) (entry->expiration / RRP_CALENDAR_DAY);
+
+	if (day < calendar->firstDay) {
+		day = calendar->firstDay;
+	}
+
+	bucket = &calendar->days[day % RRP_CALENDAR_DAYS];
+
+	if (*bucket == entry) {
+		*bucket = entry->next;
+		if (entry->next != NULL) {
+			entry->next->previous = entry->previous;
+		}
+	}
+	else {
+		entry->previous->next = entry->next;
+		if (entry->next != NULL) {
+			entry->next->previous = entry->previous;
+		}
+		else {
+			(*bucket)->previous = entry->previous;
+		}
+	}
+
+} /* unlinkCalendarEntry */
+
+
+
+
+
+
+/*
+** Doubles the table of names. Returns 0 if successful, -1 and sets the
+** error code otherwise.
+*/
+static int
+growCalendarNames (
+	RRPCALENDAR* calendar
+) {
+	RRPCALENDARENTRY** names = NULL;
+	RRPCALENDARENTRY* entry = NULL;
+	RRPCALENDARENTRY* next = NULL;
+	int size = calendar->nameTableSize > 0 ?
+		calendar->nameTableSize * 2 : 1024;
+	int i = 0;
+
+	names = (RRPCALENDARENTRY**) calloc(size, sizeof(RRPCALENDARENTRY*));
+	if (names == NULL) {
+		RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
+		return -1;
+	}
+
+	for (i = 0; i < calendar->nameTableSize; i++) {
+		for (entry = calendar->names[i]; entry != NULL; entry = next) {
+			next = entry->nextName;
+			entry->nextName = names[entry->hash & (size - 1)];
+			names[entry->hash & (size - 1)] = entry;
+		}
+	}
+
+	free(calendar->names);
+	calendar->names = names;
+	calendar->nameTableSize = size;
+
+	return 0;
+
+} /* growCalendarNames */
+
+
+
+
+
+
+/*
+** Moves up to 'max' domains that expire at or before 'until' from the
+** calendar to the renewals. Only the buckets of the days from the first
+** day not taken to the day of 'until' are visited, and the first day not
+** taken is moved past the days emptied of their due domains. Returns 0
+** if successful, -1 and sets the error code otherwise.
+*/
+static int
+takeDueCalendarDomains (
+	RRPCALENDAR* calendar,
+	time_t until,
+	int max
+) {
+	RRPCALENDARRENEWAL* renewals = NULL;
+	RRPCALENDARRENEWAL* renewal = NULL;
+	RRPCALENDARENTRY* entry = NULL;
+	RRPCALENDARENTRY* next = NULL;
+	long lastDay = (long) (until / RRP_CALENDAR_DAY);
+	long day = 0;
+	int capacity = 0;
+
+	for (day = calendar->firstDay; day <= lastDay; day++) {
+		for (entry = calendar->days[day % RRP_CALENDAR_DAYS]; entry != NULL;
+			entry = next) {
+			next = entry->next;
+
+			/*
+			** Later days that share the bucket, and the rest of the last
+			** day, are not due
+			*/
+			if (entry->expiration > until) {
+				continue;
+			}
+
+			if (calendar->renewalCount == max) {
+				return 0;
+			}
+
+			if (calendar->renewalCount == calendar->renewalCapacity) {
+				capacity = calendar->renewalCapacity > 0 ?
+					calendar->renewalCapacity * 2 : 256;
+				renewals = (RRPCALENDARRENEWAL*) realloc(calendar->renewals,
+					capacity * sizeof(RRPCALENDARRENEWAL));
+				if (renewals == NULL) {
+					RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
+					return -1;
+				}
+				calendar->renewals = renewals;
+				calendar->renewalCapacity = capacity;
+			}
+
+			renewal = &calendar->renewals[calendar->renewalCount++];
+			renewal->name = strdup(entry->name);
+			renewal->expiration = entry->expiration;
+			renewal->renewedExpiration = (time_t) -1;
+			renewal->code = -1;
+
+			if (renewal->name == NULL) {
+				calendar->renewalCount--;
+				RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
+				return -1;
+			}
+
+			RRPRemoveCalendarDomain(calendar, entry->name);
+		}
+
+		if (day < lastDay) {
+			calendar->firstDay = day + 1;
+		}
+	}
+
+	return 0;
+
+} /* takeDueCalendarDomains */
+
+
+
+
+
+
+/*
+** Submits the Renew command of the next domain of the batch in a slot.
+** Domains whose request can not be created or submitted are failed and
+** added again, and the slot is left unused once all of the domains have
+** been submitted.
+*/
+static void
+submitRenewal (
+	RRPRENEWSLOT* slot
+) {
+	RRPCALENDAR* calendar = slot->calendar;
+	RRPRENEWBATCH* batch = &calendar->batch;
+	RRPCALENDARRENEWAL* renewal = NULL;
+	RRPREQUEST* request = NULL;
+	struct tm* date = NULL;
+	char number[12];
+	int result = 0;
+
+	while (batch->pool != NULL && batch->next < calendar->renewalCount) {
+		slot->index = batch->next++;
+		renewal = &calendar->renewals[slot->index];
+
+		request = RRPCreateRequest(RRP_RENEW_COMMAND, RRP_DOMAIN_ENTITY,
+			renewal->name, strlen(renewal->name));
+		result = (request != NULL) ? 0 : -1;
+
+		if (result == 0 && batch->period > 0) {
+			sprintf(number, "%d", batch->period);
+			result = RRPAppendRequestAttribute(request, "-Period", 7,
+				number, strlen(number));
+		}
+
+		/*
+		** The current expiration year makes the server refuse a second
+		** renewal of the same year
+		*/
+		if (result == 0) {
+			date = gmtime(&renewal->expiration);
+			result = (date != NULL) ? 0 : -1;
+		}
+
+		if (result == 0) {
+			sprintf(number, "%d", date->tm_year + 1900);
+			result = RRPAppendRequestAttribute(request,
+				"-CurrentExpirationYear", 22, number, strlen(number));
+		}
+
+		if (result == 0 && RRPSubmitPoolRequest(batch->pool, request,
+			completeRenewal, slot) == 0) {
+			return;
+		}
+
+		if (request != NULL) {
+			RRPFreeRequest(request);
+		}
+
+		RRPAddCalendarDomain(calendar, renewal->name, renewal->expiration);
+		batch->completed++;
+	}
+
+} /* submitRenewal */
+
+
+
+
+
+
+/*
+** Completion function of the Renew commands of RRPRenewCalendarDomains().
+** Records the outcome and indexes the domain again, then reuses the slot
+** for the next domain.
+*/
+static void
+completeRenewal (
+	RRPREQUEST* request,
+	RRPRESPONSE* response,
+	void* context
+) {
+	RRPRENEWSLOT* slot = (RRPRENEWSLOT*) context;
+	RRPCALENDAR* calendar = slot->calendar;
+	RRPCALENDARRENEWAL* renewal = &calendar->renewals[slot->index];
+
+	if (response == NULL) {
+		RRPAddCalendarDomain(calendar, renewal->name, renewal->expiration);
+	}
+	else {
+		renewal->code = response->code;
+
+		if (response->code / 100 == 2) {
+			renewal->renewedExpiration = RRPGetExpirationDate(response);
+			if (renewal->renewedExpiration != (time_t) -1) {
+				RRPAddCalendarDomain(calendar, renewal->name,
+					renewal->renewedExpiration);
+			}
+			calendar->batch.renewed++;
+		}
+
+		RRPFreeResponse(response);
+	}
+
+	calendar->batch.completed++;
+
+	submitRenewal(slot);
+
+} /* completeRenewal */
+
+
+
+
+
+
+/*
+** Runs a session pool until every Renew command of the batch has
+** completed. Returns 0 if successful. Returns -1 and sets error code if
+** the pool fails; the domains not submitted yet are then failed, and
+** the commands in flight complete when the pool is run again or freed.
+*/
+static int
+finishRenewals (
+	RRPCALENDAR* calendar,
+	RRPSESSIONPOOL* pool
+) {
+	RRPRENEWBATCH* batch = &calendar->batch;
+	int i = 0;
+
+	while (batch->completed < calendar->renewalCount) {
+		if (RRPPollSessionPool(pool, -1) < 0) {
+			for (i = batch->next; i < calendar->renewalCount; i++) {
+				RRPAddCalendarDomain(calendar, calendar->renewals[i].name,
+					calendar->renewals[i].expiration);
+				batch->completed++;
+			}
+			batch->next = calendar->renewalCount;
+			batch->pool = NULL;
+			return -1;
+		}
+	}
+
+	return 0;
+
+} /* finishRenewals */
@@ -0,0 +1,2008 @@
+/* ===========================================================================
+ * Copyright (C) 2000 VeriSign, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * VeriSign Global Registry Service
+ * 21345 Ridgetop Circle
+ * Dulles, VA 20166
+ * ===========================================================================
+ * The RRP, APIs and Software are provided "as-is" and without any warranty
+ * of any kind.  NSI EXPRESSLY DISCLAIMS ALL WARRANTIES AND/OR CONDITIONS,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * AND CONDITIONS OF MERCHANTABILITY OR SATISFACTORY QUALITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE AND NONINFRINGEMENT OF THIRD PARTY RIGHTS.  NSI DOES
+ * NOT WARRANT THAT THE FUNCTIONS CONTAINED IN THE RRP, APIs OR SOFTWARE
+ * WILL MEET REGISTRAR'S REQUIREMENTS, OR THAT THE OPERATION OF THE RRP,
+ * APIs OR SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE,OR THAT DEFECTS IN
+ * THE RRP, APIs OR SOFTWARE WILL BE CORRECTED.  FURTHERMORE, NSI DOES NOT
+ * WARRANT NOR MAKE ANY REPRESENTATIONS REGARDING THE USE OR THE RESULTS OF
+ * THE RRP, APIs, SOFTWARE OR RELATED DOCUMENTATION IN TERMS OF THEIR
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR OTHERWISE.  SHOULD THE RRP, APIs
+ * OR SOFTWARE PROVE DEFECTIVE, REGISTRAR ASSUMES THE ENTIRE COST OF ALL
+ * NECESSARY SERVICING, REPAIR OR CORRECTION.
+ * ======================================================================== */
+
+/*
+**
+** Module Name: rrpClient.c
+**
+** Version: 2.1 for RRP version 2.1.0
+**
+** Date: Oct. 19th, 2026
+**
+** Description: rrpClient lets any number of threads share the sessions
+**              of a session pool, and coalesces identical Check and
+**              Status requests (see rrpClient.h).
+**
+**              Threads add their requests to the client's queue under
+**              the client's mutex, and write a byte to a pipe when the
+**              queue was empty. The client's thread polls the pipe along
+**              with the sessions' connections, takes the whole queue at
+**              once, and gives the requests to the pool. A coalesced
+**              request is kept in a table of the requests in flight,
+**              keyed on the text of the request, until its response
+**              arrives.
+**
+**              The thread then files each request under its priority
+**              class, and sends the oldest request of the highest class
+**              that is under its limit to the open session, among those
+**              the class may use, with the fewest requests outstanding,
+**              as long as that session has room in its window. Requests
+**              thus wait in the client, where a more urgent request can
+**              overtake them, rather than in a session's queue. A
+**              session held back by its governor takes no more requests
+**              until the governor lets it send.
+**              Latencies are counted in a histogram per class with four
+**              buckets per power of two.
+**
+**              With a response cache, lookups happen in the submitting
+**              thread. A hit still goes through the queue when the
+**              caller gave a completion function, so that the function
+**              runs on the client's thread as for any other response.
+**
+**              A request to be retried gets a copy of its text, since
+**              the session frees the original, and waits in a list
+**              sorted by the time it is due; the client's thread wakes
+**              up in time for the first one and puts the due requests
+**              back at the front of their classes.
+**
+** Entry Points:
+**
+**    RRPCreateClient(RRPSESSIONPOOL*);
+**    RRPSubmitClientRequest(RRPCLIENT*, RRPREQUEST*, RRPCOMPLETION,
+**        void*);
+**    RRPSubmitClientClassRequest(RRPCLIENT*, RRPCLIENTCLASS, RRPREQUEST*,
+**        RRPCOMPLETION, void*);
+**    RRPClientRequest(RRPCLIENT*, RRPREQUEST*);
+**    RRPClientClassRequest(RRPCLIENT*, RRPCLIENTCLASS, RRPREQUEST*);
+**    RRPClientCheckDomain(RRPCLIENT*, char*);
+**    RRPClientCheckNameServer(RRPCLIENT*, char*);
+**    RRPClientStatusDomain(RRPCLIENT*, char*);
+**    RRPClientStatusNameServer(RRPCLIENT*, char*);
+**    RRPSetClientCoalescing(RRPCLIENT*, RRPBOOLEAN);
+**    RRPSetClientCache(RRPCLIENT*, RRPCACHE*);
+**    RRPSetClientRetryPolicy(RRPCLIENT*, RRPRETRYPOLICY*);
+**    RRPSetClientClassLimits(RRPCLIENT*, RRPCLIENTCLASS, int, int);
+**    RRPGetClientStatistics(RRPCLIENT*, RRPCLIENTSTATISTICS*);
+**    RRPGetClientClassStatistics(RRPCLIENT*, RRPCLIENTCLASS,
+**        RRPCLIENTCLASSSTATISTICS*);
+**    RRPFreeClient(RRPCLIENT*);
+**
+** Changes:
+**
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "rrpClient.h"
+#include "rrpInternalError.h"
+
+/*
+** Number of buckets of the table of coalesced requests in flight
+*/
+#ifndef RRP_CLIENT_BUCKETS
+	#define RRP_CLIENT_BUCKETS 1024
+#endif
+
+/*
+** Number of buckets of the latency histograms. The last bucket holds
+** the latencies of 2^32 microseconds (over an hour) and more
+*/
+#define RRP_LATENCY_BUCKETS 128
+
+/*
+** A request submitted to a client
+*/
+typedef struct _RRPCLIENTCALL  RRPCLIENTCALL;
+
+struct _RRPCLIENTCALL {
+	RRPCLIENT* client;
+	RRPREQUEST* request;
+	RRPCOMPLETION completion;
+	void* context;
+	RRPCLIENTCLASS priority;
+	struct timespec submitted;
+	unsigned long hash;         /* hash of the request text */
+	RRPBOOLEAN leader;          /* in the table of coalesced requests */
+	RRPBOOLEAN sent;            /* given to a session */
+	RRPRESPONSE* response;      /* response found in the cache */
+	unsigned long version;      /* cache version (see rrpCache.h) */
+	RRPRETRYSTATE retry;        /* progress of its retries */
+	struct timespec due;        /* when to send it again */
+	RRPCLIENTCALL* next;        /* next call in a queue, or next
+	                               follower */
+	RRPCLIENTCALL* nextLeader;  /* next call in the same bucket */
+	RRPCLIENTCALL* followers;   /* identical requests attached to it */
+};
+
+/*
+** A thread waiting in RRPClientRequest()
+*/
+typedef struct {
+	RRPCLIENT* client;
+	pthread_cond_t condition;
+	RRPBOOLEAN done;
+	RRPRESPONSE* response;
+	RRPINTERNAL_ERROR_CODE error;
+} RRPCLIENTWAIT;
+
+/*
+** Limits and counts of a priority class
+*/
+typedef struct {
+	int limit;                  /* requests sent at once, 0 for no limit */
+	int reserved;               /* sessions reserved for the class */
+	unsigned long submitted;
+	unsigned long completed;
+	int queued;
+	int active;
+	unsigned long maximum;
+	unsigned long latencies[RRP_LATENCY_BUCKETS];
+} RRPCLIENTCLASSSTATE;
+
+struct _RRPCLIENT {
+	RRPSESSIONPOOL* pool;
+	pthread_t thread;
+	pthread_mutex_t mutex;
+	int wake[2];                /* pipe that wakes the client's thread */
+	RRPCACHE* cache;            /* set before any request is submitted */
+	RRPRETRYPOLICY* retry;      /* likewise */
+
+	/*
+	** Shared with the other threads, under 'mutex'
+	*/
+	RRPCLIENTCALL* queueHead;
+	RRPCLIENTCALL* queueTail;
+	RRPBOOLEAN stopping;
+	RRPBOOLEAN coalescing;
+	RRPCLIENTSTATISTICS statistics;
+	RRPCLIENTCLASSSTATE classes[RRP_CLIENT_CLASSES];
+
+	/*
+	** Used by the client's thread only. The counts are added to
+	** 'statistics' and 'classes' each time the thread takes the queue,
+	** and the limits are copied from 'classes'
+	*/
+	RRPCLIENTCALL* flights[RRP_CLIENT_BUCKETS];
+	RRPCLIENTCALL* classHeads[RRP_CLIENT_CLASSES];
+	RRPCLIENTCALL* classTails[RRP_CLIENT_CLASSES];
+	RRPCLIENTCALL* retries;     /* calls to send again, soonest first */
+	int* reservations;          /* class of each session, or -1 */
+	struct pollfd* descriptors;
+	RRPCLIENTSTATISTICS counts;
+	RRPCLIENTCLASSSTATE classCounts[RRP_CLIENT_CLASSES];
+};
+
+
+/*
+** Functions used internally by the client's thread
+*/
+static void* runClient (void*);
+static void takeClientQueue (RRPCLIENT*, RRPCLIENTCALL**, RRPBOOLEAN*,
+	RRPBOOLEAN*);
+static void pollClient (RRPCLIENT*);
+static void dispatchClientCall (RRPCLIENT*, RRPCLIENTCALL*, RRPBOOLEAN);
+static void scheduleClient (RRPCLIENT*);
+static void requeueClientCalls (RRPCLIENT*);
+static RRPSESSION* pickClientSession (RRPCLIENT*, RRPCLIENTCLASS,
+	RRPBOOLEAN*);
+static void sendClientCall (RRPCLIENT*, RRPCLIENTCALL*, RRPSESSION*);
+static void failClientCall (RRPCLIENTCALL*, RRPINTERNAL_ERROR_CODE);
+static void completeClientCall (RRPREQUEST*, RRPRESPONSE*, void*);
+static void finishClientCall (RRPCLIENTCALL*, RRPRESPONSE*,
+	RRPINTERNAL_ERROR_CODE);
+static RRPBOOLEAN retryClientCall (RRPCLIENT*, RRPCLIENTCALL*,
+	RRPRESPONSE*, RRPINTERNAL_ERROR_CODE);
+static RRPREQUEST* copyClientRequest (RRPREQUEST*);
+static unsigned long hashClientRequest (RRPREQUEST*);
+static int getLatencyBucket (unsigned long);
+static unsigned long getLatencyPercentile (RRPCLIENTCLASSSTATE*, int);
+
+/*
+** Functions used internally by the other threads
+*/
+static int queueClientCall (RRPCLIENT*, RRPCLIENTCLASS, RRPREQUEST*,
+	RRPCOMPLETION, void*, RRPRESPONSE*, unsigned long);
+static void wakeClientCaller (RRPREQUEST*, RRPRESPONSE*, void*);
+static RRPRESPONSE* clientEntityRequest (RRPCLIENT*, RRPCOMMAND, RRPENTITY,
+	char*);
+
+
+
+
+/*
+**
+** Function: RRPCreateClient
+**
+** Description: Creates a client for a session pool and starts the
+**              client's thread
+**
+** Input: RRPSESSIONPOOL* - the pool (see RRPCreateSessionPool()). The
+**                          client takes ownership of the pool if
+**                          successful
+**
+** Output: none
+**
+** Return: RRPCLIENT* - a pointer to an RRPCLIENT structure. NULL is
+**                      returned if an internal error occurs.
+**
+** Note: THE CLIENT MUST BE RELEASED BY CALLING RRPFreeClient()
+**
+*/
+
+RRPCLIENT*
+RRPCreateClient (
+	RRPSESSIONPOOL* pool
+) {
+	RRPCLIENT* client = NULL;
+	int size = 0;
+	int i = 0;
+
+	/*
+	** Validate parameters
+	*/
+	if (pool == NULL || (size = RRPGetSessionPoolSize(pool)) < 1) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return NULL;
+	}
+
+	client = (RRPCLIENT*) calloc(1, sizeof(RRPCLIENT));
+	if (client == NULL) {
+		RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
+		return NULL;
+	}
+
+	/*
+	** One descriptor for the pipe, then one for each session
+	*/
+	client->descriptors = (struct pollfd*) calloc(size + 1,
+		sizeof(struct pollfd));
+	client->reservations = (int*) malloc(size * sizeof(int));
+	if (client->descriptors == NULL || client->reservations == NULL) {
+		free(client->descriptors);
+		free(client->reservations);
+		free(client);
+		RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
+		return NULL;
+	}
+
+	for (i = 0; i < size; i++) {
+		client->reservations[i] = -1;
+	}
+
+	if (pipe(client->wake) < 0) {
+		free(client->descriptors);
+		free(client->reservations);
+		free(client);
+		RRPSetInternalErrorCode(RRP_IO_ERROR);
+		return NULL;
+	}
+
+	/*
+	** Neither end may block: a full pipe already wakes the thread, and
+	** the thread empties the pipe without knowing how much it holds
+	*/
+	fcntl(client->wake[0], F_SETFL, fcntl(client->wake[0], F_GETFL) |
+		O_NONBLOCK);
+	fcntl(client->wake[1], F_SETFL, fcntl(client->wake[1], F_GETFL) |
+		O_NONBLOCK);
+
+	client->pool = pool;
+	client->coalescing = RRPTRUE;
+	pthread_mutex_init(&client->mutex, NULL);
+
+	if (pthread_create(&client->thread, NULL, runClient, client) != 0) {
+		pthread_mutex_destroy(&client->mutex);
+		close(client->wake[0]);
+		close(client->wake[1]);
+		free(client->descriptors);
+		free(client->reservations);
+		free(client);
+		RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
+		return NULL;
+	}
+
+	return client;
+
+} /* RRPCreateClient */
+
+
+
+
+
+
+/*
+**
+** Function: RRPSubmitClientRequest
+**
+** Description: Submits a request of RRP_NORMAL_CLASS to a client (see
+**              RRPSubmitClientClassRequest())
+**
+** Input: RRPCLIENT* - a pointer to an RRPCLIENT structure
+**        RRPREQUEST* - the request. The client takes ownership of the
+**                      request if successful
+**        RRPCOMPLETION - function called with the response
+**        void* - context pointer passed to the completion function
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs or if the client is being freed
+**               (RRP_NOT_CONNECTED_ERROR). The request then still
+**               belongs to the caller
+**
+*/
+
+int
+RRPSubmitClientRequest (
+	RRPCLIENT* client,
+	RRPREQUEST* request,
+	RRPCOMPLETION completion,
+	void* context
+) {
+	return RRPSubmitClientClassRequest(client, RRP_NORMAL_CLASS, request,
+		completion, context);
+
+} /* RRPSubmitClientRequest */
+
+
+
+
+
+
+/*
+**
+** Function: RRPSubmitClientClassRequest
+**
+** Description: Submits a request of a priority class to a client. The
+**              completion function is called from the client's thread
+**              when the response arrives (see RRPCOMPLETION in
+**              rrpSession.h)
+**
+** Input: RRPCLIENT* - a pointer to an RRPCLIENT structure
+**        RRPCLIENTCLASS - the request's class
+**        RRPREQUEST* - the request. The client takes ownership of the
+**                      request if successful
+**        RRPCOMPLETION - function called with the response
+**        void* - context pointer passed to the completion function
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs or if the client is being freed
+**               (RRP_NOT_CONNECTED_ERROR). The request then still
+**               belongs to the caller
+**
+*/
+
+int
+RRPSubmitClientClassRequest (
+	RRPCLIENT* client,
+	RRPCLIENTCLASS priority,
+	RRPREQUEST* request,
+	RRPCOMPLETION completion,
+	void* context
+) {
+	RRPRESPONSE* response = NULL;
+	unsigned long version = 0;
+
+	/*
+	** Validate parameters
+	*/
+	if (client == NULL || (int) priority < 0 ||
+		priority >= RRP_CLIENT_CLASSES || request == NULL ||
+		completion == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	if (client->cache != NULL) {
+		response = RRPGetCachedResponse(client->cache, request, &version);
+	}
+
+	if (queueClientCall(client, priority, request, completion, context,
+		response, version) < 0) {
+		if (response != NULL) {
+			RRPFreeResponse(response);
+		}
+		return -1;
+	}
+
+	return 0;
+
+} /* RRPSubmitClientClassRequest */
+
+
+
+
+
+
+/*
+**
+** Function: RRPClientRequest
+**
+** Description: Submits a request of RRP_NORMAL_CLASS to a client and
+**              waits for its response (see RRPClientClassRequest())
+**
+** Input: RRPCLIENT* - a pointer to an RRPCLIENT structure
+**        RRPREQUEST* - the request, which is released in all cases
+**
+** Output: none
+**
+** Return: RRPRESPONSE* - a pointer to an RRPRESPONSE structure. NULL is
+**                        returned if an internal error occurs.
+**
+** Note: THE MEMORY ALLOCATED FOR THE RRPRESPONSE STRUCTURE MUST BE
+**       RELEASED BY CALLING THE RRPFreeResponse() FUNCTION
+**
+*/
+
+RRPRESPONSE*
+RRPClientRequest (
+	RRPCLIENT* client,
+	RRPREQUEST* request
+) {
+	return RRPClientClassRequest(client, RRP_NORMAL_CLASS, request);
+
+} /* RRPClientRequest */
+
+
+
+
+
+
+/*
+**
+** Function: RRPClientClassRequest
+**
+** Description: Submits a request of a priority class to a client and
+**              waits for its response
+**
+** Input: RRPCLIENT* - a pointer to an RRPCLIENT structure
+**        RRPCLIENTCLASS - the request's class
+**        RRPREQUEST* - the request, which is released in all cases
+**
+** Output: none
+**
+** Return: RRPRESPONSE* - a pointer to an RRPRESPONSE structure containing
+**                        the components of the RRP response returned from
+**                        the server. NULL is returned if an internal
+**                        error occurs, or if the request failed (its
+**                        session's connection failed, etc.)
+**
+** Note: THE MEMORY ALLOCATED FOR THE RRPRESPONSE STRUCTURE MUST BE
+**       RELEASED BY CALLING THE RRPFreeResponse() FUNCTION
+**
+*/
+
+RRPRESPONSE*
+RRPClientClassRequest (
+	RRPCLIENT* client,
+	RRPCLIENTCLASS priority,
+	RRPREQUEST* request
+) {
+	RRPCLIENTWAIT wait;
+	RRPRESPONSE* response = NULL;
+	unsigned long version = 0;
+
+	/*
+	** Validate parameters. The client's own thread would wait for
+	** itself
+	*/
+	if (client == NULL || (int) priority < 0 ||
+		priority >= RRP_CLIENT_CLASSES || request == NULL ||
+		pthread_equal(pthread_self(), client->thread)) {
+		if (request != NULL) {
+			RRPFreeRequest(request);
+		}
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return NULL;
+	}
+
+	if (client->cache != NULL) {
+		response = RRPGetCachedResponse(client->cache, request, &version);
+		if (response != NULL) {
+			RRPFreeRequest(request);
+			return response;
+		}
+	}
+
+	wait.client = client;
+	wait.done = RRPFALSE;
+	wait.response = NULL;
+	wait.error = RRP_NO_ERROR;
+	pthread_cond_init(&wait.condition, NULL);
+
+	if (queueClientCall(client, priority, request, wakeClientCaller, &wait,
+		NULL, version) < 0) {
+		pthread_cond_destroy(&wait.condition);
+		RRPFreeRequest(request);
+		return NULL;
+	}
+
+	pthread_mutex_lock(&client->mutex);
+	while (!wait.done) {
+		pthread_cond_wait(&wait.condition, &client->mutex);
+	}
+	pthread_mutex_unlock(&client->mutex);
+
+	pthread_cond_destroy(&wait.condition);
+
+	if (wait.response == NULL) {
+		RRPSetInternalErrorCode(wait.error);
+	}
+
+	return wait.response;
+
+} /* RRPClientClassRequest */
+
+
+
+
+
+
+/*
+**
+** Function: RRPClientCheckDomain
+**
+** Description: Checks the availability of a domain name through a
+**              client, in RRP_INTERACTIVE_CLASS (see RRPCheckDomain() and
+**              RRPClientClassRequest())
+**
+** Input: RRPCLIENT* - a pointer to an RRPCLIENT structure
+**        char* - a fully qualified domain name
+**
+** Output: none
+**
+** Return: RRPRESPONSE* - a pointer to an RRPRESPONSE structure. NULL is
+**                        returned if an internal error occurs.
+**
+** Note: THE MEMORY ALLOCATED FOR THE RRPRESPONSE STRUCTURE MUST BE
+**       RELEASED BY CALLING THE RRPFreeResponse() FUNCTION
+**
+*/
+
+RRPRESPONSE*
+RRPClientCheckDomain (
+	RRPCLIENT* client,
+	char* domainName
+) {
+	return clientEntityRequest(client, RRP_CHECK_COMMAND, RRP_DOMAIN_ENTITY,
+		domainName);
+
+} /* RRPClientCheckDomain */
+
+
+
+
+
+
+/*
+**
+** Function: RRPClientCheckNameServer
+**
+** Description: Checks a name server through a client, in
+**              RRP_INTERACTIVE_CLASS (see RRPCheckNameServer() and
+**              RRPClientClassRequest())
+**
+** Input: RRPCLIENT* - a pointer to an RRPCLIENT structure
+**        char* - the name server's host name
+**
+** Output: none
+**
+** Return: RRPRESPONSE* - a pointer to an RRPRESPONSE structure. NULL is
+**                        returned if an internal error occurs.
+**
+** Note: THE MEMORY ALLOCATED FOR THE RRPRESPONSE STRUCTURE MUST BE
+**       RELEASED BY CALLING THE RRPFreeResponse() FUNCTION
+**
+*/
+
+RRPRESPONSE*
+RRPClientCheckNameServer (
+	RRPCLIENT* client,
+	char* nameServer
+) {
+	return clientEntityRequest(client, RRP_CHECK_COMMAND,
+		RRP_NAMESERVER_ENTITY, nameServer);
+
+} /* RRPClientCheckNameServer */
+
+
+
+
+
+
+/*
+**
+** Function: RRPClientStatusDomain
+**
+** Description: Gets the status of a domain through a client, in
+**              RRP_INTERACTIVE_CLASS (see RRPStatusDomain() and
+**              RRPClientClassRequest())
+**
+** Input: RRPCLIENT* - a pointer to an RRPCLIENT structure
+**        char* - a fully qualified domain name
+**
+** Output: none
+**
+** Return: RRPRESPONSE* - a pointer to an RRPRESPONSE structure. NULL is
+**                        returned if an internal error occurs.
+**
+** Note: THE MEMORY ALLOCATED FOR THE RRPRESPONSE STRUCTURE MUST BE
+**       RELEASED BY CALLING THE RRPFreeResponse() FUNCTION
+**
+*/
+
+RRPRESPONSE*
+RRPClientStatusDomain (
+	RRPCLIENT* client,
+	char* domainName
+) {
+	return clientEntityRequest(client, RRP_STATUS_COMMAND, RRP_DOMAIN_ENTITY,
+		domainName);
+
+} /* RRPClientStatusDomain */
+
+
+
+
+
+
+/*
+**
+** Function: RRPClientStatusNameServer
+**
+** Description: Gets the status of a name server through a client, in
+**              RRP_INTERACTIVE_CLASS (see RRPStatusNameServer() and
+**              RRPClientClassRequest())
+**
+** Input: RRPCLIENT* - a pointer to an RRPCLIENT structure
+**        char* - the name server's host name
+**
+** Output: none
+**
+** Return: RRPRESPONSE* - a pointer to an RRPRESPONSE structure. NULL is
+**                        returned if an internal error occurs.
+**
+** Note: THE MEMORY ALLOCATED FOR THE RRPRESPONSE STRUCTURE MUST BE
+**       RELEASED BY CALLING THE RRPFreeResponse() FUNCTION
+**
+*/
+
+RRPRESPONSE*
+RRPClientStatusNameServer (
+	RRPCLIENT* client,
+	char* nameServer
+) {
+	return clientEntityRequest(client, RRP_STATUS_COMMAND,
+		RRP_NAMESERVER_ENTITY, nameServer);
+
+} /* RRPClientStatusNameServer */
+
+
+
+
+
+
+/*
+**
+** Function: RRPSetClientCoalescing
+**
+** Description: Turns the coalescing of identical Check and Status
+**              requests on or off (on by default). Requests already in
+**              flight are not affected
+**
+** Input: RRPCLIENT* - a pointer to an RRPCLIENT structure
+**        RRPBOOLEAN - RRPTRUE to coalesce requests
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+
+int
+RRPSetClientCoalescing (
+	RRPCLIENT* client,
+	RRPBOOLEAN coalescing
+) {
+	/*
+	** Validate parameters
+	*/
+	if (client == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	pthread_mutex_lock(&client->mutex);
+	client->coalescing = coalescing ? RRPTRUE : RRPFALSE;
+	pthread_mutex_unlock(&client->mutex);
+
+	return 0;
+
+} /* RRPSetClientCoalescing */
+
+
+
+
+
+
+/*
+**
+** Function: RRPSetClientCache
+**
+** Description: Gives a response cache to a client. A Check or Status
+**              request found in the cache is completed with a copy of the
+**              cached response without being sent; the completion
+**              function of RRPSubmitClientRequest() is still called from
+**              the client's thread
+**
+** Input: RRPCLIENT* - a pointer to an RRPCLIENT structure
+**        RRPCACHE* - the cache (see RRPCreateCache()), or NULL. The cache
+**                    still belongs to the caller, may be shared by
+**                    several clients and must outlive the client
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+** Note: The cache must be set before any request is submitted
+**
+*/
+
+int
+RRPSetClientCache (
+	RRPCLIENT* client,
+	RRPCACHE* cache
+) {
+	/*
+	** Validate parameters
+	*/
+	if (client == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	/*
+	** The queue's mutex publishes the pointer to the client's thread
+	*/
+	pthread_mutex_lock(&client->mutex);
+	client->cache = cache;
+	pthread_mutex_unlock(&client->mutex);
+
+	return 0;
+
+} /* RRPSetClientCache */
+
+
+
+
+
+
+/*
+**
+** Function: RRPSetClientRetryPolicy
+**
+** Description: Gives a retry policy to a client (see rrpRetry.h). A
+**              request that fails as the policy allows is sent again
+**              after the policy's delay, possibly on another session;
+**              its completion function is only called with the last
+**              outcome. The requests attached to it wait for that
+**              outcome as well
+**
+** Input: RRPCLIENT* - a pointer to an RRPCLIENT structure
+**        RRPRETRYPOLICY* - the policy (see RRPCreateRetryPolicy()), or
+**                          NULL to never retry (the default). The
+**                          policy still belongs to the caller and must
+**                          outlive the client
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+** Note: The policy must be set before any request is submitted
+**
+*/
+
+int
+RRPSetClientRetryPolicy (
+	RRPCLIENT* client,
+	RRPRETRYPOLICY* policy
+) {
+	/*
+	** Validate parameters
+	*/
+	if (client == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	pthread_mutex_lock(&client->mutex);
+	client->retry = policy;
+	pthread_mutex_unlock(&client->mutex);
+
+	return 0;
+
+} /* RRPSetClientRetryPolicy */
+
+
+
+
+
+
+/*
+**
+** Function: RRPSetClientClassLimits
+**
+** Description: Limits the requests of a priority class. Sessions are
+**              reserved from the first session of the pool on, in the
+**              order of the classes: a session reserved for a class is
+**              only used by that class and the classes above it
+**
+** Input: RRPCLIENT* - a pointer to an RRPCLIENT structure
+**        RRPCLIENTCLASS - the class
+**        int - the most requests of the class sent at once, or 0 for no
+**              limit (the default)
+**        int - number of sessions reserved for the class (0 by default).
+**              At least one session of the pool must be left unreserved
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+
+int
+RRPSetClientClassLimits (
+	RRPCLIENT* client,
+	RRPCLIENTCLASS priority,
+	int limit,
+	int reserved
+) {
+	int total = 0;
+	int i = 0;
+
+	/*
+	** Validate parameters
+	*/
+	if (client == NULL || (int) priority < 0 ||
+		priority >= RRP_CLIENT_CLASSES || limit < 0 || reserved < 0) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	pthread_mutex_lock(&client->mutex);
+
+	for (i = 0; i < RRP_CLIENT_CLASSES; i++) {
+		total += (i == (int) priority) ? reserved :
+			client->classes[i].reserved;
+	}
+
+	if (total >= RRPGetSessionPoolSize(client->pool)) {
+		pthread_mutex_unlock(&client->mutex);
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	client->classes[priority].limit = limit;
+	client->classes[priority].reserved = reserved;
+
+	pthread_mutex_unlock(&client->mutex);
+
+	/*
+	** Requests held back by the old limit may go now
+	*/
+	write(client->wake[1], "", 1);
+
+	return 0;
+
+} /* RRPSetClientClassLimits */
+
+
+
+
+
+
+/*
+**
+** Function: RRPGetClientStatistics
+**
+** Description: Returns the counts of the requests of a client
+**
+** Input: RRPCLIENT* - a pointer to an RRPCLIENT structure
+**
+** Output: RRPCLIENTSTATISTICS* - the counts
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+
+int
+RRPGetClientStatistics (
+	RRPCLIENT* client,
+	RRPCLIENTSTATISTICS* statistics
+) {
+	/*
+	** Validate parameters
+	*/
+	if (client == NULL || statistics == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	pthread_mutex_lock(&client->mutex);
+	*statistics = client->statistics;
+	pthread_mutex_unlock(&client->mutex);
+
+	return 0;
+
+} /* RRPGetClientStatistics */
+
+
+
+
+
+
+/*
+**
+** Function: RRPGetClientClassStatistics
+**
+** Description: Returns the counts and latencies of the requests of a
+**              priority class
+**
+** Input: RRPCLIENT* - a pointer to an RRPCLIENT structure
+**        RRPCLIENTCLASS - the class
+**
+** Output: RRPCLIENTCLASSSTATISTICS* - the counts and latencies. The
+**                                     percentiles are rounded up, by at
+**                                     most a quarter
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+
+int
+RRPGetClientClassStatistics (
+	RRPCLIENT* client,
+	RRPCLIENTCLASS priority,
+	RRPCLIENTCLASSSTATISTICS* statistics
+) {
+	RRPCLIENTCLASSSTATE state;
+
+	/*
+	** Validate parameters
+	*/
+	if (client == NULL || (int) priority < 0 ||
+		priority >= RRP_CLIENT_CLASSES || statistics == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	pthread_mutex_lock(&client->mutex);
+	state = client->classes[priority];
+	pthread_mutex_unlock(&client->mutex);
+
+	statistics->submitted = state.submitted;
+	statistics->completed = state.completed;
+	statistics->queued = state.queued;
+	statistics->active = state.active;
+	statistics->median = getLatencyPercentile(&state, 50);
+	statistics->p90 = getLatencyPercentile(&state, 90);
+	statistics->p99 = getLatencyPercentile(&state, 99);
+	statistics->maximum = state.maximum;
+
+	return 0;
+
+} /* RRPGetClientClassStatistics */
+
+
+
+
+
+
+/*
+**
+** Function: RRPFreeClient
+**
+** Description: Completes the requests submitted to a client, stops the
+**              client's thread, then frees the pool (see
+**              RRPFreeSessionPool()) and the client
+**
+** Input: RRPCLIENT* - a pointer to an RRPCLIENT structure
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+
+int
+RRPFreeClient (
+	RRPCLIENT* client
+) {
+	/*
+	** Validate parameters
+	*/
+	if (client == NULL || pthread_equal(pthread_self(), client->thread)) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	pthread_mutex_lock(&client->mutex);
+	client->stopping = RRPTRUE;
+	pthread_mutex_unlock(&client->mutex);
+
+	write(client->wake[1], "", 1);
+	pthread_join(client->thread, NULL);
+
+	RRPFreeSessionPool(client->pool);
+	pthread_mutex_destroy(&client->mutex);
+	close(client->wake[0]);
+	close(client->wake[1]);
+	free(client->descriptors);
+	free(client->reservations);
+	free(client);
+
+	return 0;
+
+} /* RRPFreeClient */
+
+
+
+
+
+
+/*
+** Body of the client's thread. Runs until the client is being freed and
+** all of its requests have been completed
+*/
+static void*
+runClient (
+	void* argument
+) {
+	RRPCLIENT* client = (RRPCLIENT*) argument;
+	RRPCLIENTCALL* calls = NULL;
+	RRPCLIENTCALL* next = NULL;
+	RRPBOOLEAN stopping = RRPFALSE;
+	RRPBOOLEAN coalescing = RRPFALSE;
+	RRPBOOLEAN waiting = RRPFALSE;
+	int i = 0;
+
+	for (;;) {
+		takeClientQueue(client, &calls, &stopping, &coalescing);
+
+		for (; calls != NULL; calls = next) {
+			next = calls->next;
+			calls->next = NULL;
+			dispatchClientCall(client, calls, coalescing);
+		}
+
+		requeueClientCalls(client);
+		scheduleClient(client);
+
+		/*
+		** No request can be submitted once the client is stopping, so
+		** the queue stays empty
+		*/
+		waiting = client->retries != NULL;
+		for (i = 0; i < RRP_CLIENT_CLASSES; i++) {
+			if (client->classHeads[i] != NULL) {
+				waiting = RRPTRUE;
+			}
+		}
+
+		if (stopping && !waiting &&
+			RRPGetSessionPoolPending(client->pool) == 0) {
+			break;
+		}
+
+		pollClient(client);
+	}
+
+	/*
+	** Publish the last counts
+	*/
+	takeClientQueue(client, &calls, &stopping, &coalescing);
+
+	return NULL;
+
+} /* runClient() */
+
+
+
+/*
+** Takes the whole queue of a client, publishes the counts of the
+** client's thread and reads the limits of the classes
+*/
+static void
+takeClientQueue (
+	RRPCLIENT* client,
+	RRPCLIENTCALL** calls,
+	RRPBOOLEAN* stopping,
+	RRPBOOLEAN* coalescing
+) {
+	RRPCLIENTCLASSSTATE* shared = NULL;
+	RRPCLIENTCLASSSTATE* counts = NULL;
+	RRPBOOLEAN reserving = RRPFALSE;
+	int size = 0;
+	int i = 0;
+	int j = 0;
+
+	pthread_mutex_lock(&client->mutex);
+
+	*calls = client->queueHead;
+	*stopping = client->stopping;
+	*coalescing = client->coalescing;
+	client->queueHead = NULL;
+	client->queueTail = NULL;
+
+	client->statistics.sent += client->counts.sent;
+	client->statistics.coalesced += client->counts.coalesced;
+	client->statistics.failed += client->counts.failed;
+	client->statistics.retried += client->counts.retried;
+
+	for (i = 0; i < RRP_CLIENT_CLASSES; i++) {
+		shared = &client->classes[i];
+		counts = &client->classCounts[i];
+
+		shared->completed += counts->completed;
+		shared->queued = counts->queued;
+		shared->active = counts->active;
+		if (counts->maximum > shared->maximum) {
+			shared->maximum = counts->maximum;
+		}
+		for (j = 0; j < RRP_LATENCY_BUCKETS; j++) {
+			shared->latencies[j] += counts->latencies[j];
+		}
+
+		counts->limit = shared->limit;
+		if (counts->reserved != shared->reserved) {
+			counts->reserved = shared->reserved;
+			reserving = RRPTRUE;
+		}
+	}
+
+	pthread_mutex_unlock(&client->mutex);
+
+	memset(&client->counts, 0, sizeof(client->counts));
+
+	for (i = 0; i < RRP_CLIENT_CLASSES; i++) {
+		counts = &client->classCounts[i];
+		counts->completed = 0;
+		counts->maximum = 0;
+		memset(counts->latencies, 0, sizeof(counts->latencies));
+	}
+
+	/*
+	** Reserve sessions from the first one on, in the order of the
+	** classes
+	*/
+	if (reserving) {
+		size = RRPGetSessionPoolSize(client->pool);
+
+		for (i = 0; i < size; i++) {
+			client->reservations[i] = -1;
+		}
+
+		for (i = 0, j = 0; i < RRP_CLIENT_CLASSES; i++) {
+			size = client->classCounts[i].reserved;
+			for (; size > 0; size--) {
+				client->reservations[j++] = i;
+			}
+		}
+	}
+
+} /* takeClientQueue() */
+
+
+
+/*
+** Waits until the pipe or a session is ready, then empties the pipe and
+** lets the sessions make progress (see RRPPollSessionPool())
+*/
+static void
+pollClient (
+	RRPCLIENT* client
+) {
+	struct pollfd* descriptors = client->descriptors;
+	RRPSESSION* session = NULL;
+	struct timespec now;
+	char buffer[64];
+	int size = RRPGetSessionPoolSize(client->pool);
+	int timeout = -1;
+	int result = 0;
+	int wait = 0;
+	int i = 0;
+
+	descriptors[0].fd = client->wake[0];
+	descriptors[0].events = POLLIN;
+	descriptors[0].revents = 0;
+
+	/*
+	** Write new requests right away rather than after waiting for a
+	** session to become writable
+	*/
+	for (i = 0; i < size; i++) {
+		session = RRPGetPoolSession(client->pool, i);
+		descriptors[i + 1].fd = -1;
+		descriptors[i + 1].events = 0;
+		descriptors[i + 1].revents = 0;
+
+		if (RRPGetSessionEvents(session) & POLLOUT) {
+			RRPFlushSession(session);
+		}
+
+		if ((descriptors[i + 1].events = RRPGetSessionEvents(session)) != 0) {
+			descriptors[i + 1].fd = RRPGetSessionDescriptor(session);
+		}
+
+		/*
+		** Wake up when the governor lets a throttled session send again
+		*/
+		if ((wait = RRPGetSessionTimeout(session)) >= 0 &&
+			(timeout < 0 || wait < timeout)) {
+			timeout = wait;
+		}
+	}
+
+	/*
+	** Wake up when the first request to retry is due
+	*/
+	if (client->retries != NULL) {
+		clock_gettime(CLOCK_MONOTONIC, &now);
+		wait = (int) ((client->retries->due.tv_sec - now.tv_sec) * 1000 +
+			(client->retries->due.tv_nsec - now.tv_nsec + 999999) / 1000000);
+		if (wait < 0) {
+			wait = 0;
+		}
+		if (timeout < 0 || wait < timeout) {
+			timeout = wait;
+		}
+	}
+
+	do {
+		result = poll(descriptors, size + 1, timeout);
+	} while (result < 0 && errno == EINTR);
+
+	/*
+	** poll() only fails here for lack of resources: try again on the
+	** next pass. A timeout leaves the throttled sessions to be flushed
+	** at the top of the next pass
+	*/
+	if (result <= 0) {
+		return;
+	}
+
+	if (descriptors[0].revents != 0) {
+		while (read(client->wake[0], buffer, sizeof(buffer)) > 0) {
+		}
+	}
+
+	for (i = 0; i < size; i++) {
+		if (descriptors[i + 1].revents == 0) {
+			continue;
+		}
+
+		session = RRPGetPoolSession(client->pool, i);
+
+		if (descriptors[i + 1].revents & POLLOUT) {
+			if (RRPFlushSession(session) < 0) {
+				continue;
+			}
+		}
+
+		if (descriptors[i + 1].revents & (POLLIN | POLLERR | POLLHUP)) {
+			RRPProcessSession(session);
+		}
+	}
+
+} /* pollClient() */
+
+
+
+/*
+** Completes a request found in the cache, attaches it to an identical
+** request, or files it under its class
+*/
+static void
+dispatchClientCall (
+	RRPCLIENT* client,
+	RRPCLIENTCALL* call,
+	RRPBOOLEAN coalescing
+) {
+	RRPREQUEST* request = call->request;
+	RRPCLIENTCALL* first = NULL;
+	RRPCLIENTCALL** bucket = NULL;
+
+	/*
+	** Answered from the cache
+	*/
+	if (call->response != NULL) {
+		finishClientCall(call, call->response, RRP_NO_ERROR);
+		RRPFreeRequest(request);
+		free(call);
+		return;
+	}
+
+	if (coalescing && (request->command == RRP_CHECK_COMMAND ||
+		request->command == RRP_STATUS_COMMAND)) {
+		call->hash = hashClientRequest(request);
+		bucket = &client->flights[call->hash % RRP_CLIENT_BUCKETS];
+
+		/*
+		** A request still waiting in a lower class would hold this one
+		** back
+		*/
+		for (first = *bucket; first != NULL; first = first->nextLeader) {
+			if (first->hash == call->hash &&
+				(first->sent || first->priority <= call->priority) &&
+				first->request->length == request->length &&
+				memcmp(first->request->text, request->text,
+					request->length) == 0) {
+				call->next = first->followers;
+				first->followers = call;
+				client->counts.coalesced++;
+				return;
+			}
+		}
+
+		call->leader = RRPTRUE;
+		call->nextLeader = *bucket;
+		*bucket = call;
+	}
+
+	if (client->classTails[call->priority] == NULL) {
+		client->classHeads[call->priority] = call;
+	}
+	else {
+		client->classTails[call->priority]->next = call;
+	}
+	client->classTails[call->priority] = call;
+	client->classCounts[call->priority].queued++;
+
+} /* dispatchClientCall() */
+
+
+
+/*
+** Sends the waiting requests, from the highest class down, while their
+** classes are under their limits and sessions have room
+*/
+static void
+scheduleClient (
+	RRPCLIENT* client
+) {
+	RRPCLIENTCLASSSTATE* counts = NULL;
+	RRPCLIENTCALL* call = NULL;
+	RRPSESSION* session = NULL;
+	RRPBOOLEAN open = RRPFALSE;
+	int i = 0;
+
+	for (i = 0; i < RRP_CLIENT_CLASSES; i++) {
+		counts = &client->classCounts[i];
+
+		while ((call = client->classHeads[i]) != NULL &&
+			(counts->limit == 0 || counts->active < counts->limit)) {
+			session = pickClientSession(client, (RRPCLIENTCLASS) i, &open);
+			if (session == NULL && open) {
+				break;
+			}
+
+			client->classHeads[i] = call->next;
+			if (call->next == NULL) {
+				client->classTails[i] = NULL;
+			}
+			call->next = NULL;
+			counts->queued--;
+
+			/*
+			** Every session the class may use has failed
+			*/
+			if (session == NULL) {
+				failClientCall(call, RRP_NOT_CONNECTED_ERROR);
+				continue;
+			}
+
+			sendClientCall(client, call, session);
+		}
+	}
+
+} /* scheduleClient() */
+
+
+
+/*
+** Puts the calls whose retry is due back at the front of their classes,
+** in the order they were due
+*/
+static void
+requeueClientCalls (
+	RRPCLIENT* client
+) {
+	RRPCLIENTCALL** positions[RRP_CLIENT_CLASSES];
+	RRPCLIENTCALL* call = NULL;
+	struct timespec now;
+	int i = 0;
+
+	if (client->retries == NULL) {
+		return;
+	}
+
+	for (i = 0; i < RRP_CLIENT_CLASSES; i++) {
+		positions[i] = &client->classHeads[i];
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	while ((call = client->retries) != NULL &&
+		(call->due.tv_sec < now.tv_sec || (call->due.tv_sec == now.tv_sec &&
+		call->due.tv_nsec <= now.tv_nsec))) {
+		client->retries = call->next;
+
+		call->next = *positions[call->priority];
+		*positions[call->priority] = call;
+		positions[call->priority] = &call->next;
+		if (call->next == NULL) {
+			client->classTails[call->priority] = call;
+		}
+
+		client->classCounts[call->priority].queued++;
+	}
+
+} /* requeueClientCalls() */
+
+
+
+/*
+** Returns the open session with room in its window and the fewest
+** requests outstanding among those a class may use, or NULL. 'open'
+** tells whether the class may use any open session at all
+*/
+static RRPSESSION*
+pickClientSession (
+	RRPCLIENT* client,
+	RRPCLIENTCLASS priority,
+	RRPBOOLEAN* open
+) {
+	RRPSESSION* session = NULL;
+	RRPSESSION* best = NULL;
+	int size = RRPGetSessionPoolSize(client->pool);
+	int pending = 0;
+	int fewest = 0;
+	int i = 0;
+
+	*open = RRPFALSE;
+
+	for (i = 0; i < size; i++) {
+		if (client->reservations[i] >= 0 &&
+			(int) priority > client->reservations[i]) {
+			continue;
+		}
+
+		session = RRPGetPoolSession(client->pool, i);
+		if (!RRPIsSessionOpen(session)) {
+			continue;
+		}
+
+		*open = RRPTRUE;
+
+		/*
+		** A session held back by its governor counts as busy, so that
+		** no more than its held request waits behind the governor
+		*/
+		pending = RRPGetSessionPending(session);
+		if (pending < RRPGetSessionWindow(session) &&
+			RRPGetSessionTimeout(session) < 0 &&
+			(best == NULL || pending < fewest)) {
+			best = session;
+			fewest = pending;
+		}
+	}
+
+	return best;
+
+} /* pickClientSession() */
+
+
+
+/*
+** Gives a request to a session
+*/
+static void
+sendClientCall (
+	RRPCLIENT* client,
+	RRPCLIENTCALL* call,
+	RRPSESSION* session
+) {
+	if (RRPSubmitSessionRequest(session, call->request, completeClientCall,
+		call) < 0) {
+		failClientCall(call, RRPGetInternalErrorCode());
+		return;
+	}
+
+	call->sent = RRPTRUE;
+	client->counts.sent++;
+	client->classCounts[call->priority].active++;
+
+} /* sendClientCall() */
+
+
+
+/*
+** Completes a request that could not be sent, and the requests attached
+** to it
+*/
+static void
+failClientCall (
+	RRPCLIENTCALL* call,
+	RRPINTERNAL_ERROR_CODE error
+) {
+	RRPREQUEST* request = call->request;
+
+	RRPSetInternalErrorCode(error);
+	completeClientCall(request, NULL, call);
+	RRPFreeRequest(request);
+
+} /* failClientCall() */
+
+
+
+/*
+** Completion function of the requests given to the sessions: completes
+** the request and the requests attached to it
+*/
+static void
+completeClientCall (
+	RRPREQUEST* request,
+	RRPRESPONSE* response,
+	void* context
+) {
+	RRPCLIENTCALL* call = (RRPCLIENTCALL*) context;
+	RRPCLIENT* client = call->client;
+	RRPCLIENTCALL** link = NULL;
+	RRPCLIENTCALL* follower = NULL;
+	RRPRESPONSE* copy = NULL;
+	RRPINTERNAL_ERROR_CODE error = RRP_NO_ERROR;
+
+	if (response == NULL) {
+		error = RRPGetInternalErrorCode();
+	}
+
+	if (call->sent) {
+		client->classCounts[call->priority].active--;
+
+		/*
+		** A request sent again stays in the table of requests in
+		** flight, so identical requests keep attaching to it
+		*/
+		if (client->retry != NULL &&
+			retryClientCall(client, call, response, error)) {
+			return;
+		}
+
+		if (client->cache != NULL) {
+			RRPCacheResponse(client->cache, request, response,
+				call->version);
+		}
+	}
+
+	/*
+	** Requests submitted from now on are sent again
+	*/
+	if (call->leader) {
+		for (link = &client->flights[call->hash % RRP_CLIENT_BUCKETS];
+			*link != call; link = &(*link)->nextLeader) {
+		}
+		*link = call->nextLeader;
+	}
+
+	/*
+	** Each follower gets its own copy, made before the original is
+	** handed over to the first request
+	*/
+	while ((follower = call->followers) != NULL) {
+		call->followers = follower->next;
+
+		copy = NULL;
+		if (response != NULL && (copy = RRPCloneResponse(response)) == NULL) {
+			finishClientCall(follower, NULL, RRPGetInternalErrorCode());
+		}
+		else {
+			finishClientCall(follower, copy, error);
+		}
+
+		RRPFreeRequest(follower->request);
+		free(follower);
+	}
+
+	finishClientCall(call, response, error);
+	free(call);
+
+} /* completeClientCall() */
+
+
+
+/*
+** Counts the latency of a request and calls its completion function.
+** The internal error code is set for a request that failed
+*/
+static void
+finishClientCall (
+	RRPCLIENTCALL* call,
+	RRPRESPONSE* response,
+	RRPINTERNAL_ERROR_CODE error
+) {
+	RRPCLIENTCLASSSTATE* counts = &call->client->classCounts[call->priority];
+	struct timespec now;
+	unsigned long latency = 0;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	latency = (unsigned long) (now.tv_sec - call->submitted.tv_sec) *
+		1000000 + now.tv_nsec / 1000 - call->submitted.tv_nsec / 1000;
+
+	counts->completed++;
+	counts->latencies[getLatencyBucket(latency)]++;
+	if (latency > counts->maximum) {
+		counts->maximum = latency;
+	}
+
+	if (response == NULL) {
+		call->client->counts.failed++;
+		RRPSetInternalErrorCode(error);
+	}
+
+	call->completion(call->request, response, call->context);
+
+} /* finishClientCall() */
+
+
+
+/*
+** Files a call that failed to be sent again after the delay of the
+** client's retry policy. The call keeps a copy of its request, and its
+** response is freed. Returns RRPFALSE if the call is not to be retried
+*/
+static RRPBOOLEAN
+retryClientCall (
+	RRPCLIENT* client,
+	RRPCLIENTCALL* call,
+	RRPRESPONSE* response,
+	RRPINTERNAL_ERROR_CODE error
+) {
+	RRPCLIENTCALL** link = NULL;
+	RRPREQUEST* copy = NULL;
+	int delay = 0;
+
+	delay = RRPGetRetryDelay(client->retry, &call->retry, call->request,
+		response, error);
+	if (delay <= 0 || (copy = copyClientRequest(call->request)) == NULL) {
+		return RRPFALSE;
+	}
+
+	if (response != NULL) {
+		RRPFreeResponse(response);
+	}
+
+	call->request = copy;
+	call->sent = RRPFALSE;
+
+	clock_gettime(CLOCK_MONOTONIC, &call->due);
+	call->due.tv_sec += delay / 1000;
+	call->due.tv_nsec += (long) (delay % 1000) * 1000000;
+	if (call->due.tv_nsec >= 1000000000) {
+		call->due.tv_sec++;
+		call->due.tv_nsec -= 1000000000;
+	}
+
+	for (link = &client->retries; *link != NULL &&
+		((*link)->due.tv_sec < call->due.tv_sec ||
+		((*link)->due.tv_sec == call->due.tv_sec &&
+		(*link)->due.tv_nsec <= call->due.tv_nsec));
+		link = &(*link)->next) {
+	}
+	call->next = *link;
+	*link = call;
+
+	client->counts.retried++;
+
+	return RRPTRUE;
+
+} /* retryClientCall() */
+
+
+
+/*
+** Returns a copy of a request, or NULL if memory runs out
+*/
+static RRPREQUEST*
+copyClientRequest (
+	RRPREQUEST* request
+) {
+	RRPREQUEST* copy = NULL;
+
+	copy = (RRPREQUEST*) malloc(sizeof(RRPREQUEST));
+	if (copy == NULL) {
+		return NULL;
+	}
+
+	*copy = *request;
+	copy->capacity = request->length + 1;
+	copy->text = (char*) malloc(copy->capacity);
+	if (copy->text == NULL) {
+		free(copy);
+		return NULL;
+	}
+
+	memcpy(copy->text, request->text, request->length + 1);
+
+	return copy;
+
+} /* copyClientRequest() */
+
+
+
+/*
+** Returns the hash value of the text of a request
+*/
+static unsigned long
+hashClientRequest (
+	RRPREQUEST* request
+) {
+	unsigned long hash = 5381;
+	size_t i = 0;
+
+	for (i = 0; i < request->length; i++) {
+		hash = hash * 33 + (unsigned char) request->text[i];
+	}
+
+	return hash;
+
+} /* hashClientRequest() */
+
+
+
+/*
+** Returns the bucket of a latency: the latencies under 4 microseconds
+** have a bucket each, then each power of two is split in four
+*/
+static int
+getLatencyBucket (
+	unsigned long latency
+) {
+	int exponent = 2;
+	int bucket = 0;
+
+	if (latency < 4) {
+		return (int) latency;
+	}
+
+	while ((latency >> (exponent + 1)) != 0) {
+		exponent++;
+	}
+
+	bucket = 4 * (exponent - 1) + (int) ((latency >> (exponent - 2)) & 3);
+
+	return bucket < RRP_LATENCY_BUCKETS ? bucket : RRP_LATENCY_BUCKETS - 1;
+
+} /* getLatencyBucket() */
+
+
+
+/*
+** Returns a percentile of the latencies of a class: the highest latency
+** of the bucket it falls in, or the highest latency seen if lower
+*/
+static unsigned long
+getLatencyPercentile (
+	RRPCLIENTCLASSSTATE* state,
+	int percent
+) {
+	unsigned long total = 0;
+	unsigned long target = 0;
+	unsigned long count = 0;
+	unsigned long highest = 0;
+	int exponent = 0;
+	int i = 0;
+
+	for (i = 0; i < RRP_LATENCY_BUCKETS; i++) {
+		total += state->latencies[i];
+	}
+
+	if (total == 0) {
+		return 0;
+	}
+
+	target = (total * percent + 99) / 100;
+
+	for (i = 0; i < RRP_LATENCY_BUCKETS - 1; i++) {
+		count += state->latencies[i];
+		if (count >= target) {
+			break;
+		}
+	}
+
+	if (i < 4) {
+		highest = (unsigned long) i;
+	}
+	else {
+		exponent = i / 4 + 1;
+		highest = ((unsigned long) (4 + i % 4 + 1) << (exponent - 2)) - 1;
+	}
+
+	return highest < state->maximum ? highest : state->maximum;
+
+} /* getLatencyPercentile() */
+
+
+
+/*
+** Adds a call to the queue of a client, waking the client's thread if
+** needed
+*/
+static int
+queueClientCall (
+	RRPCLIENT* client,
+	RRPCLIENTCLASS priority,
+	RRPREQUEST* request,
+	RRPCOMPLETION completion,
+	void* context,
+	RRPRESPONSE* response,
+	unsigned long version
+) {
+	RRPCLIENTCALL* call = NULL;
+	RRPBOOLEAN wake = RRPFALSE;
+
+	call = (RRPCLIENTCALL*) calloc(1, sizeof(RRPCLIENTCALL));
+	if (call == NULL) {
+		RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
+		return -1;
+	}
+
+	call->client = client;
+	call->request = request;
+	call->completion = completion;
+	call->context = context;
+	call->priority = priority;
+	call->response = response;
+	call->version = version;
+	clock_gettime(CLOCK_MONOTONIC, &call->submitted);
+
+	pthread_mutex_lock(&client->mutex);
+
+	if (client->stopping) {
+		pthread_mutex_unlock(&client->mutex);
+		free(call);
+		RRPSetInternalErrorCode(RRP_NOT_CONNECTED_ERROR);
+		return -1;
+	}
+
+	/*
+	** The thread empties the queue each time it wakes up, so it only
+	** needs waking when the queue was empty
+	*/
+	if (client->queueTail == NULL) {
+		client->queueHead = call;
+		wake = RRPTRUE;
+	}
+	else {
+		client->queueTail->next = call;
+	}
+	client->queueTail = call;
+	client->statistics.submitted++;
+	client->classes[priority].submitted++;
+
+	pthread_mutex_unlock(&client->mutex);
+
+	if (wake) {
+		write(client->wake[1], "", 1);
+	}
+
+	return 0;
+
+} /* queueClientCall() */
+
+
+
+/*
+** Completion function of the requests of RRPClientRequest(): hands the
+** response to the waiting thread
+*/
+static void
+wakeClientCaller (
+	RRPREQUEST* request,
+	RRPRESPONSE* response,
+	void* context
+) {
+	RRPCLIENTWAIT* wait = (RRPCLIENTWAIT*) context;
+
+	pthread_mutex_lock(&wait->client->mutex);
+
+	wait->response = response;
+	if (response == NULL) {
+		wait->error = RRPGetInternalErrorCode();
+	}
+	wait->done = RRPTRUE;
+	pthread_cond_signal(&wait->condition);
+
+	pthread_mutex_unlock(&wait->client->mutex);
+
+} /* wakeClientCaller() */
+
+
+
+/*
+** Builds a request for a command on a domain or name server and waits
+** for its response, in the interactive class
+*/
+static RRPRESPONSE*
+clientEntityRequest (
+	RRPCLIENT* client,
+	RRPCOMMAND command,
+	RRPENTITY entity,
+	char* name
+) {
+	RRPREQUEST* request = NULL;
+
+	/*
+	** Validate parameters
+	*/
+	if (client == NULL || name == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return NULL;
+	}
+
+	request = RRPCreateRequest(command, entity, name, strlen(name));
+	if (request == NULL) {
+		return NULL;
+	}
+
+	return RRPClientClassRequest(client, RRP_INTERACTIVE_CLASS, request);
+
+} /* clientEntityRequest() */
@@ -60,8 +60,19 @@
 **
 **    RRPCreateConnection (char*, unsigned short int);
 **    RRPSendRequest(char*);
+**    RRPSendRequestData(const char*, size_t);
 **    RRPReadResponse();
 **    RRPCloseConnection();
+**    RRPOpenConnection(char*, unsigned short int);
+**    RRPOpenLocalConnection(char*);
+**    RRPGetConnectionGreeting(RRPCONNECTION*);
+**    RRPGetConnectionDescriptor(RRPCONNECTION*);
+**    RRPSetConnectionBlocking(RRPCONNECTION*, int);
+**    RRPWriteConnection(RRPCONNECTION*, const char*, size_t);
+**    RRPFillConnection(RRPCONNECTION*);
+**    RRPNextConnectionResponse(RRPCONNECTION*, char**);
+**    RRPReadConnectionResponse(RRPCONNECTION*);
+**    RRPFreeConnection(RRPCONNECTION*);
 **
 ** IMPORTANT: THIS IMPLEMENTATION OF THE FUNCTIONS CONTAINED
 ** WITHIN THIS FILE ARE NOT SSL-ENABLED. THE FUNCTION SIGNATURES MUST
@@ -73,6 +84,21 @@
 **
 ** Changes:
 **
+** Oct. 19th, 2026: RRPSendRequestData() sends a request string whose
+** length is already known. Both send functions now keep writing until
+** the whole request has been sent. A secure replacement of
+** rrpConnection.c must implement RRPSendRequestData() as well.
+**
+** Oct. 19th, 2026: Connection handles (RRPOpenConnection() and the
+** functions that take an RRPCONNECTION*) allow several connections at
+** once, non-blocking operation, and pipelined requests. They must also
+** be implemented by a secure replacement of rrpConnection.c.
+**
+** Oct. 19th, 2026: RRPOpenLocalConnection() connects to a Unix domain
+** socket, such as that of a session broker (see rrpBroker.c). A secure
+** replacement of rrpConnection.c must implement it as well, but need not
+** encrypt it: the socket never leaves the host.
+**
 */
 
 
@@ -80,11 +106,16 @@
 #include <string.h>
 #include <sys/types.h>
 #include <sys/socket.h>
+#include <sys/un.h>
 #include <unistd.h>
 #include <netinet/in.h>
 #include <netdb.h>
 #include <arpa/inet.h>
 #include <signal.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <netinet/tcp.h>
 #include "rrpConnection.h"
 #include "rrpInternalError.h"
 
@@ -104,6 +135,23 @@ void sigAlarmHandler();
 */
 int GetInAddrFromString ( struct in_addr*, char*);
 
+static int WaitForConnection (RRPCONNECTION*, short);
+
+/*
+** Smallest amount of free space in the input buffer of a connection
+** handle before a read
+*/
+#define RRP_MIN_READ_SIZE 4096
+
+/*
+** Writes must not raise SIGPIPE if the server has closed the connection
+*/
+#ifdef MSG_NOSIGNAL
+	#define RRP_SEND_FLAGS MSG_NOSIGNAL
+#else
+	#define RRP_SEND_FLAGS 0
+#endif
+
 
 /*
 ** Function: RRPSetTimeout
@@ -246,7 +294,48 @@ int
 RRPSendRequest (
 	char* request
 ) {
-	size_t requestSize;
+	/*
+	** Validate parameters
+	*/
+	if (request == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	return RRPSendRequestData(request, strlen(request));
+}
+
+
+
+
+
+
+
+/*
+**
+** Function: RRPSendRequestData
+**
+** Description: Sends an RRP request string of a known length to the RRP
+**              server
+**
+** Input: const char* - the RRP request string to send to the server. Need
+**                      not be NUL terminated
+**        size_t - the length of the request string
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error or timeout occurs.
+**
+**
+*/
+
+int
+RRPSendRequestData (
+	const char* request,
+	size_t requestSize
+) {
+	ssize_t byteCount;
 
 	/*
 	** Validate parameters
@@ -265,11 +354,6 @@ RRPSendRequest (
 		return -1;
 	}
 
-	/*
-	** Determine size of request string
-	*/
-	requestSize = strlen(request);
-
 	/*
 	** if a timeout option is set, set timeout alarm before entering
 	** blocked write
@@ -282,18 +366,24 @@ RRPSendRequest (
 
 
 	/*
-	** Write request string to socket and make sure that all bytes
-	** were written
+	** Write request string to socket until all bytes have been written
 	*/
-	if (write(_socket, request, requestSize) < (ssize_t) requestSize) {
-		if (_timeoutFlag == 1) {
-			RRPSetInternalErrorCode(RRP_TIMEOUT_ERROR);
+	while (requestSize > 0) {
+		byteCount = write(_socket, request, requestSize);
+
+		if (byteCount <= 0) {
+			if (_timeoutFlag == 1) {
+				RRPSetInternalErrorCode(RRP_TIMEOUT_ERROR);
+			}
+			else {
+				disableTimeoutAlarm();
+				RRPSetInternalErrorCode(RRP_IO_ERROR);
+			}
+			return -1;
 		}
-		else {
-			disableTimeoutAlarm();
-			RRPSetInternalErrorCode(RRP_IO_ERROR);
-		}
-		return -1;
+
+		request += byteCount;
+		requestSize -= byteCount;
 	}
 
 	disableTimeoutAlarm();
@@ -450,6 +540,698 @@ RRPCloseConnection () {
 
 
 
+/*
+** Connection handles (see rrpConnection.h)
+*/
+struct _RRPCONNECTION {
+	int socket;
+	int blocking;
+	char* greeting;        /* greeting received from server */
+	char* input;           /* input buffer */
+	size_t inputStart;     /* start of first unreturned response */
+	size_t inputLength;    /* number of characters in buffer */
+	size_t inputCapacity;  /* size of buffer */
+	size_t inputScanned;   /* where the search for ".\r\n" resumes */
+};
+
+
+
+
+
+/*
+**
+** Function: RRPOpenConnection
+**
+** Description: Establishes a new connection to a specified RRP server and
+**              reads the server's greeting (see
+**              RRPGetConnectionGreeting()). The connection is in
+**              blocking mode
+**
+** Input: char* - host name or IP address of RRP server
+**        unsigned short int - RRP server port
+**
+** Output: none
+**
+** Return: RRPCONNECTION* - a handle for the connection. NULL is returned
+**                          if an internal error or timeout occurs.
+**
+** Note: THE CONNECTION MUST BE CLOSED BY CALLING RRPFreeConnection()
+**
+*/
+
+RRPCONNECTION*
+RRPOpenConnection (
+	char* host,
+	unsigned short int port
+) {
+	struct in_addr addr;
+	struct sockaddr_in address;
+	RRPCONNECTION* connection = NULL;
+	int error = 0;
+	int on = 1;
+	socklen_t size = sizeof(error);
+
+	/*
+	** Validate parameters
+	*/
+	if (host == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return NULL;
+	}
+
+	if (GetInAddrFromString(&addr, host) < 0) {
+		RRPSetInternalErrorCode(RRP_INVALID_HOST_NAME_ERROR);
+		return NULL;
+	}
+
+	memset((char *) &address, 0, sizeof(address));
+	address.sin_family = AF_INET;
+	address.sin_port = htons(port);
+	address.sin_addr.s_addr = addr.s_addr;
+
+	connection = (RRPCONNECTION*) calloc(1, sizeof(RRPCONNECTION));
+	if (connection == NULL) {
+		RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
+		return NULL;
+	}
+
+	connection->blocking = 1;
+	connection->socket = socket(AF_INET, SOCK_STREAM, 0);
+	if (connection->socket < 0) {
+		free(connection);
+		RRPSetInternalErrorCode(RRP_SOCKET_CONNECT_ERROR);
+		return NULL;
+	}
+
+	/*
+	** Requests are small and are often pipelined, so send them at once
+	** rather than waiting to fill a segment
+	*/
+	setsockopt(connection->socket, IPPROTO_TCP, TCP_NODELAY, (char*) &on,
+		sizeof(on));
+
+	/*
+	** Connect in non-blocking mode so that the timeout can be applied
+	** with poll()
+	*/
+	fcntl(connection->socket, F_SETFL,
+		fcntl(connection->socket, F_GETFL) | O_NONBLOCK);
+
+	if (connect(connection->socket, (struct sockaddr *) &address,
+		sizeof(address)) < 0) {
+		if (errno != EINPROGRESS) {
+			RRPFreeConnection(connection);
+			RRPSetInternalErrorCode(RRP_SOCKET_CONNECT_ERROR);
+			return NULL;
+		}
+
+		if (WaitForConnection(connection, POLLOUT) < 0) {
+			RRPFreeConnection(connection);
+			return NULL;
+		}
+
+		if (getsockopt(connection->socket, SOL_SOCKET, SO_ERROR,
+			(char*) &error, &size) < 0 || error != 0) {
+			RRPFreeConnection(connection);
+			RRPSetInternalErrorCode(RRP_SOCKET_CONNECT_ERROR);
+			return NULL;
+		}
+	}
+
+	fcntl(connection->socket, F_SETFL,
+		fcntl(connection->socket, F_GETFL) & ~O_NONBLOCK);
+
+	/*
+	** Read and keep welcome message from RRP server
+	*/
+	connection->greeting = RRPReadConnectionResponse(connection);
+	if (connection->greeting == NULL) {
+		RRPFreeConnection(connection);
+		return NULL;
+	}
+
+	return connection;
+
+} /* RRPOpenConnection */
+
+
+
+
+
+/*
+**
+** Function: RRPOpenLocalConnection
+**
+** Description: Establishes a new connection to an RRP server, or to a
+**              session broker (see rrpBroker.c), listening on a Unix
+**              domain socket, and reads its greeting. The connection is
+**              in blocking mode and is then used like one opened by
+**              RRPOpenConnection()
+**
+** Input: char* - path of the socket
+**
+** Output: none
+**
+** Return: RRPCONNECTION* - a handle for the connection. NULL is returned
+**                          if an internal error or timeout occurs.
+**
+** Note: THE CONNECTION MUST BE CLOSED BY CALLING RRPFreeConnection()
+**
+*/
+
+RRPCONNECTION*
+RRPOpenLocalConnection (
+	char* path
+) {
+	struct sockaddr_un address;
+	RRPCONNECTION* connection = NULL;
+
+	/*
+	** Validate parameters
+	*/
+	if (path == NULL || strlen(path) >= sizeof(address.sun_path)) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return NULL;
+	}
+
+	memset((char *) &address, 0, sizeof(address));
+	address.sun_family = AF_UNIX;
+	strcpy(address.sun_path, path);
+
+	connection = (RRPCONNECTION*) calloc(1, sizeof(RRPCONNECTION));
+	if (connection == NULL) {
+		RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
+		return NULL;
+	}
+
+	connection->blocking = 1;
+	connection->socket = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (connection->socket < 0) {
+		free(connection);
+		RRPSetInternalErrorCode(RRP_SOCKET_CONNECT_ERROR);
+		return NULL;
+	}
+
+	/*
+	** A local connection is accepted or refused at once, so there is no
+	** need to wait for it with poll()
+	*/
+	if (connect(connection->socket, (struct sockaddr *) &address,
+		sizeof(address)) < 0) {
+		RRPFreeConnection(connection);
+		RRPSetInternalErrorCode(RRP_SOCKET_CONNECT_ERROR);
+		return NULL;
+	}
+
+	connection->greeting = RRPReadConnectionResponse(connection);
+	if (connection->greeting == NULL) {
+		RRPFreeConnection(connection);
+		return NULL;
+	}
+
+	return connection;
+
+} /* RRPOpenLocalConnection */
+
+
+
+
+
+/*
+**
+** Function: RRPGetConnectionGreeting
+**
+** Description: Returns the greeting the RRP server sent when the
+**              connection was established (the server's version and
+**              current date, ending with ".\r\n")
+**
+** Input: RRPCONNECTION* - a connection handle
+**
+** Output: none
+**
+** Return: char* - the greeting. NULL is returned if an internal error
+**                 occurs. The string belongs to the connection
+**
+*/
+
+char*
+RRPGetConnectionGreeting (
+	RRPCONNECTION* connection
+) {
+	/*
+	** Validate parameters
+	*/
+	if (connection == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return NULL;
+	}
+
+	return connection->greeting;
+
+} /* RRPGetConnectionGreeting */
+
+
+
+
+
+/*
+**
+** Function: RRPGetConnectionDescriptor
+**
+** Description: Returns the file descriptor of a connection, to wait for
+**              it to become readable or writable with poll() or select()
+**
+** Input: RRPCONNECTION* - a connection handle
+**
+** Output: none
+**
+** Return: int - the file descriptor. -1 is returned if an internal error
+**               occurs.
+**
+*/
+
+int
+RRPGetConnectionDescriptor (
+	RRPCONNECTION* connection
+) {
+	/*
+	** Validate parameters
+	*/
+	if (connection == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	return connection->socket;
+
+} /* RRPGetConnectionDescriptor */
+
+
+
+
+
+/*
+**
+** Function: RRPSetConnectionBlocking
+**
+** Description: Switches a connection between blocking and non-blocking
+**              mode
+**
+** Input: RRPCONNECTION* - a connection handle
+**        int - 1 for blocking mode, 0 for non-blocking mode
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+
+int
+RRPSetConnectionBlocking (
+	RRPCONNECTION* connection,
+	int blocking
+) {
+	int flags = 0;
+
+	/*
+	** Validate parameters
+	*/
+	if (connection == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	flags = fcntl(connection->socket, F_GETFL);
+	if (flags < 0 || fcntl(connection->socket, F_SETFL,
+		blocking ? (flags & ~O_NONBLOCK) : (flags | O_NONBLOCK)) < 0) {
+		RRPSetInternalErrorCode(RRP_IO_ERROR);
+		return -1;
+	}
+
+	connection->blocking = blocking ? 1 : 0;
+
+	return 0;
+
+} /* RRPSetConnectionBlocking */
+
+
+
+
+
+/*
+**
+** Function: RRPWriteConnection
+**
+** Description: Writes request data to a connection. In blocking mode all
+**              of the data is written. In non-blocking mode only as much
+**              as the socket accepts without blocking is written
+**
+** Input: RRPCONNECTION* - a connection handle
+**        const char* - the data to write
+**        size_t - the number of characters to write
+**
+** Output: none
+**
+** Return: long - the number of characters written, which may be 0 in
+**                non-blocking mode. -1 is returned if an internal error
+**                or timeout occurs.
+**
+*/
+
+long
+RRPWriteConnection (
+	RRPCONNECTION* connection,
+	const char* data,
+	size_t size
+) {
+	size_t written = 0;
+	ssize_t byteCount = 0;
+
+	/*
+	** Validate parameters
+	*/
+	if (connection == NULL || data == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	while (written < size) {
+		if (connection->blocking &&
+			WaitForConnection(connection, POLLOUT) < 0) {
+			return -1;
+		}
+
+		byteCount = send(connection->socket, data + written, size - written,
+			RRP_SEND_FLAGS);
+
+		if (byteCount < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			if (errno == EAGAIN || errno == EWOULDBLOCK) {
+				if (!connection->blocking) {
+					break;
+				}
+				continue;
+			}
+			RRPSetInternalErrorCode(RRP_IO_ERROR);
+			return -1;
+		}
+
+		written += byteCount;
+	}
+
+	return (long) written;
+
+} /* RRPWriteConnection */
+
+
+
+
+
+/*
+**
+** Function: RRPFillConnection
+**
+** Description: Reads the data that is available on a connection into the
+**              connection's input buffer, from which responses are then
+**              taken by RRPNextConnectionResponse(). In blocking mode,
+**              waits until some data is available
+**
+** Input: RRPCONNECTION* - a connection handle
+**
+** Output: none
+**
+** Return: long - the number of characters read, which may be 0 in
+**                non-blocking mode. -1 is returned if the server closed
+**                the connection or if an internal error or timeout occurs.
+**
+*/
+
+long
+RRPFillConnection (
+	RRPCONNECTION* connection
+) {
+	ssize_t byteCount = 0;
+	size_t capacity = 0;
+	char* input = NULL;
+
+	/*
+	** Validate parameters
+	*/
+	if (connection == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	/*
+	** Move the unreturned data to the start of the buffer, then make
+	** sure there is room for a reasonable read
+	*/
+	if (connection->inputStart > 0) {
+		memmove(connection->input, connection->input + connection->inputStart,
+			connection->inputLength - connection->inputStart);
+		connection->inputLength -= connection->inputStart;
+		connection->inputScanned -= connection->inputStart;
+		connection->inputStart = 0;
+	}
+
+	if (connection->inputCapacity - connection->inputLength <
+		RRP_MIN_READ_SIZE) {
+		capacity = connection->inputCapacity * 2;
+		if (capacity < connection->inputLength + RRP_MIN_READ_SIZE) {
+			capacity = connection->inputLength + RRP_MIN_READ_SIZE;
+		}
+
+		input = (char*) realloc(connection->input, capacity);
+		if (input == NULL) {
+			RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
+			return -1;
+		}
+
+		connection->input = input;
+		connection->inputCapacity = capacity;
+	}
+
+	for (;;) {
+		if (connection->blocking &&
+			WaitForConnection(connection, POLLIN) < 0) {
+			return -1;
+		}
+
+		byteCount = read(connection->socket,
+			connection->input + connection->inputLength,
+			connection->inputCapacity - connection->inputLength);
+
+		if (byteCount > 0) {
+			connection->inputLength += byteCount;
+			return (long) byteCount;
+		}
+
+		if (byteCount == 0) {
+			RRPSetInternalErrorCode(RRP_NOT_CONNECTED_ERROR);
+			return -1;
+		}
+
+		if (errno == EAGAIN || errno == EWOULDBLOCK) {
+			if (!connection->blocking) {
+				return 0;
+			}
+		}
+		else if (errno != EINTR) {
+			RRPSetInternalErrorCode(RRP_IO_ERROR);
+			return -1;
+		}
+	}
+
+} /* RRPFillConnection */
+
+
+
+
+
+/*
+**
+** Function: RRPNextConnectionResponse
+**
+** Description: Takes the next complete response string out of the input
+**              buffer of a connection. Does not read from the connection
+**              (see RRPFillConnection()). Each character is examined only
+**              once however many times this function is called while a
+**              response is incomplete
+**
+** Input: RRPCONNECTION* - a connection handle
+**
+** Output: char** - the response string, or NULL if the input buffer does
+**                  not hold a complete response
+**
+** Return: int - 1 is returned if a response was returned, 0 if no complete
+**               response is available. -1 is returned if an internal
+**               error occurs.
+**
+** Note: THE MEMORY USED FOR THE RRP RESPONSE STRING IS ALLOCATED DYNAMICALLY
+**       AND MUST BE RELEASED BY THE CALLER OF THE FUNCTION
+**
+*/
+
+int
+RRPNextConnectionResponse (
+	RRPCONNECTION* connection,
+	char** response
+) {
+	char* input = NULL;
+	size_t i = 0;
+	size_t end = 0;
+
+	/*
+	** Validate parameters
+	*/
+	if (connection == NULL || response == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	*response = NULL;
+	input = connection->input;
+
+	for (i = connection->inputScanned; i + 5 <= connection->inputLength; i++) {
+		if (input[i] == '\r' && memcmp(input + i, "\r\n.\r\n", 5) == 0) {
+			break;
+		}
+	}
+
+	if (i + 5 > connection->inputLength) {
+		connection->inputScanned = i;
+		return 0;
+	}
+
+	end = i + 5;
+
+	*response = (char*) malloc(end - connection->inputStart + 1);
+	if (*response == NULL) {
+		RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
+		return -1;
+	}
+
+	memcpy(*response, input + connection->inputStart,
+		end - connection->inputStart);
+	(*response)[end - connection->inputStart] = '\0';
+
+	if (end == connection->inputLength) {
+		connection->inputStart = 0;
+		connection->inputLength = 0;
+		connection->inputScanned = 0;
+	}
+	else {
+		connection->inputStart = end;
+		connection->inputScanned = end;
+	}
+
+	return 1;
+
+} /* RRPNextConnectionResponse */
+
+
+
+
+
+/*
+**
+** Function: RRPReadConnectionResponse
+**
+** Description: Reads and returns the next response string from a
+**              connection in blocking mode
+**
+** Input: RRPCONNECTION* - a connection handle
+**
+** Output: none
+**
+** Return: char* - the RRP response string is returned if successful.
+**                 NULL is returned if an internal error or timeout occurs.
+**
+** Note: THE MEMORY USED FOR THE RRP RESPONSE STRING IS ALLOCATED DYNAMICALLY
+**       AND MUST BE RELEASED BY THE CALLER OF THE FUNCTION
+**
+*/
+
+char*
+RRPReadConnectionResponse (
+	RRPCONNECTION* connection
+) {
+	char* response = NULL;
+	long byteCount = 0;
+	int result = 0;
+
+	/*
+	** Validate parameters
+	*/
+	if (connection == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return NULL;
+	}
+
+	while ((result = RRPNextConnectionResponse(connection, &response)) == 0) {
+		byteCount = RRPFillConnection(connection);
+
+		if (byteCount < 0 || (byteCount == 0 &&
+			WaitForConnection(connection, POLLIN) < 0)) {
+			return NULL;
+		}
+	}
+
+	return result > 0 ? response : NULL;
+
+} /* RRPReadConnectionResponse */
+
+
+
+
+
+/*
+**
+** Function: RRPFreeConnection
+**
+** Description: Closes a connection and frees its handle
+**
+** Input: RRPCONNECTION* - a connection handle
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+
+int
+RRPFreeConnection (
+	RRPCONNECTION* connection
+) {
+	/*
+	** Validate parameters
+	*/
+	if (connection == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	if (connection->socket >= 0) {
+		shutdown(connection->socket, 2);
+		close(connection->socket);
+	}
+
+	free(connection->greeting);
+	free(connection->input);
+	free(connection);
+
+	return 0;
+
+} /* RRPFreeConnection */
+
+
+
+
+
 
 /*
 ** For internal use only
@@ -487,6 +1269,47 @@ GetInAddrFromString (
 
 
 
+/*
+** For internal use only
+**
+** Waits until a connection handle is ready for 'events' (POLLIN or
+** POLLOUT), for at most the timeout set by RRPSetTimeout(). Returns 0 if
+** it is ready. Returns -1 and sets error code on timeout or error.
+*/
+static int
+WaitForConnection (
+	RRPCONNECTION* connection,
+	short events
+) {
+	struct pollfd descriptor;
+	int result = 0;
+
+	descriptor.fd = connection->socket;
+	descriptor.events = events;
+	descriptor.revents = 0;
+
+	do {
+		result = poll(&descriptor, 1, _timeout > 0 ? (int) _timeout * 1000 : -1);
+	} while (result < 0 && errno == EINTR);
+
+	if (result == 0) {
+		RRPSetInternalErrorCode(RRP_TIMEOUT_ERROR);
+		return -1;
+	}
+
+	if (result < 0) {
+		RRPSetInternalErrorCode(RRP_IO_ERROR);
+		return -1;
+	}
+
+	return 0;
+
+} /* WaitForConnection */
+
+
+
+
+
 
 /*
 ** For internal use only
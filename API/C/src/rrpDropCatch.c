@@ -0,0 +1,287 @@
+/* ===========================================================================
+ * Copyright (C) 2000 VeriSign, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * VeriSign Global Registry Service
+ * 21345 Ridgetop Circle
+ * Dulles, VA 20166
+ * ===========================================================================
+ * The RRP, APIs and Software are provided "as-is" and without any warranty
+ * of any kind.  NSI EXPRESSLY DISCLAIMS ALL WARRANTIES AND/OR CONDITIONS,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * AND CONDITIONS OF MERCHANTABILITY OR SATISFACTORY QUALITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE AND NONINFRINGEMENT OF THIRD PARTY RIGHTS.  NSI DOES
+ * NOT WARRANT THAT THE FUNCTIONS CONTAINED IN THE RRP, APIs OR SOFTWARE
+ * WILL MEET REGISTRAR'S REQUIREMENTS, OR THAT THE OPERATION OF THE RRP,
+ * APIs OR SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE,OR THAT DEFECTS IN
+ * THE RRP, APIs OR SOFTWARE WILL BE CORRECTED.  FURTHERMORE, NSI DOES NOT
+ * WARRANT NOR MAKE ANY REPRESENTATIONS REGARDING THE USE OR THE RESULTS OF
+ * THE RRP, APIs, SOFTWARE OR RELATED DOCUMENTATION IN TERMS OF THEIR
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR OTHERWISE.  SHOULD THE RRP, APIs
+ * OR SOFTWARE PROVE DEFECTIVE, REGISTRAR ASSUMES THE ENTIRE COST OF ALL
+ * NECESSARY SERVICING, REPAIR OR CORRECTION.
+ * ======================================================================== */
+
+/*
+**
+** Module Name: rrpDropCatch.c
+**
+** Version: 2.1 for RRP version 2.1.0
+**
+** Date: Oct. 19th, 2026
+**
+** Description: rrpDropCatch sends Add commands for a list of domain names
+**              on a number of sessions at an exact instant of the
+**              registry's clock (see rrpFire.h), and reports the timing
+**              of each attempt.
+**
+**              The sessions are opened and the commands formatted when
+**              the program starts. The estimated offset of the
+**              registry's clock is displayed on the standard error. One
+**              line is written on the standard output for each attempt:
+**
+**                session,domain,code,late,send,response
+**
+**              where 'late' is the time from the session's instant to
+**              the moment its thread woke up, 'send' the time the write
+**              of the burst took, and 'response' the time from the end
+**              of the write to the arrival of the response, all in
+**              microseconds.
+**
+** Usage:       rrpDropCatch -h host [-p port] -u id [-w password]
+**                  -t "YYYY-MM-DD HH:MM:SS[.fraction]" [-s sessions]
+**                  [-g stagger] [-n nameserver]... [-y years] [-l]
+**                  domain...
+**
+**              The time is the registry's time, in UTC. The stagger is
+**              in microseconds. -l uses the local clock instead of the
+**              estimated offset. The password is taken from the
+**              RRP_PASSWORD environment variable if -w is not given.
+**
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "rrpAPI.h"
+#include "rrpFire.h"
+#include "rrpInternalError.h"
+
+static void usage (char*);
+static int parseInstant (char*, struct timespec*);
+static double difference (struct timespec*, struct timespec*);
+
+int
+main (
+	int argc,
+	char** argv
+) {
+	RRPFIRE* fire = NULL;
+	RRPFIREATTEMPT* attempts = NULL;
+	RRPVECTOR* nameServers = NULL;
+	struct timespec instant;
+	struct timespec scheduled;
+	char* host = NULL;
+	char* registrarID = NULL;
+	char* registrarPassword = getenv("RRP_PASSWORD");
+	char* when = NULL;
+	unsigned short int port = 648;
+	int sessions = 4;
+	int period = 0;
+	int localClock = 0;
+	int count = 0;
+	int option = 0;
+	int i = 0;
+	long stagger = 0;
+	double offset = 0;
+	double error = 0;
+	double local = 0;
+
+	nameServers = RRPCreateVector();
+	if (nameServers == NULL) {
+		RRPPrintInternalErrorDescription();
+		exit(1);
+	}
+
+	while ((option = getopt(argc, argv, "h:p:u:w:t:s:g:n:y:l")) != -1) {
+		switch (option) {
+			case 'h': host = optarg; break;
+			case 'p': port = (unsigned short int) atoi(optarg); break;
+			case 'u': registrarID = optarg; break;
+			case 'w': registrarPassword = optarg; break;
+			case 't': when = optarg; break;
+			case 's': sessions = atoi(optarg); break;
+			case 'g': stagger = atol(optarg) * 1000L; break;
+			case 'n': RRPAddVectorElement(nameServers, optarg); break;
+			case 'y': period = atoi(optarg); break;
+			case 'l': localClock = 1; break;
+			default: usage(argv[0]);
+		}
+	}
+
+	if (host == NULL || registrarID == NULL || registrarPassword == NULL ||
+		when == NULL || sessions < 1 || stagger < 0 || period < 0 ||
+		optind == argc) {
+		usage(argv[0]);
+	}
+
+	if (parseInstant(when, &instant) < 0) {
+		fprintf(stderr, "Invalid time: %s\n", when);
+		exit(2);
+	}
+
+	fire = RRPCreateFire(host, port, registrarID, registrarPassword, sessions);
+	if (fire == NULL) {
+		RRPPrintInternalErrorDescription();
+		exit(1);
+	}
+
+	for (i = optind; i < argc; i++) {
+		if (RRPAddFireDomain(fire, argv[i], nameServers, period) < 0) {
+			RRPPrintInternalErrorDescription();
+			exit(1);
+		}
+	}
+
+	RRPFreeVector(nameServers);
+
+	if (localClock) {
+		RRPSetFireClockOffset(fire, 0);
+	}
+
+	if (RRPGetFireClockOffset(fire, &offset, &error) < 0) {
+		fprintf(stderr, "The greeting has no date: use -l\n");
+		exit(1);
+	}
+
+	fprintf(stderr, "Clock offset %.6f s (error %.6f s), %d sessions ready\n",
+		offset, error, sessions);
+
+	if (RRPFireAt(fire, &instant, stagger) < 0) {
+		RRPPrintInternalErrorDescription();
+		exit(1);
+	}
+
+	attempts = RRPGetFireAttempts(fire, &count);
+	local = (double) instant.tv_sec + instant.tv_nsec / 1e9 - offset;
+
+	for (i = 0; i < count; i++) {
+		/*
+		** Local instant of the attempt's session
+		*/
+		double session = local + attempts[i].session * (stagger / 1e9);
+
+		scheduled.tv_sec = (time_t) session;
+		scheduled.tv_nsec = (long) ((session - (double) scheduled.tv_sec) *
+			1e9);
+
+		printf("%d,%s,%d,%.0f,%.0f,%.0f\n", attempts[i].session,
+			argv[optind + attempts[i].domain], attempts[i].code,
+			difference(&scheduled, &attempts[i].woke),
+			difference(&attempts[i].woke, &attempts[i].sent),
+			attempts[i].code != -1 ?
+				difference(&attempts[i].sent, &attempts[i].received) : 0.0);
+	}
+
+	RRPFreeFire(fire);
+
+	exit(0);
+
+} /* main() */
+
+
+/*
+** Prints the usage message and exits
+*/
+static void
+usage (
+	char* program
+) {
+	fprintf(stderr, "Usage: %s -h host [-p port] -u id [-w password]\n"
+		"\t-t \"YYYY-MM-DD HH:MM:SS[.fraction]\" [-s sessions] [-g stagger]\n"
+		"\t[-n nameserver]... [-y years] [-l] domain...\n"
+		"\n"
+		"\t-t\tregistry time to send at, in UTC\n"
+		"\t-s\tnumber of sessions (default 4)\n"
+		"\t-g\tmicroseconds between the sessions' bursts (default 0)\n"
+		"\t-n\tname server of the domains\n"
+		"\t-y\tregistration period in years\n"
+		"\t-l\tuse the local clock rather than the registry's\n"
+		"\n"
+		"The password is read from RRP_PASSWORD if -w is not given.\n",
+		program);
+	exit(2);
+
+} /* usage() */
+
+
+/*
+** Converts "YYYY-MM-DD HH:MM:SS[.fraction]" (UTC) to a struct timespec.
+** Returns 0 if successful, -1 otherwise.
+*/
+static int
+parseInstant (
+	char* text,
+	struct timespec* instant
+) {
+	struct tm date;
+	double second = 0;
+	time_t seconds = 0;
+
+	memset(&date, 0, sizeof(date));
+
+	if (sscanf(text, "%d-%d-%d %d:%d:%lf", &date.tm_year, &date.tm_mon,
+		&date.tm_mday, &date.tm_hour, &date.tm_min, &second) != 6 ||
+		second < 0 || second >= 61) {
+		return -1;
+	}
+
+	date.tm_year -= 1900;
+	date.tm_mon -= 1;
+	date.tm_sec = (int) second;
+
+	/*
+	** mktime() works in local time
+	*/
+	setenv("TZ", "UTC", 1);
+	tzset();
+
+	if ((seconds = mktime(&date)) == (time_t) -1) {
+		return -1;
+	}
+
+	instant->tv_sec = seconds;
+	instant->tv_nsec = (long) ((second - (int) second) * 1e9);
+
+	return 0;
+
+} /* parseInstant() */
+
+
+/*
+** Returns the time from 'from' to 'to' in microseconds
+*/
+static double
+difference (
+	struct timespec* from,
+	struct timespec* to
+) {
+	return (to->tv_sec - from->tv_sec) * 1e6 +
+		(to->tv_nsec - from->tv_nsec) / 1e3;
+
+} /* difference() */
@@ -0,0 +1,1034 @@
+/* ===========================================================================
+ * Copyright (C) 2000 VeriSign, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * VeriSign Global Registry Service
+ * 21345 Ridgetop Circle
+ * Dulles, VA 20166
+ * ===========================================================================
+ * The RRP, APIs and Software are provided "as-is" and without any warranty
+ * of any kind.  NSI EXPRESSLY DISCLAIMS ALL WARRANTIES AND/OR CONDITIONS,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * AND CONDITIONS OF MERCHANTABILITY OR SATISFACTORY QUALITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE AND NONINFRINGEMENT OF THIRD PARTY RIGHTS.  NSI DOES
+ * NOT WARRANT THAT THE FUNCTIONS CONTAINED IN THE RRP, APIs OR SOFTWARE
+ * WILL MEET REGISTRAR'S REQUIREMENTS, OR THAT THE OPERATION OF THE RRP,
+ * APIs OR SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE,OR THAT DEFECTS IN
+ * THE RRP, APIs OR SOFTWARE WILL BE CORRECTED.  FURTHERMORE, NSI DOES NOT
+ * WARRANT NOR MAKE ANY REPRESENTATIONS REGARDING THE USE OR THE RESULTS OF
+ * THE RRP, APIs, SOFTWARE OR RELATED DOCUMENTATION IN TERMS OF THEIR
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR OTHERWISE.  SHOULD THE RRP, APIs
+ * OR SOFTWARE PROVE DEFECTIVE, REGISTRAR ASSUMES THE ENTIRE COST OF ALL
+ * NECESSARY SERVICING, REPAIR OR CORRECTION.
+ * ======================================================================== */
+
+/*
+**
+** Module Name: rrpEndpoint.c
+**
+** Version: 2.1 for RRP version 2.1.0
+**
+** Date: Oct. 19th, 2026
+**
+** Description: rrpEndpoint scores RRP servers and keeps a circuit
+**              breaker for each of them (see rrpEndpoint.h). The
+**              endpoints of a set share one mutex. Latency and error
+**              rate are exponentially weighted moving averages, updated
+**              with each event reported, so recent events count most
+**              and a server that degrades loses its sessions within a
+**              few dozen commands.
+**
+** Entry Points:
+**
+**    RRPCreateEndpoints(void);
+**    RRPAddEndpoint(RRPENDPOINTS*, char*, unsigned short int);
+**    RRPParseEndpoints(char*, unsigned short int);
+**    RRPSetEndpointBreaker(RRPENDPOINTS*, int, int);
+**    RRPGetEndpointCount(RRPENDPOINTS*);
+**    RRPGetEndpointHost(RRPENDPOINTS*, int);
+**    RRPGetEndpointPort(RRPENDPOINTS*, int);
+**    RRPPickEndpoint(RRPENDPOINTS*);
+**    RRPReportEndpoint(RRPENDPOINTS*, int, RRPENDPOINTEVENT, long);
+**    RRPReleaseEndpoint(RRPENDPOINTS*, int);
+**    RRPIsEndpointHealthy(RRPENDPOINTS*, int);
+**    RRPGetEndpointStatistics(RRPENDPOINTS*, int, RRPENDPOINTSTATISTICS*);
+**    RRPFreeEndpoints(RRPENDPOINTS*);
+**
+** Changes:
+**
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include "rrpEndpoint.h"
+#include "rrpInternalError.h"
+
+/*
+** Weight of a new sample in the moving averages, error rate above which
+** a breaker opens, and how much the error rate weighs in the score
+*/
+#define ENDPOINT_SMOOTHING 0.2
+#define ENDPOINT_ERROR_LIMIT 0.5
+#define ENDPOINT_ERROR_WEIGHT 10
+
+typedef struct {
+	char* host;
+	unsigned short int port;
+	RRPENDPOINTSTATISTICS statistics;
+	int failures;               /* connections failed in a row */
+	double failed;              /* when the last one failed, in seconds */
+	double opened;              /* when the breaker opened, in seconds */
+} RRPENDPOINT;
+
+struct _RRPENDPOINTS {
+	pthread_mutex_t mutex;
+	RRPENDPOINT* endpoints;
+	int count;
+	int capacity;
+	int breakerFailures;
+	double breakerCooldown;     /* seconds */
+};
+
+
+/*
+** Functions used internally by the set of endpoints
+*/
+static double getEndpointTime (void);
+static double getEndpointScore (RRPENDPOINT*);
+static void sampleEndpoint (RRPENDPOINT*, double, long);
+static void tripEndpoint (RRPENDPOINT*, double);
+
+
+
+
+/*
+**
+** Function: RRPCreateEndpoints
+**
+** Description: Creates an empty set of endpoints, with the default
+**              circuit breaker
+**
+** Input: none
+**
+** Output: none
+**
+** Return: RRPENDPOINTS* - a pointer to an RRPENDPOINTS structure. NULL is
+**                         returned if an internal error occurs.
+**
+** Note: THE SET MUST BE RELEASED BY CALLING RRPFreeEndpoints()
+**
+*/
+
+RRPENDPOINTS*
+RRPCreateEndpoints (void) {
+	RRPENDPOINTS* endpoints = NULL;
+
+	endpoints = (RRPENDPOINTS*) calloc(1, sizeof(RRPENDPOINTS));
+	if (endpoints == NULL) {
+		RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
+		return NULL;
+	}
+
+	pthread_mutex_init(&endpoints->mutex, NULL);
+	endpoints->breakerFailures = RRP_DEFAULT_BREAKER_FAILURES;
+	endpoints->breakerCooldown = RRP_DEFAULT_BREAKER_COOLDOWN / 1000.0;
+
+	return endpoints;
+
+} /* RRPCreateEndpoints */
+
+
+
+
+
+
+/*
+**
+** Function: RRPAddEndpoint
+**
+** Description: Adds an RRP server to a set of endpoints
+**
+** Input: RRPENDPOINTS* - a pointer to an RRPENDPOINTS structure
+**        char* - host name or IP address of RRP server
+**        unsigned short int - RRP server port
+**
+** Output: none
+**
+** Return: int - the index of the endpoint in the set. -1 is returned if
+**               an internal error occurs.
+**
+*/
+
+int
+RRPAddEndpoint (
+	RRPENDPOINTS* endpoints,
+	char* host,
+	unsigned short int port
+) {
+	RRPENDPOINT* endpoint = NULL;
+	RRPENDPOINT* grown = NULL;
+	char* copy = NULL;
+	int capacity = 0;
+	int index = 0;
+
+	/*
+	** Validate parameters
+	*/
+	if (endpoints == NULL || host == NULL || *host == '\0') {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	copy = (char*) malloc(strlen(host) + 1);
+	if (copy == NULL) {
+		RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
+		return -1;
+	}
+	strcpy(copy, host);
+
+	pthread_mutex_lock(&endpoints->mutex);
+
+	if (endpoints->count == endpoints->capacity) {
+		capacity = endpoints->capacity > 0 ? endpoints->capacity * 2 : 4;
+		grown = (RRPENDPOINT*) realloc(endpoints->endpoints,
+			capacity * sizeof(RRPENDPOINT));
+		if (grown == NULL) {
+			pthread_mutex_unlock(&endpoints->mutex);
+			free(copy);
+			RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
+			return -1;
+		}
+		endpoints->endpoints = grown;
+		endpoints->capacity = capacity;
+	}
+
+	index = endpoints->count++;
+	endpoint = &endpoints->endpoints[index];
+	memset(endpoint, 0, sizeof(RRPENDPOINT));
+	endpoint->host = copy;
+	endpoint->port = port;
+	endpoint->statistics.state = RRP_BREAKER_CLOSED;
+
+	pthread_mutex_unlock(&endpoints->mutex);
+
+	return index;
+
+} /* RRPAddEndpoint */
+
+
+
+
+
+
+/*
+**
+** Function: RRPParseEndpoints
+**
+** Description: Creates a set of endpoints from a list of the form
+**              "host[:port][,host[:port]...]"
+**
+** Input: char* - the list
+**        unsigned short int - port of the hosts listed without one
+**
+** Output: none
+**
+** Return: RRPENDPOINTS* - a pointer to an RRPENDPOINTS structure. NULL is
+**                         returned if an internal error occurs or if
+**                         the list is empty or malformed
+**                         (RRP_BAD_PARAM_ERROR).
+**
+** Note: THE SET MUST BE RELEASED BY CALLING RRPFreeEndpoints()
+**
+*/
+
+RRPENDPOINTS*
+RRPParseEndpoints (
+	char* list,
+	unsigned short int defaultPort
+) {
+	RRPENDPOINTS* endpoints = NULL;
+	char* copy = NULL;
+	char* host = NULL;
+	char* next = NULL;
+	char* colon = NULL;
+	char* end = NULL;
+	long port = 0;
+	int result = 0;
+
+	/*
+	** Validate parameters
+	*/
+	if (list == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return NULL;
+	}
+
+	copy = (char*) malloc(strlen(list) + 1);
+	endpoints = RRPCreateEndpoints();
+	if (copy == NULL || endpoints == NULL) {
+		free(copy);
+		if (endpoints != NULL) {
+			RRPFreeEndpoints(endpoints);
+		}
+		RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
+		return NULL;
+	}
+	strcpy(copy, list);
+
+	for (host = copy; host != NULL && result >= 0; host = next) {
+		next = strchr(host, ',');
+		if (next != NULL) {
+			*next++ = '\0';
+		}
+
+		port = defaultPort;
+		colon = strrchr(host, ':');
+		if (colon != NULL) {
+			*colon = '\0';
+			port = strtol(colon + 1, &end, 10);
+			if (end == colon + 1 || *end != '\0' || port < 1 ||
+				port > 65535) {
+				RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+				result = -1;
+				break;
+			}
+		}
+
+		result = RRPAddEndpoint(endpoints, host, (unsigned short int) port);
+	}
+
+	free(copy);
+
+	if (result < 0) {
+		result = RRPGetInternalErrorCode();
+		RRPFreeEndpoints(endpoints);
+		RRPSetInternalErrorCode((RRPINTERNAL_ERROR_CODE) result);
+		return NULL;
+	}
+
+	return endpoints;
+
+} /* RRPParseEndpoints */
+
+
+
+
+
+
+/*
+**
+** Function: RRPSetEndpointBreaker
+**
+** Description: Sets when the circuit breakers of a set of endpoints open
+**              and for how long
+**
+** Input: RRPENDPOINTS* - a pointer to an RRPENDPOINTS structure
+**        int - connections in a row that could not be opened or were
+**              lost after which a breaker opens (1 or more)
+**        int - milliseconds a breaker stays open before a trial session
+**              is let through
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+
+int
+RRPSetEndpointBreaker (
+	RRPENDPOINTS* endpoints,
+	int failures,
+	int cooldown
+) {
+	/*
+	** Validate parameters
+	*/
+	if (endpoints == NULL || failures < 1 || cooldown < 0) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	pthread_mutex_lock(&endpoints->mutex);
+	endpoints->breakerFailures = failures;
+	endpoints->breakerCooldown = cooldown / 1000.0;
+	pthread_mutex_unlock(&endpoints->mutex);
+
+	return 0;
+
+} /* RRPSetEndpointBreaker */
+
+
+
+
+
+
+/*
+**
+** Function: RRPGetEndpointCount
+**
+** Description: Returns the number of endpoints in a set
+**
+** Input: RRPENDPOINTS* - a pointer to an RRPENDPOINTS structure
+**
+** Output: none
+**
+** Return: int - the number of endpoints. -1 is returned if an internal
+**               error occurs.
+**
+*/
+
+int
+RRPGetEndpointCount (
+	RRPENDPOINTS* endpoints
+) {
+	int count = 0;
+
+	/*
+	** Validate parameters
+	*/
+	if (endpoints == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	pthread_mutex_lock(&endpoints->mutex);
+	count = endpoints->count;
+	pthread_mutex_unlock(&endpoints->mutex);
+
+	return count;
+
+} /* RRPGetEndpointCount */
+
+
+
+
+
+
+/*
+**
+** Function: RRPGetEndpointHost
+**
+** Description: Returns the host of an endpoint
+**
+** Input: RRPENDPOINTS* - a pointer to an RRPENDPOINTS structure
+**        int - the index of the endpoint
+**
+** Output: none
+**
+** Return: char* - the host name or IP address. It belongs to the set.
+**                 NULL is returned if an internal error occurs.
+**
+*/
+
+char*
+RRPGetEndpointHost (
+	RRPENDPOINTS* endpoints,
+	int index
+) {
+	char* host = NULL;
+
+	/*
+	** Validate parameters
+	*/
+	if (endpoints == NULL || index < 0) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return NULL;
+	}
+
+	pthread_mutex_lock(&endpoints->mutex);
+	if (index < endpoints->count) {
+		host = endpoints->endpoints[index].host;
+	}
+	pthread_mutex_unlock(&endpoints->mutex);
+
+	if (host == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+	}
+
+	return host;
+
+} /* RRPGetEndpointHost */
+
+
+
+
+
+
+/*
+**
+** Function: RRPGetEndpointPort
+**
+** Description: Returns the port of an endpoint
+**
+** Input: RRPENDPOINTS* - a pointer to an RRPENDPOINTS structure
+**        int - the index of the endpoint
+**
+** Output: none
+**
+** Return: int - the port. -1 is returned if an internal error occurs.
+**
+*/
+
+int
+RRPGetEndpointPort (
+	RRPENDPOINTS* endpoints,
+	int index
+) {
+	int port = -1;
+
+	/*
+	** Validate parameters
+	*/
+	if (endpoints == NULL || index < 0) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	pthread_mutex_lock(&endpoints->mutex);
+	if (index < endpoints->count) {
+		port = endpoints->endpoints[index].port;
+	}
+	pthread_mutex_unlock(&endpoints->mutex);
+
+	if (port < 0) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+	}
+
+	return port;
+
+} /* RRPGetEndpointPort */
+
+
+
+
+
+
+/*
+**
+** Function: RRPPickEndpoint
+**
+** Description: Chooses the endpoint a new connection should go to, and
+**              counts a session on it until RRPReleaseEndpoint() is
+**              called. If the endpoint's breaker has finished its
+**              cool-down, the session is its trial
+**
+** Input: RRPENDPOINTS* - a pointer to an RRPENDPOINTS structure
+**
+** Output: none
+**
+** Return: int - the index of the endpoint. -1 is returned if an
+**               internal error occurs or if the set is empty
+**               (RRP_BAD_PARAM_ERROR).
+**
+*/
+
+int
+RRPPickEndpoint (
+	RRPENDPOINTS* endpoints
+) {
+	RRPENDPOINT* endpoint = NULL;
+	double now = 0;
+	double score = 0;
+	double bestScore = 0;
+	int failed = 0;
+	int bestFailed = 0;
+	int best = -1;
+	int i = 0;
+
+	/*
+	** Validate parameters
+	*/
+	if (endpoints == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	pthread_mutex_lock(&endpoints->mutex);
+
+	if (endpoints->count == 0) {
+		pthread_mutex_unlock(&endpoints->mutex);
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	now = getEndpointTime();
+
+	for (i = 0; i < endpoints->count; i++) {
+		endpoint = &endpoints->endpoints[i];
+
+		/*
+		** An open breaker lets one session through once it has cooled
+		** down; no other session goes there until that one connects
+		*/
+		if (endpoint->statistics.state == RRP_BREAKER_TRIAL ||
+			(endpoint->statistics.state == RRP_BREAKER_OPEN &&
+			now - endpoint->opened < endpoints->breakerCooldown)) {
+			continue;
+		}
+
+		/*
+		** An endpoint whose last connection failed less than a cooldown
+		** ago comes after every other one, whatever its latency
+		*/
+		failed = endpoint->failures > 0 &&
+			now - endpoint->failed < endpoints->breakerCooldown;
+		score = getEndpointScore(endpoint);
+		if (best < 0 || failed < bestFailed ||
+			(failed == bestFailed && score < bestScore)) {
+			best = i;
+			bestScore = score;
+			bestFailed = failed;
+		}
+	}
+
+	/*
+	** Nothing is closed: rather than failing, try the endpoint that has
+	** been left alone the longest
+	*/
+	if (best < 0) {
+		for (i = 0; i < endpoints->count; i++) {
+			endpoint = &endpoints->endpoints[i];
+			if (best < 0 || endpoint->opened < bestScore) {
+				best = i;
+				bestScore = endpoint->opened;
+			}
+		}
+	}
+
+	endpoint = &endpoints->endpoints[best];
+	if (endpoint->statistics.state == RRP_BREAKER_OPEN &&
+		now - endpoint->opened >= endpoints->breakerCooldown) {
+		endpoint->statistics.state = RRP_BREAKER_TRIAL;
+	}
+	endpoint->statistics.sessions++;
+
+	pthread_mutex_unlock(&endpoints->mutex);
+
+	return best;
+
+} /* RRPPickEndpoint */
+
+
+
+
+
+
+/*
+**
+** Function: RRPReportEndpoint
+**
+** Description: Records what happened on an endpoint
+**
+** Input: RRPENDPOINTS* - a pointer to an RRPENDPOINTS structure
+**        int - the index of the endpoint
+**        RRPENDPOINTEVENT - what happened
+**        long - for RRP_ENDPOINT_CONNECTED, the microseconds taken to
+**               connect and log in; for RRP_ENDPOINT_RESPONDED, the
+**               microseconds from sending the command to reading its
+**               response. Ignored otherwise
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+
+int
+RRPReportEndpoint (
+	RRPENDPOINTS* endpoints,
+	int index,
+	RRPENDPOINTEVENT event,
+	long latency
+) {
+	RRPENDPOINT* endpoint = NULL;
+	RRPENDPOINTSTATISTICS* statistics = NULL;
+
+	/*
+	** Validate parameters
+	*/
+	if (endpoints == NULL || index < 0 || (int) event < 0 ||
+		event > RRP_ENDPOINT_FAILED) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	pthread_mutex_lock(&endpoints->mutex);
+
+	if (index >= endpoints->count) {
+		pthread_mutex_unlock(&endpoints->mutex);
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	endpoint = &endpoints->endpoints[index];
+	statistics = &endpoint->statistics;
+
+	switch (event) {
+		case RRP_ENDPOINT_CONNECTED:
+			statistics->connected++;
+			endpoint->failures = 0;
+
+			/*
+			** A trial that connects closes the breaker, and the errors
+			** that opened it are forgotten
+			*/
+			if (statistics->state != RRP_BREAKER_CLOSED) {
+				statistics->state = RRP_BREAKER_CLOSED;
+				statistics->errorRate = 0;
+			}
+			sampleEndpoint(endpoint, 0, latency);
+			break;
+
+		case RRP_ENDPOINT_RESPONDED:
+			statistics->responded++;
+			sampleEndpoint(endpoint, 0, latency);
+			break;
+
+		case RRP_ENDPOINT_REFUSED:
+			statistics->refused++;
+			sampleEndpoint(endpoint, 1, 0);
+			if (statistics->state == RRP_BREAKER_CLOSED &&
+				statistics->errorRate > ENDPOINT_ERROR_LIMIT) {
+				tripEndpoint(endpoint, getEndpointTime());
+			}
+			break;
+
+		case RRP_ENDPOINT_FAILED:
+			statistics->failed++;
+			endpoint->failures++;
+			endpoint->failed = getEndpointTime();
+			sampleEndpoint(endpoint, 1, 0);
+			if (statistics->state != RRP_BREAKER_CLOSED ||
+				endpoint->failures >= endpoints->breakerFailures) {
+				tripEndpoint(endpoint, getEndpointTime());
+			}
+			break;
+	}
+
+	pthread_mutex_unlock(&endpoints->mutex);
+
+	return 0;
+
+} /* RRPReportEndpoint */
+
+
+
+
+
+
+/*
+**
+** Function: RRPReleaseEndpoint
+**
+** Description: Stops counting a session on an endpoint (see
+**              RRPPickEndpoint()), when its connection is closed or
+**              lost
+**
+** Input: RRPENDPOINTS* - a pointer to an RRPENDPOINTS structure
+**        int - the index of the endpoint
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+
+int
+RRPReleaseEndpoint (
+	RRPENDPOINTS* endpoints,
+	int index
+) {
+	RRPENDPOINTSTATISTICS* statistics = NULL;
+
+	/*
+	** Validate parameters
+	*/
+	if (endpoints == NULL || index < 0) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	pthread_mutex_lock(&endpoints->mutex);
+
+	if (index >= endpoints->count) {
+		pthread_mutex_unlock(&endpoints->mutex);
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	statistics = &endpoints->endpoints[index].statistics;
+	if (statistics->sessions > 0) {
+		statistics->sessions--;
+	}
+
+	/*
+	** A trial given up without a verdict: the next session tries again
+	*/
+	if (statistics->state == RRP_BREAKER_TRIAL) {
+		statistics->state = RRP_BREAKER_OPEN;
+	}
+
+	pthread_mutex_unlock(&endpoints->mutex);
+
+	return 0;
+
+} /* RRPReleaseEndpoint */
+
+
+
+
+
+
+/*
+**
+** Function: RRPIsEndpointHealthy
+**
+** Description: Tells whether sessions should stay on an endpoint
+**
+** Input: RRPENDPOINTS* - a pointer to an RRPENDPOINTS structure
+**        int - the index of the endpoint
+**
+** Output: none
+**
+** Return: RRPBOOLEAN - RRPFALSE if the endpoint's breaker is open and
+**                      the breaker of another endpoint is closed,
+**                      RRPTRUE otherwise or if an internal error occurs
+**
+*/
+
+RRPBOOLEAN
+RRPIsEndpointHealthy (
+	RRPENDPOINTS* endpoints,
+	int index
+) {
+	RRPBOOLEAN healthy = RRPTRUE;
+	int i = 0;
+
+	/*
+	** Validate parameters
+	*/
+	if (endpoints == NULL || index < 0) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return RRPTRUE;
+	}
+
+	pthread_mutex_lock(&endpoints->mutex);
+
+	if (index < endpoints->count &&
+		endpoints->endpoints[index].statistics.state == RRP_BREAKER_OPEN) {
+		for (i = 0; i < endpoints->count; i++) {
+			if (endpoints->endpoints[i].statistics.state ==
+				RRP_BREAKER_CLOSED) {
+				healthy = RRPFALSE;
+				break;
+			}
+		}
+	}
+
+	pthread_mutex_unlock(&endpoints->mutex);
+
+	return healthy;
+
+} /* RRPIsEndpointHealthy */
+
+
+
+
+
+
+/*
+**
+** Function: RRPGetEndpointStatistics
+**
+** Description: Returns the state and counts of an endpoint
+**
+** Input: RRPENDPOINTS* - a pointer to an RRPENDPOINTS structure
+**        int - the index of the endpoint
+**
+** Output: RRPENDPOINTSTATISTICS* - the state and counts
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+
+int
+RRPGetEndpointStatistics (
+	RRPENDPOINTS* endpoints,
+	int index,
+	RRPENDPOINTSTATISTICS* statistics
+) {
+	/*
+	** Validate parameters
+	*/
+	if (endpoints == NULL || index < 0 || statistics == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	pthread_mutex_lock(&endpoints->mutex);
+
+	if (index >= endpoints->count) {
+		pthread_mutex_unlock(&endpoints->mutex);
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	*statistics = endpoints->endpoints[index].statistics;
+
+	pthread_mutex_unlock(&endpoints->mutex);
+
+	return 0;
+
+} /* RRPGetEndpointStatistics */
+
+
+
+
+
+
+/*
+**
+** Function: RRPFreeEndpoints
+**
+** Description: Frees a set of endpoints. The sessions that use it must
+**              have been closed
+**
+** Input: RRPENDPOINTS* - a pointer to an RRPENDPOINTS structure
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+
+int
+RRPFreeEndpoints (
+	RRPENDPOINTS* endpoints
+) {
+	int i = 0;
+
+	/*
+	** Validate parameters
+	*/
+	if (endpoints == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	for (i = 0; i < endpoints->count; i++) {
+		free(endpoints->endpoints[i].host);
+	}
+
+	pthread_mutex_destroy(&endpoints->mutex);
+	free(endpoints->endpoints);
+	free(endpoints);
+
+	return 0;
+
+} /* RRPFreeEndpoints */
+
+
+
+
+
+
+/*
+** Returns the time of a clock that is not set back, in seconds
+*/
+static double
+getEndpointTime (void) {
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return now.tv_sec + now.tv_nsec / 1000000000.0;
+
+} /* getEndpointTime() */
+
+
+
+/*
+** Returns the score of an endpoint; the lower the better. An endpoint
+** not measured yet has a latency of 0 and so is tried before the others
+*/
+static double
+getEndpointScore (
+	RRPENDPOINT* endpoint
+) {
+	RRPENDPOINTSTATISTICS* statistics = &endpoint->statistics;
+
+	return (statistics->latency + 1) *
+		(1 + ENDPOINT_ERROR_WEIGHT * statistics->errorRate) *
+		(1 + endpoint->failures) * (1 + statistics->sessions);
+
+} /* getEndpointScore() */
+
+
+
+/*
+** Adds a sample to the moving averages of an endpoint: 'error' is 1 for
+** a failure and 0 for a success, which may come with its 'latency'
+*/
+static void
+sampleEndpoint (
+	RRPENDPOINT* endpoint,
+	double error,
+	long latency
+) {
+	RRPENDPOINTSTATISTICS* statistics = &endpoint->statistics;
+
+	statistics->errorRate += ENDPOINT_SMOOTHING *
+		(error - statistics->errorRate);
+
+	if (latency > 0) {
+		if (statistics->latency == 0) {
+			statistics->latency = latency;
+		}
+		else {
+			statistics->latency += ENDPOINT_SMOOTHING *
+				(latency - statistics->latency);
+		}
+	}
+
+} /* sampleEndpoint() */
+
+
+
+/*
+** Opens the breaker of an endpoint. A breaker that was already open
+** (every endpoint was failing) starts its cool-down again but does not
+** count as a new trip
+*/
+static void
+tripEndpoint (
+	RRPENDPOINT* endpoint,
+	double now
+) {
+	if (endpoint->statistics.state != RRP_BREAKER_OPEN) {
+		endpoint->statistics.trips++;
+	}
+
+	endpoint->statistics.state = RRP_BREAKER_OPEN;
+	endpoint->opened = now;
+
+} /* tripEndpoint() */
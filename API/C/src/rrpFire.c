@@ -0,0 +1,881 @@
+/* ===========================================================================
+ * Copyright (C) 2000 VeriSign, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * VeriSign Global Registry Service
+ * 21345 Ridgetop Circle
+ * Dulles, VA 20166
+ * ===========================================================================
+ * The RRP, APIs and Software are provided "as-is" and without any warranty
+ * of any kind.  NSI EXPRESSLY DISCLAIMS ALL WARRANTIES AND/OR CONDITIONS,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * AND CONDITIONS OF MERCHANTABILITY OR SATISFACTORY QUALITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE AND NONINFRINGEMENT OF THIRD PARTY RIGHTS.  NSI DOES
+ * NOT WARRANT THAT THE FUNCTIONS CONTAINED IN THE RRP, APIs OR SOFTWARE
+ * WILL MEET REGISTRAR'S REQUIREMENTS, OR THAT THE OPERATION OF THE RRP,
+ * APIs OR SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE,OR THAT DEFECTS IN
+ * THE RRP, APIs OR SOFTWARE WILL BE CORRECTED.  FURTHERMORE, NSI DOES NOT
+ * WARRANT NOR MAKE ANY REPRESENTATIONS REGARDING THE USE OR THE RESULTS OF
+ * THE RRP, APIs, SOFTWARE OR RELATED DOCUMENTATION IN TERMS OF THEIR
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR OTHERWISE.  SHOULD THE RRP, APIs
+ * OR SOFTWARE PROVE DEFECTIVE, REGISTRAR ASSUMES THE ENTIRE COST OF ALL
+ * NECESSARY SERVICING, REPAIR OR CORRECTION.
+ * ======================================================================== */
+
+/*
+**
+** Module Name: rrpFire.c
+**
+** Version: 2.1 for RRP version 2.1.0
+**
+** Date: Oct. 19th, 2026
+**
+** Description: rrpFire sends a burst of Add commands on a number of
+**              sessions at a given instant of the server's clock (see
+**              rrpFire.h).
+**
+** Entry Points:
+**
+**    RRPCreateFire(char*, unsigned short int, char*, char*, int);
+**    RRPAddFireDomain(RRPFIRE*, char*, RRPVECTOR*, int);
+**    RRPGetFireClockOffset(RRPFIRE*, double*, double*);
+**    RRPSetFireClockOffset(RRPFIRE*, double);
+**    RRPFireAt(RRPFIRE*, struct timespec*, long);
+**    RRPGetFireAttempts(RRPFIRE*, int*);
+**    RRPFreeFire(RRPFIRE*);
+**
+** Changes:
+**
+*/
+
+#ifdef __linux__
+	#define _GNU_SOURCE
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#ifdef __linux__
+	#include <sched.h>
+#endif
+#include "rrpFire.h"
+#include "rrpConnection.h"
+#include "rrpSession.h"
+#include "rrpInternalError.h"
+
+/*
+** A thread wakes up this long before its instant, then spins on the
+** clock, so that the time it takes to be scheduled is not added to the
+** instant
+*/
+#ifndef RRP_FIRE_SPIN_NANOSECONDS
+	#define RRP_FIRE_SPIN_NANOSECONDS 200000L
+#endif
+
+struct _RRPFIRE {
+	int size;                   /* number of sessions */
+	RRPCONNECTION** connections;
+	char* burst;                /* Add commands of all of the domains */
+	size_t burstLength;
+	size_t burstCapacity;
+	int domainCount;
+	double offset;              /* server's time less local time */
+	double error;               /* largest error of 'offset' */
+	RRPBOOLEAN offsetKnown;
+	RRPFIREATTEMPT* attempts;
+	int attemptCount;
+};
+
+/*
+** State of the thread of one session during RRPFireAt()
+*/
+typedef struct {
+	RRPFIRE* fire;
+	int index;                  /* session */
+	struct timespec instant;    /* local time to fire at */
+	int received;               /* number of responses */
+	pthread_t thread;
+} RRPFIRETHREAD;
+
+
+/*
+** Functions used internally to estimate the clock offset and to fire
+*/
+static int parseGreetingDate (char*, time_t*);
+static double toSeconds (struct timespec*);
+static void fromSeconds (double, struct timespec*);
+static void sleepUntil (struct timespec*);
+static void* fireSession (void*);
+static void closeFireConnection (RRPCONNECTION*);
+
+
+
+
+/*
+**
+** Function: RRPCreateFire
+**
+** Description: Opens and logs in a number of sessions to an RRP server,
+**              and estimates the offset of the server's clock
+**
+** Input: char* - host name or IP address of RRP server
+**        unsigned short int - RRP server port
+**        char* - registrar's id
+**        char* - registrar's password
+**        int - the number of sessions (1 or more)
+**
+** Output: none
+**
+** Return: RRPFIRE* - a pointer to an RRPFIRE structure. NULL is returned
+**                    if an internal error occurs or if a session can not
+**                    be opened.
+**
+** Note: THE STRUCTURE MUST BE RELEASED BY CALLING RRPFreeFire()
+**
+*/
+
+RRPFIRE*
+RRPCreateFire (
+	char* host,
+	unsigned short int port,
+	char* registrarID,
+	char* registrarPassword,
+	int size
+) {
+	RRPFIRE* fire = NULL;
+	RRPINTERNAL_ERROR_CODE error = RRP_NO_ERROR;
+	struct timespec before;
+	struct timespec after;
+	time_t serverTime = 0;
+	double low = 0;
+	double high = 0;
+	double sum = 0;
+	int dated = 0;
+	int i = 0;
+
+	/*
+	** Validate parameters
+	*/
+	if (host == NULL || registrarID == NULL || registrarPassword == NULL ||
+		size < 1) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return NULL;
+	}
+
+	fire = (RRPFIRE*) calloc(1, sizeof(RRPFIRE));
+	if (fire == NULL) {
+		RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
+		return NULL;
+	}
+
+	fire->connections = (RRPCONNECTION**) calloc(size,
+		sizeof(RRPCONNECTION*));
+	if (fire->connections == NULL) {
+		free(fire);
+		RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
+		return NULL;
+	}
+
+	fire->size = size;
+
+	for (i = 0; i < size; i++) {
+		clock_gettime(CLOCK_REALTIME, &before);
+		fire->connections[i] = RRPOpenConnection(host, port);
+		clock_gettime(CLOCK_REALTIME, &after);
+
+		if (fire->connections[i] == NULL ||
+			RRPLoginConnection(fire->connections[i], registrarID,
+				registrarPassword) < 0) {
+			error = RRPGetInternalErrorCode();
+			RRPFreeFire(fire);
+			RRPSetInternalErrorCode(error);
+			return NULL;
+		}
+
+		/*
+		** The server's clock read serverTime, to the second, at some
+		** time between the connect and the arrival of the greeting, so
+		** the offset lies between serverTime - after and
+		** serverTime + 1 - before
+		*/
+		if (parseGreetingDate(RRPGetConnectionGreeting(fire->connections[i]),
+			&serverTime) == 0) {
+			if (dated == 0 || (double) serverTime - toSeconds(&after) > low) {
+				low = (double) serverTime - toSeconds(&after);
+			}
+			if (dated == 0 ||
+				(double) serverTime + 1 - toSeconds(&before) < high) {
+				high = (double) serverTime + 1 - toSeconds(&before);
+			}
+			sum += (double) serverTime + 0.5 -
+				(toSeconds(&before) + toSeconds(&after)) / 2;
+			dated++;
+		}
+	}
+
+	if (dated > 0) {
+		fire->offsetKnown = RRPTRUE;
+
+		if (low <= high) {
+			fire->offset = (low + high) / 2;
+			fire->error = (high - low) / 2;
+		}
+		else {
+			/*
+			** The greetings disagree (the server's clock was adjusted,
+			** or its dates are not exact): fall back on the average
+			*/
+			fire->offset = sum / dated;
+			fire->error = (high - low) / 2;
+		}
+	}
+
+	return fire;
+
+} /* RRPCreateFire */
+
+
+
+
+
+
+/*
+**
+** Function: RRPAddFireDomain
+**
+** Description: Adds the Add command of a domain to the burst. Every
+**              session sends every domain's command, in the order added
+**
+** Input: RRPFIRE* - a pointer to an RRPFIRE structure
+**        char* - the domain name
+**        RRPVECTOR* - name servers, or NULL
+**        int - registration period in years, or 0 for the default
+**
+** Output: none
+**
+** Return: int - the index of the domain. -1 is returned if an internal
+**               error occurs.
+**
+*/
+
+int
+RRPAddFireDomain (
+	RRPFIRE* fire,
+	char* domainName,
+	RRPVECTOR* nameServers,
+	int registrationPeriod
+) {
+	RRPREQUEST* request = NULL;
+	RRPELEMENT_NODE* node = NULL;
+	char period[12];
+	size_t capacity = 0;
+	char* burst = NULL;
+	int result = 0;
+
+	/*
+	** Validate parameters
+	*/
+	if (fire == NULL || domainName == NULL || registrationPeriod < 0) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	request = RRPCreateRequest(RRP_ADD_COMMAND, RRP_DOMAIN_ENTITY,
+		domainName, strlen(domainName));
+	if (request == NULL) {
+		return -1;
+	}
+
+	if (nameServers != NULL) {
+		for (node = nameServers->head; node != NULL && result == 0;
+			node = node->next) {
+			result = RRPAppendRequestAttribute(request, "NameServer", 10,
+				node->value, strlen(node->value));
+		}
+	}
+
+	if (result == 0 && registrationPeriod > 0) {
+		sprintf(period, "%d", registrationPeriod);
+		result = RRPAppendRequestAttribute(request, "-Period", 7, period,
+			strlen(period));
+	}
+
+	if (result < 0) {
+		RRPFreeRequest(request);
+		return -1;
+	}
+
+	if (fire->burstLength + request->length > fire->burstCapacity) {
+		capacity = (fire->burstCapacity * 2 > fire->burstLength +
+			request->length) ? fire->burstCapacity * 2 :
+			fire->burstLength + request->length;
+
+		burst = (char*) realloc(fire->burst, capacity);
+		if (burst == NULL) {
+			RRPFreeRequest(request);
+			RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
+			return -1;
+		}
+
+		fire->burst = burst;
+		fire->burstCapacity = capacity;
+	}
+
+	memcpy(fire->burst + fire->burstLength, request->text, request->length);
+	fire->burstLength += request->length;
+
+	RRPFreeRequest(request);
+
+	return fire->domainCount++;
+
+} /* RRPAddFireDomain */
+
+
+
+
+
+
+/*
+**
+** Function: RRPGetFireClockOffset
+**
+** Description: Returns the estimated offset of the server's clock (the
+**              server's time less the local time)
+**
+** Input: RRPFIRE* - a pointer to an RRPFIRE structure
+**
+** Output: double* - the offset in seconds
+**         double* - the largest error of the estimate in seconds, or
+**                   NULL. It is negative if the greetings disagreed, in
+**                   which case the offset is only a rough estimate
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs, or if no greeting had a date.
+**
+*/
+
+int
+RRPGetFireClockOffset (
+	RRPFIRE* fire,
+	double* offset,
+	double* error
+) {
+	/*
+	** Validate parameters
+	*/
+	if (fire == NULL || offset == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	if (fire->offsetKnown == RRPFALSE) {
+		RRPSetInternalErrorCode(RRP_RESPONSE_FORMAT_ERROR);
+		return -1;
+	}
+
+	*offset = fire->offset;
+
+	if (error != NULL) {
+		*error = fire->error;
+	}
+
+	return 0;
+
+} /* RRPGetFireClockOffset */
+
+
+
+
+
+
+/*
+**
+** Function: RRPSetFireClockOffset
+**
+** Description: Replaces the estimated offset of the server's clock, e.g.
+**              with 0 when the local clock is known to be synchronized
+**
+** Input: RRPFIRE* - a pointer to an RRPFIRE structure
+**        double - the offset in seconds (server's time less local time)
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+
+int
+RRPSetFireClockOffset (
+	RRPFIRE* fire,
+	double offset
+) {
+	/*
+	** Validate parameters
+	*/
+	if (fire == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	fire->offset = offset;
+	fire->error = 0;
+	fire->offsetKnown = RRPTRUE;
+
+	return 0;
+
+} /* RRPSetFireClockOffset */
+
+
+
+
+
+
+/*
+**
+** Function: RRPFireAt
+**
+** Description: Sends the burst on every session at an instant of the
+**              server's clock, and waits for all of the responses
+**
+** Input: RRPFIRE* - a pointer to an RRPFIRE structure
+**        struct timespec* - the instant, in the server's time
+**        long - nanoseconds between the bursts of successive sessions,
+**               to spread the sessions over the uncertainty of the
+**               offset. Session i fires at instant + i * stagger
+**
+** Output: none
+**
+** Return: int - the number of Add commands that got a response. -1 is
+**               returned if an internal error occurs.
+**
+** Note: The sessions are ended once they have fired
+**
+*/
+
+int
+RRPFireAt (
+	RRPFIRE* fire,
+	struct timespec* instant,
+	long stagger
+) {
+	RRPFIRETHREAD* threads = NULL;
+	double local = 0;
+	int received = 0;
+	int i = 0;
+
+	/*
+	** Validate parameters
+	*/
+	if (fire == NULL || instant == NULL || stagger < 0 ||
+		fire->domainCount == 0) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	if (fire->connections[0] == NULL) {
+		RRPSetInternalErrorCode(RRP_NOT_CONNECTED_ERROR);
+		return -1;
+	}
+
+	if (fire->offsetKnown == RRPFALSE) {
+		RRPSetInternalErrorCode(RRP_RESPONSE_FORMAT_ERROR);
+		return -1;
+	}
+
+	free(fire->attempts);
+	fire->attemptCount = 0;
+
+	fire->attempts = (RRPFIREATTEMPT*) calloc(fire->size * fire->domainCount,
+		sizeof(RRPFIREATTEMPT));
+	threads = (RRPFIRETHREAD*) calloc(fire->size, sizeof(RRPFIRETHREAD));
+
+	if (fire->attempts == NULL || threads == NULL) {
+		free(threads);
+		RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
+		return -1;
+	}
+
+	fire->attemptCount = fire->size * fire->domainCount;
+
+	for (i = 0; i < fire->attemptCount; i++) {
+		fire->attempts[i].session = i / fire->domainCount;
+		fire->attempts[i].domain = i % fire->domainCount;
+		fire->attempts[i].code = -1;
+	}
+
+	/*
+	** The instant is converted to local time in floating point: the
+	** offset may be fractional and of any size
+	*/
+	local = toSeconds(instant) - fire->offset;
+
+	for (i = 0; i < fire->size; i++) {
+		threads[i].fire = fire;
+		threads[i].index = i;
+		fromSeconds(local + i * (stagger / 1e9), &threads[i].instant);
+
+		if (pthread_create(&threads[i].thread, NULL, fireSession,
+			&threads[i]) != 0) {
+			/*
+			** Sessions that already have a thread fire anyway; this one
+			** records failed attempts
+			*/
+			threads[i].index = -1;
+		}
+	}
+
+	for (i = 0; i < fire->size; i++) {
+		if (threads[i].index >= 0) {
+			pthread_join(threads[i].thread, NULL);
+			received += threads[i].received;
+		}
+
+		closeFireConnection(fire->connections[i]);
+		fire->connections[i] = NULL;
+	}
+
+	free(threads);
+
+	return received;
+
+} /* RRPFireAt */
+
+
+
+
+
+
+/*
+**
+** Function: RRPGetFireAttempts
+**
+** Description: Returns the attempts of the last RRPFireAt(), session by
+**              session, in the order each session sent them
+**
+** Input: RRPFIRE* - a pointer to an RRPFIRE structure
+**
+** Output: int* - the number of attempts
+**
+** Return: RRPFIREATTEMPT* - array of attempts, which belongs to the
+**                           RRPFIRE structure. NULL is returned if an
+**                           internal error occurs.
+**
+*/
+
+RRPFIREATTEMPT*
+RRPGetFireAttempts (
+	RRPFIRE* fire,
+	int* count
+) {
+	/*
+	** Validate parameters
+	*/
+	if (fire == NULL || count == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return NULL;
+	}
+
+	*count = fire->attemptCount;
+
+	return fire->attempts;
+
+} /* RRPGetFireAttempts */
+
+
+
+
+
+
+/*
+**
+** Function: RRPFreeFire
+**
+** Description: Closes the sessions and frees all of the memory allocated
+**              for an RRPFIRE structure
+**
+** Input: RRPFIRE* - a pointer to an RRPFIRE structure
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+
+int
+RRPFreeFire (
+	RRPFIRE* fire
+) {
+	int i = 0;
+
+	/*
+	** Validate parameters
+	*/
+	if (fire == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	for (i = 0; i < fire->size; i++) {
+		if (fire->connections[i] != NULL) {
+			closeFireConnection(fire->connections[i]);
+		}
+	}
+
+	free(fire->connections);
+	free(fire->burst);
+	free(fire->attempts);
+	free(fire);
+
+	return 0;
+
+} /* RRPFreeFire */
+
+
+
+
+
+
+/*
+** Finds the date line of a greeting, e.g. "Fri Oct 19 09:00:00 GMT 2026",
+** and converts it to a time_t. Returns 0 if successful, -1 otherwise.
+*/
+static int
+parseGreetingDate (
+	char* greeting,
+	time_t* serverTime
+) {
+	static char* months = "JanFebMarAprMayJunJulAugSepOctNovDec";
+	char weekday[4];
+	char month[4];
+	char zone[8];
+	char* line = greeting;
+	char* found = NULL;
+	int day = 0;
+	int hour = 0;
+	int minute = 0;
+	int second = 0;
+	int year = 0;
+	long days = 0;
+
+	while (line != NULL && *line != '\0') {
+		if (sscanf(line, "%3s %3s %d %d:%d:%d %7s %d", weekday, month, &day,
+			&hour, &minute, &second, zone, &year) == 8 &&
+			(strcmp(zone, "GMT") == 0 || strcmp(zone, "UTC") == 0) &&
+			(found = strstr(months, month)) != NULL &&
+			(found - months) % 3 == 0) {
+			/*
+			** Days since 1970-01-01 of the proleptic Gregorian calendar,
+			** counting years from March so that leap days come last
+			*/
+			int m = (int) (found - months) / 3 + 1;
+			int y = year - (m <= 2);
+			long era = (y >= 0 ? y : y - 399) / 400;
+			long yearOfEra = y - era * 400;
+			long dayOfYear = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+			long dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 +
+				dayOfYear;
+
+			days = era * 146097 + dayOfEra - 719468;
+			*serverTime = (time_t) days * 86400 + hour * 3600 + minute * 60 +
+				second;
+			return 0;
+		}
+
+		line = strchr(line, '\n');
+		if (line != NULL) {
+			line++;
+		}
+	}
+
+	return -1;
+
+} /* parseGreetingDate */
+
+
+
+
+
+
+/*
+** Conversions between struct timespec and seconds
+*/
+static double
+toSeconds (
+	struct timespec* time
+) {
+	return (double) time->tv_sec + time->tv_nsec / 1e9;
+
+} /* toSeconds */
+
+static void
+fromSeconds (
+	double seconds,
+	struct timespec* time
+) {
+	time->tv_sec = (time_t) floor(seconds);
+	time->tv_nsec = (long) ((seconds - floor(seconds)) * 1e9);
+	if (time->tv_nsec >= 1000000000L) {
+		time->tv_sec++;
+		time->tv_nsec -= 1000000000L;
+	}
+
+} /* fromSeconds */
+
+
+
+
+
+
+/*
+** Sleeps until a local time, then spins on the clock for the last
+** RRP_FIRE_SPIN_NANOSECONDS
+*/
+static void
+sleepUntil (
+	struct timespec* instant
+) {
+	struct timespec wake = *instant;
+	struct timespec now;
+
+	wake.tv_nsec -= RRP_FIRE_SPIN_NANOSECONDS;
+	if (wake.tv_nsec < 0) {
+		wake.tv_sec--;
+		wake.tv_nsec += 1000000000L;
+	}
+
+	while (clock_nanosleep(CLOCK_REALTIME, TIMER_ABSTIME, &wake, NULL) ==
+		EINTR) {
+	}
+
+	do {
+		clock_gettime(CLOCK_REALTIME, &now);
+	} while (now.tv_sec < instant->tv_sec ||
+		(now.tv_sec == instant->tv_sec && now.tv_nsec < instant->tv_nsec));
+
+} /* sleepUntil */
+
+
+
+
+
+
+/*
+** Thread of one session: waits for the session's instant, writes the
+** burst and reads the responses, recording the times of each attempt
+*/
+static void*
+fireSession (
+	void* argument
+) {
+	RRPFIRETHREAD* thread = (RRPFIRETHREAD*) argument;
+	RRPFIRE* fire = thread->fire;
+	RRPCONNECTION* connection = fire->connections[thread->index];
+	RRPFIREATTEMPT* attempts = fire->attempts +
+		thread->index * fire->domainCount;
+	RRPRESPONSE* response = NULL;
+	char* responseString = NULL;
+	struct timespec woke;
+	struct timespec sent;
+	long written = 0;
+	int i = 0;
+#ifdef __linux__
+	cpu_set_t processors;
+	long processorCount = sysconf(_SC_NPROCESSORS_ONLN);
+
+	/*
+	** Keep the thread on one processor so that it is not migrated
+	** between waking up and sending
+	*/
+	if (processorCount > 0) {
+		CPU_ZERO(&processors);
+		CPU_SET(thread->index % processorCount, &processors);
+		pthread_setaffinity_np(pthread_self(), sizeof(processors),
+			&processors);
+	}
+#endif
+
+	sleepUntil(&thread->instant);
+	clock_gettime(CLOCK_REALTIME, &woke);
+
+	written = RRPWriteConnection(connection, fire->burst, fire->burstLength);
+	clock_gettime(CLOCK_REALTIME, &sent);
+
+	for (i = 0; i < fire->domainCount; i++) {
+		attempts[i].woke = woke;
+		attempts[i].sent = sent;
+	}
+
+	if (written != (long) fire->burstLength) {
+		return NULL;
+	}
+
+	for (i = 0; i < fire->domainCount; i++) {
+		responseString = RRPReadConnectionResponse(connection);
+		if (responseString == NULL) {
+			break;
+		}
+
+		clock_gettime(CLOCK_REALTIME, &attempts[i].received);
+
+		response = RRPParseResponse(responseString);
+		free(responseString);
+
+		if (response != NULL) {
+			attempts[i].code = response->code;
+			RRPFreeResponse(response);
+		}
+
+		thread->received++;
+	}
+
+	return NULL;
+
+} /* fireSession */
+
+
+
+
+
+
+/*
+** Ends the session on a connection, reading the response to Quit, and
+** frees the connection
+*/
+static void
+closeFireConnection (
+	RRPCONNECTION* connection
+) {
+	char* responseString = NULL;
+
+	if (connection == NULL) {
+		return;
+	}
+
+	if (RRPWriteConnection(connection, "Quit\r\n.\r\n", 9) == 9 &&
+		(responseString = RRPReadConnectionResponse(connection)) != NULL) {
+		free(responseString);
+	}
+
+	RRPFreeConnection(connection);
+
+} /* closeFireConnection */
@@ -0,0 +1,558 @@
+/* ===========================================================================
+ * Copyright (C) 2000 VeriSign, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * VeriSign Global Registry Service
+ * 21345 Ridgetop Circle
+ * Dulles, VA 20166
+ * ===========================================================================
+ * The RRP, APIs and Software are provided "as-is" and without any warranty
+ * of any kind.  NSI EXPRESSLY DISCLAIMS ALL WARRANTIES AND/OR CONDITIONS,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * AND CONDITIONS OF MERCHANTABILITY OR SATISFACTORY QUALITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE AND NONINFRINGEMENT OF THIRD PARTY RIGHTS.  NSI DOES
+ * NOT WARRANT THAT THE FUNCTIONS CONTAINED IN THE RRP, APIs OR SOFTWARE
+ * WILL MEET REGISTRAR'S REQUIREMENTS, OR THAT THE OPERATION OF THE RRP,
+ * APIs OR SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE,OR THAT DEFECTS IN
+ * THE RRP, APIs OR SOFTWARE WILL BE CORRECTED.  FURTHERMORE, NSI DOES NOT
+ * WARRANT NOR MAKE ANY REPRESENTATIONS REGARDING THE USE OR THE RESULTS OF
+ * THE RRP, APIs, SOFTWARE OR RELATED DOCUMENTATION IN TERMS OF THEIR
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR OTHERWISE.  SHOULD THE RRP, APIs
+ * OR SOFTWARE PROVE DEFECTIVE, REGISTRAR ASSUMES THE ENTIRE COST OF ALL
+ * NECESSARY SERVICING, REPAIR OR CORRECTION.
+ * ======================================================================== */
+
+/*
+**
+** Module Name: rrpGovernor.c
+**
+** Version: 2.1 for RRP version 2.1.0
+**
+** Date: Oct. 19th, 2026
+**
+** Description: rrpGovernor paces commands with token buckets (see
+**              rrpGovernor.h). The buckets of a governor share one
+**              mutex; a bucket is refilled when it is looked at, from the
+**              time elapsed since it was last looked at, so no thread is
+**              needed to keep it.
+**
+** Entry Points:
+**
+**    RRPCreateGovernor(double, int);
+**    RRPSetGovernorClassRate(RRPGOVERNOR*, RRPCOMMANDCLASS, double, int);
+**    RRPAcquireGovernor(RRPGOVERNOR*, RRPCOMMAND);
+**    RRPWaitGovernor(RRPGOVERNOR*, RRPCOMMAND);
+**    RRPGetGovernorStatistics(RRPGOVERNOR*, RRPGOVERNORSTATISTICS*);
+**    RRPSetProcessGovernor(RRPGOVERNOR*);
+**    RRPGetProcessGovernor(void);
+**    RRPFreeGovernor(RRPGOVERNOR*);
+**
+** Changes:
+**
+*/
+
+#include <stdlib.h>
+#include <time.h>
+#include <pthread.h>
+#include "rrpGovernor.h"
+#include "rrpInternalError.h"
+
+/*
+** A token bucket. A rate of 0 means no limit
+*/
+typedef struct {
+	double rate;                /* tokens per second */
+	double burst;               /* most tokens held */
+	double tokens;
+	double refilled;            /* time of the last refill, in seconds */
+} RRPBUCKET;
+
+struct _RRPGOVERNOR {
+	pthread_mutex_t mutex;
+	RRPBUCKET total;
+	RRPBUCKET classes[RRP_COMMAND_CLASSES];
+	RRPGOVERNORSTATISTICS statistics;
+};
+
+/*
+** Governor of the process (see RRPSetProcessGovernor())
+*/
+static RRPGOVERNOR* processGovernor = NULL;
+
+
+/*
+** Functions used internally by the governor
+*/
+static double getGovernorTime (void);
+static void setBucketRate (RRPBUCKET*, double, int, double);
+static double refillBucket (RRPBUCKET*, double);
+static RRPCOMMANDCLASS getCommandClass (RRPCOMMAND);
+
+
+
+
+/*
+**
+** Function: RRPCreateGovernor
+**
+** Description: Creates a governor
+**
+** Input: double - the most commands per second, all classes together.
+**                 0 sets no overall limit
+**        int - the most commands that may be sent at once after a lull
+**              (1 or more)
+**
+** Output: none
+**
+** Return: RRPGOVERNOR* - a pointer to an RRPGOVERNOR structure. NULL is
+**                        returned if an internal error occurs.
+**
+** Note: THE GOVERNOR MUST BE RELEASED BY CALLING RRPFreeGovernor()
+**
+*/
+
+RRPGOVERNOR*
+RRPCreateGovernor (
+	double rate,
+	int burst
+) {
+	RRPGOVERNOR* governor = NULL;
+
+	/*
+	** Validate parameters
+	*/
+	if (rate < 0 || burst < 1) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return NULL;
+	}
+
+	governor = (RRPGOVERNOR*) calloc(1, sizeof(RRPGOVERNOR));
+	if (governor == NULL) {
+		RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
+		return NULL;
+	}
+
+	pthread_mutex_init(&governor->mutex, NULL);
+	setBucketRate(&governor->total, rate, burst, getGovernorTime());
+
+	return governor;
+
+} /* RRPCreateGovernor */
+
+
+
+
+
+
+/*
+**
+** Function: RRPSetGovernorClassRate
+**
+** Description: Limits the rate of a class of commands, within the
+**              overall rate of the governor
+**
+** Input: RRPGOVERNOR* - a pointer to an RRPGOVERNOR structure
+**        RRPCOMMANDCLASS - the class
+**        double - the most commands of the class per second. 0 removes
+**                 the limit
+**        int - the most commands of the class that may be sent at once
+**              after a lull (1 or more)
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+
+int
+RRPSetGovernorClassRate (
+	RRPGOVERNOR* governor,
+	RRPCOMMANDCLASS commandClass,
+	double rate,
+	int burst
+) {
+	/*
+	** Validate parameters
+	*/
+	if (governor == NULL || (int) commandClass < 0 ||
+		commandClass >= RRP_COMMAND_CLASSES || rate < 0 || burst < 1) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	pthread_mutex_lock(&governor->mutex);
+	setBucketRate(&governor->classes[commandClass], rate, burst,
+		getGovernorTime());
+	pthread_mutex_unlock(&governor->mutex);
+
+	return 0;
+
+} /* RRPSetGovernorClassRate */
+
+
+
+
+
+
+/*
+**
+** Function: RRPAcquireGovernor
+**
+** Description: Takes the tokens needed to send a command, if they are
+**              all available. Never blocks
+**
+** Input: RRPGOVERNOR* - a pointer to an RRPGOVERNOR structure
+**        RRPCOMMAND - the command
+**
+** Output: none
+**
+** Return: long - 0 if the command may be sent now, otherwise the number
+**                of microseconds after which it may be asked again. -1
+**                is returned if an internal error occurs.
+**
+*/
+
+long
+RRPAcquireGovernor (
+	RRPGOVERNOR* governor,
+	RRPCOMMAND command
+) {
+	RRPBUCKET* bucket = NULL;
+	double now = 0;
+	double wait = 0;
+	double classWait = 0;
+
+	/*
+	** Validate parameters
+	*/
+	if (governor == NULL || (int) command < 0 ||
+		command > RRP_TRANSFER_COMMAND) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	bucket = &governor->classes[getCommandClass(command)];
+
+	pthread_mutex_lock(&governor->mutex);
+
+	now = getGovernorTime();
+	wait = refillBucket(&governor->total, now);
+	classWait = refillBucket(bucket, now);
+	if (classWait > wait) {
+		wait = classWait;
+	}
+
+	/*
+	** Both tokens or neither, so that a command held back by one
+	** bucket does not waste the token of the other
+	*/
+	if (wait > 0) {
+		governor->statistics.deferred++;
+		pthread_mutex_unlock(&governor->mutex);
+		return (long) (wait * 1000000) + 1;
+	}
+
+	if (governor->total.rate > 0) {
+		governor->total.tokens -= 1;
+	}
+	if (bucket->rate > 0) {
+		bucket->tokens -= 1;
+	}
+	governor->statistics.granted++;
+
+	pthread_mutex_unlock(&governor->mutex);
+
+	return 0;
+
+} /* RRPAcquireGovernor */
+
+
+
+
+
+
+/*
+**
+** Function: RRPWaitGovernor
+**
+** Description: Waits until a command may be sent and takes its tokens
+**
+** Input: RRPGOVERNOR* - a pointer to an RRPGOVERNOR structure
+**        RRPCOMMAND - the command
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+
+int
+RRPWaitGovernor (
+	RRPGOVERNOR* governor,
+	RRPCOMMAND command
+) {
+	struct timespec pause;
+	long wait = 0;
+
+	/*
+	** Another thread may take the token first: ask again after each
+	** pause
+	*/
+	while ((wait = RRPAcquireGovernor(governor, command)) > 0) {
+		pause.tv_sec = wait / 1000000;
+		pause.tv_nsec = (wait % 1000000) * 1000;
+		nanosleep(&pause, NULL);
+	}
+
+	return wait < 0 ? -1 : 0;
+
+} /* RRPWaitGovernor */
+
+
+
+
+
+
+/*
+**
+** Function: RRPGetGovernorStatistics
+**
+** Description: Returns the counts of a governor
+**
+** Input: RRPGOVERNOR* - a pointer to an RRPGOVERNOR structure
+**
+** Output: RRPGOVERNORSTATISTICS* - the counts
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+
+int
+RRPGetGovernorStatistics (
+	RRPGOVERNOR* governor,
+	RRPGOVERNORSTATISTICS* statistics
+) {
+	/*
+	** Validate parameters
+	*/
+	if (governor == NULL || statistics == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	pthread_mutex_lock(&governor->mutex);
+	*statistics = governor->statistics;
+	pthread_mutex_unlock(&governor->mutex);
+
+	return 0;
+
+} /* RRPGetGovernorStatistics */
+
+
+
+
+
+
+/*
+**
+** Function: RRPSetProcessGovernor
+**
+** Description: Sets the governor of the process: the command functions
+**              of rrpAPI.h wait for it before sending their command, and
+**              sessions opened from now on use it (see
+**              RRPSetSessionGovernor())
+**
+** Input: RRPGOVERNOR* - the governor, or NULL for none (the default).
+**                       It still belongs to the caller and must outlive
+**                       its use
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful.
+**
+*/
+
+int
+RRPSetProcessGovernor (
+	RRPGOVERNOR* governor
+) {
+	processGovernor = governor;
+
+	return 0;
+
+} /* RRPSetProcessGovernor */
+
+
+
+
+
+
+/*
+**
+** Function: RRPGetProcessGovernor
+**
+** Description: Returns the governor of the process
+**
+** Input: none
+**
+** Output: none
+**
+** Return: RRPGOVERNOR* - the governor, or NULL if there is none
+**
+*/
+
+RRPGOVERNOR*
+RRPGetProcessGovernor (void) {
+	return processGovernor;
+
+} /* RRPGetProcessGovernor */
+
+
+
+
+
+
+/*
+**
+** Function: RRPFreeGovernor
+**
+** Description: Frees a governor
+**
+** Input: RRPGOVERNOR* - a pointer to an RRPGOVERNOR structure
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+
+int
+RRPFreeGovernor (
+	RRPGOVERNOR* governor
+) {
+	/*
+	** Validate parameters
+	*/
+	if (governor == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	if (processGovernor == governor) {
+		processGovernor = NULL;
+	}
+
+	pthread_mutex_destroy(&governor->mutex);
+	free(governor);
+
+	return 0;
+
+} /* RRPFreeGovernor */
+
+
+
+
+
+
+/*
+** Returns the time of a clock that is not set back, in seconds
+*/
+static double
+getGovernorTime (void) {
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return now.tv_sec + now.tv_nsec / 1000000000.0;
+
+} /* getGovernorTime() */
+
+
+
+/*
+** Sets the rate and burst of a bucket, which starts full
+*/
+static void
+setBucketRate (
+	RRPBUCKET* bucket,
+	double rate,
+	int burst,
+	double now
+) {
+	bucket->rate = rate;
+	bucket->burst = burst;
+	bucket->tokens = burst;
+	bucket->refilled = now;
+
+} /* setBucketRate() */
+
+
+
+/*
+** Refills a bucket for the time elapsed since its last refill. Returns
+** the number of seconds until it holds a token, 0 if it holds one now
+*/
+static double
+refillBucket (
+	RRPBUCKET* bucket,
+	double now
+) {
+	if (bucket->rate == 0) {
+		return 0;
+	}
+
+	bucket->tokens += (now - bucket->refilled) * bucket->rate;
+	if (bucket->tokens > bucket->burst) {
+		bucket->tokens = bucket->burst;
+	}
+	bucket->refilled = now;
+
+	if (bucket->tokens >= 1) {
+		return 0;
+	}
+
+	return (1 - bucket->tokens) / bucket->rate;
+
+} /* refillBucket() */
+
+
+
+/*
+** Returns the class of a command
+*/
+static RRPCOMMANDCLASS
+getCommandClass (
+	RRPCOMMAND command
+) {
+	switch (command) {
+		case RRP_CHECK_COMMAND:
+		case RRP_STATUS_COMMAND:
+		case RRP_DESCRIBE_COMMAND:
+			return RRP_QUERY_COMMANDS;
+
+		case RRP_SESSION_COMMAND:
+		case RRP_QUIT_COMMAND:
+			return RRP_SESSION_COMMANDS;
+
+		default:
+			return RRP_TRANSFORM_COMMANDS;
+	}
+
+} /* getCommandClass() */
@@ -60,6 +60,10 @@
 **
 ** Changes:
 **
+** Oct. 19th, 2026: The internal error code is kept per thread where the
+** compiler supports it, so that threads that each use their own
+** connection (see rrpConnection.h) do not overwrite each other's code.
+**
 */
 
 
@@ -70,9 +74,17 @@
 
 
 /*
-** Static internal error code
+** Static internal error code, one per thread if possible
 */
-static RRPINTERNAL_ERROR_CODE  _errorCode = RRP_NO_ERROR;
+#ifndef RRP_THREAD_LOCAL
+	#if defined(__GNUC__) || defined(__SUNPRO_C)
+		#define RRP_THREAD_LOCAL __thread
+	#else
+		#define RRP_THREAD_LOCAL
+	#endif
+#endif
+
+static RRP_THREAD_LOCAL RRPINTERNAL_ERROR_CODE  _errorCode = RRP_NO_ERROR;
 
 
 
@@ -91,7 +103,9 @@ char* rrpErrorDescriptions[] = {
 	"No socket connection exists",
 	"Invalid RRP response format",
 	"Unknown internal error",
-	"Socket operation timeout"
+	"Socket operation timeout",
+	"Internal limit exceeded",
+	"RRP server refused to start session"
 };
 
 
@@ -169,7 +183,7 @@ RRPGetInternalErrorDescription () {
 	** Only attempt to get description from array is _errorCode is
 	** a valid array index
 	*/
-	if (_errorCode < sizeof rrpErrorDescriptions) {
+	if (_errorCode < sizeof rrpErrorDescriptions / sizeof(char*)) {
 		return rrpErrorDescriptions[_errorCode];
 	}
 	return NULL;
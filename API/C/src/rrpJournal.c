@@ -0,0 +1,1370 @@
+/* ===========================================================================
+ * Copyright (C) 2000 VeriSign, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * VeriSign Global Registry Service
+ * 21345 Ridgetop Circle
+ * Dulles, VA 20166
+ * ===========================================================================
+ * The RRP, APIs and Software are provided "as-is" and without any warranty
+ * of any kind.  NSI EXPRESSLY DISCLAIMS ALL WARRANTIES AND/OR CONDITIONS,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * AND CONDITIONS OF MERCHANTABILITY OR SATISFACTORY QUALITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE AND NONINFRINGEMENT OF THIRD PARTY RIGHTS.  NSI DOES
+ * NOT WARRANT THAT THE FUNCTIONS CONTAINED IN THE RRP, APIs OR SOFTWARE
+ * WILL MEET REGISTRAR'S REQUIREMENTS, OR THAT THE OPERATION OF THE RRP,
+ * APIs OR SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE,OR THAT DEFECTS IN
+ * THE RRP, APIs OR SOFTWARE WILL BE CORRECTED.  FURTHERMORE, NSI DOES NOT
+ * WARRANT NOR MAKE ANY REPRESENTATIONS REGARDING THE USE OR THE RESULTS OF
+ * THE RRP, APIs, SOFTWARE OR RELATED DOCUMENTATION IN TERMS OF THEIR
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR OTHERWISE.  SHOULD THE RRP, APIs
+ * OR SOFTWARE PROVE DEFECTIVE, REGISTRAR ASSUMES THE ENTIRE COST OF ALL
+ * NECESSARY SERVICING, REPAIR OR CORRECTION.
+ * ======================================================================== */
+
+/*
+**
+** Module Name: rrpJournal.c
+**
+** Version: 2.1 for RRP version 2.1.0
+**
+** Date: Oct. 19th, 2026
+**
+** Description: rrpJournal appends records of commands to a file with
+**              group commit (see rrpJournal.h). Records are formatted
+**              into one of two buffers under the journal's mutex. The
+**              thread that commits swaps the buffers, then writes and
+**              synchronizes the full one without holding the mutex, so
+**              other threads keep recording meanwhile; threads that
+**              commit during that time wait for it to end, and only
+**              start another write if theirs was not covered.
+**
+**              The sequence numbers of a journal that is opened again
+**              go on from the last valid record of its file, which is
+**              found by reading its end.
+**
+** Entry Points:
+**
+**    RRPOpenJournal(char*);
+**    RRPSetJournalCommand(RRPJOURNAL*, RRPCOMMAND, RRPBOOLEAN);
+**    RRPGetJournalCommand(RRPJOURNAL*, RRPCOMMAND);
+**    RRPRecordJournalIntent(RRPJOURNAL*, RRPREQUEST*);
+**    RRPRecordJournalOutcome(RRPJOURNAL*, unsigned long, RRPRESPONSE*);
+**    RRPCommitJournal(RRPJOURNAL*, unsigned long);
+**    RRPGetJournalStatistics(RRPJOURNAL*, RRPJOURNALSTATISTICS*);
+**    RRPCloseJournal(RRPJOURNAL*);
+**    RRPOpenJournalReader(char*);
+**    RRPReadJournalEntry(RRPJOURNALREADER*, RRPJOURNALENTRY*);
+**    RRPGetJournalDamage(RRPJOURNALREADER*);
+**    RRPCloseJournalReader(RRPJOURNALREADER*);
+**
+** Changes:
+**
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include "rrpJournal.h"
+
+#define RRP_JOURNAL_COMMANDS (RRP_TRANSFER_COMMAND + 1)
+
+/*
+** Bytes read from the end of a journal to find its last sequence number
+*/
+#define JOURNAL_TAIL 65536
+
+/*
+** Records formatted but not yet written
+*/
+typedef struct {
+	char* data;
+	size_t length;
+	size_t capacity;
+} RRPJOURNALBUFFER;
+
+struct _RRPJOURNAL {
+	pthread_mutex_t mutex;
+	pthread_cond_t committed;   /* signalled when a commit ends */
+	int descriptor;
+	RRPBOOLEAN commands[RRP_JOURNAL_COMMANDS]; /* recorded commands */
+	RRPJOURNALBUFFER buffers[2];
+	int current;                /* buffer records are added to */
+	unsigned long sequence;     /* last sequence number given */
+	unsigned long durable;      /* last intent synchronized */
+	RRPBOOLEAN committing;      /* a thread is writing the other buffer */
+	RRPBOOLEAN failed;          /* a write or synchronization failed */
+	RRPJOURNALSTATISTICS statistics;
+};
+
+struct _RRPJOURNALREADER {
+	RRPJOURNALENTRY* entries;   /* commands whose outcome is unknown,
+	                               and resolved ones (with no name) not
+	                               yet removed */
+	int count;
+	int capacity;
+	int resolved;               /* resolved entries among them */
+	int next;                   /* next entry to return */
+	int damage;                 /* records skipped */
+};
+
+
+/*
+** Functions used internally to format and parse records
+*/
+static char* reserveJournal (RRPJOURNALBUFFER*, size_t);
+static unsigned long getJournalChecksum (const char*, size_t);
+static size_t escapeJournalText (char*, const char*, size_t);
+static void unescapeJournalText (char*);
+static int readJournalLine (FILE*, char**, size_t*);
+static int parseJournalLine (char*, char**, int);
+static unsigned long findJournalSequence (int);
+static int syncJournalDirectory (char*);
+
+/*
+** Functions used internally by the journal reader
+*/
+static int addJournalEntry (RRPJOURNALREADER*, char**);
+static void resolveJournalEntry (RRPJOURNALREADER*, char**);
+
+
+
+
+/*
+**
+** Function: RRPOpenJournal
+**
+** Description: Opens a journal for appending, creating the file if
+**              needed. Sequence numbers go on from the last one in the
+**              file
+**
+** Input: char* - name of the journal file
+**
+** Output: none
+**
+** Return: RRPJOURNAL* - a pointer to an RRPJOURNAL structure. NULL is
+**                       returned if an internal error occurs or if the
+**                       file can not be opened (RRP_IO_ERROR).
+**
+** Note: THE JOURNAL MUST BE CLOSED BY CALLING RRPCloseJournal()
+**
+*/
+
+RRPJOURNAL*
+RRPOpenJournal (
+	char* fileName
+) {
+	RRPJOURNAL* journal = NULL;
+	RRPBOOLEAN created = RRPFALSE;
+	char* line = NULL;
+	char last = '\n';
+	off_t end = 0;
+	int descriptor = -1;
+	int i = 0;
+
+	/*
+	** Validate parameters
+	*/
+	if (fileName == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return NULL;
+	}
+
+	/*
+	** A new file is only durable once its directory is
+	*/
+	descriptor = open(fileName, O_RDWR | O_APPEND | O_CREAT | O_EXCL, 0600);
+	if (descriptor >= 0) {
+		created = RRPTRUE;
+	}
+	else if (errno == EEXIST) {
+		descriptor = open(fileName, O_RDWR | O_APPEND);
+	}
+
+	if (descriptor < 0 ||
+		(created && syncJournalDirectory(fileName) < 0)) {
+		if (descriptor >= 0) {
+			close(descriptor);
+		}
+		RRPSetInternalErrorCode(RRP_IO_ERROR);
+		return NULL;
+	}
+
+	journal = (RRPJOURNAL*) calloc(1, sizeof(RRPJOURNAL));
+	if (journal == NULL) {
+		close(descriptor);
+		RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
+		return NULL;
+	}
+
+	pthread_mutex_init(&journal->mutex, NULL);
+	pthread_cond_init(&journal->committed, NULL);
+	journal->descriptor = descriptor;
+
+	for (i = 0; i < RRP_JOURNAL_COMMANDS; i++) {
+		journal->commands[i] = RRPFALSE;
+	}
+	journal->commands[RRP_ADD_COMMAND] = RRPTRUE;
+	journal->commands[RRP_DEL_COMMAND] = RRPTRUE;
+	journal->commands[RRP_RENEW_COMMAND] = RRPTRUE;
+	journal->commands[RRP_TRANSFER_COMMAND] = RRPTRUE;
+
+	journal->sequence = findJournalSequence(descriptor);
+	journal->durable = journal->sequence;
+
+	/*
+	** A record cut short by a crash is ended, so that the next one
+	** starts on a line of its own
+	*/
+	end = lseek(descriptor, 0, SEEK_END);
+	if (end > 0 && (pread(descriptor, &last, 1, end - 1) != 1 ||
+		last != '\n')) {
+		if ((line = reserveJournal(&journal->buffers[0], 1)) == NULL) {
+			RRPCloseJournal(journal);
+			RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
+			return NULL;
+		}
+		*line = '\n';
+		journal->buffers[0].length = 1;
+	}
+
+	return journal;
+
+} /* RRPOpenJournal */
+
+
+
+
+
+
+/*
+**
+** Function: RRPSetJournalCommand
+**
+** Description: Tells whether a command is recorded in a journal
+**
+** Input: RRPJOURNAL* - a pointer to an RRPJOURNAL structure
+**        RRPCOMMAND - the command
+**        RRPBOOLEAN - RRPTRUE to record the command
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+
+int
+RRPSetJournalCommand (
+	RRPJOURNAL* journal,
+	RRPCOMMAND command,
+	RRPBOOLEAN record
+) {
+	/*
+	** Validate parameters
+	*/
+	if (journal == NULL || (int) command < 0 ||
+		command >= RRP_JOURNAL_COMMANDS) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	journal->commands[command] = record;
+
+	return 0;
+
+} /* RRPSetJournalCommand */
+
+
+
+
+
+
+/*
+**
+** Function: RRPGetJournalCommand
+**
+** Description: Tells whether a command is recorded in a journal
+**
+** Input: RRPJOURNAL* - a pointer to an RRPJOURNAL structure
+**        RRPCOMMAND - the command
+**
+** Output: none
+**
+** Return: RRPBOOLEAN - RRPTRUE if the command is recorded, RRPFALSE if
+**                      not or if an internal error occurs
+**
+*/
+
+RRPBOOLEAN
+RRPGetJournalCommand (
+	RRPJOURNAL* journal,
+	RRPCOMMAND command
+) {
+	/*
+	** Validate parameters
+	*/
+	if (journal == NULL || (int) command < 0 ||
+		command >= RRP_JOURNAL_COMMANDS) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return RRPFALSE;
+	}
+
+	return journal->commands[command];
+
+} /* RRPGetJournalCommand */
+
+
+
+
+
+
+/*
+**
+** Function: RRPRecordJournalIntent
+**
+** Description: Records that a request is about to be sent. The record is
+**              durable once RRPCommitJournal() has returned for its
+**              sequence number
+**
+** Input: RRPJOURNAL* - a pointer to an RRPJOURNAL structure
+**        RRPREQUEST* - the request
+**
+** Output: none
+**
+** Return: unsigned long - the sequence number of the command, 1 or
+**                         more. 0 is returned if an internal error
+**                         occurs.
+**
+*/
+
+unsigned long
+RRPRecordJournalIntent (
+	RRPJOURNAL* journal,
+	RRPREQUEST* request
+) {
+	RRPJOURNALBUFFER* buffer = NULL;
+	unsigned long sequence = 0;
+	char* record = NULL;
+	char* line = NULL;
+	size_t nameLength = 0;
+
+	/*
+	** Validate parameters
+	*/
+	if (journal == NULL || request == NULL || request->text == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return 0;
+	}
+
+	if (request->entity != RRP_NO_ENTITY) {
+		nameLength = request->nameLength;
+	}
+
+	pthread_mutex_lock(&journal->mutex);
+
+	if (journal->failed) {
+		pthread_mutex_unlock(&journal->mutex);
+		RRPSetInternalErrorCode(RRP_IO_ERROR);
+		return 0;
+	}
+
+	/*
+	** Every character of the request may take two once escaped
+	*/
+	buffer = &journal->buffers[journal->current];
+	record = reserveJournal(buffer, 80 + 2 * nameLength +
+		2 * request->length);
+	if (record == NULL) {
+		pthread_mutex_unlock(&journal->mutex);
+		RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
+		return 0;
+	}
+
+	sequence = ++journal->sequence;
+
+	line = record + sprintf(record, "I\t%lu\t%ld\t%d\t", sequence,
+		(long) time(NULL), (int) request->command);
+	line += escapeJournalText(line, request->text + request->nameOffset,
+		nameLength);
+	*line++ = '\t';
+	line += escapeJournalText(line, request->text, request->length);
+	line += sprintf(line, "\t%08lx\n",
+		getJournalChecksum(record, line - record));
+
+	buffer->length += line - record;
+	journal->statistics.intents++;
+
+	pthread_mutex_unlock(&journal->mutex);
+
+	return sequence;
+
+} /* RRPRecordJournalIntent */
+
+
+
+
+
+
+/*
+**
+** Function: RRPRecordJournalOutcome
+**
+** Description: Records the outcome of a command. The record is made
+**              durable by the next commit
+**
+** Input: RRPJOURNAL* - a pointer to an RRPJOURNAL structure
+**        unsigned long - the sequence number of the command
+**        RRPRESPONSE* - the response, or NULL if there was none: the
+**                       command may then have been executed or not
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+
+int
+RRPRecordJournalOutcome (
+	RRPJOURNAL* journal,
+	unsigned long sequence,
+	RRPRESPONSE* response
+) {
+	RRPJOURNALBUFFER* buffer = NULL;
+	RRPOUTCOME outcome = RRP_OUTCOME_UNKNOWN;
+	char* record = NULL;
+	char* line = NULL;
+
+	/*
+	** Validate parameters
+	*/
+	if (journal == NULL || sequence == 0) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	/*
+	** Without a response nothing tells whether the command was executed
+	*/
+	if (response != NULL) {
+		outcome = RRPClassifyOutcome(response, RRP_NO_ERROR);
+	}
+
+	pthread_mutex_lock(&journal->mutex);
+
+	if (journal->failed) {
+		pthread_mutex_unlock(&journal->mutex);
+		RRPSetInternalErrorCode(RRP_IO_ERROR);
+		return -1;
+	}
+
+	buffer = &journal->buffers[journal->current];
+	record = reserveJournal(buffer, 64);
+	if (record == NULL) {
+		pthread_mutex_unlock(&journal->mutex);
+		RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
+		return -1;
+	}
+
+	line = record + sprintf(record, "O\t%lu\t%d\t%d", sequence,
+		response != NULL ? response->code : -1, (int) outcome);
+	line += sprintf(line, "\t%08lx\n",
+		getJournalChecksum(record, line - record));
+
+	buffer->length += line - record;
+	journal->statistics.outcomes++;
+
+	pthread_mutex_unlock(&journal->mutex);
+
+	return 0;
+
+} /* RRPRecordJournalOutcome */
+
+
+
+
+
+
+/*
+**
+** Function: RRPCommitJournal
+**
+** Description: Makes the records of a journal durable, up to a command.
+**              Records gathered by other threads meanwhile are written
+**              and synchronized along with them
+**
+** Input: RRPJOURNAL* - a pointer to an RRPJOURNAL structure
+**        unsigned long - the sequence number of the command, or 0 for
+**                        every record
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs, or if the file could not be
+**               written or synchronized (RRP_IO_ERROR); the journal can
+**               then no longer be used.
+**
+*/
+
+int
+RRPCommitJournal (
+	RRPJOURNAL* journal,
+	unsigned long sequence
+) {
+	RRPJOURNALBUFFER* buffer = NULL;
+	unsigned long covered = 0;
+	RRPBOOLEAN everything = RRPFALSE;
+	size_t written = 0;
+	ssize_t byteCount = 0;
+	int result = 0;
+
+	/*
+	** Validate parameters
+	*/
+	if (journal == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	pthread_mutex_lock(&journal->mutex);
+
+	everything = (sequence == 0) ? RRPTRUE : RRPFALSE;
+	if (everything || sequence > journal->sequence) {
+		sequence = journal->sequence;
+	}
+
+	for (;;) {
+		if (journal->failed) {
+			pthread_mutex_unlock(&journal->mutex);
+			RRPSetInternalErrorCode(RRP_IO_ERROR);
+			return -1;
+		}
+
+		if (journal->durable >= sequence && (!everything ||
+			(!journal->committing &&
+			journal->buffers[journal->current].length == 0))) {
+			pthread_mutex_unlock(&journal->mutex);
+			return 0;
+		}
+
+		/*
+		** Another thread is writing: what it writes may be enough
+		*/
+		if (journal->committing) {
+			pthread_cond_wait(&journal->committed, &journal->mutex);
+			continue;
+		}
+
+		/*
+		** Write what every thread has recorded so far, and let them
+		** record more in the other buffer meanwhile
+		*/
+		buffer = &journal->buffers[journal->current];
+		journal->current = 1 - journal->current;
+		covered = journal->sequence;
+		journal->committing = RRPTRUE;
+
+		pthread_mutex_unlock(&journal->mutex);
+
+		result = 0;
+		for (written = 0; written < buffer->length; written += byteCount) {
+			byteCount = write(journal->descriptor, buffer->data + written,
+				buffer->length - written);
+			if (byteCount < 0 && errno == EINTR) {
+				byteCount = 0;
+			}
+			else if (byteCount <= 0) {
+				result = -1;
+				break;
+			}
+		}
+
+		if (result == 0 && fdatasync(journal->descriptor) < 0) {
+			result = -1;
+		}
+
+		pthread_mutex_lock(&journal->mutex);
+
+		buffer->length = 0;
+		journal->committing = RRPFALSE;
+		journal->statistics.commits++;
+		if (result < 0) {
+			journal->failed = RRPTRUE;
+		}
+		else {
+			journal->durable = covered;
+		}
+
+		pthread_cond_broadcast(&journal->committed);
+	}
+
+} /* RRPCommitJournal */
+
+
+
+
+
+
+/*
+**
+** Function: RRPGetJournalStatistics
+**
+** Description: Returns the counts of a journal
+**
+** Input: RRPJOURNAL* - a pointer to an RRPJOURNAL structure
+**
+** Output: RRPJOURNALSTATISTICS* - the counts
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+
+int
+RRPGetJournalStatistics (
+	RRPJOURNAL* journal,
+	RRPJOURNALSTATISTICS* statistics
+) {
+	/*
+	** Validate parameters
+	*/
+	if (journal == NULL || statistics == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	pthread_mutex_lock(&journal->mutex);
+	*statistics = journal->statistics;
+	pthread_mutex_unlock(&journal->mutex);
+
+	return 0;
+
+} /* RRPGetJournalStatistics */
+
+
+
+
+
+
+/*
+**
+** Function: RRPCloseJournal
+**
+** Description: Commits every record of a journal, closes its file and
+**              frees it. The sessions that use it must have been closed
+**
+** Input: RRPJOURNAL* - a pointer to an RRPJOURNAL structure
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs, or if the last records could not
+**               be committed (RRP_IO_ERROR); the journal is freed
+**               anyway.
+**
+*/
+
+int
+RRPCloseJournal (
+	RRPJOURNAL* journal
+) {
+	int result = 0;
+
+	/*
+	** Validate parameters
+	*/
+	if (journal == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	result = RRPCommitJournal(journal, 0);
+
+	if (close(journal->descriptor) < 0 && result == 0) {
+		RRPSetInternalErrorCode(RRP_IO_ERROR);
+		result = -1;
+	}
+
+	pthread_cond_destroy(&journal->committed);
+	pthread_mutex_destroy(&journal->mutex);
+	free(journal->buffers[0].data);
+	free(journal->buffers[1].data);
+	free(journal);
+
+	return result;
+
+} /* RRPCloseJournal */
+
+
+
+
+
+
+/*
+**
+** Function: RRPOpenJournalReader
+**
+** Description: Reads a journal and gathers the commands whose outcome
+**              is unknown, in the order they were recorded
+**
+** Input: char* - name of the journal file
+**
+** Output: none
+**
+** Return: RRPJOURNALREADER* - a pointer to an RRPJOURNALREADER
+**                             structure. NULL is returned if an internal
+**                             error occurs or if the file can not be
+**                             read (RRP_IO_ERROR).
+**
+** Note: THE READER MUST BE CLOSED BY CALLING RRPCloseJournalReader()
+**
+*/
+
+RRPJOURNALREADER*
+RRPOpenJournalReader (
+	char* fileName
+) {
+	RRPJOURNALREADER* reader = NULL;
+	FILE* file = NULL;
+	char* line = NULL;
+	char* fields[6];
+	size_t capacity = 0;
+	int fieldCount = 0;
+	int result = 0;
+
+	/*
+	** Validate parameters
+	*/
+	if (fileName == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return NULL;
+	}
+
+	if ((file = fopen(fileName, "r")) == NULL) {
+		RRPSetInternalErrorCode(RRP_IO_ERROR);
+		return NULL;
+	}
+
+	reader = (RRPJOURNALREADER*) calloc(1, sizeof(RRPJOURNALREADER));
+	if (reader == NULL) {
+		fclose(file);
+		RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
+		return NULL;
+	}
+
+	/*
+	** Intents are recorded in the order of their sequence numbers, so
+	** the commands still unresolved stay sorted
+	*/
+	while ((result = readJournalLine(file, &line, &capacity)) > 0) {
+		fieldCount = parseJournalLine(line, fields, 6);
+
+		if (fieldCount == 6 && strcmp(fields[0], "I") == 0) {
+			result = addJournalEntry(reader, fields);
+		}
+		else if (fieldCount == 4 && strcmp(fields[0], "O") == 0) {
+			resolveJournalEntry(reader, fields);
+		}
+		else if (fieldCount != 0) {
+			reader->damage++;
+		}
+
+		if (result < 0) {
+			break;
+		}
+	}
+
+	free(line);
+
+	if (result < 0 || ferror(file)) {
+		fclose(file);
+		RRPCloseJournalReader(reader);
+		RRPSetInternalErrorCode(result < 0 ? RRP_MEM_ALLOC_ERROR :
+			RRP_IO_ERROR);
+		return NULL;
+	}
+
+	fclose(file);
+
+	return reader;
+
+} /* RRPOpenJournalReader */
+
+
+
+
+
+
+/*
+**
+** Function: RRPReadJournalEntry
+**
+** Description: Returns the next command whose outcome is unknown
+**
+** Input: RRPJOURNALREADER* - a pointer to an RRPJOURNALREADER structure
+**
+** Output: RRPJOURNALENTRY* - the command. Its strings belong to the
+**                            reader and are valid until it is closed
+**
+** Return: int - 1 is returned if a command was returned, 0 once there
+**               are no more. -1 is returned if an internal error occurs.
+**
+*/
+
+int
+RRPReadJournalEntry (
+	RRPJOURNALREADER* reader,
+	RRPJOURNALENTRY* entry
+) {
+	/*
+	** Validate parameters
+	*/
+	if (reader == NULL || entry == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	while (reader->next < reader->count) {
+		if (reader->entries[reader->next].name != NULL) {
+			*entry = reader->entries[reader->next++];
+			return 1;
+		}
+		reader->next++;
+	}
+
+	return 0;
+
+} /* RRPReadJournalEntry */
+
+
+
+
+
+
+/*
+**
+** Function: RRPGetJournalDamage
+**
+** Description: Returns the number of records of a journal that were
+**              skipped because they were cut short or damaged
+**
+** Input: RRPJOURNALREADER* - a pointer to an RRPJOURNALREADER structure
+**
+** Output: none
+**
+** Return: int - the number of records. -1 is returned if an internal
+**               error occurs.
+**
+*/
+
+int
+RRPGetJournalDamage (
+	RRPJOURNALREADER* reader
+) {
+	/*
+	** Validate parameters
+	*/
+	if (reader == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	return reader->damage;
+
+} /* RRPGetJournalDamage */
+
+
+
+
+
+
+/*
+**
+** Function: RRPCloseJournalReader
+**
+** Description: Frees a journal reader and the commands it returned
+**
+** Input: RRPJOURNALREADER* - a pointer to an RRPJOURNALREADER structure
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+
+int
+RRPCloseJournalReader (
+	RRPJOURNALREADER* reader
+) {
+	int i = 0;
+
+	/*
+	** Validate parameters
+	*/
+	if (reader == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	for (i = 0; i < reader->count; i++) {
+		free(reader->entries[i].name);
+		free(reader->entries[i].request);
+	}
+
+	free(reader->entries);
+	free(reader);
+
+	return 0;
+
+} /* RRPCloseJournalReader */
+
+
+
+
+
+
+/*
+** Makes room for 'size' more bytes in a buffer. Returns where they go,
+** or NULL if memory runs out
+*/
+static char*
+reserveJournal (
+	RRPJOURNALBUFFER* buffer,
+	size_t size
+) {
+	size_t capacity = 0;
+	char* data = NULL;
+
+	if (buffer->length + size > buffer->capacity) {
+		capacity = buffer->capacity * 2;
+		if (capacity < buffer->length + size) {
+			capacity = buffer->length + size;
+		}
+		if (capacity < 4096) {
+			capacity = 4096;
+		}
+
+		data = (char*) realloc(buffer->data, capacity);
+		if (data == NULL) {
+			return NULL;
+		}
+
+		buffer->data = data;
+		buffer->capacity = capacity;
+	}
+
+	return buffer->data + buffer->length;
+
+} /* reserveJournal() */
+
+
+
+/*
+** Returns the 32-bit FNV-1a hash of some bytes
+*/
+static unsigned long
+getJournalChecksum (
+	const char* bytes,
+	size_t length
+) {
+	unsigned long hash = 2166136261UL;
+	size_t i = 0;
+
+	for (i = 0; i < length; i++) {
+		hash ^= (unsigned char) bytes[i];
+		hash = (hash * 16777619UL) & 0xffffffffUL;
+	}
+
+	return hash;
+
+} /* getJournalChecksum() */
+
+
+
+/*
+** Copies text to 'line', escaping the characters that would break the
+** record. Returns the number of characters written, at most twice the
+** length of the text
+*/
+static size_t
+escapeJournalText (
+	char* line,
+	const char* text,
+	size_t length
+) {
+	char* start = line;
+	size_t i = 0;
+
+	for (i = 0; i < length; i++) {
+		switch (text[i]) {
+			case '\r': *line++ = '\\'; *line++ = 'r'; break;
+			case '\n': *line++ = '\\'; *line++ = 'n'; break;
+			case '\t': *line++ = '\\'; *line++ = 't'; break;
+			case '\\': *line++ = '\\'; *line++ = '\\'; break;
+			default: *line++ = text[i]; break;
+		}
+	}
+
+	return line - start;
+
+} /* escapeJournalText() */
+
+
+
+/*
+** Undoes escapeJournalText() in place
+*/
+static void
+unescapeJournalText (
+	char* text
+) {
+	char* to = text;
+
+	for (; *text != '\0'; text++) {
+		if (*text == '\\' && text[1] != '\0') {
+			text++;
+			switch (*text) {
+				case 'r': *to++ = '\r'; break;
+				case 'n': *to++ = '\n'; break;
+				case 't': *to++ = '\t'; break;
+				default: *to++ = *text; break;
+			}
+		}
+		else {
+			*to++ = *text;
+		}
+	}
+	*to = '\0';
+
+} /* unescapeJournalText() */
+
+
+
+/*
+** Reads a line of any length into '*line', which is grown as needed.
+** Returns 1 if a whole line was read, 2 if the file ended before the
+** end of the line, 0 at the end of the file
+*/
+static int
+readJournalLine (
+	FILE* file,
+	char** line,
+	size_t* capacity
+) {
+	size_t length = 0;
+	char* grown = NULL;
+
+	for (;;) {
+		if (*capacity - length < 2) {
+			grown = (char*) realloc(*line, *capacity > 0 ? *capacity * 2 :
+				1024);
+			if (grown == NULL) {
+				return -1;
+			}
+			*line = grown;
+			*capacity = *capacity > 0 ? *capacity * 2 : 1024;
+		}
+
+		if (fgets(*line + length, (int) (*capacity - length), file) ==
+			NULL) {
+			return length > 0 ? 2 : 0;
+		}
+
+		length += strlen(*line + length);
+		if (length > 0 && (*line)[length - 1] == '\n') {
+			(*line)[length - 1] = '\0';
+			return 1;
+		}
+	}
+
+} /* readJournalLine() */
+
+
+
+/*
+** Splits a record into its fields in place, after checking its
+** checksum, which is not counted as a field. Returns the number of
+** fields, or -1 if the record is damaged or has more than 'size'
+** fields
+*/
+static int
+parseJournalLine (
+	char* line,
+	char** fields,
+	int size
+) {
+	char* checksum = NULL;
+	char* end = NULL;
+	int count = 0;
+
+	if (*line == '\0') {
+		return 0;
+	}
+
+	checksum = strrchr(line, '\t');
+	if (checksum == NULL || strtoul(checksum + 1, &end, 16) !=
+		getJournalChecksum(line, checksum - line) || *end != '\0' ||
+		end == checksum + 1) {
+		return -1;
+	}
+	*checksum = '\0';
+
+	for (;;) {
+		if (count == size) {
+			return -1;
+		}
+		fields[count++] = line;
+
+		if ((line = strchr(line, '\t')) == NULL) {
+			break;
+		}
+		*line++ = '\0';
+	}
+
+	return count;
+
+} /* parseJournalLine() */
+
+
+
+/*
+** Returns the last sequence number recorded in a journal file, 0 if
+** there is none. Only the end of the file is read, unless no valid
+** record is found there
+*/
+static unsigned long
+findJournalSequence (
+	int descriptor
+) {
+	FILE* file = NULL;
+	char* line = NULL;
+	char* fields[6];
+	size_t capacity = 0;
+	unsigned long sequence = 0;
+	unsigned long last = 0;
+	off_t end = 0;
+	off_t start = 0;
+	int result = 0;
+
+	end = lseek(descriptor, 0, SEEK_END);
+	if (end <= 0 || (file = fdopen(dup(descriptor), "r")) == NULL) {
+		return 0;
+	}
+
+	for (start = end > JOURNAL_TAIL ? end - JOURNAL_TAIL : 0; ;
+		start = 0) {
+		fseek(file, (long) start, SEEK_SET);
+
+		/*
+		** The first line read from the middle of the file is partial
+		*/
+		if (start > 0) {
+			readJournalLine(file, &line, &capacity);
+		}
+
+		while ((result = readJournalLine(file, &line, &capacity)) == 1) {
+			if (parseJournalLine(line, fields, 6) >= 2 &&
+				strcmp(fields[0], "I") == 0) {
+				sequence = strtoul(fields[1], NULL, 10);
+				if (sequence > last) {
+					last = sequence;
+				}
+			}
+		}
+
+		if (last > 0 || start == 0 || result < 0) {
+			break;
+		}
+	}
+
+	free(line);
+	fclose(file);
+
+	return last;
+
+} /* findJournalSequence() */
+
+
+
+/*
+** Synchronizes the directory of a file, so that the file is not lost
+** if the system crashes. Returns 0 if successful, -1 otherwise
+*/
+static int
+syncJournalDirectory (
+	char* fileName
+) {
+	char* directoryName = NULL;
+	char* slash = NULL;
+	int descriptor = -1;
+	int result = 0;
+
+	directoryName = (char*) malloc(strlen(fileName) + 2);
+	if (directoryName == NULL) {
+		return -1;
+	}
+
+	strcpy(directoryName, fileName);
+	slash = strrchr(directoryName, '/');
+	if (slash == NULL) {
+		strcpy(directoryName, ".");
+	}
+	else {
+		slash[slash == directoryName ? 1 : 0] = '\0';
+	}
+
+	descriptor = open(directoryName, O_RDONLY);
+	if (descriptor < 0 || fsync(descriptor) < 0) {
+		result = -1;
+	}
+
+	if (descriptor >= 0) {
+		close(descriptor);
+	}
+	free(directoryName);
+
+	return result;
+
+} /* syncJournalDirectory() */
+
+
+
+/*
+** Adds the command of an intent record to the unresolved ones. Returns
+** 0 if successful, -1 if memory runs out
+*/
+static int
+addJournalEntry (
+	RRPJOURNALREADER* reader,
+	char** fields
+) {
+	RRPJOURNALENTRY* entry = NULL;
+	RRPJOURNALENTRY* grown = NULL;
+	int capacity = 0;
+	int i = 0;
+
+	/*
+	** Resolved entries are removed in one pass when the array is full
+	** and at least half of it is resolved, so each record costs the same
+	** however long the journal
+	*/
+	if (reader->count == reader->capacity && reader->resolved > 0 &&
+		reader->resolved >= reader->count / 2) {
+		reader->count = 0;
+		for (i = 0; i < reader->capacity; i++) {
+			if (reader->entries[i].name != NULL) {
+				reader->entries[reader->count++] = reader->entries[i];
+			}
+		}
+		reader->resolved = 0;
+	}
+
+	if (reader->count == reader->capacity) {
+		capacity = reader->capacity > 0 ? reader->capacity * 2 : 64;
+		grown = (RRPJOURNALENTRY*) realloc(reader->entries,
+			capacity * sizeof(RRPJOURNALENTRY));
+		if (grown == NULL) {
+			return -1;
+		}
+		reader->entries = grown;
+		reader->capacity = capacity;
+	}
+
+	unescapeJournalText(fields[4]);
+	unescapeJournalText(fields[5]);
+
+	entry = &reader->entries[reader->count];
+	entry->sequence = strtoul(fields[1], NULL, 10);
+	entry->time = strtol(fields[2], NULL, 10);
+	entry->command = (RRPCOMMAND) atoi(fields[3]);
+	entry->code = -1;
+	entry->outcome = RRP_OUTCOME_UNKNOWN;
+	entry->name = (char*) malloc(strlen(fields[4]) + 1);
+	entry->request = (char*) malloc(strlen(fields[5]) + 1);
+
+	if (entry->name == NULL || entry->request == NULL) {
+		free(entry->name);
+		free(entry->request);
+		return -1;
+	}
+
+	strcpy(entry->name, fields[4]);
+	strcpy(entry->request, fields[5]);
+	reader->count++;
+
+	return 0;
+
+} /* addJournalEntry() */
+
+
+
+/*
+** Applies an outcome record to the unresolved commands: a command whose
+** outcome is known is marked resolved, and one whose outcome is unknown
+** keeps its response code
+*/
+static void
+resolveJournalEntry (
+	RRPJOURNALREADER* reader,
+	char** fields
+) {
+	RRPJOURNALENTRY* entry = NULL;
+	unsigned long sequence = 0;
+	int low = 0;
+	int high = reader->count - 1;
+	int middle = 0;
+
+	sequence = strtoul(fields[1], NULL, 10);
+
+	while (low <= high) {
+		middle = (low + high) / 2;
+		entry = &reader->entries[middle];
+
+		if (entry->sequence < sequence) {
+			low = middle + 1;
+		}
+		else if (entry->sequence > sequence) {
+			high = middle - 1;
+		}
+		else {
+			if (entry->name == NULL) {
+				return;
+			}
+
+			if ((RRPOUTCOME) atoi(fields[3]) == RRP_OUTCOME_UNKNOWN) {
+				entry->code = atoi(fields[2]);
+				return;
+			}
+
+			free(entry->name);
+			free(entry->request);
+			entry->name = NULL;
+			entry->request = NULL;
+			reader->resolved++;
+			return;
+		}
+	}
+
+} /* resolveJournalEntry() */
@@ -0,0 +1,898 @@
+/* ===========================================================================
+ * Copyright (C) 2000 VeriSign, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * VeriSign Global Registry Service
+ * 21345 Ridgetop Circle
+ * Dulles, VA 20166
+ * ===========================================================================
+ * The RRP, APIs and Software are provided "as-is" and without any warranty
+ * of any kind.  NSI EXPRESSLY DISCLAIMS ALL WARRANTIES AND/OR CONDITIONS,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * AND CONDITIONS OF MERCHANTABILITY OR SATISFACTORY QUALITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE AND NONINFRINGEMENT OF THIRD PARTY RIGHTS.  NSI DOES
+ * NOT WARRANT THAT THE FUNCTIONS CONTAINED IN THE RRP, APIs OR SOFTWARE
+ * WILL MEET REGISTRAR'S REQUIREMENTS, OR THAT THE OPERATION OF THE RRP,
+ * APIs OR SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE,OR THAT DEFECTS IN
+ * THE RRP, APIs OR SOFTWARE WILL BE CORRECTED.  FURTHERMORE, NSI DOES NOT
+ * WARRANT NOR MAKE ANY REPRESENTATIONS REGARDING THE USE OR THE RESULTS OF
+ * THE RRP, APIs, SOFTWARE OR RELATED DOCUMENTATION IN TERMS OF THEIR
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR OTHERWISE.  SHOULD THE RRP, APIs
+ * OR SOFTWARE PROVE DEFECTIVE, REGISTRAR ASSUMES THE ENTIRE COST OF ALL
+ * NECESSARY SERVICING, REPAIR OR CORRECTION.
+ * ======================================================================== */
+
+/*
+**
+** Module Name: rrpMigrate.c
+**
+** Version: 2.1 for RRP version 2.1.0
+**
+** Date: Oct. 19th, 2026
+**
+** Description: rrpMigrate moves domain names from one set of name
+**              servers to another. The mapping file gives the new set
+**              of name servers for each old set, one mapping per line:
+**
+**                old1 old2 ... => new1 new2 ...
+**
+**              The domain names are read one per line from a file,
+**              optionally followed by their current name servers:
+**
+**                domain [ns1 ns2 ...]
+**
+**              (fields separated by commas or white space). If the name
+**              servers are not given they are fetched with a Status
+**              command. The current set is looked up in the mapping and
+**              a single Mod command adds the new name servers that are
+**              missing and deletes the old ones that are not kept; no
+**              command is sent if the domain already uses the new set.
+**              Name servers are compared without regard to case or a
+**              trailing dot, and the order in which they are listed does
+**              not matter.
+**
+**              The commands are pipelined over a pool of sessions (see
+**              rrpSession.h). The commands of one domain are never in
+**              flight at the same time: if a domain name appears again
+**              while it is being migrated, the later record waits until
+**              the earlier one completes. One line is written for each
+**              record, in the order the records complete:
+**
+**                domain,result,code
+**
+**              where result is "modified", "unchanged" (already uses the
+**              new set), "unmapped" (the current set is not in the
+**              mapping), "refused" (the server refused the Status or Mod
+**              command; code is the response code) or "failed" (the
+**              session failed; code is 0). A session that fails logs in
+**              again and repeats its Status commands. A migration can
+**              safely be run again on the same input, e.g. to retry the
+**              failures, since the domains already migrated are then
+**              "unchanged".
+**
+** Usage:       rrpMigrate -h host[,host...] [-p port] -u id [-w password]
+**                  -m mapping -i input [-o results] [-s sessions]
+**                  [-n window] [-r rate] [-q]
+**
+**              The password is taken from the RRP_PASSWORD environment
+**              variable if -w is not given. Several servers may be
+**              given to -h, each as host or host:port; the sessions are
+**              then spread over them and leave those that fail (see
+**              rrpEndpoint.h).
+**
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <signal.h>
+#include <unistd.h>
+#include <strings.h>
+#include <sys/time.h>
+#include "rrpAPI.h"
+#include "rrpSession.h"
+#include "rrpGovernor.h"
+#include "rrpRetry.h"
+#include "rrpEndpoint.h"
+#include "rrpInternalError.h"
+#include "rrpTool.h"
+
+/*
+** Longest line and name accepted, most name servers in a set, and number
+** of buckets of the hash tables
+*/
+#define MIGRATE_MAX_LINE 4096
+#define MIGRATE_MAX_NAME 256
+#define MIGRATE_MAX_SERVERS 13
+#define MIGRATE_BUCKETS 4096
+
+/*
+** Results of a record
+*/
+#define MIGRATE_MODIFIED 0
+#define MIGRATE_UNCHANGED 1
+#define MIGRATE_UNMAPPED 2
+#define MIGRATE_REFUSED 3
+#define MIGRATE_FAILED 4
+
+/*
+** A set of name servers, in canonical form (lower case, no trailing
+** dot) and sorted
+*/
+typedef struct {
+	int count;
+	char names[MIGRATE_MAX_SERVERS][MIGRATE_MAX_NAME];
+} NSSET;
+
+/*
+** A mapping from an old set to a new set. It is linked in the table of
+** old sets and in the table of new sets
+*/
+typedef struct _MAPPING  MAPPING;
+
+struct _MAPPING {
+	NSSET from;
+	NSSET to;
+	MAPPING* nextFrom;
+	MAPPING* nextTo;
+};
+
+/*
+** A record being migrated. The first record of a domain name is linked
+** in the table of domains in flight; the records of the same domain read
+** after it wait in its 'waiting' list
+*/
+typedef struct _MIGRATESLOT  MIGRATESLOT;
+
+struct _MIGRATESLOT {
+	char name[MIGRATE_MAX_NAME];
+	NSSET current;
+	int haveCurrent;
+	unsigned long hash;
+	MIGRATESLOT* next;          /* next free slot, or next in the table */
+	MIGRATESLOT* waiting;       /* next record of the same domain */
+};
+
+static MAPPING* fromTable[MIGRATE_BUCKETS];
+static MAPPING* toTable[MIGRATE_BUCKETS];
+static MIGRATESLOT* flightTable[MIGRATE_BUCKETS];
+static RRPSESSIONPOOL* pool = NULL;
+static FILE* results = NULL;
+static MIGRATESLOT* freeSlots = NULL;
+static int inFlight = 0;
+static unsigned long counts[5];
+static const char* resultNames[5] = {
+	"modified", "unchanged", "unmapped", "refused", "failed"
+};
+
+static void usage (char*);
+static int addServer (NSSET*, const char*);
+static unsigned long hashSet (NSSET*);
+static int equalSets (NSSET*, NSSET*);
+static int containsServer (NSSET*, const char*);
+static int loadMapping (char*);
+static int parseRecord (char*, MIGRATESLOT*);
+static void startRecord (MIGRATESLOT*);
+static void migrateRecord (MIGRATESLOT*);
+static void finishRecord (MIGRATESLOT*, int, int);
+static void completeStatus (RRPREQUEST*, RRPRESPONSE*, void*);
+static void completeModify (RRPREQUEST*, RRPRESPONSE*, void*);
+
+int
+main (
+	int argc,
+	char** argv
+) {
+	MIGRATESLOT* slots = NULL;
+	MIGRATESLOT* slot = NULL;
+	MIGRATESLOT* first = NULL;
+	FILE* input = NULL;
+	RRPGOVERNOR* governor = NULL;
+	RRPRETRYPOLICY* reconnect = NULL;
+	RRPENDPOINTS* endpoints = NULL;
+	char* host = NULL;
+	char* registrarID = NULL;
+	char* registrarPassword = getenv("RRP_PASSWORD");
+	char* mappingName = NULL;
+	char* inputName = NULL;
+	char* resultName = NULL;
+	char line[MIGRATE_MAX_LINE];
+	unsigned short int port = 648;
+	unsigned long lineNumber = 0;
+	unsigned long done = 0;
+	unsigned long lastDone = 0;
+	int sessions = 4;
+	int window = RRP_DEFAULT_SESSION_WINDOW;
+	int quiet = 0;
+	int endOfInput = 0;
+	int slotCount = 0;
+	int option = 0;
+	int i = 0;
+	double rate = 0;
+	struct timeval now;
+	struct timeval shown;
+
+	while ((option = getopt(argc, argv, "h:p:u:w:m:i:o:s:n:r:q")) != -1) {
+		switch (option) {
+			case 'h': host = optarg; break;
+			case 'p': port = (unsigned short int) atoi(optarg); break;
+			case 'u': registrarID = optarg; break;
+			case 'w': registrarPassword = optarg; break;
+			case 'm': mappingName = optarg; break;
+			case 'i': inputName = optarg; break;
+			case 'o': resultName = optarg; break;
+			case 's': sessions = atoi(optarg); break;
+			case 'n': window = atoi(optarg); break;
+			case 'r': rate = atof(optarg); break;
+			case 'q': quiet = 1; break;
+			default: usage(argv[0]);
+		}
+	}
+
+	if (host == NULL || registrarID == NULL || registrarPassword == NULL ||
+		mappingName == NULL || inputName == NULL || sessions < 1 ||
+		window < 1 || rate < 0 || optind != argc) {
+		usage(argv[0]);
+	}
+
+	if (loadMapping(mappingName) < 0) {
+		exit(1);
+	}
+
+	if ((input = fopen(inputName, "r")) == NULL) {
+		perror(inputName);
+		exit(1);
+	}
+
+	results = stdout;
+	if (resultName != NULL && (results = fopen(resultName, "w")) == NULL) {
+		perror(resultName);
+		exit(1);
+	}
+
+	slotCount = sessions * window;
+	slots = (MIGRATESLOT*) malloc(slotCount * sizeof(MIGRATESLOT));
+	if (slots == NULL) {
+		fprintf(stderr, "Out of memory\n");
+		exit(1);
+	}
+
+	for (i = 0; i < slotCount; i++) {
+		slots[i].next = freeSlots;
+		freeSlots = &slots[i];
+	}
+
+	/*
+	** The sessions, and their logins, share the process governor
+	*/
+	if ((governor = RRPCreateToolGovernor(rate)) != NULL) {
+		RRPSetProcessGovernor(governor);
+	}
+
+	pool = RRPOpenToolPool(host, port, registrarID, registrarPassword,
+		sessions, window, RRP_DEFAULT_RETRY_ATTEMPTS, &endpoints,
+		&reconnect);
+
+	RRPCatchToolSignals();
+
+	gettimeofday(&shown, NULL);
+
+	while ((!endOfInput && !RRPToolInterrupted) || inFlight > 0) {
+		while (!endOfInput && !RRPToolInterrupted && freeSlots != NULL) {
+			slot = freeSlots;
+
+			if (fgets(line, sizeof(line), input) == NULL) {
+				endOfInput = 1;
+				break;
+			}
+
+			lineNumber++;
+
+			switch (parseRecord(line, slot)) {
+				case 0:
+					continue;
+				case -1:
+					fprintf(stderr, "%s:%lu: invalid record\n", inputName,
+						lineNumber);
+					continue;
+			}
+
+			freeSlots = slot->next;
+			inFlight++;
+
+			/*
+			** A record of a domain in flight waits for the records
+			** before it
+			*/
+			for (first = flightTable[slot->hash % MIGRATE_BUCKETS];
+				first != NULL && strcmp(first->name, slot->name) != 0;
+				first = first->next) {
+			}
+
+			slot->waiting = NULL;
+
+			if (first != NULL) {
+				while (first->waiting != NULL) {
+					first = first->waiting;
+				}
+				first->waiting = slot;
+				continue;
+			}
+
+			slot->next = flightTable[slot->hash % MIGRATE_BUCKETS];
+			flightTable[slot->hash % MIGRATE_BUCKETS] = slot;
+
+			startRecord(slot);
+		}
+
+		if (inFlight > 0 && RRPPollSessionPool(pool, 1000) < 0) {
+			RRPPrintInternalErrorDescription();
+			break;
+		}
+
+		gettimeofday(&now, NULL);
+
+		if (now.tv_sec != shown.tv_sec) {
+			for (done = 0, i = 0; i < 5; i++) {
+				done += counts[i];
+			}
+
+			if (!quiet) {
+				fprintf(stderr, "%lu/s  done %lu  in flight %d  modified %lu  "
+					"unchanged %lu  unmapped %lu  refused %lu  failed %lu\n",
+					(done - lastDone) / (now.tv_sec - shown.tv_sec), done,
+					inFlight, counts[MIGRATE_MODIFIED],
+					counts[MIGRATE_UNCHANGED], counts[MIGRATE_UNMAPPED],
+					counts[MIGRATE_REFUSED], counts[MIGRATE_FAILED]);
+			}
+
+			lastDone = done;
+			shown = now;
+		}
+	}
+
+	RRPFreeSessionPool(pool);
+	RRPFreeRetryPolicy(reconnect);
+	RRPFreeEndpoints(endpoints);
+	if (governor != NULL) {
+		RRPSetProcessGovernor(NULL);
+		RRPFreeGovernor(governor);
+	}
+	fclose(input);
+	free(slots);
+
+	if (results != stdout) {
+		fclose(results);
+	}
+	else {
+		fflush(results);
+	}
+
+	fprintf(stderr, "%lu modified, %lu unchanged, %lu unmapped, "
+		"%lu refused, %lu failed%s\n", counts[MIGRATE_MODIFIED],
+		counts[MIGRATE_UNCHANGED], counts[MIGRATE_UNMAPPED],
+		counts[MIGRATE_REFUSED], counts[MIGRATE_FAILED], (endOfInput && inFlight == 0) ?
+			"" : " (not finished)");
+
+	exit((counts[MIGRATE_REFUSED] > 0 || counts[MIGRATE_FAILED] > 0 || !endOfInput || inFlight > 0) ? 1 : 0);
+
+} /* main() */
+
+
+/*
+** Prints the usage message and exits
+*/
+static void
+usage (
+	char* program
+) {
+	RRPPrintToolUsage(program,
+		"\t-m mapping -i input [-o results] [-s sessions] [-n window]\n"
+		"\t[-r rate] [-q]\n",
+		"\t-m\tmappings \"old1 old2 ... => new1 new2 ...\"\n"
+		"\t-i\trecords \"domain [ns1 ns2 ...]\"; the name servers are\n"
+		"\t\tfetched with Status when not given\n"
+		"\t-o\tresult file (default standard output)\n"
+		"\t-q\tdo not display the progress\n",
+		4);
+
+} /* usage() */
+
+
+/*
+** Adds a name server to a set, in canonical form and in order. Returns 0
+** if successful (or if the name server is already in the set), -1 if
+** the name is invalid or the set is full.
+*/
+static int
+addServer (
+	NSSET* set,
+	const char* name
+) {
+	char canonical[MIGRATE_MAX_NAME];
+	size_t length = strlen(name);
+	size_t i = 0;
+	int position = 0;
+	int order = 0;
+
+	if (length > 0 && name[length - 1] == '.') {
+		length--;
+	}
+
+	if (length == 0 || length >= sizeof(canonical)) {
+		return -1;
+	}
+
+	for (i = 0; i < length; i++) {
+		canonical[i] = (char) tolower((unsigned char) name[i]);
+	}
+	canonical[length] = '\0';
+
+	for (position = 0; position < set->count; position++) {
+		order = strcmp(canonical, set->names[position]);
+		if (order == 0) {
+			return 0;
+		}
+		if (order < 0) {
+			break;
+		}
+	}
+
+	if (set->count == MIGRATE_MAX_SERVERS) {
+		return -1;
+	}
+
+	memmove(set->names[position + 1], set->names[position],
+		(set->count - position) * sizeof(set->names[0]));
+	strcpy(set->names[position], canonical);
+	set->count++;
+
+	return 0;
+
+} /* addServer() */
+
+
+/*
+** Returns the hash value of a set of name servers
+*/
+static unsigned long
+hashSet (
+	NSSET* set
+) {
+	unsigned long hash = (unsigned long) set->count;
+	int i = 0;
+
+	for (i = 0; i < set->count; i++) {
+		hash = hash * 31 + RRPHashToolName(set->names[i]);
+	}
+
+	return hash;
+
+} /* hashSet() */
+
+
+/*
+** Returns 1 if two sets hold the same name servers, 0 otherwise
+*/
+static int
+equalSets (
+	NSSET* a,
+	NSSET* b
+) {
+	int i = 0;
+
+	if (a->count != b->count) {
+		return 0;
+	}
+
+	for (i = 0; i < a->count; i++) {
+		if (strcmp(a->names[i], b->names[i]) != 0) {
+			return 0;
+		}
+	}
+
+	return 1;
+
+} /* equalSets() */
+
+
+/*
+** Returns 1 if a canonical name server is in a set, 0 otherwise
+*/
+static int
+containsServer (
+	NSSET* set,
+	const char* name
+) {
+	int i = 0;
+
+	for (i = 0; i < set->count; i++) {
+		if (strcmp(set->names[i], name) == 0) {
+			return 1;
+		}
+	}
+
+	return 0;
+
+} /* containsServer() */
+
+
+/*
+** Reads the mapping file into the tables of old and new sets. Returns 0
+** if successful, -1 otherwise.
+*/
+static int
+loadMapping (
+	char* fileName
+) {
+	FILE* file = NULL;
+	MAPPING* mapping = NULL;
+	MAPPING* other = NULL;
+	NSSET* set = NULL;
+	char line[MIGRATE_MAX_LINE];
+	char* field = NULL;
+	unsigned long lineNumber = 0;
+	unsigned long count = 0;
+	int valid = 0;
+
+	if ((file = fopen(fileName, "r")) == NULL) {
+		perror(fileName);
+		return -1;
+	}
+
+	while (fgets(line, sizeof(line), file) != NULL) {
+		lineNumber++;
+
+		field = line + strspn(line, " \t,\r\n");
+		if (*field == '\0' || *field == '#') {
+			continue;
+		}
+
+		mapping = (MAPPING*) calloc(1, sizeof(MAPPING));
+		if (mapping == NULL) {
+			fprintf(stderr, "Out of memory\n");
+			fclose(file);
+			return -1;
+		}
+
+		set = &mapping->from;
+		valid = 1;
+
+		for (field = strtok(line, " \t,\r\n"); field != NULL && valid;
+			field = strtok(NULL, " \t,\r\n")) {
+			if (strcmp(field, "=>") == 0 && set == &mapping->from) {
+				set = &mapping->to;
+			}
+			else if (addServer(set, field) < 0) {
+				valid = 0;
+			}
+		}
+
+		if (!valid || set != &mapping->to || mapping->from.count == 0 ||
+			mapping->to.count == 0) {
+			fprintf(stderr, "%s:%lu: invalid mapping\n", fileName,
+				lineNumber);
+			free(mapping);
+			fclose(file);
+			return -1;
+		}
+
+		for (other = fromTable[hashSet(&mapping->from) % MIGRATE_BUCKETS];
+			other != NULL && !equalSets(&other->from, &mapping->from);
+			other = other->nextFrom) {
+		}
+
+		if (other != NULL) {
+			if (!equalSets(&other->to, &mapping->to)) {
+				fprintf(stderr, "%s:%lu: conflicting mapping\n", fileName,
+					lineNumber);
+				free(mapping);
+				fclose(file);
+				return -1;
+			}
+			free(mapping);
+			continue;
+		}
+
+		mapping->nextFrom = fromTable[hashSet(&mapping->from) %
+			MIGRATE_BUCKETS];
+		fromTable[hashSet(&mapping->from) % MIGRATE_BUCKETS] = mapping;
+		mapping->nextTo = toTable[hashSet(&mapping->to) % MIGRATE_BUCKETS];
+		toTable[hashSet(&mapping->to) % MIGRATE_BUCKETS] = mapping;
+		count++;
+	}
+
+	fclose(file);
+
+	if (count == 0) {
+		fprintf(stderr, "%s: no mapping\n", fileName);
+		return -1;
+	}
+
+	return 0;
+
+} /* loadMapping() */
+
+
+/*
+** Splits a record into the domain name and its current name servers.
+** Returns 0 for blank lines and comments, -1 for invalid records, 1
+** otherwise.
+*/
+static int
+parseRecord (
+	char* line,
+	MIGRATESLOT* slot
+) {
+	char* field = NULL;
+	size_t i = 0;
+
+	field = line + strspn(line, " \t,\r\n");
+	if (*field == '\0' || *field == '#') {
+		return 0;
+	}
+
+	field = strtok(line, " \t,\r\n");
+	if (strlen(field) >= sizeof(slot->name)) {
+		return -1;
+	}
+
+	/*
+	** Domain names are compared without regard to case
+	*/
+	for (i = 0; field[i] != '\0'; i++) {
+		slot->name[i] = (char) tolower((unsigned char) field[i]);
+	}
+	slot->name[i] = '\0';
+	slot->hash = RRPHashToolName(slot->name);
+	slot->current.count = 0;
+
+	while ((field = strtok(NULL, " \t,\r\n")) != NULL) {
+		if (addServer(&slot->current, field) < 0) {
+			return -1;
+		}
+	}
+
+	slot->haveCurrent = slot->current.count > 0;
+
+	return 1;
+
+} /* parseRecord() */
+
+
+/*
+** Starts the migration of a record: fetches its name servers if they are
+** not known yet
+*/
+static void
+startRecord (
+	MIGRATESLOT* slot
+) {
+	RRPREQUEST* request = NULL;
+
+	if (slot->haveCurrent) {
+		migrateRecord(slot);
+		return;
+	}
+
+	request = RRPCreateRequest(RRP_STATUS_COMMAND, RRP_DOMAIN_ENTITY,
+		slot->name, strlen(slot->name));
+
+	if (request == NULL ||
+		RRPSubmitPoolRequest(pool, request, completeStatus, slot) < 0) {
+		if (request != NULL) {
+			RRPFreeRequest(request);
+		}
+		finishRecord(slot, MIGRATE_FAILED, 0);
+	}
+
+} /* startRecord() */
+
+
+/*
+** Looks the current name servers of a record up in the mapping and
+** sends the Mod command that moves the domain to the new set
+*/
+static void
+migrateRecord (
+	MIGRATESLOT* slot
+) {
+	RRPREQUEST* request = NULL;
+	MAPPING* mapping = NULL;
+	char value[MIGRATE_MAX_NAME + 1];
+	int result = 0;
+	int i = 0;
+
+	for (mapping = fromTable[hashSet(&slot->current) % MIGRATE_BUCKETS];
+		mapping != NULL && !equalSets(&mapping->from, &slot->current);
+		mapping = mapping->nextFrom) {
+	}
+
+	if (mapping == NULL || equalSets(&mapping->to, &slot->current)) {
+		/*
+		** Not in the mapping: the domain may already use a new set
+		*/
+		if (mapping == NULL) {
+			for (mapping = toTable[hashSet(&slot->current) %
+				MIGRATE_BUCKETS]; mapping != NULL &&
+				!equalSets(&mapping->to, &slot->current);
+				mapping = mapping->nextTo) {
+			}
+		}
+
+		finishRecord(slot, mapping != NULL ? MIGRATE_UNCHANGED : MIGRATE_UNMAPPED, 0);
+		return;
+	}
+
+	request = RRPCreateRequest(RRP_MOD_COMMAND, RRP_DOMAIN_ENTITY,
+		slot->name, strlen(slot->name));
+	result = (request != NULL) ? 0 : -1;
+
+	/*
+	** The new name servers are added before the old ones are deleted, so
+	** the domain is never left without a name server
+	*/
+	for (i = 0; result == 0 && i < mapping->to.count; i++) {
+		if (!containsServer(&slot->current, mapping->to.names[i])) {
+			result = RRPAppendRequestAttribute(request, "NameServer", 10,
+				mapping->to.names[i], strlen(mapping->to.names[i]));
+		}
+	}
+
+	for (i = 0; result == 0 && i < slot->current.count; i++) {
+		if (!containsServer(&mapping->to, slot->current.names[i])) {
+			sprintf(value, "%s=", slot->current.names[i]);
+			result = RRPAppendRequestAttribute(request, "NameServer", 10,
+				value, strlen(value));
+		}
+	}
+
+	if (result == 0) {
+		result = RRPSubmitPoolRequest(pool, request, completeModify, slot);
+	}
+
+	if (result < 0) {
+		if (request != NULL) {
+			RRPFreeRequest(request);
+		}
+		finishRecord(slot, MIGRATE_FAILED, 0);
+	}
+
+} /* migrateRecord() */
+
+
+/*
+** Writes the result line of a record and releases its slot. The next
+** record of the same domain, if any, takes its place in the table of
+** domains in flight and is started
+*/
+static void
+finishRecord (
+	MIGRATESLOT* slot,
+	int result,
+	int code
+) {
+	MIGRATESLOT** link = NULL;
+	MIGRATESLOT* next = slot->waiting;
+
+	fprintf(results, "%s,%s,%d\n", slot->name, resultNames[result], code);
+
+	counts[result]++;
+
+	for (link = &flightTable[slot->hash % MIGRATE_BUCKETS]; *link != slot;
+		link = &(*link)->next) {
+	}
+
+	if (next != NULL) {
+		next->next = slot->next;
+		*link = next;
+	}
+	else {
+		*link = slot->next;
+	}
+
+	slot->next = freeSlots;
+	freeSlots = slot;
+	inFlight--;
+
+	if (next != NULL) {
+		startRecord(next);
+	}
+
+} /* finishRecord() */
+
+
+/*
+** Completion function of the Status commands: collects the name servers
+** of the domain and migrates it
+*/
+static void
+completeStatus (
+	RRPREQUEST* request,
+	RRPRESPONSE* response,
+	void* context
+) {
+	MIGRATESLOT* slot = (MIGRATESLOT*) context;
+	RRPVECTOR* values = NULL;
+	char* key = NULL;
+	int valid = 1;
+	int i = 0;
+
+	if (response == NULL) {
+		finishRecord(slot, MIGRATE_FAILED, 0);
+		return;
+	}
+
+	if (response->code != 200) {
+		finishRecord(slot, MIGRATE_REFUSED, response->code);
+		RRPFreeResponse(response);
+		return;
+	}
+
+	if (response->attributes != NULL) {
+		RRPResetPropertyPointer(response->attributes);
+
+		while ((key = RRPGetNextPropertyKey(response->attributes)) != NULL) {
+			if (strcasecmp(key, "nameserver") != 0) {
+				continue;
+			}
+
+			values = RRPGetProperty(response->attributes, key);
+			for (i = 0; valid && i < RRPGetVectorSize(values); i++) {
+				if (addServer(&slot->current,
+					RRPGetVectorElementAt(values, i)) < 0) {
+					valid = 0;
+				}
+			}
+		}
+	}
+
+	RRPFreeResponse(response);
+
+	if (!valid) {
+		fprintf(stderr, "%s: too many name servers\n", slot->name);
+		finishRecord(slot, MIGRATE_UNMAPPED, 0);
+		return;
+	}
+
+	migrateRecord(slot);
+
+} /* completeStatus() */
+
+
+/*
+** Completion function of the Mod commands
+*/
+static void
+completeModify (
+	RRPREQUEST* request,
+	RRPRESPONSE* response,
+	void* context
+) {
+	MIGRATESLOT* slot = (MIGRATESLOT*) context;
+
+	if (response == NULL) {
+		finishRecord(slot, MIGRATE_FAILED, 0);
+		return;
+	}
+
+	finishRecord(slot, response->code / 100 == 2 ?
+		MIGRATE_MODIFIED : MIGRATE_REFUSED,
+		response->code);
+	RRPFreeResponse(response);
+
+} /* completeModify() */
@@ -0,0 +1,972 @@
+/* ===========================================================================
+ * Copyright (C) 2000 VeriSign, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * VeriSign Global Registry Service
+ * 21345 Ridgetop Circle
+ * Dulles, VA 20166
+ * ===========================================================================
+ * The RRP, APIs and Software are provided "as-is" and without any warranty
+ * of any kind.  NSI EXPRESSLY DISCLAIMS ALL WARRANTIES AND/OR CONDITIONS,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * AND CONDITIONS OF MERCHANTABILITY OR SATISFACTORY QUALITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE AND NONINFRINGEMENT OF THIRD PARTY RIGHTS.  NSI DOES
+ * NOT WARRANT THAT THE FUNCTIONS CONTAINED IN THE RRP, APIs OR SOFTWARE
+ * WILL MEET REGISTRAR'S REQUIREMENTS, OR THAT THE OPERATION OF THE RRP,
+ * APIs OR SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE,OR THAT DEFECTS IN
+ * THE RRP, APIs OR SOFTWARE WILL BE CORRECTED.  FURTHERMORE, NSI DOES NOT
+ * WARRANT NOR MAKE ANY REPRESENTATIONS REGARDING THE USE OR THE RESULTS OF
+ * THE RRP, APIs, SOFTWARE OR RELATED DOCUMENTATION IN TERMS OF THEIR
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR OTHERWISE.  SHOULD THE RRP, APIs
+ * OR SOFTWARE PROVE DEFECTIVE, REGISTRAR ASSUMES THE ENTIRE COST OF ALL
+ * NECESSARY SERVICING, REPAIR OR CORRECTION.
+ * ======================================================================== */
+
+/*
+**
+** Module Name: rrpPlan.c
+**
+** Version: 2.1 for RRP version 2.1.0
+**
+** Date: Oct. 19th, 2026
+**
+** Description: rrpPlan computes the smallest Mod command that brings a
+**              domain or name server from its current state to a
+**              desired state (see rrpPlan.h).
+**
+** Entry Points:
+**
+**    RRPPlanListChanges(RRPVECTOR*, RRPVECTOR*, int, RRPLISTCHANGES*);
+**    RRPPlanModifyDomain(RRPRESPONSE*, RRPVECTOR*, RRPVECTOR*,
+**        RRPDOMAINPLAN*);
+**    RRPPlanModifyNameServer(RRPRESPONSE*, RRPVECTOR*,
+**        RRPNAMESERVERPLAN*);
+**    RRPCreateDomainPlanRequest(char*, RRPDOMAINPLAN*);
+**    RRPCreateNameServerPlanRequest(char*, RRPNAMESERVERPLAN*);
+**    RRPFreeListChanges(RRPLISTCHANGES*);
+**    RRPFreeDomainPlan(RRPDOMAINPLAN*);
+**    RRPFreeNameServerPlan(RRPNAMESERVERPLAN*);
+**
+** Changes:
+**
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <ctype.h>
+#include "rrpPlan.h"
+#include "rrpInternalError.h"
+
+/*
+** Prefix of the statuses a registrar can set
+*/
+#define RRP_PLAN_REGISTRAR_PREFIX "REGISTRAR-"
+
+/*
+** A value of a list, with the key it is compared by
+*/
+typedef struct {
+	char* value;
+	char* key;
+} RRPPLANENTRY;
+
+
+/*
+** Functions used internally to compare the lists and to build the
+** requests
+*/
+static int collectPlanEntries (RRPVECTOR*, int, RRPPLANENTRY**, int*);
+static void freePlanEntries (RRPPLANENTRY*, int);
+static int comparePlanEntries (const void*, const void*);
+static int addPlanValue (RRPVECTOR**, char*);
+static RRPVECTOR* getResponseValues (RRPRESPONSE*, const char*, RRPBOOLEAN);
+static RRPVECTOR* getRegistrarStatuses (RRPVECTOR*);
+static int appendPlanChanges (RRPREQUEST*, const char*, RRPLISTCHANGES*);
+
+
+
+
+
+
+
+/*
+**
+** Function: RRPPlanListChanges
+**
+** Description: Computes the changes that turn a list of values into
+**              another. Duplicate values count once
+**
+** Input: RRPVECTOR* - the current values, NULL if none
+**        RRPVECTOR* - the desired values, NULL if none
+**        int - options: RRP_PLAN_CASELESS, RRP_PLAN_HOST_NAMES and
+**              RRP_PLAN_REPLACE, or'ed together
+**
+** Output: RRPLISTCHANGES* - the changes. Added values are taken from
+**                           the desired list and deleted values from
+**                           the current list
+**
+** Return: int - the number of values added, replaced and deleted, 0 if
+**               the lists hold the same values. -1 is returned if an
+**               internal error occurs.
+**
+** Note: THE MEMORY ALLOCATED FOR THE CHANGES MUST BE RELEASED BY
+**       CALLING THE RRPFreeListChanges() FUNCTION
+**
+*/
+int
+RRPPlanListChanges (
+	RRPVECTOR* current,
+	RRPVECTOR* desired,
+	int options,
+	RRPLISTCHANGES* changes
+) {
+	RRPPLANENTRY* currentEntries = NULL;
+	RRPPLANENTRY* desiredEntries = NULL;
+	int currentCount = 0;
+	int desiredCount = 0;
+	RRPVECTOR* added = NULL;
+	RRPVECTOR* deleted = NULL;
+	int i = 0;
+	int j = 0;
+	int difference = 0;
+	int result = 0;
+	int count = 0;
+
+	/*
+	** Validate parameters
+	*/
+	if (changes == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	changes->added = NULL;
+	changes->modified = NULL;
+	changes->deleted = NULL;
+
+	if (collectPlanEntries(current, options, &currentEntries,
+		&currentCount) < 0) {
+		return -1;
+	}
+
+	if (collectPlanEntries(desired, options, &desiredEntries,
+		&desiredCount) < 0) {
+		freePlanEntries(currentEntries, currentCount);
+		return -1;
+	}
+
+	/*
+	** Both lists are sorted: walk them side by side
+	*/
+	while (result == 0 && (i < currentCount || j < desiredCount)) {
+		if (i == currentCount) {
+			difference = 1;
+		}
+		else if (j == desiredCount) {
+			difference = -1;
+		}
+		else {
+			difference = strcmp(currentEntries[i].key, desiredEntries[j].key);
+		}
+
+		if (difference < 0) {
+			result = addPlanValue(&deleted, currentEntries[i++].value);
+		}
+		else if (difference > 0) {
+			result = addPlanValue(&added, desiredEntries[j++].value);
+		}
+		else {
+			i++;
+			j++;
+		}
+	}
+
+	freePlanEntries(currentEntries, currentCount);
+	freePlanEntries(desiredEntries, desiredCount);
+
+	/*
+	** A value deleted while another is added is replaced on a single
+	** line instead
+	*/
+	if (result == 0 && (options & RRP_PLAN_REPLACE) && added != NULL &&
+		deleted != NULL) {
+		changes->modified = RRPCreateProperties();
+		if (changes->modified == NULL) {
+			result = -1;
+		}
+
+		while (result == 0 && RRPGetVectorSize(added) > 0 &&
+			RRPGetVectorSize(deleted) > 0) {
+			result = RRPPutProperty(changes->modified,
+				RRPGetVectorElementAt(deleted, 0),
+				RRPGetVectorElementAt(added, 0));
+			if (result == 0) {
+				RRPDeleteVectorElementAt(deleted, 0);
+				RRPDeleteVectorElementAt(added, 0);
+				count++;
+			}
+		}
+	}
+
+	if (added != NULL && result == 0) {
+		count += RRPGetVectorSize(added);
+		if (RRPGetVectorSize(added) == 0) {
+			RRPFreeVector(added);
+			added = NULL;
+		}
+	}
+
+	if (deleted != NULL && result == 0) {
+		count += RRPGetVectorSize(deleted);
+		if (RRPGetVectorSize(deleted) == 0) {
+			RRPFreeVector(deleted);
+			deleted = NULL;
+		}
+	}
+
+	changes->added = added;
+	changes->deleted = deleted;
+
+	if (result < 0) {
+		RRPFreeListChanges(changes);
+		return -1;
+	}
+
+	return count;
+
+} /* RRPPlanListChanges */
+
+
+
+
+
+
+/*
+**
+** Function: RRPPlanModifyDomain
+**
+** Description: Computes the arguments of the smallest RRPModifyDomain()
+**              call that gives a domain the desired name servers and
+**              statuses
+**
+** Input: RRPRESPONSE* - the Status response of the domain (see
+**                       RRPStatusDomain())
+**        RRPVECTOR* - the desired name servers. NULL leaves the name
+**                     servers as they are
+**        RRPVECTOR* - the desired statuses. NULL leaves the statuses as
+**                     they are
+**
+** Output: RRPDOMAINPLAN* - the plan
+**
+** Return: int - the number of values added, replaced and deleted, 0 if
+**               the domain is already in the desired state. -1 is
+**               returned if an internal error occurs.
+**
+** Note: THE MEMORY ALLOCATED FOR THE PLAN MUST BE RELEASED BY CALLING
+**       THE RRPFreeDomainPlan() FUNCTION
+**
+*/
+int
+RRPPlanModifyDomain (
+	RRPRESPONSE* status,
+	RRPVECTOR* desiredNameServers,
+	RRPVECTOR* desiredStatuses,
+	RRPDOMAINPLAN* plan
+) {
+	RRPVECTOR* current = NULL;
+	RRPVECTOR* desired = NULL;
+	int count = 0;
+	int result = 0;
+
+	/*
+	** Validate parameters
+	*/
+	if (plan == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	memset(plan, 0, sizeof(RRPDOMAINPLAN));
+
+	if (status == NULL || status->code != 200) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	if (desiredNameServers != NULL) {
+		current = getResponseValues(status, "NameServer", RRPFALSE);
+		if (current == NULL) {
+			return -1;
+		}
+
+		count = RRPPlanListChanges(current, desiredNameServers,
+			RRP_PLAN_HOST_NAMES | RRP_PLAN_REPLACE, &plan->nameServers);
+		RRPFreeVector(current);
+		if (count < 0) {
+			return -1;
+		}
+	}
+
+	/*
+	** The statuses set by the registry are left out on both sides, so
+	** that they are neither added nor deleted
+	*/
+	if (desiredStatuses != NULL) {
+		current = getResponseValues(status, "Status", RRPTRUE);
+		desired = getRegistrarStatuses(desiredStatuses);
+		if (current == NULL || desired == NULL) {
+			result = -1;
+		}
+		else {
+			result = RRPPlanListChanges(current, desired, RRP_PLAN_CASELESS,
+				&plan->statuses);
+		}
+
+		if (current != NULL) {
+			RRPFreeVector(current);
+		}
+
+		if (desired != NULL) {
+			RRPFreeVector(desired);
+		}
+
+		if (result < 0) {
+			RRPFreeDomainPlan(plan);
+			return -1;
+		}
+
+		count += result;
+	}
+
+	return count;
+
+} /* RRPPlanModifyDomain */
+
+
+
+
+
+
+/*
+**
+** Function: RRPPlanModifyNameServer
+**
+** Description: Computes the arguments of the smallest
+**              RRPModifyNameServer() call that gives a name server the
+**              desired IP addresses
+**
+** Input: RRPRESPONSE* - the Status response of the name server (see
+**                       RRPStatusNameServer())
+**        RRPVECTOR* - the desired IP addresses
+**
+** Output: RRPNAMESERVERPLAN* - the plan
+**
+** Return: int - the number of addresses added, replaced and deleted, 0
+**               if the name server is already in the desired state. -1
+**               is returned if an internal error occurs.
+**
+** Note: THE MEMORY ALLOCATED FOR THE PLAN MUST BE RELEASED BY CALLING
+**       THE RRPFreeNameServerPlan() FUNCTION
+**
+*/
+int
+RRPPlanModifyNameServer (
+	RRPRESPONSE* status,
+	RRPVECTOR* desiredIPAddresses,
+	RRPNAMESERVERPLAN* plan
+) {
+	RRPVECTOR* current = NULL;
+	int count = 0;
+
+	/*
+	** Validate parameters
+	*/
+	if (plan == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	memset(plan, 0, sizeof(RRPNAMESERVERPLAN));
+
+	if (status == NULL || status->code != 200 ||
+		desiredIPAddresses == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	current = getResponseValues(status, "IPAddress", RRPFALSE);
+	if (current == NULL) {
+		return -1;
+	}
+
+	count = RRPPlanListChanges(current, desiredIPAddresses, RRP_PLAN_REPLACE,
+		&plan->ipAddresses);
+	RRPFreeVector(current);
+
+	return count;
+
+} /* RRPPlanModifyNameServer */
+
+
+
+
+
+
+/*
+**
+** Function: RRPCreateDomainPlanRequest
+**
+** Description: Creates the Mod request of a domain plan, e.g. to submit
+**              it to a session (see rrpSession.h)
+**
+** Input: char* - the domain name
+**        RRPDOMAINPLAN* - the plan
+**
+** Output: none
+**
+** Return: RRPREQUEST* - a pointer to an allocated RRPREQUEST structure.
+**                       NULL is returned if an internal error occurs.
+**
+** Note: THE MEMORY ALLOCATED FOR THE RRPREQUEST STRUCTURE MUST BE
+**       RELEASED BY CALLING THE RRPFreeRequest() FUNCTION
+**
+*/
+RRPREQUEST*
+RRPCreateDomainPlanRequest (
+	char* domainName,
+	RRPDOMAINPLAN* plan
+) {
+	RRPREQUEST* request = NULL;
+
+	/*
+	** Validate parameters
+	*/
+	if (domainName == NULL || plan == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return NULL;
+	}
+
+	request = RRPCreateRequest(RRP_MOD_COMMAND, RRP_DOMAIN_ENTITY,
+		domainName, strlen(domainName));
+	if (request == NULL) {
+		return NULL;
+	}
+
+	if (appendPlanChanges(request, "NameServer", &plan->nameServers) < 0 ||
+		appendPlanChanges(request, "Status", &plan->statuses) < 0) {
+		RRPFreeRequest(request);
+		return NULL;
+	}
+
+	return request;
+
+} /* RRPCreateDomainPlanRequest */
+
+
+
+
+
+
+/*
+**
+** Function: RRPCreateNameServerPlanRequest
+**
+** Description: Creates the Mod request of a name server plan, e.g. to
+**              submit it to a session (see rrpSession.h)
+**
+** Input: char* - the name server's host name
+**        RRPNAMESERVERPLAN* - the plan
+**
+** Output: none
+**
+** Return: RRPREQUEST* - a pointer to an allocated RRPREQUEST structure.
+**                       NULL is returned if an internal error occurs.
+**
+** Note: THE MEMORY ALLOCATED FOR THE RRPREQUEST STRUCTURE MUST BE
+**       RELEASED BY CALLING THE RRPFreeRequest() FUNCTION
+**
+*/
+RRPREQUEST*
+RRPCreateNameServerPlanRequest (
+	char* nameServer,
+	RRPNAMESERVERPLAN* plan
+) {
+	RRPREQUEST* request = NULL;
+
+	/*
+	** Validate parameters
+	*/
+	if (nameServer == NULL || plan == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return NULL;
+	}
+
+	request = RRPCreateRequest(RRP_MOD_COMMAND, RRP_NAMESERVER_ENTITY,
+		nameServer, strlen(nameServer));
+	if (request == NULL) {
+		return NULL;
+	}
+
+	if (appendPlanChanges(request, "IPAddress", &plan->ipAddresses) < 0) {
+		RRPFreeRequest(request);
+		return NULL;
+	}
+
+	return request;
+
+} /* RRPCreateNameServerPlanRequest */
+
+
+
+
+
+
+/*
+**
+** Function: RRPFreeListChanges
+**
+** Description: Frees the vectors and properties of a list of changes
+**              and sets them to NULL
+**
+** Input: RRPLISTCHANGES* - a pointer to an RRPLISTCHANGES structure
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+int
+RRPFreeListChanges (
+	RRPLISTCHANGES* changes
+) {
+
+	/*
+	** Validate parameters
+	*/
+	if (changes == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	if (changes->added != NULL) {
+		RRPFreeVector(changes->added);
+		changes->added = NULL;
+	}
+
+	if (changes->modified != NULL) {
+		RRPFreeProperties(changes->modified);
+		changes->modified = NULL;
+	}
+
+	if (changes->deleted != NULL) {
+		RRPFreeVector(changes->deleted);
+		changes->deleted = NULL;
+	}
+
+	return 0;
+
+} /* RRPFreeListChanges */
+
+
+
+
+
+
+/*
+**
+** Function: RRPFreeDomainPlan
+**
+** Description: Frees the vectors and properties of a domain plan and
+**              sets them to NULL
+**
+** Input: RRPDOMAINPLAN* - a pointer to an RRPDOMAINPLAN structure
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+int
+RRPFreeDomainPlan (
+	RRPDOMAINPLAN* plan
+) {
+
+	/*
+	** Validate parameters
+	*/
+	if (plan == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	RRPFreeListChanges(&plan->nameServers);
+	RRPFreeListChanges(&plan->statuses);
+
+	return 0;
+
+} /* RRPFreeDomainPlan */
+
+
+
+
+
+
+/*
+**
+** Function: RRPFreeNameServerPlan
+**
+** Description: Frees the vectors and properties of a name server plan
+**              and sets them to NULL
+**
+** Input: RRPNAMESERVERPLAN* - a pointer to an RRPNAMESERVERPLAN
+**                             structure
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+int
+RRPFreeNameServerPlan (
+	RRPNAMESERVERPLAN* plan
+) {
+
+	/*
+	** Validate parameters
+	*/
+	if (plan == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	RRPFreeListChanges(&plan->ipAddresses);
+
+	return 0;
+
+} /* RRPFreeNameServerPlan */
+
+
+
+
+
+
+/*
+** Builds the sorted array of the distinct values of a vector, keyed as
+** 'options' asks. A NULL vector gives an empty array
+*/
+static int
+collectPlanEntries (
+	RRPVECTOR* vector,
+	int options,
+	RRPPLANENTRY** entries,
+	int* count
+) {
+	RRPELEMENT_NODE* element = NULL;
+	RRPPLANENTRY* array = NULL;
+	size_t length = 0;
+	char* key = NULL;
+	int size = 0;
+	int i = 0;
+	int j = 0;
+
+	*entries = NULL;
+	*count = 0;
+
+	if (vector == NULL || (size = RRPGetVectorSize(vector)) == 0) {
+		return 0;
+	}
+
+	array = (RRPPLANENTRY*) malloc(size * sizeof(RRPPLANENTRY));
+	if (array == NULL) {
+		RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
+		return -1;
+	}
+
+	for (element = vector->head; element != NULL; element = element->next) {
+		length = strlen(element->value);
+		if ((options & RRP_PLAN_HOST_NAMES) && length > 1 &&
+			element->value[length - 1] == '.') {
+			length--;
+		}
+
+		key = (char*) malloc(length + 1);
+		if (key == NULL) {
+			freePlanEntries(array, i);
+			RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
+			return -1;
+		}
+
+		for (j = 0; j < (int) length; j++) {
+			key[j] = (options & (RRP_PLAN_CASELESS | RRP_PLAN_HOST_NAMES)) ?
+				tolower((unsigned char) element->value[j]) : element->value[j];
+		}
+		key[length] = '\0';
+
+		array[i].value = element->value;
+		array[i].key = key;
+		i++;
+	}
+
+	qsort(array, i, sizeof(RRPPLANENTRY), comparePlanEntries);
+
+	/*
+	** Keep the first of equal values
+	*/
+	for (size = 0, j = 0; j < i; j++) {
+		if (size > 0 && strcmp(array[size - 1].key, array[j].key) == 0) {
+			free(array[j].key);
+		}
+		else {
+			array[size++] = array[j];
+		}
+	}
+
+	*entries = array;
+	*count = size;
+	return 0;
+
+} /* collectPlanEntries() */
+
+
+
+
+
+
+static void
+freePlanEntries (
+	RRPPLANENTRY* entries,
+	int count
+) {
+	int i = 0;
+
+	for (i = 0; i < count; i++) {
+		free(entries[i].key);
+	}
+
+	free(entries);
+
+} /* freePlanEntries() */
+
+
+
+
+
+
+static int
+comparePlanEntries (
+	const void* first,
+	const void* second
+) {
+
+	return strcmp(((const RRPPLANENTRY*) first)->key,
+		((const RRPPLANENTRY*) second)->key);
+
+} /* comparePlanEntries() */
+
+
+
+
+
+
+/*
+** Adds a value to a vector, creating the vector the first time
+*/
+static int
+addPlanValue (
+	RRPVECTOR** vector,
+	char* value
+) {
+
+	if (*vector == NULL) {
+		*vector = RRPCreateVector();
+		if (*vector == NULL) {
+			return -1;
+		}
+	}
+
+	return RRPAddVectorElement(*vector, value);
+
+} /* addPlanValue() */
+
+
+
+
+
+
+/*
+** Returns a new vector of the values of a response attribute. The
+** attribute name is compared without regard to case since the server
+** may send it in any case. 'registrar' keeps only the statuses a
+** registrar can set
+*/
+static RRPVECTOR*
+getResponseValues (
+	RRPRESPONSE* response,
+	const char* key,
+	RRPBOOLEAN registrar
+) {
+	RRPPROPERTY_NODE* node = NULL;
+	RRPELEMENT_NODE* element = NULL;
+	RRPVECTOR* values = NULL;
+	size_t prefixLength = strlen(RRP_PLAN_REGISTRAR_PREFIX);
+
+	values = RRPCreateVector();
+	if (values == NULL || response->attributes == NULL) {
+		return values;
+	}
+
+	/*
+	** Walk the list of properties directly so that the caller's
+	** current property pointer is left alone
+	*/
+	for (node = response->attributes->head; node != NULL;
+		node = node->next) {
+		if (strcasecmp(node->key, key) != 0) {
+			continue;
+		}
+
+		for (element = node->values->head; element != NULL;
+			element = element->next) {
+			if (registrar && strncasecmp(element->value,
+				RRP_PLAN_REGISTRAR_PREFIX, prefixLength) != 0) {
+				continue;
+			}
+
+			if (RRPAddVectorElement(values, element->value) < 0) {
+				RRPFreeVector(values);
+				return NULL;
+			}
+		}
+	}
+
+	return values;
+
+} /* getResponseValues() */
+
+
+
+
+
+
+/*
+** Returns a new vector of the statuses a registrar can set
+*/
+static RRPVECTOR*
+getRegistrarStatuses (
+	RRPVECTOR* statuses
+) {
+	RRPELEMENT_NODE* element = NULL;
+	RRPVECTOR* values = NULL;
+	size_t prefixLength = strlen(RRP_PLAN_REGISTRAR_PREFIX);
+
+	values = RRPCreateVector();
+	if (values == NULL) {
+		return NULL;
+	}
+
+	for (element = statuses->head; element != NULL; element = element->next) {
+		if (strncasecmp(element->value, RRP_PLAN_REGISTRAR_PREFIX,
+			prefixLength) == 0 &&
+			RRPAddVectorElement(values, element->value) < 0) {
+			RRPFreeVector(values);
+			return NULL;
+		}
+	}
+
+	return values;
+
+} /* getRegistrarStatuses() */
+
+
+
+
+
+
+/*
+** Appends the lines of a list of changes to a Mod request: "key:value"
+** for an added value, "key:old=new" for a replaced one and "key:old="
+** for a deleted one
+*/
+static int
+appendPlanChanges (
+	RRPREQUEST* request,
+	const char* key,
+	RRPLISTCHANGES* changes
+) {
+	RRPPROPERTY_NODE* node = NULL;
+	RRPELEMENT_NODE* element = NULL;
+	size_t keyLength = strlen(key);
+	char* line = NULL;
+	size_t length = 0;
+	size_t oldLength = 0;
+	int result = 0;
+
+	if (changes->added != NULL) {
+		for (element = changes->added->head; result == 0 && element != NULL;
+			element = element->next) {
+			result = RRPAppendRequestAttribute(request, key, keyLength,
+				element->value, strlen(element->value));
+		}
+	}
+
+	if (changes->modified != NULL) {
+		for (node = changes->modified->head; result == 0 && node != NULL;
+			node = node->next) {
+			for (element = node->values->head; result == 0 &&
+				element != NULL; element = element->next) {
+				oldLength = strlen(node->key);
+				length = oldLength + 1 + strlen(element->value);
+				line = (char*) malloc(length + 1);
+				if (line == NULL) {
+					RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
+					return -1;
+				}
+
+				sprintf(line, "%s=%s", node->key, element->value);
+				result = RRPAppendRequestAttribute(request, key, keyLength,
+					line, length);
+				free(line);
+			}
+		}
+	}
+
+	if (changes->deleted != NULL) {
+		for (element = changes->deleted->head; result == 0 &&
+			element != NULL; element = element->next) {
+			length = strlen(element->value);
+			line = (char*) malloc(length + 2);
+			if (line == NULL) {
+				RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
+				return -1;
+			}
+
+			memcpy(line, element->value, length);
+			line[length] = '=';
+			line[length + 1] = '\0';
+			result = RRPAppendRequestAttribute(request, key, keyLength,
+				line, length + 1);
+			free(line);
+		}
+	}
+
+	return result;
+
+} /* appendPlanChanges() */
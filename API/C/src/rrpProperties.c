@@ -68,6 +68,8 @@
 **    RRPContainsProperty(RRPPROPERTIES*, char*);
 **    RRPRemoveProperty(RRPPROPERTIES*, char*);
 **    RRPPutProperty(RRPPROPERTIES*, char*, char*);
+**    RRPPutPropertyN(RRPPROPERTIES*, const char*, size_t, const char*,
+**       size_t);
 **    RRPPutPropertyPair(RRPPROPERTIES*, char*);
 **    RRPClearProperties(RRPPROPERTIES*);
 **    RRPFreeProperties(RRPPROPERTIES*);
@@ -78,6 +80,22 @@
 **
 ** Changes:
 **
+** RRPCloneProperties() no longer copies the properties being cloned.
+** The original and the clone share a single reference counted list of
+** properties until one of them is modified, at which point the
+** modified structure makes a private copy of the list. The values of
+** each property are RRPVECTOR clones, so even that copy only duplicates
+** the property keys and not the values themselves. RRPGetProperty()
+** only reads, so it returns the shared values without copying.
+**
+** Oct. 19th, 2026: RRPPutPropertyN() adds a value from a key and value
+** of known lengths, so that callers holding them (e.g. std::string_view
+** in rrpAPI.hpp) need not copy them or have them measured first.
+**
+** Oct. 19th, 2026: The reference count of a shared list is updated
+** atomically where the compiler supports it. A structure and its clones
+** can then be handed to different threads, each thread using and
+** freeing its own structure.
 **
 */
 
@@ -91,12 +109,45 @@
 
 
 
+/*
+** Atomic update of a reference count
+*/
+#ifndef RRP_ATOMIC_ADD
+	#if defined(__GNUC__)
+		#define RRP_ATOMIC_ADD(counter, value) \
+			__sync_add_and_fetch(&(counter), (value))
+	#else
+		#define RRP_ATOMIC_ADD(counter, value) ((counter) += (value))
+	#endif
+#endif
+
+
+
+/*
+** List of properties shared between an RRPPROPERTIES structure and its
+** clones. A shared list is never modified; a structure that needs to
+** modify its properties first detaches itself from the shared list by
+** making a private copy
+*/
+struct _RRPPROPERTIES_STORAGE {
+	int references;         /* number of structures using the list */
+	RRPPROPERTY_NODE* head; /* first node of the shared list */
+};
+
+
 /*
 ** Function used internally to locate a propery based on it's
 ** key
 */
 RRPPROPERTY_NODE* RRPFindProperty (RRPPROPERTIES*, char*);
 
+/*
+** Functions used internally to manage the list of properties
+*/
+static int RRPDetachProperties (RRPPROPERTIES*);
+static void RRPReleasePropertyNodes (RRPPROPERTIES*);
+static void RRPFreePropertyNodes (RRPPROPERTY_NODE*);
+
 
 
 
@@ -140,6 +191,7 @@ RRPCreateProperties () {
 	p->current = NULL;
 	p->head = NULL;
 	p->tail = NULL;
+	p->storage = NULL;
 
 	return p;
 
@@ -176,9 +228,6 @@ RRPCloneProperties (
 	RRPPROPERTIES* p
 ) {
 	RRPPROPERTIES* newProperties = NULL;
-	RRPPROPERTY_NODE* newNode  = NULL;
-	RRPPROPERTY_NODE* last = NULL;
-	RRPPROPERTY_NODE* ptr  = NULL;
 
 	/*
 	** Validate parameters
@@ -210,54 +259,35 @@ RRPCloneProperties (
 		return newProperties;
 	}
 
+	/*
+	** The first clone of a structure turns its list of properties into
+	** a shared list. From then on neither structure may modify the list
+	** in place
+	*/
+	if (p->storage == NULL) {
+		p->storage = (RRPPROPERTIES_STORAGE*)
+			calloc(1, sizeof(RRPPROPERTIES_STORAGE));
 
-	ptr = p->head;
-
-	while(ptr != NULL) {
-		newNode = (RRPPROPERTY_NODE*) calloc(1, sizeof(RRPPROPERTY_NODE));
-
-		/*
-		** Check to make sure memory was properly allocated
-		*/
-		if (newNode == NULL) {
+		if (p->storage == NULL) {
 			RRPFreeProperties(newProperties);
 			RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
 			return NULL;
 		}
 
-		newProperties->count++;
-		
-		newNode->key = strdup(ptr->key);
-		newNode->values = RRPCloneVector(ptr->values);
-
-		/*
-		** Check to make sure memory was properly allocated
-		*/
-		if (newNode->key == NULL || newNode->values == NULL) {
-			RRPFreeProperties(newProperties);
-			RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
-			return NULL;
-		}
+		p->storage->references = 1;
+		p->storage->head = p->head;
+	}
 
-		if (NULL != last) {
-			last->next = newNode;
-		} else {
-			newProperties->head = newNode;
-		}
+	RRP_ATOMIC_ADD(p->storage->references, 1);
 
-		if (p->current == ptr) {
-			newProperties->current = newNode;
-		}
-		last = newNode;
-		ptr = ptr->next;
+	newProperties->storage = p->storage;
+	newProperties->count = p->count;
+	newProperties->current = p->current;
+	newProperties->head = p->head;
+	newProperties->tail = p->tail;
 
-		if (ptr == NULL) {
-			newProperties->tail = newNode;
-			newNode->next = NULL;
-		}
-	}
 	return newProperties;
-}
+} /* RRPCloneProperties */
 
 
 
@@ -292,10 +322,57 @@ RRPPutProperty (
 	RRPPROPERTIES* p,
 	char* key,
 	char* value
+) {
+	/*
+	** Validate parameters
+	*/
+	if (p == NULL || key == NULL || value == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	return RRPPutPropertyN(p, key, strlen(key), value, strlen(value));
+
+} /* RRPPutProperty */
+
+
+
+
+
+
+/*
+**
+** Function: RRPPutPropertyN
+**
+** Description: Same as RRPPutProperty() but the key and value are
+**              strings of given lengths that need not be NUL
+**              terminated
+**
+** Input: RRPPROPERTIES* - a pointer to an RRPPROPERTIES structure
+**        const char* - a key identifying property
+**        size_t - the number of characters in the key
+**        const char* - a property value
+**        size_t - the number of characters in the value
+**
+** Output: none
+**
+** Return: int - returns 0 if successful. Returns -1 if an internal
+**               error occurs
+**
+**
+*/
+
+int
+RRPPutPropertyN (
+	RRPPROPERTIES* p,
+	const char* key,
+	size_t keyLength,
+	const char* value,
+	size_t valueLength
 ) {
 	RRPPROPERTY_NODE* oldNode = NULL;
 	RRPPROPERTY_NODE* newNode = NULL;
-	
+
 
 	/*
 	** Validate parameters
@@ -305,16 +382,28 @@ RRPPutProperty (
 		return -1;
 	}
 
+	/*
+	** Make sure that the properties are not shared with a clone
+	*/
+	if (RRPDetachProperties(p) < 0) {
+		return -1;
+	}
+
 	/*
 	**
 	** If a property already exists with the same key, then
-	** free old key and value and assign new key and value.
+	** add the value to it.
 	**
 	*/
-	oldNode = RRPFindProperty(p, key);
+	for (oldNode = p->head; oldNode != NULL; oldNode = oldNode->next) {
+		if (strncmp(oldNode->key, key, keyLength) == 0 &&
+			oldNode->key[keyLength] == '\0') {
+			break;
+		}
+	}
 
 	if (oldNode != NULL) {
-		if (RRPAddVectorElement(oldNode->values, value) < 0) {
+		if (RRPAddVectorElementN(oldNode->values, value, valueLength) < 0) {
 			RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
 			return -1;
 		}
@@ -329,7 +418,7 @@ RRPPutProperty (
 	}
 
 	newNode->next = NULL;
-	newNode->key = strdup(key);
+	newNode->key = (char*) malloc(keyLength + 1);
 
 	if (newNode->key == NULL) {
 		free(newNode);
@@ -337,6 +426,8 @@ RRPPutProperty (
 		return -1;
 	}
 
+	memcpy(newNode->key, key, keyLength);
+	newNode->key[keyLength] = '\0';
 
 	newNode->values = RRPCreateVector();
 
@@ -347,7 +438,7 @@ RRPPutProperty (
 		return -1;
 	}
 
-	if (RRPAddVectorElement(newNode->values, value) < 0) {
+	if (RRPAddVectorElementN(newNode->values, value, valueLength) < 0) {
 		RRPFreeVector(newNode->values);
 		free(newNode->key);
 		free(newNode);
@@ -367,7 +458,7 @@ RRPPutProperty (
 
 	return 0;
 
-} /* RRPPutProperty */
+} /* RRPPutPropertyN */
 	
 	
 
@@ -477,9 +568,6 @@ int
 RRPClearProperties (
 	RRPPROPERTIES* p
 ) {
-	RRPPROPERTY_NODE* temp;
-	RRPPROPERTY_NODE* next;
-
 	/*
 	** Validate parameters
 	*/
@@ -488,17 +576,8 @@ RRPClearProperties (
 		return -1;
 	}
 
-	temp = p->head;
-	
-	while (temp) {
-		next = temp->next;
-
-		free(temp->key);	
-		RRPFreeVector(temp->values);
-		free(temp);
+	RRPReleasePropertyNodes(p);
 
-		temp = next;
-	}
 	p->count = 0;
 	p->head = NULL;
 	p->tail = NULL;
@@ -587,7 +666,9 @@ RRPFindProperty (
 **
 ** Description: Returns an RRPVector structure containing the values
 **              for a particular property. The property is identified
-**              by a specified key.
+**              by a specified key. The RRPVector belongs to the
+**              properties and may be shared with their clones: it must
+**              not be modified or freed.
 **
 ** Input: RRPPROPERTIES* - a pointer to an RRPPROPERTIES structure
 **        char* - a key which identifies a property
@@ -615,7 +696,12 @@ RRPGetProperty (
 		return NULL;
 	}
 
-	if (NULL == (temp = RRPFindProperty(p, key))) {
+	/*
+	** Reading does not detach: the vector returned may belong to a list
+	** shared with clones, which only the modifying functions copy
+	*/
+	temp = RRPFindProperty(p, key);
+	if (temp == NULL) {
 		return NULL;
 	}
 
@@ -660,6 +746,18 @@ RRPRemoveProperty (
 		return -1;
 	}
 
+	if (RRPFindProperty(p, key) == NULL) {
+		RRPSetInternalErrorCode(RRP_NO_SUCH_PROPERTY_ERROR);
+		return -1;
+	}
+
+	/*
+	** Make sure that the properties are not shared with a clone
+	*/
+	if (RRPDetachProperties(p) < 0) {
+		return -1;
+	}
+
 	temp = p->head;
 	prev = NULL;
 	
@@ -672,13 +770,13 @@ RRPRemoveProperty (
 				}
 			} else {
 				prev->next = temp->next;
-				if (temp == p->tail) {
-					p->tail = prev;
-				}
 				if (p->current == temp) {
 					p->current = prev;
 				}
 			}
+			if (temp == p->tail) {
+				p->tail = prev;
+			}
 			p->count--;
 			free(temp->key);
 			RRPFreeVector(temp->values);
@@ -886,7 +984,7 @@ RRPContainsProperty (
       return RRPFALSE;
    }
 
-	if (RRPGetProperty(p, key) != NULL) {
+	if (RRPFindProperty(p, key) != NULL) {
 		return RRPTRUE;
 	}
 
@@ -896,3 +994,146 @@ RRPContainsProperty (
 
 
 
+
+
+
+/*
+** FOR INTERNAL USE
+**
+** Gives an RRPPROPERTIES structure its own copy of a list of properties
+** that it shares with one or more clones, so that the list can be
+** modified without affecting the clones. The values of each property
+** are cloned with RRPCloneVector(), so only the keys are actually
+** copied. Nothing is copied if the structure is the only remaining user
+** of the list. Returns 0 if successful. Returns -1 and sets the error
+** code if memory can not be allocated, in which case the structure is
+** left unchanged.
+*/
+static int
+RRPDetachProperties (
+	RRPPROPERTIES* p
+) {
+	RRPPROPERTY_NODE* oldNode = NULL;
+	RRPPROPERTY_NODE* newNode = NULL;
+	RRPPROPERTY_NODE* newHead = NULL;
+	RRPPROPERTY_NODE* newTail = NULL;
+	RRPPROPERTY_NODE* newCurrent = NULL;
+
+	if (p->storage == NULL) {
+		return 0;
+	}
+
+	/*
+	** Last user of a shared list simply takes the list over
+	*/
+	if (RRP_ATOMIC_ADD(p->storage->references, 0) == 1) {
+		free(p->storage);
+		p->storage = NULL;
+		return 0;
+	}
+
+	for (oldNode = p->head; oldNode != NULL; oldNode = oldNode->next) {
+		newNode = (RRPPROPERTY_NODE*) calloc(1, sizeof(RRPPROPERTY_NODE));
+
+		if (newNode != NULL) {
+			newNode->key = strdup(oldNode->key);
+			newNode->values = RRPCloneVector(oldNode->values);
+		}
+
+		if (newNode == NULL || newNode->key == NULL ||
+			newNode->values == NULL) {
+			if (newNode != NULL) {
+				newNode->next = newHead;
+				newHead = newNode;
+			}
+			RRPFreePropertyNodes(newHead);
+			RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
+			return -1;
+		}
+
+		if (newTail != NULL) {
+			newTail->next = newNode;
+		}
+		else {
+			newHead = newNode;
+		}
+
+		if (p->current == oldNode) {
+			newCurrent = newNode;
+		}
+		newTail = newNode;
+	}
+
+	/*
+	** Other structures may let go of the shared list at the same time:
+	** whichever is last frees it
+	*/
+	RRPReleasePropertyNodes(p);
+	p->head = newHead;
+	p->tail = newTail;
+	p->current = newCurrent;
+
+	return 0;
+
+} /* RRPDetachProperties */
+
+
+
+
+
+
+/*
+** FOR INTERNAL USE
+**
+** Lets go of the list of properties of an RRPPROPERTIES structure.
+** Properties that are shared with a clone are only freed when the last
+** structure using them lets go of them. The caller is responsible for
+** resetting the structure itself.
+*/
+static void
+RRPReleasePropertyNodes (
+	RRPPROPERTIES* p
+) {
+	if (p->storage == NULL) {
+		RRPFreePropertyNodes(p->head);
+		return;
+	}
+
+	if (RRP_ATOMIC_ADD(p->storage->references, -1) == 0) {
+		RRPFreePropertyNodes(p->storage->head);
+		free(p->storage);
+	}
+	p->storage = NULL;
+
+} /* RRPReleasePropertyNodes */
+
+
+
+
+
+
+/*
+** FOR INTERNAL USE
+**
+** Frees a NULL terminated list of property nodes, their keys and their
+** values
+*/
+static void
+RRPFreePropertyNodes (
+	RRPPROPERTY_NODE* node
+) {
+	RRPPROPERTY_NODE* next;
+
+	while (node != NULL) {
+		next = node->next;
+
+		free(node->key);
+		if (node->values != NULL) {
+			RRPFreeVector(node->values);
+		}
+		free(node);
+
+		node = next;
+	}
+
+} /* RRPFreePropertyNodes */
@@ -0,0 +1,1274 @@
+/* ===========================================================================
+ * Copyright (C) 2000 VeriSign, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * VeriSign Global Registry Service
+ * 21345 Ridgetop Circle
+ * Dulles, VA 20166
+ * ===========================================================================
+ * The RRP, APIs and Software are provided "as-is" and without any warranty
+ * of any kind.  NSI EXPRESSLY DISCLAIMS ALL WARRANTIES AND/OR CONDITIONS,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * AND CONDITIONS OF MERCHANTABILITY OR SATISFACTORY QUALITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE AND NONINFRINGEMENT OF THIRD PARTY RIGHTS.  NSI DOES
+ * NOT WARRANT THAT THE FUNCTIONS CONTAINED IN THE RRP, APIs OR SOFTWARE
+ * WILL MEET REGISTRAR'S REQUIREMENTS, OR THAT THE OPERATION OF THE RRP,
+ * APIs OR SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE,OR THAT DEFECTS IN
+ * THE RRP, APIs OR SOFTWARE WILL BE CORRECTED.  FURTHERMORE, NSI DOES NOT
+ * WARRANT NOR MAKE ANY REPRESENTATIONS REGARDING THE USE OR THE RESULTS OF
+ * THE RRP, APIs, SOFTWARE OR RELATED DOCUMENTATION IN TERMS OF THEIR
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR OTHERWISE.  SHOULD THE RRP, APIs
+ * OR SOFTWARE PROVE DEFECTIVE, REGISTRAR ASSUMES THE ENTIRE COST OF ALL
+ * NECESSARY SERVICING, REPAIR OR CORRECTION.
+ * ======================================================================== */
+
+/*
+**
+** Module Name: rrpProvision.c
+**
+** Version: 2.1 for RRP version 2.1.0
+**
+** Date: Oct. 19th, 2026
+**
+** Description: rrpProvision runs a batch of Add, Mod and Del commands on
+**              domains and name servers in parallel, in the order of
+**              their dependencies (see rrpProvision.h).
+**
+** Entry Points:
+**
+**    RRPCreateProvision(void);
+**    RRPProvisionAddNameServer(RRPPROVISION*, char*, RRPVECTOR*);
+**    RRPProvisionAddDomain(RRPPROVISION*, char*, RRPVECTOR*, int);
+**    RRPProvisionModifyDomain(RRPPROVISION*, char*, RRPVECTOR*,
+**        RRPVECTOR*);
+**    RRPProvisionDeleteDomain(RRPPROVISION*, char*);
+**    RRPProvisionDeleteNameServer(RRPPROVISION*, char*);
+**    RRPAddProvisionDependency(RRPPROVISION*, int, int);
+**    RRPRunProvision(RRPPROVISION*, RRPSESSIONPOOL*);
+**    RRPGetProvisionState(RRPPROVISION*, int, int*);
+**    RRPFreeProvision(RRPPROVISION*);
+**
+** Changes:
+**
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include "rrpProvision.h"
+#include "rrpInternalError.h"
+
+/*
+** An operation of a batch. The names are in lower case, without a
+** trailing dot
+*/
+typedef struct {
+	RRPPROVISION* provision;
+	RRPCOMMAND command;
+	RRPENTITY entity;
+	char* name;                 /* domain or name server */
+	RRPREQUEST* request;        /* NULL once submitted */
+	char** added;               /* name servers referenced */
+	int addedCount;
+	char** deleted;             /* name servers removed from a domain */
+	int deletedCount;
+	int* dependents;            /* operations waiting for this one */
+	int dependentCount;
+	int dependentCapacity;
+	int waiting;                /* dependencies not done yet */
+	RRPPROVISIONSTATE state;
+	int code;
+} RRPPROVISIONOP;
+
+/*
+** A reference from an operation to a domain or name server, used to
+** find the dependencies (see buildProvisionGraph())
+*/
+#define RRP_PROVISION_ENTITY_REFERENCE 0     /* the operation's entity */
+#define RRP_PROVISION_ADDED_REFERENCE 1      /* name server referenced */
+#define RRP_PROVISION_DELETED_REFERENCE 2    /* name server removed */
+
+typedef struct {
+	RRPENTITY entity;
+	const char* name;
+	int role;
+	int index;                  /* operation */
+} RRPPROVISIONREF;
+
+struct _RRPPROVISION {
+	RRPPROVISIONOP* operations;
+	int count;
+	int capacity;
+	RRPSESSIONPOOL* pool;       /* NULL unless running */
+	int completed;              /* operations no longer pending */
+	int done;
+	RRPBOOLEAN ran;
+};
+
+
+/*
+** Functions used internally to build the operations and the graph, and
+** to run them
+*/
+static char* copyProvisionName (const char*);
+static int copyProvisionNames (RRPVECTOR*, char***, int*);
+static RRPPROVISIONOP* newProvisionOp (RRPPROVISION*, RRPCOMMAND, RRPENTITY,
+	char*);
+static void freeProvisionOp (RRPPROVISIONOP*);
+static void discardProvisionOp (RRPPROVISION*);
+static int addProvisionEdge (RRPPROVISION*, int, int);
+static int compareProvisionRefs (const void*, const void*);
+static int buildProvisionGraph (RRPPROVISION*);
+static int checkProvisionGraph (RRPPROVISION*);
+static void submitProvisionOp (RRPPROVISION*, int);
+static void finishProvisionOp (RRPPROVISION*, int, RRPPROVISIONSTATE, int);
+static void completeProvisionOp (RRPREQUEST*, RRPRESPONSE*, void*);
+
+
+
+
+/*
+**
+** Function: RRPCreateProvision
+**
+** Description: Creates an empty batch of operations
+**
+** Input: none
+**
+** Output: none
+**
+** Return: RRPPROVISION* - a pointer to an allocated RRPPROVISION
+**                         structure. NULL is returned if an internal
+**                         error occurs.
+**
+** Note: THE MEMORY ALLOCATED FOR THE RRPPROVISION STRUCTURE MUST BE
+**       RELEASED BY CALLING THE RRPFreeProvision() FUNCTION
+**
+*/
+
+RRPPROVISION*
+RRPCreateProvision (
+	void
+) {
+	RRPPROVISION* provision = NULL;
+
+	provision = (RRPPROVISION*) calloc(1, sizeof(RRPPROVISION));
+	if (provision == NULL) {
+		RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
+		return NULL;
+	}
+
+	provision->ran = RRPFALSE;
+
+	return provision;
+
+} /* RRPCreateProvision */
+
+
+
+
+
+
+/*
+**
+** Function: RRPProvisionAddNameServer
+**
+** Description: Adds the Add command of a name server to a batch
+**
+** Input: RRPPROVISION* - a pointer to an RRPPROVISION structure
+**        char* - the name server's host name
+**        RRPVECTOR* - the IP addresses of the name server, NULL if none
+**
+** Output: none
+**
+** Return: int - the index of the operation. -1 is returned if an
+**               internal error occurs.
+**
+*/
+
+int
+RRPProvisionAddNameServer (
+	RRPPROVISION* provision,
+	char* nameServer,
+	RRPVECTOR* ipAddresses
+) {
+	RRPPROVISIONOP* operation = NULL;
+	int i = 0;
+
+	/*
+	** Validate parameters
+	*/
+	if (provision == NULL || nameServer == NULL || provision->ran) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	operation = newProvisionOp(provision, RRP_ADD_COMMAND,
+		RRP_NAMESERVER_ENTITY, nameServer);
+	if (operation == NULL) {
+		return -1;
+	}
+
+	for (i = 0; ipAddresses != NULL && i < RRPGetVectorSize(ipAddresses);
+		i++) {
+		if (RRPAppendRequestAttribute(operation->request, "IPAddress", 9,
+			RRPGetVectorElementAt(ipAddresses, i),
+			strlen(RRPGetVectorElementAt(ipAddresses, i))) < 0) {
+			discardProvisionOp(provision);
+			return -1;
+		}
+	}
+
+	return provision->count - 1;
+
+} /* RRPProvisionAddNameServer */
+
+
+
+
+
+
+/*
+**
+** Function: RRPProvisionAddDomain
+**
+** Description: Adds the Add command of a domain to a batch
+**
+** Input: RRPPROVISION* - a pointer to an RRPPROVISION structure
+**        char* - the domain name
+**        RRPVECTOR* - the name servers of the domain, NULL if none
+**        int - the registration period in years, 0 for the server's
+**              default
+**
+** Output: none
+**
+** Return: int - the index of the operation. -1 is returned if an
+**               internal error occurs.
+**
+*/
+
+int
+RRPProvisionAddDomain (
+	RRPPROVISION* provision,
+	char* domainName,
+	RRPVECTOR* nameServers,
+	int registrationPeriod
+) {
+	RRPPROVISIONOP* operation = NULL;
+	char number[12];
+	int result = 0;
+	int i = 0;
+
+	/*
+	** Validate parameters
+	*/
+	if (provision == NULL || domainName == NULL || registrationPeriod < 0 ||
+		provision->ran) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	operation = newProvisionOp(provision, RRP_ADD_COMMAND,
+		RRP_DOMAIN_ENTITY, domainName);
+	if (operation == NULL) {
+		return -1;
+	}
+
+	result = copyProvisionNames(nameServers, &operation->added,
+		&operation->addedCount);
+
+	for (i = 0; result == 0 && i < operation->addedCount; i++) {
+		result = RRPAppendRequestAttribute(operation->request, "NameServer",
+			10, operation->added[i], strlen(operation->added[i]));
+	}
+
+	if (result == 0 && registrationPeriod > 0) {
+		sprintf(number, "%d", registrationPeriod);
+		result = RRPAppendRequestAttribute(operation->request, "-Period", 7,
+			number, strlen(number));
+	}
+
+	if (result < 0) {
+		discardProvisionOp(provision);
+		return -1;
+	}
+
+	return provision->count - 1;
+
+} /* RRPProvisionAddDomain */
+
+
+
+
+
+
+/*
+**
+** Function: RRPProvisionModifyDomain
+**
+** Description: Adds the Mod command of a domain that adds and deletes
+**              name servers to a batch
+**
+** Input: RRPPROVISION* - a pointer to an RRPPROVISION structure
+**        char* - the domain name
+**        RRPVECTOR* - the name servers to add, NULL if none
+**        RRPVECTOR* - the name servers to delete, NULL if none
+**
+** Output: none
+**
+** Return: int - the index of the operation. -1 is returned if an
+**               internal error occurs.
+**
+*/
+
+int
+RRPProvisionModifyDomain (
+	RRPPROVISION* provision,
+	char* domainName,
+	RRPVECTOR* addedNameServers,
+	RRPVECTOR* deletedNameServers
+) {
+	RRPPROVISIONOP* operation = NULL;
+	char* value = NULL;
+	size_t length = 0;
+	int result = 0;
+	int i = 0;
+
+	/*
+	** Validate parameters
+	*/
+	if (provision == NULL || domainName == NULL || provision->ran) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	operation = newProvisionOp(provision, RRP_MOD_COMMAND,
+		RRP_DOMAIN_ENTITY, domainName);
+	if (operation == NULL) {
+		return -1;
+	}
+
+	result = copyProvisionNames(addedNameServers, &operation->added,
+		&operation->addedCount);
+
+	if (result == 0) {
+		result = copyProvisionNames(deletedNameServers, &operation->deleted,
+			&operation->deletedCount);
+	}
+
+	for (i = 0; result == 0 && i < operation->addedCount; i++) {
+		result = RRPAppendRequestAttribute(operation->request, "NameServer",
+			10, operation->added[i], strlen(operation->added[i]));
+	}
+
+	/*
+	** A name server is deleted with an empty new value
+	*/
+	for (i = 0; result == 0 && i < operation->deletedCount; i++) {
+		length = strlen(operation->deleted[i]);
+		value = (char*) malloc(length + 2);
+		if (value == NULL) {
+			RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
+			result = -1;
+			break;
+		}
+
+		memcpy(value, operation->deleted[i], length);
+		value[length] = '=';
+		result = RRPAppendRequestAttribute(operation->request, "NameServer",
+			10, value, length + 1);
+		free(value);
+	}
+
+	if (result < 0) {
+		discardProvisionOp(provision);
+		return -1;
+	}
+
+	return provision->count - 1;
+
+} /* RRPProvisionModifyDomain */
+
+
+
+
+
+
+/*
+**
+** Function: RRPProvisionDeleteDomain
+**
+** Description: Adds the Del command of a domain to a batch
+**
+** Input: RRPPROVISION* - a pointer to an RRPPROVISION structure
+**        char* - the domain name
+**
+** Output: none
+**
+** Return: int - the index of the operation. -1 is returned if an
+**               internal error occurs.
+**
+*/
+
+int
+RRPProvisionDeleteDomain (
+	RRPPROVISION* provision,
+	char* domainName
+) {
+	/*
+	** Validate parameters
+	*/
+	if (provision == NULL || domainName == NULL || provision->ran) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	if (newProvisionOp(provision, RRP_DEL_COMMAND, RRP_DOMAIN_ENTITY,
+		domainName) == NULL) {
+		return -1;
+	}
+
+	return provision->count - 1;
+
+} /* RRPProvisionDeleteDomain */
+
+
+
+
+
+
+/*
+**
+** Function: RRPProvisionDeleteNameServer
+**
+** Description: Adds the Del command of a name server to a batch
+**
+** Input: RRPPROVISION* - a pointer to an RRPPROVISION structure
+**        char* - the name server's host name
+**
+** Output: none
+**
+** Return: int - the index of the operation. -1 is returned if an
+**               internal error occurs.
+**
+*/
+
+int
+RRPProvisionDeleteNameServer (
+	RRPPROVISION* provision,
+	char* nameServer
+) {
+	/*
+	** Validate parameters
+	*/
+	if (provision == NULL || nameServer == NULL || provision->ran) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	if (newProvisionOp(provision, RRP_DEL_COMMAND, RRP_NAMESERVER_ENTITY,
+		nameServer) == NULL) {
+		return -1;
+	}
+
+	return provision->count - 1;
+
+} /* RRPProvisionDeleteNameServer */
+
+
+
+
+
+
+/*
+**
+** Function: RRPAddProvisionDependency
+**
+** Description: Makes an operation of a batch wait until another one is
+**              done
+**
+** Input: RRPPROVISION* - a pointer to an RRPPROVISION structure
+**        int - the index of the operation to run first
+**        int - the index of the operation to run after it
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+
+int
+RRPAddProvisionDependency (
+	RRPPROVISION* provision,
+	int first,
+	int then
+) {
+	/*
+	** Validate parameters
+	*/
+	if (provision == NULL || first < 0 || first >= provision->count ||
+		then < 0 || then >= provision->count || first == then ||
+		provision->ran) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	return addProvisionEdge(provision, first, then);
+
+} /* RRPAddProvisionDependency */
+
+
+
+
+
+
+/*
+**
+** Function: RRPRunProvision
+**
+** Description: Runs the operations of a batch over the sessions of a
+**              pool, each as soon as the operations it depends on are
+**              done, and returns once every operation is done, refused,
+**              failed or skipped. A batch can only be run once
+**
+** Input: RRPPROVISION* - a pointer to an RRPPROVISION structure
+**        RRPSESSIONPOOL* - a pointer to an RRPSESSIONPOOL structure
+**
+** Output: none
+**
+** Return: int - the number of operations done. -1 is returned if the
+**               dependencies form a cycle (RRP_BAD_PARAM_ERROR; nothing
+**               is run), if the batch was already run, or if an
+**               internal error occurs.
+**
+** Note: If -1 is returned after the batch started, commands may still
+**       be in flight: the pool must be freed before the batch
+**
+*/
+
+int
+RRPRunProvision (
+	RRPPROVISION* provision,
+	RRPSESSIONPOOL* pool
+) {
+	int i = 0;
+
+	/*
+	** Validate parameters
+	*/
+	if (provision == NULL || pool == NULL || provision->ran) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	provision->ran = RRPTRUE;
+
+	if (buildProvisionGraph(provision) < 0) {
+		return -1;
+	}
+
+	if (checkProvisionGraph(provision) < 0) {
+		return -1;
+	}
+
+	provision->pool = pool;
+	provision->completed = 0;
+	provision->done = 0;
+
+	/*
+	** The roots of the graph start; every other operation is submitted
+	** by the completion of its last dependency
+	*/
+	for (i = 0; i < provision->count; i++) {
+		if (provision->operations[i].waiting == 0 &&
+			provision->operations[i].state == RRP_PROVISION_PENDING) {
+			submitProvisionOp(provision, i);
+		}
+	}
+
+	while (provision->completed < provision->count) {
+		if (RRPPollSessionPool(pool, -1) < 0) {
+			/*
+			** The commands in flight complete when the pool is freed;
+			** nothing more is submitted
+			*/
+			provision->pool = NULL;
+			return -1;
+		}
+	}
+
+	provision->pool = NULL;
+
+	return provision->done;
+
+} /* RRPRunProvision */
+
+
+
+
+
+
+/*
+**
+** Function: RRPGetProvisionState
+**
+** Description: Returns the state of an operation of a batch
+**
+** Input: RRPPROVISION* - a pointer to an RRPPROVISION structure
+**        int - the index of the operation
+**
+** Output: int* - the RRP response code, -1 if the operation has no
+**                response. May be NULL
+**
+** Return: RRPPROVISIONSTATE - the state. RRP_PROVISION_PENDING is
+**                             returned if an internal error occurs.
+**
+*/
+
+RRPPROVISIONSTATE
+RRPGetProvisionState (
+	RRPPROVISION* provision,
+	int index,
+	int* code
+) {
+	/*
+	** Validate parameters
+	*/
+	if (provision == NULL || index < 0 || index >= provision->count) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return RRP_PROVISION_PENDING;
+	}
+
+	if (code != NULL) {
+		*code = provision->operations[index].code;
+	}
+
+	return provision->operations[index].state;
+
+} /* RRPGetProvisionState */
+
+
+
+
+
+
+/*
+**
+** Function: RRPFreeProvision
+**
+** Description: Frees all of the memory allocated for an RRPPROVISION
+**              structure
+**
+** Input: RRPPROVISION* - a pointer to an RRPPROVISION structure
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+
+int
+RRPFreeProvision (
+	RRPPROVISION* provision
+) {
+	int i = 0;
+
+	/*
+	** Validate parameters
+	*/
+	if (provision == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	for (i = 0; i < provision->count; i++) {
+		freeProvisionOp(&provision->operations[i]);
+	}
+
+	free(provision->operations);
+	free(provision);
+
+	return 0;
+
+} /* RRPFreeProvision */
+
+
+
+
+
+
+/*
+** Returns a copy of a domain or name server name in lower case, without
+** a trailing dot, or NULL and sets the error code if out of memory
+*/
+static char*
+copyProvisionName (
+	const char* name
+) {
+	size_t length = strlen(name);
+	char* copy = NULL;
+	size_t i = 0;
+
+	if (length > 1 && name[length - 1] == '.') {
+		length--;
+	}
+
+	copy = (char*) malloc(length + 1);
+	if (copy == NULL) {
+		RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
+		return NULL;
+	}
+
+	for (i = 0; i < length; i++) {
+		copy[i] = (char) tolower((unsigned char) name[i]);
+	}
+	copy[length] = '\0';
+
+	return copy;
+
+} /* copyProvisionName */
+
+
+
+
+
+
+/*
+** Copies the names of a vector (which may be NULL) into an array.
+** Returns 0 if successful, -1 and sets the error code otherwise.
+*/
+static int
+copyProvisionNames (
+	RRPVECTOR* vector,
+	char*** names,
+	int* count
+) {
+	int size = (vector != NULL) ? RRPGetVectorSize(vector) : 0;
+
+	*names = NULL;
+	*count = 0;
+
+	if (size == 0) {
+		return 0;
+	}
+
+	*names = (char**) malloc(size * sizeof(char*));
+	if (*names == NULL) {
+		RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
+		return -1;
+	}
+
+	for (*count = 0; *count < size; (*count)++) {
+		(*names)[*count] = copyProvisionName(
+			RRPGetVectorElementAt(vector, *count));
+		if ((*names)[*count] == NULL) {
+			return -1;
+		}
+	}
+
+	return 0;
+
+} /* copyProvisionNames */
+
+
+
+
+
+
+/*
+** Appends a new operation and its request to a batch. Returns the
+** operation, or NULL and sets the error code if an error occurs.
+*/
+static RRPPROVISIONOP*
+newProvisionOp (
+	RRPPROVISION* provision,
+	RRPCOMMAND command,
+	RRPENTITY entity,
+	char* name
+) {
+	RRPPROVISIONOP* operations = NULL;
+	RRPPROVISIONOP* operation = NULL;
+	int capacity = 0;
+
+	if (provision->count == provision->capacity) {
+		capacity = provision->capacity > 0 ? provision->capacity * 2 : 64;
+		operations = (RRPPROVISIONOP*) realloc(provision->operations,
+			capacity * sizeof(RRPPROVISIONOP));
+		if (operations == NULL) {
+			RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
+			return NULL;
+		}
+		provision->operations = operations;
+		provision->capacity = capacity;
+	}
+
+	operation = &provision->operations[provision->count];
+	memset(operation, 0, sizeof(RRPPROVISIONOP));
+	operation->provision = provision;
+	operation->command = command;
+	operation->entity = entity;
+	operation->state = RRP_PROVISION_PENDING;
+	operation->code = -1;
+
+	operation->name = copyProvisionName(name);
+	if (operation->name == NULL) {
+		return NULL;
+	}
+
+	operation->request = RRPCreateRequest(command, entity, name,
+		strlen(name));
+	if (operation->request == NULL) {
+		free(operation->name);
+		return NULL;
+	}
+
+	provision->count++;
+
+	return operation;
+
+} /* newProvisionOp */
+
+
+
+
+
+
+/*
+** Frees the memory of an operation
+*/
+static void
+freeProvisionOp (
+	RRPPROVISIONOP* operation
+) {
+	int i = 0;
+
+	if (operation->request != NULL) {
+		RRPFreeRequest(operation->request);
+	}
+
+	for (i = 0; i < operation->addedCount; i++) {
+		free(operation->added[i]);
+	}
+
+	for (i = 0; i < operation->deletedCount; i++) {
+		free(operation->deleted[i]);
+	}
+
+	free(operation->added);
+	free(operation->deleted);
+	free(operation->dependents);
+	free(operation->name);
+
+} /* freeProvisionOp */
+
+
+
+
+
+
+/*
+** Removes the last operation of a batch, which could not be built
+*/
+static void
+discardProvisionOp (
+	RRPPROVISION* provision
+) {
+	provision->count--;
+	freeProvisionOp(&provision->operations[provision->count]);
+
+} /* discardProvisionOp */
+
+
+
+
+
+
+/*
+** Makes operation 'then' wait for operation 'first'. Returns 0 if
+** successful, -1 and sets the error code otherwise.
+*/
+static int
+addProvisionEdge (
+	RRPPROVISION* provision,
+	int first,
+	int then
+) {
+	RRPPROVISIONOP* operation = &provision->operations[first];
+	int* dependents = NULL;
+	int capacity = 0;
+
+	if (operation->dependentCount == operation->dependentCapacity) {
+		capacity = operation->dependentCapacity > 0 ?
+			operation->dependentCapacity * 2 : 4;
+		dependents = (int*) realloc(operation->dependents,
+			capacity * sizeof(int));
+		if (dependents == NULL) {
+			RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
+			return -1;
+		}
+		operation->dependents = dependents;
+		operation->dependentCapacity = capacity;
+	}
+
+	operation->dependents[operation->dependentCount++] = then;
+	provision->operations[then].waiting++;
+
+	return 0;
+
+} /* addProvisionEdge */
+
+
+
+
+
+
+/*
+** Comparison function of qsort() for references: by entity, name, then
+** operation
+*/
+static int
+compareProvisionRefs (
+	const void* a,
+	const void* b
+) {
+	const RRPPROVISIONREF* first = (const RRPPROVISIONREF*) a;
+	const RRPPROVISIONREF* second = (const RRPPROVISIONREF*) b;
+	int order = 0;
+
+	if (first->entity != second->entity) {
+		return (first->entity < second->entity) ? -1 : 1;
+	}
+
+	order = strcmp(first->name, second->name);
+	if (order != 0) {
+		return order;
+	}
+
+	return (first->index < second->index) ? -1 :
+		(first->index > second->index) ? 1 : 0;
+
+} /* compareProvisionRefs */
+
+
+
+
+
+
+/*
+** Adds the dependencies implied by the operations (see rrpProvision.h).
+** The references of all of the operations to domains and name servers
+** are sorted, so that the operations on the same entity are next to each
+** other, in the order they were added. Returns 0 if successful, -1 and
+** sets the error code otherwise.
+*/
+static int
+buildProvisionGraph (
+	RRPPROVISION* provision
+) {
+	RRPPROVISIONREF* refs = NULL;
+	RRPPROVISIONOP* operation = NULL;
+	int refCount = 0;
+	int start = 0;
+	int end = 0;
+	int previous = 0;
+	int i = 0;
+	int j = 0;
+	int k = 0;
+	int result = 0;
+
+	for (i = 0; i < provision->count; i++) {
+		refCount += 1 + provision->operations[i].addedCount +
+			provision->operations[i].deletedCount;
+	}
+
+	if (refCount == 0) {
+		return 0;
+	}
+
+	refs = (RRPPROVISIONREF*) malloc(refCount * sizeof(RRPPROVISIONREF));
+	if (refs == NULL) {
+		RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
+		return -1;
+	}
+
+	refCount = 0;
+
+	for (i = 0; i < provision->count; i++) {
+		operation = &provision->operations[i];
+
+		refs[refCount].entity = operation->entity;
+		refs[refCount].name = operation->name;
+		refs[refCount].role = RRP_PROVISION_ENTITY_REFERENCE;
+		refs[refCount++].index = i;
+
+		for (j = 0; j < operation->addedCount; j++) {
+			refs[refCount].entity = RRP_NAMESERVER_ENTITY;
+			refs[refCount].name = operation->added[j];
+			refs[refCount].role = RRP_PROVISION_ADDED_REFERENCE;
+			refs[refCount++].index = i;
+		}
+
+		for (j = 0; j < operation->deletedCount; j++) {
+			refs[refCount].entity = RRP_NAMESERVER_ENTITY;
+			refs[refCount].name = operation->deleted[j];
+			refs[refCount].role = RRP_PROVISION_DELETED_REFERENCE;
+			refs[refCount++].index = i;
+		}
+	}
+
+	qsort(refs, refCount, sizeof(RRPPROVISIONREF), compareProvisionRefs);
+
+	for (start = 0; result == 0 && start < refCount; start = end) {
+		for (end = start + 1; end < refCount &&
+			refs[end].entity == refs[start].entity &&
+			strcmp(refs[end].name, refs[start].name) == 0; end++) {
+		}
+
+		previous = -1;
+
+		for (j = start; result == 0 && j < end; j++) {
+			operation = &provision->operations[refs[j].index];
+
+			if (refs[j].role != RRP_PROVISION_ENTITY_REFERENCE) {
+				continue;
+			}
+
+			/*
+			** The operations on one entity run in the order they were
+			** added
+			*/
+			if (previous >= 0) {
+				result = addProvisionEdge(provision, previous, refs[j].index);
+			}
+			previous = refs[j].index;
+
+			for (k = start; result == 0 && k < end; k++) {
+				/*
+				** The domains that reference a name server wait for its
+				** Add; its Del waits for the domains that release it
+				*/
+				if (operation->command == RRP_ADD_COMMAND &&
+					refs[j].entity == RRP_NAMESERVER_ENTITY &&
+					refs[k].role == RRP_PROVISION_ADDED_REFERENCE) {
+					result = addProvisionEdge(provision, refs[j].index,
+						refs[k].index);
+				}
+				else if (operation->command == RRP_DEL_COMMAND &&
+					refs[j].entity == RRP_NAMESERVER_ENTITY &&
+					refs[k].role == RRP_PROVISION_DELETED_REFERENCE) {
+					result = addProvisionEdge(provision, refs[k].index,
+						refs[j].index);
+				}
+			}
+		}
+	}
+
+	free(refs);
+
+	/*
+	** The Del of a name server waits for the Del of every domain, which
+	** may reference it
+	*/
+	for (i = 0; result == 0 && i < provision->count; i++) {
+		if (provision->operations[i].command != RRP_DEL_COMMAND ||
+			provision->operations[i].entity != RRP_NAMESERVER_ENTITY) {
+			continue;
+		}
+
+		for (j = 0; result == 0 && j < provision->count; j++) {
+			if (provision->operations[j].command == RRP_DEL_COMMAND &&
+				provision->operations[j].entity == RRP_DOMAIN_ENTITY) {
+				result = addProvisionEdge(provision, j, i);
+			}
+		}
+	}
+
+	return result;
+
+} /* buildProvisionGraph */
+
+
+
+
+
+
+/*
+** Checks that the dependencies of a batch form no cycle, by removing the
+** operations that wait for nothing until none is left (Kahn's
+** algorithm). Returns 0 if there is no cycle, -1 and sets the error code
+** otherwise.
+*/
+static int
+checkProvisionGraph (
+	RRPPROVISION* provision
+) {
+	RRPPROVISIONOP* operation = NULL;
+	int* waiting = NULL;
+	int* ready = NULL;
+	int readyCount = 0;
+	int removed = 0;
+	int i = 0;
+	int j = 0;
+
+	if (provision->count == 0) {
+		return 0;
+	}
+
+	waiting = (int*) malloc(provision->count * sizeof(int));
+	ready = (int*) malloc(provision->count * sizeof(int));
+	if (waiting == NULL || ready == NULL) {
+		free(waiting);
+		free(ready);
+		RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
+		return -1;
+	}
+
+	for (i = 0; i < provision->count; i++) {
+		waiting[i] = provision->operations[i].waiting;
+		if (waiting[i] == 0) {
+			ready[readyCount++] = i;
+		}
+	}
+
+	while (readyCount > 0) {
+		operation = &provision->operations[ready[--readyCount]];
+		removed++;
+
+		for (j = 0; j < operation->dependentCount; j++) {
+			if (--waiting[operation->dependents[j]] == 0) {
+				ready[readyCount++] = operation->dependents[j];
+			}
+		}
+	}
+
+	free(waiting);
+	free(ready);
+
+	if (removed < provision->count) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	return 0;
+
+} /* checkProvisionGraph */
+
+
+
+
+
+
+/*
+** Submits the request of an operation to the pool. An operation that
+** can not be submitted fails.
+*/
+static void
+submitProvisionOp (
+	RRPPROVISION* provision,
+	int index
+) {
+	RRPPROVISIONOP* operation = &provision->operations[index];
+
+	if (provision->pool != NULL &&
+		RRPSubmitPoolRequest(provision->pool, operation->request,
+			completeProvisionOp, operation) == 0) {
+		operation->request = NULL;
+		return;
+	}
+
+	finishProvisionOp(provision, index, RRP_PROVISION_FAILED, -1);
+
+} /* submitProvisionOp */
+
+
+
+
+
+
+/*
+** Records the outcome of an operation. The operations waiting for it
+** are submitted once they wait for nothing else if it was done, and are
+** skipped otherwise.
+*/
+static void
+finishProvisionOp (
+	RRPPROVISION* provision,
+	int index,
+	RRPPROVISIONSTATE state,
+	int code
+) {
+	RRPPROVISIONOP* operation = &provision->operations[index];
+	RRPPROVISIONOP* dependent = NULL;
+	int i = 0;
+
+	operation->state = state;
+	operation->code = code;
+	provision->completed++;
+
+	if (state == RRP_PROVISION_DONE) {
+		provision->done++;
+	}
+
+	for (i = 0; i < operation->dependentCount; i++) {
+		dependent = &provision->operations[operation->dependents[i]];
+		dependent->waiting--;
+
+		if (dependent->state != RRP_PROVISION_PENDING) {
+			continue;
+		}
+
+		if (state != RRP_PROVISION_DONE) {
+			finishProvisionOp(provision, operation->dependents[i],
+				RRP_PROVISION_SKIPPED, -1);
+		}
+		else if (dependent->waiting == 0) {
+			submitProvisionOp(provision, operation->dependents[i]);
+		}
+	}
+
+} /* finishProvisionOp */
+
+
+
+
+
+
+/*
+** Completion function of the requests of the operations
+*/
+static void
+completeProvisionOp (
+	RRPREQUEST* request,
+	RRPRESPONSE* response,
+	void* context
+) {
+	RRPPROVISIONOP* operation = (RRPPROVISIONOP*) context;
+	RRPPROVISION* provision = operation->provision;
+	int index = (int) (operation - provision->operations);
+
+	if (response == NULL) {
+		finishProvisionOp(provision, index, RRP_PROVISION_FAILED, -1);
+		return;
+	}
+
+	finishProvisionOp(provision, index, response->code / 100 == 2 ?
+		RRP_PROVISION_DONE : RRP_PROVISION_REFUSED, response->code);
+	RRPFreeResponse(response);
+
+} /* completeProvisionOp */
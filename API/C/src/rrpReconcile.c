@@ -0,0 +1,1036 @@
+/* ===========================================================================
+ * Copyright (C) 2000 VeriSign, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * VeriSign Global Registry Service
+ * 21345 Ridgetop Circle
+ * Dulles, VA 20166
+ * ===========================================================================
+ * The RRP, APIs and Software are provided "as-is" and without any warranty
+ * of any kind.  NSI EXPRESSLY DISCLAIMS ALL WARRANTIES AND/OR CONDITIONS,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * AND CONDITIONS OF MERCHANTABILITY OR SATISFACTORY QUALITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE AND NONINFRINGEMENT OF THIRD PARTY RIGHTS.  NSI DOES
+ * NOT WARRANT THAT THE FUNCTIONS CONTAINED IN THE RRP, APIs OR SOFTWARE
+ * WILL MEET REGISTRAR'S REQUIREMENTS, OR THAT THE OPERATION OF THE RRP,
+ * APIs OR SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE,OR THAT DEFECTS IN
+ * THE RRP, APIs OR SOFTWARE WILL BE CORRECTED.  FURTHERMORE, NSI DOES NOT
+ * WARRANT NOR MAKE ANY REPRESENTATIONS REGARDING THE USE OR THE RESULTS OF
+ * THE RRP, APIs, SOFTWARE OR RELATED DOCUMENTATION IN TERMS OF THEIR
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR OTHERWISE.  SHOULD THE RRP, APIs
+ * OR SOFTWARE PROVE DEFECTIVE, REGISTRAR ASSUMES THE ENTIRE COST OF ALL
+ * NECESSARY SERVICING, REPAIR OR CORRECTION.
+ * ======================================================================== */
+
+/*
+**
+** Module Name: rrpReconcile.c
+**
+** Version: 2.1 for RRP version 2.1.0
+**
+** Date: Oct. 19th, 2026
+**
+** Description: rrpReconcile compares the registry's view of a list of
+**              domain names with a local snapshot. The Status commands
+**              are pipelined over a pool of sessions (see rrpSession.h)
+**              at a limited rate, and the expiration date, statuses and
+**              name servers of each domain are compared with the ones
+**              recorded in the snapshot. Only the differences are
+**              written, one per line:
+**
+**                domain,field,old,new
+**
+**              where field is "expiration", "status" or "nameserver"
+**              (a status or name server that appeared has an empty old
+**              value, one that disappeared an empty new value),
+**              "missing" (the registry does not know the domain; new is
+**              the response code) or "error" (the Status command failed
+**              or was refused; new is the response code, or -1). A
+**              domain not in the snapshot yet is compared with an empty
+**              record.
+**
+**              The snapshot is a file of lines "domain<TAB>record" and
+**              a journal (the snapshot name followed by ".log") of the
+**              records that changed since. A domain that did not change
+**              costs a hash comparison: nothing is written for it. The
+**              records that changed are appended to the journal, and
+**              the journal is merged into the snapshot (written to a
+**              temporary file, synchronized, then renamed) only once it
+**              has grown to half the size of the snapshot, or when -c
+**              is given. Errors do not change the snapshot.
+**
+**              The names are read one per line from the input file, or
+**              are all the names of the snapshot if no input is given.
+**              Sessions whose connection drops log in again and repeat
+**              their Status commands, so a long run is not cut short.
+**
+** Usage:       rrpReconcile -h host[,host...] [-p port] -u id [-w password]
+**                  -d snapshot [-i input] [-o output] [-s sessions]
+**                  [-n window] [-r rate] [-c] [-q]
+**
+**              The password is taken from the RRP_PASSWORD environment
+**              variable if -w is not given. Several servers may be
+**              given to -h, each as host or host:port; the sessions are
+**              then spread over them and leave those that fail (see
+**              rrpEndpoint.h).
+**
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <signal.h>
+#include <unistd.h>
+#include <poll.h>
+#include <strings.h>
+#include <sys/time.h>
+#include <sys/stat.h>
+#include "rrpAPI.h"
+#include "rrpSession.h"
+#include "rrpGovernor.h"
+#include "rrpRetry.h"
+#include "rrpEndpoint.h"
+#include "rrpInternalError.h"
+#include "rrpTool.h"
+
+/*
+** Longest name and record accepted, and most values in a list
+*/
+#define RECONCILE_MAX_NAME 256
+#define RECONCILE_MAX_RECORD 4096
+#define RECONCILE_MAX_VALUES 64
+
+/*
+** Record of a domain the registry does not know
+*/
+#define RECONCILE_MISSING "-"
+
+/*
+** A domain of the snapshot. 'record' holds the expiration date, the
+** sorted statuses and the sorted name servers, separated by tabs, the
+** values of a list separated by commas
+*/
+typedef struct _RECONENTRY  RECONENTRY;
+
+struct _RECONENTRY {
+	char* name;
+	char* record;
+	unsigned long fingerprint;  /* hash value of 'record' */
+	RECONENTRY* next;
+};
+
+/*
+** A Status command in flight
+*/
+typedef struct _RECONSLOT  RECONSLOT;
+
+struct _RECONSLOT {
+	char name[RECONCILE_MAX_NAME];
+	RECONSLOT* next;            /* next free slot */
+};
+
+static RECONENTRY** table = NULL;
+static unsigned long tableSize = 0;
+static unsigned long entryCount = 0;
+static FILE* output = NULL;
+static FILE* journal = NULL;
+static char* snapshotName = NULL;
+static char journalName[1024];
+static RECONSLOT* freeSlots = NULL;
+static int inFlight = 0;
+static unsigned long checked = 0;
+static unsigned long changed = 0;
+static unsigned long errors = 0;
+
+static void usage (char*);
+static unsigned long hashString (const char*);
+static RECONENTRY* findEntry (const char*);
+static int putEntry (const char*, const char*);
+static int loadSnapshot (char*);
+static int saveSnapshot (void);
+static int readName (FILE*, char*, unsigned long*, RECONENTRY**);
+static int compareValues (const void*, const void*);
+static int appendList (char*, size_t*, RRPVECTOR*, int);
+static int buildRecord (RRPRESPONSE*, char*);
+static int splitRecord (char*, char**, char**, int*, char**, int*);
+static void diffLists (const char*, const char*, char**, int, char**, int);
+static void diffRecords (const char*, const char*, const char*);
+static void completeStatus (RRPREQUEST*, RRPRESPONSE*, void*);
+
+int
+main (
+	int argc,
+	char** argv
+) {
+	RRPSESSIONPOOL* pool = NULL;
+	RRPGOVERNOR* governor = NULL;
+	RRPRETRYPOLICY* reconnect = NULL;
+	RRPENDPOINTS* endpoints = NULL;
+	RRPREQUEST* request = NULL;
+	RECONSLOT* slots = NULL;
+	RECONSLOT* slot = NULL;
+	RECONENTRY* cursor = NULL;
+	FILE* input = NULL;
+	char* host = NULL;
+	char* registrarID = NULL;
+	char* registrarPassword = getenv("RRP_PASSWORD");
+	char* inputName = NULL;
+	char* outputName = NULL;
+	unsigned short int port = 648;
+	unsigned long bucket = 0;
+	unsigned long lastChecked = 0;
+	long journalSize = 0;
+	long snapshotSize = 0;
+	int sessions = 4;
+	int window = RRP_DEFAULT_SESSION_WINDOW;
+	int compact = 0;
+	int quiet = 0;
+	int endOfInput = 0;
+	int slotCount = 0;
+	int timeout = 0;
+	int option = 0;
+	int i = 0;
+	long wait = 0;
+	double rate = 0;
+	struct timeval now;
+	struct timeval shown;
+	struct stat status;
+
+	while ((option = getopt(argc, argv, "h:p:u:w:d:i:o:s:n:r:cq")) != -1) {
+		switch (option) {
+			case 'h': host = optarg; break;
+			case 'p': port = (unsigned short int) atoi(optarg); break;
+			case 'u': registrarID = optarg; break;
+			case 'w': registrarPassword = optarg; break;
+			case 'd': snapshotName = optarg; break;
+			case 'i': inputName = optarg; break;
+			case 'o': outputName = optarg; break;
+			case 's': sessions = atoi(optarg); break;
+			case 'n': window = atoi(optarg); break;
+			case 'r': rate = atof(optarg); break;
+			case 'c': compact = 1; break;
+			case 'q': quiet = 1; break;
+			default: usage(argv[0]);
+		}
+	}
+
+	if (host == NULL || registrarID == NULL || registrarPassword == NULL ||
+		snapshotName == NULL || sessions < 1 || window < 1 || rate < 0 ||
+		optind != argc) {
+		usage(argv[0]);
+	}
+
+	if (strlen(snapshotName) + 5 > sizeof(journalName)) {
+		fprintf(stderr, "%s: name too long\n", snapshotName);
+		exit(1);
+	}
+
+	sprintf(journalName, "%s.log", snapshotName);
+
+	if (loadSnapshot(snapshotName) < 0 || loadSnapshot(journalName) < 0) {
+		exit(1);
+	}
+
+	if (inputName != NULL && (input = fopen(inputName, "r")) == NULL) {
+		perror(inputName);
+		exit(1);
+	}
+
+	output = stdout;
+	if (outputName != NULL && (output = fopen(outputName, "w")) == NULL) {
+		perror(outputName);
+		exit(1);
+	}
+
+	if ((journal = fopen(journalName, "a")) == NULL) {
+		perror(journalName);
+		exit(1);
+	}
+
+	slotCount = sessions * window;
+	slots = (RECONSLOT*) malloc(slotCount * sizeof(RECONSLOT));
+	if (slots == NULL) {
+		fprintf(stderr, "Out of memory\n");
+		exit(1);
+	}
+
+	for (i = 0; i < slotCount; i++) {
+		slots[i].next = freeSlots;
+		freeSlots = &slots[i];
+	}
+
+	pool = RRPOpenToolPool(host, port, registrarID, registrarPassword,
+		sessions, window, RRP_DEFAULT_RETRY_ATTEMPTS, &endpoints,
+		&reconnect);
+
+	governor = RRPCreateToolGovernor(rate);
+
+	RRPCatchToolSignals();
+
+	gettimeofday(&shown, NULL);
+
+	while ((!endOfInput && !RRPToolInterrupted) || inFlight > 0) {
+		gettimeofday(&now, NULL);
+
+		wait = 0;
+
+		while (!endOfInput && !RRPToolInterrupted && freeSlots != NULL &&
+			(governor == NULL ||
+			(wait = RRPAcquireGovernor(governor, RRP_STATUS_COMMAND)) == 0)) {
+			slot = freeSlots;
+
+			if (input != NULL) {
+				if (!readName(input, slot->name, NULL, NULL)) {
+					endOfInput = 1;
+					break;
+				}
+			}
+			else {
+				/*
+				** Walk the snapshot. Entries are only replaced while
+				** walking, so the table is not resized
+				*/
+				if (!readName(NULL, slot->name, &bucket, &cursor)) {
+					endOfInput = 1;
+					break;
+				}
+			}
+
+			request = RRPCreateRequest(RRP_STATUS_COMMAND, RRP_DOMAIN_ENTITY,
+				slot->name, strlen(slot->name));
+
+			if (request == NULL) {
+				RRPPrintInternalErrorDescription();
+				endOfInput = 1;
+				break;
+			}
+
+			if (RRPSubmitPoolRequest(pool, request, completeStatus, slot) < 0) {
+				/*
+				** No session is left
+				*/
+				RRPPrintInternalErrorDescription();
+				RRPFreeRequest(request);
+				endOfInput = 1;
+				break;
+			}
+
+			freeSlots = slot->next;
+			inFlight++;
+		}
+
+		/*
+		** Wait for responses, for the next token, or for the next display
+		*/
+		timeout = 1000 - (int) (RRPGetToolElapsed(&shown, &now) / 1000);
+		if (timeout < 0) {
+			timeout = 0;
+		}
+
+		if (wait > 0 && !endOfInput && freeSlots != NULL &&
+			wait / 1000 < timeout) {
+			timeout = (int) (wait / 1000) + 1;
+		}
+
+		if (inFlight > 0) {
+			if (RRPPollSessionPool(pool, timeout) < 0) {
+				RRPPrintInternalErrorDescription();
+				break;
+			}
+		}
+		else if (!endOfInput && !RRPToolInterrupted) {
+			poll(NULL, 0, timeout);
+		}
+
+		gettimeofday(&now, NULL);
+
+		if (RRPGetToolElapsed(&shown, &now) >= 1000000.0) {
+			if (!quiet) {
+				fprintf(stderr, "%.0f/s  checked %lu  changed %lu  "
+					"errors %lu  in flight %d\n",
+					(checked - lastChecked) * 1000000.0 /
+					RRPGetToolElapsed(&shown, &now), checked, changed,
+					errors, inFlight);
+			}
+			lastChecked = checked;
+			shown = now;
+		}
+	}
+
+	RRPFreeSessionPool(pool);
+	RRPFreeRetryPolicy(reconnect);
+	RRPFreeEndpoints(endpoints);
+	if (governor != NULL) {
+		RRPFreeGovernor(governor);
+	}
+
+	if (input != NULL) {
+		fclose(input);
+	}
+
+	fflush(output);
+	if (output != stdout) {
+		fclose(output);
+	}
+
+	/*
+	** Make the journal durable, then merge it into the snapshot once it
+	** is large enough
+	*/
+	if (fflush(journal) != 0 || fsync(fileno(journal)) < 0) {
+		perror(journalName);
+		exit(1);
+	}
+
+	journalSize = ftell(journal);
+	fclose(journal);
+
+	if (stat(snapshotName, &status) == 0) {
+		snapshotSize = (long) status.st_size;
+	}
+
+	if (journalSize == 0) {
+		unlink(journalName);
+	}
+	else if ((compact || journalSize > snapshotSize / 2) &&
+		saveSnapshot() < 0) {
+		exit(1);
+	}
+
+	fprintf(stderr, "%lu checked, %lu changed, %lu errors%s\n", checked,
+		changed, errors, endOfInput ? "" : " (not finished)");
+
+	exit((errors > 0 || !endOfInput || inFlight > 0) ? 1 : 0);
+
+} /* main() */
+
+
+/*
+** Prints the usage message and exits
+*/
+static void
+usage (
+	char* program
+) {
+	RRPPrintToolUsage(program,
+		"\t-d snapshot [-i input] [-o output] [-s sessions] [-n window]\n"
+		"\t[-r rate] [-c] [-q]\n",
+		"\t-d\tsnapshot file, updated with the records that changed\n"
+		"\t-i\tdomain names to check (default: those of the snapshot)\n"
+		"\t-o\tdifferences \"domain,field,old,new\" (default standard "
+		"output)\n"
+		"\t-c\tmerge the journal into the snapshot\n"
+		"\t-q\tdo not display the progress\n",
+		4);
+
+} /* usage() */
+
+
+/*
+** Returns the hash value of a string (FNV-1a)
+*/
+static unsigned long
+hashString (
+	const char* string
+) {
+	unsigned long hash = 2166136261UL;
+
+	while (*string != '\0') {
+		hash = (hash ^ (unsigned char) *string++) * 16777619UL;
+	}
+
+	return hash;
+
+} /* hashString() */
+
+
+/*
+** Returns the entry of a domain, or NULL if it is not in the snapshot
+*/
+static RECONENTRY*
+findEntry (
+	const char* name
+) {
+	RECONENTRY* entry = NULL;
+
+	if (tableSize == 0) {
+		return NULL;
+	}
+
+	for (entry = table[hashString(name) & (tableSize - 1)]; entry != NULL &&
+		strcmp(entry->name, name) != 0; entry = entry->next) {
+	}
+
+	return entry;
+
+} /* findEntry() */
+
+
+/*
+** Adds a domain to the snapshot or replaces its record. Returns 0 if
+** successful, -1 if out of memory.
+*/
+static int
+putEntry (
+	const char* name,
+	const char* record
+) {
+	RECONENTRY** newTable = NULL;
+	RECONENTRY* entry = findEntry(name);
+	RECONENTRY* next = NULL;
+	char* copy = strdup(record);
+	unsigned long size = 0;
+	unsigned long i = 0;
+
+	if (copy == NULL) {
+		return -1;
+	}
+
+	if (entry != NULL) {
+		free(entry->record);
+		entry->record = copy;
+		entry->fingerprint = hashString(copy);
+		return 0;
+	}
+
+	/*
+	** Keep at most one entry per bucket on average
+	*/
+	if (entryCount >= tableSize) {
+		size = tableSize > 0 ? tableSize * 2 : 1024;
+		newTable = (RECONENTRY**) calloc(size, sizeof(RECONENTRY*));
+		if (newTable == NULL) {
+			free(copy);
+			return -1;
+		}
+
+		for (i = 0; i < tableSize; i++) {
+			for (entry = table[i]; entry != NULL; entry = next) {
+				next = entry->next;
+				entry->next = newTable[hashString(entry->name) & (size - 1)];
+				newTable[hashString(entry->name) & (size - 1)] = entry;
+			}
+		}
+
+		free(table);
+		table = newTable;
+		tableSize = size;
+	}
+
+	entry = (RECONENTRY*) malloc(sizeof(RECONENTRY));
+	if (entry == NULL || (entry->name = strdup(name)) == NULL) {
+		free(entry);
+		free(copy);
+		return -1;
+	}
+
+	entry->record = copy;
+	entry->fingerprint = hashString(copy);
+	entry->next = table[hashString(name) & (tableSize - 1)];
+	table[hashString(name) & (tableSize - 1)] = entry;
+	entryCount++;
+
+	return 0;
+
+} /* putEntry() */
+
+
+/*
+** Reads a snapshot or journal file, if it exists. Later lines replace
+** the earlier records of the same domain. Returns 0 if successful, -1
+** otherwise.
+*/
+static int
+loadSnapshot (
+	char* fileName
+) {
+	FILE* file = NULL;
+	char line[RECONCILE_MAX_NAME + RECONCILE_MAX_RECORD + 2];
+	char* separator = NULL;
+	unsigned long lineNumber = 0;
+
+	if ((file = fopen(fileName, "r")) == NULL) {
+		return 0;
+	}
+
+	while (fgets(line, sizeof(line), file) != NULL) {
+		lineNumber++;
+
+		line[strcspn(line, "\r\n")] = '\0';
+		separator = strchr(line, '\t');
+
+		if (separator == NULL || separator == line ||
+			separator - line >= RECONCILE_MAX_NAME) {
+			/*
+			** The last line of a journal may have been cut short
+			*/
+			fprintf(stderr, "%s:%lu: invalid record ignored\n", fileName,
+				lineNumber);
+			continue;
+		}
+
+		*separator = '\0';
+
+		if (putEntry(line, separator + 1) < 0) {
+			fprintf(stderr, "Out of memory\n");
+			fclose(file);
+			return -1;
+		}
+	}
+
+	fclose(file);
+
+	return 0;
+
+} /* loadSnapshot() */
+
+
+/*
+** Writes every record to the snapshot file and removes the journal.
+** Returns 0 if successful, -1 otherwise.
+*/
+static int
+saveSnapshot (
+	void
+) {
+	char temporaryName[1024];
+	RECONENTRY* entry = NULL;
+	FILE* file = NULL;
+	unsigned long i = 0;
+
+	sprintf(temporaryName, "%s.tmp", snapshotName);
+
+	if ((file = fopen(temporaryName, "w")) == NULL) {
+		perror(temporaryName);
+		return -1;
+	}
+
+	for (i = 0; i < tableSize; i++) {
+		for (entry = table[i]; entry != NULL; entry = entry->next) {
+			fprintf(file, "%s\t%s\n", entry->name, entry->record);
+		}
+	}
+
+	if (fflush(file) != 0 || fsync(fileno(file)) < 0 || fclose(file) != 0 ||
+		rename(temporaryName, snapshotName) < 0) {
+		perror(snapshotName);
+		return -1;
+	}
+
+	/*
+	** The journal only repeats records of the new snapshot, so a crash
+	** before it is removed does no harm
+	*/
+	unlink(journalName);
+
+	return 0;
+
+} /* saveSnapshot() */
+
+
+/*
+** Reads the next domain name, from a file if 'input' is not NULL and
+** from the snapshot otherwise ('bucket' and 'cursor' keep the position).
+** Returns 1 if a name was read, 0 at the end.
+*/
+static int
+readName (
+	FILE* input,
+	char* name,
+	unsigned long* bucket,
+	RECONENTRY** cursor
+) {
+	size_t i = 0;
+
+	if (input == NULL) {
+		while (*cursor == NULL && *bucket < tableSize) {
+			*cursor = table[(*bucket)++];
+		}
+
+		if (*cursor == NULL) {
+			return 0;
+		}
+
+		strcpy(name, (*cursor)->name);
+		*cursor = (*cursor)->next;
+		return 1;
+	}
+
+	if (!RRPReadToolName(input, name, RECONCILE_MAX_NAME)) {
+		return 0;
+	}
+
+	/*
+	** Domain names are compared without regard to case
+	*/
+	for (i = 0; name[i] != '\0'; i++) {
+		name[i] = (char) tolower((unsigned char) name[i]);
+	}
+
+	return 1;
+
+} /* readName() */
+
+
+/*
+** Comparison function of qsort() for strings
+*/
+static int
+compareValues (
+	const void* a,
+	const void* b
+) {
+	return strcmp(*(char* const*) a, *(char* const*) b);
+
+} /* compareValues() */
+
+
+/*
+** Appends the values of a vector to a record, sorted and separated by
+** commas. Name servers ('lower' not 0) are stored in lower case without
+** a trailing dot. Returns 0 if successful, -1 if the record is too long.
+*/
+static int
+appendList (
+	char* record,
+	size_t* length,
+	RRPVECTOR* values,
+	int lower
+) {
+	char* sorted[RECONCILE_MAX_VALUES];
+	size_t valueLength = 0;
+	size_t start = 0;
+	size_t j = 0;
+	int count = RRPGetVectorSize(values);
+	int i = 0;
+
+	if (count > RECONCILE_MAX_VALUES) {
+		return -1;
+	}
+
+	for (i = 0; i < count; i++) {
+		sorted[i] = RRPGetVectorElementAt(values, i);
+	}
+
+	qsort(sorted, count, sizeof(char*), compareValues);
+
+	for (i = 0; i < count; i++) {
+		valueLength = strlen(sorted[i]);
+		if (*length + valueLength + 2 >= RECONCILE_MAX_RECORD) {
+			return -1;
+		}
+
+		if (i > 0) {
+			record[(*length)++] = ',';
+		}
+
+		start = *length;
+		for (j = 0; j < valueLength; j++) {
+			record[(*length)++] = lower ?
+				(char) tolower((unsigned char) sorted[i][j]) : sorted[i][j];
+		}
+
+		if (lower && *length > start && record[*length - 1] == '.') {
+			(*length)--;
+		}
+	}
+
+	record[*length] = '\0';
+
+	return 0;
+
+} /* appendList() */
+
+
+/*
+** Builds the record of a domain from its Status response. Returns 0 if
+** successful, -1 if the record is too long.
+*/
+static int
+buildRecord (
+	RRPRESPONSE* response,
+	char* record
+) {
+	RRPVECTOR* expiration = NULL;
+	RRPVECTOR* statuses = NULL;
+	RRPVECTOR* nameServers = NULL;
+	RRPVECTOR* empty = NULL;
+	char* key = NULL;
+	size_t length = 0;
+	int result = 0;
+
+	if (response->attributes != NULL) {
+		RRPResetPropertyPointer(response->attributes);
+
+		while ((key = RRPGetNextPropertyKey(response->attributes)) != NULL) {
+			if (strcasecmp(key, "registration expiration date") == 0) {
+				expiration = RRPGetProperty(response->attributes, key);
+			}
+			else if (strcasecmp(key, "status") == 0) {
+				statuses = RRPGetProperty(response->attributes, key);
+			}
+			else if (strcasecmp(key, "nameserver") == 0) {
+				nameServers = RRPGetProperty(response->attributes, key);
+			}
+		}
+	}
+
+	if ((empty = RRPCreateVector()) == NULL) {
+		return -1;
+	}
+
+	record[0] = '\0';
+
+	if (expiration != NULL && RRPGetVectorSize(expiration) > 0 &&
+		strlen(RRPGetVectorElementAt(expiration, 0)) + 1 <
+			RECONCILE_MAX_RECORD) {
+		strcpy(record, RRPGetVectorElementAt(expiration, 0));
+		length = strlen(record);
+	}
+
+	record[length++] = '\t';
+	result = appendList(record, &length,
+		statuses != NULL ? statuses : empty, 0);
+
+	if (result == 0) {
+		record[length++] = '\t';
+		result = appendList(record, &length,
+			nameServers != NULL ? nameServers : empty, 1);
+	}
+
+	RRPFreeVector(empty);
+
+	return result;
+
+} /* buildRecord() */
+
+
+/*
+** Splits a copy of a record into its expiration date and its lists of
+** statuses and name servers. Returns 0 if successful, -1 if the record
+** is invalid.
+*/
+static int
+splitRecord (
+	char* record,
+	char** expiration,
+	char** statuses,
+	int* statusCount,
+	char** nameServers,
+	int* nameServerCount
+) {
+	char* fields[3];
+	char** lists[2];
+	int* counts[2];
+	char* value = NULL;
+	int i = 0;
+
+	lists[0] = statuses;
+	lists[1] = nameServers;
+	counts[0] = statusCount;
+	counts[1] = nameServerCount;
+
+	fields[0] = record;
+	for (i = 1; i < 3; i++) {
+		fields[i] = strchr(fields[i - 1], '\t');
+		if (fields[i] == NULL) {
+			return -1;
+		}
+		*fields[i]++ = '\0';
+	}
+
+	*expiration = fields[0];
+
+	for (i = 0; i < 2; i++) {
+		*counts[i] = 0;
+
+		for (value = fields[i + 1]; *value != '\0'; ) {
+			if (*counts[i] == RECONCILE_MAX_VALUES) {
+				return -1;
+			}
+			lists[i][(*counts[i])++] = value;
+
+			value += strcspn(value, ",");
+			if (*value == ',') {
+				*value++ = '\0';
+			}
+		}
+	}
+
+	return 0;
+
+} /* splitRecord() */
+
+
+/*
+** Writes the differences between two sorted lists of values
+*/
+static void
+diffLists (
+	const char* name,
+	const char* field,
+	char** old,
+	int oldCount,
+	char** new,
+	int newCount
+) {
+	int i = 0;
+	int j = 0;
+	int order = 0;
+
+	while (i < oldCount || j < newCount) {
+		if (i == oldCount) {
+			order = 1;
+		}
+		else if (j == newCount) {
+			order = -1;
+		}
+		else {
+			order = strcmp(old[i], new[j]);
+		}
+
+		if (order < 0) {
+			fprintf(output, "%s,%s,%s,\n", name, field, old[i++]);
+		}
+		else if (order > 0) {
+			fprintf(output, "%s,%s,,%s\n", name, field, new[j++]);
+		}
+		else {
+			i++;
+			j++;
+		}
+	}
+
+} /* diffLists() */
+
+
+/*
+** Writes the differences between two records of a domain. 'old' is NULL
+** for a domain that is not in the snapshot
+*/
+static void
+diffRecords (
+	const char* name,
+	const char* old,
+	const char* new
+) {
+	char oldCopy[RECONCILE_MAX_RECORD];
+	char newCopy[RECONCILE_MAX_RECORD];
+	char* oldExpiration = NULL;
+	char* newExpiration = NULL;
+	char* oldStatuses[RECONCILE_MAX_VALUES];
+	char* newStatuses[RECONCILE_MAX_VALUES];
+	char* oldNameServers[RECONCILE_MAX_VALUES];
+	char* newNameServers[RECONCILE_MAX_VALUES];
+	int oldStatusCount = 0;
+	int newStatusCount = 0;
+	int oldNameServerCount = 0;
+	int newNameServerCount = 0;
+
+	if (old == NULL || strcmp(old, RECONCILE_MISSING) == 0 ||
+		strlen(old) >= sizeof(oldCopy)) {
+		old = "\t\t";
+	}
+
+	strcpy(oldCopy, old);
+	strcpy(newCopy, new);
+
+	if (splitRecord(oldCopy, &oldExpiration, oldStatuses, &oldStatusCount,
+		oldNameServers, &oldNameServerCount) < 0) {
+		strcpy(oldCopy, "\t\t");
+		splitRecord(oldCopy, &oldExpiration, oldStatuses, &oldStatusCount,
+			oldNameServers, &oldNameServerCount);
+	}
+
+	splitRecord(newCopy, &newExpiration, newStatuses, &newStatusCount,
+		newNameServers, &newNameServerCount);
+
+	if (strcmp(oldExpiration, newExpiration) != 0) {
+		fprintf(output, "%s,expiration,%s,%s\n", name, oldExpiration,
+			newExpiration);
+	}
+
+	diffLists(name, "status", oldStatuses, oldStatusCount, newStatuses,
+		newStatusCount);
+	diffLists(name, "nameserver", oldNameServers, oldNameServerCount,
+		newNameServers, newNameServerCount);
+
+} /* diffRecords() */
+
+
+/*
+** Completion function of the Status commands: compares the response with
+** the snapshot and records the differences
+*/
+static void
+completeStatus (
+	RRPREQUEST* request,
+	RRPRESPONSE* response,
+	void* context
+) {
+	RECONSLOT* slot = (RECONSLOT*) context;
+	RECONENTRY* entry = findEntry(slot->name);
+	char record[RECONCILE_MAX_RECORD];
+	int code = (response != NULL) ? response->code : -1;
+
+	checked++;
+
+	if (code == 200 && buildRecord(response, record) < 0) {
+		fprintf(stderr, "%s: record too long\n", slot->name);
+		code = -1;
+	}
+	else if (code == 545) {
+		strcpy(record, RECONCILE_MISSING);
+	}
+
+	if (code != 200 && code != 545) {
+		fprintf(output, "%s,error,,%d\n", slot->name, code);
+		errors++;
+	}
+	else if (entry == NULL || entry->fingerprint != hashString(record) ||
+		strcmp(entry->record, record) != 0) {
+		/*
+		** Only the records that changed are compared field by field and
+		** written to the journal
+		*/
+		if (code == 545) {
+			fprintf(output, "%s,missing,,%d\n", slot->name, code);
+		}
+		else {
+			diffRecords(slot->name, entry != NULL ? entry->record : NULL,
+				record);
+		}
+
+		fprintf(journal, "%s\t%s\n", slot->name, record);
+
+		if (putEntry(slot->name, record) < 0) {
+			fprintf(stderr, "Out of memory\n");
+			RRPToolInterrupted = 1;
+		}
+
+		changed++;
+	}
+
+	if (response != NULL) {
+		RRPFreeResponse(response);
+	}
+
+	slot->next = freeSlots;
+	freeSlots = slot;
+	inFlight--;
+
+} /* completeStatus() */
@@ -0,0 +1,193 @@
+/* ===========================================================================
+ * Copyright (C) 2000 VeriSign, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * VeriSign Global Registry Service
+ * 21345 Ridgetop Circle
+ * Dulles, VA 20166
+ * ===========================================================================
+ * The RRP, APIs and Software are provided "as-is" and without any warranty
+ * of any kind.  NSI EXPRESSLY DISCLAIMS ALL WARRANTIES AND/OR CONDITIONS,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * AND CONDITIONS OF MERCHANTABILITY OR SATISFACTORY QUALITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE AND NONINFRINGEMENT OF THIRD PARTY RIGHTS.  NSI DOES
+ * NOT WARRANT THAT THE FUNCTIONS CONTAINED IN THE RRP, APIs OR SOFTWARE
+ * WILL MEET REGISTRAR'S REQUIREMENTS, OR THAT THE OPERATION OF THE RRP,
+ * APIs OR SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE,OR THAT DEFECTS IN
+ * THE RRP, APIs OR SOFTWARE WILL BE CORRECTED.  FURTHERMORE, NSI DOES NOT
+ * WARRANT NOR MAKE ANY REPRESENTATIONS REGARDING THE USE OR THE RESULTS OF
+ * THE RRP, APIs, SOFTWARE OR RELATED DOCUMENTATION IN TERMS OF THEIR
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR OTHERWISE.  SHOULD THE RRP, APIs
+ * OR SOFTWARE PROVE DEFECTIVE, REGISTRAR ASSUMES THE ENTIRE COST OF ALL
+ * NECESSARY SERVICING, REPAIR OR CORRECTION.
+ * ======================================================================== */
+
+/*
+**
+** Module Name: rrpRecover.c
+**
+** Version: 2.1 for RRP version 2.1.0
+**
+** Date: Oct. 19th, 2026
+**
+** Description: rrpRecover lists the commands of a journal (see
+**              rrpJournal.h) whose outcome is unknown: those recorded
+**              before a crash that never got a response, and those whose
+**              connection failed while they were in flight. Each of them
+**              may or may not have been executed by the registry and
+**              must be checked before it is sent again. One line is
+**              written on the standard output for each command:
+**
+**                sequence,time,command,name,code
+**
+**              where 'time' is when the command was recorded, in UTC,
+**              and 'code' the response code (-1 if there was none).
+**              With -v the text of the request follows on the next
+**              lines, indented by a tab.
+**
+**              The number of records skipped because they were cut
+**              short or damaged is displayed on the standard error. The
+**              exit status is 0 if every command is resolved and no
+**              record is damaged, 1 otherwise.
+**
+** Usage:       rrpRecover [-v] journal
+**
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "rrpAPI.h"
+#include "rrpJournal.h"
+#include "rrpInternalError.h"
+
+static const char* commandNames[] = {
+	"Add", "Check", "Del", "Describe", "Mod", "Quit", "Renew", "Restore",
+	"Session", "Status", "Sync", "Transfer"
+};
+
+static void usage (char*);
+static void printRequest (char*);
+
+int
+main (
+	int argc,
+	char** argv
+) {
+	RRPJOURNALREADER* reader = NULL;
+	RRPJOURNALENTRY entry;
+	time_t recorded = 0;
+	char when[32];
+	unsigned long unresolved = 0;
+	int verbose = 0;
+	int damage = 0;
+	int option = 0;
+	int result = 0;
+
+	while ((option = getopt(argc, argv, "v")) != -1) {
+		switch (option) {
+			case 'v': verbose = 1; break;
+			default: usage(argv[0]);
+		}
+	}
+
+	if (optind != argc - 1) {
+		usage(argv[0]);
+	}
+
+	reader = RRPOpenJournalReader(argv[optind]);
+	if (reader == NULL) {
+		RRPPrintInternalErrorDescription();
+		exit(2);
+	}
+
+	while ((result = RRPReadJournalEntry(reader, &entry)) > 0) {
+		recorded = (time_t) entry.time;
+		strftime(when, sizeof(when), "%Y-%m-%d %H:%M:%S",
+			gmtime(&recorded));
+
+		printf("%lu,%s,%s,%s,%d\n", entry.sequence, when,
+			((int) entry.command >= 0 && (int) entry.command <
+				(int) (sizeof(commandNames) / sizeof(commandNames[0]))) ?
+				commandNames[entry.command] : "?",
+			entry.name, entry.code);
+
+		if (verbose) {
+			printRequest(entry.request);
+		}
+		unresolved++;
+	}
+
+	if (result < 0) {
+		RRPPrintInternalErrorDescription();
+		exit(2);
+	}
+
+	damage = RRPGetJournalDamage(reader);
+	RRPCloseJournalReader(reader);
+
+	fprintf(stderr, "%lu unresolved, %d damaged\n", unresolved, damage);
+
+	exit((unresolved > 0 || damage > 0) ? 1 : 0);
+
+} /* main() */
+
+
+/*
+** Prints the usage message and exits
+*/
+static void
+usage (
+	char* program
+) {
+	fprintf(stderr, "Usage: %s [-v] journal\n"
+		"\n"
+		"\t-v\talso print the text of each request\n",
+		program);
+	exit(2);
+
+} /* usage() */
+
+
+/*
+** Prints the text of a request, each line indented by a tab and without
+** its line break
+*/
+static void
+printRequest (
+	char* text
+) {
+	char* end = NULL;
+
+	while (*text != '\0') {
+		end = strchr(text, '\n');
+		if (end == NULL) {
+			end = text + strlen(text);
+		}
+
+		if (end > text && end[-1] == '\r') {
+			printf("\t%.*s\n", (int) (end - text - 1), text);
+		}
+		else {
+			printf("\t%.*s\n", (int) (end - text), text);
+		}
+
+		text = (*end == '\n') ? end + 1 : end;
+	}
+
+} /* printRequest() */
@@ -0,0 +1,719 @@
+/* ===========================================================================
+ * Copyright (C) 2000 VeriSign, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * VeriSign Global Registry Service
+ * 21345 Ridgetop Circle
+ * Dulles, VA 20166
+ * ===========================================================================
+ * The RRP, APIs and Software are provided "as-is" and without any warranty
+ * of any kind.  NSI EXPRESSLY DISCLAIMS ALL WARRANTIES AND/OR CONDITIONS,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * AND CONDITIONS OF MERCHANTABILITY OR SATISFACTORY QUALITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE AND NONINFRINGEMENT OF THIRD PARTY RIGHTS.  NSI DOES
+ * NOT WARRANT THAT THE FUNCTIONS CONTAINED IN THE RRP, APIs OR SOFTWARE
+ * WILL MEET REGISTRAR'S REQUIREMENTS, OR THAT THE OPERATION OF THE RRP,
+ * APIs OR SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE,OR THAT DEFECTS IN
+ * THE RRP, APIs OR SOFTWARE WILL BE CORRECTED.  FURTHERMORE, NSI DOES NOT
+ * WARRANT NOR MAKE ANY REPRESENTATIONS REGARDING THE USE OR THE RESULTS OF
+ * THE RRP, APIs, SOFTWARE OR RELATED DOCUMENTATION IN TERMS OF THEIR
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR OTHERWISE.  SHOULD THE RRP, APIs
+ * OR SOFTWARE PROVE DEFECTIVE, REGISTRAR ASSUMES THE ENTIRE COST OF ALL
+ * NECESSARY SERVICING, REPAIR OR CORRECTION.
+ * ======================================================================== */
+
+/*
+**
+** Module Name: rrpRenew.c
+**
+** Version: 2.1 for RRP version 2.1.0
+**
+** Date: Oct. 19th, 2026
+**
+** Description: rrpRenew renews a list of domain names. The records are
+**              read one per line from a file:
+**
+**                domain [period [currentExpirationYear]]
+**
+**              with the fields separated by commas or white space, and
+**              the Renew commands are pipelined over a pool of sessions
+**              (see rrpSession.h). One line is appended to the result
+**              file for each record, in the order the responses arrive:
+**
+**                domain,code
+**
+**              Progress is saved in a checkpoint file, so that a run that
+**              is interrupted or crashes can be started again with the
+**              same arguments and resumes where it stopped. The
+**              checkpoint holds the line below which every record is
+**              done, the records done above it, and the line below which
+**              records may have been sent. That last line is saved
+**              BEFORE the records are sent, so after a crash every record
+**              that may have reached the server is known. Such a record
+**              is sent again only if it gives the current expiration
+**              year, which makes the server reject a second renewal;
+**              otherwise it is reported as "unknown" in the result file
+**              and must be checked by hand. No record is ever renewed
+**              twice. For the same reason, a session whose connection
+**              drops logs in again and asks the server about the
+**              domains of the records it had written (see
+**              RRPResolveOutcome() in rrpRetry.h): a record is sent
+**              again only if its domain was not renewed, and one the
+**              answer does not settle stays pending as after a crash.
+**
+**              The checkpoint is replaced atomically (written to a
+**              temporary file, synchronized, renamed, then its directory
+**              synchronized) once a second and whenever more records
+**              must be reserved, after the result file has been
+**              synchronized. A checkpoint that cannot be saved stops
+**              the run.
+**
+** Usage:       rrpRenew -h host[,host...] [-p port] -u id [-w password]
+**                  -i input -o results -c checkpoint [-s sessions]
+**                  [-j journal] [-n window] [-r rate] [-q]
+**
+**              The password is taken from the RRP_PASSWORD environment
+**              variable if -w is not given. Several servers may be
+**              given to -h, each as host or host:port; the sessions are
+**              then spread over them and leave those that fail (see
+**              rrpEndpoint.h). With -j every Renew command is recorded
+**              in a journal before it is sent, together with its outcome
+**              once known (see rrpJournal.h); rrpRecover lists those
+**              whose outcome was lost.
+**
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/time.h>
+#include "rrpAPI.h"
+#include "rrpSession.h"
+#include "rrpGovernor.h"
+#include "rrpRetry.h"
+#include "rrpEndpoint.h"
+#include "rrpJournal.h"
+#include "rrpInternalError.h"
+#include "rrpTool.h"
+
+/*
+** Longest record accepted, number of records reserved at a time, and
+** most records between the first record not done and the next record
+** read
+*/
+#define RENEW_MAX_LINE 512
+#define RENEW_RESERVE 1024
+#define RENEW_SPAN 65536
+
+/*
+** State of a record in the span
+*/
+#define RENEW_PENDING 0
+#define RENEW_DONE 1
+
+/*
+** A Renew command in flight
+*/
+typedef struct _RENEWSLOT  RENEWSLOT;
+
+struct _RENEWSLOT {
+	char name[RENEW_MAX_LINE];
+	unsigned long line;
+	RENEWSLOT* next;            /* next free slot */
+};
+
+/*
+** Progress of the run. Every record before line 'base' is done; the
+** state of the records from 'base' on is kept in 'span', indexed by line
+** number modulo RENEW_SPAN. Records before line 'reserved' may have been
+** sent
+*/
+typedef struct {
+	unsigned long base;
+	unsigned long reserved;
+	unsigned long previousReserved; /* 'reserved' of the previous run */
+	unsigned long sent;         /* line after the last record sent */
+	unsigned char span[RENEW_SPAN];
+	int changed;
+} RENEWPROGRESS;
+
+static RENEWPROGRESS progress;
+static FILE* results = NULL;
+static char* checkpointName = NULL;
+static RENEWSLOT* freeSlots = NULL;
+static int inFlight = 0;
+static unsigned long renewed = 0;
+static unsigned long refused = 0;
+static unsigned long failed = 0;
+static unsigned long unknown = 0;
+
+static void usage (char*);
+static int parseRecord (char*, char*, int*, int*);
+static void markDone (unsigned long);
+static int loadCheckpoint (void);
+static int saveCheckpoint (void);
+static int syncCheckpointDirectory (void);
+static void completeRenew (RRPREQUEST*, RRPRESPONSE*, void*);
+
+int
+main (
+	int argc,
+	char** argv
+) {
+	RRPSESSIONPOOL* pool = NULL;
+	RRPREQUEST* request = NULL;
+	RENEWSLOT* slots = NULL;
+	RENEWSLOT* slot = NULL;
+	FILE* input = NULL;
+	RRPGOVERNOR* governor = NULL;
+	RRPRETRYPOLICY* reconnect = NULL;
+	RRPENDPOINTS* endpoints = NULL;
+	RRPJOURNAL* journal = NULL;
+	char* host = NULL;
+	char* registrarID = NULL;
+	char* registrarPassword = getenv("RRP_PASSWORD");
+	char* inputName = NULL;
+	char* resultName = NULL;
+	char* journalName = NULL;
+	char line[RENEW_MAX_LINE];
+	char number[12];
+	unsigned short int port = 648;
+	unsigned long lineNumber = 0;
+	int sessions = 4;
+	int window = RRP_DEFAULT_SESSION_WINDOW;
+	int quiet = 0;
+	int endOfInput = 0;
+	int haveRecord = 0;
+	int slotCount = 0;
+	int period = 0;
+	int year = 0;
+	int option = 0;
+	int result = 0;
+	int i = 0;
+	double rate = 0;
+	struct timeval now;
+	struct timeval saved;
+
+	while ((option = getopt(argc, argv, "h:p:u:w:i:o:c:j:s:n:r:q")) != -1) {
+		switch (option) {
+			case 'h': host = optarg; break;
+			case 'p': port = (unsigned short int) atoi(optarg); break;
+			case 'u': registrarID = optarg; break;
+			case 'w': registrarPassword = optarg; break;
+			case 'i': inputName = optarg; break;
+			case 'o': resultName = optarg; break;
+			case 'j': journalName = optarg; break;
+			case 'c': checkpointName = optarg; break;
+			case 's': sessions = atoi(optarg); break;
+			case 'n': window = atoi(optarg); break;
+			case 'r': rate = atof(optarg); break;
+			case 'q': quiet = 1; break;
+			default: usage(argv[0]);
+		}
+	}
+
+	if (host == NULL || registrarID == NULL || registrarPassword == NULL ||
+		inputName == NULL || resultName == NULL || checkpointName == NULL ||
+		sessions < 1 || window < 1 || rate < 0 || optind != argc) {
+		usage(argv[0]);
+	}
+
+	if (loadCheckpoint() < 0) {
+		exit(1);
+	}
+
+	if ((input = fopen(inputName, "r")) == NULL) {
+		perror(inputName);
+		exit(1);
+	}
+
+	if ((results = fopen(resultName, "a")) == NULL) {
+		perror(resultName);
+		exit(1);
+	}
+
+	slotCount = sessions * window;
+	slots = (RENEWSLOT*) malloc(slotCount * sizeof(RENEWSLOT));
+	if (slots == NULL) {
+		fprintf(stderr, "Out of memory\n");
+		exit(1);
+	}
+
+	for (i = 0; i < slotCount; i++) {
+		slots[i].next = freeSlots;
+		freeSlots = &slots[i];
+	}
+
+	/*
+	** The sessions, and their logins, share the process governor
+	*/
+	if ((governor = RRPCreateToolGovernor(rate)) != NULL) {
+		RRPSetProcessGovernor(governor);
+	}
+
+	pool = RRPOpenToolPool(host, port, registrarID, registrarPassword,
+		sessions, window, RRP_DEFAULT_RETRY_ATTEMPTS, &endpoints,
+		&reconnect);
+
+	/*
+	** Every command is recorded before it is sent, so that those whose
+	** outcome is lost can be listed afterwards (see rrpRecover)
+	*/
+	if (journalName != NULL) {
+		journal = RRPOpenJournal(journalName);
+		if (journal == NULL) {
+			RRPPrintInternalErrorDescription();
+			exit(1);
+		}
+		RRPSetSessionPoolJournal(pool, journal);
+	}
+
+	RRPCatchToolSignals();
+
+	gettimeofday(&saved, NULL);
+
+	while ((!endOfInput && !RRPToolInterrupted) || inFlight > 0) {
+		while (!endOfInput && !RRPToolInterrupted && freeSlots != NULL) {
+			slot = freeSlots;
+
+			if (!haveRecord) {
+				if (fgets(line, sizeof(line), input) == NULL) {
+					endOfInput = 1;
+					break;
+				}
+
+				lineNumber++;
+
+				/*
+				** Records done by an earlier run, blank lines and comments
+				*/
+				if (lineNumber < progress.base ||
+					progress.span[lineNumber % RENEW_SPAN] == RENEW_DONE ||
+					parseRecord(line, slot->name, &period, &year) == 0) {
+					if (lineNumber >= progress.base) {
+						markDone(lineNumber);
+					}
+					continue;
+				}
+
+				haveRecord = 1;
+			}
+
+			/*
+			** Keep the state of every record between 'base' and the
+			** next record in the span
+			*/
+			if (lineNumber >= progress.base + RENEW_SPAN) {
+				if (inFlight == 0) {
+					/*
+					** Only failed records hold 'base' back
+					*/
+					fprintf(stderr, "Too many failed records\n");
+					endOfInput = 1;
+				}
+				break;
+			}
+
+			/*
+			** A record that may have been sent by the previous run is
+			** only sent again if the server can reject a second renewal
+			*/
+			if (lineNumber < progress.previousReserved && year == 0) {
+				fprintf(results, "%s,unknown\n", slot->name);
+				unknown++;
+				markDone(lineNumber);
+				haveRecord = 0;
+				continue;
+			}
+
+			/*
+			** Reserve records before sending them
+			*/
+			if (lineNumber >= progress.reserved) {
+				progress.reserved = lineNumber + RENEW_RESERVE;
+				if (saveCheckpoint() < 0) {
+					endOfInput = 1;
+					break;
+				}
+				gettimeofday(&saved, NULL);
+			}
+
+			request = RRPCreateRequest(RRP_RENEW_COMMAND, RRP_DOMAIN_ENTITY,
+				slot->name, strlen(slot->name));
+			result = (request != NULL) ? 0 : -1;
+
+			if (result == 0 && period > 0) {
+				sprintf(number, "%d", period);
+				result = RRPAppendRequestAttribute(request, "-Period", 7,
+					number, strlen(number));
+			}
+
+			if (result == 0 && year > 0) {
+				sprintf(number, "%d", year);
+				result = RRPAppendRequestAttribute(request,
+					"-CurrentExpirationYear", 22, number, strlen(number));
+			}
+
+			if (result == 0) {
+				slot->line = lineNumber;
+				result = RRPSubmitPoolRequest(pool, request, completeRenew,
+					slot);
+			}
+
+			if (result < 0) {
+				/*
+				** No session is left, or out of memory: the record stays
+				** reserved and is dealt with by the next run
+				*/
+				RRPPrintInternalErrorDescription();
+				if (request != NULL) {
+					RRPFreeRequest(request);
+				}
+				endOfInput = 1;
+				break;
+			}
+
+			freeSlots = slot->next;
+			inFlight++;
+			haveRecord = 0;
+			progress.sent = lineNumber + 1;
+		}
+
+		if (inFlight > 0 && RRPPollSessionPool(pool, 1000) < 0) {
+			RRPPrintInternalErrorDescription();
+			break;
+		}
+
+		gettimeofday(&now, NULL);
+
+		if (now.tv_sec != saved.tv_sec && progress.changed) {
+			if (saveCheckpoint() < 0) {
+				break;
+			}
+			saved = now;
+
+			if (!quiet) {
+				fprintf(stderr, "line %lu  in flight %d  renewed %lu  "
+					"refused %lu  failed %lu  unknown %lu\n", progress.base,
+					inFlight, renewed, refused, failed, unknown);
+			}
+		}
+	}
+
+	/*
+	** Nothing is in flight any more, so only the records actually sent
+	** remain reserved. Records that failed (their session's connection
+	** failed) are still pending and are dealt with by the next run
+	*/
+	if (inFlight == 0) {
+		progress.reserved = progress.sent > progress.base ?
+			progress.sent : progress.base;
+	}
+	saveCheckpoint();
+
+	RRPFreeSessionPool(pool);
+	RRPFreeRetryPolicy(reconnect);
+	RRPFreeEndpoints(endpoints);
+	if (journal != NULL) {
+		RRPCloseJournal(journal);
+	}
+	if (governor != NULL) {
+		RRPSetProcessGovernor(NULL);
+		RRPFreeGovernor(governor);
+	}
+	fclose(results);
+	fclose(input);
+	free(slots);
+
+	fprintf(stderr, "%lu renewed, %lu refused, %lu failed, %lu unknown%s\n",
+		renewed, refused, failed, unknown,
+		(endOfInput && !RRPToolInterrupted && failed == 0 && inFlight == 0) ?
+			"" : " (not finished: run again to resume)");
+
+	exit((failed > 0 || unknown > 0 || RRPToolInterrupted || !endOfInput) ?
+		1 : 0);
+
+} /* main() */
+
+
+/*
+** Prints the usage message and exits
+*/
+static void
+usage (
+	char* program
+) {
+	RRPPrintToolUsage(program,
+		"\t-i input -o results -c checkpoint [-s sessions] [-n window]\n"
+		"\t[-j journal] [-r rate] [-q]\n",
+		"\t-i\trecords \"domain [period [currentExpirationYear]]\"\n"
+		"\t-o\tresult file, appended to\n"
+		"\t-c\tcheckpoint file; run again with the same file to resume\n"
+		"\t-j\tjournal recording each command before it is sent\n"
+		"\t-q\tdo not display the progress\n",
+		4);
+
+} /* usage() */
+
+
+/*
+** Splits a record into the domain name, the period and the current
+** expiration year (0 when not given). Returns 0 for blank lines and
+** comments, 1 otherwise.
+*/
+static int
+parseRecord (
+	char* line,
+	char* name,
+	int* period,
+	int* year
+) {
+	char* field = NULL;
+	char* next = NULL;
+	int index = 0;
+
+	*period = 0;
+	*year = 0;
+
+	for (field = line; field != NULL && index < 3; field = next, index++) {
+		field += strspn(field, " \t,\r\n");
+		if (*field == '\0' || (index == 0 && *field == '#')) {
+			break;
+		}
+
+		next = field + strcspn(field, " \t,\r\n");
+		if (*next != '\0') {
+			*next++ = '\0';
+		}
+		else {
+			next = NULL;
+		}
+
+		switch (index) {
+			case 0: strcpy(name, field); break;
+			case 1: *period = atoi(field); break;
+			case 2: *year = atoi(field); break;
+		}
+	}
+
+	return index > 0;
+
+} /* parseRecord() */
+
+
+/*
+** Marks a record as done, and moves 'base' past the records done
+*/
+static void
+markDone (
+	unsigned long line
+) {
+	progress.span[line % RENEW_SPAN] = RENEW_DONE;
+
+	while (progress.span[progress.base % RENEW_SPAN] == RENEW_DONE) {
+		progress.span[progress.base % RENEW_SPAN] = RENEW_PENDING;
+		progress.base++;
+	}
+
+	progress.changed = 1;
+
+} /* markDone() */
+
+
+/*
+** Reads the checkpoint file, if it exists. Returns 0 if successful, -1
+** otherwise.
+*/
+static int
+loadCheckpoint (
+	void
+) {
+	FILE* file = NULL;
+	unsigned long line = 0;
+	int version = 0;
+
+	progress.base = 1;
+	progress.reserved = 1;
+	progress.previousReserved = 1;
+	progress.sent = 1;
+
+	if ((file = fopen(checkpointName, "r")) == NULL) {
+		return 0;
+	}
+
+	if (fscanf(file, "rrpRenew checkpoint %d\nbase %lu\nreserved %lu\n",
+		&version, &progress.base, &progress.reserved) != 3 || version != 1 ||
+		progress.base < 1 || progress.reserved < progress.base) {
+		fprintf(stderr, "%s: invalid checkpoint\n", checkpointName);
+		fclose(file);
+		return -1;
+	}
+
+	while (fscanf(file, "done %lu\n", &line) == 1) {
+		if (line >= progress.base && line < progress.base + RENEW_SPAN) {
+			progress.span[line % RENEW_SPAN] = RENEW_DONE;
+		}
+	}
+
+	fclose(file);
+
+	progress.previousReserved = progress.reserved;
+	progress.sent = progress.reserved;
+
+	return 0;
+
+} /* loadCheckpoint() */
+
+
+/*
+** Synchronizes the result file, then replaces the checkpoint file.
+** Returns 0 if successful, -1 otherwise.
+*/
+static int
+saveCheckpoint (
+	void
+) {
+	char temporaryName[1024];
+	FILE* file = NULL;
+	unsigned long line = 0;
+
+	if (fflush(results) != 0 || fsync(fileno(results)) < 0) {
+		perror("results");
+		return -1;
+	}
+
+	if (strlen(checkpointName) + 5 > sizeof(temporaryName)) {
+		fprintf(stderr, "%s: name too long\n", checkpointName);
+		return -1;
+	}
+
+	sprintf(temporaryName, "%s.tmp", checkpointName);
+
+	if ((file = fopen(temporaryName, "w")) == NULL) {
+		perror(temporaryName);
+		return -1;
+	}
+
+	fprintf(file, "rrpRenew checkpoint 1\nbase %lu\nreserved %lu\n",
+		progress.base, progress.reserved);
+
+	for (line = progress.base; line < progress.reserved &&
+		line < progress.base + RENEW_SPAN; line++) {
+		if (progress.span[line % RENEW_SPAN] == RENEW_DONE) {
+			fprintf(file, "done %lu\n", line);
+		}
+	}
+
+	if (fflush(file) != 0 || fsync(fileno(file)) < 0 || fclose(file) != 0 ||
+		rename(temporaryName, checkpointName) < 0) {
+		perror(checkpointName);
+		return -1;
+	}
+
+	/*
+	** Until its directory is synchronized, the rename can be lost in a
+	** crash and the old checkpoint, with fewer records reserved, return
+	*/
+	if (syncCheckpointDirectory() < 0) {
+		perror(checkpointName);
+		return -1;
+	}
+
+	progress.changed = 0;
+
+	return 0;
+
+} /* saveCheckpoint() */
+
+
+/*
+** Synchronizes the directory of the checkpoint file, so that the file
+** last renamed to it survives a crash. Returns 0 if successful, -1
+** otherwise
+*/
+static int
+syncCheckpointDirectory (
+	void
+) {
+	char directoryName[1024];
+	char* slash = NULL;
+	int descriptor = -1;
+	int result = 0;
+
+	strcpy(directoryName, checkpointName);
+	slash = strrchr(directoryName, '/');
+	if (slash == NULL) {
+		strcpy(directoryName, ".");
+	}
+	else {
+		slash[slash == directoryName ? 1 : 0] = '\0';
+	}
+
+	descriptor = open(directoryName, O_RDONLY);
+	if (descriptor < 0 || fsync(descriptor) < 0) {
+		result = -1;
+	}
+
+	if (descriptor >= 0) {
+		close(descriptor);
+	}
+
+	return result;
+
+} /* syncCheckpointDirectory() */
+
+
+/*
+** Completion function of the Renew commands: writes the result line and
+** releases the slot
+*/
+static void
+completeRenew (
+	RRPREQUEST* request,
+	RRPRESPONSE* response,
+	void* context
+) {
+	RENEWSLOT* slot = (RENEWSLOT*) context;
+
+	if (response != NULL) {
+		fprintf(results, "%s,%d\n", slot->name, response->code);
+
+		if (response->code / 100 == 2) {
+			renewed++;
+		}
+		else {
+			refused++;
+		}
+
+		RRPFreeResponse(response);
+		markDone(slot->line);
+	}
+	else {
+		/*
+		** The command may or may not have reached the server: leave the
+		** record pending so that the next run deals with it
+		*/
+		failed++;
+	}
+
+	slot->next = freeSlots;
+	freeSlots = slot;
+	inFlight--;
+
+} /* completeRenew() */
@@ -0,0 +1,1080 @@
+/* ===========================================================================
+ * Copyright (C) 2000 VeriSign, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * VeriSign Global Registry Service
+ * 21345 Ridgetop Circle
+ * Dulles, VA 20166
+ * ===========================================================================
+ * The RRP, APIs and Software are provided "as-is" and without any warranty
+ * of any kind.  NSI EXPRESSLY DISCLAIMS ALL WARRANTIES AND/OR CONDITIONS,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * AND CONDITIONS OF MERCHANTABILITY OR SATISFACTORY QUALITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE AND NONINFRINGEMENT OF THIRD PARTY RIGHTS.  NSI DOES
+ * NOT WARRANT THAT THE FUNCTIONS CONTAINED IN THE RRP, APIs OR SOFTWARE
+ * WILL MEET REGISTRAR'S REQUIREMENTS, OR THAT THE OPERATION OF THE RRP,
+ * APIs OR SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE,OR THAT DEFECTS IN
+ * THE RRP, APIs OR SOFTWARE WILL BE CORRECTED.  FURTHERMORE, NSI DOES NOT
+ * WARRANT NOR MAKE ANY REPRESENTATIONS REGARDING THE USE OR THE RESULTS OF
+ * THE RRP, APIs, SOFTWARE OR RELATED DOCUMENTATION IN TERMS OF THEIR
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR OTHERWISE.  SHOULD THE RRP, APIs
+ * OR SOFTWARE PROVE DEFECTIVE, REGISTRAR ASSUMES THE ENTIRE COST OF ALL
+ * NECESSARY SERVICING, REPAIR OR CORRECTION.
+ * ======================================================================== */
+
+/*
+**
+** Module Name: rrpResultSet.c
+**
+** Version: 2.1 for RRP version 2.1.0
+**
+** Date: Oct. 19th, 2026
+**
+** Description: rrpResultSet provides a compact container for the
+**              results of many Check or Status commands (e.g. a sweep
+**              of a large list of domain names). Rather than keeping one
+**              RRPRESPONSE structure per command, each result is stored
+**              as one row of a set of parallel arrays (columns):
+**
+**                - the RRP response code
+**                - a bit mask of the domain's statuses. Each distinct
+**                  status string is stored once, and is identified by
+**                  its bit number (see RRPGetResultSetStatusBit())
+**                - the registration expiration date
+**                - the offset of the domain or name server name in a
+**                  single heap of NUL terminated strings
+**
+**              Each column can be accessed by row index, and the whole
+**              result set can be written to a CSV or binary file with a
+**              single sequential write.
+**
+**              In the event of an internal error (bad parameter, memory
+**              allocation error, etc.) each function will return a
+**              value indicating that an error has occured (see function
+**              descriptions below). An internal error code that
+**              identifies the error will be set. The error code can
+**              be accessed and interpreted by the functions defined in
+**              rrpInternalError.h (see API documentation)
+**
+** Entry Points:
+**
+**    RRPCreateResultSet(int);
+**    RRPAddResultSetRow(RRPRESULTSET*, char*, RRPRESPONSE*);
+**    RRPGetResultSetSize(RRPRESULTSET*);
+**    RRPGetResultSetName(RRPRESULTSET*, int);
+**    RRPGetResultSetCode(RRPRESULTSET*, int);
+**    RRPGetResultSetStatuses(RRPRESULTSET*, int);
+**    RRPGetResultSetExpiration(RRPRESULTSET*, int);
+**    RRPGetResultSetStatusBit(RRPRESULTSET*, char*);
+**    RRPGetResultSetStatusName(RRPRESULTSET*, int);
+**    RRPWriteResultSetCSV(RRPRESULTSET*, char*);
+**    RRPWriteResultSetBinary(RRPRESULTSET*, char*);
+**    RRPClearResultSet(RRPRESULTSET*);
+**    RRPFreeResultSet(RRPRESULTSET*);
+**
+** Changes:
+**
+*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+#include "rrpResultSet.h"
+#include "rrpAPI.h"
+#include "rrpInternalError.h"
+
+
+/*
+** Functions used internally to grow the columns of a result set and
+** to write a file
+*/
+static int growResultSetRows (RRPRESULTSET*, int);
+static int growResultSetNames (RRPRESULTSET*, size_t);
+static int internResultSetStatus (RRPRESULTSET*, char*);
+static int writeResultSetFile (char*, struct iovec*, int);
+
+
+
+
+/*
+**
+** Function: RRPCreateResultSet
+**
+** Description: Allocates memory for and returns a pointer to an empty
+**              RRPRESULTSET structure
+**
+** Input: int - the number of rows to allocate memory for initially.
+**              The result set grows as needed, so this is only a hint
+**
+** Output: none
+**
+** Return: RRPRESULTSET* - a pointer to an allocated RRPRESULTSET
+**         structure. NULL is returned if an internal error occurs.
+**
+** Note:   THE POINTER RETURNED MUST BE PASSED TO RRPFreeResultSet() IN
+**         ORDER TO FREE THE MEMORY ALLOCATED UPON CREATION OF STRUCTURE.
+*/
+
+RRPRESULTSET*
+RRPCreateResultSet (
+	int capacity
+) {
+	RRPRESULTSET* resultSet = NULL;
+
+	/*
+	** Allocate memory for new RRPRESULTSET structure
+	*/
+	resultSet = (RRPRESULTSET*) calloc(1, sizeof(RRPRESULTSET));
+
+	if (resultSet == NULL) {
+		RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
+		return NULL;
+	}
+
+	if (capacity < 16) {
+		capacity = 16;
+	}
+
+	if (growResultSetRows(resultSet, capacity) < 0) {
+		RRPFreeResultSet(resultSet);
+		return NULL;
+	}
+
+	return resultSet;
+
+} /* RRPCreateResultSet */
+
+
+
+
+
+
+/*
+**
+** Function: RRPAddResultSetRow
+**
+** Description: Appends the result of one command to a result set. The
+**              response code, statuses and expiration date are copied
+**              from the response; the response itself is not kept and
+**              may be freed as soon as this function returns
+**
+** Input: RRPRESULTSET* - a pointer to an RRPRESULTSET structure
+**        char* - the domain or name server name the command was for
+**        RRPRESPONSE* - the response to the command. NULL indicates
+**                       that the command failed with an internal error
+**
+** Output: none
+**
+** Return: int - the row index of the new row. Returns -1 if an internal
+**               error occurs (RRP_LIMIT_EXCEEDED_ERROR if the response
+**               would bring the number of distinct statuses above
+**               RRP_MAX_RESULT_STATUSES), in which case the rows and
+**               statuses of the result set are left unchanged
+**
+*/
+
+int
+RRPAddResultSetRow (
+	RRPRESULTSET* resultSet,
+	char* name,
+	RRPRESPONSE* response
+) {
+	RRPVECTOR* values = NULL;
+	unsigned int statuses = 0;
+	time_t expiration = (time_t) -1;
+	size_t nameSize = 0;
+	int statusCount = 0;
+	int bit = 0;
+	int i = 0;
+	int row = 0;
+
+	/*
+	** Validate parameters
+	*/
+	if (resultSet == NULL || name == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	/*
+	** Make room for the row first, so that nothing but the capacity of
+	** the result set changes if it can not be stored
+	*/
+	nameSize = strlen(name) + 1;
+
+	if (resultSet->count == resultSet->capacity &&
+		growResultSetRows(resultSet, resultSet->capacity * 2) < 0) {
+		return -1;
+	}
+
+	if (growResultSetNames(resultSet, nameSize) < 0) {
+		return -1;
+	}
+
+	if (response != NULL && response->attributes != NULL) {
+		if (RRPContainsProperty(response->attributes, "status")) {
+			values = RRPGetProperty(response->attributes, "status");
+			statusCount = resultSet->statusCount;
+
+			for (i = 0; i < RRPGetVectorSize(values); i++) {
+				bit = internResultSetStatus(resultSet,
+					RRPGetVectorElementAt(values, i));
+				if (bit < 0) {
+					/*
+					** Forget the statuses this row added
+					*/
+					while (resultSet->statusCount > statusCount) {
+						free(resultSet->statusNames[--resultSet->statusCount]);
+						resultSet->statusNames[resultSet->statusCount] = NULL;
+					}
+					return -1;
+				}
+				statuses |= 1U << bit;
+			}
+		}
+
+		if (RRPContainsProperty(response->attributes,
+			"registration expiration date")) {
+			expiration = RRPGetExpirationDate(response);
+		}
+	}
+
+	row = resultSet->count++;
+
+	resultSet->codes[row] = (response != NULL) ? response->code : -1;
+	resultSet->statuses[row] = statuses;
+	resultSet->expirations[row] = expiration;
+	resultSet->names[row] = resultSet->nameHeapSize;
+
+	memcpy(resultSet->nameHeap + resultSet->nameHeapSize, name, nameSize);
+	resultSet->nameHeapSize += nameSize;
+
+	return row;
+
+} /* RRPAddResultSetRow */
+
+
+
+
+
+
+/*
+**
+** Function: RRPGetResultSetSize
+**
+** Description: Returns the number of rows in a result set
+**
+** Input: RRPRESULTSET* - a pointer to an RRPRESULTSET structure
+**
+** Output: none
+**
+** Return: int - the number of rows. Returns -1 if an internal error
+**               occurs
+**
+*/
+
+int
+RRPGetResultSetSize (
+	RRPRESULTSET* resultSet
+) {
+	/*
+	** Validate parameters
+	*/
+	if (resultSet == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	return resultSet->count;
+
+} /* RRPGetResultSetSize */
+
+
+
+
+
+
+/*
+**
+** Function: RRPGetResultSetName
+**
+** Description: Returns the domain or name server name of a row
+**
+** Input: RRPRESULTSET* - a pointer to an RRPRESULTSET structure
+**        int - row index
+**
+** Output: none
+**
+** Return: char* - the name. The string belongs to the result set and
+**                 must not be freed. Returns NULL if an internal error
+**                 occurs
+**
+*/
+
+char*
+RRPGetResultSetName (
+	RRPRESULTSET* resultSet,
+	int row
+) {
+	/*
+	** Validate parameters
+	*/
+	if (resultSet == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return NULL;
+	}
+	else if (row < 0 || row >= resultSet->count) {
+		RRPSetInternalErrorCode(RRP_INVALID_VECTOR_INDEX_ERROR);
+		return NULL;
+	}
+
+	return resultSet->nameHeap + resultSet->names[row];
+
+} /* RRPGetResultSetName */
+
+
+
+
+
+
+/*
+**
+** Function: RRPGetResultSetCode
+**
+** Description: Returns the RRP response code of a row
+**
+** Input: RRPRESULTSET* - a pointer to an RRPRESULTSET structure
+**        int - row index
+**
+** Output: none
+**
+** Return: int - the response code, or -1 if the command failed with
+**               an internal error. Also returns -1 if an internal error
+**               occurs
+**
+*/
+
+int
+RRPGetResultSetCode (
+	RRPRESULTSET* resultSet,
+	int row
+) {
+	/*
+	** Validate parameters
+	*/
+	if (resultSet == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+	else if (row < 0 || row >= resultSet->count) {
+		RRPSetInternalErrorCode(RRP_INVALID_VECTOR_INDEX_ERROR);
+		return -1;
+	}
+
+	return resultSet->codes[row];
+
+} /* RRPGetResultSetCode */
+
+
+
+
+
+
+/*
+**
+** Function: RRPGetResultSetStatuses
+**
+** Description: Returns the status bit mask of a row. Bit n is set if
+**              the response contained the status returned by
+**              RRPGetResultSetStatusName() for n
+**
+** Input: RRPRESULTSET* - a pointer to an RRPRESULTSET structure
+**        int - row index
+**
+** Output: none
+**
+** Return: unsigned int - the status bit mask. Returns 0 if an internal
+**                        error occurs
+**
+*/
+
+unsigned int
+RRPGetResultSetStatuses (
+	RRPRESULTSET* resultSet,
+	int row
+) {
+	/*
+	** Validate parameters
+	*/
+	if (resultSet == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return 0;
+	}
+	else if (row < 0 || row >= resultSet->count) {
+		RRPSetInternalErrorCode(RRP_INVALID_VECTOR_INDEX_ERROR);
+		return 0;
+	}
+
+	return resultSet->statuses[row];
+
+} /* RRPGetResultSetStatuses */
+
+
+
+
+
+
+/*
+**
+** Function: RRPGetResultSetExpiration
+**
+** Description: Returns the registration expiration date of a row
+**
+** Input: RRPRESULTSET* - a pointer to an RRPRESULTSET structure
+**        int - row index
+**
+** Output: none
+**
+** Return: time_t - the expiration date. Returns (time_t) -1 if the
+**                  response had no expiration date or if an internal
+**                  error occurs
+**
+*/
+
+time_t
+RRPGetResultSetExpiration (
+	RRPRESULTSET* resultSet,
+	int row
+) {
+	/*
+	** Validate parameters
+	*/
+	if (resultSet == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return (time_t) -1;
+	}
+	else if (row < 0 || row >= resultSet->count) {
+		RRPSetInternalErrorCode(RRP_INVALID_VECTOR_INDEX_ERROR);
+		return (time_t) -1;
+	}
+
+	return resultSet->expirations[row];
+
+} /* RRPGetResultSetExpiration */
+
+
+
+
+
+
+/*
+**
+** Function: RRPGetResultSetStatusBit
+**
+** Description: Returns the bit number that identifies a status in the
+**              status bit masks of a result set
+**
+** Input: RRPRESULTSET* - a pointer to an RRPRESULTSET structure
+**        char* - a status (e.g. "ACTIVE")
+**
+** Output: none
+**
+** Return: int - the bit number. Returns -1 if no row has the status or
+**               if an internal error occurs
+**
+*/
+
+int
+RRPGetResultSetStatusBit (
+	RRPRESULTSET* resultSet,
+	char* status
+) {
+	int bit = 0;
+
+	/*
+	** Validate parameters
+	*/
+	if (resultSet == NULL || status == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	for (bit = 0; bit < resultSet->statusCount; bit++) {
+		if (strcmp(resultSet->statusNames[bit], status) == 0) {
+			return bit;
+		}
+	}
+
+	return -1;
+
+} /* RRPGetResultSetStatusBit */
+
+
+
+
+
+
+/*
+**
+** Function: RRPGetResultSetStatusName
+**
+** Description: Returns the status identified by a bit number in the
+**              status bit masks of a result set
+**
+** Input: RRPRESULTSET* - a pointer to an RRPRESULTSET structure
+**        int - bit number
+**
+** Output: none
+**
+** Return: char* - the status. The string belongs to the result set and
+**                 must not be freed. Returns NULL if the bit is not used
+**                 or if an internal error occurs
+**
+*/
+
+char*
+RRPGetResultSetStatusName (
+	RRPRESULTSET* resultSet,
+	int bit
+) {
+	/*
+	** Validate parameters
+	*/
+	if (resultSet == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return NULL;
+	}
+
+	if (bit < 0 || bit >= resultSet->statusCount) {
+		return NULL;
+	}
+
+	return resultSet->statusNames[bit];
+
+} /* RRPGetResultSetStatusName */
+
+
+
+
+
+
+/*
+**
+** Function: RRPWriteResultSetCSV
+**
+** Description: Writes a result set to a file as comma separated values,
+**              one line per row: name, response code, statuses
+**              (separated by spaces) and expiration date
+**              ("yyyy-mm-dd hh:mm:ss", GMT, empty if none). The whole
+**              file is formatted in memory and written at once
+**
+** Input: RRPRESULTSET* - a pointer to an RRPRESULTSET structure
+**        char* - the name of the file to create (or replace)
+**
+** Output: none
+**
+** Return: int - returns 0 if successful. Returns -1 if an internal
+**               error occurs
+**
+*/
+
+int
+RRPWriteResultSetCSV (
+	RRPRESULTSET* resultSet,
+	char* fileName
+) {
+	size_t statusSizes[RRP_MAX_RESULT_STATUSES];
+	struct iovec iov;
+	struct tm* date = NULL;
+	char* text = NULL;
+	char* line = NULL;
+	size_t textSize = 0;
+	unsigned int statuses = 0;
+	int separator = 0;
+	int result = 0;
+	int bit = 0;
+	int row = 0;
+
+	/*
+	** Validate parameters
+	*/
+	if (resultSet == NULL || fileName == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	/*
+	** Work out the exact size of the file so that it can be formatted
+	** in a single buffer: the names, plus at most 11 characters for
+	** the code, 19 for the date and 3 commas and a newline per row,
+	** plus each status and its separator
+	*/
+	for (bit = 0; bit < resultSet->statusCount; bit++) {
+		statusSizes[bit] = strlen(resultSet->statusNames[bit]) + 1;
+	}
+
+	textSize = resultSet->nameHeapSize + resultSet->count * (11 + 19 + 4) + 1;
+
+	for (row = 0; row < resultSet->count; row++) {
+		for (statuses = resultSet->statuses[row], bit = 0; statuses != 0;
+			statuses >>= 1, bit++) {
+			if (statuses & 1U) {
+				textSize += statusSizes[bit];
+			}
+		}
+	}
+
+	if ((text = (char*) malloc(textSize)) == NULL) {
+		RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
+		return -1;
+	}
+
+	line = text;
+
+	for (row = 0; row < resultSet->count; row++) {
+		line += sprintf(line, "%s,%d,", resultSet->nameHeap +
+			resultSet->names[row], resultSet->codes[row]);
+
+		separator = 0;
+		for (statuses = resultSet->statuses[row], bit = 0; statuses != 0;
+			statuses >>= 1, bit++) {
+			if (statuses & 1U) {
+				if (separator) {
+					*line++ = ' ';
+				}
+				memcpy(line, resultSet->statusNames[bit], statusSizes[bit] - 1);
+				line += statusSizes[bit] - 1;
+				separator = 1;
+			}
+		}
+		*line++ = ',';
+
+		if (resultSet->expirations[row] != (time_t) -1 &&
+			(date = gmtime(&resultSet->expirations[row])) != NULL) {
+			line += strftime(line, 20, "%Y-%m-%d %H:%M:%S", date);
+		}
+		*line++ = '\n';
+	}
+
+	iov.iov_base = text;
+	iov.iov_len = line - text;
+
+	result = writeResultSetFile(fileName, &iov, 1);
+
+	free(text);
+
+	return result;
+
+} /* RRPWriteResultSetCSV */
+
+
+
+
+
+
+/*
+**
+** Function: RRPWriteResultSetBinary
+**
+** Description: Writes a result set to a file in binary form with a
+**              single gathering write. The file contains, in order:
+**
+**                - the 8 characters "RRPRSET1"
+**                - the number of rows and the number of statuses (int)
+**                - the size of the status heap and of the name heap
+**                  (size_t)
+**                - the status heap: the NUL terminated statuses, in
+**                  bit number order
+**                - the codes, statuses, expirations and names columns
+**                  (int, unsigned int, time_t and size_t arrays)
+**                - the name heap
+**
+**              All numbers are in the native size and byte order of
+**              the host that wrote the file
+**
+** Input: RRPRESULTSET* - a pointer to an RRPRESULTSET structure
+**        char* - the name of the file to create (or replace)
+**
+** Output: none
+**
+** Return: int - returns 0 if successful. Returns -1 if an internal
+**               error occurs
+**
+*/
+
+int
+RRPWriteResultSetBinary (
+	RRPRESULTSET* resultSet,
+	char* fileName
+) {
+	struct iovec iov[9];
+	int counts[2];
+	size_t sizes[2];
+	char* statusHeap = NULL;
+	size_t statusSize = 0;
+	int result = 0;
+	int bit = 0;
+
+	/*
+	** Validate parameters
+	*/
+	if (resultSet == NULL || fileName == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	/*
+	** Pack the statuses into a heap of their own
+	*/
+	for (bit = 0; bit < resultSet->statusCount; bit++) {
+		statusSize += strlen(resultSet->statusNames[bit]) + 1;
+	}
+
+	if ((statusHeap = (char*) malloc(statusSize + 1)) == NULL) {
+		RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
+		return -1;
+	}
+
+	for (statusSize = 0, bit = 0; bit < resultSet->statusCount; bit++) {
+		strcpy(statusHeap + statusSize, resultSet->statusNames[bit]);
+		statusSize += strlen(resultSet->statusNames[bit]) + 1;
+	}
+
+	counts[0] = resultSet->count;
+	counts[1] = resultSet->statusCount;
+	sizes[0] = statusSize;
+	sizes[1] = resultSet->nameHeapSize;
+
+	iov[0].iov_base = "RRPRSET1";
+	iov[0].iov_len = 8;
+	iov[1].iov_base = (char*) counts;
+	iov[1].iov_len = sizeof counts;
+	iov[2].iov_base = (char*) sizes;
+	iov[2].iov_len = sizeof sizes;
+	iov[3].iov_base = statusHeap;
+	iov[3].iov_len = statusSize;
+	iov[4].iov_base = (char*) resultSet->codes;
+	iov[4].iov_len = resultSet->count * sizeof(int);
+	iov[5].iov_base = (char*) resultSet->statuses;
+	iov[5].iov_len = resultSet->count * sizeof(unsigned int);
+	iov[6].iov_base = (char*) resultSet->expirations;
+	iov[6].iov_len = resultSet->count * sizeof(time_t);
+	iov[7].iov_base = (char*) resultSet->names;
+	iov[7].iov_len = resultSet->count * sizeof(size_t);
+	iov[8].iov_base = resultSet->nameHeap;
+	iov[8].iov_len = resultSet->nameHeapSize;
+
+	result = writeResultSetFile(fileName, iov, 9);
+
+	free(statusHeap);
+
+	return result;
+
+} /* RRPWriteResultSetBinary */
+
+
+
+
+
+
+/*
+**
+** Function: RRPClearResultSet
+**
+** Description: Removes all of the rows (and statuses) of a result set.
+**              The memory allocated for the columns is kept for reuse
+**
+** Input: RRPRESULTSET* - a pointer to an RRPRESULTSET structure
+**
+** Output: none
+**
+** Return: int - returns 0 if successful. Returns -1 if an internal
+**               error occurs
+**
+*/
+
+int
+RRPClearResultSet (
+	RRPRESULTSET* resultSet
+) {
+	int bit = 0;
+
+	/*
+	** Validate parameters
+	*/
+	if (resultSet == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	for (bit = 0; bit < resultSet->statusCount; bit++) {
+		free(resultSet->statusNames[bit]);
+		resultSet->statusNames[bit] = NULL;
+	}
+
+	resultSet->statusCount = 0;
+	resultSet->count = 0;
+	resultSet->nameHeapSize = 0;
+
+	return 0;
+
+} /* RRPClearResultSet */
+
+
+
+
+
+
+/*
+**
+** Function: RRPFreeResultSet
+**
+** Description: Frees all memory allocated for a result set
+**
+** Input: RRPRESULTSET* - a pointer to an RRPRESULTSET structure
+**
+** Output: none
+**
+** Return: int - returns 0 if successful. Returns -1 if an internal
+**               error occurs
+**
+*/
+
+int
+RRPFreeResultSet (
+	RRPRESULTSET* resultSet
+) {
+	/*
+	** Validate parameters
+	*/
+	if (resultSet == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	RRPClearResultSet(resultSet);
+
+	free(resultSet->codes);
+	free(resultSet->statuses);
+	free(resultSet->expirations);
+	free(resultSet->names);
+	free(resultSet->nameHeap);
+	free(resultSet);
+
+	return 0;
+
+} /* RRPFreeResultSet */
+
+
+
+
+
+
+/*
+** FOR INTERNAL USE
+**
+** Grows the columns of a result set to hold 'capacity' rows. Returns 0
+** if successful. Returns -1 and sets the error code if memory can not
+** be allocated; the rows already in the result set are kept.
+*/
+static int
+growResultSetRows (
+	RRPRESULTSET* resultSet,
+	int capacity
+) {
+	void* column = NULL;
+
+	if ((column = realloc(resultSet->codes, capacity * sizeof(int))) == NULL) {
+		RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
+		return -1;
+	}
+	resultSet->codes = (int*) column;
+
+	if ((column = realloc(resultSet->statuses,
+		capacity * sizeof(unsigned int))) == NULL) {
+		RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
+		return -1;
+	}
+	resultSet->statuses = (unsigned int*) column;
+
+	if ((column = realloc(resultSet->expirations,
+		capacity * sizeof(time_t))) == NULL) {
+		RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
+		return -1;
+	}
+	resultSet->expirations = (time_t*) column;
+
+	if ((column = realloc(resultSet->names,
+		capacity * sizeof(size_t))) == NULL) {
+		RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
+		return -1;
+	}
+	resultSet->names = (size_t*) column;
+
+	resultSet->capacity = capacity;
+
+	return 0;
+
+} /* growResultSetRows */
+
+
+
+
+
+
+/*
+** FOR INTERNAL USE
+**
+** Makes sure that the name heap of a result set has room for 'size'
+** more bytes. Returns 0 if successful. Returns -1 and sets the error
+** code if memory can not be allocated.
+*/
+static int
+growResultSetNames (
+	RRPRESULTSET* resultSet,
+	size_t size
+) {
+	size_t capacity = resultSet->nameHeapCapacity;
+	char* heap = NULL;
+
+	if (resultSet->nameHeapSize + size <= capacity) {
+		return 0;
+	}
+
+	if (capacity == 0) {
+		capacity = resultSet->capacity * 32;
+	}
+	while (resultSet->nameHeapSize + size > capacity) {
+		capacity *= 2;
+	}
+
+	if ((heap = (char*) realloc(resultSet->nameHeap, capacity)) == NULL) {
+		RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
+		return -1;
+	}
+
+	resultSet->nameHeap = heap;
+	resultSet->nameHeapCapacity = capacity;
+
+	return 0;
+
+} /* growResultSetNames */
+
+
+
+
+
+
+/*
+** FOR INTERNAL USE
+**
+** Returns the bit number of a status, adding the status to the result
+** set if it is new. Returns -1 and sets the error code if the status
+** can not be added.
+*/
+static int
+internResultSetStatus (
+	RRPRESULTSET* resultSet,
+	char* status
+) {
+	int bit = 0;
+
+	if (status == NULL) {
+		return -1;
+	}
+
+	if ((bit = RRPGetResultSetStatusBit(resultSet, status)) >= 0) {
+		return bit;
+	}
+
+	if (resultSet->statusCount == RRP_MAX_RESULT_STATUSES) {
+		RRPSetInternalErrorCode(RRP_LIMIT_EXCEEDED_ERROR);
+		return -1;
+	}
+
+	if ((resultSet->statusNames[resultSet->statusCount] = strdup(status))
+		== NULL) {
+		RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
+		return -1;
+	}
+
+	return resultSet->statusCount++;
+
+} /* internResultSetStatus */
+
+
+
+
+
+
+/*
+** FOR INTERNAL USE
+**
+** Creates (or replaces) a file and writes a list of buffers to it.
+** Returns 0 if successful. Returns -1 and sets the error code if an
+** error occurs.
+*/
+static int
+writeResultSetFile (
+	char* fileName,
+	struct iovec* iov,
+	int iovCount
+) {
+	ssize_t written = 0;
+	int fd = -1;
+
+	if ((fd = open(fileName, O_WRONLY | O_CREAT | O_TRUNC, 0644)) < 0) {
+		RRPSetInternalErrorCode(RRP_IO_ERROR);
+		return -1;
+	}
+
+	/*
+	** writev() may write less than everything; carry on from where it
+	** stopped
+	*/
+	while (iovCount > 0) {
+		if ((written = writev(fd, iov, iovCount)) < 0) {
+			close(fd);
+			RRPSetInternalErrorCode(RRP_IO_ERROR);
+			return -1;
+		}
+
+		while (iovCount > 0 && (size_t) written >= iov->iov_len) {
+			written -= iov->iov_len;
+			iov++;
+			iovCount--;
+		}
+
+		if (iovCount > 0) {
+			iov->iov_base = (char*) iov->iov_base + written;
+			iov->iov_len -= written;
+		}
+	}
+
+	if (close(fd) < 0) {
+		RRPSetInternalErrorCode(RRP_IO_ERROR);
+		return -1;
+	}
+
+	return 0;
+
+} /* writeResultSetFile */
@@ -0,0 +1,958 @@
+/* ===========================================================================
+ * Copyright (C) 2000 VeriSign, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * VeriSign Global Registry Service
+ * 21345 Ridgetop Circle
+ * Dulles, VA 20166
+ * ===========================================================================
+ * The RRP, APIs and Software are provided "as-is" and without any warranty
+ * of any kind.  NSI EXPRESSLY DISCLAIMS ALL WARRANTIES AND/OR CONDITIONS,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * AND CONDITIONS OF MERCHANTABILITY OR SATISFACTORY QUALITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE AND NONINFRINGEMENT OF THIRD PARTY RIGHTS.  NSI DOES
+ * NOT WARRANT THAT THE FUNCTIONS CONTAINED IN THE RRP, APIs OR SOFTWARE
+ * WILL MEET REGISTRAR'S REQUIREMENTS, OR THAT THE OPERATION OF THE RRP,
+ * APIs OR SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE,OR THAT DEFECTS IN
+ * THE RRP, APIs OR SOFTWARE WILL BE CORRECTED.  FURTHERMORE, NSI DOES NOT
+ * WARRANT NOR MAKE ANY REPRESENTATIONS REGARDING THE USE OR THE RESULTS OF
+ * THE RRP, APIs, SOFTWARE OR RELATED DOCUMENTATION IN TERMS OF THEIR
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR OTHERWISE.  SHOULD THE RRP, APIs
+ * OR SOFTWARE PROVE DEFECTIVE, REGISTRAR ASSUMES THE ENTIRE COST OF ALL
+ * NECESSARY SERVICING, REPAIR OR CORRECTION.
+ * ======================================================================== */
+
+/*
+**
+** Module Name: rrpRetry.c
+**
+** Version: 2.1 for RRP version 2.1.0
+**
+** Date: Oct. 19th, 2026
+**
+** Description: rrpRetry classifies the outcome of commands and computes
+**              the delays between their attempts (see rrpRetry.h). The
+**              random delays are drawn with rand_r() from a seed kept in
+**              the progress of each command, so that no lock is needed.
+**
+** Entry Points:
+**
+**    RRPCreateRetryPolicy(int, int, int);
+**    RRPSetRetryCommand(RRPRETRYPOLICY*, RRPCOMMAND, RRPBOOLEAN);
+**    RRPGetRetryCommand(RRPRETRYPOLICY*, RRPCOMMAND);
+**    RRPSetRetryProbe(RRPRETRYPOLICY*, RRPCOMMAND, RRPBOOLEAN);
+**    RRPGetRetryProbe(RRPRETRYPOLICY*, RRPCOMMAND);
+**    RRPClassifyOutcome(RRPRESPONSE*, RRPINTERNAL_ERROR_CODE);
+**    RRPCreateProbeRequest(RRPREQUEST*);
+**    RRPResolveOutcome(RRPREQUEST*, RRPRESPONSE*, char*, time_t);
+**    RRPIsIdempotentCommand(RRPCOMMAND);
+**    RRPGetRetryDelay(RRPRETRYPOLICY*, RRPRETRYSTATE*, RRPREQUEST*,
+**        RRPRESPONSE*, RRPINTERNAL_ERROR_CODE);
+**    RRPGetBackoffDelay(RRPRETRYPOLICY*, RRPRETRYSTATE*);
+**    RRPExecuteRetryRequest(RRPRETRYPOLICY*, RRPREQUEST*);
+**    RRPFreeRetryPolicy(RRPRETRYPOLICY*);
+**
+** Changes:
+**
+** Oct. 19th, 2026: The unknown outcome of Add and Renew can be probed
+** with a Status command (RRPCreateProbeRequest(), RRPResolveOutcome()).
+** The attributes of the request are read from its text, so the
+** probe works on requests built by any entry point.
+**
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <time.h>
+#include "rrpRetry.h"
+
+/*
+** Number of commands of RRPCOMMAND
+*/
+#define RRP_RETRY_COMMANDS (RRP_TRANSFER_COMMAND + 1)
+
+struct _RRPRETRYPOLICY {
+	int attempts;               /* most attempts of a command */
+	int base;                   /* shortest delay, in milliseconds */
+	int ceiling;                /* longest delay, in milliseconds */
+	RRPBOOLEAN commands[RRP_RETRY_COMMANDS]; /* retried when the outcome
+	                                            is unknown */
+	RRPBOOLEAN probes[RRP_RETRY_COMMANDS];   /* probed when the outcome
+	                                            is unknown */
+};
+
+
+/*
+** Functions used internally by the retry policies
+*/
+static unsigned int getRetrySeed (RRPRETRYSTATE*);
+static long getProbeRequestNumber (RRPREQUEST*, const char*);
+static int isProbeSponsor (RRPRESPONSE*, char*);
+
+
+
+
+/*
+**
+** Function: RRPCreateRetryPolicy
+**
+** Description: Creates a retry policy. Only idempotent commands are
+**              retried after an unknown outcome (see
+**              RRPSetRetryCommand()), and the outcome of Add and Renew
+**              is probed (see RRPSetRetryProbe())
+**
+** Input: int - the most times a command is sent, the first one included
+**              (1 or more; 1 never retries)
+**        int - the shortest delay before a retry, in milliseconds (1 or
+**              more)
+**        int - the longest delay before a retry, in milliseconds (no
+**              less than the shortest)
+**
+** Output: none
+**
+** Return: RRPRETRYPOLICY* - a pointer to an RRPRETRYPOLICY structure.
+**                           NULL is returned if an internal error
+**                           occurs.
+**
+** Note: THE POLICY MUST BE RELEASED BY CALLING RRPFreeRetryPolicy()
+**
+*/
+
+
+RRPRETRYPOLICY*
+RRPCreateRetryPolicy (
+	int attempts,
+	int base,
+	int ceiling
+) {
+	RRPRETRYPOLICY* policy = NULL;
+	int i = 0;
+
+	/*
+	** Validate parameters
+	*/
+	if (attempts < 1 || base < 1 || ceiling < base) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return NULL;
+	}
+
+	policy = (RRPRETRYPOLICY*) malloc(sizeof(RRPRETRYPOLICY));
+	if (policy == NULL) {
+		RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
+		return NULL;
+	}
+
+	policy->attempts = attempts;
+	policy->base = base;
+	policy->ceiling = ceiling;
+
+	for (i = 0; i < RRP_RETRY_COMMANDS; i++) {
+		policy->commands[i] = RRPIsIdempotentCommand((RRPCOMMAND) i);
+		policy->probes[i] = RRPFALSE;
+	}
+	policy->probes[RRP_ADD_COMMAND] = RRPTRUE;
+	policy->probes[RRP_RENEW_COMMAND] = RRPTRUE;
+
+	return policy;
+
+} /* RRPCreateRetryPolicy */
+
+
+
+
+
+
+/*
+**
+** Function: RRPSetRetryCommand
+**
+** Description: Tells whether a command is retried after an unknown
+**              outcome, e.g. a Renew that gives the current expiration
+**              year, which the server refuses to execute twice
+**
+** Input: RRPRETRYPOLICY* - a pointer to an RRPRETRYPOLICY structure
+**        RRPCOMMAND - the command
+**        RRPBOOLEAN - RRPTRUE to retry the command
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+
+
+int
+RRPSetRetryCommand (
+	RRPRETRYPOLICY* policy,
+	RRPCOMMAND command,
+	RRPBOOLEAN retry
+) {
+	/*
+	** Validate parameters
+	*/
+	if (policy == NULL || (int) command < 0 ||
+		(int) command >= RRP_RETRY_COMMANDS) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	policy->commands[command] = retry;
+
+	return 0;
+
+} /* RRPSetRetryCommand */
+
+
+
+
+
+
+/*
+**
+** Function: RRPGetRetryCommand
+**
+** Description: Tells whether a command is retried after an unknown
+**              outcome (see RRPSetRetryCommand())
+**
+** Input: RRPRETRYPOLICY* - a pointer to an RRPRETRYPOLICY structure
+**        RRPCOMMAND - the command
+**
+** Output: none
+**
+** Return: RRPBOOLEAN - RRPTRUE if the command is retried. RRPFALSE is
+**                      also returned if an internal error occurs.
+**
+*/
+
+RRPBOOLEAN
+RRPGetRetryCommand (
+	RRPRETRYPOLICY* policy,
+	RRPCOMMAND command
+) {
+	/*
+	** Validate parameters
+	*/
+	if (policy == NULL || (int) command < 0 ||
+		(int) command >= RRP_RETRY_COMMANDS) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return RRPFALSE;
+	}
+
+	return policy->commands[command];
+
+} /* RRPGetRetryCommand */
+
+
+
+
+
+
+/*
+**
+** Function: RRPSetRetryProbe
+**
+** Description: Tells whether the unknown outcome of a command is probed
+**              with a Status command before the command is given up
+**              (see RRPResolveOutcome()). Only Add and Renew can be
+**              probed, and are by default
+**
+** Input: RRPRETRYPOLICY* - a pointer to an RRPRETRYPOLICY structure
+**        RRPCOMMAND - the command
+**        RRPBOOLEAN - RRPTRUE to probe the command
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs or if the command can not be
+**               probed.
+**
+*/
+
+
+int
+RRPSetRetryProbe (
+	RRPRETRYPOLICY* policy,
+	RRPCOMMAND command,
+	RRPBOOLEAN probe
+) {
+	/*
+	** Validate parameters
+	*/
+	if (policy == NULL || (int) command < 0 ||
+		(int) command >= RRP_RETRY_COMMANDS ||
+		(probe && command != RRP_ADD_COMMAND &&
+		command != RRP_RENEW_COMMAND)) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	policy->probes[command] = probe;
+
+	return 0;
+
+} /* RRPSetRetryProbe */
+
+
+
+
+
+
+/*
+**
+** Function: RRPGetRetryProbe
+**
+** Description: Tells whether the unknown outcome of a command is probed
+**              (see RRPSetRetryProbe())
+**
+** Input: RRPRETRYPOLICY* - a pointer to an RRPRETRYPOLICY structure
+**        RRPCOMMAND - the command
+**
+** Output: none
+**
+** Return: RRPBOOLEAN - RRPTRUE if the command is probed. RRPFALSE is
+**                      also returned if an internal error occurs.
+**
+*/
+
+
+RRPBOOLEAN
+RRPGetRetryProbe (
+	RRPRETRYPOLICY* policy,
+	RRPCOMMAND command
+) {
+	/*
+	** Validate parameters
+	*/
+	if (policy == NULL || (int) command < 0 ||
+		(int) command >= RRP_RETRY_COMMANDS) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return RRPFALSE;
+	}
+
+	return policy->probes[command];
+
+} /* RRPGetRetryProbe */
+
+
+
+
+
+
+/*
+**
+** Function: RRPClassifyOutcome
+**
+** Description: Classifies the outcome of a command
+**
+** Input: RRPRESPONSE* - the response of the command, or NULL if it
+**                       failed
+**        RRPINTERNAL_ERROR_CODE - the internal error code of a command
+**                                 without a response
+**
+** Output: none
+**
+** Return: RRPOUTCOME - the outcome
+**
+*/
+
+
+RRPOUTCOME
+RRPClassifyOutcome (
+	RRPRESPONSE* response,
+	RRPINTERNAL_ERROR_CODE error
+) {
+	if (response != NULL) {
+		if (response->code >= 200 && response->code < 300) {
+			return RRP_OUTCOME_SUCCEEDED;
+		}
+
+		switch (response->code) {
+			/*
+			** Command failed due to server error. Client should try
+			** again
+			*/
+			case 421:
+				return RRP_OUTCOME_REFUSED;
+
+			/*
+			** Command failed due to server error, server closing
+			** connection (420); timeout exceeded, server closing
+			** connection (520); too many sessions (521)
+			*/
+			case 420:
+			case 520:
+			case 521:
+				return RRP_OUTCOME_DISCONNECTED;
+
+			default:
+				return RRP_OUTCOME_FAILED;
+		}
+	}
+
+	switch (error) {
+		/*
+		** The request may have reached the server
+		*/
+		case RRP_IO_ERROR:
+		case RRP_TIMEOUT_ERROR:
+		case RRP_RESPONSE_FORMAT_ERROR:
+			return RRP_OUTCOME_UNKNOWN;
+
+		/*
+		** The request was not sent
+		*/
+		case RRP_NOT_CONNECTED_ERROR:
+		case RRP_SOCKET_CONNECT_ERROR:
+		case RRP_INVALID_HOST_NAME_ERROR:
+			return RRP_OUTCOME_DISCONNECTED;
+
+		default:
+			return RRP_OUTCOME_FAILED;
+	}
+
+} /* RRPClassifyOutcome */
+
+
+
+
+
+
+/*
+**
+** Function: RRPCreateProbeRequest
+**
+** Description: Creates the Status request that probes the outcome of
+**              an Add or a Renew of a domain
+**
+** Input: RRPREQUEST* - the Add or Renew request
+**
+** Output: none
+**
+** Return: RRPREQUEST* - a pointer to an allocated RRPREQUEST structure.
+**                       NULL is returned if an internal error occurs or
+**                       if the request can not be probed.
+**
+** Note: THE MEMORY ALLOCATED FOR THE RRPREQUEST STRUCTURE MUST BE
+**       RELEASED BY CALLING THE RRPFreeRequest() FUNCTION
+**
+*/
+
+
+RRPREQUEST*
+RRPCreateProbeRequest (
+	RRPREQUEST* request
+) {
+	/*
+	** Validate parameters
+	*/
+	if (request == NULL || request->entity != RRP_DOMAIN_ENTITY ||
+		(request->command != RRP_ADD_COMMAND &&
+		request->command != RRP_RENEW_COMMAND)) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return NULL;
+	}
+
+	return RRPCreateRequest(RRP_STATUS_COMMAND, RRP_DOMAIN_ENTITY,
+		request->text + request->nameOffset, request->nameLength);
+
+} /* RRPCreateProbeRequest */
+
+
+
+
+
+
+/*
+**
+** Function: RRPResolveOutcome
+**
+** Description: Tells from the response of a probe (see
+**              RRPCreateProbeRequest()) whether an Add or a Renew whose
+**              outcome was unknown was executed:
+**
+**                - an Add was executed if the domain exists, is
+**                  sponsored by the registrar and was created after the
+**                  command was sent. It was not if the domain does not
+**                  exist, belongs to another registrar or is older;
+**                - a Renew that gives the current expiration year was
+**                  executed if the domain now expires in a later year,
+**                  and was not otherwise;
+**                - a Renew that does not is never settled: the dates
+**                  of the domain cannot tell it from another change,
+**                  so its outcome stays unknown unless the domain does
+**                  not exist or belongs to another registrar.
+**
+**              The creation date of the domain is compared with the
+**              time the command was sent less RRP_PROBE_CLOCK_SKEW, so
+**              a domain the registrar created just before an Add is
+**              taken as created by it
+**
+** Input: RRPREQUEST* - the Add or Renew request
+**        RRPRESPONSE* - the response of the probe
+**        char* - the registrar's id
+**        time_t - when the request was sent
+**
+** Output: none
+**
+** Return: RRPOUTCOME - RRP_OUTCOME_SUCCEEDED if the command was
+**                      executed, RRP_OUTCOME_REFUSED if it was not and
+**                      may be sent again, RRP_OUTCOME_UNKNOWN if the
+**                      probe does not tell. RRP_OUTCOME_UNKNOWN is also
+**                      returned if an internal error occurs.
+**
+*/
+
+
+RRPOUTCOME
+RRPResolveOutcome (
+	RRPREQUEST* request,
+	RRPRESPONSE* response,
+	char* registrarID,
+	time_t sent
+) {
+	struct tm date;
+	time_t since = 0;
+	time_t changed = 0;
+	long year = 0;
+	int sponsor = 0;
+
+	/*
+	** Validate parameters
+	*/
+	if (request == NULL || response == NULL || registrarID == NULL ||
+		request->entity != RRP_DOMAIN_ENTITY ||
+		(request->command != RRP_ADD_COMMAND &&
+		request->command != RRP_RENEW_COMMAND)) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return RRP_OUTCOME_UNKNOWN;
+	}
+
+	/*
+	** Domain not found (545) or belonging to another registrar (531):
+	** sending the command again gets the server's own answer
+	*/
+	if (response->code == 545 || response->code == 531) {
+		return RRP_OUTCOME_REFUSED;
+	}
+
+	if (response->code != 200 ||
+		(sponsor = isProbeSponsor(response, registrarID)) < 0) {
+		return RRP_OUTCOME_UNKNOWN;
+	}
+
+	if (sponsor == 0) {
+		return RRP_OUTCOME_REFUSED;
+	}
+
+	since = sent - RRP_PROBE_CLOCK_SKEW;
+
+	if (request->command == RRP_ADD_COMMAND) {
+		if ((changed = RRPGetResponseDate(response, "created date")) ==
+			(time_t) -1) {
+			return RRP_OUTCOME_UNKNOWN;
+		}
+		return changed >= since ? RRP_OUTCOME_SUCCEEDED : RRP_OUTCOME_REFUSED;
+	}
+
+	/*
+	** The server renews a domain only if the year it is given is the
+	** current expiration year, so a later year means it was renewed
+	*/
+	if ((year = getProbeRequestNumber(request, "-CurrentExpirationYear")) >
+		0) {
+		if ((changed = RRPGetExpirationDate(response)) == (time_t) -1 ||
+			gmtime_r(&changed, &date) == NULL) {
+			return RRP_OUTCOME_UNKNOWN;
+		}
+		return date.tm_year + 1900L > year ?
+			RRP_OUTCOME_SUCCEEDED : RRP_OUTCOME_REFUSED;
+	}
+
+	/*
+	** Without the year, a renewal cannot be told from any other change
+	** of the domain, and the server may not even date it
+	*/
+	return RRP_OUTCOME_UNKNOWN;
+
+} /* RRPResolveOutcome */
+
+
+
+
+
+
+/*
+**
+** Function: RRPIsIdempotentCommand
+**
+** Description: Tells whether executing a command twice has the same
+**              effect as executing it once
+**
+** Input: RRPCOMMAND - the command
+**
+** Output: none
+**
+** Return: RRPBOOLEAN - RRPTRUE for Check, Describe and Status
+**
+*/
+
+
+RRPBOOLEAN
+RRPIsIdempotentCommand (
+	RRPCOMMAND command
+) {
+	switch (command) {
+		case RRP_CHECK_COMMAND:
+		case RRP_DESCRIBE_COMMAND:
+		case RRP_STATUS_COMMAND:
+			return RRPTRUE;
+
+		default:
+			return RRPFALSE;
+	}
+
+} /* RRPIsIdempotentCommand */
+
+
+
+
+
+
+/*
+**
+** Function: RRPGetRetryDelay
+**
+** Description: Counts a failed attempt of a command, and tells whether
+**              and when to send it again
+**
+** Input: RRPRETRYPOLICY* - a pointer to an RRPRETRYPOLICY structure
+**        RRPRETRYSTATE* - the progress of the command, zeroed before
+**                         it is first sent
+**        RRPREQUEST* - the request
+**        RRPRESPONSE* - its response, or NULL if it failed
+**        RRPINTERNAL_ERROR_CODE - the internal error code of a request
+**                                 without a response
+**
+** Output: RRPRETRYSTATE* - the progress, updated
+**
+** Return: int - the time to wait before sending the request again, in
+**               milliseconds, or 0 if it must not be sent again. -1 is
+**               returned if an internal error occurs.
+**
+*/
+
+
+int
+RRPGetRetryDelay (
+	RRPRETRYPOLICY* policy,
+	RRPRETRYSTATE* state,
+	RRPREQUEST* request,
+	RRPRESPONSE* response,
+	RRPINTERNAL_ERROR_CODE error
+) {
+	RRPOUTCOME outcome = RRP_OUTCOME_FAILED;
+
+	/*
+	** Validate parameters
+	*/
+	if (policy == NULL || state == NULL || request == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	outcome = RRPClassifyOutcome(response, error);
+
+	if (outcome == RRP_OUTCOME_SUCCEEDED || outcome == RRP_OUTCOME_FAILED) {
+		return 0;
+	}
+
+	if (outcome == RRP_OUTCOME_UNKNOWN &&
+		((int) request->command >= RRP_RETRY_COMMANDS ||
+		!policy->commands[request->command])) {
+		return 0;
+	}
+
+	return RRPGetBackoffDelay(policy, state);
+
+} /* RRPGetRetryDelay */
+
+
+
+
+
+
+/*
+**
+** Function: RRPGetBackoffDelay
+**
+** Description: Counts a failed attempt of an operation that is always
+**              worth trying again, such as opening a connection, and
+**              tells when to try again
+**
+** Input: RRPRETRYPOLICY* - a pointer to an RRPRETRYPOLICY structure
+**        RRPRETRYSTATE* - the progress of the operation, zeroed before
+**                         its first attempt
+**
+** Output: RRPRETRYSTATE* - the progress, updated
+**
+** Return: int - the time to wait before the next attempt, in
+**               milliseconds, or 0 once the policy's attempts are used
+**               up. -1 is returned if an internal error occurs.
+**
+*/
+
+int
+RRPGetBackoffDelay (
+	RRPRETRYPOLICY* policy,
+	RRPRETRYSTATE* state
+) {
+	unsigned int seed = 0;
+	int previous = 0;
+	int delay = 0;
+
+	/*
+	** Validate parameters
+	*/
+	if (policy == NULL || state == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	if (++state->attempts >= policy->attempts) {
+		return 0;
+	}
+
+	/*
+	** Decorrelated jitter: between the base delay and three times the
+	** previous delay
+	*/
+	previous = state->delay > policy->base ? state->delay : policy->base;
+	if (previous > policy->ceiling / 3) {
+		previous = policy->ceiling / 3 + 1;
+	}
+
+	seed = getRetrySeed(state);
+	delay = policy->base + rand_r(&seed) % (previous * 3 - policy->base + 1);
+	state->seed = seed;
+
+	if (delay > policy->ceiling) {
+		delay = policy->ceiling;
+	}
+
+	state->delay = delay;
+
+	return delay;
+
+} /* RRPGetBackoffDelay */
+
+
+
+
+
+
+/*
+**
+** Function: RRPExecuteRetryRequest
+**
+** Description: Executes a request (see RRPExecuteRequest()) and sends
+**              it again as the policy allows while the server refuses
+**              it. Failures that leave the connection unusable are not
+**              retried, since the connection is not opened again here
+**
+** Input: RRPRETRYPOLICY* - a pointer to an RRPRETRYPOLICY structure
+**        RRPREQUEST* - a pointer to an RRPREQUEST structure
+**
+** Output: none
+**
+** Return: RRPRESPONSE* - the last response. NULL is returned if an
+**                        internal error occurs.
+**
+** Note: THE MEMORY ALLOCATED FOR THE RRPRESPONSE STRUCTURE MUST BE
+**       RELEASED BY CALLING THE RRPFreeResponse() FUNCTION
+**
+*/
+
+
+RRPRESPONSE*
+RRPExecuteRetryRequest (
+	RRPRETRYPOLICY* policy,
+	RRPREQUEST* request
+) {
+	RRPRETRYSTATE state = { 0, 0, 0 };
+	RRPRESPONSE* response = NULL;
+	struct timespec pause;
+	int delay = 0;
+
+	/*
+	** Validate parameters
+	*/
+	if (policy == NULL || request == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return NULL;
+	}
+
+	for (;;) {
+		response = RRPExecuteRequest(request);
+
+		/*
+		** The connection is left as it is: a late response would be
+		** read as the response of the next request
+		*/
+		if (RRPClassifyOutcome(response, RRPGetInternalErrorCode()) !=
+			RRP_OUTCOME_REFUSED) {
+			return response;
+		}
+
+		delay = RRPGetRetryDelay(policy, &state, request, response,
+			RRP_NO_ERROR);
+		if (delay <= 0) {
+			return response;
+		}
+
+		RRPFreeResponse(response);
+
+		pause.tv_sec = delay / 1000;
+		pause.tv_nsec = (long) (delay % 1000) * 1000000;
+		nanosleep(&pause, NULL);
+	}
+
+} /* RRPExecuteRetryRequest */
+
+
+
+
+
+
+/*
+**
+** Function: RRPFreeRetryPolicy
+**
+** Description: Frees a retry policy
+**
+** Input: RRPRETRYPOLICY* - a pointer to an RRPRETRYPOLICY structure
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+
+
+int
+RRPFreeRetryPolicy (
+	RRPRETRYPOLICY* policy
+) {
+	/*
+	** Validate parameters
+	*/
+	if (policy == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	free(policy);
+
+	return 0;
+
+} /* RRPFreeRetryPolicy */
+
+
+
+
+
+
+/*
+** Returns the seed of the random number generator of a command, made
+** from the clock and the address of its progress when it is first used
+*/
+static unsigned int
+getRetrySeed (
+	RRPRETRYSTATE* state
+) {
+	struct timespec now;
+
+	if (state->seed == 0) {
+		clock_gettime(CLOCK_MONOTONIC, &now);
+		state->seed = (unsigned int) now.tv_nsec ^
+			(unsigned int) (unsigned long) state;
+		if (state->seed == 0) {
+			state->seed = 1;
+		}
+	}
+
+	return state->seed;
+
+} /* getRetrySeed() */
+
+
+
+/*
+** Returns the value of a numeric attribute of a request, such as
+** "-CurrentExpirationYear", or -1 if the request does not have it
+*/
+static long
+getProbeRequestNumber (
+	RRPREQUEST* request,
+	const char* attribute
+) {
+	size_t length = strlen(attribute);
+	char* line = request->text;
+	char* end = request->text + request->length;
+
+	while (line < end) {
+		if ((size_t) (end - line) > length + 1 &&
+			strncmp(line, attribute, length) == 0 && line[length] == ':') {
+			return strtol(line + length + 1, NULL, 10);
+		}
+
+		line = memchr(line, '\n', end - line);
+		if (line == NULL) {
+			break;
+		}
+		line++;
+	}
+
+	return -1;
+
+} /* getProbeRequestNumber() */
+
+
+
+/*
+** Tells whether the domain of a Status response is sponsored by a
+** registrar. Returns 1 if it is, 0 if it is not, -1 if the response
+** does not tell
+*/
+static int
+isProbeSponsor (
+	RRPRESPONSE* response,
+	char* registrarID
+) {
+	RRPVECTOR* values = NULL;
+	char* value = NULL;
+
+	if (response->attributes == NULL || (values = RRPGetProperty(
+		response->attributes, "registrar")) == NULL ||
+		(value = RRPGetVectorElementAt(values, 0)) == NULL) {
+		return -1;
+	}
+
+	return strcasecmp(value, registrarID) == 0 ? 1 : 0;
+
+} /* isProbeSponsor() */
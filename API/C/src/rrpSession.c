@@ -0,0 +1,3280 @@
+/* ===========================================================================
+ * Copyright (C) 2000 VeriSign, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * VeriSign Global Registry Service
+ * 21345 Ridgetop Circle
+ * Dulles, VA 20166
+ * ===========================================================================
+ * The RRP, APIs and Software are provided "as-is" and without any warranty
+ * of any kind.  NSI EXPRESSLY DISCLAIMS ALL WARRANTIES AND/OR CONDITIONS,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * AND CONDITIONS OF MERCHANTABILITY OR SATISFACTORY QUALITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE AND NONINFRINGEMENT OF THIRD PARTY RIGHTS.  NSI DOES
+ * NOT WARRANT THAT THE FUNCTIONS CONTAINED IN THE RRP, APIs OR SOFTWARE
+ * WILL MEET REGISTRAR'S REQUIREMENTS, OR THAT THE OPERATION OF THE RRP,
+ * APIs OR SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE,OR THAT DEFECTS IN
+ * THE RRP, APIs OR SOFTWARE WILL BE CORRECTED.  FURTHERMORE, NSI DOES NOT
+ * WARRANT NOR MAKE ANY REPRESENTATIONS REGARDING THE USE OR THE RESULTS OF
+ * THE RRP, APIs, SOFTWARE OR RELATED DOCUMENTATION IN TERMS OF THEIR
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR OTHERWISE.  SHOULD THE RRP, APIs
+ * OR SOFTWARE PROVE DEFECTIVE, REGISTRAR ASSUMES THE ENTIRE COST OF ALL
+ * NECESSARY SERVICING, REPAIR OR CORRECTION.
+ * ======================================================================== */
+
+/*
+**
+** Module Name: rrpSession.c
+**
+** Version: 2.1 for RRP version 2.1.0
+**
+** Date: Oct. 19th, 2026
+**
+** Description: rrpSession provides RRP sessions that can be used side by
+**              side and that pipeline their requests (see rrpSession.h).
+**
+**              Each session keeps its requests in a FIFO queue. The
+**              requests at the front of the queue have been written to
+**              the session's output buffer (and usually to the
+**              connection) and are awaiting their responses, which the
+**              server sends in the same order; the others wait until the
+**              number of requests awaiting a response falls below the
+**              session's window. Requests are copied into the output
+**              buffer one after the other so that many of them go out in
+**              a single write. A session with a governor also stops
+**              copying when the governor holds a request back, and
+**              remembers when to try again.
+**
+**              When the connection of a session that may reconnect
+**              fails, the written requests that are not to be sent
+**              again are taken out of the queue before any of them is
+**              completed, so that their completion functions find the
+**              session consistent; the rest of the queue is then
+**              written again from its head on the new connection.
+**
+**              A session opened on a set of endpoints notes when each
+**              request is written, to report the latency of its
+**              response to the set. When the breaker of its endpoint
+**              opens, it stops writing, waits for the responses to what
+**              it has written and then opens its connection again,
+**              which picks another endpoint.
+**
+** Entry Points:
+**
+**    RRPOpenSession(char*, unsigned short int, char*, char*);
+**    RRPOpenEndpointSession(RRPENDPOINTS*, char*, char*);
+**    RRPOpenBrokerSession(char*);
+**    RRPLoginConnection(RRPCONNECTION*, char*, char*);
+**    RRPSubmitSessionRequest(RRPSESSION*, RRPREQUEST*, RRPCOMPLETION,
+**        void*);
+**    RRPFlushSession(RRPSESSION*);
+**    RRPProcessSession(RRPSESSION*);
+**    RRPGetSessionDescriptor(RRPSESSION*);
+**    RRPGetSessionEvents(RRPSESSION*);
+**    RRPGetSessionPending(RRPSESSION*);
+**    RRPSetSessionWindow(RRPSESSION*, int);
+**    RRPGetSessionWindow(RRPSESSION*);
+**    RRPSetSessionGovernor(RRPSESSION*, RRPGOVERNOR*);
+**    RRPGetSessionTimeout(RRPSESSION*);
+**    RRPSetSessionReconnect(RRPSESSION*, RRPRETRYPOLICY*);
+**    RRPSetSessionJournal(RRPSESSION*, RRPJOURNAL*);
+**    RRPIsSessionOpen(RRPSESSION*);
+**    RRPCloseSession(RRPSESSION*);
+**    RRPCreateSessionPool(char*, unsigned short int, char*, char*, int);
+**    RRPCreateEndpointSessionPool(RRPENDPOINTS*, char*, char*, int);
+**    RRPCreateBrokerSessionPool(char*, int);
+**    RRPSubmitPoolRequest(RRPSESSIONPOOL*, RRPREQUEST*, RRPCOMPLETION,
+**        void*);
+**    RRPPollSessionPool(RRPSESSIONPOOL*, int);
+**    RRPRunSessionPool(RRPSESSIONPOOL*);
+**    RRPGetSessionPoolPending(RRPSESSIONPOOL*);
+**    RRPGetSessionPoolSize(RRPSESSIONPOOL*);
+**    RRPGetPoolSession(RRPSESSIONPOOL*, int);
+**    RRPSetSessionPoolWindow(RRPSESSIONPOOL*, int);
+**    RRPSetSessionPoolGovernor(RRPSESSIONPOOL*, RRPGOVERNOR*);
+**    RRPSetSessionPoolReconnect(RRPSESSIONPOOL*, RRPRETRYPOLICY*);
+**    RRPSetSessionPoolJournal(RRPSESSIONPOOL*, RRPJOURNAL*);
+**    RRPFreeSessionPool(RRPSESSIONPOOL*);
+**    RRPCheckDomains(char**, int, RRPSESSIONPOOL*, RRPCHECKRESULT*);
+**
+** Changes:
+**
+** Oct. 19th, 2026: RRPGetSessionWindow() added, so that a scheduler can
+** keep its requests out of the sessions' queues (see rrpClient.c).
+**
+** Oct. 19th, 2026: Sessions can be paced by a governor (see
+** rrpGovernor.h), and start with the process governor. A session held
+** back by its governor does not ask for POLLOUT; RRPGetSessionTimeout()
+** tells event loops when to flush it again.
+**
+** Oct. 19th, 2026: Sessions keep the address and credentials they were
+** opened with, so that a lost connection can be opened again
+** (RRPSetSessionReconnect()). A lost connection is no longer fatal
+** where breakSession() is called; failSession() still closes the
+** session for good.
+**
+** Oct. 19th, 2026: Sessions can be opened on a set of endpoints (see
+** rrpEndpoint.h) instead of a single server; connectSession() then picks
+** the server, and the session reports to the set. The bodies of
+** RRPOpenSession() and RRPCreateSessionPool() moved to openSession() and
+** createSessionPool(), which serve both kinds of session.
+**
+** Oct. 19th, 2026: Sessions can record their requests in a journal (see
+** rrpJournal.h). queueSessionRequests() records the intents and
+** RRPFlushSession() commits them before writing.
+**
+** Oct. 19th, 2026: breakSession() replaces a written Add or Renew by a
+** Status probe (see RRPResolveOutcome() in rrpRetry.h), and
+** completeSessionRequest() puts the command back in the queue if the
+** probe shows it was not executed. RRPCloseSession() completes the
+** written requests with RRP_IO_ERROR, an unknown outcome, rather than
+** RRP_NOT_CONNECTED_ERROR, which means they were never sent.
+**
+** Oct. 19th, 2026: Sessions can be opened on the local socket of a
+** session broker (see rrpBroker.c). Such a session has no credentials:
+** connectSession() opens the socket without logging in, and
+** breakSession() does not probe, since the broker's own sessions do.
+** A broker tells its clients which commands may be sent again from the
+** error code their sessions complete them with, so breakSession() and
+** failSession() no longer pass on the RRP_NOT_CONNECTED_ERROR of a
+** server that hung up to requests that were written.
+**
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <poll.h>
+#include <time.h>
+#include "rrpSession.h"
+#include "rrpConnection.h"
+#include "rrpInternalError.h"
+
+
+/*
+** A request in the queue of a session
+*/
+typedef struct _RRPPENDING  RRPPENDING;
+
+struct _RRPPENDING {
+	RRPREQUEST* request;
+	RRPCOMPLETION completion;
+	void* context;
+	struct timespec written;   /* when it was written, if the session
+	                              reports to a set of endpoints */
+	unsigned long sequence;    /* number of its intent in the session's
+	                              journal, 0 if not recorded */
+	time_t issued;             /* when it was written, by the wall clock,
+	                              if the session reconnects */
+	RRPREQUEST* probed;        /* the request whose outcome 'request', a
+	                              Status probe, settles; NULL if none */
+	RRPINTERNAL_ERROR_CODE lost; /* why the response of 'probed' was
+	                                lost */
+	RRPRETRYSTATE asked;       /* the probes of 'probed' answered by a
+	                              server error */
+	struct timespec due;       /* when the probe may be asked again */
+	RRPPENDING* next;
+};
+
+struct _RRPSESSION {
+	RRPCONNECTION* connection; /* NULL once the session is closed, or
+	                              while it is broken */
+	RRPPENDING* head;          /* oldest request */
+	RRPPENDING* unsent;        /* first request not in output buffer */
+	RRPPENDING* tail;          /* newest request */
+	int pending;               /* number of requests in queue */
+	int sent;                  /* number of requests awaiting response */
+	int window;                /* most requests awaiting response */
+	RRPGOVERNOR* governor;     /* NULL if the session is not paced */
+	RRPBOOLEAN throttled;      /* the governor held a request back, or
+	                              a probe waits to be asked again */
+	struct timespec resume;    /* when to ask the governor again */
+	char* host;                /* where to connect again, NULL if the
+	                              session uses a set of endpoints; the
+	                              path of the socket of a broker */
+	unsigned short int port;
+	RRPENDPOINTS* endpoints;
+	int endpoint;              /* index of the endpoint connected to, -1
+	                              if none */
+	RRPBOOLEAN leaving;        /* waits for its responses to leave an
+	                              endpoint whose breaker opened */
+	RRPJOURNAL* journal;       /* NULL if requests are not recorded */
+	unsigned long journaled;   /* last intent recorded */
+	unsigned long committed;   /* last intent known to be durable */
+	char* registrarID;         /* NULL if the session is opened on a
+	                              broker, which is already logged in */
+	char* registrarPassword;
+	RRPRETRYPOLICY* reconnect; /* NULL if the session is not reopened */
+	RRPBOOLEAN broken;         /* lost its connection, to be reopened */
+	RRPRETRYSTATE redials;     /* progress of the attempts to reopen */
+	struct timespec redial;    /* when to try to reopen it */
+	char* output;              /* requests not yet written */
+	size_t outputStart;
+	size_t outputLength;
+	size_t outputCapacity;
+};
+
+struct _RRPSESSIONPOOL {
+	int size;
+	RRPSESSION** sessions;
+	struct pollfd* descriptors;
+};
+
+
+/*
+** State of RRPCheckDomains(). Each Check command in flight has a slot,
+** which is reused for the next name when the command completes
+*/
+typedef struct _RRPCHECKBATCH  RRPCHECKBATCH;
+
+typedef struct {
+	RRPCHECKBATCH* batch;
+	int index;                 /* name being checked */
+} RRPCHECKSLOT;
+
+struct _RRPCHECKBATCH {
+	RRPSESSIONPOOL* pool;
+	char** names;
+	RRPCHECKRESULT* results;
+	int count;
+	int next;                  /* next name to submit */
+	int completed;             /* names checked or failed */
+	int checked;               /* names checked */
+};
+
+
+/*
+** Functions used internally to move requests to the output buffer, to
+** complete requests and to open connections
+*/
+static int queueSessionRequests (RRPSESSION*);
+static void completeSessionRequest (RRPSESSION*, RRPRESPONSE*);
+static void journalSessionOutcome (RRPSESSION*, RRPPENDING*, RRPRESPONSE*);
+static int probeSessionRequest (RRPPENDING*, RRPINTERNAL_ERROR_CODE);
+static RRPOUTCOME settleSessionProbe (RRPSESSION*, RRPPENDING*,
+	RRPRESPONSE*);
+static void failSession (RRPSESSION*, RRPINTERNAL_ERROR_CODE);
+static void breakSession (RRPSESSION*, RRPINTERNAL_ERROR_CODE);
+static int connectSession (RRPSESSION*);
+static int connectSessionEndpoint (RRPSESSION*);
+static int redialSession (RRPSESSION*);
+static void leaveSessionEndpoint (RRPSESSION*, RRPBOOLEAN);
+static void moveSession (RRPSESSION*);
+static RRPSESSION* openSession (char*, unsigned short int, RRPENDPOINTS*,
+	char*, char*);
+static RRPSESSIONPOOL* createSessionPool (char*, unsigned short int,
+	RRPENDPOINTS*, char*, char*, int);
+static void freeSessionCredentials (RRPSESSION*);
+static char* copySessionString (const char*);
+static void setSessionTime (struct timespec*, long);
+static long getSessionWait (struct timespec*);
+static long getSessionElapsed (struct timespec*);
+
+/*
+** Functions used internally by RRPCheckDomains()
+*/
+static void submitCheck (RRPCHECKSLOT*);
+static void completeCheck (RRPREQUEST*, RRPRESPONSE*, void*);
+static void abandonChecks (RRPCHECKBATCH*);
+static void discardCheck (RRPREQUEST*, RRPRESPONSE*, void*);
+
+
+
+
+/*
+**
+** Function: RRPOpenSession
+**
+** Description: Connects to an RRP server and starts an authenticated
+**              session. The session is then in non-blocking mode
+**
+** Input: char* - host name or IP address of RRP server
+**        unsigned short int - RRP server port
+**        char* - registrar's id
+**        char* - registrar's password
+**
+** Output: none
+**
+** Return: RRPSESSION* - a pointer to an RRPSESSION structure. NULL is
+**                       returned if an internal error occurs, or if the
+**                       server refuses the session
+**                       (RRP_SESSION_REFUSED_ERROR).
+**
+** Note: THE SESSION MUST BE CLOSED BY CALLING RRPCloseSession()
+**
+*/
+
+RRPSESSION*
+RRPOpenSession (
+	char* host,
+	unsigned short int port,
+	char* registrarID,
+	char* registrarPassword
+) {
+	/*
+	** Validate parameters
+	*/
+	if (host == NULL || registrarID == NULL || registrarPassword == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return NULL;
+	}
+
+	return openSession(host, port, NULL, registrarID, registrarPassword);
+
+} /* RRPOpenSession */
+
+
+
+
+
+
+/*
+**
+** Function: RRPOpenEndpointSession
+**
+** Description: Starts an authenticated session on the best of a set of
+**              RRP servers (see RRPPickEndpoint()), trying each of them
+**              in turn if need be. The session reports its connections
+**              and the latency of its commands to the set, and picks a
+**              server again whenever it opens its connection again. The
+**              session is then in non-blocking mode
+**
+** Input: RRPENDPOINTS* - the set of endpoints. It still belongs to the
+**                        caller and must outlive the session
+**        char* - registrar's id
+**        char* - registrar's password
+**
+** Output: none
+**
+** Return: RRPSESSION* - a pointer to an RRPSESSION structure. NULL is
+**                       returned if an internal error occurs, or if no
+**                       server could be connected to.
+**
+** Note: THE SESSION MUST BE CLOSED BY CALLING RRPCloseSession()
+**
+*/
+
+RRPSESSION*
+RRPOpenEndpointSession (
+	RRPENDPOINTS* endpoints,
+	char* registrarID,
+	char* registrarPassword
+) {
+	/*
+	** Validate parameters
+	*/
+	if (endpoints == NULL || registrarID == NULL ||
+		registrarPassword == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return NULL;
+	}
+
+	return openSession(NULL, 0, endpoints, registrarID, registrarPassword);
+
+} /* RRPOpenEndpointSession */
+
+
+
+
+
+
+/*
+**
+** Function: RRPOpenBrokerSession
+**
+** Description: Connects to a session broker (see rrpBroker.c) on its
+**              Unix domain socket. The broker is already logged in, so
+**              the session needs no credentials and costs no login; its
+**              requests are relayed over the broker's own sessions. The
+**              session is then in non-blocking mode and is used like
+**              any other
+**
+** Input: char* - path of the broker's socket
+**
+** Output: none
+**
+** Return: RRPSESSION* - a pointer to an RRPSESSION structure. NULL is
+**                       returned if an internal error occurs, or if no
+**                       broker listens on the socket.
+**
+** Note: THE SESSION MUST BE CLOSED BY CALLING RRPCloseSession()
+**
+*/
+
+RRPSESSION*
+RRPOpenBrokerSession (
+	char* path
+) {
+	/*
+	** Validate parameters
+	*/
+	if (path == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return NULL;
+	}
+
+	return openSession(path, 0, NULL, NULL, NULL);
+
+} /* RRPOpenBrokerSession */
+
+
+
+
+
+
+/*
+**
+** Function: RRPLoginConnection
+**
+** Description: Starts an authenticated session on a connection in
+**              blocking mode (see RRPOpenConnection())
+**
+** Input: RRPCONNECTION* - a pointer to an RRPCONNECTION structure
+**        char* - registrar's id
+**        char* - registrar's password
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs, or if the server refuses the
+**               session (RRP_SESSION_REFUSED_ERROR).
+**
+*/
+
+int
+RRPLoginConnection (
+	RRPCONNECTION* connection,
+	char* registrarID,
+	char* registrarPassword
+) {
+	RRPREQUEST* request = NULL;
+	RRPRESPONSE* response = NULL;
+	char* responseString = NULL;
+	int code = -1;
+
+	/*
+	** Validate parameters
+	*/
+	if (connection == NULL || registrarID == NULL ||
+		registrarPassword == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	request = RRPCreateRequest(RRP_SESSION_COMMAND, RRP_NO_ENTITY, NULL, 0);
+
+	if (request != NULL &&
+		RRPAppendRequestAttribute(request, "-Id", 3, registrarID,
+			strlen(registrarID)) == 0 &&
+		RRPAppendRequestAttribute(request, "-Password", 9,
+			registrarPassword, strlen(registrarPassword)) == 0 &&
+		RRPWriteConnection(connection, request->text,
+			request->length) >= 0 &&
+		(responseString = RRPReadConnectionResponse(connection)) != NULL &&
+		(response = RRPParseResponse(responseString)) != NULL) {
+		code = response->code;
+	}
+
+	if (request != NULL) {
+		RRPFreeRequest(request);
+	}
+
+	if (responseString != NULL) {
+		free(responseString);
+	}
+
+	if (response != NULL) {
+		RRPFreeResponse(response);
+	}
+
+	if (code == -1) {
+		return -1;
+	}
+
+	if (code / 100 != 2) {
+		RRPSetInternalErrorCode(RRP_SESSION_REFUSED_ERROR);
+		return -1;
+	}
+
+	return 0;
+
+} /* RRPLoginConnection */
+
+
+
+
+
+
+/*
+**
+** Function: RRPSubmitSessionRequest
+**
+** Description: Adds a request to the queue of a session. The request is
+**              sent by RRPFlushSession() once fewer than the session's
+**              window of requests are awaiting a response
+**
+** Input: RRPSESSION* - a pointer to an RRPSESSION structure
+**        RRPREQUEST* - the request. The session takes ownership of the
+**                      request if successful
+**        RRPCOMPLETION - function called with the response
+**        void* - context pointer passed to the completion function
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs or if the session is closed
+**               (RRP_NOT_CONNECTED_ERROR). The request then still
+**               belongs to the caller
+**
+*/
+
+int
+RRPSubmitSessionRequest (
+	RRPSESSION* session,
+	RRPREQUEST* request,
+	RRPCOMPLETION completion,
+	void* context
+) {
+	RRPPENDING* pending = NULL;
+
+	/*
+	** Validate parameters
+	*/
+	if (session == NULL || request == NULL || completion == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	if (session->connection == NULL && !session->broken) {
+		RRPSetInternalErrorCode(RRP_NOT_CONNECTED_ERROR);
+		return -1;
+	}
+
+	pending = (RRPPENDING*) malloc(sizeof(RRPPENDING));
+	if (pending == NULL) {
+		RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
+		return -1;
+	}
+
+	pending->request = request;
+	pending->completion = completion;
+	pending->context = context;
+	pending->sequence = 0;
+	pending->probed = NULL;
+	pending->next = NULL;
+
+	if (session->tail == NULL) {
+		session->head = pending;
+	}
+	else {
+		session->tail->next = pending;
+	}
+	session->tail = pending;
+
+	if (session->unsent == NULL) {
+		session->unsent = pending;
+	}
+
+	session->pending++;
+
+	return 0;
+
+} /* RRPSubmitSessionRequest */
+
+
+
+
+
+
+/*
+**
+** Function: RRPFlushSession
+**
+** Description: Writes as many queued requests to the connection as it
+**              accepts without blocking. A session whose connection was
+**              lost opens it again first, once that is due (see
+**              RRPSetSessionReconnect()). A session that may reconnect
+**              and whose endpoint's breaker opened writes no new request,
+**              and opens its connection again, on another endpoint, once
+**              the written ones are answered (see RRPOpenEndpointSession())
+**
+** Input: RRPSESSION* - a pointer to an RRPSESSION structure
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs. If the connection failed, the
+**               session is closed and each of its requests is completed
+**               with a NULL response, unless the connection is to be
+**               opened again (see RRPSetSessionReconnect())
+**
+*/
+
+int
+RRPFlushSession (
+	RRPSESSION* session
+) {
+	long byteCount = 0;
+
+	/*
+	** Validate parameters
+	*/
+	if (session == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	if (session->connection == NULL && !session->broken) {
+		RRPSetInternalErrorCode(RRP_NOT_CONNECTED_ERROR);
+		return -1;
+	}
+
+	/*
+	** On an endpoint whose breaker opened, stop writing, and move to
+	** another endpoint once the responses to what was written are in
+	*/
+	if (session->connection != NULL && session->endpoint >= 0 &&
+		session->reconnect != NULL && !session->leaving &&
+		!RRPIsEndpointHealthy(session->endpoints, session->endpoint)) {
+		session->leaving = RRPTRUE;
+		session->throttled = RRPFALSE;
+	}
+
+	if (session->leaving && session->sent == 0) {
+		moveSession(session);
+	}
+
+	/*
+	** A lost connection is opened again only when there is something
+	** to send
+	*/
+	if (session->connection == NULL) {
+		if (session->pending == 0 || getSessionWait(&session->redial) > 0 ||
+			redialSession(session) < 0 || session->connection == NULL) {
+			return session->broken ? 0 : -1;
+		}
+	}
+
+	if (!session->leaving && queueSessionRequests(session) < 0) {
+		return -1;
+	}
+
+	if (session->outputStart == session->outputLength) {
+		return 0;
+	}
+
+	/*
+	** Nothing recorded in the journal is written before it is durable
+	*/
+	if (session->journaled > session->committed) {
+		if (RRPCommitJournal(session->journal, session->journaled) < 0) {
+			failSession(session, RRPGetInternalErrorCode());
+			return -1;
+		}
+		session->committed = session->journaled;
+	}
+
+	byteCount = RRPWriteConnection(session->connection,
+		session->output + session->outputStart,
+		session->outputLength - session->outputStart);
+
+	if (byteCount < 0) {
+		breakSession(session, RRPGetInternalErrorCode());
+		return -1;
+	}
+
+	session->outputStart += byteCount;
+
+	if (session->outputStart == session->outputLength) {
+		session->outputStart = 0;
+		session->outputLength = 0;
+	}
+
+	return 0;
+
+} /* RRPFlushSession */
+
+
+
+
+
+
+/*
+**
+** Function: RRPProcessSession
+**
+** Description: Reads the responses that have arrived on the connection
+**              without blocking, calls the completion function of the
+**              matching requests, then sends more queued requests (see
+**              RRPFlushSession())
+**
+** Input: RRPSESSION* - a pointer to an RRPSESSION structure
+**
+** Output: none
+**
+** Return: int - the number of requests completed. -1 is returned if an
+**               internal error occurs. If the connection failed, the
+**               session is closed and each of its requests is completed
+**               with a NULL response, unless the connection is to be
+**               opened again (see RRPSetSessionReconnect())
+**
+*/
+
+int
+RRPProcessSession (
+	RRPSESSION* session
+) {
+	RRPRESPONSE* response = NULL;
+	char* responseString = NULL;
+	int completed = 0;
+	int result = 0;
+
+	/*
+	** Validate parameters
+	*/
+	if (session == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	if (session->connection == NULL) {
+		RRPSetInternalErrorCode(RRP_NOT_CONNECTED_ERROR);
+		return -1;
+	}
+
+	if (RRPFillConnection(session->connection) < 0) {
+		breakSession(session, RRPGetInternalErrorCode());
+		return -1;
+	}
+
+	while ((result = RRPNextConnectionResponse(session->connection,
+		&responseString)) > 0) {
+		/*
+		** A response to a request that was never sent means that the
+		** server and the session no longer agree on anything
+		*/
+		if (session->sent == 0) {
+			free(responseString);
+			breakSession(session, RRP_RESPONSE_FORMAT_ERROR);
+			return -1;
+		}
+
+		response = RRPParseResponse(responseString);
+		free(responseString);
+
+		completeSessionRequest(session, response);
+		completed++;
+
+		/*
+		** The completion function may have flushed the session, and
+		** the connection may have failed while doing so
+		*/
+		if (session->connection == NULL) {
+			return completed;
+		}
+	}
+
+	if (result < 0) {
+		breakSession(session, RRPGetInternalErrorCode());
+		return -1;
+	}
+
+	if (RRPFlushSession(session) < 0) {
+		return -1;
+	}
+
+	return completed;
+
+} /* RRPProcessSession */
+
+
+
+
+
+
+/*
+**
+** Function: RRPGetSessionDescriptor
+**
+** Description: Returns the file descriptor of the connection of a session
+**
+** Input: RRPSESSION* - a pointer to an RRPSESSION structure
+**
+** Output: none
+**
+** Return: int - the file descriptor. -1 is returned if an internal error
+**               occurs or if the session is closed.
+**
+*/
+
+int
+RRPGetSessionDescriptor (
+	RRPSESSION* session
+) {
+	/*
+	** Validate parameters
+	*/
+	if (session == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	if (session->connection == NULL) {
+		RRPSetInternalErrorCode(RRP_NOT_CONNECTED_ERROR);
+		return -1;
+	}
+
+	return RRPGetConnectionDescriptor(session->connection);
+
+} /* RRPGetSessionDescriptor */
+
+
+
+
+
+
+/*
+**
+** Function: RRPGetSessionEvents
+**
+** Description: Returns the poll() events a session is waiting for:
+**              POLLIN while requests are awaiting a response, and
+**              POLLOUT while requests remain to be written (unless its
+**              governor holds them back, see RRPGetSessionTimeout()) or
+**              once its lost connection is due to be opened again
+**
+** Input: RRPSESSION* - a pointer to an RRPSESSION structure
+**
+** Output: none
+**
+** Return: int - the events. 0 is returned if the session has nothing to
+**               do, is closed, or if an internal error occurs
+**
+*/
+
+int
+RRPGetSessionEvents (
+	RRPSESSION* session
+) {
+	int events = 0;
+
+	/*
+	** Validate parameters
+	*/
+	if (session == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return 0;
+	}
+
+	if (session->connection == NULL) {
+		return (session->broken && session->pending > 0 &&
+			getSessionWait(&session->redial) == 0) ? POLLOUT : 0;
+	}
+
+	if (session->sent > 0) {
+		events |= POLLIN;
+	}
+
+	if (session->outputStart < session->outputLength ||
+		(session->unsent != NULL && session->sent < session->window &&
+		!session->leaving &&
+		(!session->throttled || getSessionWait(&session->resume) == 0))) {
+		events |= POLLOUT;
+	}
+
+	return events;
+
+} /* RRPGetSessionEvents */
+
+
+
+
+
+
+/*
+**
+** Function: RRPGetSessionPending
+**
+** Description: Returns the number of requests of a session that have not
+**              been completed
+**
+** Input: RRPSESSION* - a pointer to an RRPSESSION structure
+**
+** Output: none
+**
+** Return: int - the number of requests. -1 is returned if an internal
+**               error occurs.
+**
+*/
+
+int
+RRPGetSessionPending (
+	RRPSESSION* session
+) {
+	/*
+	** Validate parameters
+	*/
+	if (session == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	return session->pending;
+
+} /* RRPGetSessionPending */
+
+
+
+
+
+
+/*
+**
+** Function: RRPSetSessionWindow
+**
+** Description: Sets the number of requests a session sends before it
+**              waits for a response (RRP_DEFAULT_SESSION_WINDOW by
+**              default). A window of 1 disables pipelining
+**
+** Input: RRPSESSION* - a pointer to an RRPSESSION structure
+**        int - the window (1 or more)
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+
+int
+RRPSetSessionWindow (
+	RRPSESSION* session,
+	int window
+) {
+	/*
+	** Validate parameters
+	*/
+	if (session == NULL || window < 1) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	session->window = window;
+
+	return 0;
+
+} /* RRPSetSessionWindow */
+
+
+
+
+
+
+/*
+**
+** Function: RRPGetSessionWindow
+**
+** Description: Returns the number of requests a session sends before it
+**              waits for a response (see RRPSetSessionWindow())
+**
+** Input: RRPSESSION* - a pointer to an RRPSESSION structure
+**
+** Output: none
+**
+** Return: int - the window. -1 is returned if an internal error occurs.
+**
+*/
+
+int
+RRPGetSessionWindow (
+	RRPSESSION* session
+) {
+	/*
+	** Validate parameters
+	*/
+	if (session == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	return session->window;
+
+} /* RRPGetSessionWindow */
+
+
+
+
+
+
+/*
+**
+** Function: RRPSetSessionGovernor
+**
+** Description: Sets the governor that paces the requests of a session.
+**              A session starts with the process governor (see
+**              RRPSetProcessGovernor())
+**
+** Input: RRPSESSION* - a pointer to an RRPSESSION structure
+**        RRPGOVERNOR* - the governor, or NULL for none. It still belongs
+**                       to the caller and must outlive the session
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+
+int
+RRPSetSessionGovernor (
+	RRPSESSION* session,
+	RRPGOVERNOR* governor
+) {
+	/*
+	** Validate parameters
+	*/
+	if (session == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	session->governor = governor;
+	session->throttled = RRPFALSE;
+
+	return 0;
+
+} /* RRPSetSessionGovernor */
+
+
+
+
+
+
+/*
+**
+** Function: RRPGetSessionTimeout
+**
+** Description: Returns how long a session must wait before it can send:
+**              while its governor holds its next request back, while a
+**              probe the server was too busy to answer waits to be
+**              asked again, or while its lost connection waits to be
+**              opened again (see RRPSetSessionReconnect()). The session
+**              should be flushed (see RRPFlushSession()) once that time
+**              has passed, whether or not it has a descriptor
+**
+** Input: RRPSESSION* - a pointer to an RRPSESSION structure
+**
+** Output: none
+**
+** Return: int - the time in milliseconds, 0 if the session may be
+**               flushed now. -1 is returned if the session is not
+**               waiting or if an internal error occurs.
+**
+*/
+
+int
+RRPGetSessionTimeout (
+	RRPSESSION* session
+) {
+	long wait = 0;
+
+	/*
+	** Validate parameters
+	*/
+	if (session == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	if (session->connection == NULL) {
+		if (!session->broken || session->pending == 0) {
+			return -1;
+		}
+		wait = getSessionWait(&session->redial);
+	}
+	else {
+		if (!session->throttled || session->unsent == NULL ||
+			session->sent >= session->window) {
+			return -1;
+		}
+		wait = getSessionWait(&session->resume);
+	}
+
+	return wait > 0 ? (int) ((wait + 999) / 1000) : 0;
+
+} /* RRPGetSessionTimeout */
+
+
+
+
+
+
+/*
+**
+** Function: RRPSetSessionReconnect
+**
+** Description: Lets a session open its connection again, and log in with
+**              the credentials it was opened with, when the connection
+**              fails or the server closes it. The requests that were
+**              written but not answered are sent again if the policy
+**              retries their command after an unknown outcome (see
+**              RRPSetRetryCommand()). Those whose outcome the policy
+**              probes (see RRPSetRetryProbe()) are replaced by a Status
+**              command once the connection is open again: a command
+**              that was not executed is then sent again, and one that
+**              was is completed with the response of the probe. A
+**              probe the server is too busy to answer is sent again
+**              after the policy's delays, within its attempts, ahead
+**              of the requests not written yet. The others, and those
+**              the probe does not settle, are completed with a NULL
+**              response. The requests not written yet are kept.
+**              The connection is opened again as soon as the session
+**              has requests, then after the delays of the policy until
+**              it succeeds or the policy's attempts are used up, and
+**              the session is then closed
+**
+** Input: RRPSESSION* - a pointer to an RRPSESSION structure
+**        RRPRETRYPOLICY* - the policy (see rrpRetry.h), or NULL to
+**                          close the session when its connection fails
+**                          (the default). It still belongs to the caller
+**                          and must outlive the session
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+
+int
+RRPSetSessionReconnect (
+	RRPSESSION* session,
+	RRPRETRYPOLICY* policy
+) {
+	/*
+	** Validate parameters
+	*/
+	if (session == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	session->reconnect = policy;
+
+	/*
+	** Without a policy, a session waiting for its connection is closed
+	*/
+	if (policy == NULL && session->broken) {
+		failSession(session, RRP_NOT_CONNECTED_ERROR);
+	}
+
+	return 0;
+
+} /* RRPSetSessionReconnect */
+
+
+
+
+
+
+/*
+**
+** Function: RRPSetSessionJournal
+**
+** Description: Records in a journal the requests of a session whose
+**              command the journal records (see RRPSetJournalCommand()).
+**              The intent of such a request is recorded when it is
+**              copied to the output buffer and committed before the
+**              buffer is written; its outcome is recorded when it is
+**              completed, as unknown if it was completed without a
+**              response. If the journal fails, the session is closed
+**              rather than send a command that is not recorded. The
+**              journal is set before any request is submitted
+**
+** Input: RRPSESSION* - a pointer to an RRPSESSION structure
+**        RRPJOURNAL* - the journal, or NULL for none (the default). It
+**                      still belongs to the caller and must outlive the
+**                      session
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+
+int
+RRPSetSessionJournal (
+	RRPSESSION* session,
+	RRPJOURNAL* journal
+) {
+	/*
+	** Validate parameters
+	*/
+	if (session == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	session->journal = journal;
+	session->journaled = 0;
+	session->committed = 0;
+
+	return 0;
+
+} /* RRPSetSessionJournal */
+
+
+
+
+
+
+/*
+**
+** Function: RRPIsSessionOpen
+**
+** Description: Tells whether a session is still usable
+**
+** Input: RRPSESSION* - a pointer to an RRPSESSION structure
+**
+** Output: none
+**
+** Return: RRPBOOLEAN - RRPTRUE if the session is open or is to open
+**                      its lost connection again, RRPFALSE if it is
+**                      closed or if an internal error occurs
+**
+*/
+
+RRPBOOLEAN
+RRPIsSessionOpen (
+	RRPSESSION* session
+) {
+	/*
+	** Validate parameters
+	*/
+	if (session == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return RRPFALSE;
+	}
+
+	return (session->connection != NULL || session->broken) ? RRPTRUE :
+		RRPFALSE;
+
+} /* RRPIsSessionOpen */
+
+
+
+
+
+
+/*
+**
+** Function: RRPCloseSession
+**
+** Description: Ends a session, closes its connection and frees all of
+**              the memory allocated for it. Requests that have not been
+**              completed are completed with a NULL response:
+**              RRP_IO_ERROR for those that were written and may have
+**              been executed, RRP_NOT_CONNECTED_ERROR for the others.
+**              If no request is awaiting a response, the Quit command
+**              is sent and its response read first
+**
+** Input: RRPSESSION* - a pointer to an RRPSESSION structure
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+
+int
+RRPCloseSession (
+	RRPSESSION* session
+) {
+	RRPCONNECTION* connection = NULL;
+	RRPBOOLEAN idle = RRPFALSE;
+	char* responseString = NULL;
+
+	/*
+	** Validate parameters
+	*/
+	if (session == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	connection = session->connection;
+	session->connection = NULL;
+	session->reconnect = NULL;
+	idle = (session->sent == 0) ? RRPTRUE : RRPFALSE;
+	leaveSessionEndpoint(session, RRPFALSE);
+
+	/*
+	** Fail the outstanding requests first: their responses will never
+	** be read. Those already written may have been executed
+	*/
+	while (session->head != session->unsent) {
+		RRPSetInternalErrorCode(RRP_IO_ERROR);
+		completeSessionRequest(session, NULL);
+	}
+	failSession(session, RRP_NOT_CONNECTED_ERROR);
+
+	if (connection != NULL) {
+		/*
+		** End the session properly if the server is not still working on
+		** requests; otherwise its answer to Quit would be lost among
+		** their responses, so just close the connection
+		*/
+		if (idle == RRPTRUE && RRPSetConnectionBlocking(connection, 1) == 0 &&
+			RRPWriteConnection(connection, "Quit\r\n.\r\n", 9) == 9 &&
+			(responseString = RRPReadConnectionResponse(connection)) != NULL) {
+			free(responseString);
+		}
+		RRPFreeConnection(connection);
+	}
+
+	freeSessionCredentials(session);
+	free(session->output);
+	free(session);
+
+	return 0;
+
+} /* RRPCloseSession */
+
+
+
+
+
+
+/*
+**
+** Function: RRPCreateSessionPool
+**
+** Description: Opens a number of sessions to an RRP server for one
+**              registrar (see RRPOpenSession())
+**
+** Input: char* - host name or IP address of RRP server
+**        unsigned short int - RRP server port
+**        char* - registrar's id
+**        char* - registrar's password
+**        int - the number of sessions (1 or more)
+**
+** Output: none
+**
+** Return: RRPSESSIONPOOL* - a pointer to an RRPSESSIONPOOL structure.
+**                           NULL is returned if any of the sessions can
+**                           not be opened
+**
+** Note: THE POOL MUST BE RELEASED BY CALLING RRPFreeSessionPool()
+**
+*/
+
+RRPSESSIONPOOL*
+RRPCreateSessionPool (
+	char* host,
+	unsigned short int port,
+	char* registrarID,
+	char* registrarPassword,
+	int size
+) {
+	/*
+	** Validate parameters
+	*/
+	if (host == NULL || registrarID == NULL || registrarPassword == NULL ||
+		size < 1) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return NULL;
+	}
+
+	return createSessionPool(host, port, NULL, registrarID,
+		registrarPassword, size);
+
+} /* RRPCreateSessionPool */
+
+
+
+
+
+
+/*
+**
+** Function: RRPCreateEndpointSessionPool
+**
+** Description: Opens a number of sessions for one registrar, spread
+**              over a set of RRP servers (see RRPOpenEndpointSession())
+**
+** Input: RRPENDPOINTS* - the set of endpoints. It still belongs to the
+**                        caller and must outlive the pool
+**        char* - registrar's id
+**        char* - registrar's password
+**        int - the number of sessions (1 or more)
+**
+** Output: none
+**
+** Return: RRPSESSIONPOOL* - a pointer to an RRPSESSIONPOOL structure.
+**                           NULL is returned if any of the sessions can
+**                           not be opened
+**
+** Note: THE POOL MUST BE RELEASED BY CALLING RRPFreeSessionPool()
+**
+*/
+
+RRPSESSIONPOOL*
+RRPCreateEndpointSessionPool (
+	RRPENDPOINTS* endpoints,
+	char* registrarID,
+	char* registrarPassword,
+	int size
+) {
+	/*
+	** Validate parameters
+	*/
+	if (endpoints == NULL || registrarID == NULL ||
+		registrarPassword == NULL || size < 1) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return NULL;
+	}
+
+	return createSessionPool(NULL, 0, endpoints, registrarID,
+		registrarPassword, size);
+
+} /* RRPCreateEndpointSessionPool */
+
+
+
+
+
+
+/*
+**
+** Function: RRPCreateBrokerSessionPool
+**
+** Description: Opens a number of sessions to a session broker (see
+**              RRPOpenBrokerSession()), e.g. for a process that drives
+**              its requests through an RRPCLIENT (see rrpClient.h)
+**
+** Input: char* - path of the broker's socket
+**        int - the number of sessions (1 or more)
+**
+** Output: none
+**
+** Return: RRPSESSIONPOOL* - a pointer to an RRPSESSIONPOOL structure.
+**                           NULL is returned if any of the sessions can
+**                           not be opened
+**
+** Note: THE POOL MUST BE RELEASED BY CALLING RRPFreeSessionPool()
+**
+*/
+
+RRPSESSIONPOOL*
+RRPCreateBrokerSessionPool (
+	char* path,
+	int size
+) {
+	/*
+	** Validate parameters
+	*/
+	if (path == NULL || size < 1) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return NULL;
+	}
+
+	return createSessionPool(path, 0, NULL, NULL, NULL, size);
+
+} /* RRPCreateBrokerSessionPool */
+
+
+
+
+
+
+/*
+**
+** Function: RRPSubmitPoolRequest
+**
+** Description: Submits a request to the open session of a pool with the
+**              fewest requests outstanding (see RRPSubmitSessionRequest())
+**
+** Input: RRPSESSIONPOOL* - a pointer to an RRPSESSIONPOOL structure
+**        RRPREQUEST* - the request. The pool takes ownership of the
+**                      request if successful
+**        RRPCOMPLETION - function called with the response
+**        void* - context pointer passed to the completion function
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs or if no session is open
+**               (RRP_NOT_CONNECTED_ERROR)
+**
+*/
+
+int
+RRPSubmitPoolRequest (
+	RRPSESSIONPOOL* pool,
+	RRPREQUEST* request,
+	RRPCOMPLETION completion,
+	void* context
+) {
+	RRPSESSION* session = NULL;
+	RRPSESSION* best = NULL;
+	int i = 0;
+
+	/*
+	** Validate parameters
+	*/
+	if (pool == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	for (i = 0; i < pool->size; i++) {
+		session = pool->sessions[i];
+
+		if (RRPIsSessionOpen(session) &&
+			(best == NULL || session->pending < best->pending)) {
+			best = session;
+		}
+	}
+
+	if (best == NULL) {
+		RRPSetInternalErrorCode(RRP_NOT_CONNECTED_ERROR);
+		return -1;
+	}
+
+	return RRPSubmitSessionRequest(best, request, completion, context);
+
+} /* RRPSubmitPoolRequest */
+
+
+
+
+
+
+/*
+**
+** Function: RRPPollSessionPool
+**
+** Description: Waits until at least one session of a pool can make
+**              progress, then sends queued requests and completes the
+**              requests whose responses have arrived
+**
+** Input: RRPSESSIONPOOL* - a pointer to an RRPSESSIONPOOL structure
+**        int - the longest time to wait, in milliseconds. -1 waits
+**              until a session is ready, or until the governor of a
+**              session lets it send again
+**
+** Output: none
+**
+** Return: int - the number of requests completed, which is 0 if the time
+**               ran out or if no requests are pending. -1 is returned if
+**               an internal error occurs.
+**
+*/
+
+int
+RRPPollSessionPool (
+	RRPSESSIONPOOL* pool,
+	int timeout
+) {
+	RRPSESSION* session = NULL;
+	int count = 0;
+	int completed = 0;
+	int result = 0;
+	int wait = 0;
+	int throttled = 0;
+	int i = 0;
+
+	/*
+	** Validate parameters
+	*/
+	if (pool == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	/*
+	** Write new requests right away rather than after waiting for a
+	** session to become writable. A session whose connection fails here
+	** completes its requests with a NULL response
+	*/
+	for (i = 0; i < pool->size; i++) {
+		session = pool->sessions[i];
+		pool->descriptors[i].fd = -1;
+		pool->descriptors[i].events = 0;
+		pool->descriptors[i].revents = 0;
+
+		if (!RRPIsSessionOpen(session)) {
+			continue;
+		}
+
+		if (RRPGetSessionEvents(session) & POLLOUT) {
+			RRPFlushSession(session);
+		}
+
+		if (session->connection != NULL &&
+			(pool->descriptors[i].events = RRPGetSessionEvents(session)) != 0) {
+			pool->descriptors[i].fd =
+				RRPGetConnectionDescriptor(session->connection);
+			count++;
+		}
+
+		/*
+		** Wake up in time for a session held back by its governor, or
+		** whose connection is to be opened again
+		*/
+		if ((wait = RRPGetSessionTimeout(session)) >= 0) {
+			throttled++;
+			if (timeout < 0 || wait < timeout) {
+				timeout = wait;
+			}
+		}
+	}
+
+	if (count == 0 && throttled == 0) {
+		return 0;
+	}
+
+	do {
+		result = poll(pool->descriptors, pool->size, timeout);
+	} while (result < 0 && errno == EINTR);
+
+	if (result < 0) {
+		RRPSetInternalErrorCode(RRP_IO_ERROR);
+		return -1;
+	}
+
+	for (i = 0; i < pool->size && result > 0; i++) {
+		session = pool->sessions[i];
+
+		if (pool->descriptors[i].revents == 0) {
+			continue;
+		}
+
+		result--;
+
+		if (pool->descriptors[i].revents & POLLOUT) {
+			if (RRPFlushSession(session) < 0) {
+				continue;
+			}
+		}
+
+		if (pool->descriptors[i].revents & (POLLIN | POLLERR | POLLHUP)) {
+			count = RRPProcessSession(session);
+			if (count > 0) {
+				completed += count;
+			}
+		}
+	}
+
+	for (i = 0; i < pool->size && throttled > 0; i++) {
+		if (RRPGetSessionTimeout(pool->sessions[i]) == 0) {
+			RRPFlushSession(pool->sessions[i]);
+		}
+	}
+
+	return completed;
+
+} /* RRPPollSessionPool */
+
+
+
+
+
+
+/*
+**
+** Function: RRPRunSessionPool
+**
+** Description: Polls a pool (see RRPPollSessionPool()) until all of its
+**              requests, including those submitted by completion
+**              functions, have been completed
+**
+** Input: RRPSESSIONPOOL* - a pointer to an RRPSESSIONPOOL structure
+**
+** Output: none
+**
+** Return: int - the number of requests completed. -1 is returned if an
+**               internal error occurs.
+**
+*/
+
+int
+RRPRunSessionPool (
+	RRPSESSIONPOOL* pool
+) {
+	int completed = 0;
+	int count = 0;
+
+	/*
+	** Validate parameters
+	*/
+	if (pool == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	while (RRPGetSessionPoolPending(pool) > 0) {
+		if ((count = RRPPollSessionPool(pool, -1)) < 0) {
+			return -1;
+		}
+		completed += count;
+	}
+
+	return completed;
+
+} /* RRPRunSessionPool */
+
+
+
+
+
+
+/*
+**
+** Function: RRPGetSessionPoolPending
+**
+** Description: Returns the number of requests of all of the sessions of a
+**              pool that have not been completed
+**
+** Input: RRPSESSIONPOOL* - a pointer to an RRPSESSIONPOOL structure
+**
+** Output: none
+**
+** Return: int - the number of requests. -1 is returned if an internal
+**               error occurs.
+**
+*/
+
+int
+RRPGetSessionPoolPending (
+	RRPSESSIONPOOL* pool
+) {
+	int pending = 0;
+	int i = 0;
+
+	/*
+	** Validate parameters
+	*/
+	if (pool == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	for (i = 0; i < pool->size; i++) {
+		pending += pool->sessions[i]->pending;
+	}
+
+	return pending;
+
+} /* RRPGetSessionPoolPending */
+
+
+
+
+
+
+/*
+**
+** Function: RRPGetSessionPoolSize
+**
+** Description: Returns the number of sessions of a pool
+**
+** Input: RRPSESSIONPOOL* - a pointer to an RRPSESSIONPOOL structure
+**
+** Output: none
+**
+** Return: int - the number of sessions. -1 is returned if an internal
+**               error occurs.
+**
+*/
+
+int
+RRPGetSessionPoolSize (
+	RRPSESSIONPOOL* pool
+) {
+	/*
+	** Validate parameters
+	*/
+	if (pool == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	return pool->size;
+
+} /* RRPGetSessionPoolSize */
+
+
+
+
+
+
+/*
+**
+** Function: RRPGetPoolSession
+**
+** Description: Returns one of the sessions of a pool
+**
+** Input: RRPSESSIONPOOL* - a pointer to an RRPSESSIONPOOL structure
+**        int - the index of the session (0 to size - 1)
+**
+** Output: none
+**
+** Return: RRPSESSION* - the session, which belongs to the pool. NULL is
+**                       returned if an internal error occurs.
+**
+*/
+
+RRPSESSION*
+RRPGetPoolSession (
+	RRPSESSIONPOOL* pool,
+	int index
+) {
+	/*
+	** Validate parameters
+	*/
+	if (pool == NULL || index < 0 || index >= pool->size) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return NULL;
+	}
+
+	return pool->sessions[index];
+
+} /* RRPGetPoolSession */
+
+
+
+
+
+
+/*
+**
+** Function: RRPSetSessionPoolWindow
+**
+** Description: Sets the window of each session of a pool (see
+**              RRPSetSessionWindow())
+**
+** Input: RRPSESSIONPOOL* - a pointer to an RRPSESSIONPOOL structure
+**        int - the window (1 or more)
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+
+int
+RRPSetSessionPoolWindow (
+	RRPSESSIONPOOL* pool,
+	int window
+) {
+	int i = 0;
+
+	/*
+	** Validate parameters
+	*/
+	if (pool == NULL || window < 1) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	for (i = 0; i < pool->size; i++) {
+		pool->sessions[i]->window = window;
+	}
+
+	return 0;
+
+} /* RRPSetSessionPoolWindow */
+
+
+
+
+
+
+/*
+**
+** Function: RRPSetSessionPoolGovernor
+**
+** Description: Sets the governor of each session of a pool (see
+**              RRPSetSessionGovernor())
+**
+** Input: RRPSESSIONPOOL* - a pointer to an RRPSESSIONPOOL structure
+**        RRPGOVERNOR* - the governor, or NULL for none
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+
+int
+RRPSetSessionPoolGovernor (
+	RRPSESSIONPOOL* pool,
+	RRPGOVERNOR* governor
+) {
+	int i = 0;
+
+	/*
+	** Validate parameters
+	*/
+	if (pool == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	for (i = 0; i < pool->size; i++) {
+		RRPSetSessionGovernor(pool->sessions[i], governor);
+	}
+
+	return 0;
+
+} /* RRPSetSessionPoolGovernor */
+
+
+
+
+
+
+/*
+**
+** Function: RRPSetSessionPoolReconnect
+**
+** Description: Sets the reconnection policy of each session of a pool
+**              (see RRPSetSessionReconnect())
+**
+** Input: RRPSESSIONPOOL* - a pointer to an RRPSESSIONPOOL structure
+**        RRPRETRYPOLICY* - the policy, or NULL for none
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+
+int
+RRPSetSessionPoolReconnect (
+	RRPSESSIONPOOL* pool,
+	RRPRETRYPOLICY* policy
+) {
+	int i = 0;
+
+	/*
+	** Validate parameters
+	*/
+	if (pool == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	for (i = 0; i < pool->size; i++) {
+		RRPSetSessionReconnect(pool->sessions[i], policy);
+	}
+
+	return 0;
+
+} /* RRPSetSessionPoolReconnect */
+
+
+
+
+
+
+/*
+**
+** Function: RRPSetSessionPoolJournal
+**
+** Description: Sets the journal of each session of a pool (see
+**              RRPSetSessionJournal())
+**
+** Input: RRPSESSIONPOOL* - a pointer to an RRPSESSIONPOOL structure
+**        RRPJOURNAL* - the journal, or NULL for none
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+
+int
+RRPSetSessionPoolJournal (
+	RRPSESSIONPOOL* pool,
+	RRPJOURNAL* journal
+) {
+	int i = 0;
+
+	/*
+	** Validate parameters
+	*/
+	if (pool == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	for (i = 0; i < pool->size; i++) {
+		RRPSetSessionJournal(pool->sessions[i], journal);
+	}
+
+	return 0;
+
+} /* RRPSetSessionPoolJournal */
+
+
+
+
+
+
+/*
+**
+** Function: RRPFreeSessionPool
+**
+** Description: Closes all of the sessions of a pool (see
+**              RRPCloseSession()) and frees the pool
+**
+** Input: RRPSESSIONPOOL* - a pointer to an RRPSESSIONPOOL structure
+**
+** Output: none
+**
+** Return: int - 0 is returned if successful. -1 is returned if an
+**               internal error occurs.
+**
+*/
+
+int
+RRPFreeSessionPool (
+	RRPSESSIONPOOL* pool
+) {
+	int i = 0;
+
+	/*
+	** Validate parameters
+	*/
+	if (pool == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	for (i = 0; i < pool->size; i++) {
+		RRPCloseSession(pool->sessions[i]);
+	}
+
+	free(pool->sessions);
+	free(pool->descriptors);
+	free(pool);
+
+	return 0;
+
+} /* RRPFreeSessionPool */
+
+
+
+
+
+
+/*
+**
+** Function: RRPCheckDomains
+**
+** Description: Checks the availability of a number of domain names. The
+**              Check commands are pipelined over the sessions of a pool,
+**              and only as many are created as the sessions' windows can
+**              hold, so any number of names can be checked in constant
+**              memory
+**
+** Input: char** - array of domain names
+**        int - the number of names
+**        RRPSESSIONPOOL* - a pointer to an RRPSESSIONPOOL structure
+**
+** Output: RRPCHECKRESULT* - array of 'count' results, in the order of the
+**                           names. The code of a name whose check failed
+**                           (its session's connection failed, etc.) is
+**                           set to -1
+**
+** Return: int - the number of names checked, i.e. 'count' less the
+**               failed checks. -1 is returned if an internal error
+**               occurs: the Check commands not written yet are then
+**               dropped, and the responses to those already written
+**               are discarded when they arrive. The other requests of
+**               the pool are not affected.
+**
+*/
+
+int
+RRPCheckDomains (
+	char** names,
+	int count,
+	RRPSESSIONPOOL* pool,
+	RRPCHECKRESULT* results
+) {
+	RRPCHECKBATCH batch;
+	RRPCHECKSLOT* slots = NULL;
+	int slotCount = 0;
+	int i = 0;
+
+	/*
+	** Validate parameters
+	*/
+	if (names == NULL || count < 0 || pool == NULL || results == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	for (i = 0; i < count; i++) {
+		results[i].code = -1;
+		results[i].available = RRPFALSE;
+	}
+
+	/*
+	** One slot for each request the open sessions send before waiting
+	** for a response: more would only wait in the sessions' queues
+	*/
+	for (i = 0; i < pool->size; i++) {
+		if (RRPIsSessionOpen(pool->sessions[i])) {
+			slotCount += pool->sessions[i]->window;
+		}
+	}
+
+	if (slotCount > count) {
+		slotCount = count;
+	}
+
+	if (slotCount == 0) {
+		if (count > 0) {
+			RRPSetInternalErrorCode(RRP_NOT_CONNECTED_ERROR);
+		}
+		return 0;
+	}
+
+	slots = (RRPCHECKSLOT*) malloc(slotCount * sizeof(RRPCHECKSLOT));
+	if (slots == NULL) {
+		RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
+		return -1;
+	}
+
+	batch.pool = pool;
+	batch.names = names;
+	batch.results = results;
+	batch.count = count;
+	batch.next = 0;
+	batch.completed = 0;
+	batch.checked = 0;
+
+	for (i = 0; i < slotCount; i++) {
+		slots[i].batch = &batch;
+		submitCheck(&slots[i]);
+	}
+
+	while (batch.completed < batch.count) {
+		if (RRPPollSessionPool(pool, -1) < 0) {
+			/*
+			** The slots can not be released while requests that use
+			** them are queued, so take the batch's requests off them;
+			** the caller's other requests are left alone
+			*/
+			batch.next = batch.count;
+			abandonChecks(&batch);
+			free(slots);
+			return -1;
+		}
+	}
+
+	free(slots);
+
+	return batch.checked;
+
+} /* RRPCheckDomains */
+
+
+
+
+
+
+/*
+** Copies queued requests into the output buffer of a session until its
+** window is full or its governor holds a request back, recording the
+** intent of those its journal records. Returns 0 if successful. Returns
+** -1 and sets error code if an error occurs; the session is closed if
+** its journal failed.
+*/
+static int
+queueSessionRequests (
+	RRPSESSION* session
+) {
+	RRPREQUEST* request = NULL;
+	size_t capacity = 0;
+	char* output = NULL;
+	long wait = 0;
+	time_t issued = 0;
+	struct timespec now;
+
+	session->throttled = RRPFALSE;
+
+	if (session->endpoint >= 0) {
+		clock_gettime(CLOCK_MONOTONIC, &now);
+	}
+	if (session->reconnect != NULL) {
+		issued = time(NULL);
+	}
+
+	while (session->unsent != NULL && session->sent < session->window) {
+		request = session->unsent->request;
+
+		/*
+		** Hold a probe the server was too busy to answer back until
+		** the delay of the reconnection policy has passed
+		*/
+		if (session->unsent->probed != NULL &&
+			(wait = getSessionWait(&session->unsent->due)) > 0) {
+			setSessionTime(&session->resume, wait);
+			session->throttled = RRPTRUE;
+			break;
+		}
+
+		/*
+		** Hold the request back until the governor allows it
+		*/
+		if (session->governor != NULL && (wait =
+			RRPAcquireGovernor(session->governor, request->command)) > 0) {
+			setSessionTime(&session->resume, wait);
+			session->throttled = RRPTRUE;
+			break;
+		}
+
+		/*
+		** A request sent again keeps the intent recorded the first time
+		*/
+		if (session->journal != NULL && session->unsent->sequence == 0 &&
+			RRPGetJournalCommand(session->journal, request->command)) {
+			session->unsent->sequence =
+				RRPRecordJournalIntent(session->journal, request);
+			if (session->unsent->sequence == 0) {
+				failSession(session, RRPGetInternalErrorCode());
+				return -1;
+			}
+			session->journaled = session->unsent->sequence;
+		}
+
+		if (session->outputLength + request->length >
+			session->outputCapacity) {
+			capacity = session->outputCapacity * 2;
+			if (capacity < session->outputLength + request->length) {
+				capacity = session->outputLength + request->length;
+			}
+			if (capacity < 4096) {
+				capacity = 4096;
+			}
+
+			output = (char*) realloc(session->output, capacity);
+			if (output == NULL) {
+				RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
+				return -1;
+			}
+
+			session->output = output;
+			session->outputCapacity = capacity;
+		}
+
+		memcpy(session->output + session->outputLength, request->text,
+			request->length);
+		session->outputLength += request->length;
+
+		if (session->endpoint >= 0) {
+			session->unsent->written = now;
+		}
+		if (session->reconnect != NULL && session->unsent->probed == NULL) {
+			session->unsent->issued = issued;
+		}
+
+		session->unsent = session->unsent->next;
+		session->sent++;
+	}
+
+	return 0;
+
+} /* queueSessionRequests */
+
+
+
+
+
+
+/*
+** Removes the oldest request from the queue of a session and calls its
+** completion function with 'response', then frees the request. If the
+** request is a probe, the command it probed is completed instead, or
+** put back in the queue to be sent again (see settleSessionProbe()).
+*/
+static void
+completeSessionRequest (
+	RRPSESSION* session,
+	RRPRESPONSE* response
+) {
+	RRPPENDING* pending = session->head;
+	RRPPENDING** link = NULL;
+	RRPOUTCOME outcome = RRP_OUTCOME_SUCCEEDED;
+	int delay = 0;
+
+	session->head = pending->next;
+	if (session->head == NULL) {
+		session->tail = NULL;
+	}
+	if (session->unsent == pending) {
+		session->unsent = pending->next;
+	}
+	else {
+		session->sent--;
+	}
+	session->pending--;
+
+	/*
+	** Server errors count against the endpoint; any other answer is a
+	** sign of health, whatever it says about the request
+	*/
+	if (response != NULL && session->endpoint >= 0) {
+		outcome = RRPClassifyOutcome(response, RRP_NO_ERROR);
+		if (outcome == RRP_OUTCOME_REFUSED ||
+			outcome == RRP_OUTCOME_DISCONNECTED) {
+			RRPReportEndpoint(session->endpoints, session->endpoint,
+				RRP_ENDPOINT_REFUSED, 0);
+		}
+		else {
+			RRPReportEndpoint(session->endpoints, session->endpoint,
+				RRP_ENDPOINT_RESPONDED, getSessionElapsed(&pending->written));
+		}
+	}
+
+	if (pending->probed != NULL) {
+		/*
+		** A probe the server could not answer is asked again after the
+		** delay of the reconnection policy, as long as the policy
+		** allows; otherwise the probe is settled, and a request that
+		** was not executed is sent again. Either goes before the
+		** requests not written yet.
+		*/
+		if (response != NULL && session->connection != NULL) {
+			delay = RRPGetRetryDelay(session->reconnect, &pending->asked,
+				pending->request, response, RRP_NO_ERROR);
+		}
+
+		if (delay <= 0) {
+			outcome = settleSessionProbe(session, pending, response);
+		}
+		else {
+			setSessionTime(&pending->due, delay * 1000L);
+			outcome = RRP_OUTCOME_REFUSED;
+		}
+
+		if (outcome == RRP_OUTCOME_REFUSED) {
+			RRPFreeResponse(response);
+
+			link = &session->head;
+			while (*link != session->unsent) {
+				link = &(*link)->next;
+			}
+			pending->next = session->unsent;
+			*link = pending;
+			if (pending->next == NULL) {
+				session->tail = pending;
+			}
+			session->unsent = pending;
+			session->pending++;
+			return;
+		}
+
+		if (outcome == RRP_OUTCOME_UNKNOWN && response != NULL) {
+			RRPFreeResponse(response);
+			response = NULL;
+			RRPSetInternalErrorCode(pending->lost);
+		}
+	}
+
+	journalSessionOutcome(session, pending, response);
+	pending->completion(pending->request, response, pending->context);
+
+	RRPFreeRequest(pending->request);
+	free(pending);
+
+} /* completeSessionRequest */
+
+
+
+
+
+
+/*
+** Records the outcome of a request in the journal of its session, if
+** its intent was recorded there. The internal error code, which the
+** completion function may read, is left as it was.
+*/
+static void
+journalSessionOutcome (
+	RRPSESSION* session,
+	RRPPENDING* pending,
+	RRPRESPONSE* response
+) {
+	RRPINTERNAL_ERROR_CODE error = RRP_NO_ERROR;
+
+	if (pending->sequence == 0 || session->journal == NULL) {
+		return;
+	}
+
+	error = RRPGetInternalErrorCode();
+	RRPRecordJournalOutcome(session->journal, pending->sequence, response);
+	RRPSetInternalErrorCode(error);
+
+} /* journalSessionOutcome */
+
+
+
+
+
+
+/*
+** Replaces a written request whose response was lost by the Status
+** request that probes its outcome, keeping the request aside. Returns
+** 0 if successful, -1 if the request can not be probed.
+*/
+static int
+probeSessionRequest (
+	RRPPENDING* pending,
+	RRPINTERNAL_ERROR_CODE error
+) {
+	RRPREQUEST* probe = NULL;
+
+	probe = RRPCreateProbeRequest(pending->request);
+	if (probe == NULL) {
+		return -1;
+	}
+
+	pending->probed = pending->request;
+	pending->request = probe;
+	pending->lost = error;
+	memset(&pending->asked, 0, sizeof(pending->asked));
+	setSessionTime(&pending->due, 0);
+
+	return 0;
+
+} /* probeSessionRequest */
+
+
+
+
+
+
+/*
+** Puts back the request a probe stood for and frees the probe. Returns
+** what the response of the probe, NULL if it has none, tells about the
+** request (see RRPResolveOutcome()); a request that was not executed can
+** only be sent again if the session is still open.
+*/
+static RRPOUTCOME
+settleSessionProbe (
+	RRPSESSION* session,
+	RRPPENDING* pending,
+	RRPRESPONSE* response
+) {
+	RRPOUTCOME outcome = RRP_OUTCOME_UNKNOWN;
+	RRPINTERNAL_ERROR_CODE error = RRP_NO_ERROR;
+
+	error = RRPGetInternalErrorCode();
+
+	if (response != NULL) {
+		outcome = RRPResolveOutcome(pending->probed, response,
+			session->registrarID, pending->issued);
+	}
+
+	RRPFreeRequest(pending->request);
+	pending->request = pending->probed;
+	pending->probed = NULL;
+
+	if (outcome == RRP_OUTCOME_REFUSED && session->connection == NULL) {
+		outcome = RRP_OUTCOME_UNKNOWN;
+	}
+
+	RRPSetInternalErrorCode(error);
+
+	return outcome;
+
+} /* settleSessionProbe */
+
+
+
+
+
+
+/*
+** Marks a session as closed after its connection failed, and completes
+** each of its requests with a NULL response and 'error' as the internal
+** error code. The session itself is freed by RRPCloseSession().
+**
+** RRP_NOT_CONNECTED_ERROR, which a server hanging up also gives, says a
+** request was never sent; the written requests get RRP_IO_ERROR instead.
+*/
+static void
+failSession (
+	RRPSESSION* session,
+	RRPINTERNAL_ERROR_CODE error
+) {
+	session->broken = RRPFALSE;
+	session->leaving = RRPFALSE;
+
+	if (session->connection != NULL) {
+		leaveSessionEndpoint(session, session->sent > 0);
+		RRPFreeConnection(session->connection);
+		session->connection = NULL;
+	}
+
+	session->outputStart = 0;
+	session->outputLength = 0;
+
+	while (session->head != NULL) {
+		RRPSetInternalErrorCode((session->head != session->unsent &&
+			error == RRP_NOT_CONNECTED_ERROR) ? RRP_IO_ERROR : error);
+		completeSessionRequest(session, NULL);
+	}
+
+	RRPSetInternalErrorCode(error);
+
+} /* failSession */
+
+
+
+
+
+
+/*
+** Handles the failure of the connection of a session. A session that
+** may not reconnect is closed (see failSession()). Otherwise the written
+** requests that are not to be sent again are taken out of the queue,
+** the others are put back with the unwritten ones, and the connection
+** is to be opened again right away; the requests taken out are then
+** completed with a NULL response and 'error' as the internal error code.
+*/
+static void
+breakSession (
+	RRPSESSION* session,
+	RRPINTERNAL_ERROR_CODE error
+) {
+	RRPPENDING* lost = NULL;
+	RRPPENDING** lostTail = &lost;
+	RRPPENDING** link = NULL;
+	RRPPENDING* pending = NULL;
+
+	if (session->reconnect == NULL) {
+		failSession(session, error);
+		return;
+	}
+
+	/*
+	** Only written requests are completed here, and the server hanging
+	** up does not tell whether it executed them
+	*/
+	if (error == RRP_NOT_CONNECTED_ERROR) {
+		error = RRP_IO_ERROR;
+	}
+
+	leaveSessionEndpoint(session, session->sent > 0);
+	RRPFreeConnection(session->connection);
+	session->connection = NULL;
+	session->outputStart = 0;
+	session->outputLength = 0;
+	session->throttled = RRPFALSE;
+	session->leaving = RRPFALSE;
+
+	/*
+	** A written request may or may not have been executed; the server
+	** is asked about those the policy probes. A session on a broker
+	** has no registrar to compare the sponsor with, and leaves that to
+	** the broker's sessions
+	*/
+	link = &session->head;
+	while ((pending = *link) != session->unsent) {
+		if (RRPGetRetryCommand(session->reconnect,
+			pending->request->command) ||
+			(pending->probed == NULL && session->registrarID != NULL &&
+			RRPGetRetryProbe(session->reconnect, pending->request->command) &&
+			probeSessionRequest(pending, error) == 0)) {
+			link = &pending->next;
+			continue;
+		}
+
+		*link = pending->next;
+		pending->next = NULL;
+		*lostTail = pending;
+		lostTail = &pending->next;
+		session->pending--;
+	}
+
+	session->tail = NULL;
+	for (pending = session->head; pending != NULL; pending = pending->next) {
+		session->tail = pending;
+	}
+	session->unsent = session->head;
+	session->sent = 0;
+
+	session->broken = RRPTRUE;
+	setSessionTime(&session->redial, 0);
+
+	while ((pending = lost) != NULL) {
+		lost = pending->next;
+
+		if (pending->probed != NULL) {
+			settleSessionProbe(session, pending, NULL);
+		}
+
+		journalSessionOutcome(session, pending, NULL);
+		RRPSetInternalErrorCode(error);
+		pending->completion(pending->request, NULL, pending->context);
+
+		RRPFreeRequest(pending->request);
+		free(pending);
+	}
+
+	RRPSetInternalErrorCode(error);
+
+} /* breakSession */
+
+
+
+
+
+
+/*
+** Opens the connection of a session and logs in, on the best endpoint
+** if the session uses a set of endpoints. A session on a broker only
+** opens the broker's socket. Returns 0 if successful.
+** Returns -1 and sets error code if an error occurs, and the session is
+** then left without a connection.
+*/
+static int
+connectSession (
+	RRPSESSION* session
+) {
+	RRPINTERNAL_ERROR_CODE error = RRP_NO_ERROR;
+
+	if (session->endpoints != NULL) {
+		return connectSessionEndpoint(session);
+	}
+
+	if (session->registrarID == NULL) {
+		session->connection = RRPOpenLocalConnection(session->host);
+		if (session->connection == NULL) {
+			return -1;
+		}
+		RRPSetConnectionBlocking(session->connection, 0);
+		return 0;
+	}
+
+	session->connection = RRPOpenConnection(session->host, session->port);
+	if (session->connection == NULL) {
+		return -1;
+	}
+
+	/*
+	** Log in while the connection is still in blocking mode
+	*/
+	if ((session->governor != NULL &&
+		RRPWaitGovernor(session->governor, RRP_SESSION_COMMAND) < 0) ||
+		RRPLoginConnection(session->connection, session->registrarID,
+		session->registrarPassword) < 0 ||
+		RRPSetConnectionBlocking(session->connection, 0) < 0) {
+		error = RRPGetInternalErrorCode();
+		RRPFreeConnection(session->connection);
+		session->connection = NULL;
+		RRPSetInternalErrorCode(error);
+		return -1;
+	}
+
+	return 0;
+
+} /* connectSession */
+
+
+
+
+
+
+/*
+** Opens the connection of a session on the endpoint its set picks, then
+** on the next one picked if that fails, trying as many times as the set
+** has endpoints. The time taken to connect and log in, or the failure,
+** is reported to the set. Returns 0 if successful. Returns -1 and sets
+** error code if no endpoint could be connected to.
+*/
+static int
+connectSessionEndpoint (
+	RRPSESSION* session
+) {
+	RRPINTERNAL_ERROR_CODE error = RRP_SOCKET_CONNECT_ERROR;
+	struct timespec started;
+	char* host = NULL;
+	int port = 0;
+	int attempts = 0;
+	int index = 0;
+
+	attempts = RRPGetEndpointCount(session->endpoints);
+
+	while (attempts-- > 0) {
+		/*
+		** Wait for the governor first, so that the pause is not taken
+		** for the endpoint's latency
+		*/
+		if (session->governor != NULL &&
+			RRPWaitGovernor(session->governor, RRP_SESSION_COMMAND) < 0) {
+			return -1;
+		}
+
+		index = RRPPickEndpoint(session->endpoints);
+		if (index < 0) {
+			return -1;
+		}
+
+		host = RRPGetEndpointHost(session->endpoints, index);
+		port = RRPGetEndpointPort(session->endpoints, index);
+
+		clock_gettime(CLOCK_MONOTONIC, &started);
+		session->connection = RRPOpenConnection(host,
+			(unsigned short int) port);
+
+		if (session->connection != NULL &&
+			RRPLoginConnection(session->connection, session->registrarID,
+			session->registrarPassword) == 0 &&
+			RRPSetConnectionBlocking(session->connection, 0) == 0) {
+			session->endpoint = index;
+			RRPReportEndpoint(session->endpoints, index,
+				RRP_ENDPOINT_CONNECTED, getSessionElapsed(&started));
+			return 0;
+		}
+
+		error = RRPGetInternalErrorCode();
+		if (session->connection != NULL) {
+			RRPFreeConnection(session->connection);
+			session->connection = NULL;
+		}
+
+		/*
+		** A server that refuses the credentials is working, and the
+		** others will refuse them too
+		*/
+		if (error == RRP_SESSION_REFUSED_ERROR) {
+			RRPReleaseEndpoint(session->endpoints, index);
+			break;
+		}
+
+		RRPReportEndpoint(session->endpoints, index, RRP_ENDPOINT_FAILED, 0);
+		RRPReleaseEndpoint(session->endpoints, index);
+	}
+
+	RRPSetInternalErrorCode(error);
+
+	return -1;
+
+} /* connectSessionEndpoint */
+
+
+
+
+
+
+/*
+** Tries to open the lost connection of a session again. A failed
+** attempt is tried again after the delay of the session's policy, and
+** once the policy gives up the session is closed (see failSession()).
+** Returns -1 if the session was closed, 0 otherwise.
+*/
+static int
+redialSession (
+	RRPSESSION* session
+) {
+	RRPINTERNAL_ERROR_CODE error = RRP_NO_ERROR;
+	int delay = 0;
+
+	if (connectSession(session) == 0) {
+		session->broken = RRPFALSE;
+		memset(&session->redials, 0, sizeof(session->redials));
+		return 0;
+	}
+
+	error = RRPGetInternalErrorCode();
+
+	delay = RRPGetBackoffDelay(session->reconnect, &session->redials);
+	if (delay <= 0) {
+		failSession(session, error);
+		return -1;
+	}
+
+	setSessionTime(&session->redial, delay * 1000L);
+
+	return 0;
+
+} /* redialSession */
+
+
+
+
+
+
+/*
+** Stops counting a session on its endpoint, if it has one, and reports
+** a failure to the set if 'failed'. The callers do not hold a lost
+** connection against the endpoint when nothing was awaiting a response,
+** as servers close the sessions that stay idle.
+*/
+static void
+leaveSessionEndpoint (
+	RRPSESSION* session,
+	RRPBOOLEAN failed
+) {
+	if (session->endpoint < 0) {
+		return;
+	}
+
+	if (failed) {
+		RRPReportEndpoint(session->endpoints, session->endpoint,
+			RRP_ENDPOINT_FAILED, 0);
+	}
+	RRPReleaseEndpoint(session->endpoints, session->endpoint);
+	session->endpoint = -1;
+
+} /* leaveSessionEndpoint */
+
+
+
+
+
+
+/*
+** Ends the connection of a session that is leaving its endpoint, once
+** no request is awaiting a response, so that it is opened again right
+** away on another endpoint. Quit is sent if the connection takes it
+** without blocking; its response is not waited for.
+*/
+static void
+moveSession (
+	RRPSESSION* session
+) {
+	RRPWriteConnection(session->connection, "Quit\r\n.\r\n", 9);
+
+	leaveSessionEndpoint(session, RRPFALSE);
+	RRPFreeConnection(session->connection);
+	session->connection = NULL;
+	session->outputStart = 0;
+	session->outputLength = 0;
+	session->leaving = RRPFALSE;
+
+	session->broken = RRPTRUE;
+	memset(&session->redials, 0, sizeof(session->redials));
+	setSessionTime(&session->redial, 0);
+
+} /* moveSession */
+
+
+
+
+
+
+/*
+** Creates a session and opens its connection (see RRPOpenSession(),
+** RRPOpenEndpointSession() and RRPOpenBrokerSession()): to 'host' and
+** 'port', to the best of 'endpoints' if 'host' is NULL, or to the broker
+** whose socket is 'host' if there are no credentials.
+*/
+static RRPSESSION*
+openSession (
+	char* host,
+	unsigned short int port,
+	RRPENDPOINTS* endpoints,
+	char* registrarID,
+	char* registrarPassword
+) {
+	RRPSESSION* session = NULL;
+
+	session = (RRPSESSION*) calloc(1, sizeof(RRPSESSION));
+	if (session == NULL) {
+		RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
+		return NULL;
+	}
+
+	session->window = RRP_DEFAULT_SESSION_WINDOW;
+	session->governor = RRPGetProcessGovernor();
+	session->port = port;
+	session->endpoints = endpoints;
+	session->endpoint = -1;
+	if (host != NULL) {
+		session->host = copySessionString(host);
+	}
+	if (registrarID != NULL) {
+		session->registrarID = copySessionString(registrarID);
+		session->registrarPassword = copySessionString(registrarPassword);
+	}
+
+	if ((host != NULL && session->host == NULL) ||
+		(registrarID != NULL && (session->registrarID == NULL ||
+		session->registrarPassword == NULL))) {
+		freeSessionCredentials(session);
+		free(session);
+		RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
+		return NULL;
+	}
+
+	if (connectSession(session) < 0) {
+		freeSessionCredentials(session);
+		free(session);
+		return NULL;
+	}
+
+	return session;
+
+} /* openSession */
+
+
+
+
+
+
+/*
+** Creates a pool of sessions (see RRPCreateSessionPool(),
+** RRPCreateEndpointSessionPool() and RRPCreateBrokerSessionPool()).
+*/
+static RRPSESSIONPOOL*
+createSessionPool (
+	char* host,
+	unsigned short int port,
+	RRPENDPOINTS* endpoints,
+	char* registrarID,
+	char* registrarPassword,
+	int size
+) {
+	RRPSESSIONPOOL* pool = NULL;
+	RRPINTERNAL_ERROR_CODE error = RRP_NO_ERROR;
+	int i = 0;
+
+	pool = (RRPSESSIONPOOL*) calloc(1, sizeof(RRPSESSIONPOOL));
+	if (pool == NULL) {
+		RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
+		return NULL;
+	}
+
+	pool->sessions = (RRPSESSION**) calloc(size, sizeof(RRPSESSION*));
+	pool->descriptors = (struct pollfd*) calloc(size,
+		sizeof(struct pollfd));
+
+	if (pool->sessions == NULL || pool->descriptors == NULL) {
+		RRPFreeSessionPool(pool);
+		RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
+		return NULL;
+	}
+
+	for (i = 0; i < size; i++) {
+		pool->sessions[i] = openSession(host, port, endpoints, registrarID,
+			registrarPassword);
+
+		if (pool->sessions[i] == NULL) {
+			error = RRPGetInternalErrorCode();
+			RRPFreeSessionPool(pool);
+			RRPSetInternalErrorCode(error);
+			return NULL;
+		}
+
+		pool->size++;
+	}
+
+	return pool;
+
+} /* createSessionPool */
+
+
+
+
+
+
+/*
+** Frees the address and credentials of a session, overwriting the
+** password first.
+*/
+static void
+freeSessionCredentials (
+	RRPSESSION* session
+) {
+	if (session->registrarPassword != NULL) {
+		memset(session->registrarPassword, 0,
+			strlen(session->registrarPassword));
+	}
+
+	free(session->host);
+	free(session->registrarID);
+	free(session->registrarPassword);
+	session->host = NULL;
+	session->registrarID = NULL;
+	session->registrarPassword = NULL;
+
+} /* freeSessionCredentials */
+
+
+
+
+
+
+/*
+** Returns a copy of a string, or NULL if memory runs out.
+*/
+static char*
+copySessionString (
+	const char* string
+) {
+	char* copy = NULL;
+
+	copy = (char*) malloc(strlen(string) + 1);
+	if (copy != NULL) {
+		strcpy(copy, string);
+	}
+
+	return copy;
+
+} /* copySessionString */
+
+
+
+
+
+
+/*
+** Sets a time to 'wait' microseconds from now.
+*/
+static void
+setSessionTime (
+	struct timespec* time,
+	long wait
+) {
+	clock_gettime(CLOCK_MONOTONIC, time);
+	time->tv_sec += wait / 1000000;
+	time->tv_nsec += (wait % 1000000) * 1000;
+	if (time->tv_nsec >= 1000000000) {
+		time->tv_sec++;
+		time->tv_nsec -= 1000000000;
+	}
+
+} /* setSessionTime */
+
+
+
+
+
+
+/*
+** Returns the microseconds until a time, or 0 if it has passed.
+*/
+static long
+getSessionWait (
+	struct timespec* time
+) {
+	struct timespec now;
+	long wait = 0;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	wait = (long) (time->tv_sec - now.tv_sec) * 1000000 +
+		(time->tv_nsec - now.tv_nsec) / 1000;
+
+	return wait > 0 ? wait : 0;
+
+} /* getSessionWait */
+
+
+
+
+
+
+/*
+** Returns the microseconds since a time.
+*/
+static long
+getSessionElapsed (
+	struct timespec* time
+) {
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return (long) (now.tv_sec - time->tv_sec) * 1000000 +
+		(now.tv_nsec - time->tv_nsec) / 1000;
+
+} /* getSessionElapsed */
+
+
+
+
+
+
+/*
+** Submits the Check command of the next name of a batch in a slot. Names
+** whose request can not be created or submitted are marked as failed,
+** and the slot is left unused once all of the names have been submitted.
+*/
+static void
+submitCheck (
+	RRPCHECKSLOT* slot
+) {
+	RRPCHECKBATCH* batch = slot->batch;
+	RRPREQUEST* request = NULL;
+	char* name = NULL;
+
+	while (batch->next < batch->count) {
+		slot->index = batch->next++;
+		name = batch->names[slot->index];
+
+		request = (name != NULL) ? RRPCreateRequest(RRP_CHECK_COMMAND,
+			RRP_DOMAIN_ENTITY, name, strlen(name)) : NULL;
+
+		if (request != NULL) {
+			if (RRPSubmitPoolRequest(batch->pool, request, completeCheck,
+				slot) == 0) {
+				return;
+			}
+			RRPFreeRequest(request);
+		}
+
+		batch->completed++;
+	}
+
+} /* submitCheck */
+
+
+
+
+
+
+/*
+** Completion function of the Check commands of RRPCheckDomains(). Records
+** the result, then reuses the slot for the next name.
+*/
+static void
+completeCheck (
+	RRPREQUEST* request,
+	RRPRESPONSE* response,
+	void* context
+) {
+	RRPCHECKSLOT* slot = (RRPCHECKSLOT*) context;
+	RRPCHECKBATCH* batch = slot->batch;
+	RRPCHECKRESULT* result = &batch->results[slot->index];
+
+	if (response != NULL) {
+		result->code = response->code;
+		result->available = (response->code == RRP_DOMAIN_AVAILABLE_CODE) ?
+			RRPTRUE : RRPFALSE;
+		batch->checked++;
+		RRPFreeResponse(response);
+	}
+
+	batch->completed++;
+
+	submitCheck(slot);
+
+} /* completeCheck */
+
+
+
+
+
+
+/*
+** Takes the Check commands of a batch off the queues of its pool, so that
+** none refers to the batch any more. Those not written yet are freed;
+** those written are left to complete, their responses discarded.
+*/
+static void
+abandonChecks (
+	RRPCHECKBATCH* batch
+) {
+	RRPSESSION* session = NULL;
+	RRPPENDING* pending = NULL;
+	RRPPENDING* previous = NULL;
+	RRPPENDING* next = NULL;
+	RRPBOOLEAN written = RRPFALSE;
+	int i = 0;
+
+	for (i = 0; i < batch->pool->size; i++) {
+		session = batch->pool->sessions[i];
+		previous = NULL;
+		written = RRPTRUE;
+
+		for (pending = session->head; pending != NULL; pending = next) {
+			next = pending->next;
+			if (pending == session->unsent) {
+				written = RRPFALSE;
+			}
+
+			if (pending->completion != completeCheck ||
+				((RRPCHECKSLOT*) pending->context)->batch != batch) {
+				previous = pending;
+				continue;
+			}
+
+			if (written) {
+				pending->completion = discardCheck;
+				pending->context = NULL;
+				previous = pending;
+				continue;
+			}
+
+			if (previous == NULL) {
+				session->head = next;
+			}
+			else {
+				previous->next = next;
+			}
+			if (session->tail == pending) {
+				session->tail = previous;
+			}
+			if (session->unsent == pending) {
+				session->unsent = next;
+			}
+			session->pending--;
+
+			RRPFreeRequest(pending->request);
+			free(pending);
+		}
+	}
+
+} /* abandonChecks */
+
+
+
+
+
+
+/*
+** Completion function of the Check commands of a batch that was given
+** up (see abandonChecks())
+*/
+static void
+discardCheck (
+	RRPREQUEST* request,
+	RRPRESPONSE* response,
+	void* context
+) {
+	(void) request;
+	(void) context;
+
+	if (response != NULL) {
+		RRPFreeResponse(response);
+	}
+
+} /* discardCheck */
@@ -0,0 +1,427 @@
+/* ===========================================================================
+ * Copyright (C) 2000 VeriSign, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * VeriSign Global Registry Service
+ * 21345 Ridgetop Circle
+ * Dulles, VA 20166
+ * ===========================================================================
+ * The RRP, APIs and Software are provided "as-is" and without any warranty
+ * of any kind.  NSI EXPRESSLY DISCLAIMS ALL WARRANTIES AND/OR CONDITIONS,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * AND CONDITIONS OF MERCHANTABILITY OR SATISFACTORY QUALITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE AND NONINFRINGEMENT OF THIRD PARTY RIGHTS.  NSI DOES
+ * NOT WARRANT THAT THE FUNCTIONS CONTAINED IN THE RRP, APIs OR SOFTWARE
+ * WILL MEET REGISTRAR'S REQUIREMENTS, OR THAT THE OPERATION OF THE RRP,
+ * APIs OR SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE,OR THAT DEFECTS IN
+ * THE RRP, APIs OR SOFTWARE WILL BE CORRECTED.  FURTHERMORE, NSI DOES NOT
+ * WARRANT NOR MAKE ANY REPRESENTATIONS REGARDING THE USE OR THE RESULTS OF
+ * THE RRP, APIs, SOFTWARE OR RELATED DOCUMENTATION IN TERMS OF THEIR
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR OTHERWISE.  SHOULD THE RRP, APIs
+ * OR SOFTWARE PROVE DEFECTIVE, REGISTRAR ASSUMES THE ENTIRE COST OF ALL
+ * NECESSARY SERVICING, REPAIR OR CORRECTION.
+ * ======================================================================== */
+
+/*
+**
+** Module Name: rrpSweep.c
+**
+** Version: 2.1 for RRP version 2.1.0
+**
+** Date: Oct. 19th, 2026
+**
+** Description: rrpSweep checks the availability of a list of domain
+**              names. The names are read one per line from a file or
+**              from the standard input, and the Check commands are
+**              pipelined over a pool of sessions (see rrpSession.h):
+**              each name goes to the session with the fewest commands
+**              outstanding. The names are streamed, so lists of any
+**              length can be checked in constant memory.
+**
+**              One line is written for each name, in the order the
+**              responses arrive:
+**
+**                name,code,available,latency
+**
+**              where 'available' is 1 for response code 210 and the
+**              latency is in microseconds. The code of a name whose
+**              check failed is -1. Blank lines and lines starting with
+**              '#' are ignored.
+**
+**              The rate, the average and longest latency of the last
+**              second and the totals are displayed on the standard
+**              error once a second. The number of commands sent per
+**              second can be limited to stay within the registrar's
+**              quota (see rrpGovernor.h). A session whose connection
+**              drops logs in again and sends its checks again. An
+**              interrupt stops reading names; the commands already sent
+**              are completed before exiting.
+**
+** Usage:       rrpSweep -h host[,host...] [-p port] -u id [-w password]
+**                  [-s sessions] [-n window] [-r rate] [-i input]
+**                  [-o output] [-q]
+**
+**              The password is taken from the RRP_PASSWORD environment
+**              variable if -w is not given. Several servers may be
+**              given to -h, each as host or host:port; the sessions are
+**              then spread over them and leave those that fail (see
+**              rrpEndpoint.h).
+**
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/time.h>
+#include "rrpAPI.h"
+#include "rrpSession.h"
+#include "rrpGovernor.h"
+#include "rrpRetry.h"
+#include "rrpEndpoint.h"
+#include "rrpInternalError.h"
+#include "rrpTool.h"
+
+/*
+** Longest name accepted, and size of the output buffer
+*/
+#define SWEEP_MAX_NAME 256
+#define SWEEP_OUTPUT_BUFFER 65536
+
+/*
+** A Check command in flight
+*/
+typedef struct _SWEEPSLOT  SWEEPSLOT;
+
+struct _SWEEPSLOT {
+	char name[SWEEP_MAX_NAME];
+	struct timeval sent;
+	SWEEPSLOT* next;            /* next free slot */
+};
+
+/*
+** Counters, for the whole sweep and for the current display interval
+*/
+typedef struct {
+	unsigned long checked;
+	unsigned long available;
+	unsigned long failed;
+	unsigned long intervalCount;
+	double intervalLatency;     /* microseconds */
+	double intervalMaxLatency;
+} SWEEPSTATS;
+
+static FILE* output = NULL;
+static SWEEPSLOT* freeSlots = NULL;
+static int inFlight = 0;
+static SWEEPSTATS stats;
+
+static void usage (char*);
+static void completeCheck (RRPREQUEST*, RRPRESPONSE*, void*);
+static void display (double);
+
+int
+main (
+	int argc,
+	char** argv
+) {
+	RRPSESSIONPOOL* pool = NULL;
+	RRPGOVERNOR* governor = NULL;
+	RRPRETRYPOLICY* reconnect = NULL;
+	RRPENDPOINTS* endpoints = NULL;
+	RRPREQUEST* request = NULL;
+	SWEEPSLOT* slots = NULL;
+	SWEEPSLOT* slot = NULL;
+	FILE* input = stdin;
+	char* host = NULL;
+	char* registrarID = NULL;
+	char* registrarPassword = getenv("RRP_PASSWORD");
+	char* inputName = NULL;
+	char* outputName = NULL;
+	unsigned short int port = 648;
+	int sessions = 4;
+	int window = RRP_DEFAULT_SESSION_WINDOW;
+	int quiet = 0;
+	int endOfInput = 0;
+	int slotCount = 0;
+	int timeout = 0;
+	int option = 0;
+	int i = 0;
+	long wait = 0;
+	double rate = 0;
+	double interval = 0;
+	struct timeval start;
+	struct timeval now;
+	struct timeval shown;
+
+	while ((option = getopt(argc, argv, "h:p:u:w:s:n:r:i:o:q")) != -1) {
+		switch (option) {
+			case 'h': host = optarg; break;
+			case 'p': port = (unsigned short int) atoi(optarg); break;
+			case 'u': registrarID = optarg; break;
+			case 'w': registrarPassword = optarg; break;
+			case 's': sessions = atoi(optarg); break;
+			case 'n': window = atoi(optarg); break;
+			case 'r': rate = atof(optarg); break;
+			case 'i': inputName = optarg; break;
+			case 'o': outputName = optarg; break;
+			case 'q': quiet = 1; break;
+			default: usage(argv[0]);
+		}
+	}
+
+	if (host == NULL || registrarID == NULL || registrarPassword == NULL ||
+		sessions < 1 || window < 1 || rate < 0 || optind != argc) {
+		usage(argv[0]);
+	}
+
+	if (inputName != NULL && strcmp(inputName, "-") != 0 &&
+		(input = fopen(inputName, "r")) == NULL) {
+		perror(inputName);
+		exit(1);
+	}
+
+	output = stdout;
+	if (outputName != NULL && (output = fopen(outputName, "w")) == NULL) {
+		perror(outputName);
+		exit(1);
+	}
+	setvbuf(output, NULL, _IOFBF, SWEEP_OUTPUT_BUFFER);
+
+	/*
+	** One slot for each command the sessions send before waiting for a
+	** response
+	*/
+	slotCount = sessions * window;
+	slots = (SWEEPSLOT*) malloc(slotCount * sizeof(SWEEPSLOT));
+	if (slots == NULL) {
+		fprintf(stderr, "Out of memory\n");
+		exit(1);
+	}
+
+	for (i = 0; i < slotCount; i++) {
+		slots[i].next = freeSlots;
+		freeSlots = &slots[i];
+	}
+
+	pool = RRPOpenToolPool(host, port, registrarID, registrarPassword,
+		sessions, window, RRP_DEFAULT_RETRY_ATTEMPTS, &endpoints,
+		&reconnect);
+
+	governor = RRPCreateToolGovernor(rate);
+
+	RRPCatchToolSignals();
+
+	gettimeofday(&start, NULL);
+	shown = start;
+
+	while ((!endOfInput && !RRPToolInterrupted) || inFlight > 0) {
+		gettimeofday(&now, NULL);
+
+		wait = 0;
+
+		while (!endOfInput && !RRPToolInterrupted && freeSlots != NULL &&
+			(governor == NULL ||
+			(wait = RRPAcquireGovernor(governor, RRP_CHECK_COMMAND)) == 0)) {
+			slot = freeSlots;
+
+			if (!RRPReadToolName(input, slot->name, SWEEP_MAX_NAME)) {
+				endOfInput = 1;
+				break;
+			}
+
+			request = RRPCreateRequest(RRP_CHECK_COMMAND, RRP_DOMAIN_ENTITY,
+				slot->name, strlen(slot->name));
+
+			if (request == NULL) {
+				RRPPrintInternalErrorDescription();
+				endOfInput = 1;
+				break;
+			}
+
+			freeSlots = slot->next;
+			gettimeofday(&slot->sent, NULL);
+
+			if (RRPSubmitPoolRequest(pool, request, completeCheck, slot) < 0) {
+				/*
+				** No session is left
+				*/
+				RRPPrintInternalErrorDescription();
+				RRPFreeRequest(request);
+				slot->next = freeSlots;
+				freeSlots = slot;
+				endOfInput = 1;
+				break;
+			}
+
+			inFlight++;
+		}
+
+		/*
+		** Wait for responses, for the next token, or for the next display
+		*/
+		timeout = 1000 - (int) (RRPGetToolElapsed(&shown, &now) / 1000);
+		if (timeout < 0) {
+			timeout = 0;
+		}
+
+		if (wait > 0 && !endOfInput && freeSlots != NULL &&
+			wait / 1000 < timeout) {
+			timeout = (int) (wait / 1000) + 1;
+		}
+
+		if (inFlight > 0) {
+			if (RRPPollSessionPool(pool, timeout) < 0) {
+				RRPPrintInternalErrorDescription();
+				break;
+			}
+		}
+		else if (!endOfInput && !RRPToolInterrupted) {
+			poll(NULL, 0, timeout);
+		}
+
+		gettimeofday(&now, NULL);
+		interval = RRPGetToolElapsed(&shown, &now);
+
+		if (interval >= 1000000.0) {
+			if (!quiet) {
+				display(interval);
+			}
+			shown = now;
+		}
+	}
+
+	gettimeofday(&now, NULL);
+
+	if (!quiet) {
+		display(RRPGetToolElapsed(&shown, &now));
+	}
+
+	fflush(output);
+	if (output != stdout) {
+		fclose(output);
+	}
+
+	if (input != stdin) {
+		fclose(input);
+	}
+
+	RRPFreeSessionPool(pool);
+	RRPFreeRetryPolicy(reconnect);
+	RRPFreeEndpoints(endpoints);
+	if (governor != NULL) {
+		RRPFreeGovernor(governor);
+	}
+	free(slots);
+
+	interval = RRPGetToolElapsed(&start, &now) / 1000000.0;
+
+	fprintf(stderr, "%lu names checked in %.1f s (%.0f/s), %lu available, "
+		"%lu failed\n", stats.checked, interval,
+		interval > 0 ? stats.checked / interval : 0.0, stats.available,
+		stats.failed);
+
+	exit(stats.failed > 0 || RRPToolInterrupted ? 1 : 0);
+
+} /* main() */
+
+
+/*
+** Prints the usage message and exits
+*/
+static void
+usage (
+	char* program
+) {
+	RRPPrintToolUsage(program,
+		"\t[-s sessions] [-n window] [-r rate] [-i input] [-o output] [-q]\n",
+		"\t-i\tfile of names, one per line (default standard input)\n"
+		"\t-o\tresult file (default standard output)\n"
+		"\t-q\tdo not display the rate\n",
+		4);
+
+} /* usage() */
+
+
+/*
+** Completion function of the Check commands: writes the result line and
+** releases the slot
+*/
+static void
+completeCheck (
+	RRPREQUEST* request,
+	RRPRESPONSE* response,
+	void* context
+) {
+	SWEEPSLOT* slot = (SWEEPSLOT*) context;
+	struct timeval now;
+	double latency = 0;
+	int code = -1;
+
+	gettimeofday(&now, NULL);
+	latency = RRPGetToolElapsed(&slot->sent, &now);
+
+	if (response != NULL) {
+		code = response->code;
+		RRPFreeResponse(response);
+		stats.checked++;
+		if (code == RRP_DOMAIN_AVAILABLE_CODE) {
+			stats.available++;
+		}
+	}
+	else {
+		stats.failed++;
+	}
+
+	stats.intervalCount++;
+	stats.intervalLatency += latency;
+	if (latency > stats.intervalMaxLatency) {
+		stats.intervalMaxLatency = latency;
+	}
+
+	fprintf(output, "%s,%d,%d,%.0f\n", slot->name, code,
+		code == RRP_DOMAIN_AVAILABLE_CODE, latency);
+
+	slot->next = freeSlots;
+	freeSlots = slot;
+	inFlight--;
+
+} /* completeCheck() */
+
+
+/*
+** Displays the rate and latency of the last 'interval' microseconds and
+** the totals, then starts a new interval
+*/
+static void
+display (
+	double interval
+) {
+	fprintf(stderr, "%8.0f/s  latency avg %7.1f ms max %7.1f ms  "
+		"in flight %4d  checked %lu  available %lu  failed %lu\n",
+		interval > 0 ? stats.intervalCount * 1000000.0 / interval : 0.0,
+		stats.intervalCount > 0 ?
+			stats.intervalLatency / stats.intervalCount / 1000.0 : 0.0,
+		stats.intervalMaxLatency / 1000.0, inFlight, stats.checked,
+		stats.available, stats.failed);
+
+	stats.intervalCount = 0;
+	stats.intervalLatency = 0;
+	stats.intervalMaxLatency = 0;
+
+} /* display() */
@@ -0,0 +1,431 @@
+/* ===========================================================================
+ * Copyright (C) 2000 VeriSign, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * VeriSign Global Registry Service
+ * 21345 Ridgetop Circle
+ * Dulles, VA 20166
+ * ===========================================================================
+ * The RRP, APIs and Software are provided "as-is" and without any warranty
+ * of any kind.  NSI EXPRESSLY DISCLAIMS ALL WARRANTIES AND/OR CONDITIONS,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * AND CONDITIONS OF MERCHANTABILITY OR SATISFACTORY QUALITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE AND NONINFRINGEMENT OF THIRD PARTY RIGHTS.  NSI DOES
+ * NOT WARRANT THAT THE FUNCTIONS CONTAINED IN THE RRP, APIs OR SOFTWARE
+ * WILL MEET REGISTRAR'S REQUIREMENTS, OR THAT THE OPERATION OF THE RRP,
+ * APIs OR SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE,OR THAT DEFECTS IN
+ * THE RRP, APIs OR SOFTWARE WILL BE CORRECTED.  FURTHERMORE, NSI DOES NOT
+ * WARRANT NOR MAKE ANY REPRESENTATIONS REGARDING THE USE OR THE RESULTS OF
+ * THE RRP, APIs, SOFTWARE OR RELATED DOCUMENTATION IN TERMS OF THEIR
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR OTHERWISE.  SHOULD THE RRP, APIs
+ * OR SOFTWARE PROVE DEFECTIVE, REGISTRAR ASSUMES THE ENTIRE COST OF ALL
+ * NECESSARY SERVICING, REPAIR OR CORRECTION.
+ * ======================================================================== */
+
+/*
+**
+** Module Name: rrpTool.c
+**
+** Version: 2.1 for RRP version 2.1.0
+**
+** Date: Oct. 19th, 2026
+**
+** Description: rrpTool holds what the bulk command line tools have in
+**              common (see rrpTool.h)
+**
+** Entry Points:
+**
+**    RRPPrintToolUsage(char*, char*, char*, int);
+**    RRPCatchToolSignals(void);
+**    RRPOpenToolPool(char*, unsigned short int, char*, char*, int, int,
+**       int, RRPENDPOINTS**, RRPRETRYPOLICY**);
+**    RRPCreateToolGovernor(double);
+**    RRPHashToolName(const char*);
+**    RRPReadToolName(FILE*, char*, size_t);
+**    RRPGetToolElapsed(struct timeval*, struct timeval*);
+**
+** Changes:
+**
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include "rrpTool.h"
+#include "rrpInternalError.h"
+
+/*
+** Longest line of a file of names
+*/
+#define RRP_TOOL_MAX_LINE 1024
+
+volatile sig_atomic_t RRPToolInterrupted = 0;
+
+/*
+** Functions used internally by the tools
+*/
+static void interruptTool (int);
+
+
+
+
+/*
+**
+** Function: RRPPrintToolUsage
+**
+** Description: Prints the usage of a tool, followed by the options all
+**              of the tools share (-h, -s, -n and -r), then exits with
+**              status 2
+**
+** Input: char* - the name of the program
+**        char* - the rest of the synopsis, after the options that log
+**                in, each line starting with a tab
+**        char* - the description of the options of the tool, a line
+**                each
+**        int - the default number of sessions
+**
+** Output: none
+**
+** Return: none
+**
+*/
+
+void
+RRPPrintToolUsage (
+	char* program,
+	char* synopsis,
+	char* options,
+	int sessions
+) {
+	fprintf(stderr, "Usage: %s -h host[,host...] [-p port] -u id "
+		"[-w password]\n"
+		"%s"
+		"\n"
+		"%s"
+		"\t-h\tservers separated by commas, each host or host:port\n"
+		"\t-s\tnumber of sessions, at most MaxSessions (default %d)\n"
+		"\t-n\tcommands each session sends before waiting (default %d)\n"
+		"\t-r\tmost commands sent per second (default no limit)\n"
+		"\n"
+		"The password is read from RRP_PASSWORD if -w is not given.\n",
+		program, synopsis, options, sessions, RRP_DEFAULT_SESSION_WINDOW);
+	exit(2);
+
+} /* RRPPrintToolUsage */
+
+
+
+
+
+
+/*
+**
+** Function: RRPCatchToolSignals
+**
+** Description: Makes SIGINT and SIGTERM set RRPToolInterrupted instead
+**              of killing the process, so that a tool can finish the
+**              commands in flight before it stops
+**
+** Input: none
+**
+** Output: none
+**
+** Return: none
+**
+*/
+
+void
+RRPCatchToolSignals (
+	void
+) {
+	signal(SIGINT, interruptTool);
+	signal(SIGTERM, interruptTool);
+
+} /* RRPCatchToolSignals */
+
+
+
+
+
+
+/*
+**
+** Function: RRPOpenToolPool
+**
+** Description: Opens a pool of sessions on the servers given to -h (see
+**              RRPParseEndpoints()), with the window given to -n. The
+**              sessions log in again when their connections drop, so
+**              that a long run keeps going (see
+**              RRPSetSessionPoolReconnect()). Exits if the server list
+**              is invalid (status 2) or if the pool can not be opened
+**              (status 1)
+**
+** Input: char* - the server list
+**        unsigned short int - the default port
+**        char* - the registrar's id
+**        char* - the registrar's password
+**        int - the number of sessions
+**        int - the window of each session
+**        int - the attempts to reopen a connection
+**
+** Output: RRPENDPOINTS** - the set of servers, to be freed after the
+**                          pool
+**         RRPRETRYPOLICY** - the reconnection policy, to be freed
+**                            after the pool
+**
+** Return: RRPSESSIONPOOL* - the pool
+**
+*/
+
+RRPSESSIONPOOL*
+RRPOpenToolPool (
+	char* host,
+	unsigned short int port,
+	char* registrarID,
+	char* registrarPassword,
+	int sessions,
+	int window,
+	int attempts,
+	RRPENDPOINTS** endpoints,
+	RRPRETRYPOLICY** reconnect
+) {
+	RRPSESSIONPOOL* pool = NULL;
+
+	*endpoints = RRPParseEndpoints(host, port);
+	if (*endpoints == NULL) {
+		fprintf(stderr, "Bad server list: %s\n", host);
+		exit(2);
+	}
+
+	pool = RRPCreateEndpointSessionPool(*endpoints, registrarID,
+		registrarPassword, sessions);
+	if (pool == NULL) {
+		RRPPrintInternalErrorDescription();
+		exit(1);
+	}
+
+	RRPSetSessionPoolWindow(pool, window);
+
+	/*
+	** Keep going when a connection drops or the server closes it
+	*/
+	*reconnect = RRPCreateRetryPolicy(attempts, RRP_DEFAULT_RETRY_BASE,
+		RRP_DEFAULT_RETRY_CEILING);
+	if (*reconnect == NULL) {
+		RRPPrintInternalErrorDescription();
+		exit(1);
+	}
+	RRPSetSessionPoolReconnect(pool, *reconnect);
+
+	return pool;
+
+} /* RRPOpenToolPool */
+
+
+
+
+
+
+/*
+**
+** Function: RRPCreateToolGovernor
+**
+** Description: Creates the governor that keeps a tool to the rate given
+**              to -r: at most 'rate' commands per second, and a second's
+**              worth at once. Exits with status 1 if it can not be
+**              created
+**
+** Input: double - commands per second, 0 for no limit
+**
+** Output: none
+**
+** Return: RRPGOVERNOR* - the governor, NULL if 'rate' is 0
+**
+*/
+
+RRPGOVERNOR*
+RRPCreateToolGovernor (
+	double rate
+) {
+	RRPGOVERNOR* governor = NULL;
+
+	if (rate <= 0) {
+		return NULL;
+	}
+
+	governor = RRPCreateGovernor(rate, rate > 1 ? (int) rate : 1);
+	if (governor == NULL) {
+		RRPPrintInternalErrorDescription();
+		exit(1);
+	}
+
+	return governor;
+
+} /* RRPCreateToolGovernor */
+
+
+
+
+
+
+/*
+**
+** Function: RRPHashToolName
+**
+** Description: Returns the hash value of a string, for the tables in
+**              which tools look their records up by name
+**
+** Input: const char* - the string
+**
+** Output: none
+**
+** Return: unsigned long - the hash value
+**
+*/
+
+unsigned long
+RRPHashToolName (
+	const char* name
+) {
+	unsigned long hash = 5381;
+
+	while (*name != '\0') {
+		hash = hash * 33 + (unsigned char) *name++;
+	}
+
+	return hash;
+
+} /* RRPHashToolName */
+
+
+
+
+
+
+/*
+**
+** Function: RRPReadToolName
+**
+** Description: Reads the next name from a file of names, one per line:
+**              the first field of the line. Blank lines and comments
+**              ('#') are skipped, as are names that do not fit
+**
+** Input: FILE* - the file
+**        size_t - the size of the buffer receiving the name
+**
+** Output: char* - the name
+**
+** Return: int - 1 if a name was read, 0 at the end of the file
+**
+*/
+
+int
+RRPReadToolName (
+	FILE* input,
+	char* name,
+	size_t size
+) {
+	char line[RRP_TOOL_MAX_LINE];
+	char* field = NULL;
+	size_t length = 0;
+	int tooLong = 0;
+
+	while (fgets(line, sizeof(line), input) != NULL) {
+		length = strlen(line);
+
+		/*
+		** Skip the rest of a line that did not fit
+		*/
+		if (length > 0 && line[length - 1] != '\n' && !feof(input)) {
+			tooLong = 1;
+			continue;
+		}
+
+		if (tooLong) {
+			tooLong = 0;
+			fprintf(stderr, "Name too long, skipped\n");
+			continue;
+		}
+
+		field = line + strspn(line, " \t\r\n");
+		length = strcspn(field, " \t\r\n");
+
+		if (length == 0 || *field == '#') {
+			continue;
+		}
+
+		if (length >= size) {
+			fprintf(stderr, "Name too long, skipped\n");
+			continue;
+		}
+
+		memcpy(name, field, length);
+		name[length] = '\0';
+		return 1;
+	}
+
+	return 0;
+
+} /* RRPReadToolName */
+
+
+
+
+
+
+/*
+**
+** Function: RRPGetToolElapsed
+**
+** Description: Returns the time between two instants
+**
+** Input: struct timeval* - the first instant
+**        struct timeval* - the second instant
+**
+** Output: none
+**
+** Return: double - the time from the first to the second instant, in
+**                  microseconds
+**
+*/
+
+double
+RRPGetToolElapsed (
+	struct timeval* from,
+	struct timeval* to
+) {
+	return (to->tv_sec - from->tv_sec) * 1000000.0 +
+		(to->tv_usec - from->tv_usec);
+
+} /* RRPGetToolElapsed */
+
+
+
+
+
+
+/*
+** Signal handler: the tool stops starting new work
+*/
+static void
+interruptTool (
+	int signalNumber
+) {
+	RRPToolInterrupted = 1;
+	signal(signalNumber, interruptTool);
+
+} /* interruptTool */
@@ -0,0 +1,227 @@
+/* ===========================================================================
+ * Copyright (C) 2000 VeriSign, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * VeriSign Global Registry Service
+ * 21345 Ridgetop Circle
+ * Dulles, VA 20166
+ * ===========================================================================
+ * The RRP, APIs and Software are provided "as-is" and without any warranty
+ * of any kind.  NSI EXPRESSLY DISCLAIMS ALL WARRANTIES AND/OR CONDITIONS,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * AND CONDITIONS OF MERCHANTABILITY OR SATISFACTORY QUALITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE AND NONINFRINGEMENT OF THIRD PARTY RIGHTS.  NSI DOES
+ * NOT WARRANT THAT THE FUNCTIONS CONTAINED IN THE RRP, APIs OR SOFTWARE
+ * WILL MEET REGISTRAR'S REQUIREMENTS, OR THAT THE OPERATION OF THE RRP,
+ * APIs OR SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE,OR THAT DEFECTS IN
+ * THE RRP, APIs OR SOFTWARE WILL BE CORRECTED.  FURTHERMORE, NSI DOES NOT
+ * WARRANT NOR MAKE ANY REPRESENTATIONS REGARDING THE USE OR THE RESULTS OF
+ * THE RRP, APIs, SOFTWARE OR RELATED DOCUMENTATION IN TERMS OF THEIR
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR OTHERWISE.  SHOULD THE RRP, APIs
+ * OR SOFTWARE PROVE DEFECTIVE, REGISTRAR ASSUMES THE ENTIRE COST OF ALL
+ * NECESSARY SERVICING, REPAIR OR CORRECTION.
+ * ======================================================================== */
+
+/*
+**
+** Module Name: rrpTool.h
+**
+** Version: 2.1 for RRP version 2.1.0
+**
+** Date: Oct. 19th, 2026
+**
+** Description: rrpTool holds what the bulk command line tools (rrpSweep,
+**              rrpMigrate, rrpTransfer, ...) have in common: the options
+**              that open a pool of sessions on a set of servers, the
+**              signals that stop a run, and small helpers for reading
+**              names and hashing them. It is linked into each tool and
+**              is not part of the RRP API libraries.
+**
+**              Errors are reported on the standard error, and the
+**              functions that set a tool up exit rather than return
+**              when they fail, as the tools themselves do.
+**
+** Entry Points:
+**
+**    RRPPrintToolUsage(char*, char*, char*, int);
+**    RRPCatchToolSignals(void);
+**    RRPOpenToolPool(char*, unsigned short int, char*, char*, int, int,
+**       int, RRPENDPOINTS**, RRPRETRYPOLICY**);
+**    RRPCreateToolGovernor(double);
+**    RRPHashToolName(const char*);
+**    RRPReadToolName(FILE*, char*, size_t);
+**    RRPGetToolElapsed(struct timeval*, struct timeval*);
+**
+** Changes:
+**
+*/
+
+#ifndef _RRP_TOOL_H_
+#define _RRP_TOOL_H_
+
+#include <stdio.h>
+#include <signal.h>
+#include <sys/time.h>
+#include "rrpSession.h"
+#include "rrpGovernor.h"
+#include "rrpRetry.h"
+#include "rrpEndpoint.h"
+
+/*
+** Set once SIGINT or SIGTERM is received (see RRPCatchToolSignals())
+*/
+extern volatile sig_atomic_t RRPToolInterrupted;
+
+/*
+**
+** Function: RRPPrintToolUsage
+**
+** Description: Prints the usage of a tool, followed by the options all
+**              of the tools share (-h, -s, -n and -r), then exits with
+**              status 2
+**
+** Input: char* - the name of the program
+**        char* - the rest of the synopsis, after the options that log
+**                in, each line starting with a tab
+**        char* - the description of the options of the tool, a line
+**                each
+**        int - the default number of sessions
+**
+** Output: none
+**
+** Return: none
+**
+*/
+void RRPPrintToolUsage(char*, char*, char*, int);
+
+/*
+**
+** Function: RRPCatchToolSignals
+**
+** Description: Makes SIGINT and SIGTERM set RRPToolInterrupted instead
+**              of killing the process, so that a tool can finish the
+**              commands in flight before it stops
+**
+** Input: none
+**
+** Output: none
+**
+** Return: none
+**
+*/
+void RRPCatchToolSignals(void);
+
+/*
+**
+** Function: RRPOpenToolPool
+**
+** Description: Opens a pool of sessions on the servers given to -h (see
+**              RRPParseEndpoints()), with the window given to -n. The
+**              sessions log in again when their connections drop, so
+**              that a long run keeps going (see
+**              RRPSetSessionPoolReconnect()). Exits if the server list
+**              is invalid (status 2) or if the pool can not be opened
+**              (status 1)
+**
+** Input: char* - the server list
+**        unsigned short int - the default port
+**        char* - the registrar's id
+**        char* - the registrar's password
+**        int - the number of sessions
+**        int - the window of each session
+**        int - the attempts to reopen a connection
+**
+** Output: RRPENDPOINTS** - the set of servers, to be freed after the
+**                          pool
+**         RRPRETRYPOLICY** - the reconnection policy, to be freed
+**                            after the pool
+**
+** Return: RRPSESSIONPOOL* - the pool
+**
+*/
+RRPSESSIONPOOL* RRPOpenToolPool(char*, unsigned short int, char*, char*,
+	int, int, int, RRPENDPOINTS**, RRPRETRYPOLICY**);
+
+/*
+**
+** Function: RRPCreateToolGovernor
+**
+** Description: Creates the governor that keeps a tool to the rate given
+**              to -r: at most 'rate' commands per second, and a second's
+**              worth at once. Exits with status 1 if it can not be
+**              created
+**
+** Input: double - commands per second, 0 for no limit
+**
+** Output: none
+**
+** Return: RRPGOVERNOR* - the governor, NULL if 'rate' is 0
+**
+*/
+RRPGOVERNOR* RRPCreateToolGovernor(double);
+
+/*
+**
+** Function: RRPHashToolName
+**
+** Description: Returns the hash value of a string, for the tables in
+**              which tools look their records up by name
+**
+** Input: const char* - the string
+**
+** Output: none
+**
+** Return: unsigned long - the hash value
+**
+*/
+unsigned long RRPHashToolName(const char*);
+
+/*
+**
+** Function: RRPReadToolName
+**
+** Description: Reads the next name from a file of names, one per line:
+**              the first field of the line. Blank lines and comments
+**              ('#') are skipped, as are names that do not fit
+**
+** Input: FILE* - the file
+**        size_t - the size of the buffer receiving the name
+**
+** Output: char* - the name
+**
+** Return: int - 1 if a name was read, 0 at the end of the file
+**
+*/
+int RRPReadToolName(FILE*, char*, size_t);
+
+/*
+**
+** Function: RRPGetToolElapsed
+**
+** Description: Returns the time between two instants
+**
+** Input: struct timeval* - the first instant
+**        struct timeval* - the second instant
+**
+** Output: none
+**
+** Return: double - the time from the first to the second instant, in
+**                  microseconds
+**
+*/
+double RRPGetToolElapsed(struct timeval*, struct timeval*);
+
+#endif /* _RRP_TOOL_H_ */
@@ -0,0 +1,687 @@
+/* ===========================================================================
+ * Copyright (C) 2000 VeriSign, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * VeriSign Global Registry Service
+ * 21345 Ridgetop Circle
+ * Dulles, VA 20166
+ * ===========================================================================
+ * The RRP, APIs and Software are provided "as-is" and without any warranty
+ * of any kind.  NSI EXPRESSLY DISCLAIMS ALL WARRANTIES AND/OR CONDITIONS,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * AND CONDITIONS OF MERCHANTABILITY OR SATISFACTORY QUALITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE AND NONINFRINGEMENT OF THIRD PARTY RIGHTS.  NSI DOES
+ * NOT WARRANT THAT THE FUNCTIONS CONTAINED IN THE RRP, APIs OR SOFTWARE
+ * WILL MEET REGISTRAR'S REQUIREMENTS, OR THAT THE OPERATION OF THE RRP,
+ * APIs OR SOFTWARE WILL BE UNINTERRUPTED OR ERROR-FREE,OR THAT DEFECTS IN
+ * THE RRP, APIs OR SOFTWARE WILL BE CORRECTED.  FURTHERMORE, NSI DOES NOT
+ * WARRANT NOR MAKE ANY REPRESENTATIONS REGARDING THE USE OR THE RESULTS OF
+ * THE RRP, APIs, SOFTWARE OR RELATED DOCUMENTATION IN TERMS OF THEIR
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR OTHERWISE.  SHOULD THE RRP, APIs
+ * OR SOFTWARE PROVE DEFECTIVE, REGISTRAR ASSUMES THE ENTIRE COST OF ALL
+ * NECESSARY SERVICING, REPAIR OR CORRECTION.
+ * ======================================================================== */
+
+/*
+**
+** Module Name: rrpTransfer.c
+**
+** Version: 2.1 for RRP version 2.1.0
+**
+** Date: Oct. 19th, 2026
+**
+** Description: rrpTransfer answers pending transfer requests and
+**              synchronizes expiration dates in bulk. The decisions are
+**              read one per line:
+**
+**                domain approve
+**                domain reject
+**                domain sync mm-dd
+**
+**              (fields separated by commas or white space) from a file
+**              or from the standard input, which can be a pipe fed by a
+**              queue: records are sent as soon as they arrive. The
+**              Transfer commands (with -Approve:yes or -Approve:no) and
+**              Sync commands are pipelined over a pool of sessions (see
+**              rrpSession.h). The commands of one domain are never in
+**              flight at the same time: a later decision for a domain
+**              being processed waits until the earlier one completes.
+**              One line is written for each record, in the order the
+**              records complete:
+**
+**                domain,action,result,code
+**
+**              where result is "done", "refused" (code is the response
+**              code) or "failed" (the session failed; code is 0). A
+**              session that fails logs in again for the records it had
+**              not sent yet.
+**
+** Usage:       rrpTransfer -h host[,host...] [-p port] -u id [-w password]
+**                  [-i input] [-o results] [-s sessions] [-n window]
+**                  [-j journal] [-r rate] [-q]
+**
+**              The password is taken from the RRP_PASSWORD environment
+**              variable if -w is not given. Several servers may be
+**              given to -h, each as host or host:port; the sessions are
+**              then spread over them and leave those that fail (see
+**              rrpEndpoint.h). With -j the Transfer and Sync commands
+**              are recorded in a journal before they are sent (see
+**              rrpJournal.h and rrpRecover).
+**
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <ctype.h>
+#include <signal.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/time.h>
+#include "rrpAPI.h"
+#include "rrpSession.h"
+#include "rrpGovernor.h"
+#include "rrpRetry.h"
+#include "rrpEndpoint.h"
+#include "rrpJournal.h"
+#include "rrpInternalError.h"
+#include "rrpTool.h"
+
+/*
+** Longest line and name accepted, and number of buckets of the table of
+** domains in flight
+*/
+#define TRANSFER_MAX_LINE 512
+#define TRANSFER_MAX_NAME 256
+#define TRANSFER_BUCKETS 4096
+
+/*
+** Actions of a record
+*/
+#define TRANSFER_APPROVE 0
+#define TRANSFER_REJECT 1
+#define TRANSFER_SYNC 2
+
+/*
+** Results of a record
+*/
+#define TRANSFER_DONE 0
+#define TRANSFER_REFUSED 1
+#define TRANSFER_FAILED 2
+
+/*
+** A record being processed. The first record of a domain name is linked
+** in the table of domains in flight; the records of the same domain read
+** after it wait in its 'waiting' list
+*/
+typedef struct _TRANSFERSLOT  TRANSFERSLOT;
+
+struct _TRANSFERSLOT {
+	char name[TRANSFER_MAX_NAME];
+	char date[6];               /* mm-dd, for Sync */
+	int action;
+	unsigned long hash;
+	TRANSFERSLOT* next;         /* next free slot, or next in the table */
+	TRANSFERSLOT* waiting;      /* next record of the same domain */
+};
+
+/*
+** Input not yet split into lines
+*/
+typedef struct {
+	int descriptor;
+	char buffer[TRANSFER_MAX_LINE];
+	size_t length;
+	int skipping;               /* discarding the rest of a long line */
+	int endOfFile;
+} TRANSFERINPUT;
+
+static TRANSFERSLOT* flightTable[TRANSFER_BUCKETS];
+static TRANSFERINPUT input;
+static RRPSESSIONPOOL* pool = NULL;
+static FILE* results = NULL;
+static TRANSFERSLOT* freeSlots = NULL;
+static int inFlight = 0;
+static unsigned long done[3];
+static unsigned long refused = 0;
+static unsigned long failed = 0;
+static const char* actionNames[3] = {
+	"approve", "reject", "sync"
+};
+static const char* resultNames[3] = {
+	"done", "refused", "failed"
+};
+
+static void usage (char*);
+static int readLine (char*, int);
+static int parseRecord (char*, TRANSFERSLOT*);
+static void startRecord (TRANSFERSLOT*);
+static void finishRecord (TRANSFERSLOT*, int, int);
+static void completeRecord (RRPREQUEST*, RRPRESPONSE*, void*);
+
+int
+main (
+	int argc,
+	char** argv
+) {
+	TRANSFERSLOT* slots = NULL;
+	TRANSFERSLOT* slot = NULL;
+	TRANSFERSLOT* first = NULL;
+	RRPGOVERNOR* governor = NULL;
+	RRPRETRYPOLICY* reconnect = NULL;
+	RRPENDPOINTS* endpoints = NULL;
+	RRPJOURNAL* journal = NULL;
+	char* host = NULL;
+	char* registrarID = NULL;
+	char* registrarPassword = getenv("RRP_PASSWORD");
+	char* inputName = NULL;
+	char* resultName = NULL;
+	char* journalName = NULL;
+	char line[TRANSFER_MAX_LINE];
+	unsigned short int port = 648;
+	unsigned long lineNumber = 0;
+	unsigned long total = 0;
+	unsigned long lastTotal = 0;
+	int sessions = 4;
+	int window = RRP_DEFAULT_SESSION_WINDOW;
+	int quiet = 0;
+	int endOfInput = 0;
+	int slotCount = 0;
+	int option = 0;
+	int result = 0;
+	int i = 0;
+	double rate = 0;
+	struct timeval now;
+	struct timeval shown;
+
+	while ((option = getopt(argc, argv, "h:p:u:w:i:o:j:s:n:r:q")) != -1) {
+		switch (option) {
+			case 'h': host = optarg; break;
+			case 'p': port = (unsigned short int) atoi(optarg); break;
+			case 'u': registrarID = optarg; break;
+			case 'w': registrarPassword = optarg; break;
+			case 'i': inputName = optarg; break;
+			case 'o': resultName = optarg; break;
+			case 'j': journalName = optarg; break;
+			case 's': sessions = atoi(optarg); break;
+			case 'n': window = atoi(optarg); break;
+			case 'r': rate = atof(optarg); break;
+			case 'q': quiet = 1; break;
+			default: usage(argv[0]);
+		}
+	}
+
+	if (host == NULL || registrarID == NULL || registrarPassword == NULL ||
+		sessions < 1 || window < 1 || rate < 0 || optind != argc) {
+		usage(argv[0]);
+	}
+
+	if (inputName == NULL || strcmp(inputName, "-") == 0) {
+		inputName = "stdin";
+		input.descriptor = 0;
+	}
+	else if ((input.descriptor = open(inputName, O_RDONLY)) < 0) {
+		perror(inputName);
+		exit(1);
+	}
+
+	results = stdout;
+	if (resultName != NULL && (results = fopen(resultName, "w")) == NULL) {
+		perror(resultName);
+		exit(1);
+	}
+
+	slotCount = sessions * window;
+	slots = (TRANSFERSLOT*) malloc(slotCount * sizeof(TRANSFERSLOT));
+	if (slots == NULL) {
+		fprintf(stderr, "Out of memory\n");
+		exit(1);
+	}
+
+	for (i = 0; i < slotCount; i++) {
+		slots[i].next = freeSlots;
+		freeSlots = &slots[i];
+	}
+
+	/*
+	** The sessions, and their logins, share the process governor
+	*/
+	if ((governor = RRPCreateToolGovernor(rate)) != NULL) {
+		RRPSetProcessGovernor(governor);
+	}
+
+	pool = RRPOpenToolPool(host, port, registrarID, registrarPassword,
+		sessions, window, RRP_DEFAULT_RETRY_ATTEMPTS, &endpoints,
+		&reconnect);
+
+	/*
+	** Every command is recorded before it is sent, so that those whose
+	** outcome is lost can be listed afterwards (see rrpRecover)
+	*/
+	if (journalName != NULL) {
+		journal = RRPOpenJournal(journalName);
+		if (journal == NULL) {
+			RRPPrintInternalErrorDescription();
+			exit(1);
+		}
+		RRPSetJournalCommand(journal, RRP_SYNC_COMMAND, RRPTRUE);
+		RRPSetSessionPoolJournal(pool, journal);
+	}
+
+	RRPCatchToolSignals();
+
+	gettimeofday(&shown, NULL);
+
+	while ((!endOfInput && !RRPToolInterrupted) || inFlight > 0) {
+		while (!endOfInput && !RRPToolInterrupted && freeSlots != NULL) {
+			slot = freeSlots;
+
+			/*
+			** Wait for input only when there are no responses to wait
+			** for
+			*/
+			result = readLine(line, inFlight > 0 ? 0 : 1000);
+			if (result < 0) {
+				endOfInput = 1;
+			}
+			if (result <= 0) {
+				break;
+			}
+
+			lineNumber++;
+
+			switch (result == 1 ? parseRecord(line, slot) : -1) {
+				case 0:
+					continue;
+				case -1:
+					fprintf(stderr, "%s:%lu: invalid record\n", inputName,
+						lineNumber);
+					continue;
+			}
+
+			freeSlots = slot->next;
+			inFlight++;
+
+			/*
+			** A record of a domain in flight waits for the records
+			** before it
+			*/
+			for (first = flightTable[slot->hash % TRANSFER_BUCKETS];
+				first != NULL && strcmp(first->name, slot->name) != 0;
+				first = first->next) {
+			}
+
+			slot->waiting = NULL;
+
+			if (first != NULL) {
+				while (first->waiting != NULL) {
+					first = first->waiting;
+				}
+				first->waiting = slot;
+				continue;
+			}
+
+			slot->next = flightTable[slot->hash % TRANSFER_BUCKETS];
+			flightTable[slot->hash % TRANSFER_BUCKETS] = slot;
+
+			startRecord(slot);
+		}
+
+		/*
+		** Come back to the input soon while it may still bring records
+		*/
+		if (inFlight > 0 && RRPPollSessionPool(pool,
+			(endOfInput || freeSlots == NULL) ? 1000 : 50) < 0) {
+			RRPPrintInternalErrorDescription();
+			break;
+		}
+
+		gettimeofday(&now, NULL);
+
+		if (now.tv_sec != shown.tv_sec) {
+			total = done[TRANSFER_APPROVE] + done[TRANSFER_REJECT] +
+				done[TRANSFER_SYNC] + refused + failed;
+
+			if (!quiet) {
+				fprintf(stderr, "%lu/s  done %lu  in flight %d  approved %lu  "
+					"rejected %lu  synced %lu  refused %lu  failed %lu\n",
+					(total - lastTotal) / (now.tv_sec - shown.tv_sec), total,
+					inFlight, done[TRANSFER_APPROVE], done[TRANSFER_REJECT],
+					done[TRANSFER_SYNC], refused, failed);
+			}
+
+			/*
+			** Results are read by other programs while the input is
+			** still coming
+			*/
+			fflush(results);
+
+			lastTotal = total;
+			shown = now;
+		}
+	}
+
+	RRPFreeSessionPool(pool);
+	RRPFreeRetryPolicy(reconnect);
+	RRPFreeEndpoints(endpoints);
+	if (journal != NULL) {
+		RRPCloseJournal(journal);
+	}
+	if (governor != NULL) {
+		RRPSetProcessGovernor(NULL);
+		RRPFreeGovernor(governor);
+	}
+	free(slots);
+
+	if (input.descriptor != 0) {
+		close(input.descriptor);
+	}
+
+	if (results != stdout) {
+		fclose(results);
+	}
+	else {
+		fflush(results);
+	}
+
+	fprintf(stderr, "%lu approved, %lu rejected, %lu synced, %lu refused, "
+		"%lu failed%s\n", done[TRANSFER_APPROVE], done[TRANSFER_REJECT],
+		done[TRANSFER_SYNC], refused, failed,
+		(endOfInput && inFlight == 0) ? "" : " (not finished)");
+
+	exit((refused > 0 || failed > 0 || !endOfInput || inFlight > 0) ? 1 : 0);
+
+} /* main() */
+
+
+/*
+** Prints the usage message and exits
+*/
+static void
+usage (
+	char* program
+) {
+	RRPPrintToolUsage(program,
+		"\t[-i input] [-o results] [-j journal] [-s sessions] [-n window]\n"
+		"\t[-r rate] [-q]\n",
+		"\t-i\trecords \"domain approve\", \"domain reject\" or\n"
+		"\t\t\"domain sync mm-dd\" (default standard input)\n"
+		"\t-o\tresult file (default standard output)\n"
+		"\t-j\tjournal recording each command before it is sent\n"
+		"\t-q\tdo not display the progress\n",
+		4);
+
+} /* usage() */
+
+
+/*
+** Copies the next line of the input to 'line', waiting at most 'timeout'
+** milliseconds for it. The input is only read when poll() reports it
+** readable, so a pipe that has nothing to give does not hold up the
+** responses. Returns 1 if a line was copied, 2 if the line was too long
+** (and dropped), 0 if none is available yet, -1 at the end of the
+** input.
+*/
+static int
+readLine (
+	char* line,
+	int timeout
+) {
+	struct pollfd descriptor;
+	char* end = NULL;
+	ssize_t count = 0;
+	size_t length = 0;
+
+	for (;;) {
+		end = (char*) memchr(input.buffer, '\n', input.length);
+
+		if (end != NULL || (input.endOfFile && input.length > 0)) {
+			length = (end != NULL) ?
+				(size_t) (end - input.buffer) : input.length;
+			memcpy(line, input.buffer, length);
+			line[length] = '\0';
+
+			if (end != NULL) {
+				length++;
+			}
+			input.length -= length;
+			memmove(input.buffer, input.buffer + length, input.length);
+
+			if (input.skipping) {
+				input.skipping = 0;
+				return 2;
+			}
+			return 1;
+		}
+
+		if (input.endOfFile) {
+			return -1;
+		}
+
+		/*
+		** The buffer is full (one byte is kept for the line's end): drop
+		** the line
+		*/
+		if (input.length == sizeof(input.buffer) - 1) {
+			input.length = 0;
+			input.skipping = 1;
+		}
+
+		descriptor.fd = input.descriptor;
+		descriptor.events = POLLIN;
+		descriptor.revents = 0;
+
+		if (poll(&descriptor, 1, timeout) <= 0) {
+			return 0;
+		}
+
+		count = read(input.descriptor, input.buffer + input.length,
+			sizeof(input.buffer) - 1 - input.length);
+		if (count <= 0) {
+			input.endOfFile = 1;
+			if (count < 0) {
+				perror("read");
+			}
+		}
+		else {
+			input.length += count;
+		}
+
+		timeout = 0;
+	}
+
+} /* readLine() */
+
+
+/*
+** Splits a record into the domain name, the action and the date.
+** Returns 0 for blank lines and comments, -1 for invalid records, 1
+** otherwise.
+*/
+static int
+parseRecord (
+	char* line,
+	TRANSFERSLOT* slot
+) {
+	char* field = NULL;
+	char* date = NULL;
+	int month = 0;
+	int day = 0;
+	size_t i = 0;
+
+	field = line + strspn(line, " \t,\r\n");
+	if (*field == '\0' || *field == '#') {
+		return 0;
+	}
+
+	field = strtok(line, " \t,\r\n");
+	if (strlen(field) >= sizeof(slot->name)) {
+		return -1;
+	}
+
+	/*
+	** Domain names are compared without regard to case
+	*/
+	for (i = 0; field[i] != '\0'; i++) {
+		slot->name[i] = (char) tolower((unsigned char) field[i]);
+	}
+	slot->name[i] = '\0';
+	slot->hash = RRPHashToolName(slot->name);
+
+	if ((field = strtok(NULL, " \t,\r\n")) == NULL) {
+		return -1;
+	}
+
+	if (strcasecmp(field, "approve") == 0 || strcasecmp(field, "yes") == 0) {
+		slot->action = TRANSFER_APPROVE;
+	}
+	else if (strcasecmp(field, "reject") == 0 ||
+		strcasecmp(field, "no") == 0) {
+		slot->action = TRANSFER_REJECT;
+	}
+	else if (strcasecmp(field, "sync") == 0) {
+		slot->action = TRANSFER_SYNC;
+
+		date = strtok(NULL, " \t,\r\n");
+		if (date == NULL || sscanf(date, "%d-%d", &month, &day) != 2 ||
+			month < 1 || month > 12 || day < 1 || day > 31) {
+			return -1;
+		}
+		sprintf(slot->date, "%02d-%02d", month, day);
+	}
+	else {
+		return -1;
+	}
+
+	return strtok(NULL, " \t,\r\n") == NULL ? 1 : -1;
+
+} /* parseRecord() */
+
+
+/*
+** Sends the Transfer or Sync command of a record
+*/
+static void
+startRecord (
+	TRANSFERSLOT* slot
+) {
+	RRPREQUEST* request = NULL;
+	int result = 0;
+
+	request = RRPCreateRequest(slot->action == TRANSFER_SYNC ?
+		RRP_SYNC_COMMAND : RRP_TRANSFER_COMMAND, RRP_DOMAIN_ENTITY,
+		slot->name, strlen(slot->name));
+	result = (request != NULL) ? 0 : -1;
+
+	if (result == 0) {
+		switch (slot->action) {
+			case TRANSFER_APPROVE:
+				result = RRPAppendRequestAttribute(request, "-Approve", 8,
+					"yes", 3);
+				break;
+			case TRANSFER_REJECT:
+				result = RRPAppendRequestAttribute(request, "-Approve", 8,
+					"no", 2);
+				break;
+			default:
+				result = RRPAppendRequestAttribute(request, "date", 4,
+					slot->date, strlen(slot->date));
+		}
+	}
+
+	if (result == 0) {
+		result = RRPSubmitPoolRequest(pool, request, completeRecord, slot);
+	}
+
+	if (result < 0) {
+		if (request != NULL) {
+			RRPFreeRequest(request);
+		}
+		finishRecord(slot, TRANSFER_FAILED, 0);
+	}
+
+} /* startRecord() */
+
+
+/*
+** Writes the result line of a record and releases its slot. The next
+** record of the same domain, if any, takes its place in the table of
+** domains in flight and is started
+*/
+static void
+finishRecord (
+	TRANSFERSLOT* slot,
+	int result,
+	int code
+) {
+	TRANSFERSLOT** link = NULL;
+	TRANSFERSLOT* next = slot->waiting;
+
+	fprintf(results, "%s,%s,%s,%d\n", slot->name, actionNames[slot->action],
+		resultNames[result], code);
+
+	switch (result) {
+		case TRANSFER_DONE: done[slot->action]++; break;
+		case TRANSFER_REFUSED: refused++; break;
+		default: failed++;
+	}
+
+	for (link = &flightTable[slot->hash % TRANSFER_BUCKETS]; *link != slot;
+		link = &(*link)->next) {
+	}
+
+	if (next != NULL) {
+		next->next = slot->next;
+		*link = next;
+	}
+	else {
+		*link = slot->next;
+	}
+
+	slot->next = freeSlots;
+	freeSlots = slot;
+	inFlight--;
+
+	if (next != NULL) {
+		startRecord(next);
+	}
+
+} /* finishRecord() */
+
+
+/*
+** Completion function of the Transfer and Sync commands
+*/
+static void
+completeRecord (
+	RRPREQUEST* request,
+	RRPRESPONSE* response,
+	void* context
+) {
+	TRANSFERSLOT* slot = (TRANSFERSLOT*) context;
+
+	if (response == NULL) {
+		finishRecord(slot, TRANSFER_FAILED, 0);
+		return;
+	}
+
+	finishRecord(slot, response->code / 100 == 2 ?
+		TRANSFER_DONE : TRANSFER_REFUSED, response->code);
+	RRPFreeResponse(response);
+
+} /* completeRecord() */
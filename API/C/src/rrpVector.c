@@ -59,7 +59,11 @@
 ** Entry Points:
 **
 ** 	RRPCreateVector(void);
+**    RRPCloneVector(RRPVECTOR*);
+**    RRPCreateVectorFromArray(char**, int, RRPBOOLEAN);
+**    RRPCreateVectorFromBuffer(char*, size_t, RRPBOOLEAN);
 ** 	RRPAddVectorElement(RRPVECTOR*, char*);
+**    RRPAddVectorElementN(RRPVECTOR*, const char*, size_t);
 ** 	RRPRemoveAllVectorElements(RRPVECTOR*);
 ** 	RRPFreeVector(RRPVECTOR*);
 ** 	RRPGetVectorSize(RRPVECTOR*);
@@ -68,6 +72,30 @@
 **
 ** Changes:
 **
+** RRPCloneVector() no longer copies the elements of the vector being
+** cloned. The original and the clone share a single reference counted
+** list of nodes, and a vector makes its own private copy of the list
+** only when it is modified (copy-on-write). Cloning is therefore a
+** constant time operation, and a list that is cloned many times (e.g.
+** one set of name servers used for many RRPAddDomain() calls) is only
+** stored once.
+**
+** RRPCreateVectorFromArray() and RRPCreateVectorFromBuffer() build a
+** complete vector from an array of strings or from a packed buffer in
+** a single allocation, instead of one allocation per node and string
+** with RRPAddVectorElement(). The strings can optionally be borrowed
+** from the caller rather than copied.
+**
+** Oct. 19th, 2026: The reference counts of shared node lists are
+** updated atomically where the compiler supports it, so that the
+** clones of one vector can be used and freed by different threads
+** (e.g. the copies of a response handed out by rrpClient.c). Each
+** clone still belongs to a single thread.
+**
+** Oct. 19th, 2026: RRPAddVectorElementN() adds an element from a string
+** of known length, so that callers holding one (e.g. a std::string in
+** rrpAPI.hpp) need not copy it or have it measured first.
+**
 */
 
 
@@ -77,6 +105,46 @@
 #include "rrpInternalError.h"
 
 
+/*
+** Atomic update of a reference count, and atomic installation of the
+** shared list of a vector that has none yet
+*/
+#ifndef RRP_ATOMIC_ADD
+	#if defined(__GNUC__)
+		#define RRP_ATOMIC_ADD(counter, value) \
+			__sync_add_and_fetch(&(counter), (value))
+		#define RRP_ATOMIC_INSTALL(pointer, value) \
+			__sync_bool_compare_and_swap(&(pointer), NULL, (value))
+	#else
+		#define RRP_ATOMIC_ADD(counter, value) ((counter) += (value))
+		#define RRP_ATOMIC_INSTALL(pointer, value) ((pointer) = (value), 1)
+	#endif
+#endif
+
+
+/*
+** List of nodes shared between a vector and its clones. A shared list
+** is never modified; a vector that needs to modify its elements first
+** detaches itself from the shared list by making a private copy
+*/
+struct _RRPVECTOR_STORAGE {
+	int references;        /* number of vectors using the list */
+	RRPELEMENT_NODE* head; /* first node of the shared list */
+	RRPBOOLEAN packed;     /* RRPTRUE if the nodes and their values were
+	                          allocated in the same block as this
+	                          structure (or borrowed from the caller) */
+};
+
+
+/*
+** Functions used internally to manage the node list of a vector
+*/
+static RRPVECTOR* RRPCreatePackedVector (int, size_t, char**);
+static int RRPDetachVector (RRPVECTOR*);
+static void RRPReleaseVectorNodes (RRPVECTOR*);
+static void RRPFreeElementNodes (RRPELEMENT_NODE*);
+
+
 
 /*
 **
@@ -118,6 +186,7 @@ RRPCreateVector () {
 	newVector->current = NULL;
 	newVector->head = NULL;
 	newVector->tail = NULL;
+	newVector->storage = NULL;
 
 	return newVector;
 
@@ -152,9 +221,7 @@ RRPCloneVector (
 	RRPVECTOR* oldVector
 ) {
 	RRPVECTOR* newVector = NULL;
-	RRPELEMENT_NODE* newNode  = NULL;
-	RRPELEMENT_NODE* lastNode = NULL;
-	RRPELEMENT_NODE* currentNode  = NULL;
+	RRPVECTOR_STORAGE* storage = NULL;
 
 	/*
 	** Validate parameters
@@ -186,57 +253,261 @@ RRPCloneVector (
 		return newVector;
 	}
 
+	/*
+	** The first clone of a vector turns its node list into a shared
+	** list. From then on neither vector may modify the list in place.
+	** A vector that belongs to a shared list of properties can be
+	** cloned by two threads at once, in which case only one of them
+	** installs its list
+	*/
+	if (oldVector->storage == NULL) {
+		storage = (RRPVECTOR_STORAGE*) calloc(1, sizeof(RRPVECTOR_STORAGE));
 
-	currentNode = oldVector->head;
-
-	while (currentNode != NULL) {
-		newNode = (RRPELEMENT_NODE*) calloc(1, sizeof(RRPELEMENT_NODE));
-
-		/*
-		** Check to make sure memory was properly allocated
-		*/
-		if (newNode == NULL) {
+		if (storage == NULL) {
 			RRPFreeVector(newVector);
 			RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
 			return NULL;
 		}
 
-		newVector->count++;
+		storage->references = 1;
+		storage->head = oldVector->head;
+		storage->packed = RRPFALSE;
 
-		newNode->value = strdup(currentNode->value);
+		if (!RRP_ATOMIC_INSTALL(oldVector->storage, storage)) {
+			free(storage);
+		}
+	}
 
-		/*
-		** Check to make sure memory was properly allocated
-		*/
-		if (newNode->value == NULL) {
-			RRPFreeVector(newVector);
-			RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
+	RRP_ATOMIC_ADD(oldVector->storage->references, 1);
+
+	newVector->storage = oldVector->storage;
+	newVector->count = oldVector->count;
+	newVector->current = oldVector->current;
+	newVector->head = oldVector->head;
+	newVector->tail = oldVector->tail;
+
+	return newVector;
+
+} /* RRPCloneVector */
+
+
+
+
+
+
+
+/*
+**
+** Function: RRPCreateVectorFromArray
+**
+** Description: Allocates memory for and returns a pointer to a new
+**              RRPVECTOR structure containing each string of an
+**              array, in order. All of the nodes (and the copies of the
+**              strings, unless they are borrowed) are allocated in one
+**              block rather than one at a time
+**
+** Input: char** - an array of strings
+**        int - the number of strings in the array
+**        RRPBOOLEAN - RRPTRUE to borrow the strings rather than copy
+**                     them. Borrowed strings must not be changed or
+**                     freed until the vector and all of its clones have
+**                     been freed or modified (a vector that is modified
+**                     makes its own copy of the strings)
+**
+** Output: none
+**
+** Return: RRPVECTOR* - a pointer to a new allocated RRPVECTOR structure.
+**         NULL is returned if an internal error occurs.
+**
+** Note:   THE POINTER RETURNED MUST BE PASSED TO RRPFreeVector() IN ORDER
+**         TO FREE THE MEMORY ALLOCATED UPON CREATION OF STRUCTURE.
+*/
+
+RRPVECTOR*
+RRPCreateVectorFromArray (
+	char** values,
+	int count,
+	RRPBOOLEAN borrow
+) {
+	RRPVECTOR* newVector = NULL;
+	RRPELEMENT_NODE* node = NULL;
+	char* text = NULL;
+	size_t textSize = 0;
+	size_t valueSize = 0;
+	int i = 0;
+
+	/*
+	** Validate parameters
+	*/
+	if (count < 0 || (values == NULL && count > 0)) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return NULL;
+	}
+
+	for (i = 0; i < count; i++) {
+		if (values[i] == NULL) {
+			RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
 			return NULL;
 		}
+		if (!borrow) {
+			textSize += strlen(values[i]) + 1;
+		}
+	}
+
+	if (count == 0) {
+		return RRPCreateVector();
+	}
 
-		if (lastNode != NULL) {
-			lastNode->next = newNode;
+	newVector = RRPCreatePackedVector(count, textSize, &text);
+
+	if (newVector == NULL) {
+		return NULL;
+	}
+
+	for (node = newVector->head, i = 0; i < count; node++, i++) {
+		if (borrow) {
+			node->value = values[i];
 		}
 		else {
-			newVector->head = newNode;
+			valueSize = strlen(values[i]) + 1;
+			memcpy(text, values[i], valueSize);
+			node->value = text;
+			text += valueSize;
 		}
+	}
+
+	return newVector;
+
+} /* RRPCreateVectorFromArray */
+
+
+
+
+
+
+/*
+**
+** Function: RRPCreateVectorFromBuffer
+**
+** Description: Allocates memory for and returns a pointer to a new
+**              RRPVECTOR structure containing each string of a buffer
+**              in which the strings are separated by NUL characters
+**              or newlines (a carriage return before a newline is
+**              ignored, as are empty strings). All of the nodes (and
+**              the copy of the buffer, unless it is borrowed) are
+**              allocated in one block
+**
+** Input: char* - the buffer
+**        size_t - the number of characters in the buffer
+**        RRPBOOLEAN - RRPTRUE to borrow the buffer rather than copy it.
+**                     A borrowed buffer must be followed by a NUL
+**                     character (at buffer[length]); the separator
+**                     after each string is overwritten with a NUL
+**                     character. It must not be changed or freed until
+**                     the vector and all of its clones have been freed
+**                     or modified (a vector that is modified makes its
+**                     own copy of the strings)
+**
+** Output: none
+**
+** Return: RRPVECTOR* - a pointer to a new allocated RRPVECTOR structure.
+**         NULL is returned if an internal error occurs.
+**
+** Note:   THE POINTER RETURNED MUST BE PASSED TO RRPFreeVector() IN ORDER
+**         TO FREE THE MEMORY ALLOCATED UPON CREATION OF STRUCTURE.
+*/
+
+RRPVECTOR*
+RRPCreateVectorFromBuffer (
+	char* buffer,
+	size_t length,
+	RRPBOOLEAN borrow
+) {
+	RRPVECTOR* newVector = NULL;
+	RRPELEMENT_NODE* node = NULL;
+	char* text = NULL;
+	char* value = NULL;
+	char* valueEnd = NULL;
+	char* end = NULL;
+	size_t valueSize = 0;
+	size_t start = 0;
+	size_t i = 0;
+	int count = 0;
+
+	/*
+	** Validate parameters
+	*/
+	if (buffer == NULL || (borrow && buffer[length] != '\0')) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return NULL;
+	}
 
-		if (oldVector->current == currentNode) {
-			newVector->current = newNode;
+	/*
+	** Count the non-empty strings so that all of the nodes can be
+	** allocated at once
+	*/
+	for (i = 0; i <= length; i++) {
+		if (i < length && buffer[i] != '\0' && buffer[i] != '\n') {
+			continue;
 		}
-		lastNode = newNode;
-		currentNode = currentNode->next;
 
-		if (currentNode == NULL) {
-			newVector->tail = newNode;
-			newNode->next = NULL;
+		valueSize = i - start;
+		if (valueSize > 0 && buffer[i - 1] == '\r') {
+			valueSize--;
 		}
+		if (valueSize > 0) {
+			count++;
+		}
+		start = i + 1;
 	}
-	return newVector;
 
+	if (count == 0) {
+		return RRPCreateVector();
+	}
 
+	newVector = RRPCreatePackedVector(count, borrow ? 0 : length + 1, &text);
 
-} /* RRPCloneVector */
+	if (newVector == NULL) {
+		return NULL;
+	}
+
+	if (borrow) {
+		text = buffer;
+	}
+	else {
+		memcpy(text, buffer, length);
+		text[length] = '\0';
+	}
+
+	/*
+	** Terminate each string in place and point a node at it
+	*/
+	node = newVector->head;
+	value = text;
+
+	for (end = text; end <= text + length; end++) {
+		if (end < text + length && *end != '\0' && *end != '\n') {
+			continue;
+		}
+
+		valueEnd = end;
+		if (valueEnd > value && *(valueEnd - 1) == '\r') {
+			valueEnd--;
+		}
+
+		if (valueEnd > value) {
+			if (*valueEnd != '\0') {
+				*valueEnd = '\0';
+			}
+			node->value = value;
+			node++;
+		}
+		value = end + 1;
+	}
+
+	return newVector;
+
+} /* RRPCreateVectorFromBuffer */
 
 
 
@@ -265,6 +536,49 @@ int
 RRPAddVectorElement (
 	RRPVECTOR* vector,
 	char* value
+) {
+	/*
+	** Validate parameters
+	*/
+	if (vector == NULL || value == NULL) {
+		RRPSetInternalErrorCode(RRP_BAD_PARAM_ERROR);
+		return -1;
+	}
+
+	return RRPAddVectorElementN(vector, value, strlen(value));
+
+} /* RRPAddVectorElement */
+
+
+
+
+
+
+/*
+**
+** Function: RRPAddVectorElementN
+**
+** Description: Adds a new vector element to the end of an
+**              RRPVECTOR structure, from a string of a given length
+**              that need not be NUL terminated
+**
+** Input: RRPVECTOR* - a pointer to an RRPVECTOR structure
+**        const char* - the element string
+**        size_t - the number of characters in the string
+**
+** Output: none
+**
+** Return: int - returns 0 if successful. Returns -1 if an internal
+**               error occurs.
+**
+**
+*/
+
+int
+RRPAddVectorElementN (
+	RRPVECTOR* vector,
+	const char* value,
+	size_t length
 ) {
 	RRPELEMENT_NODE* lastNode = NULL;
 	RRPELEMENT_NODE* newNode = NULL;
@@ -277,6 +591,13 @@ RRPAddVectorElement (
 		return -1;
 	}
 
+	/*
+	** Make sure that the nodes are not shared with a clone
+	*/
+	if (RRPDetachVector(vector) < 0) {
+		return -1;
+	}
+
 	/*
 	** Allocate memory for new RRPELEMENT_NODE structure
 	*/
@@ -293,7 +614,7 @@ RRPAddVectorElement (
 	/*
 	** Allocate memory for node string value
 	*/
-	newNode->value = strdup(value);
+	newNode->value = (char*) malloc(length + 1);
 
 	/*
 	** Verify that memory was allocated properly
@@ -304,6 +625,8 @@ RRPAddVectorElement (
 		return -1;
 	}
 
+	memcpy(newNode->value, value, length);
+	newNode->value[length] = '\0';
 	newNode->next = NULL;
 
 	if (vector->count == 0) {
@@ -319,7 +642,7 @@ RRPAddVectorElement (
 
 	return 0;
 	
-} /* RRPAddVectorElement */
+} /* RRPAddVectorElementN */
 
 
 
@@ -348,9 +671,6 @@ int
 RRPRemoveAllVectorElements (
 	RRPVECTOR* vector
 ) {
-   RRPELEMENT_NODE* currentNode;
-   RRPELEMENT_NODE* nextNode;
-
    /*
    ** Validate parameters
    */
@@ -359,16 +679,7 @@ RRPRemoveAllVectorElements (
       return -1;
    }
 
-   currentNode = vector->head;
-
-   while (currentNode != NULL) {
-      nextNode = currentNode->next;
-
-      free(currentNode->value);
-      free(currentNode);
-
-      currentNode = nextNode;
-   }
+   RRPReleaseVectorNodes(vector);
 
    vector->count = 0;
    vector->head = NULL;
@@ -561,6 +872,13 @@ RRPDeleteVectorElementAt (
 		return -1;
 	}
 
+	/*
+	** Make sure that the nodes are not shared with a clone
+	*/
+	if (RRPDetachVector(vector) < 0) {
+		return -1;
+	}
+
 	currentNode = vector->head;
 	previousNode = vector->head;
 
@@ -573,6 +891,10 @@ RRPDeleteVectorElementAt (
 				previousNode->next = currentNode->next;
 			}
 
+			if (currentNode == vector->tail) {
+				vector->tail = (position == 0) ? NULL : previousNode;
+			}
+
 			if (currentNode == vector->current) {
 				vector->current = currentNode->next;
 			}
@@ -592,3 +914,197 @@ RRPDeleteVectorElementAt (
 
 
 
+
+
+
+/*
+** FOR INTERNAL USE
+**
+** Gives a vector its own copy of a node list that it shares with one
+** or more clones, so that the list can be modified without affecting
+** the clones. Nothing is copied if the vector is the only remaining
+** user of the list. Returns 0 if successful. Returns -1 and sets the
+** error code if memory can not be allocated, in which case the vector
+** is left unchanged.
+*/
+static int
+RRPDetachVector (
+	RRPVECTOR* vector
+) {
+	RRPELEMENT_NODE* oldNode = NULL;
+	RRPELEMENT_NODE* newNode = NULL;
+	RRPELEMENT_NODE* newHead = NULL;
+	RRPELEMENT_NODE* newTail = NULL;
+	RRPELEMENT_NODE* newCurrent = NULL;
+
+	if (vector->storage == NULL) {
+		return 0;
+	}
+
+	/*
+	** Last user of a shared list simply takes the list over, unless
+	** the nodes were allocated as one block
+	*/
+	if (RRP_ATOMIC_ADD(vector->storage->references, 0) == 1 &&
+		!vector->storage->packed) {
+		free(vector->storage);
+		vector->storage = NULL;
+		return 0;
+	}
+
+	for (oldNode = vector->head; oldNode != NULL; oldNode = oldNode->next) {
+		newNode = (RRPELEMENT_NODE*) calloc(1, sizeof(RRPELEMENT_NODE));
+
+		if (newNode != NULL) {
+			newNode->value = strdup(oldNode->value);
+		}
+
+		if (newNode == NULL || newNode->value == NULL) {
+			free(newNode);
+			RRPFreeElementNodes(newHead);
+			RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
+			return -1;
+		}
+
+		if (newTail != NULL) {
+			newTail->next = newNode;
+		}
+		else {
+			newHead = newNode;
+		}
+
+		if (vector->current == oldNode) {
+			newCurrent = newNode;
+		}
+		newTail = newNode;
+	}
+
+	RRPReleaseVectorNodes(vector);
+	vector->head = newHead;
+	vector->tail = newTail;
+	vector->current = newCurrent;
+
+	return 0;
+
+} /* RRPDetachVector */
+
+
+
+
+
+
+/*
+** FOR INTERNAL USE
+**
+** Lets go of the node list of a vector. Nodes that are shared with a
+** clone are only freed when the last vector using them lets go of them.
+** The caller is responsible for resetting the vector itself.
+*/
+static void
+RRPReleaseVectorNodes (
+	RRPVECTOR* vector
+) {
+	if (vector->storage == NULL) {
+		RRPFreeElementNodes(vector->head);
+		return;
+	}
+
+	if (RRP_ATOMIC_ADD(vector->storage->references, -1) == 0) {
+		if (!vector->storage->packed) {
+			RRPFreeElementNodes(vector->storage->head);
+		}
+		free(vector->storage);
+	}
+	vector->storage = NULL;
+
+} /* RRPReleaseVectorNodes */
+
+
+
+
+
+
+/*
+** FOR INTERNAL USE
+**
+** Frees a NULL terminated list of nodes and their values
+*/
+static void
+RRPFreeElementNodes (
+	RRPELEMENT_NODE* node
+) {
+	RRPELEMENT_NODE* nextNode;
+
+	while (node != NULL) {
+		nextNode = node->next;
+
+		free(node->value);
+		free(node);
+
+		node = nextNode;
+	}
+
+} /* RRPFreeElementNodes */
+
+
+
+
+
+
+/*
+** FOR INTERNAL USE
+**
+** Creates a vector of 'count' nodes whose nodes are allocated in one
+** block, together with 'textSize' bytes for the node values. The nodes
+** are linked together but their values are left for the caller to set.
+** A pointer to the space for the values is returned in 'text'.
+** Returns NULL and sets the error code if an error occurs.
+*/
+static RRPVECTOR*
+RRPCreatePackedVector (
+	int count,
+	size_t textSize,
+	char** text
+) {
+	RRPVECTOR* newVector = NULL;
+	RRPVECTOR_STORAGE* storage = NULL;
+	RRPELEMENT_NODE* nodes = NULL;
+	int i = 0;
+
+	newVector = RRPCreateVector();
+
+	if (newVector == NULL) {
+		return NULL;
+	}
+
+	storage = (RRPVECTOR_STORAGE*) malloc(sizeof(RRPVECTOR_STORAGE) +
+		count * sizeof(RRPELEMENT_NODE) + textSize);
+
+	if (storage == NULL) {
+		free(newVector);
+		RRPSetInternalErrorCode(RRP_MEM_ALLOC_ERROR);
+		return NULL;
+	}
+
+	nodes = (RRPELEMENT_NODE*) (storage + 1);
+
+	for (i = 0; i < count; i++) {
+		nodes[i].value = NULL;
+		nodes[i].next = (i + 1 < count) ? &nodes[i + 1] : NULL;
+	}
+
+	storage->references = 1;
+	storage->head = nodes;
+	storage->packed = RRPTRUE;
+
+	newVector->storage = storage;
+	newVector->count = count;
+	newVector->head = nodes;
+	newVector->current = nodes;
+	newVector->tail = &nodes[count - 1];
+
+	*text = (char*) (nodes + count);
+
+	return newVector;
+
+} /* RRPCreatePackedVector */